@@ -0,0 +1,169 @@
+#!/usr/bin/python3
+"""
+Benchmark how scans slow down as deletes pile up - and how much compaction recovers.
+
+For every DML method (DELETE, UPDATE or MERGE) the benchmark builds a table of --files data files, and then removes
+(or rewrites) an increasing fraction of the rows of every data file in steps. After every step it measures the time of
+the DML and the throughput of a full scan of the table. Finally it times ducklake_rewrite_data_files and
+ducklake_merge_adjacent_files, and measures the scan throughput after each of them.
+
+Example:
+    python3 benchmark/compaction/delete_compaction_benchmark.py \\
+        --extension build/release/extension/ducklake/ducklake.duckdb_extension \\
+        --method delete update merge --ratios 0.1 0.25 0.5 0.75 --files 20 --rows-per-file 1000000
+"""
+
+import argparse
+import os
+import shutil
+import statistics
+import tempfile
+import time
+
+import duckdb
+
+# the rows are deleted based on "id % BUCKET_COUNT" - so that every data file is affected by every step
+BUCKET_COUNT = 100
+
+
+def connect(args) -> duckdb.DuckDBPyConnection:
+    """
+    Create a new in-memory database with the DuckLake extension loaded.
+    """
+    con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    if args.extension:
+        con.execute(f"LOAD '{args.extension}'")
+    else:
+        con.execute("INSTALL ducklake")
+        con.execute("LOAD ducklake")
+    return con
+
+
+def attach(con: duckdb.DuckDBPyConnection, metadata: str, lake_dir: str) -> None:
+    """
+    Attach the DuckLake of the given metadata catalog type as "lake".
+    """
+    if metadata == "sqlite":
+        connection_string = f"sqlite:{os.path.join(lake_dir, 'metadata.sqlite')}"
+    else:
+        connection_string = os.path.join(lake_dir, "metadata.ducklake")
+    data_path = os.path.join(lake_dir, "data")
+    con.execute(f"ATTACH 'ducklake:{connection_string}' AS lake (DATA_PATH '{data_path}')")
+
+
+def build(con: duckdb.DuckDBPyConnection, args) -> None:
+    con.execute("CREATE TABLE lake.tbl(id BIGINT, val DOUBLE, payload VARCHAR)")
+    for file_idx in range(args.files):
+        first_row = file_idx * args.rows_per_file
+        con.execute(
+            f"INSERT INTO lake.tbl SELECT i, i / 7, 'payload-' || i "
+            f"FROM range({first_row}, {first_row + args.rows_per_file}) t(i)"
+        )
+
+
+def apply_step(con: duckdb.DuckDBPyConnection, method: str, start_bucket: int, end_bucket: int) -> None:
+    """
+    Delete (or rewrite) the rows in the buckets [start_bucket, end_bucket).
+    """
+    condition = f"id % {BUCKET_COUNT} >= {start_bucket} AND id % {BUCKET_COUNT} < {end_bucket}"
+    if method == "delete":
+        con.execute(f"DELETE FROM lake.tbl WHERE {condition}")
+    elif method == "update":
+        con.execute(f"UPDATE lake.tbl SET val = val + 1 WHERE {condition}")
+    elif method == "merge":
+        con.execute(
+            f"MERGE INTO lake.tbl USING (SELECT id FROM lake.tbl WHERE {condition}) source "
+            f"ON tbl.id = source.id WHEN MATCHED THEN UPDATE SET val = tbl.val + 1"
+        )
+    else:
+        raise ValueError(f"Unknown method {method}")
+
+
+def timed(con: duckdb.DuckDBPyConnection, query: str) -> float:
+    start = time.perf_counter()
+    con.execute(query).fetchall()
+    return time.perf_counter() - start
+
+
+def measure_scan(con: duckdb.DuckDBPyConnection, args) -> tuple:
+    """
+    Returns the median scan time (in seconds) and the amount of rows scanned.
+    """
+    # SUM(val) cannot be answered from the stats - so the scan has to read (and filter) all files
+    scan_time = statistics.median(timed(con, "SELECT SUM(val) FROM lake.tbl") for _ in range(args.repetitions))
+    row_count = con.execute("SELECT COUNT(*) FROM lake.tbl").fetchone()[0]
+    return scan_time, row_count
+
+
+def file_counts(con: duckdb.DuckDBPyConnection) -> tuple:
+    return con.execute(
+        "SELECT COUNT(*), COUNT(delete_file) FROM ducklake_list_files('lake', 'tbl')"
+    ).fetchone()
+
+
+def run_method(args, metadata: str, method: str) -> list:
+    lake_dir = tempfile.mkdtemp(prefix=f"ducklake_compaction_bench_{method}_", dir=args.dir)
+    rows = []
+
+    def record(step: str, dml_time) -> None:
+        scan_time, row_count = measure_scan(con, args)
+        data_files, delete_files = file_counts(con)
+        rows.append((metadata, method, step, dml_time, scan_time, row_count, data_files, delete_files))
+        print_row(rows[-1])
+
+    try:
+        con = connect(args)
+        attach(con, metadata, lake_dir)
+        build(con, args)
+        record("baseline", None)
+        start_bucket = 0
+        for ratio in sorted(args.ratios):
+            end_bucket = int(round(ratio * BUCKET_COUNT))
+            if end_bucket <= start_bucket:
+                continue
+            start = time.perf_counter()
+            apply_step(con, method, start_bucket, end_bucket)
+            record(f"{method} {end_bucket}%", time.perf_counter() - start)
+            start_bucket = end_bucket
+        record("rewrite", timed(con, "CALL ducklake_rewrite_data_files('lake', 'tbl', delete_threshold => 0)"))
+        record("merge", timed(con, "CALL ducklake_merge_adjacent_files('lake', 'tbl')"))
+        con.close()
+    finally:
+        shutil.rmtree(lake_dir, ignore_errors=True)
+    return rows
+
+
+def print_row(row: tuple) -> None:
+    metadata, method, step, dml_time, scan_time, row_count, data_files, delete_files = row
+    dml_ms = f"{dml_time * 1000:.1f}" if dml_time is not None else "-"
+    rows_per_second = row_count / scan_time if scan_time > 0 else 0.0
+    print(
+        f"{metadata:<8} {method:<7} {step:<12} {dml_ms:>10} {scan_time * 1000:>10.1f} {rows_per_second / 1e6:>10.2f} "
+        f"{data_files:>10} {delete_files:>12}",
+        flush=True,
+    )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Benchmark scans with accumulating deletes, and their compaction")
+    parser.add_argument("--extension", help="path of the ducklake extension to load (installs it if omitted)")
+    parser.add_argument("--method", nargs="+", choices=["delete", "update", "merge"], default=["delete", "update"])
+    parser.add_argument("--ratios", type=float, nargs="+", default=[0.01, 0.1, 0.25, 0.5, 0.75])
+    parser.add_argument("--metadata", nargs="+", choices=["duckdb", "sqlite"], default=["duckdb"])
+    parser.add_argument("--files", type=int, default=10, help="data files in the table")
+    parser.add_argument("--rows-per-file", type=int, default=1000000, help="rows in every data file")
+    parser.add_argument("--repetitions", type=int, default=3, help="repetitions of every scan")
+    parser.add_argument("--dir", help="directory in which the DuckLakes are created")
+    args = parser.parse_args()
+
+    print(
+        f"{'metadata':<8} {'method':<7} {'step':<12} {'dml ms':>10} {'scan ms':>10} {'M rows/s':>10} "
+        f"{'data files':>10} {'delete files':>12}"
+    )
+    for metadata in args.metadata:
+        for method in args.method:
+            run_method(args, metadata, method)
+
+
+if __name__ == "__main__":
+    main()
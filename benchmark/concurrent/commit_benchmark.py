@@ -0,0 +1,238 @@
+#!/usr/bin/python3
+"""
+Benchmark the commit throughput of concurrent writers to a DuckLake.
+
+Every worker runs a loop of small transactions (appends, deletes, or a mix of appends, deletes and updates) against
+the same DuckLake table, and times the COMMIT of each transaction - which is where DuckLake checks for conflicts with
+other writers, writes the metadata and retries. The workers run as threads within a process, and optionally in
+multiple processes. The benchmark reports the commits per second, the p50/p99 commit latency and the amount of
+retries (as reported by ducklake_commit_stats) for every combination of metadata catalog and workload.
+
+Example:
+    python3 benchmark/concurrent/commit_benchmark.py \\
+        --extension build/release/extension/ducklake/ducklake.duckdb_extension \\
+        --threads 1 4 16 --processes 1 --metadata duckdb sqlite --workload append delete mixed
+"""
+
+import argparse
+import multiprocessing
+import os
+import shutil
+import sys
+import tempfile
+import threading
+import time
+
+import duckdb
+
+TABLE_NAME = "lake.commit_bench"
+
+
+def connect(args) -> duckdb.DuckDBPyConnection:
+    """
+    Create a new in-memory database with the DuckLake extension loaded.
+    """
+    con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    if args.extension:
+        con.execute(f"LOAD '{args.extension}'")
+    else:
+        con.execute("INSTALL ducklake")
+        con.execute("LOAD ducklake")
+    con.execute(f"SET GLOBAL ducklake_max_retry_count = {args.max_retry_count}")
+    con.execute(f"SET GLOBAL ducklake_retry_wait_ms = {args.retry_wait_ms}")
+    return con
+
+
+def attach(con: duckdb.DuckDBPyConnection, metadata: str, work_dir: str) -> None:
+    """
+    Attach the DuckLake of the given metadata catalog type as "lake".
+    """
+    if metadata == "sqlite":
+        connection_string = f"sqlite:{os.path.join(work_dir, 'metadata.sqlite')}"
+    else:
+        connection_string = os.path.join(work_dir, "metadata.ducklake")
+    data_path = os.path.join(work_dir, "data")
+    con.execute(f"ATTACH 'ducklake:{connection_string}' AS lake (DATA_PATH '{data_path}')")
+
+
+def setup(args, metadata: str, work_dir: str, worker_count: int) -> None:
+    """
+    Create the table - with one row for every delete/update every worker performs. The rows of every worker are
+    written to their own data file, as deletes from the same data file by different transactions conflict.
+    """
+    con = connect(args)
+    attach(con, metadata, work_dir)
+    con.execute(f"CREATE TABLE {TABLE_NAME}(id BIGINT, worker INTEGER, val VARCHAR)")
+    for worker_id in range(worker_count):
+        first_row = worker_id * args.commits
+        con.execute(
+            f"INSERT INTO {TABLE_NAME} SELECT i, {worker_id}, 'initial' "
+            f"FROM range({first_row}, {first_row + args.commits}) t(i)"
+        )
+    con.close()
+
+
+def run_transaction(cursor, workload: str, worker_id: int, i: int, args) -> None:
+    """
+    Run the statements of the i-th transaction of a worker - every worker deletes/updates its own rows only, so that
+    all conflicts are caused by concurrent commits rather than by logically conflicting changes.
+    """
+    row_id = worker_id * args.commits + i
+    new_id = (worker_id + 1) * 1000000000 + i
+    if workload == "append":
+        cursor.execute(f"INSERT INTO {TABLE_NAME} VALUES ({new_id}, {worker_id}, 'append')")
+    elif workload == "delete":
+        cursor.execute(f"DELETE FROM {TABLE_NAME} WHERE id = {row_id}")
+    elif workload == "mixed":
+        if i % 3 == 0:
+            cursor.execute(f"INSERT INTO {TABLE_NAME} VALUES ({new_id}, {worker_id}, 'mixed')")
+        elif i % 3 == 1:
+            cursor.execute(f"DELETE FROM {TABLE_NAME} WHERE id = {row_id}")
+        else:
+            cursor.execute(f"UPDATE {TABLE_NAME} SET val = 'updated' WHERE id = {row_id}")
+    else:
+        raise ValueError(f"Unknown workload {workload}")
+
+
+def run_worker(con, workload: str, worker_id: int, args, latencies: list, failures: list) -> None:
+    cursor = con.cursor()
+    for i in range(args.commits):
+        try:
+            cursor.execute("BEGIN")
+            run_transaction(cursor, workload, worker_id, i, args)
+            start = time.perf_counter()
+            cursor.execute("COMMIT")
+            latencies.append(time.perf_counter() - start)
+        except duckdb.Error as ex:
+            failures.append(str(ex))
+            try:
+                cursor.execute("ROLLBACK")
+            except duckdb.Error:
+                pass
+    cursor.close()
+
+
+def run_process(args, metadata: str, work_dir: str, workload: str, process_id: int, start_barrier) -> dict:
+    """
+    Run the worker threads of one process - returns the commit latencies, failures and retries of the process.
+    """
+    con = connect(args)
+    attach(con, metadata, work_dir)
+    latencies = []
+    failures = []
+    threads = []
+    for thread_id in range(args.thread_count):
+        worker_id = process_id * args.thread_count + thread_id
+        thread = threading.Thread(target=run_worker, args=(con, workload, worker_id, args, latencies, failures))
+        threads.append(thread)
+    if start_barrier is not None:
+        start_barrier.wait()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    retries, max_retries = con.execute("SELECT retries, max_retries FROM ducklake_commit_stats('lake')").fetchone()
+    con.close()
+    return {"latencies": latencies, "failures": failures, "retries": retries, "max_retries": max_retries}
+
+
+def run_process_entry(args, metadata, work_dir, workload, process_id, start_barrier, queue) -> None:
+    try:
+        queue.put(run_process(args, metadata, work_dir, workload, process_id, start_barrier))
+    except Exception as ex:
+        queue.put({"error": str(ex)})
+
+
+def percentile(sorted_values: list, fraction: float) -> float:
+    if not sorted_values:
+        return 0.0
+    index = int(round(fraction * (len(sorted_values) - 1)))
+    return sorted_values[index]
+
+
+def run_benchmark(args, metadata: str, workload: str) -> dict:
+    work_dir = tempfile.mkdtemp(prefix=f"ducklake_commit_bench_{metadata}_", dir=args.dir)
+    try:
+        setup(args, metadata, work_dir, args.process_count * args.thread_count)
+        start = time.perf_counter()
+        if args.process_count == 1:
+            results = [run_process(args, metadata, work_dir, workload, 0, None)]
+        else:
+            context = multiprocessing.get_context("spawn")
+            queue = context.Queue()
+            start_barrier = context.Barrier(args.process_count)
+            processes = []
+            for process_id in range(args.process_count):
+                process = context.Process(
+                    target=run_process_entry,
+                    args=(args, metadata, work_dir, workload, process_id, start_barrier, queue),
+                )
+                process.start()
+                processes.append(process)
+            results = [queue.get() for _ in processes]
+            for process in processes:
+                process.join()
+        elapsed = time.perf_counter() - start
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+    for result in results:
+        if "error" in result:
+            raise RuntimeError(result["error"])
+    latencies = sorted(latency for result in results for latency in result["latencies"])
+    failures = [failure for result in results for failure in result["failures"]]
+    if failures and args.verbose:
+        for failure in sorted(set(failures)):
+            print(f"    failed commit: {failure}", file=sys.stderr)
+    return {
+        "commits": len(latencies),
+        "failures": len(failures),
+        "commits_per_second": len(latencies) / elapsed if elapsed > 0 else 0.0,
+        "p50_ms": percentile(latencies, 0.5) * 1000,
+        "p99_ms": percentile(latencies, 0.99) * 1000,
+        "max_ms": (latencies[-1] if latencies else 0.0) * 1000,
+        "retries": sum(result["retries"] for result in results),
+        "max_retries": max(result["max_retries"] for result in results),
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Benchmark the commit throughput of concurrent DuckLake writers")
+    parser.add_argument("--extension", help="path of the ducklake extension to load (installs it if omitted)")
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 4, 16], help="writer threads per process")
+    parser.add_argument("--processes", type=int, nargs="+", default=[1], help="amount of writer processes")
+    parser.add_argument("--metadata", nargs="+", choices=["duckdb", "sqlite"], default=["duckdb", "sqlite"])
+    parser.add_argument("--workload", nargs="+", choices=["append", "delete", "mixed"], default=["append", "mixed"])
+    parser.add_argument("--commits", type=int, default=50, help="transactions committed by every writer")
+    parser.add_argument("--max-retry-count", type=int, default=100, help="the ducklake_max_retry_count setting")
+    parser.add_argument("--retry-wait-ms", type=int, default=10, help="the ducklake_retry_wait_ms setting")
+    parser.add_argument("--dir", help="directory in which the DuckLakes are created")
+    parser.add_argument("--verbose", action="store_true", help="print the errors of failed commits")
+    args = parser.parse_args()
+
+    header = (
+        f"{'metadata':<8} {'workload':<8} {'procs':>5} {'threads':>7} {'commits':>8} {'failed':>6} "
+        f"{'commits/s':>10} {'p50 ms':>9} {'p99 ms':>9} {'max ms':>9} {'retries':>8} {'max retries':>11}"
+    )
+    print(header)
+    for metadata in args.metadata:
+        for process_count in args.processes:
+            if metadata == "duckdb" and process_count > 1:
+                # a DuckDB database file can only be written to by a single process
+                print(f"skipping duckdb metadata with {process_count} processes", file=sys.stderr)
+                continue
+            for thread_count in args.threads:
+                for workload in args.workload:
+                    args.process_count = process_count
+                    args.thread_count = thread_count
+                    result = run_benchmark(args, metadata, workload)
+                    print(
+                        f"{metadata:<8} {workload:<8} {process_count:>5} {thread_count:>7} {result['commits']:>8} "
+                        f"{result['failures']:>6} {result['commits_per_second']:>10.1f} {result['p50_ms']:>9.2f} "
+                        f"{result['p99_ms']:>9.2f} {result['max_ms']:>9.2f} {result['retries']:>8} "
+                        f"{result['max_retries']:>11}",
+                        flush=True,
+                    )
+
+
+if __name__ == "__main__":
+    main()
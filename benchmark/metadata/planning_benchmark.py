@@ -0,0 +1,191 @@
+#!/usr/bin/python3
+"""
+Benchmark the planning cost of DuckLakes with large amounts of metadata.
+
+Every scenario builds a DuckLake whose metadata grows with the scale:
+    files      - a single table with <scale> data files
+    deletes    - a single table with <scale> data files that all have a delete file
+    snapshots  - a single table built up through <scale> snapshots
+    tables     - <scale> tables with a data file each
+For every DuckLake the benchmark measures, in a fresh database instance:
+    attach     - the time to ATTACH the DuckLake
+    first      - the time to plan the first query after attaching (the metadata has to be loaded)
+    cached     - the median time to plan the same query again
+    pruned     - the median time to run a query with a filter that prunes all but one data file
+
+The DuckLakes are built in --dir and are re-used by later runs, as building the larger ones takes a while.
+
+Example:
+    python3 benchmark/metadata/planning_benchmark.py \\
+        --extension build/release/extension/ducklake/ducklake.duckdb_extension \\
+        --scenario files deletes --scale 10000 100000 1000000 --dir /tmp/ducklake_planning
+"""
+
+import argparse
+import os
+import shutil
+import statistics
+import tempfile
+import time
+
+import duckdb
+
+# the amount of distinct values of the "part" column in the snapshots and tables scenarios
+PART_COUNT = 100
+
+
+def connect(args) -> duckdb.DuckDBPyConnection:
+    """
+    Create a new in-memory database with the DuckLake extension loaded.
+    """
+    con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    if args.extension:
+        con.execute(f"LOAD '{args.extension}'")
+    else:
+        con.execute("INSTALL ducklake")
+        con.execute("LOAD ducklake")
+    return con
+
+
+def attach(con: duckdb.DuckDBPyConnection, metadata: str, lake_dir: str) -> None:
+    """
+    Attach the DuckLake of the given metadata catalog type as "lake".
+    """
+    if metadata == "sqlite":
+        connection_string = f"sqlite:{os.path.join(lake_dir, 'metadata.sqlite')}"
+    else:
+        connection_string = os.path.join(lake_dir, "metadata.ducklake")
+    data_path = os.path.join(lake_dir, "data")
+    con.execute(f"ATTACH 'ducklake:{connection_string}' AS lake (DATA_PATH '{data_path}')")
+
+
+def build_files(con: duckdb.DuckDBPyConnection, scale: int, args) -> None:
+    # every partition value is written to its own data file
+    con.execute("CREATE TABLE lake.tbl(part INTEGER, val INTEGER)")
+    con.execute("ALTER TABLE lake.tbl SET PARTITIONED BY (part)")
+    con.execute(f"INSERT INTO lake.tbl SELECT i % {scale}, i FROM range({scale * args.rows_per_file}) t(i)")
+
+
+def build_deletes(con: duckdb.DuckDBPyConnection, scale: int, args) -> None:
+    build_files(con, scale, args)
+    # the values below the scale are all in different files - every data file gets a delete file
+    con.execute(f"DELETE FROM lake.tbl WHERE val < {scale}")
+
+
+def build_snapshots(con: duckdb.DuckDBPyConnection, scale: int, args) -> None:
+    con.execute("CREATE TABLE lake.tbl(part INTEGER, val INTEGER)")
+    for i in range(scale):
+        con.execute(f"INSERT INTO lake.tbl SELECT {i % PART_COUNT}, i FROM range({args.rows_per_file}) t(i)")
+
+
+def build_tables(con: duckdb.DuckDBPyConnection, scale: int, args) -> None:
+    con.execute("BEGIN")
+    for i in range(scale):
+        con.execute(
+            f"CREATE TABLE lake.tbl_{i} AS SELECT i % {PART_COUNT} AS part, i AS val "
+            f"FROM range({args.rows_per_file}) t(i)"
+        )
+    con.execute("COMMIT")
+
+
+SCENARIOS = {
+    "files": build_files,
+    "deletes": build_deletes,
+    "snapshots": build_snapshots,
+    "tables": build_tables,
+}
+
+
+def get_queries(scenario: str, scale: int) -> tuple:
+    """
+    Returns the query that is planned, and the query with a filter that prunes all but one file.
+    """
+    table_name = f"lake.tbl_{scale // 2}" if scenario == "tables" else "lake.tbl"
+    if scenario == "files" or scenario == "deletes":
+        part = scale // 2
+    else:
+        part = PART_COUNT // 2
+    query = f"SELECT SUM(val) FROM {table_name}"
+    pruned_query = f"SELECT SUM(val) FROM {table_name} WHERE part = {part}"
+    return query, pruned_query
+
+
+def build(args, scenario: str, scale: int, metadata: str) -> str:
+    """
+    Build the DuckLake of a scenario (if it has not been built by an earlier run) - returns its directory.
+    """
+    lake_dir = os.path.join(args.dir, f"{scenario}_{scale}_{metadata}")
+    ready_marker = os.path.join(lake_dir, "ready")
+    if os.path.exists(ready_marker):
+        return lake_dir
+    shutil.rmtree(lake_dir, ignore_errors=True)
+    os.makedirs(lake_dir)
+    start = time.perf_counter()
+    con = connect(args)
+    attach(con, metadata, lake_dir)
+    SCENARIOS[scenario](con, scale, args)
+    con.close()
+    print(f"built {scenario} ({scale}) with {metadata} metadata in {time.perf_counter() - start:.1f}s", flush=True)
+    open(ready_marker, "w").close()
+    return lake_dir
+
+
+def timed(con: duckdb.DuckDBPyConnection, query: str) -> float:
+    start = time.perf_counter()
+    con.execute(query).fetchall()
+    return (time.perf_counter() - start) * 1000
+
+
+def measure(args, scenario: str, scale: int, metadata: str, lake_dir: str) -> dict:
+    query, pruned_query = get_queries(scenario, scale)
+    # use a fresh database instance - so that nothing is cached by the catalog
+    con = connect(args)
+    start = time.perf_counter()
+    attach(con, metadata, lake_dir)
+    attach_ms = (time.perf_counter() - start) * 1000
+    first_ms = timed(con, f"EXPLAIN {query}")
+    cached_ms = statistics.median(timed(con, f"EXPLAIN {query}") for _ in range(args.repetitions))
+    pruned_ms = statistics.median(timed(con, pruned_query) for _ in range(args.repetitions))
+    con.close()
+    return {"attach_ms": attach_ms, "first_ms": first_ms, "cached_ms": cached_ms, "pruned_ms": pruned_ms}
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Benchmark the planning cost of DuckLakes with large metadata")
+    parser.add_argument("--extension", help="path of the ducklake extension to load (installs it if omitted)")
+    parser.add_argument("--scenario", nargs="+", choices=list(SCENARIOS.keys()), default=list(SCENARIOS.keys()))
+    parser.add_argument("--scale", type=int, nargs="+", default=[10000, 100000], help="amount of files/tables")
+    parser.add_argument("--metadata", nargs="+", choices=["duckdb", "sqlite"], default=["duckdb"])
+    parser.add_argument("--rows-per-file", type=int, default=10, help="rows in every data file")
+    parser.add_argument("--repetitions", type=int, default=5, help="repetitions of the cached measurements")
+    parser.add_argument("--dir", help="directory in which the DuckLakes are built (and re-used)")
+    args = parser.parse_args()
+    temp_dir = None
+    if not args.dir:
+        temp_dir = tempfile.mkdtemp(prefix="ducklake_planning_bench_")
+        args.dir = temp_dir
+
+    results = []
+    try:
+        for metadata in args.metadata:
+            for scenario in args.scenario:
+                for scale in args.scale:
+                    lake_dir = build(args, scenario, scale, metadata)
+                    results.append((metadata, scenario, scale, measure(args, scenario, scale, metadata, lake_dir)))
+    finally:
+        if temp_dir:
+            shutil.rmtree(temp_dir, ignore_errors=True)
+
+    print(
+        f"{'metadata':<8} {'scenario':<10} {'scale':>8} {'attach ms':>10} {'first ms':>10} {'cached ms':>10} "
+        f"{'pruned ms':>10}"
+    )
+    for metadata, scenario, scale, result in results:
+        print(
+            f"{metadata:<8} {scenario:<10} {scale:>8} {result['attach_ms']:>10.2f} {result['first_ms']:>10.2f} "
+            f"{result['cached_ms']:>10.2f} {result['pruned_ms']:>10.2f}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,32 @@
 #include "common/ducklake_data_file.hpp"
 
+#include "duckdb/common/string_util.hpp"
+
 namespace duckdb {
 
+static constexpr const char *LOCAL_INLINED_DELETE_PREFIX = "local-";
+
+string DuckLakeDeleteFile::GetInlinedDeletePath(DataFileIndex delete_file_id) {
+	return INLINED_DELETE_PREFIX + to_string(delete_file_id.index);
+}
+
+string DuckLakeDeleteFile::GetLocalInlinedDeletePath(const string &uuid) {
+	return INLINED_DELETE_PREFIX + string(LOCAL_INLINED_DELETE_PREFIX) + uuid;
+}
+
+bool DuckLakeDeleteFile::IsInlinedDeletePath(const string &path) {
+	return StringUtil::StartsWith(path, INLINED_DELETE_PREFIX);
+}
+
+DataFileIndex DuckLakeDeleteFile::GetInlinedDeleteFileId(const string &path) {
+	D_ASSERT(IsInlinedDeletePath(path));
+	auto id = path.substr(strlen(INLINED_DELETE_PREFIX));
+	if (StringUtil::StartsWith(id, LOCAL_INLINED_DELETE_PREFIX)) {
+		return DataFileIndex();
+	}
+	return DataFileIndex(StringUtil::ToUnsigned(id));
+}
+
 DuckLakeDataFile::DuckLakeDataFile(const DuckLakeDataFile &other) {
 	file_name = other.file_name;
 	row_count = other.row_count;
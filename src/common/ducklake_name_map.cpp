@@ -2,14 +2,25 @@
 
 namespace duckdb {
 
-hash_t DuckLakeNameMapEntry::GetHash() const {
-	hash_t result = Hash(source_name.c_str(), source_name.size());
-	for (auto &entry : child_entries) {
-		result ^= entry->GetHash();
+//! Combine the hashes of a list of entries - compatibility does not depend on the order of the entries, so neither
+//! can the hash. The hashes are summed (instead of XOR-ed) so that equal entries do not cancel each other out
+static hash_t GetListHash(const vector<unique_ptr<DuckLakeNameMapEntry>> &entries) {
+	hash_t result = Hash(entries.size());
+	for (auto &entry : entries) {
+		result += entry->GetHash();
 	}
 	return result;
 }
 
+hash_t DuckLakeNameMapEntry::GetHash() const {
+	// hash everything that is compared by IsCompatibleWith - so that maps of the same table that only differ in the
+	// fields they map to end up in different buckets
+	hash_t result = Hash(source_name.c_str(), source_name.size());
+	result = CombineHash(result, Hash(target_field_id.index));
+	result = CombineHash(result, Hash(hive_partition));
+	return CombineHash(result, GetListHash(child_entries));
+}
+
 bool DuckLakeNameMapEntry::ListIsCompatible(const vector<unique_ptr<DuckLakeNameMapEntry>> &left,
                                             const vector<unique_ptr<DuckLakeNameMapEntry>> &right) {
 	if (left.size() != right.size()) {
@@ -48,11 +59,7 @@ bool DuckLakeNameMapEntry::IsCompatibleWith(const DuckLakeNameMapEntry &other) c
 }
 
 hash_t DuckLakeNameMap::GetHash() const {
-	hash_t result = Hash(table_id.index);
-	for (auto &entry : column_maps) {
-		result ^= entry->GetHash();
-	}
-	return result;
+	return CombineHash(Hash(table_id.index), GetListHash(column_maps));
 }
 
 bool DuckLakeNameMap::IsCompatibleWith(const DuckLakeNameMap &other) const {
@@ -4,7 +4,12 @@
 #include "duckdb/common/string_util.hpp"
 #include "storage/ducklake_storage.hpp"
 #include "functions/ducklake_table_functions.hpp"
+#include "functions/ducklake_partition_functions.hpp"
+#include "storage/ducklake_scan.hpp"
 #include "storage/ducklake_secret.hpp"
+#include "storage/ducklake_aggregate_optimizer.hpp"
+#include "storage/ducklake_scan_order_optimizer.hpp"
+#include "storage/ducklake_merge_key_filter_optimizer.hpp"
 
 namespace duckdb {
 
@@ -13,6 +18,9 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
 	config.storage_extensions["ducklake"] = make_uniq<DuckLakeStorageExtension>();
+	config.optimizer_extensions.push_back(DuckLakeAggregateOptimizer());
+	config.optimizer_extensions.push_back(DuckLakeScanOrderOptimizer());
+	config.optimizer_extensions.push_back(DuckLakeMergeKeyFilterOptimizer());
 
 	config.AddExtensionOption("ducklake_max_retry_count",
 	                          "The maximum amount of retry attempts for a ducklake transaction", LogicalType::UBIGINT,
@@ -21,6 +29,19 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          Value::UBIGINT(100), nullptr, SetScope::GLOBAL);
 	config.AddExtensionOption("ducklake_retry_backoff", "Backoff factor for exponentially increasing retry wait time",
 	                          LogicalType::DOUBLE, Value::DOUBLE(1.5), nullptr, SetScope::GLOBAL);
+	config.AddExtensionOption("ducklake_serialize_commits",
+	                          "Commit transactions to the same DuckLake from this process one at a time, so that they "
+	                          "do not have to retry against each other",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false), nullptr, SetScope::GLOBAL);
+	config.AddExtensionOption("ducklake_group_commit_window_ms",
+	                          "Time (in milliseconds) a commit that only inserts data files waits for other such "
+	                          "commits to the same DuckLake from this process, which are then committed together in a "
+	                          "single snapshot (0 to disable)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0), nullptr, SetScope::GLOBAL);
+	config.AddExtensionOption("ducklake_metadata_latency_ms",
+	                          "Latency (in milliseconds) added to every query sent to the metadata catalog - to "
+	                          "simulate a metadata catalog across the network",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0), nullptr, SetScope::GLOBAL);
 
 	DuckLakeSnapshotsFunction snapshots;
 	loader.RegisterFunction(snapshots);
@@ -40,6 +61,9 @@ static void LoadInternal(ExtensionLoader &loader) {
 	auto rewrite_files = DuckLakeRewriteDataFilesFunction::GetFunctions();
 	loader.RegisterFunction(rewrite_files);
 
+	auto consolidate_deletes = DuckLakeConsolidateDeletesFunction::GetFunctions();
+	loader.RegisterFunction(consolidate_deletes);
+
 	DuckLakeCleanupOldFilesFunction cleanup_old_files;
 	loader.RegisterFunction(cleanup_old_files);
 
@@ -52,6 +76,15 @@ static void LoadInternal(ExtensionLoader &loader) {
 	DuckLakeFlushInlinedDataFunction flush_inlined_data;
 	loader.RegisterFunction(flush_inlined_data);
 
+	DuckLakeFlushInsertBufferFunction flush_insert_buffer;
+	loader.RegisterFunction(flush_insert_buffer);
+
+	DuckLakeTailFunction tail;
+	loader.RegisterFunction(tail);
+
+	DuckLakeRefreshMaterializedViewFunction refresh_materialized_view;
+	loader.RegisterFunction(refresh_materialized_view);
+
 	DuckLakeSetOptionFunction set_options;
 	loader.RegisterFunction(set_options);
 
@@ -76,6 +109,25 @@ static void LoadInternal(ExtensionLoader &loader) {
 	DuckLakeLastCommittedSnapshotFunction last_committed;
 	loader.RegisterFunction(last_committed);
 
+	DuckLakeMetadataStatsFunction metadata_stats;
+	loader.RegisterFunction(metadata_stats);
+
+	DuckLakeCommitStatsFunction commit_stats;
+	loader.RegisterFunction(commit_stats);
+
+	DuckLakeWriteManifestsFunction write_manifests;
+	loader.RegisterFunction(write_manifests);
+
+	DuckLakeArchiveFilesFunction archive_files;
+	loader.RegisterFunction(archive_files);
+
+	// serialized scans of DuckLake tables
+	loader.RegisterFunction(DuckLakeFunctions::GetDuckLakeScanDeserializeFunction());
+
+	// partition transforms
+	loader.RegisterFunction(DuckLakePartitionFunctions::GetBucketFunctions());
+	loader.RegisterFunction(DuckLakePartitionFunctions::GetTruncateFunctions());
+
 	// secrets
 	auto secret_type = DuckLakeSecret::GetSecretType();
 	loader.RegisterSecretType(secret_type);
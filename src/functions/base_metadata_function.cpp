@@ -1,6 +1,10 @@
 #include "functions/ducklake_table_functions.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/main/database_manager.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 
 namespace duckdb {
 
@@ -22,6 +26,56 @@ Catalog &BaseMetadataFunction::GetCatalog(ClientContext &context, const Value &i
 	return catalog;
 }
 
+vector<MetadataColumnFilter> BaseMetadataFunction::GetColumnFilters(LogicalGet &get,
+                                                                   const vector<unique_ptr<Expression>> &filters,
+                                                                   idx_t column_index, const LogicalType &type) {
+	vector<MetadataColumnFilter> result;
+	auto &column_ids = get.GetColumnIds();
+	for (auto &filter : filters) {
+		if (filter->GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+			continue;
+		}
+		auto &comparison = filter->Cast<BoundComparisonExpression>();
+		auto comparison_type = comparison.GetExpressionType();
+		switch (comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			break;
+		default:
+			continue;
+		}
+		optional_ptr<Expression> column = comparison.left.get();
+		optional_ptr<Expression> constant = comparison.right.get();
+		if (column->GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+			// constant on the left side - flip the comparison
+			std::swap(column, constant);
+			comparison_type = FlipComparisonExpression(comparison_type);
+		}
+		if (column->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF ||
+		    constant->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			continue;
+		}
+		auto &binding = column->Cast<BoundColumnRefExpression>().binding;
+		if (binding.table_index != get.table_index || binding.column_index >= column_ids.size() ||
+		    column_ids[binding.column_index].GetPrimaryIndex() != column_index) {
+			continue;
+		}
+		auto &value = constant->Cast<BoundConstantExpression>().value;
+		if (value.IsNull() || value.type() != type) {
+			// only comparisons in the type of the column are used - so they have the same result in the metadata
+			continue;
+		}
+		MetadataColumnFilter column_filter;
+		column_filter.comparison = comparison_type;
+		column_filter.constant = value;
+		result.push_back(std::move(column_filter));
+	}
+	return result;
+}
+
 struct MetadataFunctionData : public GlobalTableFunctionState {
 	MetadataFunctionData() : offset(0) {
 	}
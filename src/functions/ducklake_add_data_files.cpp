@@ -1,10 +1,16 @@
 #include "functions/ducklake_table_functions.hpp"
+#include "storage/ducklake_catalog.hpp"
 #include "storage/ducklake_transaction.hpp"
 #include "common/ducklake_util.hpp"
 #include "storage/ducklake_transaction_changes.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_insert.hpp"
 #include "duckdb/common/constants.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
@@ -20,6 +26,10 @@ struct DuckLakeAddDataFilesData : public TableFunctionData {
 	bool allow_missing = false;
 	bool ignore_extra_columns = false;
 	HivePartitioningType hive_partitioning = HivePartitioningType::AUTOMATIC;
+	//! The amount of connections used to read the metadata of the files (defaults to the amount of threads)
+	optional_idx max_concurrency;
+	//! If set, the files are added in batches of this size - each batch is committed as its own snapshot
+	optional_idx batch_size;
 };
 
 static unique_ptr<FunctionData> DuckLakeAddDataFilesBind(ClientContext &context, TableFunctionBindInput &input,
@@ -52,6 +62,18 @@ static unique_ptr<FunctionData> DuckLakeAddDataFilesBind(ClientContext &context,
 		} else if (lower == "hive_partitioning") {
 			result->hive_partitioning =
 			    BooleanValue::Get(entry.second) ? HivePartitioningType::YES : HivePartitioningType::NO;
+		} else if (lower == "max_concurrency") {
+			auto max_concurrency = UBigIntValue::Get(entry.second);
+			if (max_concurrency == 0) {
+				throw InvalidInputException("max_concurrency must be at least 1");
+			}
+			result->max_concurrency = max_concurrency;
+		} else if (lower == "batch_size") {
+			auto batch_size = UBigIntValue::Get(entry.second);
+			if (batch_size == 0) {
+				throw InvalidInputException("batch_size must be at least 1");
+			}
+			result->batch_size = batch_size;
 		} else if (lower != "schema") {
 			throw InternalException("Unknown named parameter %s for add_files", entry.first);
 		}
@@ -113,16 +135,28 @@ struct ParquetFileMetadata {
 struct DuckLakeFileProcessor {
 public:
 	DuckLakeFileProcessor(DuckLakeTransaction &transaction, const DuckLakeAddDataFilesData &bind_data)
-	    : transaction(transaction), table(bind_data.table), allow_missing(bind_data.allow_missing),
-	      ignore_extra_columns(bind_data.ignore_extra_columns), hive_partitioning(bind_data.hive_partitioning) {
+	    : DuckLakeFileProcessor(transaction, bind_data, bind_data.table) {
+	}
+	DuckLakeFileProcessor(DuckLakeTransaction &transaction, const DuckLakeAddDataFilesData &bind_data,
+	                      DuckLakeTableEntry &table)
+	    : transaction(transaction), table(table), allow_missing(bind_data.allow_missing),
+	      ignore_extra_columns(bind_data.ignore_extra_columns), hive_partitioning(bind_data.hive_partitioning),
+	      max_concurrency(bind_data.max_concurrency) {
 	}
 
-	vector<DuckLakeDataFile> AddFiles(const vector<string> &globs);
+	//! Expand the globs into the list of files they match
+	vector<string> GlobFiles(const vector<string> &globs);
+	//! Map a set of files to the table
+	vector<DuckLakeDataFile> AddFiles(const vector<string> &files);
 
 private:
-	void ReadParquetSchema(const string &glob);
-	void ReadParquetStats(const string &glob);
-	void ReadParquetFileMetadata(const string &glob);
+	//! Expand a glob into the list of files it matches
+	vector<string> GlobFiles(const string &glob);
+	//! Read the schema, stats and file metadata of a set of files - the files are read in parallel batches
+	void ReadParquetMetadata(const vector<string> &files);
+	void ReadParquetSchema(QueryResult &result);
+	void ReadParquetStats(QueryResult &result);
+	void ReadParquetFileMetadata(QueryResult &result);
 	DuckLakeDataFile AddFileToTable(ParquetFileMetadata &file);
 	unique_ptr<DuckLakeNameMapEntry> MapColumn(ParquetFileMetadata &file_metadata, ParquetColumn &column,
 	                                           const DuckLakeFieldId &field_id, string prefix);
@@ -144,11 +178,12 @@ private:
 	bool ignore_extra_columns;
 	map<string, string> hive_partitions;
 	HivePartitioningType hive_partitioning;
+	optional_idx max_concurrency;
 	unordered_map<string, unique_ptr<ParquetFileMetadata>> parquet_files;
 };
 
-void DuckLakeFileProcessor::ReadParquetSchema(const string &glob) {
-	auto result = transaction.Query(StringUtil::Format(R"(
+static string GetParquetSchemaQuery(const string &files) {
+	return StringUtil::Format(R"(
 WITH base AS (
   SELECT file_name, name, type, num_children, converted_type, scale, precision, field_id, logical_type
   FROM parquet_schema(%s)
@@ -159,15 +194,31 @@ SELECT * EXCLUDE (flattened_column_id)
 FROM partitioned
 ORDER BY file_name, flattened_column_id;
 )",
-	                                                   SQLString(glob)));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to add data files to DuckLake: ");
-	}
+	                          files);
+}
+
+static string GetParquetStatsQuery(const string &files) {
+	return StringUtil::Format(R"(
+SELECT file_name, column_id, coalesce(stats_min, stats_min_value), coalesce(stats_max, stats_max_value), stats_null_count, total_compressed_size, geo_bbox, geo_types
+FROM parquet_metadata(%s)
+)",
+	                          files);
+}
+
+static string GetParquetFileMetadataQuery(const string &files) {
+	return StringUtil::Format(R"(
+SELECT file_name, num_rows, footer_size, file_size_bytes
+FROM parquet_file_metadata(%s)
+)",
+	                          files);
+}
+
+void DuckLakeFileProcessor::ReadParquetSchema(QueryResult &result) {
 	unique_ptr<ParquetFileMetadata> file;
 	vector<reference<ParquetColumn>> current_column;
 	vector<idx_t> child_counts;
 	idx_t column_id = 0;
-	for (auto &row : *result) {
+	for (auto &row : result) {
 		auto filename = row.GetValue<string>(0);
 		auto child_count = row.IsNull(3) ? 0 : row.GetValue<idx_t>(3);
 		if (!file || file->filename != filename) {
@@ -252,16 +303,8 @@ ORDER BY file_name, flattened_column_id;
 	}
 }
 
-void DuckLakeFileProcessor::ReadParquetStats(const string &glob) {
-	auto result = transaction.Query(StringUtil::Format(R"(
-SELECT file_name, column_id, coalesce(stats_min, stats_min_value), coalesce(stats_max, stats_max_value), stats_null_count, total_compressed_size, geo_bbox, geo_types
-FROM parquet_metadata(%s)
-)",
-	                                                   SQLString(glob)));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to add data files to DuckLake: ");
-	}
-	for (auto &row : *result) {
+void DuckLakeFileProcessor::ReadParquetStats(QueryResult &result) {
+	for (auto &row : result) {
 		auto filename = row.GetValue<string>(0);
 		auto entry = parquet_files.find(filename);
 		if (entry == parquet_files.end()) {
@@ -348,17 +391,8 @@ FROM parquet_metadata(%s)
 	}
 }
 
-void DuckLakeFileProcessor::ReadParquetFileMetadata(const string &glob) {
-
-	auto result = transaction.Query(StringUtil::Format(R"(
-SELECT file_name, num_rows, footer_size, file_size_bytes
-FROM parquet_file_metadata(%s)
-)",
-	                                                   SQLString(glob)));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to add data files to DuckLake: ");
-	}
-	for (auto &row : *result) {
+void DuckLakeFileProcessor::ReadParquetFileMetadata(QueryResult &result) {
+	for (auto &row : result) {
 		auto filename = row.GetValue<string>(0);
 		auto entry = parquet_files.find(filename);
 		if (entry == parquet_files.end()) {
@@ -908,16 +942,125 @@ DuckLakeDataFile DuckLakeFileProcessor::AddFileToTable(ParquetFileMetadata &file
 	return result;
 }
 
-vector<DuckLakeDataFile> DuckLakeFileProcessor::AddFiles(const vector<string> &globs) {
-	// fetch the metadata, stats and columns from the various files
+vector<string> DuckLakeFileProcessor::GlobFiles(const string &glob) {
+	auto result = transaction.Query(StringUtil::Format("SELECT file FROM glob(%s) ORDER BY file", SQLString(glob)));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to add data files to DuckLake: ");
+	}
+	vector<string> files;
+	for (auto &row : *result) {
+		files.push_back(row.GetValue<string>(0));
+	}
+	if (files.empty()) {
+		throw InvalidInputException(
+		    "Failed to add data files to DuckLake: No files found that match the pattern \"%s\"", glob);
+	}
+	return files;
+}
+
+//! The amount of files whose metadata is read by a single set of metadata queries
+static constexpr idx_t ADD_FILES_BATCH_SIZE = 100;
+
+struct DuckLakeParquetMetadataBatch {
+	string files;
+	unique_ptr<QueryResult> schema;
+	unique_ptr<QueryResult> stats;
+	unique_ptr<QueryResult> file_metadata;
+};
+
+void DuckLakeFileProcessor::ReadParquetMetadata(const vector<string> &files) {
+	vector<DuckLakeParquetMetadataBatch> batches;
+	for (idx_t batch_start = 0; batch_start < files.size(); batch_start += ADD_FILES_BATCH_SIZE) {
+		auto batch_end = MinValue<idx_t>(batch_start + ADD_FILES_BATCH_SIZE, files.size());
+		DuckLakeParquetMetadataBatch batch;
+		for (idx_t file_idx = batch_start; file_idx < batch_end; file_idx++) {
+			batch.files += batch.files.empty() ? "[" : ", ";
+			batch.files += SQLString(files[file_idx]);
+		}
+		batch.files += "]";
+		batches.push_back(std::move(batch));
+	}
+	// the footers of the files are fetched by separate connections in parallel - the latency of fetching the footers
+	// (e.g. from an object store) dominates the time spent here
+	auto &db = transaction.GetCatalog().GetDatabase();
+	mutex lock;
+	idx_t next_batch = 0;
+	vector<ErrorData> errors;
+	auto read_batches = [&]() {
+		try {
+			Connection con(db);
+			while (true) {
+				idx_t batch_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_batch >= batches.size() || !errors.empty()) {
+						return;
+					}
+					batch_idx = next_batch++;
+				}
+				auto &batch = batches[batch_idx];
+				// query the parquet_schema to figure out the schema for each of the columns
+				batch.schema = con.Query(GetParquetSchemaQuery(batch.files));
+				// query the parquet_metadata to get the stats for each of the columns
+				batch.stats = con.Query(GetParquetStatsQuery(batch.files));
+				// read parquet file metadata
+				batch.file_metadata = con.Query(GetParquetFileMetadataQuery(batch.files));
+				for (auto result : {batch.schema.get(), batch.stats.get(), batch.file_metadata.get()}) {
+					if (result->HasError()) {
+						lock_guard<mutex> guard(lock);
+						errors.push_back(result->GetErrorObject());
+						return;
+					}
+				}
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			errors.emplace_back(ex);
+		}
+	};
+#ifndef DUCKDB_NO_THREADS
+	auto thread_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(db).NumberOfThreads());
+	if (max_concurrency.IsValid()) {
+		thread_count = max_concurrency.GetIndex();
+	}
+	thread_count = MaxValue<idx_t>(MinValue<idx_t>(thread_count, batches.size()), 1);
+	vector<thread> threads;
+	for (idx_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(read_batches);
+	}
+	read_batches();
+	for (auto &read_thread : threads) {
+		read_thread.join();
+	}
+#else
+	read_batches();
+#endif
+	if (!errors.empty()) {
+		errors[0].Throw("Failed to add data files to DuckLake: ");
+	}
+	// process the metadata of the batches in order
+	for (auto &batch : batches) {
+		ReadParquetSchema(*batch.schema);
+		ReadParquetStats(*batch.stats);
+		ReadParquetFileMetadata(*batch.file_metadata);
+		batch.schema.reset();
+		batch.stats.reset();
+		batch.file_metadata.reset();
+	}
+}
+
+vector<string> DuckLakeFileProcessor::GlobFiles(const vector<string> &globs) {
+	vector<string> files;
 	for (auto &glob : globs) {
-		// query the parquet_schema to figure out the schema for each of the columns
-		ReadParquetSchema(glob);
-		// query the parquet_metadata to get the stats for each of the columns
-		ReadParquetStats(glob);
-		// read parquet file metadata
-		ReadParquetFileMetadata(glob);
+		auto glob_files = GlobFiles(glob);
+		files.insert(files.end(), glob_files.begin(), glob_files.end());
 	}
+	return files;
+}
+
+vector<DuckLakeDataFile> DuckLakeFileProcessor::AddFiles(const vector<string> &files) {
+	// fetch the metadata, stats and columns from the various files
+	ReadParquetMetadata(files);
 
 	// now we have obtained a list of files to add together with the relevant information (statistics, file size, ...)
 	// we need to create a mapping from the columns in the file to the columns in the table
@@ -935,6 +1078,55 @@ vector<DuckLakeDataFile> DuckLakeFileProcessor::AddFiles(const vector<string> &g
 	return written_files;
 }
 
+static void AddDataFilesInBatches(ClientContext &context, DuckLakeTransaction &transaction,
+                                  const DuckLakeAddDataFilesData &bind_data) {
+	// every batch is committed as its own snapshot in a separate transaction - this keeps the memory usage bounded
+	// by the batch size, and preserves the progress made if a later batch fails
+	auto &table = bind_data.table;
+	if (table.IsTransactionLocal()) {
+		throw InvalidInputException("Failed to add data files to DuckLake: batch_size cannot be used for a table that "
+		                            "was created in the current transaction");
+	}
+	auto &catalog = transaction.GetCatalog();
+	auto table_id = table.GetTableId();
+	DuckLakeFileProcessor glob_processor(transaction, bind_data);
+	auto files = glob_processor.GlobFiles(bind_data.globs);
+
+	// skip files that are already part of the table - this allows an interrupted call to be resumed by re-running it
+	unordered_set<string> existing_files;
+	for (auto &entry : catalog.GetFilesForTable(transaction, table, transaction.GetSnapshot())) {
+		existing_files.insert(entry.file.path);
+	}
+	vector<string> files_to_add;
+	for (auto &file : files) {
+		if (existing_files.find(file) == existing_files.end()) {
+			files_to_add.push_back(file);
+		}
+	}
+
+	auto batch_size = bind_data.batch_size.GetIndex();
+	for (idx_t batch_start = 0; batch_start < files_to_add.size(); batch_start += batch_size) {
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		auto batch_end = MinValue<idx_t>(batch_start + batch_size, files_to_add.size());
+		vector<string> batch(files_to_add.begin() + NumericCast<int64_t>(batch_start),
+		                     files_to_add.begin() + NumericCast<int64_t>(batch_end));
+
+		Connection con(catalog.GetDatabase());
+		con.BeginTransaction();
+		auto &batch_transaction = DuckLakeTransaction::Get(*con.context, catalog);
+		auto entry = catalog.GetEntryById(batch_transaction, batch_transaction.GetSnapshot(), table_id);
+		if (!entry) {
+			throw InvalidInputException(
+			    "Failed to add data files to DuckLake: table \"%s\" was dropped while adding files", table.name);
+		}
+		DuckLakeFileProcessor processor(batch_transaction, bind_data, entry->Cast<DuckLakeTableEntry>());
+		batch_transaction.AppendFiles(table_id, processor.AddFiles(batch));
+		con.Commit();
+	}
+}
+
 static void DuckLakeAddDataFilesExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &state = data_p.global_state->Cast<DuckLakeAddDataFilesState>();
 	auto &bind_data = data_p.bind_data->Cast<DuckLakeAddDataFilesData>();
@@ -943,8 +1135,15 @@ static void DuckLakeAddDataFilesExecute(ClientContext &context, TableFunctionInp
 	if (state.finished) {
 		return;
 	}
+	if (bind_data.batch_size.IsValid()) {
+		AddDataFilesInBatches(context, transaction, bind_data);
+		state.finished = true;
+		return;
+	}
 	DuckLakeFileProcessor processor(transaction, bind_data);
-	auto files_to_add = processor.AddFiles(bind_data.globs);
+	// expand the globs once - the metadata of the matching files is then read in batches
+	auto files = processor.GlobFiles(bind_data.globs);
+	auto files_to_add = processor.AddFiles(files);
 	// add the files
 	transaction.AppendFiles(bind_data.table.GetTableId(), std::move(files_to_add));
 	state.finished = true;
@@ -957,6 +1156,8 @@ DuckLakeAddDataFilesFunction::DuckLakeAddDataFilesFunction()
 	named_parameters["ignore_extra_columns"] = LogicalType::BOOLEAN;
 	named_parameters["hive_partitioning"] = LogicalType::BOOLEAN;
 	named_parameters["schema"] = LogicalType::VARCHAR;
+	named_parameters["max_concurrency"] = LogicalType::UBIGINT;
+	named_parameters["batch_size"] = LogicalType::UBIGINT;
 }
 
 } // namespace duckdb
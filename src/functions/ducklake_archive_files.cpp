@@ -0,0 +1,88 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_transaction.hpp"
+
+namespace duckdb {
+
+struct ArchiveFilesBindData : public TableFunctionData {
+	explicit ArchiveFilesBindData(Catalog &catalog) : catalog(catalog) {
+	}
+
+	Catalog &catalog;
+	//! Only archive the files that ended in snapshots committed at or before this time
+	Value older_than;
+};
+
+static unique_ptr<FunctionData> DuckLakeArchiveFilesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                         vector<LogicalType> &return_types, vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto result = make_uniq<ArchiveFilesBindData>(catalog);
+	for (auto &entry : input.named_parameters) {
+		if (StringUtil::CIEquals(entry.first, "older_than")) {
+			result->older_than = entry.second;
+		} else {
+			throw InternalException("Unsupported named parameter for ducklake_archive_files");
+		}
+	}
+
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("archive_snapshot");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("data_file_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("delete_file_count");
+	return std::move(result);
+}
+
+struct ArchiveFilesData : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeArchiveFilesInit(ClientContext &context,
+                                                                     TableFunctionInitInput &input) {
+	return make_uniq<ArchiveFilesData>();
+}
+
+static void DuckLakeArchiveFilesExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<ArchiveFilesData>();
+	if (state.finished) {
+		return;
+	}
+	auto &bind_data = data_p.bind_data->Cast<ArchiveFilesBindData>();
+	auto &transaction = DuckLakeTransaction::Get(context, bind_data.catalog);
+
+	// by default all files that ended up to (and including) the current snapshot are archived
+	DuckLakeSnapshot snapshot;
+	if (bind_data.older_than.IsNull()) {
+		snapshot = transaction.GetSnapshot();
+	} else {
+		BoundAtClause at_clause("timestamp", bind_data.older_than);
+		snapshot = transaction.GetSnapshot(&at_clause);
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto archive_info = metadata_manager.ArchiveFiles(snapshot.snapshot_id);
+
+	// store the new archive snapshot - queries of older snapshots include the archive tables from now on
+	// other transactions load the archive snapshot from the metadata catalog, so a rolled back archive is never seen
+	if (archive_info.archive_snapshot > 0) {
+		DuckLakeConfigOption option;
+		option.option.key = DuckLakeArchiveInfo::OPTION_NAME;
+		option.option.value = to_string(archive_info.archive_snapshot);
+		transaction.SetConfigOptionOnCommit(option);
+	}
+
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(archive_info.archive_snapshot)));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(archive_info.data_file_count)));
+	output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(archive_info.delete_file_count)));
+	output.SetCardinality(1);
+	state.finished = true;
+}
+
+DuckLakeArchiveFilesFunction::DuckLakeArchiveFilesFunction()
+    : TableFunction("ducklake_archive_files", {LogicalType::VARCHAR}, DuckLakeArchiveFilesExecute,
+                    DuckLakeArchiveFilesBind, DuckLakeArchiveFilesInit) {
+	named_parameters["older_than"] = LogicalType::TIMESTAMP_TZ;
+}
+
+} // namespace duckdb
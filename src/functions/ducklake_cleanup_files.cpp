@@ -1,6 +1,9 @@
 #include "functions/ducklake_table_functions.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/main/database_manager.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
 #include "storage/ducklake_catalog.hpp"
 #include "storage/ducklake_transaction.hpp"
 
@@ -45,12 +48,72 @@ struct CleanupBindData : public TableFunctionData {
 	vector<DuckLakeFileForCleanup> files;
 	//! If we are going to delete the files for real or not
 	bool dry_run = false;
+	//! The amount of files that are removed concurrently
+	idx_t max_concurrency = 16;
 	bool default_interval = false;
 
 	CleanupType type;
 	string timestamp_filter;
+	//! Only the files in these directories are examined for orphaned files (if set)
+	vector<string> directories;
+	bool restrict_directories = false;
+	//! The table whose directory is examined by an incremental orphan cleanup - stored as checkpoint after the run
+	optional_idx checkpoint_table_id;
 };
 
+//! The option in which incremental orphan cleanups store the last table whose directory was examined
+static constexpr const char *ORPHAN_CLEANUP_CHECKPOINT = "orphan_cleanup_checkpoint";
+
+//! Determine the directories that are examined by an orphan cleanup
+static void BindOrphanCleanupDirectories(ClientContext &context, DuckLakeCatalog &catalog, CleanupBindData &result,
+                                         const string &prefix, optional_idx since_snapshot, bool incremental) {
+	auto function_name = result.GetFunctionName();
+	if (!prefix.empty()) {
+		if (since_snapshot.IsValid() || incremental) {
+			throw InvalidInputException("%s: prefix cannot be combined with since_snapshot or incremental",
+			                            function_name);
+		}
+		auto &separator = catalog.Separator();
+		auto directory = catalog.DataPath() + StringUtil::Replace(prefix, "/", separator);
+		if (!StringUtil::EndsWith(directory, separator)) {
+			directory += separator;
+		}
+		result.directories.push_back(std::move(directory));
+		result.restrict_directories = true;
+		return;
+	}
+	if (!since_snapshot.IsValid() && !incremental) {
+		// examine the entire data path
+		return;
+	}
+	auto &transaction = DuckLakeTransaction::Get(context, catalog);
+	auto table_directories = transaction.GetMetadataManager().GetTableDirectories(since_snapshot);
+	result.restrict_directories = true;
+	if (table_directories.empty()) {
+		return;
+	}
+	if (!incremental) {
+		for (auto &table_directory : table_directories) {
+			result.directories.push_back(std::move(table_directory.path));
+		}
+		return;
+	}
+	// examine the directory of the table following the checkpoint - wrapping around after the last table
+	auto checkpoint = catalog.GetConfigOption<string>(ORPHAN_CLEANUP_CHECKPOINT, {}, {}, "");
+	idx_t table_idx = 0;
+	if (!checkpoint.empty()) {
+		auto checkpoint_table_id = Value(checkpoint).DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		for (idx_t i = 0; i < table_directories.size(); i++) {
+			if (table_directories[i].table_id.index > checkpoint_table_id) {
+				table_idx = i;
+				break;
+			}
+		}
+	}
+	result.checkpoint_table_id = table_directories[table_idx].table_id.index;
+	result.directories.push_back(std::move(table_directories[table_idx].path));
+}
+
 static unique_ptr<FunctionData> CleanupBind(ClientContext &context, TableFunctionBindInput &input,
                                             vector<LogicalType> &return_types, vector<string> &names,
                                             CleanupType type) {
@@ -59,10 +122,14 @@ static unique_ptr<FunctionData> CleanupBind(ClientContext &context, TableFunctio
 
 	auto &ducklake_catalog = reinterpret_cast<DuckLakeCatalog &>(catalog);
 	const auto older_than_default = ducklake_catalog.GetConfigOption<string>("delete_older_than", {}, {}, "2 days");
+	result->max_concurrency = ducklake_catalog.GetConfigOption<idx_t>("cleanup_max_concurrency", {}, {}, 16);
 
 	timestamp_tz_t from_timestamp;
 	bool has_timestamp = false;
 	bool cleanup_all = false;
+	string prefix;
+	optional_idx since_snapshot;
+	bool incremental = false;
 	for (auto &entry : input.named_parameters) {
 		if (StringUtil::CIEquals(entry.first, "dry_run")) {
 			result->dry_run = true;
@@ -71,6 +138,14 @@ static unique_ptr<FunctionData> CleanupBind(ClientContext &context, TableFunctio
 		} else if (StringUtil::CIEquals(entry.first, "older_than")) {
 			from_timestamp = entry.second.GetValue<timestamp_tz_t>();
 			has_timestamp = true;
+		} else if (StringUtil::CIEquals(entry.first, "max_concurrency")) {
+			result->max_concurrency = UBigIntValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "prefix")) {
+			prefix = StringValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "since_snapshot")) {
+			since_snapshot = UBigIntValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "incremental")) {
+			incremental = BooleanValue::Get(entry.second);
 		} else {
 			throw InternalException("Unsupported named parameter for %s", result->GetFunctionName());
 		}
@@ -82,6 +157,9 @@ static unique_ptr<FunctionData> CleanupBind(ClientContext &context, TableFunctio
 		    "deletion via e.g., CALL ducklake.set_option('delete_older_than', '1 week');",
 		    result->GetFunctionName());
 	}
+	if (result->max_concurrency == 0) {
+		throw InvalidInputException("%s: max_concurrency must be at least 1", result->GetFunctionName());
+	}
 	if (has_timestamp) {
 		result->timestamp_filter = Timestamp::ToString(timestamp_t(from_timestamp.value));
 	} else if (!cleanup_all && !older_than_default.empty()) {
@@ -91,7 +169,15 @@ static unique_ptr<FunctionData> CleanupBind(ClientContext &context, TableFunctio
 
 	auto &transaction = DuckLakeTransaction::Get(context, catalog);
 	auto &metadata_manager = transaction.GetMetadataManager();
-	result->files = metadata_manager.GetFilesForCleanup(result->GetFilter(), type, ducklake_catalog.Separator());
+	if (type == CleanupType::ORPHANED_FILES) {
+		BindOrphanCleanupDirectories(context, ducklake_catalog, *result, prefix, since_snapshot, incremental);
+	}
+	if (!result->restrict_directories) {
+		result->files = metadata_manager.GetFilesForCleanup(result->GetFilter(), type, ducklake_catalog.Separator());
+	} else if (!result->directories.empty()) {
+		result->files = metadata_manager.GetOrphanFilesForCleanup(result->GetFilter(), ducklake_catalog.Separator(),
+		                                                          result->directories);
+	}
 
 	return_types.emplace_back(LogicalType::VARCHAR);
 	names.emplace_back("path");
@@ -122,26 +208,96 @@ unique_ptr<GlobalTableFunctionState> DuckLakeCleanupInit(ClientContext &context,
 	return std::move(result);
 }
 
+//! The amount of files that are removed (and, for old files, removed from the catalog) together
+static constexpr idx_t CLEANUP_BATCH_SIZE = 1000;
+
+static void RemoveCleanupFileBatch(ClientContext &context, const CleanupBindData &data, idx_t batch_start,
+                                   idx_t batch_end) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	mutex lock;
+	idx_t next_file = batch_start;
+	vector<ErrorData> errors;
+	auto remove_files = [&]() {
+		try {
+			while (true) {
+				idx_t file_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_file >= batch_end || !errors.empty()) {
+						return;
+					}
+					file_idx = next_file++;
+				}
+				fs.TryRemoveFile(data.files[file_idx].path);
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			errors.emplace_back(ex);
+		}
+	};
+#ifndef DUCKDB_NO_THREADS
+	auto thread_count = MinValue<idx_t>(data.max_concurrency, batch_end - batch_start);
+	vector<thread> threads;
+	for (idx_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(remove_files);
+	}
+	remove_files();
+	for (auto &remove_thread : threads) {
+		remove_thread.join();
+	}
+#else
+	remove_files();
+#endif
+	if (!errors.empty()) {
+		errors[0].Throw();
+	}
+}
+
+//! Remove the files in batches - the files within a batch are removed concurrently
+//! Old files are removed from the catalog batch by batch in a separate transaction, so an interrupted cleanup keeps the
+//! progress it made
+static void RemoveCleanupFiles(ClientContext &context, const CleanupBindData &data) {
+	for (idx_t batch_start = 0; batch_start < data.files.size(); batch_start += CLEANUP_BATCH_SIZE) {
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		auto batch_end = MinValue<idx_t>(batch_start + CLEANUP_BATCH_SIZE, data.files.size());
+		RemoveCleanupFileBatch(context, data, batch_start, batch_end);
+		if (data.type != CleanupType::OLD_FILES) {
+			continue;
+		}
+		// If we are removing old files, we need to remove them from the catalog
+		vector<DuckLakeFileForCleanup> removed_files(data.files.begin() + NumericCast<int64_t>(batch_start),
+		                                             data.files.begin() + NumericCast<int64_t>(batch_end));
+		Connection con(data.catalog.GetDatabase());
+		con.BeginTransaction();
+		auto &transaction = DuckLakeTransaction::Get(*con.context, data.catalog);
+		transaction.GetMetadataManager().RemoveFilesScheduledForCleanup(removed_files);
+		con.Commit();
+	}
+}
+
 void DuckLakeCleanupExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &data = data_p.bind_data->Cast<CleanupBindData>();
 	auto &state = data_p.global_state->Cast<DuckLakeCleanupData>();
-	if (state.offset >= data.files.size()) {
-		return;
-	}
-	if (!state.executed && !data.dry_run) {
-		// delete the files
-		auto &fs = FileSystem::GetFileSystem(context);
-		for (auto &file : data.files) {
-			fs.TryRemoveFile(file.path);
-		}
-		if (data.type == CleanupType::OLD_FILES) {
-			// If we are removing old files, we need to remove them from the catalog
-			auto &transaction = DuckLakeTransaction::Get(context, data.catalog);
-			auto &metadata_manager = transaction.GetMetadataManager();
-			metadata_manager.RemoveFilesScheduledForCleanup(data.files);
+	if (!state.executed) {
+		if (!data.dry_run) {
+			// delete the files
+			RemoveCleanupFiles(context, data);
+			if (data.checkpoint_table_id.IsValid()) {
+				// the next incremental cleanup continues with the next table
+				DuckLakeConfigOption checkpoint;
+				checkpoint.option.key = ORPHAN_CLEANUP_CHECKPOINT;
+				checkpoint.option.value = to_string(data.checkpoint_table_id.GetIndex());
+				auto &transaction = DuckLakeTransaction::Get(context, data.catalog);
+				transaction.SetConfigOption(checkpoint);
+			}
 		}
 		state.executed = true;
 	}
+	if (state.offset >= data.files.size()) {
+		return;
+	}
 	idx_t count = 0;
 	while (state.offset < data.files.size() && count < STANDARD_VECTOR_SIZE) {
 		auto &file = data.files[state.offset++];
@@ -157,6 +313,7 @@ DuckLakeCleanupOldFilesFunction::DuckLakeCleanupOldFilesFunction()
 	named_parameters["older_than"] = LogicalType::TIMESTAMP_TZ;
 	named_parameters["cleanup_all"] = LogicalType::BOOLEAN;
 	named_parameters["dry_run"] = LogicalType::BOOLEAN;
+	named_parameters["max_concurrency"] = LogicalType::UBIGINT;
 }
 
 DuckLakeCleanupOrphanedFilesFunction::DuckLakeCleanupOrphanedFilesFunction()
@@ -165,6 +322,10 @@ DuckLakeCleanupOrphanedFilesFunction::DuckLakeCleanupOrphanedFilesFunction()
 	named_parameters["older_than"] = LogicalType::TIMESTAMP_TZ;
 	named_parameters["cleanup_all"] = LogicalType::BOOLEAN;
 	named_parameters["dry_run"] = LogicalType::BOOLEAN;
+	named_parameters["max_concurrency"] = LogicalType::UBIGINT;
+	named_parameters["prefix"] = LogicalType::VARCHAR;
+	named_parameters["since_snapshot"] = LogicalType::UBIGINT;
+	named_parameters["incremental"] = LogicalType::BOOLEAN;
 }
 
 } // namespace duckdb
@@ -0,0 +1,75 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_commit_stats.hpp"
+
+namespace duckdb {
+
+static Value TimeInMs(idx_t time_us) {
+	return Value::DOUBLE(static_cast<double>(time_us) / 1000.0);
+}
+
+static unique_ptr<FunctionData> DuckLakeCommitStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto &ducklake_catalog = catalog.Cast<DuckLakeCatalog>();
+
+	names.emplace_back("commits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("failed_commits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("retries");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("max_retries");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("total_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("avg_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("max_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("phase_time_ms");
+	return_types.emplace_back(LogicalType::MAP(LogicalType::VARCHAR, LogicalType::DOUBLE));
+	names.emplace_back("max_phase_time_ms");
+	return_types.emplace_back(LogicalType::MAP(LogicalType::VARCHAR, LogicalType::DOUBLE));
+	names.emplace_back("conflict_causes");
+	return_types.emplace_back(LogicalType::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT));
+
+	auto stats = ducklake_catalog.GetCommitStats().GetStats();
+	vector<Value> phase_names;
+	vector<Value> phase_times;
+	vector<Value> max_phase_times;
+	for (auto &entry : stats.phases) {
+		phase_names.push_back(Value(entry.first));
+		phase_times.push_back(TimeInMs(entry.second.total_time_us));
+		max_phase_times.push_back(TimeInMs(entry.second.max_time_us));
+	}
+	vector<Value> cause_names;
+	vector<Value> cause_counts;
+	for (auto &entry : stats.conflict_causes) {
+		cause_names.push_back(Value(entry.first));
+		cause_counts.push_back(Value::UBIGINT(entry.second));
+	}
+
+	auto result = make_uniq<MetadataBindData>();
+	vector<Value> row_values;
+	row_values.push_back(Value::UBIGINT(stats.commits));
+	row_values.push_back(Value::UBIGINT(stats.failed_commits));
+	row_values.push_back(Value::UBIGINT(stats.retries));
+	row_values.push_back(Value::UBIGINT(stats.max_retries));
+	row_values.push_back(TimeInMs(stats.total_time_us));
+	row_values.push_back(TimeInMs(stats.commits == 0 ? 0 : stats.total_time_us / stats.commits));
+	row_values.push_back(TimeInMs(stats.max_time_us));
+	row_values.push_back(Value::MAP(LogicalType::VARCHAR, LogicalType::DOUBLE, phase_names, std::move(phase_times)));
+	row_values.push_back(
+	    Value::MAP(LogicalType::VARCHAR, LogicalType::DOUBLE, std::move(phase_names), std::move(max_phase_times)));
+	row_values.push_back(
+	    Value::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT, std::move(cause_names), std::move(cause_counts)));
+	result->rows.push_back(std::move(row_values));
+	return std::move(result);
+}
+
+DuckLakeCommitStatsFunction::DuckLakeCommitStatsFunction()
+    : BaseMetadataFunction("ducklake_commit_stats", DuckLakeCommitStatsBind) {
+}
+
+} // namespace duckdb
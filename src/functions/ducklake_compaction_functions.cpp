@@ -5,17 +5,30 @@
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_insert.hpp"
 #include "storage/ducklake_multi_file_reader.hpp"
+#include "storage/ducklake_delete_filter.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_copy_to_file.hpp"
 #include "duckdb/planner/operator/logical_extension_operator.hpp"
 #include "duckdb/planner/operator/logical_set_operation.hpp"
 #include "storage/ducklake_compaction.hpp"
+#include "storage/ducklake_compaction_tracker.hpp"
+#include "storage/ducklake_file_size_advisor.hpp"
+#include "storage/ducklake_parquet_merge.hpp"
 #include "duckdb/common/multi_file/multi_file_function.hpp"
 #include "storage/ducklake_multi_file_list.hpp"
 #include "duckdb/planner/tableref/bound_at_clause.hpp"
 #include "duckdb/planner/operator/logical_empty_result.hpp"
+#include "duckdb/planner/operator/logical_order.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "fmt/format.h"
 
+#include <chrono>
+
 namespace duckdb {
 
 //===--------------------------------------------------------------------===//
@@ -73,6 +86,9 @@ SinkFinalizeType DuckLakeCompaction::Finalize(Pipeline &pipeline, Event &event,
 		}
 	}
 
+	DuckLakeInsert::ComputeBloomFilters(context, global_state.table, global_state.written_files);
+	DuckLakeInsert::ComputeHistograms(context, global_state.table, global_state.written_files);
+
 	DuckLakeCompactionEntry compaction_entry;
 	compaction_entry.row_id_start = row_id_start;
 	compaction_entry.source_files = source_files;
@@ -113,9 +129,17 @@ public:
 	vector<string> partition_values;
 	optional_idx row_id_start;
 	CompactionType type;
+	//! If set, the row groups of the source files are copied into the merged file as-is - the operator has no child
+	shared_ptr<DuckLakeParquetMerge> merge;
+	string file_path;
 
 public:
 	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		if (merge) {
+			return planner.Make<DuckLakePassthroughCompaction>(types, table, std::move(source_files), std::move(merge),
+			                                                   std::move(file_path), partition_id,
+			                                                   std::move(partition_values), row_id_start);
+		}
 		auto &child = planner.CreatePlan(*children[0]);
 		return planner.Make<DuckLakeCompaction>(types, table, std::move(source_files), std::move(encryption_key),
 		                                        partition_id, std::move(partition_values), row_id_start, child, type);
@@ -135,18 +159,335 @@ public:
 	}
 };
 
+//===--------------------------------------------------------------------===//
+// Passthrough Compaction
+//===--------------------------------------------------------------------===//
+DuckLakePassthroughCompaction::DuckLakePassthroughCompaction(
+    PhysicalPlan &physical_plan, const vector<LogicalType> &types, DuckLakeTableEntry &table,
+    vector<DuckLakeCompactionFileEntry> source_files_p, shared_ptr<DuckLakeParquetMerge> merge_p, string file_path_p,
+    optional_idx partition_id, vector<string> partition_values_p, optional_idx row_id_start)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, 0), table(table),
+      source_files(std::move(source_files_p)), merge(std::move(merge_p)), file_path(std::move(file_path_p)),
+      partition_id(partition_id), partition_values(std::move(partition_values_p)), row_id_start(row_id_start) {
+}
+
+DuckLakeColumnStatsMap DuckLakePassthroughCompaction::MergeColumnStats(DuckLakeTransaction &transaction) const {
+	vector<DataFileIndex> file_ids;
+	unordered_map<idx_t, idx_t> file_row_counts;
+	for (auto &source : source_files) {
+		file_ids.push_back(source.file.id);
+		file_row_counts[source.file.id.index] = source.file.row_count;
+	}
+	auto file_stats = transaction.GetMetadataManager().GetFileColumnStats(table, file_ids);
+	DuckLakeColumnStatsMap merged_stats;
+	unordered_map<idx_t, idx_t> file_counts;
+	for (auto &col_stats : file_stats) {
+		auto field = table.GetFieldId(col_stats.column_id);
+		if (!field) {
+			continue;
+		}
+		DuckLakeColumnStats column_stats(field->Type());
+		column_stats.column_size_bytes = col_stats.column_size_bytes;
+		column_stats.has_null_count = col_stats.has_null_count;
+		column_stats.null_count = col_stats.null_count;
+		if (col_stats.has_null_count && col_stats.null_count == file_row_counts[col_stats.data_file_id.index]) {
+			// all values are NULL for this file
+			column_stats.any_valid = false;
+		}
+		column_stats.has_contains_nan = col_stats.has_contains_nan;
+		column_stats.contains_nan = col_stats.contains_nan;
+		column_stats.has_min = col_stats.has_min;
+		column_stats.min = col_stats.min_val;
+		column_stats.has_max = col_stats.has_max;
+		column_stats.max = col_stats.max_val;
+		if (col_stats.has_extra_stats && column_stats.extra_stats) {
+			// only the extra stats of the column type (e.g. geo stats) are merged - Bloom filters and histograms
+			// describe a single file and are computed for the merged file instead
+			column_stats.extra_stats->Deserialize(col_stats.extra_stats);
+		}
+		auto entry = merged_stats.find(col_stats.column_id);
+		if (entry == merged_stats.end()) {
+			merged_stats.insert(make_pair(col_stats.column_id, std::move(column_stats)));
+		} else {
+			entry->second.MergeStats(column_stats);
+		}
+		file_counts[col_stats.column_id.index]++;
+	}
+	// the stats of a column are only known if they are known for every source file
+	DuckLakeColumnStatsMap result;
+	for (auto &entry : merged_stats) {
+		if (file_counts[entry.first.index] == source_files.size()) {
+			result.insert(make_pair(entry.first, std::move(entry.second)));
+		}
+	}
+	return result;
+}
+
+SourceResultType DuckLakePassthroughCompaction::GetData(ExecutionContext &context, DataChunk &chunk,
+                                                        OperatorSourceInput &input) const {
+	auto &transaction = DuckLakeTransaction::Get(context.client, table.catalog);
+	auto merge_result = merge->Write(file_path);
+
+	vector<DuckLakeDataFile> written_files;
+	DuckLakeDataFile written_file;
+	written_file.file_name = file_path;
+	written_file.row_count = merge_result.row_count;
+	written_file.file_size_bytes = merge_result.file_size_bytes;
+	written_file.footer_size = merge_result.footer_size;
+	written_file.partition_id = partition_id;
+	for (idx_t col_idx = 0; col_idx < partition_values.size(); col_idx++) {
+		DuckLakeFilePartition file_partition_info;
+		file_partition_info.partition_column_idx = col_idx;
+		file_partition_info.partition_value = partition_values[col_idx];
+		written_file.partition_values.push_back(std::move(file_partition_info));
+	}
+	written_file.column_stats = MergeColumnStats(transaction);
+	written_files.push_back(std::move(written_file));
+
+	DuckLakeInsert::ComputeBloomFilters(context.client, table, written_files);
+	DuckLakeInsert::ComputeHistograms(context.client, table, written_files);
+
+	DuckLakeCompactionEntry compaction_entry;
+	compaction_entry.row_id_start = row_id_start;
+	compaction_entry.source_files = source_files;
+	compaction_entry.written_file = std::move(written_files[0]);
+	compaction_entry.type = CompactionType::MERGE_ADJACENT_TABLES;
+	transaction.AddCompaction(table.GetTableId(), std::move(compaction_entry));
+	return SourceResultType::FINISHED;
+}
+
+string DuckLakePassthroughCompaction::GetName() const {
+	return "DUCKLAKE_PASSTHROUGH_COMPACTION";
+}
+
+//===--------------------------------------------------------------------===//
+// Parallel Compaction
+//===--------------------------------------------------------------------===//
+DuckLakeParallelCompaction::DuckLakeParallelCompaction(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+                                                       DuckLakeCatalog &catalog,
+                                                       vector<DuckLakeCompactionTableTarget> tables_p,
+                                                       CompactionType type, double delete_threshold,
+                                                       idx_t max_concurrency, optional_idx max_duration_us)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, 0), catalog(catalog),
+      tables(std::move(tables_p)), type(type), delete_threshold(delete_threshold), max_concurrency(max_concurrency),
+      max_duration_us(max_duration_us) {
+}
+
+string DuckLakeParallelCompaction::GetCompactionQuery(const DuckLakeCompactionTableTarget &table) const {
+	auto catalog_name = KeywordHelper::WriteQuoted(catalog.GetName(), '\'');
+	auto table_name = KeywordHelper::WriteQuoted(table.table_name, '\'');
+	auto schema_name = KeywordHelper::WriteQuoted(table.schema_name, '\'');
+	string max_bytes;
+	if (table.max_bytes.IsValid()) {
+		max_bytes = StringUtil::Format(", max_bytes => '%d'", table.max_bytes.GetIndex());
+	}
+	switch (type) {
+	case CompactionType::MERGE_ADJACENT_TABLES:
+		return StringUtil::Format("CALL ducklake_merge_adjacent_files(%s, %s, schema => %s%s)", catalog_name,
+		                          table_name, schema_name, max_bytes);
+	case CompactionType::REWRITE_DELETES:
+		return StringUtil::Format("CALL ducklake_rewrite_data_files(%s, %s, schema => %s, delete_threshold => %s%s)",
+		                          catalog_name, table_name, schema_name, Value::DOUBLE(delete_threshold).ToString(),
+		                          max_bytes);
+	default:
+		throw InternalException("Compaction type not recognized");
+	}
+}
+
+SourceResultType DuckLakeParallelCompaction::GetData(ExecutionContext &context, DataChunk &chunk,
+                                                     OperatorSourceInput &input) const {
+	mutex lock;
+	idx_t next_table = 0;
+	vector<ErrorData> errors;
+	auto start_time = std::chrono::steady_clock::now();
+	auto time_budget_exceeded = [&]() {
+		if (!max_duration_us.IsValid()) {
+			return false;
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start_time;
+		auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+		return NumericCast<idx_t>(elapsed_us) >= max_duration_us.GetIndex();
+	};
+	auto run_compactions = [&]() {
+		try {
+			Connection con(catalog.GetDatabase());
+			while (true) {
+				idx_t table_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_table >= tables.size() || context.client.interrupted || time_budget_exceeded()) {
+						return;
+					}
+					table_idx = next_table++;
+				}
+				// every table is compacted (and committed) in a separate transaction
+				auto result = con.Query(GetCompactionQuery(tables[table_idx]));
+				if (result->HasError()) {
+					lock_guard<mutex> guard(lock);
+					errors.push_back(result->GetErrorObject());
+				}
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			errors.emplace_back(ex);
+		}
+	};
+#ifndef DUCKDB_NO_THREADS
+	auto thread_count = MinValue<idx_t>(max_concurrency, tables.size());
+	vector<thread> threads;
+	for (idx_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(run_compactions);
+	}
+	run_compactions();
+	for (auto &compaction_thread : threads) {
+		compaction_thread.join();
+	}
+#else
+	run_compactions();
+#endif
+	if (!errors.empty()) {
+		errors[0].Throw("Failed to compact table in DuckLake: ");
+	}
+	return SourceResultType::FINISHED;
+}
+
+string DuckLakeParallelCompaction::GetName() const {
+	return "DUCKLAKE_PARALLEL_COMPACTION";
+}
+
+class DuckLakeLogicalParallelCompaction : public LogicalExtensionOperator {
+public:
+	DuckLakeLogicalParallelCompaction(idx_t table_index, DuckLakeCatalog &catalog,
+	                                  vector<DuckLakeCompactionTableTarget> tables_p, CompactionType type,
+	                                  double delete_threshold, idx_t max_concurrency, optional_idx max_duration_us)
+	    : table_index(table_index), catalog(catalog), tables(std::move(tables_p)), type(type),
+	      delete_threshold(delete_threshold), max_concurrency(max_concurrency), max_duration_us(max_duration_us) {
+	}
+
+	idx_t table_index;
+	DuckLakeCatalog &catalog;
+	vector<DuckLakeCompactionTableTarget> tables;
+	CompactionType type;
+	double delete_threshold;
+	idx_t max_concurrency;
+	optional_idx max_duration_us;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		return planner.Make<DuckLakeParallelCompaction>(types, catalog, std::move(tables), type, delete_threshold,
+		                                                max_concurrency, max_duration_us);
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		vector<ColumnBinding> result;
+		result.emplace_back(table_index, 0);
+		return result;
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BOOLEAN};
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Inline Deletes
+//===--------------------------------------------------------------------===//
+DuckLakeInlineDeletes::DuckLakeInlineDeletes(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+                                             DuckLakeTableEntry &table,
+                                             vector<DuckLakeCompactionFileEntry> source_files_p)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, 0), table(table),
+      source_files(std::move(source_files_p)) {
+}
+
+SourceResultType DuckLakeInlineDeletes::GetData(ExecutionContext &context, DataChunk &chunk,
+                                                OperatorSourceInput &input) const {
+	auto &transaction = DuckLakeTransaction::Get(context.client, table.catalog);
+	vector<DuckLakeDeleteFile> delete_files;
+	for (auto &source : source_files) {
+		auto &source_delete = source.delete_files.back();
+		DuckLakeDeleteFilter delete_filter;
+		delete_filter.Initialize(context.client, transaction, source_delete.data);
+		auto deleted_rows = delete_filter.delete_data->deleted_rows.ToVector();
+		if (deleted_rows.empty()) {
+			continue;
+		}
+		DuckLakeDeleteFile delete_file;
+		delete_file.data_file_id = source.file.id;
+		delete_file.data_file_path = source.file.data.path;
+		delete_file.file_name = DuckLakeDeleteFile::GetLocalInlinedDeletePath(transaction.GenerateUUID());
+		delete_file.delete_count = deleted_rows.size();
+		delete_file.file_size_bytes = 0;
+		delete_file.footer_size = 0;
+		// the inlined deletes replace the delete file
+		delete_file.overwrites_existing_delete = true;
+		delete_file.inlined_deletes = std::move(deleted_rows);
+		delete_files.push_back(std::move(delete_file));
+	}
+	transaction.AddDeletes(table.GetTableId(), std::move(delete_files));
+	return SourceResultType::FINISHED;
+}
+
+string DuckLakeInlineDeletes::GetName() const {
+	return "DUCKLAKE_INLINE_DELETES";
+}
+
+class DuckLakeLogicalInlineDeletes : public LogicalExtensionOperator {
+public:
+	DuckLakeLogicalInlineDeletes(idx_t table_index, DuckLakeTableEntry &table,
+	                             vector<DuckLakeCompactionFileEntry> source_files_p)
+	    : table_index(table_index), table(table), source_files(std::move(source_files_p)) {
+	}
+
+	idx_t table_index;
+	DuckLakeTableEntry &table;
+	vector<DuckLakeCompactionFileEntry> source_files;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		return planner.Make<DuckLakeInlineDeletes>(types, table, std::move(source_files));
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		vector<ColumnBinding> result;
+		result.emplace_back(table_index, 0);
+		return result;
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BOOLEAN};
+	}
+};
+
 //===--------------------------------------------------------------------===//
 // Compaction Command Generator
 //===--------------------------------------------------------------------===//
+//! A planned merge of a set of files of a single table
+struct DuckLakeCompactionMerge {
+	TableIndex table_id;
+	vector<DuckLakeCompactionFileEntry> files;
+	//! The amount of bytes rewritten by the merge
+	idx_t byte_count = 0;
+};
+
 class DuckLakeCompactor {
 public:
 	DuckLakeCompactor(ClientContext &context, DuckLakeCatalog &catalog, DuckLakeTransaction &transaction,
 	                  Binder &binder, TableIndex table_id);
 	DuckLakeCompactor(ClientContext &context, DuckLakeCatalog &catalog, DuckLakeTransaction &transaction,
 	                  Binder &binder, TableIndex table_id, double delete_threshold);
-	void GenerateCompactions(DuckLakeTableEntry &table, vector<unique_ptr<LogicalOperator>> &compactions);
+	void GenerateCompactions(DuckLakeTableEntry &table, vector<DuckLakeCompactionMerge> &compactions);
 	unique_ptr<LogicalOperator> GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry> source_files);
 
+private:
+	shared_ptr<DuckLakeParquetMerge> TryPassthroughMerge(const DuckLakeCopyInput &copy_input,
+	                                                     const vector<DuckLakeCompactionFileEntry> &source_files);
+
 private:
 	ClientContext &context;
 	DuckLakeCatalog &catalog;
@@ -205,16 +546,230 @@ template <typename T>
 using compaction_map_t =
     unordered_map<DuckLakeCompactionGroup, T, DuckLakeCompactionGroupHash, DuckLakeCompactionGroupEquality>;
 
-void DuckLakeCompactor::GenerateCompactions(DuckLakeTableEntry &table,
-                                            vector<unique_ptr<LogicalOperator>> &compactions) {
+//===--------------------------------------------------------------------===//
+// Compaction Planners
+//===--------------------------------------------------------------------===//
+//! A DuckLakeCompactionPlanner decides which candidate files of a compaction group are merged together
+class DuckLakeCompactionPlanner {
+public:
+	explicit DuckLakeCompactionPlanner(idx_t target_file_size) : target_file_size(target_file_size) {
+	}
+	virtual ~DuckLakeCompactionPlanner() = default;
+
+	//! Create the planner for the compaction_strategy of the table
+	static unique_ptr<DuckLakeCompactionPlanner> Create(DuckLakeCatalog &catalog, DuckLakeTableEntry &table,
+	                                                    idx_t target_file_size);
+
+	//! Plan the merges of the candidate files (indexes into files in snapshot order) of a single compaction group
+	//! Every merge is a list of file indexes in snapshot order
+	virtual void PlanMerges(const vector<DuckLakeCompactionFileEntry> &files, const vector<idx_t> &candidate_list,
+	                        vector<vector<idx_t>> &merges) = 0;
+	//! Order the planned merges of all compaction groups
+	virtual void OrderMerges(const vector<DuckLakeCompactionFileEntry> &files, vector<vector<idx_t>> &merges) {
+	}
+
+protected:
+	idx_t target_file_size;
+};
+
+//! The adjacent planner merges runs of consecutive files until the target file size is reached
+class DuckLakeAdjacentCompactionPlanner : public DuckLakeCompactionPlanner {
+public:
+	explicit DuckLakeAdjacentCompactionPlanner(idx_t target_file_size) : DuckLakeCompactionPlanner(target_file_size) {
+	}
+
+	void PlanMerges(const vector<DuckLakeCompactionFileEntry> &files, const vector<idx_t> &candidate_list,
+	                vector<vector<idx_t>> &merges) override {
+		for (idx_t start_idx = 0; start_idx < candidate_list.size(); start_idx++) {
+			// check if we can merge this file with subsequent files
+			idx_t current_file_size = 0;
+			idx_t compaction_idx;
+			for (compaction_idx = start_idx; compaction_idx < candidate_list.size(); compaction_idx++) {
+				if (current_file_size >= target_file_size) {
+					// we hit the target size already - stop
+					break;
+				}
+				auto candidate_idx = candidate_list[compaction_idx];
+				auto &candidate = files[candidate_idx];
+				if (!candidate.partial_files.empty()) {
+					// the file already has partial files - we can only accept this as a candidate if it is the first
+					// file
+					if (compaction_idx != start_idx) {
+						// not the first file - we cannot compact this file together with the existing file
+						break;
+					}
+				}
+				idx_t file_size = candidate.file.data.file_size_bytes;
+				if (file_size >= target_file_size) {
+					// don't consider merging if the file is larger than the target size
+					break;
+				}
+				// this file can be compacted along with the neighbors
+				current_file_size += file_size;
+			}
+
+			if (start_idx < compaction_idx) {
+				idx_t compaction_file_count = compaction_idx - start_idx;
+				vector<idx_t> merge;
+				for (idx_t i = start_idx; i < compaction_idx; i++) {
+					merge.push_back(candidate_list[i]);
+				}
+				merges.push_back(std::move(merge));
+				start_idx += compaction_file_count - 1;
+			}
+		}
+	}
+};
+
+//! The bin-packing planner packs files (largest first) into bins of at most the target file size, regardless of
+//! whether the files are adjacent. Files that are already within the size tolerance of the target are left alone, so
+//! files slightly below the target are not rewritten over and over again.
+class DuckLakeBinPackCompactionPlanner : public DuckLakeCompactionPlanner {
+	struct Bin {
+		vector<idx_t> files;
+		idx_t size = 0;
+		//! The index in the candidate list of the file with partial files in this bin (if any)
+		optional_idx partial_file;
+		//! The lowest index in the candidate list of any file in this bin
+		idx_t min_candidate = NumericLimits<idx_t>::Maximum();
+	};
+
+public:
+	DuckLakeBinPackCompactionPlanner(idx_t target_file_size, double size_tolerance)
+	    : DuckLakeCompactionPlanner(target_file_size), size_tolerance(size_tolerance) {
+	}
+
+	void PlanMerges(const vector<DuckLakeCompactionFileEntry> &files, const vector<idx_t> &candidate_list,
+	                vector<vector<idx_t>> &merges) override {
+		auto skip_size = static_cast<idx_t>(static_cast<double>(target_file_size) * (1.0 - size_tolerance));
+		// visit the files from large to small
+		vector<idx_t> order;
+		for (idx_t i = 0; i < candidate_list.size(); i++) {
+			if (files[candidate_list[i]].file.data.file_size_bytes >= skip_size) {
+				// the file is close enough to the target size - rewriting it gains little
+				continue;
+			}
+			order.push_back(i);
+		}
+		std::stable_sort(order.begin(), order.end(), [&](idx_t a, idx_t b) {
+			return files[candidate_list[a]].file.data.file_size_bytes >
+			       files[candidate_list[b]].file.data.file_size_bytes;
+		});
+		// place every file in the first bin that it fits in
+		vector<Bin> bins;
+		for (auto candidate : order) {
+			auto &file = files[candidate_list[candidate]];
+			auto file_size = file.file.data.file_size_bytes;
+			bool has_partial_files = !file.partial_files.empty();
+			optional_ptr<Bin> target_bin;
+			for (auto &bin : bins) {
+				if (bin.size + file_size > target_file_size) {
+					continue;
+				}
+				// a file with partial files has to be the first file (in snapshot order) of the merge
+				if (has_partial_files && (bin.partial_file.IsValid() || bin.min_candidate < candidate)) {
+					continue;
+				}
+				if (bin.partial_file.IsValid() && candidate < bin.partial_file.GetIndex()) {
+					continue;
+				}
+				target_bin = &bin;
+				break;
+			}
+			if (!target_bin) {
+				bins.emplace_back();
+				target_bin = &bins.back();
+			}
+			target_bin->files.push_back(candidate);
+			target_bin->size += file_size;
+			target_bin->min_candidate = MinValue<idx_t>(target_bin->min_candidate, candidate);
+			if (has_partial_files) {
+				target_bin->partial_file = candidate;
+			}
+		}
+		for (auto &bin : bins) {
+			if (bin.files.size() <= 1) {
+				// nothing to merge
+				continue;
+			}
+			// the files of a merge are written in snapshot order
+			std::sort(bin.files.begin(), bin.files.end());
+			vector<idx_t> merge;
+			for (auto candidate : bin.files) {
+				merge.push_back(candidate_list[candidate]);
+			}
+			merges.push_back(std::move(merge));
+		}
+	}
+
+	void OrderMerges(const vector<DuckLakeCompactionFileEntry> &files, vector<vector<idx_t>> &merges) override {
+		// run the merges that remove the most files first - ties are broken by the amount of bytes rewritten
+		vector<pair<idx_t, idx_t>> merge_cost;
+		for (auto &merge : merges) {
+			idx_t bytes = 0;
+			for (auto file_idx : merge) {
+				bytes += files[file_idx].file.data.file_size_bytes;
+			}
+			merge_cost.emplace_back(merge.size(), bytes);
+		}
+		vector<idx_t> order;
+		for (idx_t i = 0; i < merges.size(); i++) {
+			order.push_back(i);
+		}
+		std::stable_sort(order.begin(), order.end(), [&](idx_t a, idx_t b) {
+			if (merge_cost[a].first != merge_cost[b].first) {
+				return merge_cost[a].first > merge_cost[b].first;
+			}
+			return merge_cost[a].second < merge_cost[b].second;
+		});
+		vector<vector<idx_t>> result;
+		for (auto idx : order) {
+			result.push_back(std::move(merges[idx]));
+		}
+		merges = std::move(result);
+	}
+
+private:
+	double size_tolerance;
+};
+
+unique_ptr<DuckLakeCompactionPlanner> DuckLakeCompactionPlanner::Create(DuckLakeCatalog &catalog,
+                                                                        DuckLakeTableEntry &table,
+                                                                        idx_t target_file_size) {
+	string strategy = "adjacent";
+	catalog.TryGetConfigOption("compaction_strategy", strategy, table);
+	if (strategy == "bin_pack") {
+		double size_tolerance = 0.1;
+		string size_tolerance_str;
+		if (catalog.TryGetConfigOption("compaction_size_tolerance", size_tolerance_str, table)) {
+			size_tolerance = Value(size_tolerance_str).DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+		}
+		return make_uniq<DuckLakeBinPackCompactionPlanner>(target_file_size, size_tolerance);
+	}
+	return make_uniq<DuckLakeAdjacentCompactionPlanner>(target_file_size);
+}
+
+void DuckLakeCompactor::GenerateCompactions(DuckLakeTableEntry &table, vector<DuckLakeCompactionMerge> &compactions) {
 	auto &metadata_manager = transaction.GetMetadataManager();
 	auto snapshot = transaction.GetSnapshot();
-	auto files = metadata_manager.GetFilesForCompaction(table, type, delete_threshold, snapshot);
 
-	idx_t target_file_size = DuckLakeCatalog::DEFAULT_TARGET_FILE_SIZE;
-	string target_file_size_str;
-	if (catalog.TryGetConfigOption("target_file_size", target_file_size_str, table)) {
-		target_file_size = Value(target_file_size_str).DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+	// merge the files up to the target file size that new files of the table are written with
+	auto &schema = table.ParentSchema().Cast<DuckLakeSchemaEntry>();
+	auto file_sizing = catalog.GetFileSizeAdvisor().GetFileSizing(catalog, schema.GetSchemaId(), table_id,
+	                                                              table.GetColumns().PhysicalColumnCount());
+	auto target_file_size = file_sizing.target_file_size;
+	// skip reading the file list if the tracked compaction candidates show the table has nothing to compact
+	auto &tracker = catalog.GetCompactionTracker();
+	bool track_table = !table_id.IsTransactionLocal();
+	if (track_table && tracker.CanSkipCompaction(transaction, table_id, type, target_file_size, delete_threshold)) {
+		return;
+	}
+	auto files = metadata_manager.GetFilesForCompaction(table, type, delete_threshold, snapshot);
+	if (track_table && type == CompactionType::MERGE_ADJACENT_TABLES) {
+		// the merge reads the full file list - track the compaction candidates of the table from it
+		tracker.SetTableState(table_id, snapshot.snapshot_id, target_file_size, files);
+	} else if (track_table && files.empty()) {
+		tracker.SetCleanRewrite(table_id, snapshot.snapshot_id, delete_threshold);
 	}
 
 	// iterate over the files and split into separate compaction groups
@@ -240,60 +795,70 @@ void DuckLakeCompactor::GenerateCompactions(DuckLakeTableEntry &table,
 	}
 	if (type == CompactionType::REWRITE_DELETES) {
 		if (!files.empty()) {
-			auto compaction_command = GenerateCompactionCommand(std::move(files));
-			if (compaction_command) {
-				compactions.push_back(std::move(compaction_command));
+			DuckLakeCompactionMerge merge;
+			merge.table_id = table_id;
+			for (auto &file : files) {
+				merge.byte_count += file.file.data.file_size_bytes;
 			}
+			merge.files = std::move(files);
+			compactions.push_back(std::move(merge));
 		}
 		return;
 	}
 	// we have gathered all the candidate files per compaction group
-	// iterate over them to generate actual compaction commands
+	// plan the merges within every group
+	auto planner = DuckLakeCompactionPlanner::Create(catalog, table, target_file_size);
+	vector<vector<idx_t>> merges;
 	for (auto &entry : candidates) {
 		auto &candidate_list = entry.second.candidate_files;
 		if (candidate_list.size() <= 1) {
 			// we need at least 2 files to consider a merge
 			continue;
 		}
-		for (idx_t start_idx = 0; start_idx < candidate_list.size(); start_idx++) {
-			// check if we can merge this file with subsequent files
-			idx_t current_file_size = 0;
-			idx_t compaction_idx;
-			for (compaction_idx = start_idx; compaction_idx < candidate_list.size(); compaction_idx++) {
-				if (current_file_size >= target_file_size) {
-					// we hit the target size already - stop
-					break;
-				}
-				auto candidate_idx = candidate_list[compaction_idx];
-				auto &candidate = files[candidate_idx];
-				if (!candidate.partial_files.empty()) {
-					// the file already has partial files - we can only accept this as a candidate if it is the first
-					// file
-					if (compaction_idx != start_idx) {
-						// not the first file - we cannot compact this file together with the existing file
-						break;
-					}
-				}
-				idx_t file_size = candidate.file.data.file_size_bytes;
-				if (file_size >= target_file_size) {
-					// don't consider merging if the file is larger than the target size
-					break;
-				}
-				// this file can be compacted along with the neighbors
-				current_file_size += file_size;
-			}
+		planner->PlanMerges(files, candidate_list, merges);
+	}
+	planner->OrderMerges(files, merges);
+	for (auto &merge_files : merges) {
+		DuckLakeCompactionMerge merge;
+		merge.table_id = table_id;
+		for (auto file_idx : merge_files) {
+			merge.byte_count += files[file_idx].file.data.file_size_bytes;
+			merge.files.push_back(std::move(files[file_idx]));
+		}
+		compactions.push_back(std::move(merge));
+	}
+}
 
-			if (start_idx < compaction_idx) {
-				idx_t compaction_file_count = compaction_idx - start_idx;
-				vector<DuckLakeCompactionFileEntry> compaction_files;
-				for (idx_t i = start_idx; i < compaction_idx; i++) {
-					compaction_files.push_back(std::move(files[candidate_list[i]]));
-				}
-				compactions.push_back(GenerateCompactionCommand(std::move(compaction_files)));
-				start_idx += compaction_file_count - 1;
-			}
+//! Returns the merge of the source files if their row groups can be copied into the merged file as-is
+shared_ptr<DuckLakeParquetMerge>
+DuckLakeCompactor::TryPassthroughMerge(const DuckLakeCopyInput &copy_input,
+                                       const vector<DuckLakeCompactionFileEntry> &source_files) {
+	if (type != CompactionType::MERGE_ADJACENT_TABLES || !copy_input.encryption_key.empty()) {
+		return nullptr;
+	}
+	auto passthrough =
+	    catalog.GetConfigOption<string>("compaction_passthrough", copy_input.schema_id, copy_input.table_id, "true");
+	if (passthrough != "true") {
+		return nullptr;
+	}
+	auto begin_snapshot = source_files[0].file.begin_snapshot;
+	for (auto &source : source_files) {
+		if (source.file.begin_snapshot != begin_snapshot || !source.partial_files.empty()) {
+			// the rows of different snapshots are tagged with their snapshot id in the merged file
+			return nullptr;
+		}
+		if (source.file.mapping_id.IsValid() || !source.file.data.encryption_key.empty()) {
+			// files added with a name mapping are rewritten with the field ids of the table
+			return nullptr;
+		}
+	}
+	auto merge = make_shared_ptr<DuckLakeParquetMerge>(FileSystem::GetFileSystem(context));
+	for (auto &source : source_files) {
+		if (!merge->AddFile(source.file.data.path, source.file.data.file_size_bytes)) {
+			return nullptr;
 		}
 	}
+	return merge;
 }
 
 unique_ptr<LogicalOperator>
@@ -397,6 +962,11 @@ DuckLakeCompactor::GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry>
 	DuckLakeCopyInput copy_input(context, table, data_path);
 	// merge_adjacent_files does not use partitioning information - instead we always merge within partitions
 	copy_input.partition_data = nullptr;
+	copy_input.get_table_index = table_idx;
+	if (!DuckLakeInsert::GetSortOrders(context, copy_input).empty()) {
+		// we are sorting the rows - the row ids no longer follow from the position in the file
+		files_are_adjacent = false;
+	}
 	// if files are adjacent, we don't need to write the row-id to the file
 	if (files_are_adjacent) {
 		copy_input.virtual_columns = InsertVirtualColumns::WRITE_SNAPSHOT_ID;
@@ -406,6 +976,25 @@ DuckLakeCompactor::GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry>
 
 	auto copy_options = DuckLakeInsert::GetCopyOptions(context, copy_input);
 
+	optional_idx target_row_id_start;
+	if (files_are_adjacent) {
+		target_row_id_start = source_files[0].file.row_id_start;
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_path = copy_options.filename_pattern.CreateFilename(fs, copy_options.file_path, "parquet", 0);
+	if (files_are_adjacent) {
+		// files of the same snapshot can be merged without rewriting their rows
+		auto merge = TryPassthroughMerge(copy_input, actionable_source_files);
+		if (merge) {
+			auto compaction = make_uniq<DuckLakeLogicalCompaction>(
+			    binder.GenerateTableIndex(), table, std::move(actionable_source_files), string(), partition_id,
+			    std::move(partition_values), target_row_id_start, type);
+			compaction->merge = std::move(merge);
+			compaction->file_path = std::move(file_path);
+			return std::move(compaction);
+		}
+	}
+
 	auto virtual_columns = table.GetVirtualColumns();
 	auto ducklake_scan =
 	    make_uniq<LogicalGet>(table_idx, std::move(scan_function), std::move(bind_data), copy_options.expected_types,
@@ -426,6 +1015,14 @@ DuckLakeCompactor::GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry>
 	// Insert a cast projection if necessary
 	auto root = unique_ptr_cast<LogicalGet, LogicalOperator>(std::move(ducklake_scan));
 
+	if (!copy_options.sort_orders.empty()) {
+		// sort the rows prior to writing them
+		auto order = make_uniq<LogicalOrder>(std::move(copy_options.sort_orders));
+		order->children.push_back(std::move(root));
+		order->ResolveOperatorTypes();
+		root = std::move(order);
+	}
+
 	if (DuckLakeTypes::RequiresCast(root->types)) {
 		root = DuckLakeInsert::InsertCasts(binder, root);
 	}
@@ -434,8 +1031,7 @@ DuckLakeCompactor::GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry>
 	auto copy = make_uniq<LogicalCopyToFile>(std::move(copy_options.copy_function), std::move(copy_options.bind_data),
 	                                         std::move(copy_options.info));
 
-	auto &fs = FileSystem::GetFileSystem(context);
-	copy->file_path = copy_options.filename_pattern.CreateFilename(fs, copy_options.file_path, "parquet", 0);
+	copy->file_path = std::move(file_path);
 	copy->use_tmp_file = copy_options.use_tmp_file;
 	copy->filename_pattern = std::move(copy_options.filename_pattern);
 	copy->file_extension = std::move(copy_options.file_extension);
@@ -456,11 +1052,6 @@ DuckLakeCompactor::GenerateCompactionCommand(vector<DuckLakeCompactionFileEntry>
 	copy->rotate = false;
 	copy->children.push_back(std::move(root));
 
-	optional_idx target_row_id_start;
-	if (files_are_adjacent) {
-		target_row_id_start = source_files[0].file.row_id_start;
-	}
-
 	// followed by the compaction operator (that writes the results back to the
 	auto compaction = make_uniq<DuckLakeLogicalCompaction>(
 	    binder.GenerateTableIndex(), table, std::move(actionable_source_files), std::move(copy_input.encryption_key),
@@ -491,26 +1082,102 @@ static unique_ptr<LogicalOperator> GenerateCompactionOperator(TableFunctionBindI
 	return union_op;
 }
 
+static DuckLakeCompactor CreateCompactor(ClientContext &context, DuckLakeTransaction &transaction,
+                                         DuckLakeCatalog &ducklake_catalog, TableFunctionBindInput &input,
+                                         TableIndex table_id, CompactionType type, double delete_threshold) {
+	switch (type) {
+	case CompactionType::MERGE_ADJACENT_TABLES:
+		return DuckLakeCompactor(context, ducklake_catalog, transaction, *input.binder, table_id);
+	case CompactionType::REWRITE_DELETES:
+		return DuckLakeCompactor(context, ducklake_catalog, transaction, *input.binder, table_id, delete_threshold);
+	default:
+		throw InternalException("Compaction type not recognized");
+	}
+}
+
 static void GenerateCompaction(ClientContext &context, DuckLakeTransaction &transaction,
                                DuckLakeCatalog &ducklake_catalog, TableFunctionBindInput &input,
                                DuckLakeTableEntry &cur_table, CompactionType type, double delete_threshold,
-                               vector<unique_ptr<LogicalOperator>> &compactions) {
-	switch (type) {
-	case CompactionType::MERGE_ADJACENT_TABLES: {
-		DuckLakeCompactor compactor(context, ducklake_catalog, transaction, *input.binder, cur_table.GetTableId());
-		compactor.GenerateCompactions(cur_table, compactions);
-		break;
+                               vector<DuckLakeCompactionMerge> &merges) {
+	auto compactor =
+	    CreateCompactor(context, transaction, ducklake_catalog, input, cur_table.GetTableId(), type, delete_threshold);
+	compactor.GenerateCompactions(cur_table, merges);
+}
+
+//! Restrict the planned merges to the ones that fit in the byte budget - the most valuable merges are picked first
+static void ApplyCompactionBudget(vector<DuckLakeCompactionMerge> &merges, optional_idx max_bytes) {
+	if (!max_bytes.IsValid()) {
+		return;
+	}
+	// merges that remove the most files are the most valuable - ties are broken by the amount of bytes rewritten
+	std::stable_sort(merges.begin(), merges.end(),
+	                 [](const DuckLakeCompactionMerge &a, const DuckLakeCompactionMerge &b) {
+		                 if (a.files.size() != b.files.size()) {
+			                 return a.files.size() > b.files.size();
+		                 }
+		                 return a.byte_count < b.byte_count;
+	                 });
+	vector<DuckLakeCompactionMerge> result;
+	idx_t total_bytes = 0;
+	for (auto &merge : merges) {
+		// always run at least one merge so that a merge larger than the budget does not stall compaction forever
+		if (!result.empty() && total_bytes + merge.byte_count > max_bytes.GetIndex()) {
+			continue;
+		}
+		total_bytes += merge.byte_count;
+		result.push_back(std::move(merge));
 	}
-	case CompactionType::REWRITE_DELETES: {
-		DuckLakeCompactor compactor(context, ducklake_catalog, transaction, *input.binder, cur_table.GetTableId(),
-		                            delete_threshold);
-		compactor.GenerateCompactions(cur_table, compactions);
-		break;
+	merges = std::move(result);
+}
+
+static unique_ptr<LogicalOperator> GenerateCompactionOperator(ClientContext &context, DuckLakeTransaction &transaction,
+                                                              DuckLakeCatalog &ducklake_catalog,
+                                                              TableFunctionBindInput &input, idx_t bind_index,
+                                                              CompactionType type, double delete_threshold,
+                                                              vector<DuckLakeCompactionMerge> &merges) {
+	vector<unique_ptr<LogicalOperator>> compactions;
+	for (auto &merge : merges) {
+		auto compactor =
+		    CreateCompactor(context, transaction, ducklake_catalog, input, merge.table_id, type, delete_threshold);
+		auto compaction_command = compactor.GenerateCompactionCommand(std::move(merge.files));
+		if (compaction_command) {
+			compactions.push_back(std::move(compaction_command));
+		}
 	}
-	default:
-		throw InternalException("Compaction type not recognized");
+	return GenerateCompactionOperator(input, bind_index, compactions);
+}
+
+//! Restrict the planned rewrites to the given data files
+static void FilterCompactionFiles(vector<DuckLakeCompactionMerge> &merges, const unordered_set<idx_t> &data_file_ids) {
+	vector<DuckLakeCompactionMerge> result;
+	for (auto &merge : merges) {
+		vector<DuckLakeCompactionFileEntry> files;
+		merge.byte_count = 0;
+		for (auto &file : merge.files) {
+			if (data_file_ids.find(file.file.id.index) == data_file_ids.end()) {
+				continue;
+			}
+			merge.byte_count += file.file.data.file_size_bytes;
+			files.push_back(std::move(file));
+		}
+		if (files.empty()) {
+			continue;
+		}
+		merge.files = std::move(files);
+		result.push_back(std::move(merge));
+	}
+	merges = std::move(result);
+}
+
+//! Parse a byte budget - either a plain number of bytes or a size such as '1GB'
+static idx_t ParseCompactionBytes(const string &value) {
+	idx_t result;
+	if (TryCast::Operation<string_t, uint64_t>(string_t(value), result, false)) {
+		return result;
 	}
+	return DBConfig::ParseMemoryLimit(value);
 }
+
 unique_ptr<LogicalOperator> BindCompaction(ClientContext &context, TableFunctionBindInput &input, idx_t bind_index,
                                            CompactionType type) {
 	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
@@ -531,29 +1198,94 @@ unique_ptr<LogicalOperator> BindCompaction(ClientContext &context, TableFunction
 		throw BinderException("The delete_threshold option must be between 0 and 1");
 	}
 
-	vector<unique_ptr<LogicalOperator>> compactions;
+	// the amount of tables that are compacted concurrently when compacting multiple tables
+	auto max_concurrency = ducklake_catalog.GetConfigOption<idx_t>("compaction_max_concurrency", {}, {}, 1);
+	auto max_concurrency_entry = input.named_parameters.find("max_concurrency");
+	if (max_concurrency_entry != input.named_parameters.end()) {
+		max_concurrency = UBigIntValue::Get(max_concurrency_entry->second);
+	}
+	if (max_concurrency == 0) {
+		throw BinderException("The max_concurrency option must be at least 1");
+	}
+
+	// the budget of this call - the amount of bytes rewritten and the time spent
+	optional_idx max_bytes;
+	auto max_bytes_str = ducklake_catalog.GetConfigOption<string>("compaction_max_bytes", {}, {}, "");
+	auto max_bytes_entry = input.named_parameters.find("max_bytes");
+	if (max_bytes_entry != input.named_parameters.end()) {
+		max_bytes_str = StringValue::Get(max_bytes_entry->second);
+	}
+	if (!max_bytes_str.empty()) {
+		max_bytes = ParseCompactionBytes(max_bytes_str);
+	}
+	optional_idx max_duration_us;
+	auto max_duration_str = ducklake_catalog.GetConfigOption<string>("compaction_max_duration", {}, {}, "");
+	auto max_duration_entry = input.named_parameters.find("max_duration");
+	if (max_duration_entry != input.named_parameters.end()) {
+		max_duration_str = max_duration_entry->second.ToString();
+	}
+	if (!max_duration_str.empty()) {
+		interval_t max_duration;
+		if (!Interval::FromString(max_duration_str, max_duration) || Interval::GetMicro(max_duration) <= 0) {
+			throw BinderException("The max_duration option must be a positive interval");
+		}
+		max_duration_us = NumericCast<idx_t>(Interval::GetMicro(max_duration));
+	}
+
+	vector<DuckLakeCompactionMerge> merges;
 	if (input.inputs.size() == 1) {
+		vector<reference<DuckLakeTableEntry>> tables;
 		if (schema.empty() && table.empty()) {
 			// No default schema/table, we will perform rewrites on deletes in the whole database
 			auto schemas = ducklake_catalog.GetSchemas(context);
 			for (auto &cur_schema : schemas) {
-				cur_schema.get().Scan(context, CatalogType::TABLE_ENTRY, [&](CatalogEntry &entry) {
-					auto &cur_table = entry.Cast<DuckLakeTableEntry>();
-					GenerateCompaction(context, transaction, ducklake_catalog, input, cur_table, type, delete_threshold,
-					                   compactions);
-				});
+				cur_schema.get().Scan(context, CatalogType::TABLE_ENTRY,
+				                      [&](CatalogEntry &entry) { tables.push_back(entry.Cast<DuckLakeTableEntry>()); });
 			}
-			return GenerateCompactionOperator(input, bind_index, compactions);
 		} else if (!schema.empty() && table.empty()) {
 			// There is a default schema but not a default table, we will use that
 			auto schema_entry = catalog.GetSchema(context, catalog.GetName(), schema, OnEntryNotFound::THROW_EXCEPTION);
 			auto &ducklake_schema = schema_entry->Cast<DuckLakeSchemaEntry>();
-			ducklake_schema.Scan(context, CatalogType::TABLE_ENTRY, [&](CatalogEntry &entry) {
-				auto &cur_table = entry.Cast<DuckLakeTableEntry>();
-				GenerateCompaction(context, transaction, ducklake_catalog, input, cur_table, type, delete_threshold,
-				                   compactions);
-			});
-			return GenerateCompactionOperator(input, bind_index, compactions);
+			ducklake_schema.Scan(context, CatalogType::TABLE_ENTRY,
+			                     [&](CatalogEntry &entry) { tables.push_back(entry.Cast<DuckLakeTableEntry>()); });
+		}
+		if (table.empty()) {
+			for (auto &table_ref : tables) {
+				GenerateCompaction(context, transaction, ducklake_catalog, input, table_ref.get(), type,
+				                   delete_threshold, merges);
+			}
+			ApplyCompactionBudget(merges, max_bytes);
+			if ((max_concurrency > 1 || max_duration_us.IsValid()) && tables.size() > 1) {
+				// compact the tables that have work to do table by table - each in a separate transaction
+				// the byte budget is split over the tables according to the merges picked for them
+				vector<DuckLakeCompactionTableTarget> targets;
+				unordered_map<idx_t, idx_t> target_map;
+				for (auto &merge : merges) {
+					auto entry = target_map.find(merge.table_id.index);
+					if (entry == target_map.end()) {
+						auto &cur_table = ducklake_catalog
+						                      .GetEntryById(transaction, transaction.GetSnapshot(), merge.table_id)
+						                      ->Cast<DuckLakeTableEntry>();
+						DuckLakeCompactionTableTarget target;
+						target.schema_name = cur_table.ParentSchema().name;
+						target.table_name = cur_table.name;
+						if (max_bytes.IsValid()) {
+							target.max_bytes = 0;
+						}
+						entry = target_map.emplace(merge.table_id.index, targets.size()).first;
+						targets.push_back(std::move(target));
+					}
+					auto &target = targets[entry->second];
+					if (target.max_bytes.IsValid()) {
+						target.max_bytes = target.max_bytes.GetIndex() + merge.byte_count;
+					}
+				}
+				return make_uniq<DuckLakeLogicalParallelCompaction>(bind_index, ducklake_catalog, std::move(targets),
+				                                                    type, delete_threshold, max_concurrency,
+				                                                    max_duration_us);
+			}
+			return GenerateCompactionOperator(context, transaction, ducklake_catalog, input, bind_index, type,
+			                                  delete_threshold, merges);
 		}
 	} else if (input.inputs.size() == 2) {
 		// We have the table_name defined in our input
@@ -567,10 +1299,19 @@ unique_ptr<LogicalOperator> BindCompaction(ClientContext &context, TableFunction
 	EntryLookupInfo table_lookup(CatalogType::TABLE_ENTRY, table, nullptr, QueryErrorContext());
 	auto table_entry = catalog.GetEntry(context, schema, table_lookup, OnEntryNotFound::THROW_EXCEPTION);
 	auto &ducklake_table = table_entry->Cast<DuckLakeTableEntry>();
-	GenerateCompaction(context, transaction, ducklake_catalog, input, ducklake_table, type, delete_threshold,
-	                   compactions);
-
-	return GenerateCompactionOperator(input, bind_index, compactions);
+	GenerateCompaction(context, transaction, ducklake_catalog, input, ducklake_table, type, delete_threshold, merges);
+	auto data_file_ids_entry = input.named_parameters.find("data_file_ids");
+	if (data_file_ids_entry != input.named_parameters.end()) {
+		// only rewrite the given data files of the table
+		unordered_set<idx_t> data_file_ids;
+		for (auto &data_file_id : ListValue::GetChildren(data_file_ids_entry->second)) {
+			data_file_ids.insert(data_file_id.GetValue<idx_t>());
+		}
+		FilterCompactionFiles(merges, data_file_ids);
+	}
+	ApplyCompactionBudget(merges, max_bytes);
+	return GenerateCompactionOperator(context, transaction, ducklake_catalog, input, bind_index, type,
+	                                  delete_threshold, merges);
 }
 
 static unique_ptr<LogicalOperator> MergeAdjacentFilesBind(ClientContext &context, TableFunctionBindInput &input,
@@ -585,6 +1326,9 @@ TableFunctionSet DuckLakeMergeAdjacentFilesFunction::GetFunctions() {
 	for (auto &type : at_types) {
 		TableFunction function("ducklake_merge_adjacent_files", type, nullptr, nullptr, nullptr);
 		function.bind_operator = MergeAdjacentFilesBind;
+		function.named_parameters["max_concurrency"] = LogicalType::UBIGINT;
+		function.named_parameters["max_bytes"] = LogicalType::VARCHAR;
+		function.named_parameters["max_duration"] = LogicalType::INTERVAL;
 		if (type.size() == 2) {
 			function.named_parameters["schema"] = LogicalType::VARCHAR;
 		}
@@ -607,6 +1351,141 @@ TableFunctionSet DuckLakeRewriteDataFilesFunction::GetFunctions() {
 		TableFunction function("ducklake_rewrite_data_files", type, nullptr, nullptr, nullptr);
 		function.bind_operator = RewriteFilesBind;
 		function.named_parameters["delete_threshold"] = LogicalType::DOUBLE;
+		function.named_parameters["max_concurrency"] = LogicalType::UBIGINT;
+		function.named_parameters["max_bytes"] = LogicalType::VARCHAR;
+		function.named_parameters["max_duration"] = LogicalType::INTERVAL;
+		if (type.size() == 2) {
+			function.named_parameters["schema"] = LogicalType::VARCHAR;
+			function.named_parameters["data_file_ids"] = LogicalType::LIST(LogicalType::UBIGINT);
+		}
+		set.AddFunction(function);
+	}
+	return set;
+}
+
+//! Gather the files of a table with an active delete file that is small enough to be inlined in the metadata catalog
+static vector<DuckLakeCompactionFileEntry> GetDeleteFilesToInline(DuckLakeTransaction &transaction,
+                                                                  DuckLakeTableEntry &table, double delete_threshold,
+                                                                  idx_t inline_limit) {
+	vector<DuckLakeCompactionFileEntry> result;
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto files = metadata_manager.GetFilesForCompaction(table, CompactionType::MERGE_ADJACENT_TABLES, 0,
+	                                                    transaction.GetSnapshot());
+	for (auto &file : files) {
+		if (file.file.end_snapshot.IsValid() || file.delete_files.empty() || !file.file.data.encryption_key.empty()) {
+			continue;
+		}
+		auto &delete_file = file.delete_files.back();
+		if (delete_file.end_snapshot.IsValid() || DuckLakeDeleteFile::IsInlinedDeletePath(delete_file.data.path)) {
+			// no active delete file - or the deletes are already inlined
+			continue;
+		}
+		if (delete_file.row_count > inline_limit || file.file.row_count == 0) {
+			continue;
+		}
+		auto delete_ratio = static_cast<double>(delete_file.row_count) / static_cast<double>(file.file.row_count);
+		if (delete_ratio >= delete_threshold) {
+			// the data file is rewritten instead
+			continue;
+		}
+		result.push_back(std::move(file));
+	}
+	return result;
+}
+
+static unique_ptr<LogicalOperator> ConsolidateDeletesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          idx_t bind_index, vector<string> &return_names) {
+	return_names.push_back("Success");
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto &ducklake_catalog = catalog.Cast<DuckLakeCatalog>();
+	auto &transaction = DuckLakeTransaction::Get(context, ducklake_catalog);
+
+	double delete_threshold = ducklake_catalog.GetConfigOption<double>("rewrite_delete_threshold", {}, {}, 0.95);
+	auto delete_threshold_entry = input.named_parameters.find("delete_threshold");
+	if (delete_threshold_entry != input.named_parameters.end()) {
+		delete_threshold = DoubleValue::Get(delete_threshold_entry->second);
+	}
+	if (delete_threshold > 1 || delete_threshold < 0) {
+		throw BinderException("The delete_threshold option must be between 0 and 1");
+	}
+	optional_idx inline_limit;
+	auto inline_limit_entry = input.named_parameters.find("inline_limit");
+	if (inline_limit_entry != input.named_parameters.end()) {
+		inline_limit = UBigIntValue::Get(inline_limit_entry->second);
+	}
+
+	vector<reference<DuckLakeTableEntry>> tables;
+	if (input.inputs.size() == 2) {
+		string schema;
+		auto schema_entry = input.named_parameters.find("schema");
+		if (schema_entry != input.named_parameters.end()) {
+			schema = StringValue::Get(schema_entry->second);
+		}
+		EntryLookupInfo table_lookup(CatalogType::TABLE_ENTRY, StringValue::Get(input.inputs[1]), nullptr,
+		                             QueryErrorContext());
+		auto table_entry = catalog.GetEntry(context, schema, table_lookup, OnEntryNotFound::THROW_EXCEPTION);
+		tables.push_back(table_entry->Cast<DuckLakeTableEntry>());
+	} else {
+		auto schemas = ducklake_catalog.GetSchemas(context);
+		for (auto &cur_schema : schemas) {
+			cur_schema.get().Scan(context, CatalogType::TABLE_ENTRY,
+			                      [&](CatalogEntry &entry) { tables.push_back(entry.Cast<DuckLakeTableEntry>()); });
+		}
+	}
+
+	// files with a large fraction of deleted rows are rewritten without the deleted rows
+	vector<DuckLakeCompactionMerge> merges;
+	vector<unique_ptr<LogicalOperator>> inline_operators;
+	for (auto &table_ref : tables) {
+		auto &table = table_ref.get();
+		GenerateCompaction(context, transaction, ducklake_catalog, input, table, CompactionType::REWRITE_DELETES,
+		                   delete_threshold, merges);
+		// the delete files of the remaining files are moved into the metadata catalog if they are small enough
+		auto schema_id = table.ParentSchema().Cast<DuckLakeSchemaEntry>().GetSchemaId();
+		auto table_inline_limit = inline_limit.IsValid()
+		                              ? inline_limit.GetIndex()
+		                              : ducklake_catalog.DeleteInliningRowLimit(schema_id, table.GetTableId());
+		if (table_inline_limit == 0) {
+			continue;
+		}
+		auto inline_files = GetDeleteFilesToInline(transaction, table, delete_threshold, table_inline_limit);
+		if (!inline_files.empty()) {
+			auto inline_deletes = make_uniq<DuckLakeLogicalInlineDeletes>(bind_index, table, std::move(inline_files));
+			inline_operators.push_back(std::move(inline_deletes));
+		}
+	}
+	if (inline_operators.empty()) {
+		return GenerateCompactionOperator(context, transaction, ducklake_catalog, input, bind_index,
+		                                  CompactionType::REWRITE_DELETES, delete_threshold, merges);
+	}
+	vector<unique_ptr<LogicalOperator>> operators;
+	for (auto &merge : merges) {
+		auto compactor = CreateCompactor(context, transaction, ducklake_catalog, input, merge.table_id,
+		                                 CompactionType::REWRITE_DELETES, delete_threshold);
+		auto compaction_command = compactor.GenerateCompactionCommand(std::move(merge.files));
+		if (compaction_command) {
+			operators.push_back(std::move(compaction_command));
+		}
+	}
+	for (auto &inline_operator : inline_operators) {
+		operators.push_back(std::move(inline_operator));
+	}
+	if (operators.size() == 1) {
+		return std::move(operators[0]);
+	}
+	auto union_op = input.binder->UnionOperators(std::move(operators));
+	union_op->Cast<LogicalSetOperation>().table_index = bind_index;
+	return union_op;
+}
+
+TableFunctionSet DuckLakeConsolidateDeletesFunction::GetFunctions() {
+	TableFunctionSet set("ducklake_consolidate_deletes");
+	vector<vector<LogicalType>> at_types {{LogicalType::VARCHAR, LogicalType::VARCHAR}, {LogicalType::VARCHAR}};
+	for (auto &type : at_types) {
+		TableFunction function("ducklake_consolidate_deletes", type, nullptr, nullptr, nullptr);
+		function.bind_operator = ConsolidateDeletesBind;
+		function.named_parameters["delete_threshold"] = LogicalType::DOUBLE;
+		function.named_parameters["inline_limit"] = LogicalType::UBIGINT;
 		if (type.size() == 2) {
 			function.named_parameters["schema"] = LogicalType::VARCHAR;
 		}
@@ -1,9 +1,14 @@
 #include "functions/ducklake_table_functions.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/main/database_manager.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
 #include "storage/ducklake_catalog.hpp"
 #include "storage/ducklake_transaction.hpp"
 
+#include <chrono>
+
 namespace duckdb {
 
 struct ExpireSnapshotsBindData : public TableFunctionData {
@@ -14,6 +19,10 @@ struct ExpireSnapshotsBindData : public TableFunctionData {
 	vector<DuckLakeSnapshotInfo> snapshots;
 	bool dry_run = false;
 	bool valid = true;
+	//! The amount of snapshots that are expired per metadata transaction
+	idx_t batch_size = 1000;
+	//! The time waited between two batches (in microseconds)
+	idx_t batch_delay_us = 0;
 };
 
 static unique_ptr<FunctionData> DuckLakeExpireSnapshotsBind(ClientContext &context, TableFunctionBindInput &input,
@@ -28,6 +37,8 @@ static unique_ptr<FunctionData> DuckLakeExpireSnapshotsBind(ClientContext &conte
 	DuckLakeSnapshotsFunction::GetSnapshotTypes(return_types, names);
 
 	const auto older_than_default = ducklake_catalog.GetConfigOption<string>("expire_older_than", {}, {}, "");
+	result->batch_size = ducklake_catalog.GetConfigOption<idx_t>("expire_snapshots_batch_size", {}, {}, 1000);
+	auto batch_delay = ducklake_catalog.GetConfigOption<string>("expire_snapshots_batch_delay", {}, {}, "");
 
 	for (auto &entry : input.named_parameters) {
 		if (StringUtil::CIEquals(entry.first, "dry_run")) {
@@ -43,6 +54,10 @@ static unique_ptr<FunctionData> DuckLakeExpireSnapshotsBind(ClientContext &conte
 		} else if (StringUtil::CIEquals(entry.first, "older_than")) {
 			from_timestamp = entry.second.GetValue<timestamp_tz_t>();
 			has_timestamp = true;
+		} else if (StringUtil::CIEquals(entry.first, "batch_size")) {
+			result->batch_size = UBigIntValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "batch_delay")) {
+			batch_delay = entry.second.ToString();
 		} else {
 			throw InternalException("Unsupported named parameter for ducklake_expire_snapshots");
 		}
@@ -53,6 +68,17 @@ static unique_ptr<FunctionData> DuckLakeExpireSnapshotsBind(ClientContext &conte
 		return std::move(result);
 	}
 
+	if (result->batch_size == 0) {
+		throw InvalidInputException("ducklake_expire_snapshots: batch_size must be at least 1");
+	}
+	if (!batch_delay.empty()) {
+		interval_t delay;
+		if (!Interval::FromString(batch_delay, delay) || Interval::GetMicro(delay) < 0) {
+			throw InvalidInputException("ducklake_expire_snapshots: batch_delay must be a non-negative interval");
+		}
+		result->batch_delay_us = NumericCast<idx_t>(Interval::GetMicro(delay));
+	}
+
 	string filter;
 	// we can never delete the most recent snapshot
 	filter = "snapshot_id != (SELECT MAX(snapshot_id) FROM {METADATA_CATALOG}.ducklake_snapshot) AND ";
@@ -85,6 +111,28 @@ unique_ptr<GlobalTableFunctionState> DuckLakeExpireSnapshotsInit(ClientContext &
 	return std::move(result);
 }
 
+//! Expire the snapshots in batches - every batch is expired in its own short metadata transaction
+//! This keeps the deletes against the metadata tables small and does not block concurrent commits for long. Batches
+//! that have been expired stay expired if a later batch fails or the expiration is interrupted.
+static void ExpireSnapshots(ClientContext &context, const ExpireSnapshotsBindData &data) {
+	for (idx_t batch_start = 0; batch_start < data.snapshots.size(); batch_start += data.batch_size) {
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		if (batch_start > 0 && data.batch_delay_us > 0) {
+			std::this_thread::sleep_for(std::chrono::microseconds(data.batch_delay_us));
+		}
+		auto batch_end = MinValue<idx_t>(batch_start + data.batch_size, data.snapshots.size());
+		vector<DuckLakeSnapshotInfo> batch(data.snapshots.begin() + NumericCast<int64_t>(batch_start),
+		                                   data.snapshots.begin() + NumericCast<int64_t>(batch_end));
+		Connection con(data.catalog.GetDatabase());
+		con.BeginTransaction();
+		auto &transaction = DuckLakeTransaction::Get(*con.context, data.catalog);
+		transaction.DeleteSnapshots(batch);
+		con.Commit();
+	}
+}
+
 void DuckLakeExpireSnapshotsExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &data = data_p.bind_data->Cast<ExpireSnapshotsBindData>();
 	if (!data.valid) {
@@ -95,8 +143,8 @@ void DuckLakeExpireSnapshotsExecute(ClientContext &context, TableFunctionInput &
 		return;
 	}
 	if (!state.executed && !data.dry_run) {
-		auto &transaction = DuckLakeTransaction::Get(context, data.catalog);
-		transaction.DeleteSnapshots(data.snapshots);
+		ExpireSnapshots(context, data);
+		state.executed = true;
 	}
 
 	idx_t count = 0;
@@ -116,6 +164,8 @@ DuckLakeExpireSnapshotsFunction::DuckLakeExpireSnapshotsFunction()
 	named_parameters["older_than"] = LogicalType::TIMESTAMP_TZ;
 	named_parameters["versions"] = LogicalType::LIST(LogicalType::UBIGINT);
 	named_parameters["dry_run"] = LogicalType::BOOLEAN;
+	named_parameters["batch_size"] = LogicalType::UBIGINT;
+	named_parameters["batch_delay"] = LogicalType::INTERVAL;
 }
 
 } // namespace duckdb
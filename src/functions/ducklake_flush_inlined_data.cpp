@@ -16,6 +16,10 @@
 #include "duckdb/planner/operator/logical_empty_result.hpp"
 #include "storage/ducklake_flush_data.hpp"
 #include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_order.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 
 namespace duckdb {
 
@@ -60,6 +64,8 @@ SinkFinalizeType DuckLakeFlushData::Finalize(Pipeline &pipeline, Event &event, C
 	auto &global_state = input.global_state.Cast<DuckLakeInsertGlobalState>();
 
 	// add the files to the transaction
+	DuckLakeInsert::ComputeBloomFilters(context, global_state.table, global_state.written_files);
+	DuckLakeInsert::ComputeHistograms(context, global_state.table, global_state.written_files);
 	auto &transaction = DuckLakeTransaction::Get(context, global_state.table.catalog);
 	transaction.AppendFiles(global_state.table.GetTableId(), std::move(global_state.written_files));
 
@@ -113,6 +119,118 @@ public:
 	}
 };
 
+//===--------------------------------------------------------------------===//
+// Parallel Flush
+//===--------------------------------------------------------------------===//
+DuckLakeParallelFlush::DuckLakeParallelFlush(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+                                             DuckLakeCatalog &catalog,
+                                             vector<vector<DuckLakeCompactionTableTarget>> batches_p,
+                                             idx_t max_concurrency)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, 0), catalog(catalog),
+      batches(std::move(batches_p)), max_concurrency(max_concurrency) {
+}
+
+SourceResultType DuckLakeParallelFlush::GetData(ExecutionContext &context, DataChunk &chunk,
+                                                OperatorSourceInput &input) const {
+	mutex lock;
+	idx_t next_batch = 0;
+	vector<ErrorData> errors;
+	auto catalog_name = KeywordHelper::WriteQuoted(catalog.GetName(), '\'');
+	auto run_flushes = [&]() {
+		try {
+			Connection con(catalog.GetDatabase());
+			while (true) {
+				idx_t batch_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_batch >= batches.size() || context.client.interrupted) {
+						return;
+					}
+					batch_idx = next_batch++;
+				}
+				// all tables of a batch are flushed (and committed) in a single transaction
+				vector<string> queries;
+				queries.push_back("BEGIN TRANSACTION");
+				for (auto &table : batches[batch_idx]) {
+					queries.push_back(StringUtil::Format(
+					    "CALL ducklake_flush_inlined_data(%s, schema_name => %s, table_name => %s)", catalog_name,
+					    KeywordHelper::WriteQuoted(table.schema_name, '\''),
+					    KeywordHelper::WriteQuoted(table.table_name, '\'')));
+				}
+				queries.push_back("COMMIT");
+				for (auto &query : queries) {
+					auto result = con.Query(query);
+					if (result->HasError()) {
+						{
+							lock_guard<mutex> guard(lock);
+							errors.push_back(result->GetErrorObject());
+						}
+						if (con.HasActiveTransaction()) {
+							con.Query("ROLLBACK");
+						}
+						break;
+					}
+				}
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			errors.emplace_back(ex);
+		}
+	};
+#ifndef DUCKDB_NO_THREADS
+	auto thread_count = MinValue<idx_t>(max_concurrency, batches.size());
+	vector<thread> threads;
+	for (idx_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(run_flushes);
+	}
+	run_flushes();
+	for (auto &flush_thread : threads) {
+		flush_thread.join();
+	}
+#else
+	run_flushes();
+#endif
+	if (!errors.empty()) {
+		errors[0].Throw("Failed to flush inlined data in DuckLake: ");
+	}
+	return SourceResultType::FINISHED;
+}
+
+string DuckLakeParallelFlush::GetName() const {
+	return "DUCKLAKE_PARALLEL_FLUSH";
+}
+
+class DuckLakeLogicalParallelFlush : public LogicalExtensionOperator {
+public:
+	DuckLakeLogicalParallelFlush(idx_t table_index, DuckLakeCatalog &catalog,
+	                             vector<vector<DuckLakeCompactionTableTarget>> batches_p, idx_t max_concurrency)
+	    : table_index(table_index), catalog(catalog), batches(std::move(batches_p)), max_concurrency(max_concurrency) {
+	}
+
+	idx_t table_index;
+	DuckLakeCatalog &catalog;
+	vector<vector<DuckLakeCompactionTableTarget>> batches;
+	idx_t max_concurrency;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		return planner.Make<DuckLakeParallelFlush>(types, catalog, std::move(batches), max_concurrency);
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		vector<ColumnBinding> result;
+		result.emplace_back(table_index, 0);
+		return result;
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BOOLEAN};
+	}
+};
+
 ////===--------------------------------------------------------------------===//
 //// Compaction Command Generator
 ////===--------------------------------------------------------------------===//
@@ -187,6 +305,13 @@ unique_ptr<LogicalOperator> DuckLakeDataFlusher::GenerateFlushCommand() {
 
 	auto root = unique_ptr_cast<LogicalGet, LogicalOperator>(std::move(ducklake_scan));
 
+	if (!copy_options.sort_orders.empty()) {
+		// sort the rows prior to writing them
+		auto order = make_uniq<LogicalOrder>(std::move(copy_options.sort_orders));
+		order->children.push_back(std::move(root));
+		root = std::move(order);
+	}
+
 	if (!copy_options.projection_list.empty()) {
 		// push a projection
 		auto proj = make_uniq<LogicalProjection>(binder.GenerateTableIndex(), std::move(copy_options.projection_list));
@@ -256,6 +381,16 @@ static unique_ptr<LogicalOperator> FlushInlinedDataBind(ClientContext &context,
 		table = StringValue::Get(table_entry->second);
 	}
 
+	// the amount of tables that are flushed concurrently when flushing multiple tables
+	auto max_concurrency = ducklake_catalog.GetConfigOption<idx_t>("compaction_max_concurrency", {}, {}, 1);
+	auto max_concurrency_entry = named_parameters.find("max_concurrency");
+	if (max_concurrency_entry != named_parameters.end()) {
+		max_concurrency = UBigIntValue::Get(max_concurrency_entry->second);
+	}
+	if (max_concurrency == 0) {
+		throw BinderException("The max_concurrency option must be at least 1");
+	}
+
 	// no or table schema specified - scan all schemas
 	vector<reference<DuckLakeTableEntry>> tables;
 	if (table.empty()) {
@@ -282,6 +417,30 @@ static unique_ptr<LogicalOperator> FlushInlinedDataBind(ClientContext &context,
 		tables.push_back(table_entry->Cast<DuckLakeTableEntry>());
 	}
 
+	return_names.push_back("Success");
+	if (max_concurrency > 1) {
+		vector<reference<DuckLakeTableEntry>> flushed_tables;
+		for (auto &table_ref : tables) {
+			if (!table_ref.get().GetInlinedDataTables().empty()) {
+				flushed_tables.push_back(table_ref);
+			}
+		}
+		if (flushed_tables.size() > 1) {
+			// flush the tables in parallel - split them into one batch per connection, each committed on its own
+			auto batch_count = MinValue<idx_t>(max_concurrency, flushed_tables.size());
+			vector<vector<DuckLakeCompactionTableTarget>> batches(batch_count);
+			for (idx_t table_idx = 0; table_idx < flushed_tables.size(); table_idx++) {
+				auto &flushed_table = flushed_tables[table_idx].get();
+				DuckLakeCompactionTableTarget target;
+				target.schema_name = flushed_table.ParentSchema().name;
+				target.table_name = flushed_table.name;
+				batches[table_idx % batch_count].push_back(std::move(target));
+			}
+			return make_uniq<DuckLakeLogicalParallelFlush>(bind_index, ducklake_catalog, std::move(batches),
+			                                               max_concurrency);
+		}
+	}
+
 	// try to compact all tables
 	vector<unique_ptr<LogicalOperator>> flushes;
 	for (auto &table_ref : tables) {
@@ -293,7 +452,6 @@ static unique_ptr<LogicalOperator> FlushInlinedDataBind(ClientContext &context,
 			flushes.push_back(compactor.GenerateFlushCommand());
 		}
 	}
-	return_names.push_back("Success");
 	if (flushes.empty()) {
 		// nothing to write - generate empty result
 		vector<ColumnBinding> bindings;
@@ -315,6 +473,7 @@ DuckLakeFlushInlinedDataFunction::DuckLakeFlushInlinedDataFunction()
     : TableFunction("ducklake_flush_inlined_data", {LogicalType::VARCHAR}, nullptr, nullptr, nullptr) {
 	named_parameters["schema_name"] = LogicalType::VARCHAR;
 	named_parameters["table_name"] = LogicalType::VARCHAR;
+	named_parameters["max_concurrency"] = LogicalType::UBIGINT;
 	bind_operator = FlushInlinedDataBind;
 }
 
@@ -0,0 +1,138 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "storage/ducklake_transaction.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_schema_entry.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_insert.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
+#include "storage/ducklake_buffer_data.hpp"
+#include "duckdb/execution/operator/helper/physical_empty_result.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+#include "duckdb/planner/operator/logical_set_operation.hpp"
+#include "duckdb/planner/operator/logical_empty_result.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Logical Operator
+//===--------------------------------------------------------------------===//
+class DuckLakeLogicalFlushInsertBuffer : public LogicalExtensionOperator {
+public:
+	DuckLakeLogicalFlushInsertBuffer(idx_t table_index, DuckLakeTableEntry &table)
+	    : table_index(table_index), table(table) {
+	}
+
+	idx_t table_index;
+	DuckLakeTableEntry &table;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		// the buffered rows are emitted by the DuckLakeBufferData operator - the source itself is empty
+		vector<LogicalType> column_types;
+		auto &columns = table.GetColumns();
+		for (idx_t i = 0; i < columns.PhysicalColumnCount(); i++) {
+			column_types.push_back(columns.GetColumn(PhysicalIndex(i)).Type());
+		}
+		auto &empty_source = planner.Make<PhysicalEmptyResult>(std::move(column_types), 0);
+		auto &buffer_data = planner.Make<DuckLakeBufferData>(empty_source, table, DuckLakeInsertBufferLimits(), true);
+
+		// write the buffered rows like a regular insert
+		DuckLakeCopyInput copy_input(context, table);
+		auto &physical_copy = DuckLakeInsert::PlanCopyForInsert(context, planner, copy_input, buffer_data);
+		auto &insert = DuckLakeInsert::PlanInsert(context, planner, table, std::move(copy_input.encryption_key));
+		insert.children.push_back(physical_copy);
+		return insert;
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		vector<ColumnBinding> result;
+		result.emplace_back(table_index, 0);
+		return result;
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BIGINT};
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Function
+//===--------------------------------------------------------------------===//
+static unique_ptr<LogicalOperator> FlushInsertBufferBind(ClientContext &context, TableFunctionBindInput &input,
+                                                         idx_t bind_index, vector<string> &return_names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto &ducklake_catalog = catalog.Cast<DuckLakeCatalog>();
+	auto &insert_buffer = ducklake_catalog.GetInsertBuffer();
+
+	auto &named_parameters = input.named_parameters;
+
+	string schema;
+	string table;
+	auto schema_entry = named_parameters.find("schema_name");
+	if (schema_entry != named_parameters.end()) {
+		// specific schema
+		schema = StringValue::Get(schema_entry->second);
+	}
+	auto table_entry = named_parameters.find("table_name");
+	if (table_entry != named_parameters.end()) {
+		table = StringValue::Get(table_entry->second);
+	}
+
+	vector<reference<DuckLakeTableEntry>> tables;
+	if (table.empty()) {
+		// no specific table - scan all tables from the relevant schemas
+		vector<reference<SchemaCatalogEntry>> schemas;
+		if (schema.empty()) {
+			schemas = ducklake_catalog.GetSchemas(context);
+		} else {
+			schemas.push_back(ducklake_catalog.GetSchema(context, schema));
+		}
+		for (auto &schema : schemas) {
+			schema.get().Scan(context, CatalogType::TABLE_ENTRY,
+			                  [&](CatalogEntry &entry) { tables.push_back(entry.Cast<DuckLakeTableEntry>()); });
+		}
+	} else {
+		// specific table - fetch the table
+		auto table_entry =
+		    ducklake_catalog.GetEntry<TableCatalogEntry>(context, schema, table, OnEntryNotFound::THROW_EXCEPTION);
+		tables.push_back(table_entry->Cast<DuckLakeTableEntry>());
+	}
+
+	// flush the buffers of all tables that have buffered rows
+	vector<unique_ptr<LogicalOperator>> flushes;
+	for (auto &table_ref : tables) {
+		auto &table = table_ref.get();
+		if (!insert_buffer.HasBufferedRows(table.GetTableId())) {
+			continue;
+		}
+		flushes.push_back(make_uniq<DuckLakeLogicalFlushInsertBuffer>(input.binder->GenerateTableIndex(), table));
+	}
+	return_names.push_back("row_count");
+	if (flushes.empty()) {
+		// nothing to write - generate empty result
+		vector<ColumnBinding> bindings;
+		vector<LogicalType> return_types;
+		bindings.emplace_back(bind_index, 0);
+		return_types.emplace_back(LogicalType::BIGINT);
+		return make_uniq<LogicalEmptyResult>(std::move(return_types), std::move(bindings));
+	}
+	if (flushes.size() == 1) {
+		flushes[0]->Cast<DuckLakeLogicalFlushInsertBuffer>().table_index = bind_index;
+		return std::move(flushes[0]);
+	}
+	auto union_op = input.binder->UnionOperators(std::move(flushes));
+	union_op->Cast<LogicalSetOperation>().table_index = bind_index;
+	return union_op;
+}
+
+DuckLakeFlushInsertBufferFunction::DuckLakeFlushInsertBufferFunction()
+    : TableFunction("ducklake_flush_insert_buffer", {LogicalType::VARCHAR}, nullptr, nullptr, nullptr) {
+	named_parameters["schema_name"] = LogicalType::VARCHAR;
+	named_parameters["table_name"] = LogicalType::VARCHAR;
+	bind_operator = FlushInsertBufferBind;
+}
+
+} // namespace duckdb
@@ -7,28 +7,56 @@
 
 namespace duckdb {
 
-static void AddFileInfo(DuckLakeFileData &file_info, vector<Value> &row_values) {
+//! The amount of files that is read from the metadata catalog at a time - the file list is converted into the result as
+//! it is read, so listing the files of a large table does not materialize the full file list
+static constexpr idx_t LIST_FILES_PAGE_SIZE = 10 * STANDARD_VECTOR_SIZE;
+
+struct DuckLakeListFilesData : public TableFunctionData {
+	DuckLakeListFilesData(Catalog &catalog, DuckLakeTableEntry &table, DuckLakeSnapshot snapshot)
+	    : catalog(catalog), table(table), snapshot(snapshot) {
+	}
+
+	Catalog &catalog;
+	DuckLakeTableEntry &table;
+	DuckLakeSnapshot snapshot;
+};
+
+struct DuckLakeListFilesState : public GlobalTableFunctionState {
+	//! The current page of the file list
+	vector<DuckLakeFileListEntry> files;
+	idx_t offset = 0;
+	//! The id of the last file of the current page
+	optional_idx last_file_id;
+	bool finished = false;
+};
+
+static void WriteFileInfo(const DuckLakeFileData &file_info, DataChunk &output, idx_t column_idx, idx_t row_idx) {
+	auto &path = output.data[column_idx];
+	auto &file_size = output.data[column_idx + 1];
+	auto &footer_size = output.data[column_idx + 2];
+	auto &encryption_key = output.data[column_idx + 3];
 	// add the file info - if we have a file
 	if (file_info.path.empty()) {
 		// no file - push NULL values
 		// this can happen for delete files
-		row_values.emplace_back();
-		row_values.emplace_back();
-		row_values.emplace_back();
-		row_values.emplace_back();
+		FlatVector::SetNull(path, row_idx, true);
+		FlatVector::SetNull(file_size, row_idx, true);
+		FlatVector::SetNull(footer_size, row_idx, true);
+		FlatVector::SetNull(encryption_key, row_idx, true);
 		return;
 	}
-	row_values.emplace_back(file_info.path);
-	row_values.push_back(Value::UBIGINT(file_info.file_size_bytes));
+	FlatVector::GetData<string_t>(path)[row_idx] = StringVector::AddString(path, file_info.path);
+	FlatVector::GetData<uint64_t>(file_size)[row_idx] = file_info.file_size_bytes;
 	if (file_info.footer_size.IsValid()) {
-		row_values.push_back(Value::UBIGINT(file_info.footer_size.GetIndex()));
+		FlatVector::GetData<uint64_t>(footer_size)[row_idx] = file_info.footer_size.GetIndex();
 	} else {
-		row_values.emplace_back();
+		FlatVector::SetNull(footer_size, row_idx, true);
 	}
 	if (file_info.encryption_key.empty()) {
-		row_values.emplace_back();
+		FlatVector::SetNull(encryption_key, row_idx, true);
 	} else {
-		row_values.emplace_back(Value::BLOB_RAW(file_info.encryption_key));
+		FlatVector::GetData<string_t>(encryption_key)[row_idx] =
+		    StringVector::AddStringOrBlob(encryption_key, file_info.encryption_key);
 	}
 }
 
@@ -84,29 +112,52 @@ static unique_ptr<FunctionData> DuckLakeListFilesBind(ClientContext &context, Ta
 	auto table_entry = catalog.GetEntry(context, schema, table_lookup, OnEntryNotFound::THROW_EXCEPTION);
 	auto &ducklake_table = table_entry->Cast<DuckLakeTableEntry>();
 	auto snapshot = transaction.GetSnapshot(at_clause.get());
+	// the file list is read during execution
+	return make_uniq<DuckLakeListFilesData>(catalog, ducklake_table, snapshot);
+}
 
-	// fetch the file list
-	auto &metadata_manager = transaction.GetMetadataManager();
-	// FIXME: support predicate pushdown
-	string filter;
-	auto files = metadata_manager.GetFilesForTable(ducklake_table, snapshot, filter);
-	// generate the result
-	auto result = make_uniq<MetadataBindData>();
-	for (auto &file : files) {
-		vector<Value> row_values;
-		// data file
-		auto &data_file = file.file;
-		AddFileInfo(data_file, row_values);
+static unique_ptr<GlobalTableFunctionState> DuckLakeListFilesInit(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	return make_uniq<DuckLakeListFilesState>();
+}
 
-		auto &delete_file = file.delete_file;
-		AddFileInfo(delete_file, row_values);
-		result->rows.push_back(std::move(row_values));
+static void DuckLakeListFilesExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DuckLakeListFilesData>();
+	auto &state = data_p.global_state->Cast<DuckLakeListFilesState>();
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (state.offset >= state.files.size()) {
+			if (state.finished) {
+				break;
+			}
+			// fetch the next page of the file list
+			auto &transaction = DuckLakeTransaction::Get(context, data.catalog);
+			auto &metadata_manager = transaction.GetMetadataManager();
+			// FIXME: support predicate pushdown
+			string filter;
+			state.files = metadata_manager.GetFilesForTablePage(data.table, data.snapshot, filter, state.last_file_id,
+			                                                    LIST_FILES_PAGE_SIZE);
+			state.offset = 0;
+			state.finished = state.files.size() < LIST_FILES_PAGE_SIZE;
+			if (!state.files.empty()) {
+				state.last_file_id = state.files.back().file_id.index;
+			}
+			continue;
+		}
+		auto &file = state.files[state.offset++];
+		// data file
+		WriteFileInfo(file.file, output, 0, count);
+		// delete file
+		WriteFileInfo(file.delete_file, output, 4, count);
+		count++;
 	}
-	return std::move(result);
+	output.SetCardinality(count);
 }
 
 DuckLakeListFilesFunction::DuckLakeListFilesFunction()
     : BaseMetadataFunction("ducklake_list_files", DuckLakeListFilesBind) {
+	init_global = DuckLakeListFilesInit;
+	function = DuckLakeListFilesExecute;
 	arguments.push_back(LogicalType::VARCHAR);
 	named_parameters["schema"] = LogicalType::VARCHAR;
 	named_parameters["snapshot_version"] = LogicalType::BIGINT;
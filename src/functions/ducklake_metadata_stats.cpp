@@ -0,0 +1,64 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_stats.hpp"
+
+namespace duckdb {
+
+static Value TimeInMs(idx_t time_us) {
+	return Value::DOUBLE(static_cast<double>(time_us) / 1000.0);
+}
+
+static unique_ptr<FunctionData> DuckLakeMetadataStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types, vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto &ducklake_catalog = catalog.Cast<DuckLakeCatalog>();
+
+	names.emplace_back("operation");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("queries");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("errors");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("rows");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("bytes");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("total_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("avg_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("max_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("latency_histogram");
+	return_types.emplace_back(LogicalType::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT));
+
+	auto result = make_uniq<MetadataBindData>();
+	for (auto &entry : ducklake_catalog.GetMetadataStats().GetStats()) {
+		auto &stats = entry.second;
+		vector<Value> bucket_names;
+		vector<Value> bucket_counts;
+		for (idx_t bucket = 0; bucket < DuckLakeMetadataOperationStats::BUCKET_COUNT; bucket++) {
+			bucket_names.push_back(Value(DuckLakeMetadataOperationStats::GetBucketName(bucket)));
+			bucket_counts.push_back(Value::UBIGINT(stats.latency_buckets[bucket]));
+		}
+		vector<Value> row_values;
+		row_values.push_back(Value(entry.first));
+		row_values.push_back(Value::UBIGINT(stats.queries));
+		row_values.push_back(Value::UBIGINT(stats.errors));
+		row_values.push_back(Value::UBIGINT(stats.rows));
+		row_values.push_back(Value::UBIGINT(stats.bytes));
+		row_values.push_back(TimeInMs(stats.total_time_us));
+		row_values.push_back(TimeInMs(stats.queries == 0 ? 0 : stats.total_time_us / stats.queries));
+		row_values.push_back(TimeInMs(stats.max_time_us));
+		row_values.push_back(Value::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT, std::move(bucket_names),
+		                                std::move(bucket_counts)));
+		result->rows.push_back(std::move(row_values));
+	}
+	return std::move(result);
+}
+
+DuckLakeMetadataStatsFunction::DuckLakeMetadataStatsFunction()
+    : BaseMetadataFunction("ducklake_metadata_stats", DuckLakeMetadataStatsBind) {
+}
+
+} // namespace duckdb
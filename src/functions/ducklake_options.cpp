@@ -12,10 +12,22 @@ struct DuckLakeOptionMetadata {
 	const char *description;
 };
 
-using ducklake_option_array = std::array<DuckLakeOptionMetadata, 19>;
+using ducklake_option_array = std::array<DuckLakeOptionMetadata, 44>;
 
 static constexpr const ducklake_option_array DUCKLAKE_OPTIONS = {
     {{"data_inlining_row_limit", "Maximum amount of rows to inline in a single insert"},
+     {"delete_inlining_row_limit",
+      "Maximum amount of deleted rows of a data file to store in the metadata catalog instead of in a delete file"},
+     {"insert_buffer_row_limit",
+      "Buffer inserts of auto-commit transactions in memory and write them once this many rows are buffered"},
+     {"insert_buffer_size", "Write the buffered inserts of a table once they exceed this size"},
+     {"insert_buffer_flush_interval", "Write the buffered inserts of a table once the oldest row exceeds this age"},
+     {"insert_buffer_ack_mode",
+      "When buffered inserts are acknowledged: 'buffered' once buffered, 'committed' once their rows are written"},
+     {"auto_flush_inlined_row_limit",
+      "Flush the inlined data of a table to Parquet in the background once this many rows have been inlined"},
+     {"auto_flush_inlined_size",
+      "Flush the inlined data of a table to Parquet in the background once the inlined rows exceed this size"},
      {"parquet_compression",
       "Compression algorithm for Parquet files (uncompressed, snappy, gzip, zstd, brotli, lz4, lz4_raw)"},
      {"parquet_version", "Parquet format version (1 or 2)"},
@@ -24,6 +36,8 @@ static constexpr const ducklake_option_array DUCKLAKE_OPTIONS = {
      {"parquet_row_group_size_bytes", "Number of bytes per row group in Parquet files"},
      {"hive_file_pattern", "If partitioned data should be written in a hive-like folder structure"},
      {"target_file_size", "The target data file size for insertion and compaction operations"},
+     {"adaptive_file_size", "Choose the target file size and row group size of tables that do not configure them "
+                            "from their column count, write rate and scan selectivity"},
      {"version", "DuckLake format version"},
      {"created_by", "Tool used to write the DuckLake"},
      {"data_path", "Path to data files"},
@@ -32,15 +46,68 @@ static constexpr const ducklake_option_array DUCKLAKE_OPTIONS = {
                                   "removed from a file before a rewrite is warranted. From 0 - 1."},
      {"delete_older_than", "How old unused files must be to be removed by the 'ducklake_delete_orphaned_files' and "
                            "'ducklake_cleanup_old_files' cleanup functions."},
+     {"cleanup_max_concurrency", "The amount of files that 'ducklake_cleanup_old_files' and "
+                                 "'ducklake_delete_orphaned_files' remove concurrently"},
+     {"orphan_cleanup_checkpoint", "The id of the last table whose directory was examined by an incremental "
+                                   "'ducklake_delete_orphaned_files' run - the next run continues with the next table"},
+     {"materialized_view_snapshot", "The last snapshot of the source table that was applied to a materialized view "
+                                    "by 'ducklake_refresh_materialized_view'"},
+     {"archive_snapshot", "Ended file rows up to this snapshot were moved to the archive tables by "
+                          "'ducklake_archive_files' - only queries of older snapshots read the archive"},
      {"expire_older_than", "How old snapshots must be, by default, to be expired by: 'ducklake_expire_snapshots'"},
+     {"expire_snapshots_batch_size", "The amount of snapshots that 'ducklake_expire_snapshots' expires per "
+                                     "metadata transaction"},
+     {"expire_snapshots_batch_delay", "The time 'ducklake_expire_snapshots' waits between two batches of expired "
+                                      "snapshots, giving concurrent commits room to proceed"},
      {"compaction_schema", "Pre-defined schema used as a default value for the following compaction functions "
                            "'ducklake_flush_inlined_data','ducklake_merge_adjacent_files', "
                            "'ducklake_rewrite_data_files', 'ducklake_delete_orphaned_files'"},
      {"compaction_table", "Pre-defined table used as a default value for the following compaction functions "
                           "'ducklake_flush_inlined_data','ducklake_merge_adjacent_files', "
                           "'ducklake_rewrite_data_files', 'ducklake_delete_orphaned_files'"},
+     {"compaction_max_concurrency", "The amount of tables that 'ducklake_merge_adjacent_files' and "
+                                    "'ducklake_rewrite_data_files' compact concurrently, each in its own transaction, "
+                                    "and the amount of batches of tables 'ducklake_flush_inlined_data' flushes "
+                                    "concurrently"},
+     {"checkpoint_max_concurrency", "The amount of tables that CHECKPOINT flushes and compacts concurrently, each "
+                                    "in its own transactions"},
+     {"metadata_bulk_insert_threshold", "Inserts of at least this many rows into a metadata table are appended in "
+                                        "bulk (through the appender for DuckDB, and binary COPY for Postgres) "
+                                        "instead of through INSERT statements. 0 disables bulk inserts"},
+     {"checkpoint_snapshot", "The snapshot up to which the changes made to a table were processed by CHECKPOINT - "
+                             "tables that were not changed since are skipped, unless FORCE CHECKPOINT is used"},
+     {"auto_compaction_file_count", "Merge the files of a table in the background once this many files below the "
+                                    "target file size have been written to it"},
+     {"auto_compaction_delete_ratio", "Rewrite the files of a table in the background once this fraction of its "
+                                      "rows has been deleted. From 0 - 1."},
+     {"compaction_max_bytes", "The maximum amount of bytes a single compaction call rewrites - the most valuable "
+                              "merges are picked first and the rest is left for the next call"},
+     {"compaction_max_duration", "When compacting multiple tables, no new table is started once a compaction call "
+                                 "has run for this long"},
+     {"compaction_strategy", "How 'ducklake_merge_adjacent_files' picks the files to merge: 'adjacent' merges runs of "
+                             "consecutive files, 'bin_pack' packs the files of a partition into target-sized files"},
+     {"compaction_size_tolerance", "With the 'bin_pack' compaction strategy, files within this fraction of the target "
+                                   "file size are not rewritten. From 0 - 1."},
+     {"compaction_passthrough", "Whether 'ducklake_merge_adjacent_files' copies the row groups of files that only "
+                                "hold table columns of the same schema into the merged file as-is, instead of "
+                                "decoding and rewriting their rows"},
      {"encrypted", "Whether or not to encrypt Parquet files written to the data path"},
-     {"per_thread_output", "Whether to create separate output files per thread during parallel insertion"}}};
+     {"footer_prefetch_count", "The amount of upcoming remote files whose footers are fetched in the background "
+                               "while a file is scanned - 0 disables prefetching"},
+     {"read_ahead_file_size", "Upcoming remote files up to this size are fetched completely instead of only their "
+                              "footers - 0 disables reading ahead"},
+     {"read_ahead_memory_limit", "The total size of the files that the scans of this DuckLake read ahead at any time"},
+     {"per_thread_output", "Whether to create separate output files per thread during parallel insertion"},
+     {"bloom_filter_columns", "Comma-separated list of columns for which per-file Bloom filters are stored, used to "
+                              "prune files on equality and IN filters - CREATE INDEX adds columns to this list"},
+     {"histogram_columns", "Comma-separated list of numeric or temporal columns for which per-file equi-depth "
+                           "histograms are stored, used to estimate the selectivity of range filters"},
+     {"sorted_by", "Comma-separated list of columns (optionally followed by ASC or DESC) used to sort rows when "
+                   "writing new files, so min/max statistics can be used to prune files on these columns"},
+     {"sort_partitioned_writes", "Sort rows by their partition before writing, so partitions are written one at a "
+                                 "time instead of keeping a writer open for every partition"},
+     {"update_mode", "How updates are written: 'merge_on_read' writes delete files next to the new rows, "
+                     "'copy_on_write' rewrites the updated files in full in the background after the update commits"}}};
 
 struct DuckLakeOptionsData : public TableFunctionData {
 	explicit DuckLakeOptionsData(Catalog &catalog) : catalog(catalog) {
@@ -0,0 +1,353 @@
+#include "functions/ducklake_partition_functions.hpp"
+
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Hashing
+//===--------------------------------------------------------------------===//
+static uint32_t RotateLeft(uint32_t value, int bits) {
+	return (value << bits) | (value >> (32 - bits));
+}
+
+//! The 32-bit x86 variant of Murmur3 (with seed 0) - which is the hash function used by Iceberg bucket transforms
+static uint32_t Murmur3Hash32(const_data_ptr_t data, idx_t length) {
+	static constexpr uint32_t C1 = 0xcc9e2d51;
+	static constexpr uint32_t C2 = 0x1b873593;
+	uint32_t hash = 0;
+	idx_t block_count = length / 4;
+	for (idx_t block_idx = 0; block_idx < block_count; block_idx++) {
+		auto block = data + block_idx * 4;
+		// blocks are read as little-endian regardless of the byte order of the machine
+		uint32_t k1 = uint32_t(block[0]) | (uint32_t(block[1]) << 8) | (uint32_t(block[2]) << 16) |
+		              (uint32_t(block[3]) << 24);
+		k1 *= C1;
+		k1 = RotateLeft(k1, 15);
+		k1 *= C2;
+		hash ^= k1;
+		hash = RotateLeft(hash, 13);
+		hash = hash * 5 + 0xe6546b64;
+	}
+	auto tail = data + block_count * 4;
+	uint32_t k1 = 0;
+	switch (length & 3) {
+	case 3:
+		k1 ^= uint32_t(tail[2]) << 16;
+		DUCKDB_EXPLICIT_FALLTHROUGH;
+	case 2:
+		k1 ^= uint32_t(tail[1]) << 8;
+		DUCKDB_EXPLICIT_FALLTHROUGH;
+	case 1:
+		k1 ^= uint32_t(tail[0]);
+		k1 *= C1;
+		k1 = RotateLeft(k1, 15);
+		k1 *= C2;
+		hash ^= k1;
+		break;
+	default:
+		break;
+	}
+	hash ^= uint32_t(length);
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+//! Integers, dates and timestamps are all hashed as their 64-bit little-endian representation
+static uint32_t HashLong(int64_t value) {
+	uint8_t bytes[sizeof(int64_t)];
+	auto unsigned_value = static_cast<uint64_t>(value);
+	for (idx_t i = 0; i < sizeof(int64_t); i++) {
+		bytes[i] = static_cast<uint8_t>(unsigned_value >> (8 * i));
+	}
+	return Murmur3Hash32(bytes, sizeof(int64_t));
+}
+
+static uint32_t HashBytes(const char *data, idx_t length) {
+	return Murmur3Hash32(const_data_ptr_cast(data), length);
+}
+
+//! UUIDs are hashed as their 16 big-endian bytes
+static uint32_t HashUUID(hugeint_t value) {
+	// DuckDB flips the top bit of UUIDs so that they sort correctly as a signed hugeint
+	auto upper = static_cast<uint64_t>(value.upper) ^ (uint64_t(1) << 63);
+	auto lower = value.lower;
+	uint8_t bytes[16];
+	for (idx_t i = 0; i < 8; i++) {
+		bytes[i] = static_cast<uint8_t>(upper >> (56 - 8 * i));
+		bytes[8 + i] = static_cast<uint8_t>(lower >> (56 - 8 * i));
+	}
+	return Murmur3Hash32(bytes, 16);
+}
+
+static int32_t ComputeBucket(int64_t bucket_count, uint32_t hash) {
+	if (bucket_count <= 0 || bucket_count > NumericLimits<int32_t>::Maximum()) {
+		throw InvalidInputException("The bucket count must be between 1 and %d, but got %d",
+		                            NumericLimits<int32_t>::Maximum(), bucket_count);
+	}
+	return static_cast<int32_t>((hash & 0x7FFFFFFF) % static_cast<uint32_t>(bucket_count));
+}
+
+//===--------------------------------------------------------------------===//
+// Truncation
+//===--------------------------------------------------------------------===//
+static void CheckWidth(int64_t width) {
+	if (width <= 0) {
+		throw InvalidInputException("The truncate width must be bigger than 0, but got %d", width);
+	}
+}
+
+//! Integers are truncated to the multiple of the width that is equal to or below the value
+static int64_t TruncateInteger(int64_t width, int64_t value) {
+	CheckWidth(width);
+	return value - (((value % width) + width) % width);
+}
+
+//! Strings are truncated to their first <width> code points
+static idx_t TruncatedStringLength(int64_t width, const char *data, idx_t length) {
+	CheckWidth(width);
+	idx_t code_points = 0;
+	for (idx_t i = 0; i < length; i++) {
+		if ((static_cast<uint8_t>(data[i]) & 0xC0) == 0x80) {
+			// continuation byte
+			continue;
+		}
+		if (code_points == static_cast<idx_t>(width)) {
+			return i;
+		}
+		code_points++;
+	}
+	return length;
+}
+
+//! Blobs are truncated to their first <width> bytes
+static idx_t TruncatedBlobLength(int64_t width, idx_t length) {
+	CheckWidth(width);
+	return MinValue<idx_t>(length, static_cast<idx_t>(width));
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar Functions
+//===--------------------------------------------------------------------===//
+template <class T>
+static void BucketIntegerFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, T, int32_t>(
+	    args.data[0], args.data[1], result, args.size(), [&](int64_t bucket_count, T input) {
+		    return ComputeBucket(bucket_count, HashLong(static_cast<int64_t>(input)));
+	    });
+}
+
+static void BucketDateFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, date_t, int32_t>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](int64_t bucket_count, date_t input) { return ComputeBucket(bucket_count, HashLong(input.days)); });
+}
+
+static void BucketTimestampFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, timestamp_t, int32_t>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](int64_t bucket_count, timestamp_t input) { return ComputeBucket(bucket_count, HashLong(input.value)); });
+}
+
+static void BucketStringFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, string_t, int32_t>(
+	    args.data[0], args.data[1], result, args.size(), [&](int64_t bucket_count, string_t input) {
+		    return ComputeBucket(bucket_count, HashBytes(input.GetData(), input.GetSize()));
+	    });
+}
+
+static void BucketUUIDFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, hugeint_t, int32_t>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](int64_t bucket_count, hugeint_t input) { return ComputeBucket(bucket_count, HashUUID(input)); });
+}
+
+template <class T>
+static void TruncateIntegerFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, T, int64_t>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](int64_t width, T input) { return TruncateInteger(width, static_cast<int64_t>(input)); });
+}
+
+static void TruncateStringFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, string_t, string_t>(
+	    args.data[0], args.data[1], result, args.size(), [&](int64_t width, string_t input) {
+		    auto length = TruncatedStringLength(width, input.GetData(), input.GetSize());
+		    return StringVector::AddString(result, input.GetData(), length);
+	    });
+}
+
+static void TruncateBlobFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<int64_t, string_t, string_t>(
+	    args.data[0], args.data[1], result, args.size(), [&](int64_t width, string_t input) {
+		    auto length = TruncatedBlobLength(width, input.GetSize());
+		    return StringVector::AddStringOrBlob(result, input.GetData(), length);
+	    });
+}
+
+static scalar_function_t GetBucketIntegerFunction(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+		return BucketIntegerFunction<int8_t>;
+	case LogicalTypeId::SMALLINT:
+		return BucketIntegerFunction<int16_t>;
+	case LogicalTypeId::INTEGER:
+		return BucketIntegerFunction<int32_t>;
+	case LogicalTypeId::BIGINT:
+		return BucketIntegerFunction<int64_t>;
+	case LogicalTypeId::UTINYINT:
+		return BucketIntegerFunction<uint8_t>;
+	case LogicalTypeId::USMALLINT:
+		return BucketIntegerFunction<uint16_t>;
+	case LogicalTypeId::UINTEGER:
+		return BucketIntegerFunction<uint32_t>;
+	default:
+		throw InternalException("Unsupported type for GetBucketIntegerFunction");
+	}
+}
+
+static scalar_function_t GetTruncateIntegerFunction(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+		return TruncateIntegerFunction<int8_t>;
+	case LogicalTypeId::SMALLINT:
+		return TruncateIntegerFunction<int16_t>;
+	case LogicalTypeId::INTEGER:
+		return TruncateIntegerFunction<int32_t>;
+	case LogicalTypeId::BIGINT:
+		return TruncateIntegerFunction<int64_t>;
+	case LogicalTypeId::UTINYINT:
+		return TruncateIntegerFunction<uint8_t>;
+	case LogicalTypeId::USMALLINT:
+		return TruncateIntegerFunction<uint16_t>;
+	case LogicalTypeId::UINTEGER:
+		return TruncateIntegerFunction<uint32_t>;
+	default:
+		throw InternalException("Unsupported type for GetTruncateIntegerFunction");
+	}
+}
+
+//! The integer types that can be bucketed and truncated - they are all converted to BIGINT first (UBIGINT is not
+//! supported as it does not fit)
+static vector<LogicalType> PartitionIntegerTypes() {
+	return {LogicalType::TINYINT,  LogicalType::SMALLINT,  LogicalType::INTEGER, LogicalType::BIGINT,
+	        LogicalType::UTINYINT, LogicalType::USMALLINT, LogicalType::UINTEGER};
+}
+
+ScalarFunctionSet DuckLakePartitionFunctions::GetBucketFunctions() {
+	ScalarFunctionSet set("ducklake_bucket");
+	for (auto &type : PartitionIntegerTypes()) {
+		set.AddFunction(
+		    ScalarFunction({LogicalType::BIGINT, type}, LogicalType::INTEGER, GetBucketIntegerFunction(type)));
+	}
+	set.AddFunction(ScalarFunction({LogicalType::BIGINT, LogicalType::DATE}, LogicalType::INTEGER, BucketDateFunction));
+	set.AddFunction(
+	    ScalarFunction({LogicalType::BIGINT, LogicalType::TIMESTAMP}, LogicalType::INTEGER, BucketTimestampFunction));
+	set.AddFunction(ScalarFunction({LogicalType::BIGINT, LogicalType::TIMESTAMP_TZ}, LogicalType::INTEGER,
+	                               BucketTimestampFunction));
+	set.AddFunction(
+	    ScalarFunction({LogicalType::BIGINT, LogicalType::VARCHAR}, LogicalType::INTEGER, BucketStringFunction));
+	set.AddFunction(
+	    ScalarFunction({LogicalType::BIGINT, LogicalType::BLOB}, LogicalType::INTEGER, BucketStringFunction));
+	set.AddFunction(ScalarFunction({LogicalType::BIGINT, LogicalType::UUID}, LogicalType::INTEGER, BucketUUIDFunction));
+	return set;
+}
+
+ScalarFunctionSet DuckLakePartitionFunctions::GetTruncateFunctions() {
+	ScalarFunctionSet set("ducklake_truncate");
+	for (auto &type : PartitionIntegerTypes()) {
+		set.AddFunction(
+		    ScalarFunction({LogicalType::BIGINT, type}, LogicalType::BIGINT, GetTruncateIntegerFunction(type)));
+	}
+	set.AddFunction(
+	    ScalarFunction({LogicalType::BIGINT, LogicalType::VARCHAR}, LogicalType::VARCHAR, TruncateStringFunction));
+	set.AddFunction(
+	    ScalarFunction({LogicalType::BIGINT, LogicalType::BLOB}, LogicalType::BLOB, TruncateBlobFunction));
+	return set;
+}
+
+//===--------------------------------------------------------------------===//
+// Transforms of constant values
+//===--------------------------------------------------------------------===//
+static bool IsPartitionIntegerType(const LogicalType &type) {
+	for (auto &integer_type : PartitionIntegerTypes()) {
+		if (type == integer_type) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DuckLakePartitionFunctions::SupportsBucket(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::UUID:
+		return true;
+	default:
+		return IsPartitionIntegerType(type);
+	}
+}
+
+bool DuckLakePartitionFunctions::SupportsTruncate(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB:
+		return true;
+	default:
+		return IsPartitionIntegerType(type);
+	}
+}
+
+int32_t DuckLakePartitionFunctions::Bucket(idx_t bucket_count, const Value &value) {
+	auto count = NumericCast<int64_t>(bucket_count);
+	switch (value.type().id()) {
+	case LogicalTypeId::DATE:
+		return ComputeBucket(count, HashLong(value.GetValueUnsafe<date_t>().days));
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return ComputeBucket(count, HashLong(value.GetValueUnsafe<timestamp_t>().value));
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB: {
+		auto &str = StringValue::Get(value);
+		return ComputeBucket(count, HashBytes(str.c_str(), str.size()));
+	}
+	case LogicalTypeId::UUID:
+		return ComputeBucket(count, HashUUID(value.GetValueUnsafe<hugeint_t>()));
+	default:
+		if (!IsPartitionIntegerType(value.type())) {
+			throw InternalException("Unsupported type for DuckLakePartitionFunctions::Bucket");
+		}
+		return ComputeBucket(count, HashLong(value.GetValue<int64_t>()));
+	}
+}
+
+Value DuckLakePartitionFunctions::Truncate(idx_t width, const Value &value) {
+	auto truncate_width = NumericCast<int64_t>(width);
+	switch (value.type().id()) {
+	case LogicalTypeId::VARCHAR: {
+		auto &str = StringValue::Get(value);
+		return Value(str.substr(0, TruncatedStringLength(truncate_width, str.c_str(), str.size())));
+	}
+	case LogicalTypeId::BLOB: {
+		auto &str = StringValue::Get(value);
+		return Value::BLOB(const_data_ptr_cast(str.c_str()), TruncatedBlobLength(truncate_width, str.size()));
+	}
+	default:
+		if (!IsPartitionIntegerType(value.type())) {
+			throw InternalException("Unsupported type for DuckLakePartitionFunctions::Truncate");
+		}
+		return Value::BIGINT(TruncateInteger(truncate_width, value.GetValue<int64_t>()));
+	}
+}
+
+} // namespace duckdb
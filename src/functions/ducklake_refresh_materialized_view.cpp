@@ -0,0 +1,327 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_schema_entry.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
+
+namespace duckdb {
+
+//! The table-scoped option in which a materialized view stores the last snapshot of the source it has processed
+static constexpr const char *MATERIALIZED_VIEW_SNAPSHOT = "materialized_view_snapshot";
+
+struct DuckLakeAggregateColumn {
+	//! The aggregate (sum, min or max)
+	string aggregate;
+	//! The column of the source table that is aggregated
+	string column;
+
+	string GetName() const {
+		return KeywordHelper::WriteOptionallyQuoted(aggregate + "_" + column);
+	}
+	string GetColumn() const {
+		return KeywordHelper::WriteOptionallyQuoted(column);
+	}
+};
+
+struct RefreshMaterializedViewBindData : public TableFunctionData {
+	explicit RefreshMaterializedViewBindData(Catalog &catalog) : catalog(catalog) {
+	}
+
+	Catalog &catalog;
+	string schema_name;
+	string view_name;
+	string source_name;
+	vector<string> group_columns;
+	vector<DuckLakeAggregateColumn> aggregates;
+
+	string QualifiedName(const string &table_name) const {
+		return KeywordHelper::WriteOptionallyQuoted(catalog.GetName()) + "." +
+		       KeywordHelper::WriteOptionallyQuoted(schema_name) + "." +
+		       KeywordHelper::WriteOptionallyQuoted(table_name);
+	}
+	bool HasMinMax() const {
+		for (auto &aggregate : aggregates) {
+			if (aggregate.aggregate != "sum") {
+				return true;
+			}
+		}
+		return false;
+	}
+	//! The condition under which the groups of the "left" and "right" relations are equal
+	string GroupCondition(const string &left, const string &right) const {
+		if (group_columns.empty()) {
+			return "TRUE";
+		}
+		vector<string> conditions;
+		for (auto &group : group_columns) {
+			auto column = KeywordHelper::WriteOptionallyQuoted(group);
+			conditions.push_back(left + "." + column + " IS NOT DISTINCT FROM " + right + "." + column);
+		}
+		return StringUtil::Join(conditions, " AND ");
+	}
+	string GroupList(const string &prefix) const {
+		vector<string> columns;
+		for (auto &group : group_columns) {
+			columns.push_back(prefix + KeywordHelper::WriteOptionallyQuoted(group));
+		}
+		return StringUtil::Join(columns, ", ");
+	}
+	//! The select list that computes the materialized view from the rows of the source table
+	string AggregateList() const {
+		vector<string> columns;
+		if (!group_columns.empty()) {
+			columns.push_back(GroupList(string()));
+		}
+		columns.push_back("COUNT(*) AS count_star");
+		for (auto &aggregate : aggregates) {
+			columns.push_back(StringUtil::Upper(aggregate.aggregate) + "(" + aggregate.GetColumn() + ") AS " +
+			                  aggregate.GetName());
+		}
+		return StringUtil::Join(columns, ", ");
+	}
+	string GroupBy() const {
+		return group_columns.empty() ? string() : " GROUP BY " + GroupList(string());
+	}
+	string FullQuery() const {
+		return "SELECT " + AggregateList() + " FROM " + QualifiedName(source_name) + GroupBy();
+	}
+};
+
+static vector<string> GetColumnList(const Value &input) {
+	vector<string> result;
+	if (input.IsNull()) {
+		return result;
+	}
+	for (auto &column : ListValue::GetChildren(input)) {
+		if (column.IsNull()) {
+			throw InvalidInputException("ducklake_refresh_materialized_view: column names cannot be NULL");
+		}
+		result.push_back(StringValue::Get(column));
+	}
+	return result;
+}
+
+static unique_ptr<FunctionData> DuckLakeRefreshMaterializedViewBind(ClientContext &context,
+                                                                    TableFunctionBindInput &input,
+                                                                    vector<LogicalType> &return_types,
+                                                                    vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto result = make_uniq<RefreshMaterializedViewBindData>(catalog);
+	if (input.inputs[1].IsNull() || input.inputs[2].IsNull()) {
+		throw InvalidInputException("ducklake_refresh_materialized_view: the view and source table cannot be NULL");
+	}
+	result->view_name = StringValue::Get(input.inputs[1]);
+	result->source_name = StringValue::Get(input.inputs[2]);
+	result->schema_name = DEFAULT_SCHEMA;
+	for (auto &entry : input.named_parameters) {
+		if (StringUtil::CIEquals(entry.first, "schema")) {
+			result->schema_name = StringValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "group_by")) {
+			result->group_columns = GetColumnList(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "sum") || StringUtil::CIEquals(entry.first, "min") ||
+		           StringUtil::CIEquals(entry.first, "max")) {
+			for (auto &column : GetColumnList(entry.second)) {
+				DuckLakeAggregateColumn aggregate;
+				aggregate.aggregate = StringUtil::Lower(entry.first);
+				aggregate.column = std::move(column);
+				result->aggregates.push_back(std::move(aggregate));
+			}
+		} else {
+			throw InternalException("Unsupported named parameter for ducklake_refresh_materialized_view");
+		}
+	}
+	if (StringUtil::CIEquals(result->view_name, result->source_name)) {
+		throw InvalidInputException("ducklake_refresh_materialized_view: the view cannot be its own source table");
+	}
+
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("snapshot_id");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("refresh_type");
+	return std::move(result);
+}
+
+struct RefreshMaterializedViewData : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeRefreshMaterializedViewInit(ClientContext &context,
+                                                                                TableFunctionInitInput &input) {
+	return make_uniq<RefreshMaterializedViewData>();
+}
+
+static void RunQuery(Connection &con, const string &query) {
+	auto result = con.Query(query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to refresh materialized view in DuckLake: ");
+	}
+}
+
+//! Apply the changes made to the source table between start_snapshot and end_snapshot to the materialized view
+//! SUM and COUNT are updated from the delta - MIN and MAX are recomputed for the groups in which rows were deleted
+//! Returns false if the source table did not change
+static bool RefreshIncremental(Connection &con, const RefreshMaterializedViewBindData &data, idx_t start_snapshot,
+                               idx_t end_snapshot) {
+	auto view = data.QualifiedName(data.view_name);
+	vector<string> change_columns;
+	vector<string> delta_columns;
+	if (!data.group_columns.empty()) {
+		change_columns.push_back(data.GroupList(string()));
+		delta_columns.push_back(data.GroupList(string()));
+	}
+	change_columns.push_back("change_type IN ('insert', 'update_postimage') AS __ducklake_insert");
+	delta_columns.push_back("SUM(CASE WHEN __ducklake_insert THEN 1 ELSE -1 END) AS count_star");
+	for (auto &aggregate : data.aggregates) {
+		auto column = aggregate.GetColumn();
+		if (aggregate.aggregate == "sum") {
+			delta_columns.push_back(StringUtil::Format("SUM(CASE WHEN __ducklake_insert THEN %s ELSE -%s END) AS %s",
+			                                           column, column, aggregate.GetName()));
+		} else {
+			delta_columns.push_back(StringUtil::Format("%s(%s) FILTER (WHERE __ducklake_insert) AS %s",
+			                                           StringUtil::Upper(aggregate.aggregate), column,
+			                                           aggregate.GetName()));
+		}
+	}
+	delta_columns.push_back("BOOL_OR(NOT __ducklake_insert) AS __ducklake_has_deletes");
+	case_insensitive_set_t change_names(data.group_columns.begin(), data.group_columns.end());
+	for (auto &aggregate : data.aggregates) {
+		if (change_names.insert(aggregate.column).second) {
+			change_columns.push_back(aggregate.GetColumn());
+		}
+	}
+
+	// combine the current state of the view with the delta
+	vector<string> new_columns;
+	if (!data.group_columns.empty()) {
+		new_columns.push_back(data.GroupList("delta."));
+	}
+	new_columns.push_back("COALESCE(mv.count_star, 0) + delta.count_star AS count_star");
+	for (auto &aggregate : data.aggregates) {
+		auto name = aggregate.GetName();
+		if (aggregate.aggregate == "sum") {
+			new_columns.push_back(StringUtil::Format("COALESCE(mv.%s + delta.%s, mv.%s, delta.%s) AS %s", name,
+			                                         name, name, name, name));
+		} else {
+			auto combine = aggregate.aggregate == "min" ? "LEAST" : "GREATEST";
+			new_columns.push_back(StringUtil::Format(
+			    "CASE WHEN delta.__ducklake_has_deletes THEN recompute.%s ELSE %s(mv.%s, delta.%s) END AS %s", name,
+			    combine, name, name, name));
+		}
+	}
+	string recompute_join;
+	if (data.HasMinMax()) {
+		// groups in which rows were deleted cannot update MIN/MAX from the delta - recompute them from the source
+		recompute_join = StringUtil::Format(
+		    "\nLEFT JOIN (SELECT %s FROM %s source WHERE EXISTS (SELECT 1 FROM delta "
+		    "WHERE delta.__ducklake_has_deletes AND %s)%s) recompute ON %s",
+		    data.AggregateList(), data.QualifiedName(data.source_name), data.GroupCondition("delta", "source"),
+		    data.GroupBy(), data.GroupCondition("delta", "recompute"));
+	}
+	auto catalog_name = KeywordHelper::WriteQuoted(data.catalog.GetName(), '\'');
+	auto schema_name = KeywordHelper::WriteQuoted(data.schema_name, '\'');
+	auto source_name = KeywordHelper::WriteQuoted(data.source_name, '\'');
+	auto query = StringUtil::Format(R"(
+CREATE OR REPLACE TEMPORARY TABLE __ducklake_view_delta AS
+WITH changes AS (
+	SELECT %s FROM ducklake_table_changes(%s, %s, %s, %d, %d)
+), delta AS (
+	SELECT %s FROM changes%s
+)
+SELECT %s
+FROM delta
+LEFT JOIN %s mv ON %s%s
+)",
+	                                StringUtil::Join(change_columns, ", "), catalog_name, schema_name, source_name,
+	                                start_snapshot, end_snapshot, StringUtil::Join(delta_columns, ", "),
+	                                data.group_columns.empty() ? " HAVING COUNT(*) > 0" : data.GroupBy(),
+	                                StringUtil::Join(new_columns, ", "), view, data.GroupCondition("delta", "mv"),
+	                                recompute_join);
+	RunQuery(con, query);
+	auto delta_count = con.Query("SELECT COUNT(*) FROM __ducklake_view_delta");
+	if (delta_count->HasError()) {
+		delta_count->GetErrorObject().Throw("Failed to refresh materialized view in DuckLake: ");
+	}
+	if (delta_count->GetValue(0, 0).GetValue<idx_t>() == 0) {
+		RunQuery(con, "DROP TABLE __ducklake_view_delta");
+		return false;
+	}
+	// replace the groups that changed - groups without any rows left are removed
+	RunQuery(con, StringUtil::Format("DELETE FROM %s mv WHERE EXISTS (SELECT 1 FROM __ducklake_view_delta delta "
+	                                 "WHERE %s)",
+	                                 view, data.GroupCondition("delta", "mv")));
+	auto filter = data.group_columns.empty() ? string() : " WHERE count_star > 0";
+	RunQuery(con, StringUtil::Format("INSERT INTO %s SELECT * FROM __ducklake_view_delta%s", view, filter));
+	RunQuery(con, "DROP TABLE __ducklake_view_delta");
+	return true;
+}
+
+static string RefreshMaterializedView(const RefreshMaterializedViewBindData &data, idx_t &snapshot_id) {
+	auto view = data.QualifiedName(data.view_name);
+	Connection con(data.catalog.GetDatabase());
+	// create the (empty) view if it does not exist yet - so that it has a table id we can store the snapshot under
+	RunQuery(con, StringUtil::Format("CREATE TABLE IF NOT EXISTS %s AS %s LIMIT 0", view, data.FullQuery()));
+	con.BeginTransaction();
+	auto &transaction = DuckLakeTransaction::Get(*con.context, data.catalog);
+	auto &catalog = data.catalog.Cast<DuckLakeCatalog>();
+	auto &entry = Catalog::GetEntry<TableCatalogEntry>(*con.context, data.catalog.GetName(), data.schema_name,
+	                                                   data.view_name);
+	auto &table = entry.Cast<DuckLakeTableEntry>();
+	snapshot_id = transaction.GetSnapshot().snapshot_id;
+
+	string refresh_type;
+	string last_snapshot;
+	if (!catalog.TryGetConfigOption(MATERIALIZED_VIEW_SNAPSHOT, last_snapshot, {}, table.GetTableId())) {
+		// the view has not been computed yet - compute it from scratch
+		RunQuery(con, "DELETE FROM " + view);
+		RunQuery(con, StringUtil::Format("INSERT INTO %s %s", view, data.FullQuery()));
+		refresh_type = "full";
+	} else {
+		auto start_snapshot = Value(last_snapshot).DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>() + 1;
+		if (start_snapshot > snapshot_id) {
+			con.Rollback();
+			return "none";
+		}
+		// if nothing changed only the snapshot is advanced - which does not create a new snapshot
+		refresh_type = RefreshIncremental(con, data, start_snapshot, snapshot_id) ? "incremental" : "none";
+	}
+	DuckLakeConfigOption option;
+	option.option.key = MATERIALIZED_VIEW_SNAPSHOT;
+	option.option.value = to_string(snapshot_id);
+	option.table_id = table.GetTableId();
+	transaction.SetConfigOption(option);
+	con.Commit();
+	return refresh_type;
+}
+
+static void DuckLakeRefreshMaterializedViewExecute(ClientContext &context, TableFunctionInput &data_p,
+                                                   DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<RefreshMaterializedViewBindData>();
+	auto &state = data_p.global_state->Cast<RefreshMaterializedViewData>();
+	if (state.finished) {
+		return;
+	}
+	idx_t snapshot_id;
+	auto refresh_type = RefreshMaterializedView(data, snapshot_id);
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(snapshot_id)));
+	output.SetValue(1, 0, Value(refresh_type));
+	output.SetCardinality(1);
+	state.finished = true;
+}
+
+DuckLakeRefreshMaterializedViewFunction::DuckLakeRefreshMaterializedViewFunction()
+    : TableFunction("ducklake_refresh_materialized_view",
+                    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                    DuckLakeRefreshMaterializedViewExecute, DuckLakeRefreshMaterializedViewBind,
+                    DuckLakeRefreshMaterializedViewInit) {
+	named_parameters["schema"] = LogicalType::VARCHAR;
+	named_parameters["group_by"] = LogicalType::LIST(LogicalType::VARCHAR);
+	named_parameters["sum"] = LogicalType::LIST(LogicalType::VARCHAR);
+	named_parameters["min"] = LogicalType::LIST(LogicalType::VARCHAR);
+	named_parameters["max"] = LogicalType::LIST(LogicalType::VARCHAR);
+}
+
+} // namespace duckdb
@@ -67,6 +67,8 @@ static unique_ptr<FunctionData> DuckLakeSetOptionBind(ClientContext &context, Ta
 	} else if (option == "target_file_size") {
 		auto target_file_size_bytes = DBConfig::ParseMemoryLimit(val.ToString());
 		value = to_string(target_file_size_bytes);
+	} else if (option == "adaptive_file_size") {
+		value = val.GetValue<bool>() ? "true" : "false";
 	} else if (option == "data_inlining_row_limit") {
 		auto &metadata_catalog = Catalog::GetCatalog(context, ducklake_catalog.MetadataDatabaseName());
 		if (!metadata_catalog.IsDuckCatalog()) {
@@ -74,6 +76,34 @@ static unique_ptr<FunctionData> DuckLakeSetOptionBind(ClientContext &context, Ta
 		}
 		auto data_inlining_row_limit = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
 		value = to_string(data_inlining_row_limit);
+	} else if (option == "delete_inlining_row_limit") {
+		auto delete_inlining_row_limit = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(delete_inlining_row_limit);
+	} else if (option == "insert_buffer_row_limit") {
+		auto insert_buffer_row_limit = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(insert_buffer_row_limit);
+	} else if (option == "insert_buffer_size") {
+		auto insert_buffer_size = DBConfig::ParseMemoryLimit(val.ToString());
+		value = to_string(insert_buffer_size);
+	} else if (option == "insert_buffer_flush_interval") {
+		interval_t result;
+		if (!Interval::FromString(val.ToString(), result)) {
+			throw BinderException("%s is not a valid interval value.", option);
+		}
+		value = val.ToString();
+	} else if (option == "insert_buffer_ack_mode") {
+		auto ack_mode = StringUtil::Lower(val.ToString());
+		if (ack_mode != "buffered" && ack_mode != "committed") {
+			throw BinderException("Unsupported insert_buffer_ack_mode '%s' - expected 'buffered' or 'committed'",
+			                      ack_mode);
+		}
+		value = ack_mode;
+	} else if (option == "auto_flush_inlined_row_limit") {
+		auto auto_flush_inlined_row_limit = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(auto_flush_inlined_row_limit);
+	} else if (option == "auto_flush_inlined_size") {
+		auto auto_flush_inlined_size = DBConfig::ParseMemoryLimit(val.ToString());
+		value = to_string(auto_flush_inlined_size);
 	} else if (option == "require_commit_message") {
 		value = val.GetValue<bool>() ? "true" : "false";
 	} else if (option == "rewrite_delete_threshold") {
@@ -99,8 +129,106 @@ static unique_ptr<FunctionData> DuckLakeSetOptionBind(ClientContext &context, Ta
 			throw BinderException("The %s option can't be null.", option.c_str());
 		}
 		value = val.ToString();
+	} else if (option == "compaction_max_concurrency") {
+		auto max_concurrency = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		if (max_concurrency == 0) {
+			throw BinderException("The compaction_max_concurrency option must be at least 1");
+		}
+		value = to_string(max_concurrency);
+	} else if (option == "checkpoint_max_concurrency") {
+		auto max_concurrency = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		if (max_concurrency == 0) {
+			throw BinderException("The checkpoint_max_concurrency option must be at least 1");
+		}
+		value = to_string(max_concurrency);
+	} else if (option == "metadata_bulk_insert_threshold") {
+		auto threshold = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(threshold);
+	} else if (option == "checkpoint_snapshot") {
+		auto snapshot_id = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(snapshot_id);
+	} else if (option == "cleanup_max_concurrency") {
+		auto max_concurrency = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		if (max_concurrency == 0) {
+			throw BinderException("The cleanup_max_concurrency option must be at least 1");
+		}
+		value = to_string(max_concurrency);
+	} else if (option == "footer_prefetch_count") {
+		auto prefetch_count = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(prefetch_count);
+	} else if (option == "read_ahead_file_size" || option == "read_ahead_memory_limit") {
+		auto size = DBConfig::ParseMemoryLimit(val.ToString());
+		value = to_string(size);
+	} else if (option == "orphan_cleanup_checkpoint") {
+		auto checkpoint = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(checkpoint);
+	} else if (option == "materialized_view_snapshot") {
+		auto snapshot_id = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(snapshot_id);
+	} else if (option == "expire_snapshots_batch_size") {
+		auto batch_size = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		if (batch_size == 0) {
+			throw BinderException("The expire_snapshots_batch_size option must be at least 1");
+		}
+		value = to_string(batch_size);
+	} else if (option == "expire_snapshots_batch_delay") {
+		interval_t delay;
+		if (!Interval::FromString(val.ToString(), delay) || Interval::GetMicro(delay) < 0) {
+			throw BinderException("The expire_snapshots_batch_delay option must be a non-negative interval");
+		}
+		value = val.ToString();
+	} else if (option == "auto_compaction_file_count") {
+		auto auto_compaction_file_count = val.DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+		value = to_string(auto_compaction_file_count);
+	} else if (option == "auto_compaction_delete_ratio") {
+		auto delete_ratio = val.DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+		if (delete_ratio < 0 || delete_ratio > 1) {
+			throw BinderException("The auto_compaction_delete_ratio option must be between 0 and 1");
+		}
+		value = to_string(delete_ratio);
+	} else if (option == "compaction_max_bytes") {
+		auto max_bytes = DBConfig::ParseMemoryLimit(val.ToString());
+		value = to_string(max_bytes);
+	} else if (option == "compaction_max_duration") {
+		interval_t result;
+		if (!Interval::FromString(val.ToString(), result) || Interval::GetMicro(result) <= 0) {
+			throw BinderException("%s is not a valid positive interval value.", option);
+		}
+		value = val.ToString();
+	} else if (option == "compaction_strategy") {
+		auto strategy = StringUtil::Lower(val.ToString());
+		if (strategy != "adjacent" && strategy != "bin_pack") {
+			throw BinderException("Unsupported compaction_strategy '%s' - expected 'adjacent' or 'bin_pack'", strategy);
+		}
+		value = strategy;
+	} else if (option == "compaction_size_tolerance") {
+		auto size_tolerance = val.DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+		if (size_tolerance < 0 || size_tolerance > 1) {
+			throw BinderException("The compaction_size_tolerance option must be between 0 and 1");
+		}
+		value = to_string(size_tolerance);
+	} else if (option == "compaction_passthrough") {
+		value = val.CastAs(context, LogicalType::BOOLEAN).GetValue<bool>() ? "true" : "false";
+	} else if (option == "bloom_filter_columns") {
+		// comma-separated list of columns for which Bloom filters are computed for newly written files
+		value = val.IsNull() ? string() : val.ToString();
+	} else if (option == "histogram_columns") {
+		// comma-separated list of columns for which histograms are computed for newly written files
+		value = val.IsNull() ? string() : val.ToString();
+	} else if (option == "sorted_by") {
+		// comma-separated list of columns (optionally followed by ASC or DESC) that newly written files are sorted by
+		value = val.IsNull() ? string() : val.ToString();
+	} else if (option == "sort_partitioned_writes") {
+		value = val.CastAs(context, LogicalType::BOOLEAN).GetValue<bool>() ? "true" : "false";
 	} else if (option == "per_thread_output") {
 		value = val.CastAs(context, LogicalType::BOOLEAN).GetValue<bool>() ? "true" : "false";
+	} else if (option == "update_mode") {
+		auto update_mode = StringUtil::Lower(val.ToString());
+		if (update_mode != "merge_on_read" && update_mode != "copy_on_write") {
+			throw BinderException("Unsupported update_mode '%s' - expected 'merge_on_read' or 'copy_on_write'",
+			                      update_mode);
+		}
+		value = update_mode;
 	} else {
 		throw NotImplementedException("Unsupported option %s", option);
 	}
@@ -120,24 +120,124 @@ vector<Value> DuckLakeSnapshotsFunction::GetSnapshotValues(const DuckLakeSnapsho
 	return row_values;
 }
 
+//! The amount of snapshots that is read from the metadata catalog at a time
+static constexpr idx_t SNAPSHOTS_PAGE_SIZE = STANDARD_VECTOR_SIZE;
+
+struct DuckLakeSnapshotsData : public TableFunctionData {
+	explicit DuckLakeSnapshotsData(Catalog &catalog) : catalog(catalog) {
+	}
+
+	Catalog &catalog;
+	//! The (inclusive) range of snapshot ids selected by the filters of the query
+	int64_t min_snapshot_id = 0;
+	int64_t max_snapshot_id = NumericLimits<int64_t>::Maximum();
+};
+
+struct DuckLakeSnapshotsState : public GlobalTableFunctionState {
+	//! The current page of snapshots
+	vector<DuckLakeSnapshotInfo> snapshots;
+	idx_t offset = 0;
+	//! The id of the last snapshot of the current page
+	optional_idx last_snapshot_id;
+	bool finished = false;
+};
+
 static unique_ptr<FunctionData> DuckLakeSnapshotsBind(ClientContext &context, TableFunctionBindInput &input,
                                                       vector<LogicalType> &return_types, vector<string> &names) {
 	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
-	auto &transaction = DuckLakeTransaction::Get(context, catalog);
-
-	auto &metadata_manager = transaction.GetMetadataManager();
-	auto snapshots = metadata_manager.GetAllSnapshots();
-	auto result = make_uniq<MetadataBindData>();
-	for (auto &snapshot : snapshots) {
-		auto row_values = DuckLakeSnapshotsFunction::GetSnapshotValues(snapshot);
-		result->rows.push_back(std::move(row_values));
-	}
 	DuckLakeSnapshotsFunction::GetSnapshotTypes(return_types, names);
+	// the snapshots are read during execution
+	return make_uniq<DuckLakeSnapshotsData>(catalog);
+}
+
+static void DuckLakeSnapshotsPushdown(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                      vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<DuckLakeSnapshotsData>();
+	// restrict the snapshots that are read to the range of snapshot ids the query selects
+	auto snapshot_filters = BaseMetadataFunction::GetColumnFilters(get, filters, 0, LogicalType::BIGINT);
+	for (auto &filter : snapshot_filters) {
+		auto snapshot_id = filter.constant.GetValue<int64_t>();
+		switch (filter.comparison) {
+		case ExpressionType::COMPARE_EQUAL:
+			bind_data.min_snapshot_id = MaxValue<int64_t>(bind_data.min_snapshot_id, snapshot_id);
+			bind_data.max_snapshot_id = MinValue<int64_t>(bind_data.max_snapshot_id, snapshot_id);
+			break;
+		case ExpressionType::COMPARE_GREATERTHAN:
+			if (snapshot_id == NumericLimits<int64_t>::Maximum()) {
+				bind_data.max_snapshot_id = -1;
+				break;
+			}
+			bind_data.min_snapshot_id = MaxValue<int64_t>(bind_data.min_snapshot_id, snapshot_id + 1);
+			break;
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			bind_data.min_snapshot_id = MaxValue<int64_t>(bind_data.min_snapshot_id, snapshot_id);
+			break;
+		case ExpressionType::COMPARE_LESSTHAN:
+			if (snapshot_id <= 0) {
+				bind_data.max_snapshot_id = -1;
+				break;
+			}
+			bind_data.max_snapshot_id = MinValue<int64_t>(bind_data.max_snapshot_id, snapshot_id - 1);
+			break;
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			bind_data.max_snapshot_id = MinValue<int64_t>(bind_data.max_snapshot_id, snapshot_id);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeSnapshotsInit(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<DuckLakeSnapshotsData>();
+	auto result = make_uniq<DuckLakeSnapshotsState>();
+	if (bind_data.min_snapshot_id > bind_data.max_snapshot_id) {
+		// the filters do not select any snapshot
+		result->finished = true;
+	}
 	return std::move(result);
 }
 
+static void DuckLakeSnapshotsExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DuckLakeSnapshotsData>();
+	auto &state = data_p.global_state->Cast<DuckLakeSnapshotsState>();
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (state.offset >= state.snapshots.size()) {
+			if (state.finished) {
+				break;
+			}
+			// fetch the next page of snapshots
+			auto &transaction = DuckLakeTransaction::Get(context, data.catalog);
+			auto &metadata_manager = transaction.GetMetadataManager();
+			auto filter = StringUtil::Format("snapshot_id >= %d AND snapshot_id <= %d", data.min_snapshot_id,
+			                                 data.max_snapshot_id);
+			if (state.last_snapshot_id.IsValid()) {
+				filter += StringUtil::Format(" AND snapshot_id > %d", state.last_snapshot_id.GetIndex());
+			}
+			state.snapshots = metadata_manager.GetAllSnapshots(filter, SNAPSHOTS_PAGE_SIZE);
+			state.offset = 0;
+			state.finished = state.snapshots.size() < SNAPSHOTS_PAGE_SIZE;
+			if (!state.snapshots.empty()) {
+				state.last_snapshot_id = state.snapshots.back().id;
+			}
+			continue;
+		}
+		auto row_values = DuckLakeSnapshotsFunction::GetSnapshotValues(state.snapshots[state.offset++]);
+		for (idx_t c = 0; c < row_values.size(); c++) {
+			output.SetValue(c, count, row_values[c]);
+		}
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
 DuckLakeSnapshotsFunction::DuckLakeSnapshotsFunction()
     : BaseMetadataFunction("ducklake_snapshots", DuckLakeSnapshotsBind) {
+	init_global = DuckLakeSnapshotsInit;
+	function = DuckLakeSnapshotsExecute;
+	pushdown_complex_filter = DuckLakeSnapshotsPushdown;
 }
 
 } // namespace duckdb
@@ -3,18 +3,24 @@
 
 namespace duckdb {
 
+// the insertions and deletions are scanned once - rows that appear in both within the same snapshot are updates
 // clang-format off
 static const DefaultTableMacro ducklake_table_macros[] = {
 	{DEFAULT_SCHEMA, "ducklake_table_changes", {"catalog", "schema_name", "table_name", "start_snapshot", "end_snapshot", nullptr}, {{nullptr, nullptr}},  R"(
-SELECT snapshot_id, rowid, CASE WHEN (snapshot_id, rowid) in (SELECT snapshot_id, rowid FROM ducklake_table_deletions(catalog, schema_name, table_name, start_snapshot, end_snapshot))
-       THEN 'update_postimage'
-       ELSE 'insert'
-       END AS change_type, * FROM ducklake_table_insertions(catalog, schema_name, table_name, start_snapshot, end_snapshot)
-UNION ALL
-SELECT snapshot_id, rowid, CASE WHEN (snapshot_id, rowid) in (SELECT snapshot_id, rowid FROM ducklake_table_insertions(catalog, schema_name, table_name, start_snapshot, end_snapshot))
-       THEN 'update_preimage'
-       ELSE 'delete'
-       END AS change_type, * FROM ducklake_table_deletions(catalog, schema_name, table_name, start_snapshot, end_snapshot)
+SELECT snapshot_id, rowid, CASE
+       WHEN __ducklake_is_insertion THEN CASE WHEN __ducklake_deletions > 0 THEN 'update_postimage' ELSE 'insert' END
+       ELSE CASE WHEN __ducklake_insertions > 0 THEN 'update_preimage' ELSE 'delete' END
+       END AS change_type, * EXCLUDE (snapshot_id, rowid, __ducklake_is_insertion, __ducklake_insertions, __ducklake_deletions)
+FROM (
+	SELECT *,
+	       COUNT(*) FILTER (WHERE __ducklake_is_insertion) OVER (PARTITION BY snapshot_id, rowid) AS __ducklake_insertions,
+	       COUNT(*) FILTER (WHERE NOT __ducklake_is_insertion) OVER (PARTITION BY snapshot_id, rowid) AS __ducklake_deletions
+	FROM (
+		SELECT snapshot_id, rowid, true AS __ducklake_is_insertion, * FROM ducklake_table_insertions(catalog, schema_name, table_name, start_snapshot, end_snapshot)
+		UNION ALL
+		SELECT snapshot_id, rowid, false AS __ducklake_is_insertion, * FROM ducklake_table_deletions(catalog, schema_name, table_name, start_snapshot, end_snapshot)
+	)
+)
 )"},
 	{nullptr, nullptr, {nullptr}, {{nullptr, nullptr}}, nullptr}
 	};
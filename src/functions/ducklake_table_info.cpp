@@ -2,29 +2,29 @@
 #include "storage/ducklake_transaction.hpp"
 #include "common/ducklake_util.hpp"
 #include "storage/ducklake_transaction_changes.hpp"
+#include "duckdb/common/types/uuid.hpp"
 
 namespace duckdb {
 
+struct DuckLakeTableInfoData : public TableFunctionData {
+	explicit DuckLakeTableInfoData(Catalog &catalog) : catalog(catalog) {
+	}
+
+	Catalog &catalog;
+	//! The filter on the tables selected by the query (if any)
+	string filter;
+};
+
+struct DuckLakeTableInfoState : public GlobalTableFunctionState {
+	vector<DuckLakeTableSizeInfo> tables;
+	idx_t offset = 0;
+};
+
 static unique_ptr<FunctionData> DuckLakeTableInfoBind(ClientContext &context, TableFunctionBindInput &input,
                                                       vector<LogicalType> &return_types, vector<string> &names) {
 	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
-	auto &transaction = DuckLakeTransaction::Get(context, catalog);
-
-	auto &metadata_manager = transaction.GetMetadataManager();
-	auto tables = metadata_manager.GetTableSizes(transaction.GetSnapshot());
-	auto result = make_uniq<MetadataBindData>();
-	for (auto &table_info : tables) {
-		vector<Value> row_values;
-		row_values.push_back(Value(table_info.table_name));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.schema_id.index)));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.table_id.index)));
-		row_values.push_back(Value::UUID(table_info.table_uuid));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.file_count)));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.file_size_bytes)));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.delete_file_count)));
-		row_values.push_back(Value::BIGINT(NumericCast<int64_t>(table_info.delete_file_size_bytes)));
-		result->rows.push_back(std::move(row_values));
-	}
+	// the table sizes are read during execution
+	auto result = make_uniq<DuckLakeTableInfoData>(catalog);
 
 	names.emplace_back("table_name");
 	return_types.emplace_back(LogicalType::VARCHAR);
@@ -52,8 +52,60 @@ static unique_ptr<FunctionData> DuckLakeTableInfoBind(ClientContext &context, Ta
 	return std::move(result);
 }
 
+static void DuckLakeTableInfoPushdown(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                      vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<DuckLakeTableInfoData>();
+	// only compute the sizes of the tables the query selects by name or id
+	vector<string> conditions;
+	for (auto &filter : BaseMetadataFunction::GetColumnFilters(get, filters, 0, LogicalType::VARCHAR)) {
+		if (filter.comparison == ExpressionType::COMPARE_EQUAL) {
+			auto table_name = KeywordHelper::WriteQuoted(StringValue::Get(filter.constant), '\'');
+			conditions.push_back("tbl.table_name = " + table_name);
+		}
+	}
+	for (auto &filter : BaseMetadataFunction::GetColumnFilters(get, filters, 2, LogicalType::BIGINT)) {
+		if (filter.comparison == ExpressionType::COMPARE_EQUAL) {
+			conditions.push_back("tbl.table_id = " + to_string(filter.constant.GetValue<int64_t>()));
+		}
+	}
+	bind_data.filter = StringUtil::Join(conditions, " AND ");
+}
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeTableInfoInit(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<DuckLakeTableInfoData>();
+	auto &transaction = DuckLakeTransaction::Get(context, bind_data.catalog);
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto result = make_uniq<DuckLakeTableInfoState>();
+	result->tables = metadata_manager.GetTableSizes(transaction.GetSnapshot(), bind_data.filter);
+	return std::move(result);
+}
+
+static void DuckLakeTableInfoExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<DuckLakeTableInfoState>();
+	idx_t count = 0;
+	while (state.offset < state.tables.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &table_info = state.tables[state.offset++];
+		FlatVector::GetData<string_t>(output.data[0])[count] =
+		    StringVector::AddString(output.data[0], table_info.table_name);
+		FlatVector::GetData<int64_t>(output.data[1])[count] = NumericCast<int64_t>(table_info.schema_id.index);
+		FlatVector::GetData<int64_t>(output.data[2])[count] = NumericCast<int64_t>(table_info.table_id.index);
+		FlatVector::GetData<hugeint_t>(output.data[3])[count] = UUID::FromString(table_info.table_uuid);
+		FlatVector::GetData<int64_t>(output.data[4])[count] = NumericCast<int64_t>(table_info.file_count);
+		FlatVector::GetData<int64_t>(output.data[5])[count] = NumericCast<int64_t>(table_info.file_size_bytes);
+		FlatVector::GetData<int64_t>(output.data[6])[count] = NumericCast<int64_t>(table_info.delete_file_count);
+		FlatVector::GetData<int64_t>(output.data[7])[count] =
+		    NumericCast<int64_t>(table_info.delete_file_size_bytes);
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
 DuckLakeTableInfoFunction::DuckLakeTableInfoFunction()
     : BaseMetadataFunction("ducklake_table_info", DuckLakeTableInfoBind) {
+	init_global = DuckLakeTableInfoInit;
+	function = DuckLakeTableInfoExecute;
+	pushdown_complex_filter = DuckLakeTableInfoPushdown;
 }
 
 } // namespace duckdb
@@ -0,0 +1,175 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_transaction.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+struct DuckLakeTailBindData : public TableFunctionData {
+	explicit DuckLakeTailBindData(Catalog &catalog) : catalog(catalog) {
+	}
+
+	Catalog &catalog;
+	string schema_name;
+	string table_name;
+	idx_t from_snapshot;
+	//! The interval (in milliseconds) at which the metadata is checked for snapshots committed by other processes
+	idx_t poll_interval_ms = 1000;
+	//! The time (in milliseconds) without new snapshots after which the tail ends - waits indefinitely if not set
+	optional_idx timeout_ms;
+	vector<LogicalType> types;
+};
+
+static idx_t GetIntervalMs(const string &name, const Value &input, bool allow_zero) {
+	auto interval = IntervalValue::Get(input);
+	auto interval_us = Interval::GetMicro(interval);
+	if (interval_us < 0 || (!allow_zero && interval_us == 0)) {
+		throw InvalidInputException("ducklake_tail: %s must be a %s interval", name,
+		                            allow_zero ? "non-negative" : "positive");
+	}
+	return NumericCast<idx_t>(interval_us / Interval::MICROS_PER_MSEC);
+}
+
+static unique_ptr<FunctionData> DuckLakeTailBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	auto result = make_uniq<DuckLakeTailBindData>(catalog);
+	if (input.inputs[1].IsNull() || input.inputs[2].IsNull()) {
+		throw InvalidInputException("ducklake_tail: the table and snapshot cannot be NULL");
+	}
+	result->table_name = StringValue::Get(input.inputs[1]);
+	auto from_snapshot = BigIntValue::Get(input.inputs[2]);
+	if (from_snapshot < 0) {
+		throw InvalidInputException("ducklake_tail: the snapshot cannot be negative");
+	}
+	result->from_snapshot = NumericCast<idx_t>(from_snapshot);
+	result->schema_name = DEFAULT_SCHEMA;
+	for (auto &entry : input.named_parameters) {
+		if (StringUtil::CIEquals(entry.first, "schema")) {
+			result->schema_name = StringValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "poll_interval")) {
+			result->poll_interval_ms = MaxValue<idx_t>(GetIntervalMs(entry.first, entry.second, false), 1);
+		} else if (StringUtil::CIEquals(entry.first, "timeout")) {
+			result->timeout_ms = GetIntervalMs(entry.first, entry.second, true);
+		} else {
+			throw InternalException("Unsupported named parameter for ducklake_tail");
+		}
+	}
+
+	// the changes are returned in the same layout as ducklake_table_changes
+	auto &table = Catalog::GetEntry<TableCatalogEntry>(context, catalog.GetName(), result->schema_name,
+	                                                   result->table_name);
+	names.emplace_back("snapshot_id");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("rowid");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("change_type");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	for (auto &column : table.GetColumns().Logical()) {
+		names.push_back(column.Name());
+		return_types.push_back(column.Type());
+	}
+	result->types = return_types;
+	return std::move(result);
+}
+
+struct DuckLakeTailState : public GlobalTableFunctionState {
+	//! The first snapshot whose changes have not been returned yet
+	idx_t next_snapshot;
+	//! The changes that are currently being returned
+	unique_ptr<MaterializedQueryResult> changes;
+	unique_ptr<DataChunk> chunk;
+	//! The last time a new snapshot was observed
+	std::chrono::steady_clock::time_point last_snapshot_time;
+};
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeTailInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<DuckLakeTailBindData>();
+	auto result = make_uniq<DuckLakeTailState>();
+	result->next_snapshot = bind_data.from_snapshot;
+	result->last_snapshot_time = std::chrono::steady_clock::now();
+	return std::move(result);
+}
+
+//! Read the changes made to the table in all snapshots committed since next_snapshot - returns false if no new
+//! snapshots have been committed
+static bool ReadNewChanges(const DuckLakeTailBindData &data, DuckLakeTailState &state) {
+	// every poll runs in a new transaction - so that it observes the latest snapshot
+	Connection con(data.catalog.GetDatabase());
+	con.BeginTransaction();
+	auto &transaction = DuckLakeTransaction::Get(*con.context, data.catalog);
+	auto latest_snapshot = transaction.GetSnapshot().snapshot_id;
+	if (latest_snapshot < state.next_snapshot) {
+		con.Rollback();
+		return false;
+	}
+	auto query = StringUtil::Format(
+	    "SELECT * FROM ducklake_table_changes(%s, %s, %s, %d, %d) ORDER BY snapshot_id",
+	    KeywordHelper::WriteQuoted(data.catalog.GetName(), '\''), KeywordHelper::WriteQuoted(data.schema_name, '\''),
+	    KeywordHelper::WriteQuoted(data.table_name, '\''), state.next_snapshot, latest_snapshot);
+	auto changes = con.Query(query);
+	if (changes->HasError()) {
+		changes->GetErrorObject().Throw("Failed to read table changes in ducklake_tail: ");
+	}
+	con.Commit();
+	if (changes->types != data.types) {
+		throw InvalidInputException("ducklake_tail: the schema of table \"%s\" was altered in one of the snapshots "
+		                            "between %d and %d - restart the tail from snapshot %d",
+		                            data.table_name, state.next_snapshot, latest_snapshot, state.next_snapshot);
+	}
+	state.changes = std::move(changes);
+	state.next_snapshot = latest_snapshot + 1;
+	return true;
+}
+
+static void DuckLakeTailExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->Cast<DuckLakeTailBindData>();
+	auto &state = data_p.global_state->Cast<DuckLakeTailState>();
+	while (true) {
+		if (state.changes) {
+			state.chunk = state.changes->Fetch();
+			if (state.chunk && state.chunk->size() > 0) {
+				output.Reference(*state.chunk);
+				return;
+			}
+			state.changes.reset();
+			state.chunk.reset();
+		}
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		if (ReadNewChanges(data, state)) {
+			state.last_snapshot_time = std::chrono::steady_clock::now();
+			continue;
+		}
+		// wait for a commit of this process - or for the poll interval to pass for commits made elsewhere
+		auto wait_ms = data.poll_interval_ms;
+		if (data.timeout_ms.IsValid()) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+			                                                                     state.last_snapshot_time);
+			auto elapsed_ms = NumericCast<idx_t>(elapsed.count());
+			if (elapsed_ms >= data.timeout_ms.GetIndex()) {
+				// no new snapshots were committed within the timeout - end the tail
+				return;
+			}
+			wait_ms = MinValue<idx_t>(wait_ms, data.timeout_ms.GetIndex() - elapsed_ms);
+		}
+		auto &catalog = data.catalog.Cast<DuckLakeCatalog>();
+		catalog.WaitForCommit(state.next_snapshot - 1, wait_ms);
+	}
+}
+
+DuckLakeTailFunction::DuckLakeTailFunction()
+    : TableFunction("ducklake_tail", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT},
+                    DuckLakeTailExecute, DuckLakeTailBind, DuckLakeTailInit) {
+	named_parameters["schema"] = LogicalType::VARCHAR;
+	named_parameters["poll_interval"] = LogicalType::INTERVAL;
+	named_parameters["timeout"] = LogicalType::INTERVAL;
+}
+
+} // namespace duckdb
@@ -0,0 +1,105 @@
+#include "functions/ducklake_table_functions.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
+
+namespace duckdb {
+
+struct WriteManifestsBindData : public TableFunctionData {
+	WriteManifestsBindData(Catalog &catalog, DuckLakeTableEntry &table) : catalog(catalog), table(table) {
+	}
+
+	Catalog &catalog;
+	DuckLakeTableEntry &table;
+	//! The maximum amount of data files per manifest
+	idx_t manifest_size = 10000;
+};
+
+static unique_ptr<FunctionData> DuckLakeWriteManifestsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	auto &catalog = BaseMetadataFunction::GetCatalog(context, input.inputs[0]);
+	if (input.inputs[1].IsNull()) {
+		throw InvalidInputException("ducklake_write_manifests: the table name cannot be NULL");
+	}
+	string schema;
+	idx_t manifest_size = 10000;
+	for (auto &entry : input.named_parameters) {
+		if (StringUtil::CIEquals(entry.first, "schema")) {
+			schema = entry.second.IsNull() ? string() : StringValue::Get(entry.second);
+		} else if (StringUtil::CIEquals(entry.first, "manifest_size")) {
+			manifest_size = UBigIntValue::Get(entry.second);
+		} else {
+			throw InternalException("Unsupported named parameter for ducklake_write_manifests");
+		}
+	}
+	if (manifest_size == 0) {
+		throw InvalidInputException("ducklake_write_manifests: manifest_size must be at least 1");
+	}
+	auto table_name = StringValue::Get(input.inputs[1]);
+	auto table_entry =
+	    catalog.GetEntry<TableCatalogEntry>(context, schema, table_name, OnEntryNotFound::THROW_EXCEPTION);
+	auto &table = table_entry->Cast<DuckLakeTableEntry>();
+	if (table.GetTableId().IsTransactionLocal()) {
+		throw NotImplementedException("Manifests cannot be written for transaction-local tables");
+	}
+	auto result = make_uniq<WriteManifestsBindData>(catalog, table);
+	result->manifest_size = manifest_size;
+
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("manifest_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("file_count");
+	return std::move(result);
+}
+
+struct WriteManifestsData : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<GlobalTableFunctionState> DuckLakeWriteManifestsInit(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	return make_uniq<WriteManifestsData>();
+}
+
+static void DuckLakeWriteManifestsExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<WriteManifestsData>();
+	if (state.finished) {
+		return;
+	}
+	auto &bind_data = data_p.bind_data->Cast<WriteManifestsBindData>();
+	auto &transaction = DuckLakeTransaction::Get(context, bind_data.catalog);
+	auto &separator = transaction.GetCatalog().Separator();
+
+	// every set of manifests is written to a new directory - readers of the previous set are not affected
+	auto directory = "manifests" + separator + UUID::ToString(UUID::GenerateRandomUUID()) + separator;
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto manifest_list =
+	    metadata_manager.WriteManifests(bind_data.table, transaction.GetSnapshot(), directory, bind_data.manifest_size);
+
+	// point the table to the new manifests
+	DuckLakeConfigOption option;
+	option.option.key = DuckLakeManifestList::OPTION_NAME;
+	option.option.value = directory;
+	option.table_id = bind_data.table.GetTableId();
+	transaction.SetConfigOption(option);
+
+	idx_t file_count = 0;
+	for (auto &manifest : manifest_list.manifests) {
+		file_count += manifest.file_count;
+	}
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(manifest_list.manifests.size())));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(file_count)));
+	output.SetCardinality(1);
+	state.finished = true;
+}
+
+DuckLakeWriteManifestsFunction::DuckLakeWriteManifestsFunction()
+    : TableFunction("ducklake_write_manifests", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+                    DuckLakeWriteManifestsExecute, DuckLakeWriteManifestsBind, DuckLakeWriteManifestsInit) {
+	named_parameters["schema"] = LogicalType::VARCHAR;
+	named_parameters["manifest_size"] = LogicalType::UBIGINT;
+}
+
+} // namespace duckdb
@@ -28,12 +28,28 @@ struct DuckLakeDeleteFile {
 	idx_t footer_size;
 	string encryption_key;
 	bool overwrites_existing_delete = false;
+	//! The deleted rows - only set if the deletes are inlined in the metadata catalog instead of written to a file
+	vector<idx_t> inlined_deletes;
+
+	bool IsInlined() const {
+		return !inlined_deletes.empty();
+	}
+
+	//! Inlined deletes are referred to through a path consisting of this prefix followed by the delete file id
+	static constexpr const char *INLINED_DELETE_PREFIX = "ducklake_inlined_delete:";
+	static string GetInlinedDeletePath(DataFileIndex delete_file_id);
+	static string GetLocalInlinedDeletePath(const string &uuid);
+	static bool IsInlinedDeletePath(const string &path);
+	//! Returns the delete file id of an inlined delete path - or an invalid index for transaction-local inlined deletes
+	static DataFileIndex GetInlinedDeleteFileId(const string &path);
 };
 
 struct DuckLakeDataFile {
 	DuckLakeDataFile() = default;
 	DuckLakeDataFile(const DuckLakeDataFile &other);
 	DuckLakeDataFile &operator=(const DuckLakeDataFile &);
+	DuckLakeDataFile(DuckLakeDataFile &&other) = default;
+	DuckLakeDataFile &operator=(DuckLakeDataFile &&) = default;
 
 	string file_name;
 	idx_t row_count;
@@ -41,7 +57,7 @@ struct DuckLakeDataFile {
 	optional_idx footer_size;
 	optional_idx partition_id;
 	unique_ptr<DuckLakeDeleteFile> delete_file;
-	map<FieldIndex, DuckLakeColumnStats> column_stats;
+	DuckLakeColumnStatsMap column_stats;
 	vector<DuckLakeFilePartition> partition_values;
 	string encryption_key;
 	MappingIndex mapping_id;
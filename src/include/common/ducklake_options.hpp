@@ -24,6 +24,10 @@ struct DuckLakeOptions {
 	string metadata_database;
 	string metadata_path;
 	string metadata_schema;
+	//! Connection string of a read replica of the (Postgres) metadata catalog - if empty there is no read replica
+	string metadata_read_replica;
+	//! The name under which the read replica is attached
+	string metadata_replica_database;
 	string data_path;
 	bool override_data_path = false;
 	AccessMode access_mode = AccessMode::AUTOMATIC;
@@ -36,6 +40,25 @@ struct DuckLakeOptions {
 	map<SchemaIndex, option_map_t> schema_options;
 	map<TableIndex, option_map_t> table_options;
 	idx_t busy_timeout = 5000;
+	//! Memory budget for the cached schema and stats versions of the catalog
+	idx_t catalog_cache_size = 1ULL << 29;
+	//! Memory budget for the decoded contents of delete files that are shared across queries
+	idx_t delete_file_cache_size = 1ULL << 28;
+	//! Whether or not concurrent scans share the in-flight loads of file lists and delete files
+	bool shared_scans = true;
+	//! Directory in which local copies of remote data and delete files are kept - if empty no files are cached
+	string data_file_cache_path;
+	//! Disk budget for the local copies of remote data and delete files
+	idx_t data_file_cache_size = 1ULL << 34;
+	//! Path of the local metadata cache file - if empty no local metadata cache is used
+	string catalog_cache_path;
+	//! Whether or not to load only the names of tables up front, and the remaining table metadata on first access
+	bool lazy_catalog_loading = false;
+	//! The maximum number of idle metadata connections that are kept around for re-use by other transactions
+	idx_t metadata_connection_pool_size = 8;
+	//! How long (in milliseconds) the latest snapshot observed by one transaction can be re-used by new transactions
+	//! instead of querying the metadata catalog - 0 means every transaction queries the latest snapshot
+	idx_t snapshot_staleness_ms = 0;
 };
 
 } // namespace duckdb
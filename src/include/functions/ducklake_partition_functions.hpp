@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// functions/ducklake_partition_functions.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/function/function_set.hpp"
+
+namespace duckdb {
+
+//! The bucket and truncate partition transforms. They are registered as ducklake_bucket(N, col) and
+//! ducklake_truncate(W, col), which compute the partition values of written rows - and are evaluated on the
+//! constants of filters to prune the partitions. Both follow the Iceberg specification (i.e. buckets are computed from
+//! the 32-bit Murmur3 hash of the value), so the partition values do not depend on the DuckDB version that wrote them
+class DuckLakePartitionFunctions {
+public:
+	static ScalarFunctionSet GetBucketFunctions();
+	static ScalarFunctionSet GetTruncateFunctions();
+
+	static bool SupportsBucket(const LogicalType &type);
+	static bool SupportsTruncate(const LogicalType &type);
+	//! Compute the bucket of a (non-NULL) value
+	static int32_t Bucket(idx_t bucket_count, const Value &value);
+	//! Compute the truncated value of a (non-NULL) value
+	static Value Truncate(idx_t width, const Value &value);
+};
+
+} // namespace duckdb
@@ -11,9 +11,11 @@
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/parser/parsed_data/create_macro_info.hpp"
 #include "duckdb/function/function_set.hpp"
+#include "duckdb/common/enums/expression_type.hpp"
 
 namespace duckdb {
 class DuckLakeCatalog;
+class LogicalGet;
 struct DuckLakeSnapshotInfo;
 
 struct MetadataBindData : public TableFunctionData {
@@ -23,11 +25,21 @@ struct MetadataBindData : public TableFunctionData {
 	vector<vector<Value>> rows;
 };
 
+//! A comparison of a column of a metadata function with a constant, e.g. "snapshot_id > 10"
+struct MetadataColumnFilter {
+	ExpressionType comparison;
+	Value constant;
+};
+
 class BaseMetadataFunction : public TableFunction {
 public:
 	BaseMetadataFunction(string name, table_function_bind_t bind);
 
 	static Catalog &GetCatalog(ClientContext &context, const Value &input);
+	//! Get the comparisons of a column with a constant from the filters of a query - so the metadata that is read can
+	//! be restricted. The filters are not consumed: they are still applied to the rows the function returns.
+	static vector<MetadataColumnFilter> GetColumnFilters(LogicalGet &get, const vector<unique_ptr<Expression>> &filters,
+	                                                     idx_t column_index, const LogicalType &type);
 };
 
 class DuckLakeSnapshotsFunction : public BaseMetadataFunction {
@@ -64,6 +76,21 @@ public:
 	static TableFunctionSet GetFunctions();
 };
 
+class DuckLakeConsolidateDeletesFunction : public TableFunction {
+public:
+	static TableFunctionSet GetFunctions();
+};
+
+class DuckLakeTailFunction : public TableFunction {
+public:
+	DuckLakeTailFunction();
+};
+
+class DuckLakeRefreshMaterializedViewFunction : public TableFunction {
+public:
+	DuckLakeRefreshMaterializedViewFunction();
+};
+
 class DuckLakeCleanupOldFilesFunction : public TableFunction {
 public:
 	DuckLakeCleanupOldFilesFunction();
@@ -84,6 +111,11 @@ public:
 	DuckLakeFlushInlinedDataFunction();
 };
 
+class DuckLakeFlushInsertBufferFunction : public TableFunction {
+public:
+	DuckLakeFlushInsertBufferFunction();
+};
+
 class DuckLakeSetOptionFunction : public TableFunction {
 public:
 	DuckLakeSetOptionFunction();
@@ -114,9 +146,29 @@ public:
 	DuckLakeCurrentSnapshotFunction();
 };
 
+class DuckLakeMetadataStatsFunction : public BaseMetadataFunction {
+public:
+	DuckLakeMetadataStatsFunction();
+};
+
+class DuckLakeCommitStatsFunction : public BaseMetadataFunction {
+public:
+	DuckLakeCommitStatsFunction();
+};
+
 class DuckLakeAddDataFilesFunction : public TableFunction {
 public:
 	DuckLakeAddDataFilesFunction();
 };
 
+class DuckLakeWriteManifestsFunction : public TableFunction {
+public:
+	DuckLakeWriteManifestsFunction();
+};
+
+class DuckLakeArchiveFilesFunction : public TableFunction {
+public:
+	DuckLakeArchiveFilesFunction();
+};
+
 } // namespace duckdb
@@ -16,8 +16,23 @@ class PostgresMetadataManager : public DuckLakeMetadataManager {
 public:
 	explicit PostgresMetadataManager(DuckLakeTransaction &transaction);
 
+	void CreateMetadataIndexes() override;
+	DuckLakeCatalogInfo GetCatalogForSnapshot(DuckLakeSnapshot snapshot) override;
+	vector<DuckLakeFileListEntry> GetFilesForTablePage(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                                                   const string &filter, optional_idx last_file_id,
+	                                                   idx_t page_size) override;
+	DuckLakeArchiveInfo ArchiveFiles(idx_t archive_snapshot) override;
+	string GetWriteBatchQuery(const vector<string> &statements) override;
+
 protected:
 	string GetLatestSnapshotQuery() const override;
+	bool TryBulkInsert(const DuckLakeMetadataInsert &insert) override;
+
+private:
+	//! Whether or not reads of the given snapshot can be routed to the read replica of the metadata catalog
+	bool CanReadFromReplica(DuckLakeSnapshot snapshot);
+	//! Whether or not the metadata write can be sent to Postgres as-is (i.e. it is plain SQL on a metadata table)
+	static bool CanExecuteInPostgres(const string &statement);
 };
 
 } // namespace duckdb
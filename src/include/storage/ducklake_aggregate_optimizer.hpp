@@ -0,0 +1,24 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_aggregate_optimizer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+//! The DuckLakeAggregateOptimizer answers COUNT, MIN and MAX aggregates over DuckLake tables from the file stats in
+//! the metadata catalog, instead of reading the data files
+class DuckLakeAggregateOptimizer : public OptimizerExtension {
+public:
+	DuckLakeAggregateOptimizer();
+
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_background_maintenance.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "common/index.hpp"
+
+#include <chrono>
+#include <condition_variable>
+
+namespace duckdb {
+class DuckLakeCatalog;
+
+//! The changes a committed transaction made to a table that are relevant for background maintenance
+struct DuckLakeCommittedTableChanges {
+	TableIndex table_id;
+	string schema_name;
+	string table_name;
+	//! The rows and bytes inlined into the table
+	idx_t inlined_row_count = 0;
+	idx_t inlined_size_in_bytes = 0;
+	//! The amount of files below the target file size written to the table
+	idx_t small_file_count = 0;
+	//! The amount of rows deleted from data files of the table
+	idx_t deleted_row_count = 0;
+	//! The amount of rows in the table prior to the commit
+	idx_t table_row_count = 0;
+
+	//! Flush the inlined data of the table once this many rows have been inlined (0 = no limit)
+	idx_t inlined_row_limit = 0;
+	//! Flush the inlined data of the table once this many bytes have been inlined (0 = no limit)
+	idx_t inlined_size_limit = 0;
+	//! Merge the files of the table once this many small files have been written (0 = disabled)
+	idx_t small_file_limit = 0;
+	//! Rewrite the files of the table once this fraction of its rows has been deleted (0 = disabled)
+	double delete_ratio_limit = 0;
+
+	bool HasMaintenanceThresholds() const {
+		return inlined_row_limit > 0 || inlined_size_limit > 0 || small_file_limit > 0 || delete_ratio_limit > 0;
+	}
+};
+
+//! The state shared between the background maintenance and its thread
+//! The thread holds a reference to the state - if a task holds the last reference to the database, the catalog (and
+//! the background maintenance) are destroyed on the thread itself, after which it only accesses this state to exit
+struct DuckLakeMaintenanceState {
+	mutex lock;
+	std::condition_variable cv;
+	bool shutdown = false;
+	//! The maintenance queries that should be run
+	vector<string> task_queue;
+	//! The set of queued maintenance queries - used to avoid queueing the same task twice
+	unordered_set<string> queued_tasks;
+	//! The amount of times each failed maintenance query has failed in a row
+	unordered_map<string, idx_t> task_failures;
+	//! Whether the insert buffers should be checked for buffers that exceed their flush interval at next_buffer_check
+	bool buffer_check_scheduled = false;
+	std::chrono::steady_clock::time_point next_buffer_check;
+
+	//! Queue a maintenance query unless it is queued already - requires the lock to be held
+	void QueueTask(string query);
+	//! Register the result of a maintenance query - failed queries are queued again a few times
+	void FinishTask(const string &query, bool success);
+};
+
+//! The DuckLakeBackgroundMaintenance runs table maintenance in the background in reaction to commits
+//! Commits report the changes they made to tables - once the changes made to a table since its last maintenance cross
+//! one of the thresholds of the table, a background thread flushes the inlined data of the table
+//! (ducklake_flush_inlined_data), merges its small files (ducklake_merge_adjacent_files) or rewrites its files with
+//! many deletes (ducklake_rewrite_data_files).
+//! The thread also writes buffered inserts once they exceed the flush interval of their table
+//! (ducklake_flush_insert_buffer), and rewrites the files updated by copy-on-write updates once they have committed.
+class DuckLakeBackgroundMaintenance {
+	struct PendingChanges {
+		idx_t inlined_row_count = 0;
+		idx_t inlined_size_in_bytes = 0;
+		idx_t small_file_count = 0;
+		idx_t deleted_row_count = 0;
+	};
+
+public:
+	explicit DuckLakeBackgroundMaintenance(DuckLakeCatalog &catalog);
+	~DuckLakeBackgroundMaintenance();
+
+	//! Register the changes made by a committed transaction
+	void AddCommittedChanges(const vector<DuckLakeCommittedTableChanges> &committed_changes);
+	//! Check the insert buffers for buffers that exceed their flush interval after the given amount of microseconds
+	void ScheduleInsertBufferCheck(idx_t delay_us);
+	//! Run a maintenance query in the background (e.g. the rewrite of the files updated by a copy-on-write update)
+	void ScheduleQuery(const string &query);
+	//! Stop the background thread - waits for any running maintenance task to finish
+	void Stop();
+
+private:
+	static void Run(shared_ptr<DuckLakeMaintenanceState> state, DuckLakeBackgroundMaintenance &maintenance);
+	void ScheduleTask(const string &function_name, const string &schema_name, const string &table_name);
+	//! Schedule a buffer check - requires the lock of the state to be held
+	void ScheduleBufferCheck(idx_t delay_us);
+	//! Queue flushes of the insert buffers that exceed their flush interval
+	void CheckInsertBuffers();
+	//! Start the background thread if it is not running yet - requires the lock of the state to be held
+	void StartThread();
+	//! Run a maintenance query - returns whether it succeeded
+	bool RunTask(const string &query);
+
+private:
+	DuckLakeCatalog &catalog;
+	shared_ptr<DuckLakeMaintenanceState> state;
+	unique_ptr<thread> maintenance_thread;
+	//! The changes made per table since its last maintenance - guarded by the lock of the state
+	map<TableIndex, PendingChanges> pending_changes;
+};
+
+} // namespace duckdb
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_buffer_data.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/physical_operator.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
+
+namespace duckdb {
+class DuckLakeInsert;
+class DuckLakeTableEntry;
+
+//! The DuckLakeBufferData operator adds the inserted rows to the insert buffer of the table
+//! Rows are only emitted to the copy if the insert buffer should be flushed - in which case all buffered rows of the
+//! table are emitted
+class DuckLakeBufferData : public PhysicalOperator {
+public:
+	static constexpr const PhysicalOperatorType TYPE = PhysicalOperatorType::EXTENSION;
+
+public:
+	DuckLakeBufferData(PhysicalPlan &physical_plan, PhysicalOperator &child, DuckLakeTableEntry &table,
+	                   DuckLakeInsertBufferLimits limits, bool flush_buffer);
+
+	DuckLakeTableEntry &table;
+	DuckLakeInsertBufferLimits limits;
+	//! Whether we are flushing the buffer regardless of the limits (i.e. through ducklake_flush_insert_buffer)
+	bool flush_buffer;
+	optional_ptr<DuckLakeInsert> insert;
+
+public:
+	unique_ptr<OperatorState> GetOperatorState(ExecutionContext &context) const override;
+	unique_ptr<GlobalOperatorState> GetGlobalOperatorState(ClientContext &context) const override;
+	OperatorResultType Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                           GlobalOperatorState &gstate, OperatorState &state) const override;
+	OperatorFinalizeResultType FinalExecute(ExecutionContext &context, DataChunk &chunk, GlobalOperatorState &gstate,
+	                                        OperatorState &state) const override;
+	OperatorFinalResultType OperatorFinalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                                         OperatorFinalizeInput &input) const override;
+
+	bool RequiresFinalExecute() const override {
+		return true;
+	}
+	bool RequiresOperatorFinalize() const override {
+		return true;
+	}
+	bool ParallelOperator() const override {
+		return false;
+	}
+	string GetName() const override;
+};
+
+} // namespace duckdb
@@ -10,20 +10,65 @@
 
 #include "common/ducklake_encryption.hpp"
 #include "common/ducklake_options.hpp"
+#include "common/ducklake_snapshot.hpp"
 #include "common/ducklake_name_map.hpp"
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/types/value_map.hpp"
+#include "duckdb/main/connection.hpp"
 #include "storage/ducklake_catalog_set.hpp"
+#include "storage/ducklake_commit_stats.hpp"
+#include "storage/ducklake_metadata_stats.hpp"
 #include "storage/ducklake_partition_data.hpp"
 #include "storage/ducklake_stats.hpp"
 
+#include <chrono>
+#include <condition_variable>
+
 namespace duckdb {
 class ColumnList;
 class DuckLakeFieldData;
 struct DuckLakeFileListEntry;
 struct DuckLakeConfigOption;
 struct DeleteFileMap;
+struct DuckLakeCachedFileList;
+struct DuckLakeFileListLoad;
+struct DuckLakeSnapshotInfo;
+struct DuckLakeManifestList;
+struct DuckLakeZoneMapFilter;
+struct DuckLakeCatalogInfo;
+struct DuckLakeTableInfo;
+struct DuckLakePartitionInfo;
+struct DuckLakeMetadataCache;
+class DuckLakeColumnZoneMap;
+class DuckLakeDeleteFileCache;
+class DuckLakeDataFileCache;
+class DuckLakeInsertBuffer;
+class DuckLakeBackgroundMaintenance;
+class DuckLakeCompactionTracker;
+class DuckLakeFileSizeAdvisor;
+class DuckLakeReadAheadBudget;
+struct DuckLakeInsertBufferLimits;
+class DuckLakeFieldId;
 class LogicalGet;
 
+//! An entry in one of the caches of the catalog
+template <class T>
+struct DuckLakeCacheEntry {
+	shared_ptr<T> entry;
+	//! The snapshot at which the entry was loaded
+	idx_t snapshot_id;
+	//! The estimated memory usage of the entry
+	idx_t estimated_size;
+	//! The last time the entry was accessed - used for LRU eviction
+	idx_t last_access;
+};
+
+//! An idle connection to the metadata catalog, together with the statements prepared on it
+struct DuckLakeMetadataConnection {
+	unique_ptr<Connection> connection;
+	unordered_map<string, unique_ptr<PreparedStatement>> prepared_statements;
+};
+
 class DuckLakeCatalog : public Catalog {
 public:
 	// default target file size: 512MB
@@ -55,7 +100,22 @@ public:
 	const string &MetadataType() const {
 		return metadata_type;
 	}
+	//! The name of the attached read replica of the metadata catalog - empty if there is no read replica
+	const string &MetadataReplicaDatabaseName() const {
+		return options.metadata_replica_database;
+	}
+	//! Whether or not the read replica was observed to contain the given snapshot
+	bool ReplicaHasSnapshot(idx_t snapshot_id) const {
+		auto replica_snapshot = replica_snapshot_id.load();
+		return replica_snapshot != DConstants::INVALID_INDEX && replica_snapshot >= snapshot_id;
+	}
+	//! Record the latest snapshot that was observed on the read replica
+	void SetReplicaSnapshot(idx_t snapshot_id) {
+		replica_snapshot_id = snapshot_id;
+	}
 	idx_t DataInliningRowLimit(SchemaIndex schema_index, TableIndex table_index) const;
+	idx_t DeleteInliningRowLimit(SchemaIndex schema_index, TableIndex table_index) const;
+	DuckLakeInsertBufferLimits InsertBufferLimits(SchemaIndex schema_index, TableIndex table_index) const;
 	string &Separator() {
 		return separator;
 	}
@@ -70,6 +130,8 @@ public:
 		return default_value;
 	}
 	bool TryGetConfigOption(const string &option, string &result, DuckLakeTableEntry &table) const;
+	//! Whether or not the option is set in any scope - globally, or for any schema or table
+	bool HasConfigOption(const string &option) const;
 
 	optional_ptr<BoundAtClause> CatalogSnapshot() const;
 
@@ -106,6 +168,63 @@ public:
 	optional_ptr<CatalogEntry> GetEntryById(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot,
 	                                        TableIndex table_id);
 	string GeneratePathFromName(const string &uuid, const string &name);
+	//! Look up the snapshot an AT clause was resolved to by an earlier transaction
+	bool TryGetAtClauseSnapshot(const Value &at_clause, DuckLakeSnapshot &result);
+	//! Cache the snapshot an AT clause resolved to - only for AT clauses whose snapshot can no longer change
+	void CacheAtClauseSnapshot(Value at_clause, DuckLakeSnapshot snapshot);
+	//! Evict the AT clauses that resolved to any of the given (expired) snapshots
+	void EvictAtClauseSnapshots(const vector<DuckLakeSnapshotInfo> &snapshots);
+	//! Get the committed file list of a table at a given snapshot - this list is shared across transactions
+	vector<DuckLakeFileListEntry> GetFilesForTable(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+	                                               DuckLakeSnapshot snapshot);
+	//! Get the current manifest list of a table - returns nullptr if the table does not have (readable) manifests
+	shared_ptr<DuckLakeManifestList> GetManifestList(DuckLakeTransaction &transaction, DuckLakeTableEntry &table);
+	//! Get the committed file list of a table at a given snapshot from its manifests - skipping the manifests whose
+	//! partition summaries show they cannot match the filters, and applying the (SQL) filter to the manifest entries.
+	//! Returns false if the file list cannot be constructed from the manifests.
+	bool TryGetFilesFromManifests(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+	                              DuckLakeSnapshot snapshot, const vector<DuckLakeZoneMapFilter> &filters,
+	                              const string &filter, vector<DuckLakeFileListEntry> &result);
+	//! Get the zone map of a column, loading the stats of any files committed since it was last used - returns nullptr
+	//! if zone maps are not supported for the type of the column
+	shared_ptr<DuckLakeColumnZoneMap> GetZoneMap(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+	                                             const DuckLakeFieldId &field_id, DuckLakeSnapshot snapshot);
+	//! The cache of decoded delete files - shared across queries and transactions
+	DuckLakeDeleteFileCache &GetDeleteFileCache() {
+		return *delete_file_cache;
+	}
+	//! The local disk cache of remote data and delete files - nullptr if no cache directory is configured
+	optional_ptr<DuckLakeDataFileCache> GetDataFileCache() {
+		return data_file_cache.get();
+	}
+	//! The rows of buffered inserts that have not been written yet
+	DuckLakeInsertBuffer &GetInsertBuffer() {
+		return *insert_buffer;
+	}
+	//! Maintains tables (flushing inlined data, compaction) in the background once they cross their thresholds
+	DuckLakeBackgroundMaintenance &GetBackgroundMaintenance() {
+		return *background_maintenance;
+	}
+	//! The compaction candidates (small files and deletes) of the tables, maintained incrementally across commits
+	DuckLakeCompactionTracker &GetCompactionTracker() {
+		return *compaction_tracker;
+	}
+	//! Chooses the size of the data files of the tables from their observed workload
+	DuckLakeFileSizeAdvisor &GetFileSizeAdvisor() {
+		return *file_size_advisor;
+	}
+	//! The memory budget for reading ahead the files of all scans
+	shared_ptr<DuckLakeReadAheadBudget> GetReadAheadBudget() {
+		return read_ahead_budget;
+	}
+	//! The number, size and latency of the queries sent to the metadata catalog
+	DuckLakeMetadataStats &GetMetadataStats() {
+		return metadata_stats;
+	}
+	//! The time spent in the phases of the commits of this catalog - and the number (and cause) of their retries
+	DuckLakeCommitStats &GetCommitStats() {
+		return commit_stats;
+	}
 
 	bool InMemory() override;
 	string GetDBPath() override;
@@ -141,10 +260,40 @@ public:
 	idx_t GetNewUncommittedCatalogVersion() {
 		return ++last_uncommitted_catalog_version;
 	}
+	//! Get the catalog version of a committed schema version - this is the schema version itself unless the schema
+	//! was evicted from the cache, in which case plans bound against the evicted schema have to be re-bound
+	idx_t GetCommittedCatalogVersion(idx_t schema_version);
 
 	void SetCommittedSnapshotId(idx_t value) {
-		lock_guard<mutex> guard(commit_lock);
-		last_committed_snapshot = value;
+		{
+			lock_guard<mutex> guard(commit_lock);
+			last_committed_snapshot = value;
+		}
+		commit_cv.notify_all();
+	}
+	//! Wait until a transaction of this process commits a snapshot newer than snapshot_id, or until the timeout passes
+	void WaitForCommit(idx_t snapshot_id, idx_t timeout_ms) {
+		unique_lock<mutex> guard(commit_lock);
+		commit_cv.wait_for(guard, std::chrono::milliseconds(timeout_ms), [&]() {
+			return last_committed_snapshot.IsValid() && last_committed_snapshot.GetIndex() > snapshot_id;
+		});
+	}
+
+	//! Returns the most recently observed latest snapshot, if it was observed within the configured staleness bound
+	//! (or at all, if the metadata catalog is exclusive to this process)
+	unique_ptr<DuckLakeSnapshot> TryGetLatestSnapshot();
+	//! Record the latest snapshot - either loaded from the metadata catalog or committed by a transaction
+	void SetLatestSnapshot(DuckLakeSnapshot snapshot);
+	//! Mark the metadata catalog as only being written to by this process
+	void SetExclusiveMetadata(bool exclusive) {
+		exclusive_metadata = exclusive;
+	}
+	//! Whether the metadata catalog has the snapshot change index - which commits write and conflict checks read
+	bool HasSnapshotChangeIndex() const {
+		return snapshot_change_index;
+	}
+	void SetSnapshotChangeIndex(bool has_index) {
+		snapshot_change_index = has_index;
 	}
 
 	Value GetLastCommittedSnapshotId() const {
@@ -158,6 +307,18 @@ public:
 	optional_ptr<const DuckLakeNameMap> TryGetMappingById(DuckLakeTransaction &transaction, MappingIndex mapping_id);
 	MappingIndex TryGetCompatibleNameMap(DuckLakeTransaction &transaction, const DuckLakeNameMap &name_map);
 	idx_t GetSnapshotForSchema(idx_t schema_id, DuckLakeTransaction &transaction);
+	//! Load the local metadata cache (if configured) - after which only changes made since the cached snapshot are
+	//! read from the metadata catalog
+	void LoadMetadataCache(DuckLakeTransaction &transaction);
+	//! Load the specified lazily loaded tables of a schema version
+	void LoadLazyEntries(DuckLakeTransaction &transaction, DuckLakeCatalogSet &schema_set,
+	                     const vector<TableIndex> &table_ids);
+	//! Borrow a connection to the metadata catalog - returns an idle pooled connection, or nullptr if there is none
+	//! (in which case the caller creates a new connection). Every borrow must be paired with a ReturnConnection
+	unique_ptr<DuckLakeMetadataConnection> BorrowConnection();
+	//! Return a borrowed connection - if the connection is set (and no longer has an active transaction) it is kept
+	//! in the pool for re-use by other transactions
+	void ReturnConnection(unique_ptr<DuckLakeMetadataConnection> connection);
 
 private:
 	void DropSchema(ClientContext &context, DropInfo &info) override;
@@ -165,21 +326,114 @@ private:
 	//! Return the schema for the given snapshot - loading it if it is not yet loaded
 	DuckLakeCatalogSet &GetSchemaForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot);
 	unique_ptr<DuckLakeCatalogSet> LoadSchemaForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot);
+	//! Load a schema version by applying the changes made since an earlier cached schema version on top of it
+	unique_ptr<DuckLakeCatalogSet> LoadSchemaChanges(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot);
+	unique_ptr<DuckLakeCatalogSet> CreateSchemaSet(DuckLakeSnapshot snapshot, DuckLakeCatalogInfo &catalog,
+	                                               optional_ptr<DuckLakeCatalogSet> base_set,
+	                                               const set<TableIndex> &changed_entries);
+	void AddTableEntries(DuckLakeCatalogSet &schema_set, vector<DuckLakeTableInfo> &tables,
+	                     vector<DuckLakePartitionInfo> &partitions);
+	//! Look up a committed table by id - loading it if it is lazily loaded
+	optional_ptr<CatalogEntry> GetCommittedEntryById(DuckLakeTransaction &transaction, DuckLakeCatalogSet &schema,
+	                                                 TableIndex table_id);
 	DuckLakeStats &GetStatsForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot);
 	unique_ptr<DuckLakeStats> LoadStatsForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot,
 	                                               DuckLakeCatalogSet &schema);
+	//! Load the stats for a snapshot by reloading only the tables changed since an earlier set of cached stats
+	unique_ptr<DuckLakeStats> LoadStatsChanges(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot,
+	                                           DuckLakeCatalogSet &schema);
 	void LoadNameMaps(DuckLakeTransaction &transaction);
+	//! Evict the least recently used schema and stats versions until the caches fit in the memory budget
+	void EvictCacheEntries();
+	//! Write the local metadata cache (if configured)
+	void WriteMetadataCache();
+	//! Close all idle pooled metadata connections
+	void ClearConnectionPool();
+	//! Load the committed file list of a table at a snapshot - starting from the cached file list (if any)
+	shared_ptr<DuckLakeCachedFileList> LoadFileList(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+	                                                DuckLakeSnapshot snapshot,
+	                                                const shared_ptr<DuckLakeCachedFileList> &cached_list,
+	                                                vector<DuckLakeFileListEntry> &loaded_files);
+	//! Publish the result of a file list load to the scans waiting for it - nullptr if the load failed
+	void FinishFileListLoad(TableIndex table_id, idx_t snapshot_id, const shared_ptr<DuckLakeFileListLoad> &load,
+	                        shared_ptr<DuckLakeCachedFileList> result);
+	shared_ptr<DuckLakeCachedFileList> TryUpdateFileList(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+	                                                     const DuckLakeCachedFileList &cached_list,
+	                                                     DuckLakeSnapshot snapshot);
+	//! Load the file list of a table at a snapshot from (a subset of) its manifests, and the changes made since
+	shared_ptr<DuckLakeCachedFileList>
+	TryLoadFileListFromManifests(DuckLakeTransaction &transaction, DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                             const vector<DuckLakeZoneMapFilter> &filters, const string &filter);
 
 private:
 	mutex schemas_lock;
 	//! Map of schema index -> schema
-	unordered_map<idx_t, unique_ptr<DuckLakeCatalogSet>> schemas;
+	unordered_map<idx_t, DuckLakeCacheEntry<DuckLakeCatalogSet>> schemas;
 	//! Map of data file index -> table stats
-	unordered_map<idx_t, unique_ptr<DuckLakeStats>> stats;
+	unordered_map<idx_t, DuckLakeCacheEntry<DuckLakeStats>> stats;
+	//! The estimated memory usage of the schema and stats caches
+	idx_t cache_size = 0;
+	//! Access counter for the schema and stats caches
+	idx_t cache_access_count = 0;
+	//! Map of schema version -> catalog version for schema versions that were evicted from the cache
+	//! Prepared statements keep references into the schema they were bound against - changing the catalog version
+	//! makes DuckDB re-bind them against the reloaded schema
+	unordered_map<idx_t, idx_t> evicted_schema_versions;
+	//! The catalog version assigned to the last evicted schema version - this lies between the committed schema
+	//! versions and the uncommitted catalog versions
+	idx_t last_evicted_catalog_version = TRANSACTION_ID_START / 2;
+	//! The local metadata cache - only set if a catalog_cache_path is configured
+	unique_ptr<DuckLakeMetadataCache> metadata_cache;
+	//! The name map lock - guards the name maps, separately from the schemas so that adding files does not contend
+	//! with schema lookups
+	mutex name_maps_lock;
 	//! Map of mapping index -> name map
 	DuckLakeNameMapSet name_maps;
 	//! The maximum name map index we have loaded so far
 	optional_idx loaded_name_map_index;
+	//! The AT clause lock
+	mutex at_clause_lock;
+	//! Map of AT clause (e.g. {"version": 2}) -> the committed snapshot it resolves to
+	value_map_t<DuckLakeSnapshot> at_clause_snapshots;
+	//! The file list lock
+	mutex file_list_lock;
+	//! Map of table index -> most recently loaded committed file list of that table
+	unordered_map<idx_t, shared_ptr<DuckLakeCachedFileList>> file_lists;
+	//! Map of table index -> snapshot id -> in-flight load of the file list of that table at that snapshot (guarded by
+	//! the file list lock) - concurrent scans of the same table at the same snapshot wait for a single load
+	unordered_map<idx_t, unordered_map<idx_t, shared_ptr<DuckLakeFileListLoad>>> file_list_loads;
+	//! Notified whenever an in-flight file list load finishes
+	std::condition_variable file_list_cv;
+	//! Map of table index -> manifest list of that table (guarded by the file list lock)
+	unordered_map<idx_t, shared_ptr<DuckLakeManifestList>> manifest_lists;
+	//! The zone map lock
+	mutex zone_map_lock;
+	//! Map of table index -> column index -> zone map of that column
+	unordered_map<idx_t, unordered_map<idx_t, shared_ptr<DuckLakeColumnZoneMap>>> zone_maps;
+	//! The decoded contents of recently read delete files
+	unique_ptr<DuckLakeDeleteFileCache> delete_file_cache;
+	//! The local copies of remote data and delete files
+	unique_ptr<DuckLakeDataFileCache> data_file_cache;
+	//! The buffered inserts of all tables
+	unique_ptr<DuckLakeInsertBuffer> insert_buffer;
+	//! The background maintenance of tables
+	unique_ptr<DuckLakeBackgroundMaintenance> background_maintenance;
+	//! The tracked compaction candidates of the tables
+	unique_ptr<DuckLakeCompactionTracker> compaction_tracker;
+	//! The observed workload of the tables
+	unique_ptr<DuckLakeFileSizeAdvisor> file_size_advisor;
+	//! The memory budget of the read-ahead of the scans - shared with the scans, which release it when they finish
+	shared_ptr<DuckLakeReadAheadBudget> read_ahead_budget;
+	//! The stats of the queries sent to the metadata catalog
+	DuckLakeMetadataStats metadata_stats;
+	//! The stats of the commits of this catalog
+	DuckLakeCommitStats commit_stats;
+	//! The connection pool lock
+	mutex connection_pool_lock;
+	//! Idle connections to the metadata catalog
+	vector<unique_ptr<DuckLakeMetadataConnection>> connection_pool;
+	//! The number of currently borrowed metadata connections
+	idx_t borrowed_connections = 0;
 	//! The configuration lock
 	mutable mutex config_lock;
 	//! The DuckLake options
@@ -195,6 +449,21 @@ private:
 	//! The id of the last committed snapshot, set at FlushChanges on a successful commit
 	mutable mutex commit_lock;
 	optional_idx last_committed_snapshot;
+	//! Notified whenever a transaction of this process commits a snapshot
+	std::condition_variable commit_cv;
+	//! The most recently observed latest snapshot, shared between transactions if snapshot_staleness_ms is set
+	mutex latest_snapshot_lock;
+	unique_ptr<DuckLakeSnapshot> latest_snapshot;
+	//! The time (in milliseconds since an arbitrary point) at which the latest snapshot was observed
+	idx_t latest_snapshot_time = 0;
+	//! Whether or not all snapshots are committed through this catalog - in which case the latest snapshot it observed
+	//! is never stale, and read-only transactions that only hit the caches never access the metadata catalog
+	bool exclusive_metadata = false;
+	//! Whether the metadata catalog has the snapshot change index
+	bool snapshot_change_index = false;
+	//! The latest snapshot observed on the read replica of the metadata catalog - reads are only routed to the replica
+	//! if it has caught up to the latest snapshot seen by the reading transaction
+	atomic<idx_t> replica_snapshot_id {DConstants::INVALID_INDEX};
 };
 
 } // namespace duckdb
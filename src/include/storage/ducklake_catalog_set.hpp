@@ -21,8 +21,18 @@ class DuckLakeTableEntry;
 
 using ducklake_entries_map_t = case_insensitive_map_t<unique_ptr<CatalogEntry>>;
 
+//! A table in the catalog set of which only the name is known - the catalog entry is created on first access
+struct DuckLakeLazyEntry {
+	DuckLakeLazyEntry(DuckLakeSchemaEntry &schema, string name_p) : schema(schema), name(std::move(name_p)) {
+	}
+
+	reference<DuckLakeSchemaEntry> schema;
+	string name;
+};
+
 //! The DuckLakeCatalogSet contains a set of catalog entries for a given schema version of the DuckLake
-//! Note that we don't need any locks to access this - the catalog set is constant for a given snapshot
+//! Note that the catalog set is constant for a given snapshot - the only exception are lazily loaded tables, which are
+//! materialized on first access. Lookups are therefore protected by a lock.
 class DuckLakeCatalogSet {
 public:
 	DuckLakeCatalogSet();
@@ -34,6 +44,16 @@ public:
 	optional_ptr<CatalogEntry> GetEntryById(SchemaIndex index);
 	optional_ptr<CatalogEntry> GetEntryById(TableIndex index);
 	void AddEntry(DuckLakeSchemaEntry &schema, TableIndex id, unique_ptr<CatalogEntry> entry);
+	//! Add a table whose catalog entry is only created on first access
+	void AddLazyEntry(DuckLakeSchemaEntry &schema, TableIndex id, string name);
+	//! Add a lazily loaded table to the entries of a schema
+	void AddLazyEntry(const string &name, TableIndex id);
+	//! Returns the id of the lazily loaded table with the given name - or an invalid index if there is none
+	TableIndex GetLazyEntry(const string &name);
+	//! Returns the ids of all lazily loaded tables of a schema
+	vector<TableIndex> GetLazyEntries();
+	//! Whether or not the table with the given id has not been loaded yet
+	bool IsLazyEntry(TableIndex id);
 
 	template <class T>
 	optional_ptr<T> GetEntry(const string &name) {
@@ -50,11 +70,30 @@ public:
 	const map<SchemaIndex, reference<DuckLakeSchemaEntry>> &GetSchemaIdMap() {
 		return schema_entry_map;
 	}
+	const map<TableIndex, reference<CatalogEntry>> &GetTableIdMap() {
+		return table_entry_map;
+	}
+	const map<TableIndex, DuckLakeLazyEntry> &GetLazyEntryMap() {
+		return lazy_entry_map;
+	}
+	//! The snapshot at which the catalog set was loaded - lazily loaded tables are loaded at this snapshot
+	DuckLakeSnapshot GetSnapshot() const {
+		return snapshot;
+	}
+	void SetSnapshot(DuckLakeSnapshot snapshot_p) {
+		snapshot = snapshot_p;
+	}
 
 private:
+	mutex entry_lock;
 	ducklake_entries_map_t catalog_entries;
 	map<SchemaIndex, reference<DuckLakeSchemaEntry>> schema_entry_map;
 	map<TableIndex, reference<CatalogEntry>> table_entry_map;
+	//! Map of table index -> tables that have not been loaded yet
+	map<TableIndex, DuckLakeLazyEntry> lazy_entry_map;
+	//! Map of name -> id of the tables in a schema that have not been loaded yet
+	case_insensitive_map_t<TableIndex> lazy_entries;
+	DuckLakeSnapshot snapshot;
 };
 
 } // namespace duckdb
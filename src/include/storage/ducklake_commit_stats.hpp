@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_commit_stats.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+//! The time spent in the phases of a single commit - summed over all of its attempts
+struct DuckLakeCommitTimings {
+	//! The time spent in every phase of the commit (e.g. "conflict_check" or "write_data_files")
+	map<string, idx_t> phase_time_us;
+	idx_t total_time_us = 0;
+	//! The number of times the commit was retried
+	idx_t retries = 0;
+	//! The causes of the errors that made the commit retry (or fail)
+	vector<string> conflict_causes;
+	bool failed = false;
+};
+
+//! Adds the time spent in this scope to a phase of a commit
+class DuckLakeCommitPhase {
+public:
+	DuckLakeCommitPhase(DuckLakeCommitTimings &timings, const char *phase);
+	~DuckLakeCommitPhase();
+
+private:
+	DuckLakeCommitTimings &timings;
+	const char *phase;
+	std::chrono::steady_clock::time_point start;
+};
+
+//! The accumulated time spent in one phase of the commits
+struct DuckLakeCommitPhaseStats {
+	idx_t commits = 0;
+	idx_t total_time_us = 0;
+	idx_t max_time_us = 0;
+};
+
+struct DuckLakeCommitStatsData {
+	idx_t commits = 0;
+	idx_t failed_commits = 0;
+	idx_t retries = 0;
+	idx_t max_retries = 0;
+	idx_t total_time_us = 0;
+	idx_t max_time_us = 0;
+	map<string, DuckLakeCommitPhaseStats> phases;
+	//! The number of retries (or failures) per cause
+	map<string, idx_t> conflict_causes;
+};
+
+//! Tracks where the commits of a DuckLake catalog spend their time - so that the retry settings and the amount of
+//! concurrent writers can be tuned
+class DuckLakeCommitStats {
+public:
+	void Record(const DuckLakeCommitTimings &timings);
+	DuckLakeCommitStatsData GetStats() const;
+	void Reset();
+
+	//! Classifies the error that made a commit attempt fail - without the identifiers of the entries involved
+	static string GetConflictCause(const string &error_message);
+
+private:
+	mutable mutex lock;
+	DuckLakeCommitStatsData stats;
+};
+
+} // namespace duckdb
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_compact_file_list.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "storage/ducklake_metadata_info.hpp"
+
+namespace duckdb {
+
+//! The DuckLakeCompactFileList is the compact in-memory representation of a (cached) file list of a table
+//! Every path is split into its directory and its file name. Directories - which are shared by (almost) all files of a
+//! table - are interned and stored only once, while the file names and encryption keys are appended to a single string
+//! arena. The entries themselves are fixed-size and reference the strings by offset, so a file list of N files takes
+//! only a handful of allocations instead of several per file.
+class DuckLakeCompactFileList {
+	static constexpr const uint32_t INVALID_DIRECTORY = NumericLimits<uint32_t>::Maximum();
+
+	//! A string stored in the arena
+	struct ArenaString {
+		idx_t offset = 0;
+		idx_t length = 0;
+	};
+	struct CompactFileData {
+		//! The interned directory of the path - INVALID_DIRECTORY if there is no file
+		uint32_t directory = INVALID_DIRECTORY;
+		ArenaString file_name;
+		ArenaString encryption_key;
+		idx_t file_size_bytes = 0;
+		idx_t footer_size = DConstants::INVALID_INDEX;
+	};
+	struct CompactFileListEntry {
+		CompactFileData file;
+		CompactFileData delete_file;
+		idx_t row_id_start;
+		idx_t snapshot_id;
+		idx_t max_row_count;
+		idx_t snapshot_filter;
+		idx_t mapping_id;
+		idx_t file_id;
+		idx_t row_count;
+		idx_t delete_count;
+		DuckLakeDataType data_type;
+	};
+public:
+	DuckLakeCompactFileList();
+	explicit DuckLakeCompactFileList(const vector<DuckLakeFileListEntry> &files);
+
+	idx_t size() const {
+		return entries.size();
+	}
+	bool empty() const {
+		return entries.empty();
+	}
+
+	//! Add a file to the list
+	void Append(const DuckLakeFileListEntry &file);
+	//! Add a file of another list to this list - without materializing it
+	void Append(const DuckLakeCompactFileList &other, idx_t index);
+	//! The data file id of a file
+	DataFileIndex GetFileId(idx_t index) const {
+		return DataFileIndex(entries[index].file_id);
+	}
+	//! Materialize a single file
+	DuckLakeFileListEntry Get(idx_t index) const;
+	//! Materialize all files of the list
+	vector<DuckLakeFileListEntry> GetEntries() const;
+
+private:
+	ArenaString AddString(const char *data, idx_t length);
+	string GetString(const ArenaString &str) const;
+	uint32_t InternDirectory(const string &directory);
+	CompactFileData CompactFile(const DuckLakeFileData &file);
+	CompactFileData CopyFile(const DuckLakeCompactFileList &other, const CompactFileData &file);
+	DuckLakeFileData GetFile(const CompactFileData &file) const;
+
+private:
+	vector<CompactFileListEntry> entries;
+	//! The file names and encryption keys of all files
+	string arena;
+	//! The distinct directories of the paths
+	vector<string> directories;
+	unordered_map<string, uint32_t> directory_map;
+};
+
+} // namespace duckdb
@@ -16,7 +16,10 @@
 #include "storage/ducklake_metadata_info.hpp"
 
 namespace duckdb {
+class DuckLakeCatalog;
+class DuckLakeParquetMerge;
 class DuckLakeTableEntry;
+class DuckLakeTransaction;
 
 class DuckLakeCompaction : public PhysicalOperator {
 public:
@@ -59,4 +62,96 @@ public:
 	string GetName() const override;
 };
 
+//! The DuckLakePassthroughCompaction operator merges adjacent files by copying their row groups into the merged file
+//! The rows are not decoded and written again - only the footer of the merged file is written (see
+//! DuckLakeParquetMerge). The stats of the merged file are the merged stats of the source files.
+class DuckLakePassthroughCompaction : public PhysicalOperator {
+public:
+	DuckLakePassthroughCompaction(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+	                              DuckLakeTableEntry &table, vector<DuckLakeCompactionFileEntry> source_files_p,
+	                              shared_ptr<DuckLakeParquetMerge> merge, string file_path, optional_idx partition_id,
+	                              vector<string> partition_values, optional_idx row_id_start);
+
+	DuckLakeTableEntry &table;
+	vector<DuckLakeCompactionFileEntry> source_files;
+	shared_ptr<DuckLakeParquetMerge> merge;
+	string file_path;
+	optional_idx partition_id;
+	vector<string> partition_values;
+	optional_idx row_id_start;
+
+public:
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+	string GetName() const override;
+
+private:
+	DuckLakeColumnStatsMap MergeColumnStats(DuckLakeTransaction &transaction) const;
+};
+
+//! A compaction target of a parallel compaction
+struct DuckLakeCompactionTableTarget {
+	string schema_name;
+	string table_name;
+	//! The maximum amount of bytes rewritten for this table (if any)
+	optional_idx max_bytes;
+};
+
+//! The DuckLakeParallelCompaction compacts a set of tables concurrently
+//! Every table is compacted by a separate connection in its own transaction - so every table is committed on its own
+//! and a slow table does not hold up the others. Once the time budget is used up, the remaining tables are skipped.
+class DuckLakeParallelCompaction : public PhysicalOperator {
+public:
+	DuckLakeParallelCompaction(PhysicalPlan &physical_plan, const vector<LogicalType> &types, DuckLakeCatalog &catalog,
+	                           vector<DuckLakeCompactionTableTarget> tables, CompactionType type,
+	                           double delete_threshold, idx_t max_concurrency, optional_idx max_duration_us);
+
+	DuckLakeCatalog &catalog;
+	vector<DuckLakeCompactionTableTarget> tables;
+	CompactionType type;
+	double delete_threshold;
+	idx_t max_concurrency;
+	//! No new tables are compacted once this much time has passed (if set)
+	optional_idx max_duration_us;
+
+public:
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+	string GetName() const override;
+
+private:
+	string GetCompactionQuery(const DuckLakeCompactionTableTarget &table) const;
+};
+
+//! The DuckLakeInlineDeletes operator moves small delete files of a table into the metadata catalog
+//! The deletes of every source file are read and written back as inlined deletes that replace the delete file
+class DuckLakeInlineDeletes : public PhysicalOperator {
+public:
+	DuckLakeInlineDeletes(PhysicalPlan &physical_plan, const vector<LogicalType> &types, DuckLakeTableEntry &table,
+	                      vector<DuckLakeCompactionFileEntry> source_files);
+
+	DuckLakeTableEntry &table;
+	vector<DuckLakeCompactionFileEntry> source_files;
+
+public:
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+	string GetName() const override;
+};
+
 } // namespace duckdb
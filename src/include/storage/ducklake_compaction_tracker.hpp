@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_compaction_tracker.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "common/index.hpp"
+#include "storage/ducklake_metadata_info.hpp"
+
+namespace duckdb {
+class DuckLakeTransaction;
+struct DuckLakeDataFile;
+
+//! A data file written by a committed transaction
+struct DuckLakeCompactionTrackerFile {
+	//! The partition the file belongs to (see DuckLakeCompactionTracker::GetPartitionKey)
+	string partition_key;
+	idx_t file_size_bytes = 0;
+};
+
+//! The changes a committed transaction made to the files of a table
+struct DuckLakeCompactionTrackerChanges {
+	TableIndex table_id;
+	//! The files of the table were replaced (e.g. by a compaction) - the table state has to be gathered again
+	bool invalidate = false;
+	//! Rows were deleted from the data files of the table
+	bool deleted_rows = false;
+	//! The data files added to the table
+	vector<DuckLakeCompactionTrackerFile> new_files;
+};
+
+//! The DuckLakeCompactionTracker keeps track of the compaction candidates of every table - i.e. the small files of
+//! every partition and the deletion ratio of the files - so that compaction can skip the tables that have no work
+//! without reading their full file list from the metadata catalog.
+//! The state of a table is gathered from the file list read by a compaction and then maintained incrementally by the
+//! commits of this process. Commits made by other processes are detected through the snapshot changes - if the files of
+//! a table were changed by one of them, the state of the table is discarded and gathered again by the next compaction.
+class DuckLakeCompactionTracker {
+	static constexpr const double UNKNOWN_DELETE_RATIO = NumericLimits<double>::Maximum();
+
+	struct PartitionState {
+		//! The amount and total size of the live files below the target file size
+		idx_t small_file_count = 0;
+		idx_t small_file_bytes = 0;
+	};
+	struct TableState {
+		//! The snapshot up to which the state reflects the files of the table
+		idx_t snapshot_id;
+		//! The target file size the small files were determined with
+		idx_t target_file_size;
+		//! Map of partition key -> state of the partition
+		map<string, PartitionState> partitions;
+		//! The highest deletion ratio of any live file - or UNKNOWN_DELETE_RATIO if it is not known
+		double max_delete_ratio = UNKNOWN_DELETE_RATIO;
+		//! The lowest deletion threshold for which a rewrite is known to have no work
+		double clean_rewrite_threshold = UNKNOWN_DELETE_RATIO;
+	};
+
+public:
+	//! Whether a compaction of the table can be skipped because the tracked state shows it has no candidates
+	bool CanSkipCompaction(DuckLakeTransaction &transaction, TableIndex table_id, CompactionType type,
+	                       idx_t target_file_size, double delete_threshold);
+	//! Set the state of a table from the full file list read for a merge at the given snapshot
+	void SetTableState(TableIndex table_id, idx_t snapshot_id, idx_t target_file_size,
+	                   const vector<DuckLakeCompactionFileEntry> &files);
+	//! Register that a rewrite at the given snapshot found no files that exceed the deletion threshold
+	void SetCleanRewrite(TableIndex table_id, idx_t snapshot_id, double delete_threshold);
+	//! Apply the changes made by a committed transaction
+	void CommitChanges(idx_t commit_snapshot_id, const vector<DuckLakeCompactionTrackerChanges> &changes);
+
+	//! The key of the partition a file belongs to - files can only be merged with files of the same partition
+	static string GetPartitionKey(const optional_idx &partition_id, const vector<string> &partition_values);
+	static string GetPartitionKey(const DuckLakeDataFile &file);
+
+private:
+	//! Bring the state of a table up to the given snapshot - returns false if the files of the table were changed by
+	//! a commit the state does not reflect
+	bool AdvanceTableState(DuckLakeTransaction &transaction, TableIndex table_id, idx_t snapshot_id);
+
+private:
+	mutex lock;
+	//! Map of table index -> state of that table
+	unordered_map<idx_t, TableState> tables;
+};
+
+} // namespace duckdb
@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_create_index.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/physical_operator.hpp"
+
+namespace duckdb {
+class Binder;
+class DuckLakeTableEntry;
+struct CreateIndexInfo;
+
+//! The DuckLakeCreateIndex operator creates a secondary index on a set of columns of a table
+//! DuckLake indexes are immutable per-file Bloom filters, stored next to the column stats of every data file. The
+//! indexed columns are added to the "bloom_filter_columns" option of the table - so the Bloom filters are written for
+//! every new file (on insert, compaction and flushes of inlined data) - and the Bloom filters of the existing files of
+//! the table are computed. Scans use the Bloom filters to skip the files that cannot contain the values of equality
+//! and IN filters.
+class DuckLakeCreateIndex : public PhysicalOperator {
+public:
+	DuckLakeCreateIndex(PhysicalPlan &physical_plan, const vector<LogicalType> &types, DuckLakeTableEntry &table,
+	                    vector<string> columns);
+
+	DuckLakeTableEntry &table;
+	//! The indexed columns
+	vector<string> columns;
+
+public:
+	//! Plan a CREATE INDEX statement on a DuckLake table
+	static unique_ptr<LogicalOperator> Bind(Binder &binder, CreateIndexInfo &info, DuckLakeTableEntry &table);
+
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+	string GetName() const override;
+};
+
+} // namespace duckdb
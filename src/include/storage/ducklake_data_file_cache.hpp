@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_data_file_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+class FileSystem;
+
+//! The DuckLakeDataFileCache keeps local copies of remote data and delete files in a directory on local disk
+//! Cached copies are keyed by the path and the size of the file recorded in the metadata - files written by DuckLake
+//! are immutable and uniquely named, and a file that no longer matches its recorded size is never cached. The cache
+//! survives restarts and is bounded by the total size of the cached files - the least
+//! recently used files are evicted first.
+class DuckLakeDataFileCache {
+public:
+	DuckLakeDataFileCache(FileSystem &fs, string directory, idx_t max_size);
+
+	//! Returns the path of the local copy of a remote file, downloading the file if it is not cached yet
+	//! Returns the original path if the file is not remote, does not fit in the cache, does not have file_size (the
+	//! size recorded in the metadata) or cannot be cached (e.g. because the local disk is full)
+	string GetLocalPath(const string &path, idx_t file_size);
+
+private:
+	struct CacheEntry {
+		string local_path;
+		idx_t file_size;
+		idx_t last_access;
+	};
+
+	//! Register the files that were cached by a previous session
+	void LoadCachedFiles();
+	string GetCacheFileName(const string &path, idx_t file_size) const;
+	//! Download a remote file to local_path - returns false (without downloading) if its size is not file_size
+	bool DownloadFile(const string &path, const string &local_path, idx_t file_size);
+	void EvictEntries();
+
+private:
+	FileSystem &fs;
+	string directory;
+	idx_t max_size;
+	mutex lock;
+	idx_t cache_size = 0;
+	idx_t access_count = 0;
+	//! Map of cache file name -> cached file
+	unordered_map<string, CacheEntry> entries;
+};
+
+} // namespace duckdb
@@ -16,6 +16,8 @@ namespace duckdb {
 class DuckLakeTableEntry;
 class DuckLakeDeleteGlobalState;
 class DuckLakeTransaction;
+class CopyFunctionCatalogEntry;
+struct DuckLakeDeleteFileWrite;
 
 struct DuckLakeDeleteMap {
 
@@ -109,7 +111,10 @@ public:
 
 private:
 	void FlushDelete(DuckLakeTransaction &transaction, ClientContext &context, DuckLakeDeleteGlobalState &global_state,
-	                 const string &filename, ColumnDataCollection &deleted_rows) const;
+	                 const string &filename, ColumnDataCollection &deleted_rows,
+	                 vector<DuckLakeDeleteFileWrite> &pending_writes) const;
+	void WriteDeleteFile(ClientContext &context, CopyFunctionCatalogEntry &copy_fun,
+	                     DuckLakeDeleteFileWrite &pending_write) const;
 };
 
 } // namespace duckdb
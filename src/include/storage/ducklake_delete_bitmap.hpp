@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_delete_bitmap.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/types/selection_vector.hpp"
+
+namespace duckdb {
+
+//! The DuckLakeDeleteBitmap is a compressed (roaring-style) set of deleted row positions
+//! Rows are grouped in containers of 64K rows. Sparse containers store the low 16 bits of the deleted rows as a sorted
+//! array, dense containers store them as a bitmap.
+class DuckLakeDeleteBitmap {
+	static constexpr const idx_t CONTAINER_BITS = 16;
+	static constexpr const idx_t CONTAINER_SIZE = 1ULL << CONTAINER_BITS;
+	static constexpr const idx_t BITMAP_WORDS = CONTAINER_SIZE / 64;
+	//! Containers with more entries than this are stored as a bitmap
+	static constexpr const idx_t ARRAY_LIMIT = 4096;
+
+	struct Container {
+		explicit Container(idx_t key) : key(key) {
+		}
+
+		idx_t key;
+		idx_t count = 0;
+		//! The sorted set of deleted rows - used while the container is sparse
+		vector<uint16_t> array;
+		//! The bitmap of deleted rows - used once the container is dense
+		vector<uint64_t> bitmap;
+
+		bool IsBitmap() const {
+			return !bitmap.empty();
+		}
+		bool Add(uint16_t row);
+		bool Contains(uint16_t row) const;
+		//! Set bit (mask_offset + i) of the mask for every deleted row (offset + i) in [offset, offset + count)
+		void GetMask(idx_t offset, idx_t count, uint64_t *mask, idx_t mask_offset) const;
+	};
+
+public:
+	void Add(idx_t row);
+	bool Contains(idx_t row) const;
+	//! The total amount of deleted rows
+	idx_t Count() const {
+		return total_count;
+	}
+	bool Empty() const {
+		return total_count == 0;
+	}
+	void Clear();
+	//! Returns the sorted list of deleted rows
+	vector<idx_t> ToVector() const;
+	//! The estimated memory usage of the bitmap
+	idx_t EstimatedSize() const;
+	//! Filter the deleted rows from the range [start, start + count) - returns the amount of remaining rows
+	//! If no rows in the range are deleted the selection vector is left untouched
+	idx_t Filter(idx_t start, idx_t count, SelectionVector &result_sel) const;
+
+private:
+	optional_ptr<const Container> FindContainer(idx_t key) const;
+
+private:
+	//! The containers, ordered by key
+	vector<Container> containers;
+	idx_t total_count = 0;
+};
+
+} // namespace duckdb
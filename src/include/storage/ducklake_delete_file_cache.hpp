@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_delete_file_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <condition_variable>
+
+namespace duckdb {
+struct DuckLakeDeleteData;
+
+//! The DuckLakeDeleteFileCache holds the decoded contents of recently read delete files
+//! Delete files are immutable and never re-used, so the decoded deletes can be shared by all queries and transactions
+//! that read the same delete file. The cache is bounded by the estimated memory usage of the decoded deletes.
+//! With shared loads, readers of a delete file that is being loaded by another query wait for that load to finish
+//! instead of reading and decoding the same delete file again.
+class DuckLakeDeleteFileCache {
+public:
+	DuckLakeDeleteFileCache(idx_t max_size, bool shared_loads);
+
+	//! Returns the cached deletes of the delete file, or nullptr if the delete file is not cached
+	shared_ptr<DuckLakeDeleteData> Get(const string &path);
+	//! Add the decoded deletes of a delete file to the cache
+	void Insert(const string &path, shared_ptr<DuckLakeDeleteData> delete_data);
+	//! Returns the cached deletes of the delete file - loading and caching them if they are not cached yet
+	shared_ptr<DuckLakeDeleteData> GetOrLoad(const string &path,
+	                                         const std::function<shared_ptr<DuckLakeDeleteData>()> &load);
+
+private:
+	struct CacheEntry {
+		shared_ptr<DuckLakeDeleteData> delete_data;
+		idx_t estimated_size;
+		idx_t last_access;
+	};
+	struct PendingLoad {
+		bool finished = false;
+		//! The loaded deletes - nullptr if the load failed
+		shared_ptr<DuckLakeDeleteData> delete_data;
+	};
+
+	void EvictEntries();
+	void FinishLoad(const string &path, const shared_ptr<PendingLoad> &pending,
+	                shared_ptr<DuckLakeDeleteData> delete_data);
+
+private:
+	mutex lock;
+	idx_t max_size;
+	bool shared_loads;
+	idx_t cache_size = 0;
+	idx_t access_count = 0;
+	//! Map of delete file path -> decoded deletes
+	unordered_map<string, CacheEntry> entries;
+	//! Map of delete file path -> in-flight load of that delete file
+	unordered_map<string, shared_ptr<PendingLoad>> pending_loads;
+	//! Notified whenever an in-flight load finishes
+	std::condition_variable load_finished;
+};
+
+} // namespace duckdb
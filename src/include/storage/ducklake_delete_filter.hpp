@@ -9,12 +9,14 @@
 #pragma once
 
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
+#include "storage/ducklake_delete_bitmap.hpp"
 #include "storage/ducklake_metadata_info.hpp"
 
 namespace duckdb {
+class DuckLakeTransaction;
 
 struct DuckLakeDeleteData {
-	vector<idx_t> deleted_rows;
+	DuckLakeDeleteBitmap deleted_rows;
 
 	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) const;
 };
@@ -27,13 +29,18 @@ public:
 	optional_idx max_row_count;
 
 	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) override;
-	void Initialize(ClientContext &context, const DuckLakeFileData &delete_file);
+	void Initialize(ClientContext &context, DuckLakeTransaction &transaction, const DuckLakeFileData &delete_file);
 	void Initialize(const DuckLakeInlinedDataDeletes &inlined_deletes);
-	void Initialize(ClientContext &context, const DuckLakeDeleteScanEntry &delete_scan);
+	void Initialize(ClientContext &context, DuckLakeTransaction &transaction,
+	                const DuckLakeDeleteScanEntry &delete_scan);
 	void SetMaxRowCount(idx_t max_row_count);
 
 private:
-	static vector<idx_t> ScanDeleteFile(ClientContext &context, const DuckLakeFileData &delete_file);
+	static DuckLakeDeleteBitmap ScanDeleteFile(ClientContext &context, const DuckLakeFileData &delete_file);
+	//! Load the deletes of a delete file - either from the delete file cache, by scanning the delete file or by reading
+	//! the inlined deletes from the metadata catalog
+	static shared_ptr<DuckLakeDeleteData> LoadDeleteFile(ClientContext &context, DuckLakeTransaction &transaction,
+	                                                     const DuckLakeFileData &delete_file);
 };
 
 } // namespace duckdb
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_file_size_advisor.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "common/index.hpp"
+#include <chrono>
+
+namespace duckdb {
+class DuckLakeCatalog;
+struct DuckLakeCompactionTrackerChanges;
+
+//! The size of the data files written to a table
+struct DuckLakeFileSizing {
+	idx_t target_file_size;
+	//! The amount of rows per Parquet row group - or invalid to use the row group size of the Parquet writer
+	optional_idx row_group_size;
+};
+
+//! The DuckLakeFileSizeAdvisor chooses the size of the data files of the tables with the "adaptive_file_size" option
+//! from how the tables are written and read by this process:
+//! * tables that receive less than the target file size per day get files of (about) a day of writes - so compaction
+//!   does not keep rewriting the same growing file
+//! * wide tables get larger files - the overhead of opening a file grows with the number of columns
+//! * tables whose scans read only a small fraction of their files get smaller files and row groups - which can be
+//!   pruned on their statistics more precisely
+//! Sizes are rounded to powers of two, so the target of a table only changes when its workload changes noticeably.
+//! Compaction merges the files of a table up to the same target - so existing files converge towards it.
+class DuckLakeFileSizeAdvisor {
+public:
+	static constexpr const idx_t MIN_TARGET_FILE_SIZE = 1 << 24;
+	static constexpr const idx_t MAX_TARGET_FILE_SIZE = 1 << 30;
+	//! The row group size used for selectively read tables
+	static constexpr const idx_t SELECTIVE_ROW_GROUP_SIZE = 30720;
+	//! Tables with at least this many columns are wide
+	static constexpr const idx_t WIDE_TABLE_COLUMN_COUNT = 64;
+	//! Tables whose scans read at most this fraction of their files (on average) are read selectively
+	static constexpr const double SELECTIVE_READ_FRACTION = 0.25;
+	//! The amount of scans that have to be observed before the read fraction of a table is used
+	static constexpr const idx_t MIN_OBSERVED_SCANS = 4;
+
+public:
+	//! Register a scan of a table that read read_files of the catalog_files data files it was planned with
+	void RecordScan(TableIndex table_id, idx_t catalog_files, idx_t read_files);
+	//! Register the data files written by a committed transaction
+	void RecordWrites(const vector<DuckLakeCompactionTrackerChanges> &changes);
+	//! Get the size of the files written to a table - explicitly configured sizes take precedence over adaptive sizes
+	DuckLakeFileSizing GetFileSizing(const DuckLakeCatalog &catalog, SchemaIndex schema_id, TableIndex table_id,
+	                                 idx_t column_count);
+
+private:
+	struct TableState {
+		idx_t scan_count = 0;
+		//! The (exponentially decaying) average fraction of the data files read by a scan
+		double read_fraction = 1;
+		//! The bytes written to the table since its first observed write
+		idx_t bytes_written = 0;
+		std::chrono::steady_clock::time_point first_write;
+	};
+
+	//! Get the adaptive size of the files of a table
+	DuckLakeFileSizing GetAdaptiveFileSizing(TableIndex table_id, idx_t column_count);
+
+private:
+	mutex lock;
+	//! Map of table index -> observed workload of that table
+	unordered_map<idx_t, TableState> tables;
+};
+
+} // namespace duckdb
@@ -14,8 +14,10 @@
 #include "duckdb/common/index_vector.hpp"
 #include "storage/ducklake_stats.hpp"
 #include "storage/ducklake_metadata_info.hpp"
+#include "storage/ducklake_compaction.hpp"
 
 namespace duckdb {
+class DuckLakeCatalog;
 class DuckLakeTableEntry;
 
 class DuckLakeFlushData : public PhysicalOperator {
@@ -55,4 +57,27 @@ public:
 	string GetName() const override;
 };
 
+//! The DuckLakeParallelFlush flushes the inlined data of a set of tables concurrently
+//! The tables are split into batches - every batch is flushed by a separate connection in a single transaction, so a
+//! catalog-wide flush commits once per batch rather than once per table, and the batches are written in parallel.
+class DuckLakeParallelFlush : public PhysicalOperator {
+public:
+	DuckLakeParallelFlush(PhysicalPlan &physical_plan, const vector<LogicalType> &types, DuckLakeCatalog &catalog,
+	                      vector<vector<DuckLakeCompactionTableTarget>> batches, idx_t max_concurrency);
+
+	DuckLakeCatalog &catalog;
+	vector<vector<DuckLakeCompactionTableTarget>> batches;
+	idx_t max_concurrency;
+
+public:
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+	string GetName() const override;
+};
+
 } // namespace duckdb
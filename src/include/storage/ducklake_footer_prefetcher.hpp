@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_footer_prefetcher.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "storage/ducklake_metadata_info.hpp"
+
+namespace duckdb {
+class ClientContext;
+struct DuckLakePrefetchState;
+
+//! The memory budget shared by the read-ahead of all scans of a catalog - it covers the files that have been read
+//! ahead, until their scan reaches them
+class DuckLakeReadAheadBudget {
+public:
+	//! Reserve memory for reading ahead a file - fails if the reservation would exceed the limit
+	bool TryReserve(idx_t bytes, idx_t limit);
+	void Release(idx_t bytes);
+
+private:
+	mutex lock;
+	idx_t reserved = 0;
+};
+
+//! The DuckLakeFooterPrefetcher fetches the footers of the files that are scanned next in the background
+//! The footer size of a file is recorded in the metadata, so the footer is read with a single ranged read into the
+//! external file cache. The reader that opens the file later finds the footer in the cache instead of having to probe
+//! the file first.
+//! Small files can be read ahead completely instead - the file size is recorded in the metadata as well, so the file
+//! is fetched with a single ranged read and the reader finds its column chunks in the cache.
+//! The files are fetched by tasks on the task scheduler, through the file system of the client context - so the
+//! secrets and settings of the client apply to the prefetch as they do to the scan.
+class DuckLakeFooterPrefetcher {
+public:
+	DuckLakeFooterPrefetcher(ClientContext &context, idx_t max_tasks);
+	~DuckLakeFooterPrefetcher();
+
+	//! Schedule the footer of a file - or the complete file - to be fetched
+	void Prefetch(idx_t file_idx, const DuckLakeFileData &file, bool read_file = false);
+	//! Whether or not the prefetch of the file has finished (i.e. the scan will find the file in the cache)
+	bool IsPrefetched(idx_t file_idx);
+
+private:
+	//! The state is shared with the tasks - which might still be queued when the scan finishes
+	shared_ptr<DuckLakePrefetchState> state;
+};
+
+} // namespace duckdb
@@ -27,6 +27,7 @@ private:
 	void LoadExistingDuckLake(DuckLakeTransaction &transaction);
 	void InitializeDataPath();
 	string GetAttachOptions();
+	void AttachReadReplica(DuckLakeTransaction &transaction);
 	void CheckAndAutoloadedRequiredExtension(const string &pattern);
 
 private:
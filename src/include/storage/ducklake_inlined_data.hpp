@@ -16,7 +16,7 @@ namespace duckdb {
 
 struct DuckLakeInlinedData {
 	unique_ptr<ColumnDataCollection> data;
-	map<FieldIndex, DuckLakeColumnStats> column_stats;
+	DuckLakeColumnStatsMap column_stats;
 };
 
 struct DuckLakeInlinedDataDeletes {
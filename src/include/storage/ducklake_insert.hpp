@@ -12,6 +12,7 @@
 
 #include "duckdb/execution/physical_operator.hpp"
 #include "duckdb/common/index_vector.hpp"
+#include "duckdb/planner/bound_result_modifier.hpp"
 #include "storage/ducklake_stats.hpp"
 #include "common/ducklake_data_file.hpp"
 
@@ -20,6 +21,8 @@ class DuckLakeCatalog;
 class DuckLakeSchemaEntry;
 class DuckLakeTableEntry;
 class DuckLakeFieldData;
+class DuckLakeFieldId;
+class DuckLakeTransaction;
 struct DuckLakePartition;
 struct DuckLakeCopyOptions;
 struct DuckLakeCopyInput;
@@ -30,12 +33,22 @@ class DuckLakeInsertGlobalState : public GlobalSinkState {
 public:
 	explicit DuckLakeInsertGlobalState(DuckLakeTableEntry &table);
 
+	mutex lock;
 	DuckLakeTableEntry &table;
 	vector<DuckLakeDataFile> written_files;
 	idx_t total_insert_count;
+	//! Whether or not to add the rows of the written files to the insert count - this is disabled when the inserted
+	//! rows are buffered, since the written files then contain the rows of previously buffered inserts instead
+	bool count_written_rows = true;
 	case_insensitive_set_t not_null_fields;
 };
 
+class DuckLakeInsertLocalState : public LocalSinkState {
+public:
+	//! The files written by this thread - merged into the global state in Combine
+	vector<DuckLakeDataFile> written_files;
+};
+
 class DuckLakeInsert : public PhysicalOperator {
 public:
 	//! INSERT INTO
@@ -75,27 +88,47 @@ public:
 
 	static DuckLakeColumnStats ParseColumnStats(const LogicalType &type, const vector<Value> &stats);
 	static DuckLakeCopyOptions GetCopyOptions(ClientContext &context, DuckLakeCopyInput &copy_input);
+	//! Get the sort order in which rows are written, as specified by the "sort_partitioned_writes" and "sorted_by"
+	//! options (if any)
+	static vector<BoundOrderByNode> GetSortOrders(ClientContext &context, DuckLakeCopyInput &copy_input);
 	static PhysicalOperator &PlanCopyForInsert(ClientContext &context, PhysicalPlanGenerator &planner,
 	                                           DuckLakeCopyInput &copy_input, optional_ptr<PhysicalOperator> plan);
 	static PhysicalOperator &PlanInsert(ClientContext &context, PhysicalPlanGenerator &planner,
 	                                    DuckLakeTableEntry &table, string encryption_key);
 	static void AddWrittenFiles(DuckLakeInsertGlobalState &gstate, DataChunk &chunk, const string &encryption_key,
 	                            optional_idx partition_id, bool set_snapshot_id = false);
+	//! Parse the files returned by the copy into the result - the global state is only read so this can run in parallel
+	static void AddWrittenFiles(const DuckLakeInsertGlobalState &gstate, vector<DuckLakeDataFile> &result,
+	                            DataChunk &chunk, const string &encryption_key, optional_idx partition_id,
+	                            bool set_snapshot_id = false);
+	//! Compute the Bloom filters of the columns listed in the "bloom_filter_columns" option for a set of written files
+	static void ComputeBloomFilters(ClientContext &context, DuckLakeTableEntry &table,
+	                                vector<DuckLakeDataFile> &written_files);
+	//! Compute the Bloom filters of a set of columns over the values read from a (single file) table expression - in a
+	//! single pass over the file. The values are hashed as the type of the column in the table, which is the type of
+	//! the constants the Bloom filters are probed with
+	static vector<unique_ptr<DuckLakeColumnBloomFilterStats>>
+	ComputeFileBloomFilters(DuckLakeTransaction &transaction, const vector<reference<const DuckLakeFieldId>> &fields,
+	                        const string &source);
+	//! Compute the histograms of the columns listed in the "histogram_columns" option for a set of written files
+	static void ComputeHistograms(ClientContext &context, DuckLakeTableEntry &table,
+	                              vector<DuckLakeDataFile> &written_files);
 
 public:
 	// Sink interface
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
-	// SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
 	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
 	                          OperatorSinkFinalizeInput &input) const override;
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
 
 	bool IsSink() const override {
 		return true;
 	}
 
 	bool ParallelSink() const override {
-		return false;
+		return true;
 	}
 
 	string GetName() const override;
@@ -129,6 +162,8 @@ struct DuckLakeCopyOptions {
 
 	//! Set of projection columns to execute prior to inserting (if any)
 	vector<unique_ptr<Expression>> projection_list;
+	//! The order to sort the rows in prior to inserting (if any) - refers to the columns before the projection
+	vector<BoundOrderByNode> sort_orders;
 };
 
 struct DuckLakeCopyInput {
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_insert_buffer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "common/index.hpp"
+
+#include <chrono>
+#include <condition_variable>
+
+namespace duckdb {
+
+//! The thresholds at which the buffered inserts of a table are written out
+struct DuckLakeInsertBufferLimits {
+	//! Flush once this many rows are buffered (buffering is disabled if this is 0)
+	idx_t row_limit = 0;
+	//! Flush once the buffered rows take up this many bytes (0 = no limit)
+	idx_t size_limit = 0;
+	//! Flush once the oldest buffered row is older than this amount of microseconds (0 = no limit)
+	idx_t flush_interval_us = 0;
+	//! Whether inserts are only acknowledged once their rows have been written by a committed flush
+	bool wait_for_commit = false;
+};
+
+//! Rows taken from the insert buffer of a table
+struct DuckLakeBufferedRows {
+	unique_ptr<ColumnDataCollection> rows;
+	//! The ids of the appends the rows were buffered by
+	vector<idx_t> batch_ids;
+};
+
+//! A table whose buffered rows have exceeded the flush interval of the table
+struct DuckLakeExpiredInsertBuffer {
+	string schema_name;
+	string table_name;
+};
+
+//! The DuckLakeInsertBuffer holds the rows of buffered inserts that have been acknowledged but not yet written
+//! Buffered rows are kept per table, independent of any transaction, and are written to a single data file (and
+//! snapshot) by the insert that makes the buffer exceed one of its limits - or by the background maintenance once the
+//! oldest buffered row exceeds the flush interval of the table.
+//! Every append gets a batch id that remains uncommitted until the rows are written by a committed transaction -
+//! inserts with insert_buffer_ack_mode = 'committed' wait for this before they are acknowledged.
+class DuckLakeInsertBuffer {
+public:
+	//! Add rows to the buffer of a table - returns all buffered rows if the buffer should be flushed
+	//! batch_id is set to the id of this append
+	DuckLakeBufferedRows Append(TableIndex table_id, const string &schema_name, const string &table_name,
+	                            unique_ptr<ColumnDataCollection> rows, const DuckLakeInsertBufferLimits &limits,
+	                            idx_t &batch_id);
+	//! Take all buffered rows of a table (if any)
+	DuckLakeBufferedRows Take(TableIndex table_id);
+	//! Put back rows that were taken from the buffer by a transaction that did not commit
+	void Restore(TableIndex table_id, DuckLakeBufferedRows rows);
+	//! Mark rows taken from the buffer as written by a committed transaction
+	void MarkCommitted(const vector<idx_t> &batch_ids);
+	//! Wait until the rows of an append have been written by a committed transaction
+	void WaitForCommit(idx_t batch_id);
+	//! Release all waiting inserts - inserts whose rows were not written fail
+	void Shutdown();
+	bool HasBufferedRows(TableIndex table_id);
+	bool HasBufferedRows();
+	//! Returns the tables whose oldest buffered row exceeds their flush interval
+	//! next_check_us is set to the time until the buffers should be checked again (if any buffer has a flush interval)
+	vector<DuckLakeExpiredInsertBuffer> GetExpiredBuffers(optional_idx &next_check_us);
+
+private:
+	struct TableBuffer {
+		unique_ptr<ColumnDataCollection> rows;
+		vector<idx_t> batch_ids;
+		std::chrono::steady_clock::time_point first_append;
+		string schema_name;
+		string table_name;
+		idx_t flush_interval_us = 0;
+	};
+
+	static void AddRows(TableBuffer &buffer, DuckLakeBufferedRows rows);
+
+private:
+	mutex lock;
+	std::condition_variable commit_cv;
+	map<TableIndex, TableBuffer> buffers;
+	//! The id of the last append
+	idx_t last_batch_id = 0;
+	//! The appends whose rows have not been written by a committed transaction yet
+	unordered_set<idx_t> uncommitted_batches;
+	bool shutdown = false;
+};
+
+} // namespace duckdb
@@ -0,0 +1,25 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_merge_key_filter_optimizer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+//! The DuckLakeMergeKeyFilterOptimizer collects the range of the join keys of the source of a MERGE INTO while the
+//! join is built, and pushes that range into the scan of the target table as a dynamic filter - so that files of the
+//! target that cannot contain any matching rows are skipped
+class DuckLakeMergeKeyFilterOptimizer : public OptimizerExtension {
+public:
+	DuckLakeMergeKeyFilterOptimizer();
+
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
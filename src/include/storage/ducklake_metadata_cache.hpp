@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_metadata_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/timestamp.hpp"
+#include "common/ducklake_snapshot.hpp"
+#include "storage/ducklake_metadata_info.hpp"
+
+namespace duckdb {
+class FileSystem;
+
+//! The committed file list of a table at a given snapshot
+struct DuckLakeMetadataCacheFileList {
+	TableIndex table_id;
+	idx_t snapshot_id;
+	vector<DuckLakeFileListEntry> files;
+};
+
+//! The DuckLakeMetadataCache is a local on-disk copy of the metadata of a DuckLake
+//! On ATTACH the cache is loaded, after which only the changes made since the cached snapshot are read from the
+//! metadata catalog
+struct DuckLakeMetadataCache {
+	//! The version of the on-disk format - caches written with a different version are ignored
+	//! The cache never contains encryption keys - file lists of tables with encrypted files are not cached
+	static constexpr const idx_t CACHE_VERSION = 4;
+
+	//! The metadata and data path of the DuckLake the cache was created for
+	string metadata_path;
+	string data_path;
+	//! The snapshot at which the catalog was cached
+	DuckLakeSnapshot snapshot;
+	//! The commit time of the snapshot - a DuckLake that is recreated (or restored) can reach the same snapshot ids
+	//! with different contents, but not at the same time
+	timestamp_tz_t snapshot_time = timestamp_tz_t(0);
+	DuckLakeCatalogInfo catalog;
+	//! The snapshot at which the global stats were cached, and its commit time
+	DuckLakeSnapshot stats_snapshot;
+	timestamp_tz_t stats_snapshot_time = timestamp_tz_t(0);
+	vector<DuckLakeGlobalStatsInfo> stats;
+	vector<DuckLakeMetadataCacheFileList> file_lists;
+
+	//! Apply changes loaded through GetCatalogChanges to the cached catalog
+	void ApplyCatalogChanges(const DuckLakeCatalogInfo &changes, const set<TableIndex> &changed_entries,
+	                         DuckLakeSnapshot new_snapshot, timestamp_tz_t new_snapshot_time);
+	//! Apply the reloaded stats of a set of tables to the cached stats
+	void ApplyStatsChanges(const vector<DuckLakeGlobalStatsInfo> &changes, const set<TableIndex> &changed_tables,
+	                       DuckLakeSnapshot new_snapshot, timestamp_tz_t new_snapshot_time);
+
+	//! Write the cache to the specified path
+	void Write(FileSystem &fs, const string &path) const;
+	//! Read the cache from the specified path - returns nullptr if there is no (readable) cache at the path
+	static unique_ptr<DuckLakeMetadataCache> TryRead(FileSystem &fs, const string &path);
+};
+
+} // namespace duckdb
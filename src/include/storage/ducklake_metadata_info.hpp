@@ -151,6 +151,8 @@ struct DuckLakeDeleteFileInfo {
 	idx_t file_size_bytes;
 	idx_t footer_size;
 	string encryption_key;
+	//! The deleted rows of a delete file that is inlined in the metadata catalog (if any)
+	vector<idx_t> inlined_deletes;
 };
 
 struct DuckLakePartitionFieldInfo {
@@ -268,6 +270,8 @@ struct DuckLakeCatalogInfo {
 	vector<DuckLakeTableInfo> tables;
 	vector<DuckLakeViewInfo> views;
 	vector<DuckLakePartitionInfo> partitions;
+	//! Tables of which only the id, schema, uuid, name and path are loaded - the remaining information is loaded lazily
+	vector<DuckLakeTableInfo> lazy_tables;
 };
 
 struct DuckLakeFileData {
@@ -292,6 +296,21 @@ struct DuckLakeFileListEntry {
 	optional_idx snapshot_filter;
 	MappingIndex mapping_id;
 	DuckLakeDataType data_type = DuckLakeDataType::DATA_FILE;
+	//! The data file id - only set for files read from the metadata catalog
+	DataFileIndex file_id;
+	//! The amount of rows in the data file, and the amount of those rows that are deleted - only set for files read
+	//! from the metadata catalog
+	optional_idx row_count;
+	idx_t delete_count = 0;
+};
+
+struct DuckLakeFileListChanges {
+	//! Files that were added or had their delete file changed
+	vector<DuckLakeFileListEntry> new_files;
+	//! Files that were removed or had their delete file changed
+	set<DataFileIndex> removed_files;
+	//! Whether or not the start snapshot has been expired - in which case the changes cannot be computed
+	bool start_snapshot_expired = false;
 };
 
 struct DuckLakeDeleteScanEntry {
@@ -316,6 +335,96 @@ struct DuckLakeFileListExtendedEntry {
 	DuckLakeDataType data_type = DuckLakeDataType::DATA_FILE;
 };
 
+struct DuckLakeFileColumnStatsEntry {
+	FieldIndex column_id;
+	Value min_value;
+	Value max_value;
+	optional_idx null_count;
+	//! Whether or not the column can contain NaN values - true if unknown
+	bool contains_nan = true;
+};
+
+//! The stats of a column of a data file as they are stored in the metadata catalog
+struct DuckLakeFileColumnStatsInfo {
+	DataFileIndex data_file_id;
+	FieldIndex column_id;
+	idx_t column_size_bytes = 0;
+
+	idx_t null_count = 0;
+	bool has_null_count = false;
+
+	string min_val;
+	bool has_min = false;
+
+	string max_val;
+	bool has_max = false;
+
+	bool contains_nan = false;
+	bool has_contains_nan = false;
+
+	string extra_stats;
+	bool has_extra_stats = false;
+};
+
+//! The stats of a data file that are used to answer aggregates without reading the file
+struct DuckLakeFileStatsEntry {
+	DataFileIndex file_id;
+	idx_t row_count;
+	idx_t delete_count = 0;
+	//! Whether or not only part of the file is visible at the snapshot
+	bool is_partial_file = false;
+	vector<DuckLakeFileColumnStatsEntry> column_stats;
+};
+
+//! The range of the values of an identity partition column within a manifest
+struct DuckLakeManifestPartitionSummary {
+	FieldIndex field_id;
+	Value min_value;
+	Value max_value;
+};
+
+//! A manifest holds the file list entries of a group of data files as an immutable Parquet file
+struct DuckLakeManifestInfo {
+	//! The full path of the manifest
+	string path;
+	idx_t file_count = 0;
+	idx_t record_count = 0;
+	//! The partition summaries - only present for columns for which all files in the manifest have a partition value
+	vector<DuckLakeManifestPartitionSummary> partition_summaries;
+};
+
+//! The manifest list of a table - the manifests that together hold the file list of the table at a snapshot
+struct DuckLakeManifestList {
+	//! The table-scoped option under which the directory of the current manifest list is stored
+	static constexpr const char *OPTION_NAME = "manifest_list";
+	//! The file name of the manifest list within its directory
+	static constexpr const char *LIST_FILE_NAME = "manifest_list.parquet";
+
+	//! The directory of the manifest list (relative to the data path of the table), as stored in the option
+	string directory;
+	//! The snapshot at which the file list was written to the manifests
+	idx_t snapshot_id = 0;
+	vector<DuckLakeManifestInfo> manifests;
+};
+
+//! The extra stats (e.g. a Bloom filter) of a column of an existing data file
+struct DuckLakeFileExtraStats {
+	DataFileIndex data_file_id;
+	//! The serialized extra stats - as a SQL literal
+	string extra_stats;
+};
+
+struct DuckLakeArchiveInfo {
+	//! The global option under which the archive snapshot is stored
+	static constexpr const char *OPTION_NAME = "archive_snapshot";
+
+	//! All rows of data and delete files that ended at or before this snapshot are stored in the archive tables
+	idx_t archive_snapshot = 0;
+	//! The amount of data and delete file rows that were moved to the archive
+	idx_t data_file_count = 0;
+	idx_t delete_file_count = 0;
+};
+
 struct DuckLakeCompactionBaseFileData {
 	DataFileIndex id;
 	DuckLakeFileData data;
@@ -331,6 +440,12 @@ struct DuckLakeFileForCleanup {
 	timestamp_tz_t time;
 };
 
+struct DuckLakeTableDirectory {
+	TableIndex table_id;
+	//! The full path of the data directory of the table
+	string path;
+};
+
 struct DuckLakeCompactionFileData : public DuckLakeCompactionBaseFileData {
 	optional_idx row_id_start;
 	MappingIndex mapping_id;
@@ -34,6 +34,21 @@ class FileSystem;
 
 enum class SnapshotBound { LOWER_BOUND, UPPER_BOUND };
 
+//! The version a DuckLake is moved to once it uses archived file rows (ducklake_archive_files) or inlined delete files
+//! Clients that only know version 0.3 cannot read these - they refuse to attach DuckLakes with this version
+static constexpr const char *DUCKLAKE_EXTENDED_VERSION = "0.3-ext1";
+
+//! The rows that are inserted into a table of the metadata catalog
+struct DuckLakeMetadataInsert {
+	DuckLakeMetadataInsert(string table_name, vector<LogicalType> types)
+	    : table_name(std::move(table_name)), types(std::move(types)) {
+	}
+
+	string table_name;
+	vector<LogicalType> types;
+	vector<vector<Value>> rows;
+};
+
 //! The DuckLake metadata manger is the communication layer between the system and the metadata catalog
 class DuckLakeMetadataManager {
 public:
@@ -49,21 +64,65 @@ public:
 	virtual DuckLakeMetadata LoadDuckLake();
 	//! Get the catalog information for a specific snapshot
 	virtual DuckLakeCatalogInfo GetCatalogForSnapshot(DuckLakeSnapshot snapshot);
+	//! Get the schemas at a specific snapshot, and only the tables and views that are either in the changed set or
+	//! that were created after the start snapshot
+	virtual DuckLakeCatalogInfo GetCatalogChanges(DuckLakeSnapshot start_snapshot, DuckLakeSnapshot snapshot,
+	                                              const set<TableIndex> &changed_entries);
+	//! Get the schemas and views at a specific snapshot, and only the names and ids of the tables
+	virtual DuckLakeCatalogInfo GetCatalogListingForSnapshot(DuckLakeSnapshot snapshot);
+	//! Get the full information of the specified tables at a specific snapshot
+	virtual DuckLakeCatalogInfo GetTablesForSnapshot(DuckLakeSnapshot snapshot, const set<TableIndex> &table_ids);
 	virtual vector<DuckLakeGlobalStatsInfo> GetGlobalTableStats(DuckLakeSnapshot snapshot);
+	//! Get the global stats of only the specified tables
+	virtual vector<DuckLakeGlobalStatsInfo> GetGlobalTableStats(DuckLakeSnapshot snapshot,
+	                                                            const set<TableIndex> &table_ids);
 	virtual vector<DuckLakeFileListEntry> GetFilesForTable(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
 	                                                       const string &filter);
+	//! Get (at most) page_size entries of the file list of a table, ordered by data file id - only the files with an id
+	//! above last_file_id (if set) are listed
+	virtual vector<DuckLakeFileListEntry> GetFilesForTablePage(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                                                           const string &filter, optional_idx last_file_id,
+	                                                           idx_t page_size);
+	//! Write the file list of a table at a snapshot to Parquet manifests of (at most) manifest_size files each, grouped
+	//! by their identity partition values - the manifests and their list are written to the given directory
+	virtual DuckLakeManifestList WriteManifests(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                                            const string &directory, idx_t manifest_size);
+	//! Read a manifest list - returns nullptr if the manifest list does not exist (anymore)
+	virtual unique_ptr<DuckLakeManifestList> ReadManifestList(DuckLakeTableEntry &table, const string &directory);
+	//! Read the file list entries of a set of manifests of a table - the (optional) filter is a predicate over the
+	//! file list, as for GetFilesForTable
+	virtual vector<DuckLakeFileListEntry> ReadManifests(DuckLakeTableEntry &table, const DuckLakeManifestList &list,
+	                                                    const vector<idx_t> &manifest_indexes, const string &filter);
+	//! Get the changes made to the file list of a table between two snapshots
+	virtual DuckLakeFileListChanges GetFileListChanges(DuckLakeTableEntry &table, DuckLakeSnapshot start_snapshot,
+	                                                   DuckLakeSnapshot snapshot);
 	virtual vector<DuckLakeFileListEntry> GetTableInsertions(DuckLakeTableEntry &table, DuckLakeSnapshot start_snapshot,
 	                                                         DuckLakeSnapshot snapshot);
 	virtual vector<DuckLakeDeleteScanEntry>
 	GetTableDeletions(DuckLakeTableEntry &table, DuckLakeSnapshot start_snapshot, DuckLakeSnapshot snapshot);
 	virtual vector<DuckLakeFileListExtendedEntry>
 	GetExtendedFilesForTable(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot, const string &filter);
+	//! Get the encryption keys of the given data files of a table - and of their delete files - keyed by file path
+	virtual unordered_map<string, string> GetFileEncryptionKeys(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                                                            const vector<DataFileIndex> &file_ids);
+	//! Get the row counts, delete counts and the stats of the specified columns of all files of a table
+	virtual vector<DuckLakeFileStatsEntry> GetFileStatsForTable(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+	                                                            const vector<FieldIndex> &columns);
+	//! Get the stats of all columns of the given data files of a table
+	virtual vector<DuckLakeFileColumnStatsInfo> GetFileColumnStats(DuckLakeTableEntry &table,
+	                                                               const vector<DataFileIndex> &file_ids);
 	virtual vector<DuckLakeCompactionFileEntry> GetFilesForCompaction(DuckLakeTableEntry &table, CompactionType type,
 	                                                                  double deletion_threshold,
 	                                                                  DuckLakeSnapshot snapshot);
 	virtual idx_t GetCatalogIdForSchema(idx_t schema_id);
 	virtual vector<DuckLakeFileForCleanup> GetOldFilesForCleanup(const string &filter);
-	virtual vector<DuckLakeFileForCleanup> GetOrphanFilesForCleanup(const string &filter, const string &separator);
+	//! Get the files in the data path that are not known to the catalog - if directories are given, only the files in
+	//! these directories are examined
+	virtual vector<DuckLakeFileForCleanup> GetOrphanFilesForCleanup(const string &filter, const string &separator,
+	                                                                const vector<string> &directories);
+	//! Get the data directories of the tables - optionally only of the tables that had files added or removed since the
+	//! given snapshot
+	virtual vector<DuckLakeTableDirectory> GetTableDirectories(optional_idx changed_since_snapshot);
 	virtual vector<DuckLakeFileForCleanup> GetFilesForCleanup(const string &filter, CleanupType type,
 	                                                          const string &separator);
 
@@ -95,6 +154,8 @@ public:
 	virtual void DropDeleteFiles(DuckLakeSnapshot commit_snapshot, const set<DataFileIndex> &dropped_files);
 	virtual void WriteNewDeleteFiles(DuckLakeSnapshot commit_snapshot,
 	                                 const vector<DuckLakeDeleteFileInfo> &new_delete_files);
+	//! Read the deleted rows of a delete file that is inlined in the metadata catalog
+	virtual vector<idx_t> ReadInlinedDeleteFile(DataFileIndex delete_file_id);
 	virtual vector<DuckLakeColumnMappingInfo> GetColumnMappings(optional_idx start_from);
 	virtual void WriteNewColumnMappings(DuckLakeSnapshot commit_snapshot,
 	                                    const vector<DuckLakeColumnMappingInfo> &new_column_mappings);
@@ -106,40 +167,100 @@ public:
 	                                  const DuckLakeSnapshotCommit &commit_info);
 	virtual void UpdateGlobalTableStats(const DuckLakeGlobalStatsInfo &stats);
 	virtual SnapshotChangeInfo GetChangesMadeAfterSnapshot(DuckLakeSnapshot start_snapshot);
+	//! Get the changes made after the snapshot to the given schemas, tables and views - and all changes that refer to
+	//! entries by name - from the snapshot change index
+	//! Returns nullptr if the index does not cover all snapshots made after the snapshot
+	virtual unique_ptr<SnapshotChangeInfo> GetIndexedChangesMadeAfterSnapshot(DuckLakeSnapshot start_snapshot,
+	                                                                          const set<idx_t> &object_ids);
+	//! Get the changes made after the start snapshot up to and including the end snapshot
+	//! Returns nullptr if the changes are not available because snapshots in the range have been expired
+	virtual unique_ptr<SnapshotChangeInfo> GetChangesMadeBetweenSnapshots(DuckLakeSnapshot start_snapshot,
+	                                                                      DuckLakeSnapshot end_snapshot);
 	SnapshotDeletedFromFiles GetFilesDeletedOrDroppedAfterSnapshot(DuckLakeSnapshot start_snapshot);
+	//! Returns the subset of the given data files that no longer exist in the metadata (e.g. because they were merged)
+	set<DataFileIndex> GetRemovedDataFiles(const set<DataFileIndex> &file_ids);
 	virtual unique_ptr<DuckLakeSnapshot> GetSnapshot();
+	//! Get the time at which the given snapshot was committed - returns NULL if the snapshot does not (or no longer)
+	//! exist in the DuckLake
+	virtual Value GetSnapshotTime(DuckLakeSnapshot snapshot);
 	virtual unique_ptr<DuckLakeSnapshot> GetSnapshot(BoundAtClause &at_clause, SnapshotBound bound);
 	virtual idx_t GetNextColumnId(TableIndex table_id);
+	//! Compute a set of aggregates over the rows of an inlined data table that are visible at the snapshot
+	virtual vector<Value> ReadInlinedDataAggregates(DuckLakeSnapshot snapshot, const string &inlined_table_name,
+	                                                const vector<string> &aggregates);
+	//! Read the rows of an inlined data table - the (optional) filter is a SQL predicate over the inlined data table
 	virtual shared_ptr<DuckLakeInlinedData> ReadInlinedData(DuckLakeSnapshot snapshot, const string &inlined_table_name,
-	                                                        const vector<string> &columns_to_read);
+	                                                        const vector<string> &columns_to_read,
+	                                                        const string &filter);
 	virtual shared_ptr<DuckLakeInlinedData> ReadInlinedDataInsertions(DuckLakeSnapshot start_snapshot,
 	                                                                  DuckLakeSnapshot end_snapshot,
 	                                                                  const string &inlined_table_name,
-	                                                                  const vector<string> &columns_to_read);
+	                                                                  const vector<string> &columns_to_read,
+	                                                                  const string &filter);
 	virtual shared_ptr<DuckLakeInlinedData> ReadInlinedDataDeletions(DuckLakeSnapshot start_snapshot,
 	                                                                 DuckLakeSnapshot end_snapshot,
 	                                                                 const string &inlined_table_name,
-	                                                                 const vector<string> &columns_to_read);
+	                                                                 const vector<string> &columns_to_read,
+	                                                                 const string &filter);
 	virtual void DeleteInlinedData(const DuckLakeInlinedTableInfo &inlined_table);
 	virtual void InsertNewSchema(const DuckLakeSnapshot &snapshot);
 
-	virtual vector<DuckLakeSnapshotInfo> GetAllSnapshots(const string &filter = string());
+	virtual vector<DuckLakeSnapshotInfo> GetAllSnapshots(const string &filter = string(),
+	                                                     optional_idx limit = optional_idx());
 	virtual void DeleteSnapshots(const vector<DuckLakeSnapshotInfo> &snapshots);
-	virtual vector<DuckLakeTableSizeInfo> GetTableSizes(DuckLakeSnapshot snapshot);
+	virtual vector<DuckLakeTableSizeInfo> GetTableSizes(DuckLakeSnapshot snapshot, const string &filter = string());
+	//! Move the rows of the data and delete files that ended at or before the archive snapshot to the archive tables
+	virtual DuckLakeArchiveInfo ArchiveFiles(idx_t archive_snapshot);
+	//! Load the archive snapshot from the metadata catalog - the archive might have been moved by other connections
+	idx_t LoadArchiveSnapshot();
+	//! The archive snapshot as seen by this transaction - it is loaded from the metadata catalog on first use
+	idx_t GetArchiveSnapshot();
+	//! The relation holding the rows of a file table (ducklake_data_file or ducklake_delete_file) for a query that only
+	//! needs the current rows and the rows that ended at or after min_end_snapshot - the archive is only included if it
+	//! can contain such rows
+	string GetFileTable(const string &table_name, idx_t min_end_snapshot);
+	//! Get the data files of a table that have stats for a column, but no extra stats (e.g. a Bloom filter) yet
+	virtual vector<DataFileIndex> GetFilesWithoutExtraStats(TableIndex table_id, FieldIndex column_id);
+	//! Add extra stats to the stats of a column of existing data files - the stats of files that already have extra
+	//! stats are left untouched
+	virtual void SetFileExtraStats(TableIndex table_id, FieldIndex column_id,
+	                               const vector<DuckLakeFileExtraStats> &file_stats);
 	virtual void SetConfigOption(const DuckLakeConfigOption &option);
 	virtual string GetPathForSchema(SchemaIndex schema_id);
 	virtual string GetPathForTable(TableIndex table_id);
 
 	virtual void MigrateV01();
 	virtual void MigrateV02(bool allow_failures = false);
+	//! Create the indexes on the metadata tables that are used when planning scans and cleaning up files
+	//! By default no indexes are created - only metadata catalogs that benefit from them create them
+	virtual void CreateMetadataIndexes();
+	//! Whether the metadata catalog has the snapshot change index (ducklake_snapshot_change_index)
+	virtual bool HasSnapshotChangeIndex();
+	//! Get the query that runs a batch of metadata writes - by default the statements are run as a single
+	//! multi-statement query by DuckDB
+	virtual string GetWriteBatchQuery(const vector<string> &statements);
 
 	string LoadPath(string path);
 	string StorePath(string path);
 
 protected:
 	virtual string GetLatestSnapshotQuery() const;
+	//! Insert the rows through the bulk path of the metadata catalog - returns false if there is no bulk path
+	virtual bool TryBulkInsert(const DuckLakeMetadataInsert &insert);
+	//! Append the rows to a DuckDB table through the appender of the metadata connection
+	void AppendRows(const string &catalog_name, const string &schema_name, const string &table_name,
+	                const DuckLakeMetadataInsert &insert);
+	//! Insert rows into a metadata table - inserts of many rows (e.g. the files of a large commit) go through the bulk
+	//! path of the metadata catalog, instead of through an INSERT ... VALUES statement of many megabytes
+	void InsertRows(DuckLakeSnapshot commit_snapshot, const DuckLakeMetadataInsert &insert,
+	                const string &error_prefix);
 
 protected:
+	DuckLakeCatalogInfo LoadCatalogInfo(DuckLakeSnapshot snapshot, const string &table_filter,
+	                                    const string &view_filter, const string &partition_filter);
+	void LoadSchemaInfo(DuckLakeSnapshot snapshot, DuckLakeCatalogInfo &catalog);
+	void LoadViewInfo(DuckLakeSnapshot snapshot, DuckLakeCatalogInfo &catalog, const string &view_filter);
+	vector<DuckLakeGlobalStatsInfo> LoadGlobalTableStats(DuckLakeSnapshot snapshot, const string &table_filter);
 	string GetInlinedTableQuery(const DuckLakeTableInfo &table, const string &table_name);
 	string GetColumnType(const DuckLakeColumnInfo &col);
 	shared_ptr<DuckLakeInlinedData> TransformInlinedData(QueryResult &result);
@@ -164,15 +285,24 @@ private:
 	               const set<T> &dropped_entries);
 	template <class T>
 	DuckLakeFileData ReadDataFile(DuckLakeTableEntry &table, T &row, idx_t &col_idx, bool is_encrypted);
+	//! Convert a page of the file list query into file list entries
+	void ReadFileListPage(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot, QueryResult &result,
+	                      vector<DuckLakeFileListEntry> &files);
 
 	bool IsEncrypted() const;
 	string GetFileSelectList(const string &prefix);
+	//! The query that moves the DuckLake to DUCKLAKE_EXTENDED_VERSION (if it is not there yet)
+	static string GetExtendedVersionQuery();
+	//! Remove the inlined deletes of all inlined delete files matching the given filter
+	void DeleteInlinedDeleteFiles(const string &delete_file_filter);
 
 protected:
 	DuckLakeTransaction &transaction;
 	mutex paths_lock;
 	map<SchemaIndex, string> schema_paths;
 	map<TableIndex, string> table_paths;
+	//! The archive snapshot seen by this transaction (if it has been loaded)
+	optional_idx archive_snapshot;
 };
 
 } // namespace duckdb
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_metadata_stats.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+
+//! The accumulated cost of the queries sent to the metadata catalog for one metadata operation
+struct DuckLakeMetadataOperationStats {
+	//! The latency histogram has buckets for < 100us, < 1ms, < 10ms, < 100ms, < 1s and >= 1s
+	static constexpr const idx_t BUCKET_COUNT = 6;
+
+	idx_t queries = 0;
+	idx_t errors = 0;
+	idx_t rows = 0;
+	idx_t bytes = 0;
+	idx_t total_time_us = 0;
+	idx_t max_time_us = 0;
+	idx_t latency_buckets[BUCKET_COUNT] = {};
+
+	static idx_t GetBucket(idx_t time_us);
+	static const char *GetBucketName(idx_t bucket);
+};
+
+//! Tracks the queries a DuckLake catalog sends to its metadata catalog - keyed by the metadata operation that issued
+//! them (e.g. "GetFilesForTable"), so slow metadata access can be told apart from slow data access
+class DuckLakeMetadataStats {
+public:
+	void Record(const string &operation, idx_t time_us, idx_t rows, idx_t bytes, bool error);
+	map<string, DuckLakeMetadataOperationStats> GetStats() const;
+	void Reset();
+
+	//! The operation that the metadata queries of this thread are currently attributed to
+	static const char *CurrentOperation();
+
+private:
+	mutable mutex lock;
+	map<string, DuckLakeMetadataOperationStats> operations;
+};
+
+//! Attributes the metadata queries issued by this thread to the given operation while it is in scope
+class DuckLakeMetadataOperation {
+public:
+	explicit DuckLakeMetadataOperation(const char *name);
+	~DuckLakeMetadataOperation();
+
+private:
+	const char *previous_operation;
+};
+
+} // namespace duckdb
@@ -9,12 +9,23 @@
 #pragma once
 
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "storage/ducklake_scan.hpp"
 #include "storage/ducklake_transaction.hpp"
 #include "storage/ducklake_metadata_info.hpp"
 #include "storage/ducklake_inlined_data.hpp"
 
 namespace duckdb {
+class DuckLakeColumnZoneMap;
+class DuckLakeFooterPrefetcher;
+class DuckLakeReadAheadBudget;
+struct DynamicFilterData;
+
+//! A filter on a column that is evaluated against the zone map of the column
+struct DuckLakeZoneMapFilter {
+	FieldIndex field_index;
+	unique_ptr<TableFilter> filter;
+};
 
 //! The DuckLakeMultiFileList implements the MultiFileList API to allow injecting it into the regular DuckDB parquet
 //! scan
@@ -28,6 +39,7 @@ public:
 	                      shared_ptr<DuckLakeInlinedData> transaction_local_data, string filter = string());
 	DuckLakeMultiFileList(DuckLakeFunctionInfo &read_info, vector<DuckLakeFileListEntry> files_to_scan);
 	DuckLakeMultiFileList(DuckLakeFunctionInfo &read_info, const DuckLakeInlinedTableInfo &inlined_table);
+	~DuckLakeMultiFileList() override;
 
 	unique_ptr<MultiFileList> ComplexFilterPushdown(ClientContext &context, const MultiFileOptions &options,
 	                                                MultiFilePushdownInfo &info,
@@ -51,15 +63,43 @@ public:
 	const vector<DuckLakeFileListEntry> &GetFiles();
 	const DuckLakeFileListEntry &GetFileEntry(idx_t file_idx);
 
+	//! Visit the files in the order of the stats of a column - ascending by min, or descending by max
+	void SetScanOrder(FieldIndex field_index, bool descending);
+
 	bool IsDeleteScan() const;
 	const DuckLakeDeleteScanEntry &GetDeleteScanEntry(idx_t file_idx);
 
+	//! Serialize the (pruned) file list, including the delete files and name mappings of the files - so the scan can be
+	//! executed elsewhere without reading the file list from the metadata catalog again
+	void Serialize(Serializer &serializer);
+	static unique_ptr<DuckLakeMultiFileList> Deserialize(Deserializer &deserializer, DuckLakeFunctionInfo &read_info);
+	//! Split the file list into (at most) "count" disjoint file lists of roughly equal size that together cover the scan
+	vector<unique_ptr<DuckLakeMultiFileList>> Split(idx_t count);
+
 protected:
 	//! Get the i-th expanded file
 	OpenFileInfo GetFile(idx_t i) override;
 
 private:
+	OpenFileInfo GetFileInfo(idx_t i);
+	//! Throws if the scan reads uncommitted changes of the transaction - these cannot be scanned elsewhere
+	void VerifyCommittedScan();
+	//! Fetch the footers of the (remote) data files that are scanned after the i-th file in the background - small
+	//! files are read ahead completely while the memory budget allows
+	void PrefetchFiles(idx_t i);
 	void GetFilesForTable();
+	//! Remove the files that cannot match the zone map filters from the file list
+	void PruneFilesWithZoneMaps(DuckLakeTransaction &transaction);
+	//! Remove the files whose row id ranges cannot match the row id filter from the file list
+	void PruneFilesWithRowIds();
+	//! Order the data files by the stats of a column - returns the zone map of the column (if any)
+	shared_ptr<DuckLakeColumnZoneMap> OrderFilesByStats(DuckLakeTransaction &transaction, FieldIndex field_index,
+	                                                    bool descending);
+	//! Order the files by the stats of the top-n column, so the scan can stop once the top-n threshold excludes all
+	//! remaining files
+	void OrderFilesForTopN(DuckLakeTransaction &transaction);
+	//! Whether or not a file can contain rows that pass the current top-n threshold
+	bool TopNFileCanMatch(const DuckLakeFileListEntry &file_entry);
 	void GetTableInsertions();
 	void GetTableDeletions();
 
@@ -79,6 +119,30 @@ private:
 	vector<DuckLakeDeleteScanEntry> delete_scans;
 	//! The filter to apply
 	string filter;
+	//! The filters that are evaluated against the (locally cached) zone maps of the columns
+	vector<DuckLakeZoneMapFilter> zone_map_filters;
+	//! The filter on the row id column (if any) - evaluated against the row id ranges of the files
+	unique_ptr<TableFilter> row_id_filter;
+	//! The column by which the files are ordered (if any)
+	FieldIndex scan_order_field;
+	bool scan_order_descending = false;
+	//! The dynamic filter pushed into the scan by a top-n (ORDER BY ... LIMIT) on the table (if any)
+	shared_ptr<DynamicFilterData> top_n_filter;
+	//! The column the top-n filter is on
+	FieldIndex top_n_field;
+	//! The zone map of the top-n column - only set if the files have been ordered by it
+	shared_ptr<DuckLakeColumnZoneMap> top_n_zone_map;
+	mutex prefetch_lock;
+	//! The amount of files ahead of the current file whose footers are prefetched
+	optional_idx prefetch_count;
+	//! The files up to this size are read ahead completely instead of only their footers (0 if disabled)
+	idx_t read_ahead_file_size = 0;
+	//! The files before this index have been handed to the prefetcher
+	idx_t prefetch_end = 0;
+	unique_ptr<DuckLakeFooterPrefetcher> footer_prefetcher;
+	//! The memory reserved for the files that were read ahead - released once the scan reaches them
+	shared_ptr<DuckLakeReadAheadBudget> read_ahead_budget;
+	unordered_map<idx_t, idx_t> read_ahead_reservations;
 };
 
 } // namespace duckdb
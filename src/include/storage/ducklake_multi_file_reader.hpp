@@ -76,12 +76,31 @@ public:
 
 private:
 	shared_ptr<BaseFileReader> TryCreateInlinedDataReader(const OpenFileInfo &file);
+	//! Returns the file info pointing to the local copy of a remote file, or nullptr if the file is not cached
+	unique_ptr<OpenFileInfo> GetCachedFile(const OpenFileInfo &file);
+
+private:
+	//! The global columns mapped through a name map
+	struct DuckLakeMappedColumns {
+		//! The global columns that were mapped
+		optional_ptr<const vector<MultiFileColumnDefinition>> global_columns;
+		shared_ptr<vector<MultiFileColumnDefinition>> columns;
+	};
+
+	//! Get the global columns mapped through the name map of a file - the mapping is shared by all files of the scan
+	//! with the same name map
+	shared_ptr<vector<MultiFileColumnDefinition>>
+	GetMappedColumns(MultiFileReaderData &reader_data, const vector<MultiFileColumnDefinition> &global_columns,
+	                 MappingIndex mapping_id);
 
 private:
 	unique_ptr<MultiFileColumnDefinition> row_id_column;
 	unique_ptr<MultiFileColumnDefinition> snapshot_id_column;
 	//! Inlined transaction-local data
 	shared_ptr<DuckLakeInlinedData> transaction_local_data;
+	mutex mapping_lock;
+	//! Map of mapping id -> the global columns mapped through that name map
+	unordered_map<idx_t, DuckLakeMappedColumns> mapped_column_cache;
 };
 
 } // namespace duckdb
@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_parquet_merge.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+class FileSystem;
+struct DuckLakeParquetMergeSource;
+
+//! The merged file written by a DuckLakeParquetMerge
+struct DuckLakeParquetMergeResult {
+	idx_t row_count = 0;
+	idx_t file_size_bytes = 0;
+	//! The size of the file metadata - excluding its length and the magic bytes that follow it
+	idx_t footer_size = 0;
+};
+
+//! The DuckLakeParquetMerge merges Parquet files with the same schema into a single file without decoding their data
+//! The row groups of the source files - together with their column indexes and Bloom filters - are copied byte for
+//! byte. The footer is rewritten: it lists the row groups of all source files, with the offsets of their column
+//! chunks moved to where the row groups end up in the merged file. The offset indexes hold the positions of the pages
+//! as well - they are rewritten with the moved positions and placed before the footer. The footers are decoded into a
+//! generic representation of the Thrift compact protocol, so every field the files were written with is preserved.
+class DuckLakeParquetMerge {
+public:
+	explicit DuckLakeParquetMerge(FileSystem &fs);
+	~DuckLakeParquetMerge();
+
+	//! Add a file to the merge - returns false if the file cannot be merged with the files that were added before
+	bool AddFile(const string &path, idx_t file_size);
+	//! Write the merged file
+	DuckLakeParquetMergeResult Write(const string &path);
+
+private:
+	FileSystem &fs;
+	vector<unique_ptr<DuckLakeParquetMergeSource>> sources;
+	idx_t row_group_count = 0;
+};
+
+} // namespace duckdb
@@ -15,10 +15,12 @@
 namespace duckdb {
 class BaseStatistics;
 
-enum class DuckLakeTransformType { IDENTITY, YEAR, MONTH, DAY, HOUR };
+enum class DuckLakeTransformType { IDENTITY, YEAR, MONTH, DAY, HOUR, BUCKET, TRUNCATE };
 
 struct DuckLakeTransform {
 	DuckLakeTransformType type;
+	//! The number of buckets (for BUCKET) or the width (for TRUNCATE) of the transform
+	idx_t parameter = 0;
 };
 
 struct DuckLakePartitionField {
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_row_id_index.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "storage/ducklake_metadata_info.hpp"
+
+namespace duckdb {
+class TableFilter;
+
+//! A range of row ids [start, end)
+struct DuckLakeRowIdRange {
+	DuckLakeRowIdRange(idx_t start, idx_t end) : start(start), end(end) {
+	}
+
+	idx_t start;
+	idx_t end;
+};
+
+//! The DuckLakeRowIdIndex is an interval index over the row id ranges [row_id_start, row_id_start + row_count) of the
+//! data files of a table. It maps filters on the row id column to the files that can contain the requested rows,
+//! without opening any of the files. Files whose row ids are not known upfront (i.e. files that store their row ids)
+//! always match.
+class DuckLakeRowIdIndex {
+public:
+	explicit DuckLakeRowIdIndex(const vector<DuckLakeFileListEntry> &files);
+
+	//! Convert a filter on the row id column into the sorted, disjoint set of row id ranges that can match it
+	static vector<DuckLakeRowIdRange> GetRowIdRanges(const TableFilter &filter);
+	//! Whether or not a set of row id ranges covers all row ids - i.e. nothing can be pruned with it
+	static bool IsFullRange(const vector<DuckLakeRowIdRange> &ranges);
+	//! Restrict a set of row id ranges to the rows of a single file, and convert them to file row numbers
+	static vector<DuckLakeRowIdRange> GetFileRowRanges(const vector<DuckLakeRowIdRange> &ranges, idx_t row_id_start,
+	                                                   optional_idx row_count);
+
+	//! Evaluate a set of row id ranges against the files - returns for every file whether or not it can contain any
+	//! of the row ids
+	vector<bool> Evaluate(const vector<DuckLakeRowIdRange> &ranges) const;
+
+private:
+	struct IndexEntry {
+		idx_t start;
+		idx_t end;
+		idx_t file_idx;
+	};
+
+	idx_t file_count;
+	//! The row id ranges of the files, ordered by their start
+	vector<IndexEntry> entries;
+	//! The maximum end of the entries up to (and including) each entry - bounds the search for overlapping files
+	vector<idx_t> max_end;
+	//! The files whose row ids are not known upfront
+	vector<idx_t> unindexed_files;
+};
+
+} // namespace duckdb
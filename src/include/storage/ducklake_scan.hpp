@@ -8,28 +8,68 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "common/ducklake_snapshot.hpp"
 #include "common/index.hpp"
 
 namespace duckdb {
+class DuckLakeFieldId;
 class DuckLakeMultiFileList;
 class DuckLakeTableEntry;
 class DuckLakeTransaction;
+class LogicalGet;
+class LogicalOperator;
+struct ColumnBinding;
 
 class DuckLakeFunctions {
 public:
 	//! Table Functions
 	static TableFunction GetDuckLakeScanFunction(DatabaseInstance &instance);
+	//! The ducklake_scan entry registered in the system catalog - only used to deserialize serialized scans
+	static TableFunction GetDuckLakeScanDeserializeFunction();
+	//! Split a bound ducklake_scan into (at most) "count" self-contained scans that each read a disjoint part of the
+	//! files - every part can be serialized and executed by a different worker
+	static vector<unique_ptr<FunctionData>> SplitScan(const FunctionData &bind_data, idx_t count);
 
 	static unique_ptr<FunctionData> BindDuckLakeScan(ClientContext &context, TableFunction &function);
 
 	static CopyFunctionCatalogEntry &GetCopyFunction(ClientContext &context, const string &name);
+
+	//! Resolve a column (index into the column ids) of a ducklake_scan to the root field id of the column - returns
+	//! nullptr for virtual columns and nested column references
+	static optional_ptr<const DuckLakeFieldId> GetScanColumn(LogicalGet &get, DuckLakeTableEntry &table,
+	                                                         idx_t column_index);
+	//! Follow a column binding down (through projections and filters) to the scan that produces it - returns the index
+	//! of the column in the column ids of the scan
+	static optional_ptr<LogicalGet> FindScanColumn(LogicalOperator &op, const ColumnBinding &binding,
+	                                               idx_t &column_index);
 };
 
 enum class DuckLakeScanType { SCAN_TABLE, SCAN_INSERTIONS, SCAN_DELETIONS };
 
+//! The counters of a scan of a DuckLake table - these are shown in the EXPLAIN ANALYZE output of the scan
+struct DuckLakeScanMetrics {
+	//! The data files returned by the catalog - after the filters that are pushed into the metadata query
+	atomic<idx_t> catalog_files {0};
+	//! The data files pruned on the locally cached zone maps
+	atomic<idx_t> zone_map_pruned_files {0};
+	//! The data files pruned on their row id ranges
+	atomic<idx_t> row_id_pruned_files {0};
+	//! The data files opened by the scan - and their total size
+	atomic<idx_t> data_files_read {0};
+	atomic<idx_t> data_file_bytes {0};
+	atomic<idx_t> delete_files_applied {0};
+	//! The data files whose footer (or contents) had been prefetched by the time the scan opened them
+	atomic<idx_t> prefetched_files {0};
+	//! The inlined data sources read by the scan - and the size of the data fetched from the metadata catalog
+	atomic<idx_t> inlined_data_read {0};
+	atomic<idx_t> inlined_data_bytes {0};
+	//! The time spent reading (and pruning) the file list
+	atomic<idx_t> planning_time_us {0};
+};
+
 struct DuckLakeFunctionInfo : public TableFunctionInfo {
 	DuckLakeFunctionInfo(DuckLakeTableEntry &table, DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot);
 
@@ -43,6 +83,7 @@ struct DuckLakeFunctionInfo : public TableFunctionInfo {
 	DuckLakeScanType scan_type = DuckLakeScanType::SCAN_TABLE;
 	//! Start snapshot - only set for DuckLakeScanType::SCAN_INSERTIONS and DuckLakeScanType::SCAN_DELETIONS
 	unique_ptr<DuckLakeSnapshot> start_snapshot;
+	DuckLakeScanMetrics metrics;
 
 	shared_ptr<DuckLakeTransaction> GetTransaction();
 };
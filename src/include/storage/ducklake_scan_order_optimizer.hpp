@@ -0,0 +1,24 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_scan_order_optimizer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+//! The DuckLakeScanOrderOptimizer makes DuckLake scans below an ORDER BY visit their files in the order of the stats
+//! of the first sort key
+class DuckLakeScanOrderOptimizer : public OptimizerExtension {
+public:
+	DuckLakeScanOrderOptimizer();
+
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
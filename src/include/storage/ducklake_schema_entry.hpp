@@ -55,6 +55,8 @@ public:
 	optional_ptr<CatalogEntry> LookupEntry(CatalogTransaction transaction, const EntryLookupInfo &lookup_info) override;
 
 	void AddEntry(CatalogType type, unique_ptr<CatalogEntry> entry);
+	//! Add a table that is only loaded on first access - the schema set is the catalog set that owns this schema
+	void AddLazyEntry(DuckLakeCatalogSet &schema_set, const string &name, TableIndex id);
 	void TryDropSchema(DuckLakeTransaction &transaction, bool cascade);
 
 	static bool CatalogTypeIsSupported(CatalogType type);
@@ -63,6 +65,10 @@ public:
 
 private:
 	DuckLakeCatalogSet &GetCatalogSet(CatalogType type);
+	//! Load the specified lazily loaded tables of this schema
+	void LoadLazyEntries(DuckLakeTransaction &transaction, const vector<TableIndex> &table_ids);
+	//! Load all lazily loaded tables of this schema
+	void LoadLazyEntries(DuckLakeTransaction &transaction);
 	bool HandleCreateConflict(CatalogTransaction transaction, CatalogType type, const string &name,
 	                          OnCreateConflict on_conflict);
 
@@ -74,6 +80,8 @@ private:
 	string schema_uuid;
 	string data_path;
 	DuckLakeCatalogSet tables;
+	//! The catalog set that owns this schema - only set if the schema has lazily loaded tables
+	optional_ptr<DuckLakeCatalogSet> lazy_schema_set;
 	mutex default_function_lock;
 	case_insensitive_map_t<unique_ptr<CatalogEntry>> default_function_map;
 };
@@ -12,10 +12,13 @@
 #include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/types/value.hpp"
 #include "common/index.hpp"
 
 namespace duckdb {
+struct DuckLakeGlobalStatsInfo;
 class BaseStatistics;
+class TableFilter;
 
 struct DuckLakeColumnExtraStats {
 	virtual ~DuckLakeColumnExtraStats() = default;
@@ -27,6 +30,10 @@ struct DuckLakeColumnExtraStats {
 	virtual string Serialize() const = 0;
 	// Parse the stats from a string
 	virtual void Deserialize(const string &stats) = 0;
+	// Whether or not the stats are merged into the table-wide stats
+	virtual bool IsTableStats() const {
+		return true;
+	}
 
 	template <class TARGET>
 	TARGET &Cast() {
@@ -54,6 +61,77 @@ public:
 	set<string> geo_types;
 };
 
+//! A Bloom filter over the distinct values of a column within a single data file
+struct DuckLakeColumnBloomFilterStats final : public DuckLakeColumnExtraStats {
+	//! The number of bits set per value
+	static constexpr const idx_t HASH_COUNT = 7;
+	//! The number of bits reserved per distinct value (~1% false positive rate)
+	static constexpr const idx_t BITS_PER_VALUE = 10;
+	static constexpr const idx_t MIN_BIT_COUNT = 64;
+	static constexpr const idx_t MAX_BIT_COUNT = 1ULL << 20;
+
+	DuckLakeColumnBloomFilterStats();
+	DuckLakeColumnBloomFilterStats(const LogicalType &type, idx_t distinct_count);
+
+	void Merge(const DuckLakeColumnExtraStats &new_stats) override;
+	unique_ptr<DuckLakeColumnExtraStats> Copy() const override;
+	bool IsTableStats() const override {
+		return false;
+	}
+
+	string Serialize() const override;
+	void Deserialize(const string &stats) override;
+
+	void Insert(hash_t hash);
+	//! Returns false if the value with the given hash is definitely not present
+	bool MayContain(hash_t hash) const;
+
+public:
+	//! The type of the values the hashes were computed for
+	string type;
+	vector<uint64_t> bits;
+};
+
+//! An equi-depth histogram over the values of a column - every bucket holds (roughly) the same amount of rows
+//! Values are represented as DOUBLE: integral types (including dates, timestamps and decimals) by their internal
+//! integer representation. The histograms of files are merged into a table-wide histogram that is used to estimate
+//! the selectivity of range filters.
+struct DuckLakeColumnHistogramStats final : public DuckLakeColumnExtraStats {
+	static constexpr const idx_t BUCKET_COUNT = 32;
+
+	DuckLakeColumnHistogramStats();
+
+	void Merge(const DuckLakeColumnExtraStats &new_stats) override;
+	unique_ptr<DuckLakeColumnExtraStats> Copy() const override;
+
+	string Serialize() const override;
+	void Deserialize(const string &stats) override;
+
+	//! Whether or not histograms can be computed for columns of the given type
+	static bool SupportsType(const LogicalType &type);
+	//! Whether or not the serialized extra stats are a histogram
+	static bool IsHistogram(const string &stats);
+	//! Convert a value of the given type into the representation used by the histogram
+	static bool TryConvert(const LogicalType &type, const Value &value, double &result);
+	//! Build the histogram from the quantiles of a column - "quantiles" are BUCKET_COUNT + 1 evenly spaced quantiles
+	//! (including the min and the max) over "value_count" non-NULL values
+	void Initialize(const vector<double> &quantiles, idx_t value_count);
+	//! The fraction of rows for which a filter evaluates to true - returns false if this cannot be estimated
+	bool TryEstimateSelectivity(const LogicalType &type, const TableFilter &filter, double &result) const;
+
+	idx_t TotalCount() const;
+
+private:
+	//! The amount of rows smaller than (or equal to, if inclusive) the given value
+	double CumulativeCount(double value, bool inclusive) const;
+
+public:
+	//! The bucket boundaries - bucket i holds the values in [bounds[i], bounds[i + 1]]
+	vector<double> bounds;
+	//! The amount of rows per bucket
+	vector<idx_t> counts;
+};
+
 struct DuckLakeColumnStats {
 	explicit DuckLakeColumnStats(LogicalType type_p) : type(std::move(type_p)) {
 		if (DuckLakeTypes::IsGeoType(type)) {
@@ -85,10 +163,73 @@ public:
 	unique_ptr<BaseStatistics> ToStats() const;
 	void MergeStats(const DuckLakeColumnStats &new_stats);
 	DuckLakeColumnStats Copy() const;
+	//! Parse the min/max into the type of the column once - stats that are shared between threads are initialized
+	//! before they are shared, the const methods only read the parsed values and never cache them
+	void InitializeTypedStats();
 
 private:
 	unique_ptr<BaseStatistics> CreateNumericStats() const;
 	unique_ptr<BaseStatistics> CreateStringStats() const;
+	//! Returns the min/max parsed into the type of the column - or a NULL value if the type is compared as text
+	Value GetTypedMin() const;
+	Value GetTypedMax() const;
+
+private:
+	//! The parsed min/max - merging the stats of many files into the same stats then only parses the text of the
+	//! merged-in stats. Only valid if typed_stats_initialized is set.
+	Value typed_min;
+	Value typed_max;
+	bool typed_stats_initialized = false;
+};
+
+//! The stats of the columns of a table or a file, stored contiguously and ordered by field index
+//! Field indexes of a table are dense - lookups go through a direct index from field index to position instead of
+//! through a tree, which keeps merging the stats of many files cheap
+class DuckLakeColumnStatsMap {
+public:
+	using value_type = pair<FieldIndex, DuckLakeColumnStats>;
+	using iterator = vector<value_type>::iterator;
+	using const_iterator = vector<value_type>::const_iterator;
+
+	//! Field indexes above this are looked up through a binary search instead of through the direct index
+	static constexpr const idx_t MAX_DIRECT_INDEX = 1ULL << 16;
+
+public:
+	iterator begin() {
+		return entries.begin();
+	}
+	iterator end() {
+		return entries.end();
+	}
+	const_iterator begin() const {
+		return entries.begin();
+	}
+	const_iterator end() const {
+		return entries.end();
+	}
+	idx_t size() const {
+		return entries.size();
+	}
+	bool empty() const {
+		return entries.empty();
+	}
+	void clear();
+
+	iterator find(FieldIndex field_index);
+	const_iterator find(FieldIndex field_index) const;
+	pair<iterator, bool> insert(value_type entry);
+	pair<iterator, bool> emplace(FieldIndex field_index, DuckLakeColumnStats stats);
+
+private:
+	//! Returns the position of the field index in the entries - or DConstants::INVALID_INDEX if it is not present
+	idx_t GetPosition(FieldIndex field_index) const;
+	//! Update the direct index for all entries starting at the given position
+	void UpdatePositions(idx_t start);
+
+private:
+	vector<value_type> entries;
+	//! The position of every field index below MAX_DIRECT_INDEX in the entries
+	vector<idx_t> positions;
 };
 
 //! These are the global, table-wide stats
@@ -96,13 +237,16 @@ struct DuckLakeTableStats {
 	idx_t record_count = 0;
 	idx_t table_size_bytes = 0;
 	idx_t next_row_id = 0;
-	map<FieldIndex, DuckLakeColumnStats> column_stats;
+	DuckLakeColumnStatsMap column_stats;
 
 	void MergeStats(FieldIndex col_id, const DuckLakeColumnStats &file_stats);
 };
 
 struct DuckLakeStats {
-	map<TableIndex, unique_ptr<DuckLakeTableStats>> table_stats;
+	//! The stats of the individual tables - these are shared with the stats of other snapshots if they are unchanged
+	map<TableIndex, shared_ptr<DuckLakeTableStats>> table_stats;
+	//! The stats of tables that have not been loaded yet - these are converted on first access
+	map<TableIndex, shared_ptr<DuckLakeGlobalStatsInfo>> lazy_table_stats;
 };
 
 } // namespace duckdb
@@ -143,6 +143,8 @@ public:
 	                   unique_ptr<ColumnChangeInfo> changed_fields, shared_ptr<DuckLakeFieldData> new_field_data);
 	// ! Create a DuckLakeTableEntry from a SET PARTITION KEY
 	DuckLakeTableEntry(DuckLakeTableEntry &parent, CreateTableInfo &info, unique_ptr<DuckLakePartition> partition_data);
+	// ! Create a copy of a committed DuckLakeTableEntry in a different schema entry
+	DuckLakeTableEntry(DuckLakeTableEntry &parent, SchemaCatalogEntry &schema, CreateTableInfo &info);
 
 private:
 	TableIndex table_id;
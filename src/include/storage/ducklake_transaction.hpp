@@ -16,8 +16,11 @@
 #include "duckdb/transaction/transaction.hpp"
 #include "storage/ducklake_catalog_set.hpp"
 #include "storage/ducklake_inlined_data.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
 #include "storage/ducklake_metadata_manager.hpp"
 
+#include <chrono>
+
 namespace duckdb {
 class DuckLakeCatalog;
 class DuckLakeCatalogSet;
@@ -26,6 +29,7 @@ class DuckLakeSchemaEntry;
 class DuckLakeTableEntry;
 class DuckLakeViewEntry;
 struct DuckLakeNewGlobalStats;
+struct DuckLakeStats;
 struct DuckLakeTableStats;
 struct SnapshotChangeInformation;
 struct TransactionChangeInformation;
@@ -35,6 +39,10 @@ struct NewNameMapInfo;
 struct CompactionInformation;
 struct DuckLakePath;
 struct DuckLakeCommitState;
+struct DuckLakeCommitTimings;
+struct DuckLakePreparedCommit;
+struct DuckLakeCommittedTableChanges;
+struct DuckLakeCompactionTrackerChanges;
 
 struct LocalTableDataChanges {
 	vector<DuckLakeDataFile> new_data_files;
@@ -42,9 +50,26 @@ struct LocalTableDataChanges {
 	unordered_map<string, DuckLakeDeleteFile> new_delete_files;
 	unordered_map<string, unique_ptr<DuckLakeInlinedDataDeletes>> new_inlined_data_deletes;
 	vector<DuckLakeCompactionEntry> compactions;
+	//! Guards the changes of this table - so that pipelines writing to (or scanning) different tables within the same
+	//! transaction do not contend with each other
+	mutable mutex lock;
 	bool IsEmpty() const;
 };
 
+//! Routes the metadata queries issued by this thread to the given attached database (e.g. a read replica of the
+//! metadata catalog) instead of the metadata catalog while it is in scope
+class DuckLakeMetadataReadScope {
+public:
+	explicit DuckLakeMetadataReadScope(const string &database_name);
+	~DuckLakeMetadataReadScope();
+
+	//! The database the metadata queries of this thread are currently routed to - or nullptr if there is none
+	static optional_ptr<const string> CurrentDatabase();
+
+private:
+	optional_ptr<const string> previous_database;
+};
+
 class DuckLakeTransaction : public Transaction, public enable_shared_from_this<DuckLakeTransaction> {
 public:
 	DuckLakeTransaction(DuckLakeCatalog &ducklake_catalog, TransactionManager &manager, ClientContext &context);
@@ -54,6 +79,14 @@ public:
 	virtual void Start();
 	virtual void Commit();
 	virtual void Rollback();
+	//! Whether or not the changes of this transaction can be committed as part of the commit of another transaction
+	//! This is the case if the transaction only appends data files to existing tables
+	bool CanGroupCommit();
+	//! Take over the data files appended by another transaction - they are committed in the snapshot of this
+	//! transaction, after which the other transaction can commit without any changes
+	void AddGroupCommit(DuckLakeTransaction &other);
+	//! Rewrite the files of the copy-on-write tables updated by this transaction - called after the commit
+	void RewriteCopyOnWriteTables();
 
 	DuckLakeCatalog &GetCatalog() {
 		return ducklake_catalog;
@@ -63,11 +96,32 @@ public:
 	}
 	unique_ptr<QueryResult> Query(DuckLakeSnapshot snapshot, string query);
 	unique_ptr<QueryResult> Query(string query);
+	//! Run a query through a prepared statement that is cached on the metadata connection, keyed by the query text
+	//! Parameters are referenced as $1, $2, ... in the query
+	unique_ptr<QueryResult> PreparedQuery(string query, vector<Value> parameters = vector<Value>());
+	//! Same as above, but binds {SNAPSHOT_ID} as an additional (last) parameter instead of substituting it
+	unique_ptr<QueryResult> PreparedQuery(DuckLakeSnapshot snapshot, string query,
+	                                      vector<Value> parameters = vector<Value>());
+	//! Execute a metadata write. While a write batch is active (during commit) the write is buffered, and all buffered
+	//! writes are issued as a single multi-statement query before the next read or at commit. The metadata manager
+	//! decides how the batch is sent (see DuckLakeMetadataManager::GetWriteBatchQuery)
+	void ExecuteWrite(DuckLakeSnapshot snapshot, string query, const string &error_prefix);
+	void ExecuteWrite(string query, const string &error_prefix);
+	//! Send the buffered metadata writes (if any) to the metadata catalog
+	void FlushWriteBatch();
+	//! Whether or not metadata writes are currently being batched (i.e. the transaction is committing)
+	bool IsBatchingWrites() const {
+		return batch_writes;
+	}
 	Connection &GetConnection();
 
 	DuckLakeSnapshot GetSnapshot();
 	DuckLakeSnapshot GetSnapshot(optional_ptr<BoundAtClause> at_clause,
 	                             SnapshotBound bound = SnapshotBound::UPPER_BOUND);
+	//! Keep a cached schema or stats version alive (and prevent eviction from the catalog caches) until the
+	//! transaction ends
+	void PinSchema(idx_t schema_version, shared_ptr<DuckLakeCatalogSet> schema);
+	void PinStats(idx_t next_file_id, shared_ptr<DuckLakeStats> stats);
 
 	static DuckLakeTransaction &Get(ClientContext &context, Catalog &catalog);
 
@@ -119,6 +173,8 @@ public:
 		return id >= DuckLakeConstants::TRANSACTION_LOCAL_ID_START;
 	}
 	void SetConfigOption(const DuckLakeConfigOption &option);
+	//! Write a config option to the metadata - the option is only set in the catalog once the transaction commits
+	void SetConfigOptionOnCommit(const DuckLakeConfigOption &option);
 
 	void SetCommitMessage(const DuckLakeSnapshotCommit &option);
 
@@ -126,7 +182,13 @@ public:
 
 	bool HasLocalDeletes(TableIndex table_id);
 	void GetLocalDeleteForFile(TableIndex table_id, const string &path, DuckLakeFileData &delete_file);
+	//! Find the transaction-local inlined deletes referred to by the given inlined delete path
+	optional_ptr<const DuckLakeDeleteFile> GetLocalInlinedDeletes(const string &file_name);
 	void TransactionLocalDelete(TableIndex table_id, const string &data_path, DuckLakeDeleteFile delete_file);
+	//! Register an update of a table with update_mode = copy_on_write - its files are rewritten after the commit
+	void AddCopyOnWriteUpdate(TableIndex table_id);
+	//! Take ownership of rows taken from the insert buffer - they are put back into the buffer if we do not commit
+	optional_ptr<ColumnDataCollection> AddFlushedInsertBuffer(TableIndex table_id, DuckLakeBufferedRows rows);
 
 	bool HasDroppedFiles() const;
 	bool FileIsDropped(const string &path) const;
@@ -155,7 +217,29 @@ protected:
 
 private:
 	void CleanupFiles();
+	string ReplaceCatalogPlaceholders(string query);
+	string ReplaceSnapshotPlaceholders(DuckLakeSnapshot snapshot, string query);
+	void BeginWriteBatch();
+	void EndWriteBatch();
+	void DiscardWriteBatch();
+	void ClearPreparedStatements();
+	//! Record the latency and result size of a query sent to the metadata catalog
+	void RecordMetadataQuery(const char *operation, std::chrono::steady_clock::time_point start, QueryResult &result);
+	//! Simulate the round trip latency of a remote metadata catalog (if configured)
+	void AddMetadataLatency();
+	//! Record the time spent in the phases of a commit that started at the given time
+	void RecordCommitTimings(DuckLakeCommitTimings &timings, std::chrono::steady_clock::time_point start);
+	//! Load the latest snapshot from the metadata catalog
+	unique_ptr<DuckLakeSnapshot> LoadLatestSnapshot();
+	//! Release the metadata connection back to the connection pool of the catalog
+	void ReleaseConnection();
 	void FlushChanges();
+	//! Collect the changes this transaction makes to tables that are maintained in the background
+	vector<DuckLakeCommittedTableChanges> GetCommittedTableChanges();
+	//! Collect the changes this transaction made to the files of tables - for the compaction tracker of the catalog
+	vector<DuckLakeCompactionTrackerChanges> GetCompactionTrackerChanges();
+	//! Generate the rewrites of the files of the copy-on-write tables this transaction writes delete files for
+	vector<string> GetCopyOnWriteRewrites();
 	void FlushSettingChanges();
 	void CommitChanges(DuckLakeCommitState &commit_state, TransactionChangeInformation &transaction_changes);
 	void CommitCompaction(DuckLakeSnapshot &commit_snapshot, TransactionChangeInformation &transaction_changes);
@@ -168,7 +252,10 @@ private:
 	DuckLakeViewInfo GetNewView(DuckLakeCommitState &commit_state, DuckLakeViewEntry &view);
 	void FlushNewPartitionKey(DuckLakeSnapshot &commit_snapshot, DuckLakeTableEntry &table);
 	DuckLakeFileInfo GetNewDataFile(DuckLakeDataFile &file, DuckLakeSnapshot &commit_snapshot, TableIndex table_id,
-	                                optional_idx row_id_start);
+	                                optional_idx row_id_start,
+	                                optional_ptr<const vector<DuckLakeColumnStatsInfo>> column_stats = nullptr);
+	//! Compute the parts of the commit that do not depend on the commit snapshot - these are re-used across retries
+	void PrepareCommit();
 	NewDataInfo GetNewDataFiles(DuckLakeCommitState &commit_state);
 	vector<DuckLakeDeleteFileInfo> GetNewDeleteFiles(const DuckLakeCommitState &commit_state,
 	                                                 set<DataFileIndex> &overwritten_delete_files) const;
@@ -191,6 +278,11 @@ private:
 	void AlterEntryInternal(DuckLakeViewEntry &old_entry, unique_ptr<CatalogEntry> new_entry);
 	void AddTableChanges(TableIndex table_id, const LocalTableDataChanges &table_changes,
 	                     TransactionChangeInformation &changes);
+	//! Returns the transaction-local changes of a table - creating them if they do not exist yet
+	LocalTableDataChanges &GetOrCreateTableChanges(TableIndex table_id);
+	//! Returns the transaction-local changes of a table - or nullptr if there are none
+	optional_ptr<LocalTableDataChanges> TryGetTableChanges(TableIndex table_id);
+	optional_ptr<const LocalTableDataChanges> TryGetTableChanges(TableIndex table_id) const;
 
 private:
 	DuckLakeCatalog &ducklake_catalog;
@@ -199,6 +291,15 @@ private:
 	unique_ptr<DuckLakeMetadataManager> metadata_manager;
 	mutex connection_lock;
 	unique_ptr<Connection> connection;
+	//! Prepared statements on the metadata connection, keyed by query text
+	mutex prepared_statement_lock;
+	unordered_map<string, unique_ptr<PreparedStatement>> prepared_statements;
+	//! Whether or not metadata writes are currently being batched
+	bool batch_writes = false;
+	//! The buffered metadata writes
+	vector<string> write_batch;
+	//! The latency that is added to every round trip to the metadata catalog (ducklake_metadata_latency_ms)
+	idx_t metadata_latency_ms = 0;
 	//! The snapshot of the transaction (latest snapshot in DuckLake)
 	mutex snapshot_lock;
 	unique_ptr<DuckLakeSnapshot> snapshot;
@@ -214,13 +315,30 @@ private:
 	//! Schemas added by this transaction
 	unique_ptr<DuckLakeCatalogSet> new_schemas;
 	map<SchemaIndex, reference<DuckLakeSchemaEntry>> dropped_schemas;
-	//! Local changes made to tables
-	mutex table_data_changes_lock;
+	//! Local changes made to tables - the lock only guards the map, the changes of every table have their own lock
+	mutable mutex table_data_changes_lock;
 	map<TableIndex, LocalTableDataChanges> table_data_changes;
+	//! Rows taken from the insert buffer that are written (or discarded) by this transaction
+	vector<pair<TableIndex, DuckLakeBufferedRows>> flushed_insert_buffers;
+	//! Tables with update_mode = copy_on_write that were updated by this transaction
+	set<TableIndex> copy_on_write_tables;
+	//! The rewrites of the copy-on-write tables that are queued once the transaction has committed
+	vector<string> copy_on_write_rewrites;
+	//! The snapshot-independent parts of the commit - computed once at the start of the commit
+	unique_ptr<DuckLakePreparedCommit> prepared_commit;
+	//! Cached schema and stats versions used by this transaction
+	mutex pinned_cache_lock;
+	unordered_map<idx_t, shared_ptr<DuckLakeCatalogSet>> pinned_schemas;
+	unordered_map<idx_t, shared_ptr<DuckLakeStats>> pinned_stats;
 	//! Snapshot cache for the AT (...) conditions that are referenced in the transaction
 	value_map_t<DuckLakeSnapshot> snapshot_cache;
 	//! New set of transaction-local name maps
 	DuckLakeNameMapSet new_name_maps;
+	//! Config options that are set in the catalog once the transaction has committed
+	vector<DuckLakeConfigOption> commit_config_options;
+	//! The snapshots of the transactions whose data files were taken over by this transaction, together with the
+	//! tables they inserted into - used to check their inserts for conflicts
+	vector<pair<DuckLakeSnapshot, set<TableIndex>>> grouped_transactions;
 
 	atomic<idx_t> catalog_version;
 };
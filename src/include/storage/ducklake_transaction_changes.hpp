@@ -16,6 +16,16 @@
 
 namespace duckdb {
 
+//! A single change made by a snapshot
+struct SnapshotChangeEntry {
+	//! The type of the change (e.g. "inserted_into_table")
+	string change_type;
+	//! The value of the change - the (quoted) name or the id of the entry that was changed
+	string change_value;
+	//! The id of the schema, table or view that was changed - invalid for changes that refer to an entry by name
+	optional_idx object_id;
+};
+
 struct SnapshotChangeInformation {
 	case_insensitive_set_t created_schemas;
 	set<SchemaIndex> dropped_schemas;
@@ -31,6 +41,8 @@ struct SnapshotChangeInformation {
 	set<TableIndex> tables_deleted_inlined;
 	set<TableIndex> tables_flushed_inlined;
 	static SnapshotChangeInformation ParseChangesMade(const string &changes_made);
+	//! Split the changes made by a snapshot into the individual changes
+	static vector<SnapshotChangeEntry> SplitChangesMade(const string &changes_made);
 };
 
 } // namespace duckdb
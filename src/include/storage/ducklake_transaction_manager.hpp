@@ -12,8 +12,20 @@
 #include "storage/ducklake_transaction.hpp"
 #include "storage/ducklake_catalog.hpp"
 
+#include <condition_variable>
+
 namespace duckdb {
 
+//! A group of transactions that are committed together in a single snapshot by the first of them (the leader)
+struct DuckLakeCommitGroup {
+	//! The transactions whose data files are committed by the leader
+	vector<reference<DuckLakeTransaction>> transactions;
+	//! Whether or not the leader has finished committing
+	bool finished = false;
+	//! The result of the commit
+	ErrorData error;
+};
+
 class DuckLakeTransactionManager : public TransactionManager {
 public:
 	DuckLakeTransactionManager(AttachedDatabase &db_p, DuckLakeCatalog &ducklake_catalog);
@@ -24,11 +36,22 @@ public:
 
 	void Checkpoint(ClientContext &context, bool force = false) override;
 
+private:
+	void CommitInternal(ClientContext &context, DuckLakeTransaction &transaction);
+	//! Commit the transaction as part of a commit group (see ducklake_group_commit_window_ms)
+	void GroupCommit(ClientContext &context, DuckLakeTransaction &transaction, idx_t window_ms);
+
 private:
 	DuckLakeCatalog &ducklake_catalog;
 	mutex transaction_lock;
 	reference_map_t<Transaction, shared_ptr<DuckLakeTransaction>> transactions;
 	bool get_snapshot = true;
+	//! Lock held while committing if ducklake_serialize_commits is enabled
+	mutex commit_lock;
+	//! The commit group that transactions can still join - if any
+	mutex group_commit_lock;
+	std::condition_variable group_commit_cv;
+	shared_ptr<DuckLakeCommitGroup> open_commit_group;
 };
 
 } // namespace duckdb
@@ -56,17 +56,26 @@ public:
 public:
 	// ALTER VIEW
 	DuckLakeViewEntry(DuckLakeViewEntry &parent, CreateViewInfo &info, LocalChange local_change);
+	// Copy a committed view entry into a different schema entry
+	DuckLakeViewEntry(DuckLakeViewEntry &parent, SchemaCatalogEntry &schema, CreateViewInfo &info);
 
 private:
 	unique_ptr<SelectStatement> ParseSelectStatement() const;
+	//! Get the parsed query of the view - the query is parsed on first use
+	shared_ptr<SelectStatement> GetParsedQuery() const;
+	//! Share the parsed query of an entry of this view with the same definition (if it has been parsed)
+	void ShareParsedQuery(const DuckLakeViewEntry &other);
 
 private:
-	mutex parse_lock;
+	mutable mutex parse_lock;
 	TableIndex view_id;
 	string view_uuid;
 	string query_sql;
 	LocalChange local_change;
 	bool is_bound = false;
+	//! The parsed query - shared by the entries of this view in every schema version (and transaction) that has the
+	//! same definition, so an unchanged view is only parsed once. Planning only reads it, since the binder copies it.
+	mutable shared_ptr<SelectStatement> parsed_query;
 };
 
 } // namespace duckdb
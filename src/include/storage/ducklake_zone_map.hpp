@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/ducklake_zone_map.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/index.hpp"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+class TableFilter;
+class Value;
+
+//! The DuckLakeColumnZoneMap holds the per-file min/max stats of a single column in typed, columnar form
+//! This allows filters to be evaluated against the stats of all files of a table locally, without a round trip to the
+//! metadata catalog. Integral types (including dates, timestamps and decimals) are stored as BIGINT, floating point
+//! types as DOUBLE.
+class DuckLakeColumnZoneMap {
+public:
+	explicit DuckLakeColumnZoneMap(LogicalType type);
+
+	//! Whether or not zone maps can be built for columns of the given type
+	static bool SupportsType(const LogicalType &type);
+
+	const LogicalType &GetType() const {
+		return type;
+	}
+	//! The data file id up to which (exclusive) the stats of all files have been added
+	idx_t GetLoadedFileId();
+	//! Add the stats of a set of files - the values are (data_file_id, min_value, max_value, null_count, value_count,
+	//! contains_nan)
+	void AddFiles(const vector<vector<Value>> &file_stats, idx_t loaded_file_id);
+	//! Evaluate a filter against the stats of the given files - returns for every file whether or not it can contain
+	//! rows that match the filter
+	vector<bool> Evaluate(const TableFilter &filter, const vector<DataFileIndex> &file_ids);
+	//! Order files by their stats - ascending by min for an ascending order, or descending by max for a descending
+	//! order. Files for which the order cannot be determined from the stats come first. Returns the new order of the
+	//! files as indexes into file_ids.
+	vector<idx_t> OrderFiles(const vector<DataFileIndex> &file_ids, bool descending);
+	//! Whether or not a file can contain rows that match a comparison with a constant
+	bool FileCanMatch(DataFileIndex file_id, ExpressionType comparison_type, const Value &constant);
+
+private:
+	void EvaluateFilter(const TableFilter &filter, vector<uint8_t> &result) const;
+	void EvaluateComparison(ExpressionType comparison_type, const Value &constant, vector<uint8_t> &result) const;
+	template <class T>
+	void EvaluateComparison(ExpressionType comparison_type, T constant, const vector<T> &min_values,
+	                        const vector<T> &max_values, vector<uint8_t> &result) const;
+	bool TryConvert(const Value &value, int64_t &result) const;
+
+private:
+	mutex lock;
+	LogicalType type;
+	bool is_floating_point;
+	idx_t loaded_file_id = 0;
+	//! Map of data file id -> offset in the stats arrays
+	unordered_map<idx_t, idx_t> file_offsets;
+	vector<int64_t> int_min;
+	vector<int64_t> int_max;
+	vector<double> double_min;
+	vector<double> double_max;
+	//! Whether or not the min/max of a file are known
+	vector<uint8_t> has_min_max;
+	//! The null count and value count of a file (or -1 if unknown)
+	vector<int64_t> null_count;
+	vector<int64_t> value_count;
+	//! Whether or not a file can contain NaN values
+	vector<uint8_t> contains_nan;
+};
+
+} // namespace duckdb
@@ -1,5 +1,10 @@
 #include "metadata_manager/postgres_metadata_manager.hpp"
 
+#include "common/ducklake_util.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_stats.hpp"
+#include "storage/ducklake_transaction.hpp"
+
 namespace duckdb {
 
 PostgresMetadataManager::PostgresMetadataManager(DuckLakeTransaction &transaction)
@@ -16,4 +21,229 @@ string PostgresMetadataManager::GetLatestSnapshotQuery() const {
 	)";
 }
 
+void PostgresMetadataManager::CreateMetadataIndexes() {
+	DuckLakeMetadataOperation metadata_operation("CreateMetadataIndexes");
+	struct DuckLakeMetadataIndex {
+		const char *name;
+		const char *table;
+		const char *columns;
+	};
+	// the file and stats tables are filtered on table id and snapshot range when planning scans, and the snapshot
+	// change index on snapshot range when checking for conflicts
+	// without these indexes these filters turn into sequential scans over the entire history of the DuckLake
+	static const DuckLakeMetadataIndex METADATA_INDEXES[] = {
+	    {"ducklake_data_file_table_idx", "ducklake_data_file", "table_id, begin_snapshot, end_snapshot"},
+	    {"ducklake_delete_file_table_idx", "ducklake_delete_file", "table_id, begin_snapshot, end_snapshot"},
+	    {"ducklake_delete_file_data_file_idx", "ducklake_delete_file", "data_file_id"},
+	    {"ducklake_file_column_stats_table_idx", "ducklake_file_column_stats", "table_id, column_id, data_file_id"},
+	    {"ducklake_file_partition_value_table_idx", "ducklake_file_partition_value", "table_id, data_file_id"},
+	    {"ducklake_snapshot_change_index_idx", "ducklake_snapshot_change_index", "snapshot_id, object_id"}};
+	// CREATE INDEX locks the table against writes even if the index already exists - look up which indexes and
+	// tables exist first, so that attaching a DuckLake that already has all indexes does not block other writers
+	auto schema_literal =
+	    StringUtil::Replace(DuckLakeUtil::SQLLiteralToString(transaction.GetCatalog().MetadataSchemaName()), "'", "''");
+	auto existing_query = StringUtil::Format(R"(
+	SELECT * FROM postgres_query({METADATA_CATALOG_NAME_LITERAL},
+		'SELECT indexname FROM pg_indexes WHERE schemaname = %s
+		 UNION ALL
+		 SELECT tablename FROM pg_tables WHERE schemaname = %s')
+	)",
+	                                         schema_literal, schema_literal);
+	auto result = transaction.Query(existing_query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to load metadata indexes for DuckLake: ");
+	}
+	unordered_set<string> existing_objects;
+	for (auto &row : *result) {
+		existing_objects.insert(row.GetValue<string>(0));
+	}
+	string create_indexes;
+	for (auto &index : METADATA_INDEXES) {
+		if (existing_objects.count(index.name) > 0) {
+			continue;
+		}
+		if (existing_objects.count(index.table) == 0) {
+			// the table does not exist in this DuckLake (e.g. the snapshot change index of an old v0.3 DuckLake)
+			continue;
+		}
+		create_indexes += StringUtil::Format("CREATE INDEX IF NOT EXISTS %s ON {METADATA_SCHEMA_ESCAPED}.%s (%s);",
+		                                     index.name, index.table, index.columns);
+	}
+	if (create_indexes.empty()) {
+		return;
+	}
+	result = transaction.Query("CALL postgres_execute({METADATA_CATALOG_NAME_LITERAL}, '" + create_indexes + "')");
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to create metadata indexes for DuckLake: ");
+	}
+}
+
+bool PostgresMetadataManager::TryBulkInsert(const DuckLakeMetadataInsert &insert) {
+	// stage the rows in a temporary DuckDB table - the postgres extension inserts them from there through a binary
+	// COPY, instead of Postgres having to parse an INSERT statement containing all rows
+	auto staging_table = DuckLakeUtil::SQLIdentifierToString("__ducklake_bulk_insert_" + insert.table_name);
+	string columns;
+	for (idx_t col_idx = 0; col_idx < insert.types.size(); col_idx++) {
+		if (!columns.empty()) {
+			columns += ", ";
+		}
+		columns += StringUtil::Format("c%d %s", col_idx, insert.types[col_idx].ToString());
+	}
+	auto result = transaction.Query(
+	    StringUtil::Format("CREATE OR REPLACE TEMPORARY TABLE temp.main.%s(%s)", staging_table, columns));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to stage metadata rows for a bulk insert: ");
+	}
+	AppendRows("temp", "main", "__ducklake_bulk_insert_" + insert.table_name, insert);
+	result = transaction.Query(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.%s SELECT * FROM temp.main.%s",
+	                                              insert.table_name, staging_table));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw();
+	}
+	result = transaction.Query(StringUtil::Format("DROP TABLE temp.main.%s", staging_table));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to drop the staged metadata rows of a bulk insert: ");
+	}
+	return true;
+}
+
+bool PostgresMetadataManager::CanReadFromReplica(DuckLakeSnapshot snapshot) {
+	auto &catalog = transaction.GetCatalog();
+	auto &replica_name = catalog.MetadataReplicaDatabaseName();
+	if (replica_name.empty() || transaction.IsBatchingWrites()) {
+		// no replica - or we are committing, in which case the reads must observe the writes of this transaction
+		return false;
+	}
+	if (snapshot.snapshot_id < GetArchiveSnapshot()) {
+		// the snapshot needs the archive tables - which the replica might not have received yet
+		return false;
+	}
+	// the metadata of committed snapshots is not immutable: compaction and expiring snapshots remove (and replace)
+	// file rows of snapshots that already exist. A replica that contains the snapshot might still return the files of
+	// before a later compaction - which might be deleted already. The replica is only used if it has caught up to the
+	// latest snapshot seen by this transaction, in which case it has seen the same rewrites as the primary
+	auto required_snapshot = MaxValue<idx_t>(snapshot.snapshot_id, transaction.GetSnapshot().snapshot_id);
+	auto last_committed_snapshot = catalog.GetLastCommittedSnapshotId();
+	if (!last_committed_snapshot.IsNull()) {
+		required_snapshot = MaxValue<idx_t>(required_snapshot, last_committed_snapshot.GetValue<idx_t>());
+	}
+	if (catalog.ReplicaHasSnapshot(required_snapshot)) {
+		return true;
+	}
+	// the replica might have caught up since we last checked
+	DuckLakeMetadataOperation metadata_operation("GetReplicaSnapshot");
+	DuckLakeMetadataReadScope replica_scope(replica_name);
+	auto result = transaction.Query(R"(
+	SELECT * FROM postgres_query({METADATA_CATALOG_NAME_LITERAL},
+		'SELECT MAX(snapshot_id) FROM {METADATA_SCHEMA_ESCAPED}.ducklake_snapshot')
+	)");
+	if (result->HasError()) {
+		// the replica is unavailable - fall back to the primary
+		return false;
+	}
+	auto chunk = result->Fetch();
+	if (!chunk || chunk->size() == 0) {
+		return false;
+	}
+	auto replica_snapshot = chunk->GetValue(0, 0);
+	if (replica_snapshot.IsNull()) {
+		return false;
+	}
+	catalog.SetReplicaSnapshot(replica_snapshot.GetValue<idx_t>());
+	// if the replica has not caught up yet we read from the primary
+	return catalog.ReplicaHasSnapshot(required_snapshot);
+}
+
+DuckLakeCatalogInfo PostgresMetadataManager::GetCatalogForSnapshot(DuckLakeSnapshot snapshot) {
+	if (!CanReadFromReplica(snapshot)) {
+		return DuckLakeMetadataManager::GetCatalogForSnapshot(snapshot);
+	}
+	DuckLakeMetadataReadScope replica_scope(transaction.GetCatalog().MetadataReplicaDatabaseName());
+	return DuckLakeMetadataManager::GetCatalogForSnapshot(snapshot);
+}
+
+vector<DuckLakeFileListEntry> PostgresMetadataManager::GetFilesForTablePage(DuckLakeTableEntry &table,
+                                                                            DuckLakeSnapshot snapshot,
+                                                                            const string &filter,
+                                                                            optional_idx last_file_id,
+                                                                            idx_t page_size) {
+	if (!CanReadFromReplica(snapshot)) {
+		return DuckLakeMetadataManager::GetFilesForTablePage(table, snapshot, filter, last_file_id, page_size);
+	}
+	DuckLakeMetadataReadScope replica_scope(transaction.GetCatalog().MetadataReplicaDatabaseName());
+	return DuckLakeMetadataManager::GetFilesForTablePage(table, snapshot, filter, last_file_id, page_size);
+}
+
+bool PostgresMetadataManager::CanExecuteInPostgres(const string &statement) {
+	// the writes are generated as DuckDB SQL - only plain INSERT, UPDATE and DELETE statements on the metadata tables
+	// mean the same thing in Postgres. Statements with casts (e.g. the inlined data, where the values are rendered by
+	// DuckDB) or CTEs over VALUES lists (whose column types Postgres infers differently) are left to DuckDB
+	static const char *const SUPPORTED_PREFIXES[] = {"INSERT INTO {METADATA_CATALOG}.ducklake_",
+	                                                 "UPDATE {METADATA_CATALOG}.ducklake_",
+	                                                 "DELETE FROM {METADATA_CATALOG}.ducklake_"};
+	bool has_supported_prefix = false;
+	for (auto &prefix : SUPPORTED_PREFIXES) {
+		if (StringUtil::StartsWith(statement, prefix)) {
+			has_supported_prefix = true;
+			break;
+		}
+	}
+	if (!has_supported_prefix) {
+		return false;
+	}
+	if (StringUtil::Contains(statement, "{METADATA_CATALOG}.ducklake_inlined_data_") ||
+	    StringUtil::Contains(statement, "::")) {
+		return false;
+	}
+	// the only placeholder that is translated is the metadata catalog
+	auto remaining = StringUtil::Replace(statement, "{METADATA_CATALOG}", "");
+	return !StringUtil::Contains(remaining, "{METADATA_") && !StringUtil::Contains(remaining, "{DATA_PATH}");
+}
+
+string PostgresMetadataManager::GetWriteBatchQuery(const vector<string> &statements) {
+	// DuckDB sends every statement of a multi-statement query to Postgres separately - consecutive writes that can be
+	// run by Postgres directly are sent as a single postgres_execute instead, which is one round trip for all of them
+	string result;
+	string postgres_batch;
+	auto flush_postgres_batch = [&]() {
+		if (postgres_batch.empty()) {
+			return;
+		}
+		result += "CALL postgres_execute({METADATA_CATALOG_NAME_LITERAL}, '" + postgres_batch + "');\n";
+		postgres_batch = string();
+	};
+	for (auto &statement : statements) {
+		if (!CanExecuteInPostgres(statement)) {
+			flush_postgres_batch();
+			result += statement + "\n";
+			continue;
+		}
+		auto postgres_statement = StringUtil::Replace(statement, "'", "''");
+		postgres_batch += StringUtil::Replace(postgres_statement, "{METADATA_CATALOG}", "{METADATA_SCHEMA_ESCAPED}");
+		postgres_batch += "\n";
+	}
+	flush_postgres_batch();
+	return result;
+}
+
+DuckLakeArchiveInfo PostgresMetadataManager::ArchiveFiles(idx_t archive_snapshot) {
+	auto archive_info = DuckLakeMetadataManager::ArchiveFiles(archive_snapshot);
+	if (archive_info.archive_snapshot == 0) {
+		// nothing was archived - the archive tables do not exist
+		return archive_info;
+	}
+	// time travel queries filter the archive tables on table id and snapshot range - like the file tables
+	auto result = transaction.Query(R"(
+	CALL postgres_execute({METADATA_CATALOG_NAME_LITERAL},
+		'CREATE INDEX IF NOT EXISTS ducklake_data_file_archive_table_idx
+		     ON {METADATA_SCHEMA_ESCAPED}.ducklake_data_file_archive (table_id, begin_snapshot, end_snapshot);
+		 CREATE INDEX IF NOT EXISTS ducklake_delete_file_archive_table_idx
+		     ON {METADATA_SCHEMA_ESCAPED}.ducklake_delete_file_archive (table_id, begin_snapshot, end_snapshot);')
+	)");
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to create archive indexes for DuckLake: ");
+	}
+	return archive_info;
+}
+
 } // namespace duckdb
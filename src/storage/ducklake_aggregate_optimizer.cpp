@@ -0,0 +1,479 @@
+#include "storage/ducklake_aggregate_optimizer.hpp"
+
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_dummy_scan.hpp"
+#include "duckdb/planner/operator/logical_expression_get.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_scan.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
+#include "storage/ducklake_zone_map.hpp"
+
+namespace duckdb {
+
+DuckLakeAggregateOptimizer::DuckLakeAggregateOptimizer() {
+	optimize_function = DuckLakeAggregateOptimizer::Optimize;
+}
+
+enum class DuckLakeStatsAggregateType { COUNT_STAR, COUNT, MIN, MAX };
+
+//! An aggregate that is computed from the file stats
+struct DuckLakeStatsAggregate {
+	DuckLakeStatsAggregateType type;
+	//! The column the aggregate is computed over (if any)
+	FieldIndex column_id;
+	LogicalType column_type;
+	LogicalType return_type;
+	//! The result of COUNT(*) / COUNT(col)
+	idx_t count = 0;
+	//! The result of MIN(col) / MAX(col)
+	Value value;
+};
+
+//! A filter on a column of the scanned table
+struct DuckLakeStatsFilter {
+	DuckLakeStatsFilter(FieldIndex column_id, LogicalType type_p, const TableFilter &filter)
+	    : column_id(column_id), type(std::move(type_p)), filter(filter) {
+	}
+
+	FieldIndex column_id;
+	LogicalType type;
+	const TableFilter &filter;
+};
+
+//! Whether all, none or only some of the rows of a file match a filter
+enum class DuckLakeFileFilterResult { ALL_ROWS, NO_ROWS, SOME_ROWS };
+
+static bool TryCastStatsValue(const Value &input, const LogicalType &type, Value &result) {
+	if (input.IsNull()) {
+		return false;
+	}
+	result = input;
+	return result.DefaultTryCastAs(type);
+}
+
+static bool IsFloatingPoint(const LogicalType &type) {
+	return type.id() == LogicalTypeId::FLOAT || type.id() == LogicalTypeId::DOUBLE;
+}
+
+static optional_ptr<const DuckLakeFileColumnStatsEntry> GetColumnStats(const DuckLakeFileStatsEntry &file,
+                                                                       FieldIndex column_id) {
+	for (auto &stats : file.column_stats) {
+		if (stats.column_id == column_id) {
+			return &stats;
+		}
+	}
+	return nullptr;
+}
+
+static DuckLakeFileFilterResult EvaluateComparison(const ConstantFilter &filter,
+                                                   const DuckLakeFileColumnStatsEntry &stats, const LogicalType &type,
+                                                   bool all_valid) {
+	Value min_value, max_value, constant;
+	if (!TryCastStatsValue(stats.min_value, type, min_value) || !TryCastStatsValue(stats.max_value, type, max_value) ||
+	    !TryCastStatsValue(filter.constant, type, constant)) {
+		return DuckLakeFileFilterResult::SOME_ROWS;
+	}
+	if (IsFloatingPoint(type) && stats.contains_nan) {
+		// NaN values are not part of the min/max
+		return DuckLakeFileFilterResult::SOME_ROWS;
+	}
+	bool no_rows;
+	bool all_rows;
+	switch (filter.comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		no_rows = constant < min_value || constant > max_value;
+		all_rows = min_value == constant && max_value == constant;
+		break;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		no_rows = min_value == constant && max_value == constant;
+		all_rows = constant < min_value || constant > max_value;
+		break;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		no_rows = max_value <= constant;
+		all_rows = min_value > constant;
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		no_rows = max_value < constant;
+		all_rows = min_value >= constant;
+		break;
+	case ExpressionType::COMPARE_LESSTHAN:
+		no_rows = min_value >= constant;
+		all_rows = max_value < constant;
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		no_rows = min_value > constant;
+		all_rows = max_value <= constant;
+		break;
+	default:
+		return DuckLakeFileFilterResult::SOME_ROWS;
+	}
+	if (no_rows) {
+		return DuckLakeFileFilterResult::NO_ROWS;
+	}
+	// NULL values never match a comparison
+	if (all_rows && all_valid) {
+		return DuckLakeFileFilterResult::ALL_ROWS;
+	}
+	return DuckLakeFileFilterResult::SOME_ROWS;
+}
+
+static DuckLakeFileFilterResult EvaluateFilter(const TableFilter &filter, const DuckLakeFileColumnStatsEntry &stats,
+                                               const LogicalType &type, idx_t row_count) {
+	if (filter.filter_type == TableFilterType::OPTIONAL_FILTER) {
+		// optional filters are only hints for the scan - they do not need to be applied
+		return DuckLakeFileFilterResult::ALL_ROWS;
+	}
+	if (!stats.null_count.IsValid()) {
+		return DuckLakeFileFilterResult::SOME_ROWS;
+	}
+	auto null_count = stats.null_count.GetIndex();
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		if (null_count >= row_count) {
+			// only NULL values
+			return DuckLakeFileFilterResult::NO_ROWS;
+		}
+		return EvaluateComparison(filter.Cast<ConstantFilter>(), stats, type, null_count == 0);
+	case TableFilterType::IS_NULL:
+		if (null_count == 0) {
+			return DuckLakeFileFilterResult::NO_ROWS;
+		}
+		return null_count >= row_count ? DuckLakeFileFilterResult::ALL_ROWS : DuckLakeFileFilterResult::SOME_ROWS;
+	case TableFilterType::IS_NOT_NULL:
+		if (null_count == 0) {
+			return DuckLakeFileFilterResult::ALL_ROWS;
+		}
+		return null_count >= row_count ? DuckLakeFileFilterResult::NO_ROWS : DuckLakeFileFilterResult::SOME_ROWS;
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		auto result = DuckLakeFileFilterResult::ALL_ROWS;
+		for (auto &child_filter : conjunction_and_filter.child_filters) {
+			auto child_result = EvaluateFilter(*child_filter, stats, type, row_count);
+			if (child_result == DuckLakeFileFilterResult::NO_ROWS) {
+				return child_result;
+			}
+			if (child_result == DuckLakeFileFilterResult::SOME_ROWS) {
+				result = child_result;
+			}
+		}
+		return result;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction_or_filter = filter.Cast<ConjunctionOrFilter>();
+		auto result = DuckLakeFileFilterResult::NO_ROWS;
+		for (auto &child_filter : conjunction_or_filter.child_filters) {
+			auto child_result = EvaluateFilter(*child_filter, stats, type, row_count);
+			if (child_result == DuckLakeFileFilterResult::ALL_ROWS) {
+				return child_result;
+			}
+			if (child_result == DuckLakeFileFilterResult::SOME_ROWS) {
+				result = child_result;
+			}
+		}
+		return result;
+	}
+	default:
+		return DuckLakeFileFilterResult::SOME_ROWS;
+	}
+}
+
+static bool MergeValue(DuckLakeStatsAggregate &aggregate, const Value &input) {
+	if (input.IsNull()) {
+		return true;
+	}
+	Value value;
+	if (!TryCastStatsValue(input, aggregate.column_type, value)) {
+		return false;
+	}
+	if (aggregate.value.IsNull()) {
+		aggregate.value = std::move(value);
+	} else if (aggregate.type == DuckLakeStatsAggregateType::MIN ? value < aggregate.value : value > aggregate.value) {
+		aggregate.value = std::move(value);
+	}
+	return true;
+}
+
+static bool AddFile(DuckLakeStatsAggregate &aggregate, const DuckLakeFileStatsEntry &file) {
+	auto row_count = file.row_count - MinValue<idx_t>(file.delete_count, file.row_count);
+	if (aggregate.type == DuckLakeStatsAggregateType::COUNT_STAR) {
+		aggregate.count += row_count;
+		return true;
+	}
+	auto stats = GetColumnStats(file, aggregate.column_id);
+	if (!stats || !stats->null_count.IsValid()) {
+		// no stats for this column (e.g. because the column was added after the file was written)
+		return false;
+	}
+	auto null_count = stats->null_count.GetIndex();
+	if (aggregate.type == DuckLakeStatsAggregateType::COUNT) {
+		if (null_count >= file.row_count) {
+			// the file only contains NULL values
+			return true;
+		}
+		if (null_count == 0) {
+			aggregate.count += row_count;
+			return true;
+		}
+		if (file.delete_count > 0) {
+			// we don't know whether or not the deleted rows are NULL
+			return false;
+		}
+		aggregate.count += file.row_count - MinValue<idx_t>(null_count, file.row_count);
+		return true;
+	}
+	if (null_count >= file.row_count) {
+		// the file only contains NULL values
+		return true;
+	}
+	if (file.delete_count > 0) {
+		// the min/max of the file might have been deleted
+		return false;
+	}
+	if (IsFloatingPoint(aggregate.column_type) && stats->contains_nan) {
+		return false;
+	}
+	auto &value = aggregate.type == DuckLakeStatsAggregateType::MIN ? stats->min_value : stats->max_value;
+	if (value.IsNull()) {
+		return false;
+	}
+	return MergeValue(aggregate, value);
+}
+
+static bool AddInlinedData(DuckLakeTransaction &transaction, DuckLakeFunctionInfo &read_info,
+                           vector<DuckLakeStatsAggregate> &aggregates) {
+	auto &catalog = transaction.GetCatalog();
+	auto &metadata_manager = transaction.GetMetadataManager();
+	for (auto &inlined_table : read_info.table.GetInlinedDataTables()) {
+		// the inlined data table has the columns of the table at the schema version it was created for
+		DuckLakeSnapshot schema_snapshot(catalog.GetSnapshotForSchema(inlined_table.schema_version, transaction),
+		                                 inlined_table.schema_version, 0, 0);
+		auto entry = catalog.GetEntryById(transaction, schema_snapshot, read_info.table.GetTableId());
+		if (!entry) {
+			return false;
+		}
+		auto &field_data = entry->Cast<DuckLakeTableEntry>().GetFieldData();
+		vector<string> aggregate_list;
+		for (auto &aggregate : aggregates) {
+			if (aggregate.type == DuckLakeStatsAggregateType::COUNT_STAR) {
+				aggregate_list.push_back("COUNT(*)");
+				continue;
+			}
+			auto field_id = field_data.GetByFieldIndex(aggregate.column_id);
+			if (!field_id) {
+				// the column did not exist yet when the data was inlined
+				return false;
+			}
+			auto column_name = KeywordHelper::WriteOptionallyQuoted(field_id->Name());
+			switch (aggregate.type) {
+			case DuckLakeStatsAggregateType::COUNT:
+				aggregate_list.push_back("COUNT(" + column_name + ")");
+				break;
+			case DuckLakeStatsAggregateType::MIN:
+				aggregate_list.push_back("MIN(" + column_name + ")");
+				break;
+			case DuckLakeStatsAggregateType::MAX:
+				aggregate_list.push_back("MAX(" + column_name + ")");
+				break;
+			default:
+				throw InternalException("Unsupported stats aggregate type");
+			}
+		}
+		auto values = metadata_manager.ReadInlinedDataAggregates(read_info.snapshot, inlined_table.table_name,
+		                                                         aggregate_list);
+		if (values.size() != aggregates.size()) {
+			return false;
+		}
+		for (idx_t i = 0; i < aggregates.size(); i++) {
+			auto &aggregate = aggregates[i];
+			if (aggregate.type == DuckLakeStatsAggregateType::COUNT_STAR ||
+			    aggregate.type == DuckLakeStatsAggregateType::COUNT) {
+				aggregate.count += values[i].IsNull() ? 0 : values[i].GetValue<idx_t>();
+			} else if (!MergeValue(aggregate, values[i])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static unique_ptr<LogicalOperator> TryAnswerFromStats(OptimizerExtensionInput &input, LogicalAggregate &aggr) {
+	if (!aggr.groups.empty() || !aggr.grouping_functions.empty() || aggr.grouping_sets.size() > 1) {
+		return nullptr;
+	}
+	if (aggr.children.size() != 1 || aggr.children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = aggr.children[0]->Cast<LogicalGet>();
+	if (get.function.name != "ducklake_scan" || !get.function.function_info) {
+		return nullptr;
+	}
+	auto &read_info = get.function.function_info->Cast<DuckLakeFunctionInfo>();
+	if (read_info.scan_type != DuckLakeScanType::SCAN_TABLE || read_info.table_id.IsTransactionLocal()) {
+		return nullptr;
+	}
+	auto transaction = read_info.transaction.lock();
+	if (!transaction || transaction->ChangesMade()) {
+		// the stats in the metadata catalog do not include the changes made by this transaction
+		return nullptr;
+	}
+	auto &table = read_info.table;
+
+	// figure out which aggregates we need to compute
+	vector<DuckLakeStatsAggregate> aggregates;
+	vector<FieldIndex> stats_columns;
+	for (auto &expr : aggr.expressions) {
+		if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+			return nullptr;
+		}
+		auto &bound_aggr = expr->Cast<BoundAggregateExpression>();
+		if (bound_aggr.filter || bound_aggr.order_bys) {
+			return nullptr;
+		}
+		DuckLakeStatsAggregate aggregate;
+		aggregate.return_type = bound_aggr.return_type;
+		auto &name = bound_aggr.function.name;
+		if (name == "count_star") {
+			aggregate.type = DuckLakeStatsAggregateType::COUNT_STAR;
+		} else if (name == "count" && !bound_aggr.IsDistinct()) {
+			aggregate.type = DuckLakeStatsAggregateType::COUNT;
+		} else if (name == "min") {
+			aggregate.type = DuckLakeStatsAggregateType::MIN;
+		} else if (name == "max") {
+			aggregate.type = DuckLakeStatsAggregateType::MAX;
+		} else {
+			return nullptr;
+		}
+		if (aggregate.type != DuckLakeStatsAggregateType::COUNT_STAR) {
+			if (bound_aggr.children.size() != 1 ||
+			    bound_aggr.children[0]->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+				return nullptr;
+			}
+			auto &colref = bound_aggr.children[0]->Cast<BoundColumnRefExpression>();
+			if (colref.binding.table_index != get.table_index) {
+				return nullptr;
+			}
+			auto column_index = colref.binding.column_index;
+			if (!get.projection_ids.empty()) {
+				if (column_index >= get.projection_ids.size()) {
+					return nullptr;
+				}
+				column_index = get.projection_ids[column_index];
+			}
+			auto field_id = DuckLakeFunctions::GetScanColumn(get, table, column_index);
+			if (!field_id) {
+				return nullptr;
+			}
+			if (aggregate.type != DuckLakeStatsAggregateType::COUNT &&
+			    !DuckLakeColumnZoneMap::SupportsType(field_id->Type())) {
+				// the min/max stats of other types are not necessarily exact (e.g. truncated strings)
+				return nullptr;
+			}
+			aggregate.column_id = field_id->GetFieldIndex();
+			aggregate.column_type = field_id->Type();
+			aggregate.value = Value(aggregate.column_type);
+			stats_columns.push_back(aggregate.column_id);
+		}
+		aggregates.push_back(std::move(aggregate));
+	}
+	if (aggregates.empty()) {
+		return nullptr;
+	}
+	// filters are only supported if every file either fully matches them or does not match them at all
+	vector<DuckLakeStatsFilter> filters;
+	for (auto &entry : get.table_filters.filters) {
+		auto field_id = DuckLakeFunctions::GetScanColumn(get, table, entry.first);
+		if (!field_id || !DuckLakeColumnZoneMap::SupportsType(field_id->Type())) {
+			return nullptr;
+		}
+		filters.emplace_back(field_id->GetFieldIndex(), field_id->Type(), *entry.second);
+		stats_columns.push_back(field_id->GetFieldIndex());
+	}
+	if (!filters.empty() && !table.GetInlinedDataTables().empty()) {
+		// we cannot evaluate filters against inlined data
+		return nullptr;
+	}
+
+	auto &metadata_manager = transaction->GetMetadataManager();
+	auto files = metadata_manager.GetFileStatsForTable(table, read_info.snapshot, stats_columns);
+	for (auto &file : files) {
+		if (file.is_partial_file) {
+			return nullptr;
+		}
+		auto filter_result = DuckLakeFileFilterResult::ALL_ROWS;
+		for (auto &filter : filters) {
+			auto stats = GetColumnStats(file, filter.column_id);
+			auto column_result = stats ? EvaluateFilter(filter.filter, *stats, filter.type, file.row_count)
+			                           : DuckLakeFileFilterResult::SOME_ROWS;
+			if (column_result == DuckLakeFileFilterResult::NO_ROWS) {
+				filter_result = column_result;
+				break;
+			}
+			if (column_result == DuckLakeFileFilterResult::SOME_ROWS) {
+				filter_result = column_result;
+			}
+		}
+		if (filter_result == DuckLakeFileFilterResult::NO_ROWS) {
+			// none of the rows in this file match - skip it
+			continue;
+		}
+		if (filter_result == DuckLakeFileFilterResult::SOME_ROWS) {
+			// only part of this file matches - we need to scan it
+			return nullptr;
+		}
+		for (auto &aggregate : aggregates) {
+			if (!AddFile(aggregate, file)) {
+				return nullptr;
+			}
+		}
+	}
+	if (!AddInlinedData(*transaction, read_info, aggregates)) {
+		return nullptr;
+	}
+
+	// replace the aggregate with the computed values
+	vector<LogicalType> types;
+	vector<vector<unique_ptr<Expression>>> values(1);
+	for (auto &aggregate : aggregates) {
+		Value result;
+		if (aggregate.type == DuckLakeStatsAggregateType::COUNT_STAR ||
+		    aggregate.type == DuckLakeStatsAggregateType::COUNT) {
+			result = Value::BIGINT(NumericCast<int64_t>(aggregate.count));
+		} else {
+			result = aggregate.value;
+		}
+		if (!result.DefaultTryCastAs(aggregate.return_type)) {
+			return nullptr;
+		}
+		types.push_back(aggregate.return_type);
+		values[0].push_back(make_uniq<BoundConstantExpression>(std::move(result)));
+	}
+	auto expression_get = make_uniq<LogicalExpressionGet>(aggr.aggregate_index, std::move(types), std::move(values));
+	expression_get->children.push_back(make_uniq<LogicalDummyScan>(input.optimizer.binder.GenerateTableIndex()));
+	return std::move(expression_get);
+}
+
+void DuckLakeAggregateOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	for (auto &child : plan->children) {
+		Optimize(input, child);
+	}
+	if (plan->type != LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY) {
+		return;
+	}
+	auto result = TryAnswerFromStats(input, plan->Cast<LogicalAggregate>());
+	if (result) {
+		plan = std::move(result);
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,239 @@
+#include "storage/ducklake_background_maintenance.hpp"
+
+#include "storage/ducklake_catalog.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+namespace duckdb {
+
+//! The amount of times a failed maintenance task is retried before it is dropped
+static constexpr const idx_t MAX_TASK_RETRIES = 3;
+
+DuckLakeBackgroundMaintenance::DuckLakeBackgroundMaintenance(DuckLakeCatalog &catalog)
+    : catalog(catalog), state(make_shared_ptr<DuckLakeMaintenanceState>()) {
+}
+
+DuckLakeBackgroundMaintenance::~DuckLakeBackgroundMaintenance() {
+	try {
+		Stop();
+	} catch (...) {
+	}
+}
+
+void DuckLakeBackgroundMaintenance::ScheduleTask(const string &function_name, const string &schema,
+                                                 const string &table) {
+	auto catalog_name = KeywordHelper::WriteQuoted(catalog.GetName(), '\'');
+	auto schema_name = KeywordHelper::WriteQuoted(schema, '\'');
+	auto table_name = KeywordHelper::WriteQuoted(table, '\'');
+	string query;
+	if (function_name == "ducklake_flush_inlined_data" || function_name == "ducklake_flush_insert_buffer") {
+		query = StringUtil::Format("CALL %s(%s, schema_name => %s, table_name => %s)", function_name, catalog_name,
+		                           schema_name, table_name);
+	} else {
+		// the compaction functions take the table name as a positional parameter
+		query = StringUtil::Format("CALL %s(%s, %s, schema => %s)", function_name, catalog_name, table_name,
+		                           schema_name);
+	}
+	state->QueueTask(std::move(query));
+}
+
+void DuckLakeMaintenanceState::QueueTask(string query) {
+	if (!queued_tasks.insert(query).second) {
+		// this task is already queued
+		return;
+	}
+	task_queue.push_back(std::move(query));
+}
+
+void DuckLakeMaintenanceState::FinishTask(const string &query, bool success) {
+	lock_guard<mutex> guard(lock);
+	if (success) {
+		task_failures.erase(query);
+		return;
+	}
+	// failures (e.g. conflicts with concurrent writers) are not fatal - the task is retried a few times, after which it
+	// is only scheduled again once the thresholds are crossed again
+	auto &failure_count = task_failures[query];
+	if (shutdown || ++failure_count > MAX_TASK_RETRIES) {
+		task_failures.erase(query);
+		return;
+	}
+	QueueTask(query);
+}
+
+void DuckLakeBackgroundMaintenance::ScheduleQuery(const string &query) {
+#ifndef DUCKDB_NO_THREADS
+	lock_guard<mutex> guard(state->lock);
+	if (state->shutdown) {
+		return;
+	}
+	state->QueueTask(query);
+	StartThread();
+	state->cv.notify_one();
+#endif
+}
+
+void DuckLakeBackgroundMaintenance::AddCommittedChanges(
+    const vector<DuckLakeCommittedTableChanges> &committed_changes) {
+#ifndef DUCKDB_NO_THREADS
+	lock_guard<mutex> guard(state->lock);
+	if (state->shutdown) {
+		return;
+	}
+	auto queued_task_count = state->task_queue.size();
+	for (auto &entry : committed_changes) {
+		auto &pending = pending_changes[entry.table_id];
+		pending.inlined_row_count += entry.inlined_row_count;
+		pending.inlined_size_in_bytes += entry.inlined_size_in_bytes;
+		pending.small_file_count += entry.small_file_count;
+		pending.deleted_row_count += entry.deleted_row_count;
+
+		bool flush_inlined_data = entry.inlined_row_limit > 0 && pending.inlined_row_count >= entry.inlined_row_limit;
+		if (entry.inlined_size_limit > 0 && pending.inlined_size_in_bytes >= entry.inlined_size_limit) {
+			flush_inlined_data = true;
+		}
+		if (flush_inlined_data) {
+			ScheduleTask("ducklake_flush_inlined_data", entry.schema_name, entry.table_name);
+			pending.inlined_row_count = 0;
+			pending.inlined_size_in_bytes = 0;
+		}
+		if (entry.small_file_limit > 0 && pending.small_file_count >= entry.small_file_limit) {
+			ScheduleTask("ducklake_merge_adjacent_files", entry.schema_name, entry.table_name);
+			pending.small_file_count = 0;
+		}
+		if (entry.delete_ratio_limit > 0 && entry.table_row_count > 0 &&
+		    static_cast<double>(pending.deleted_row_count) >=
+		        entry.delete_ratio_limit * static_cast<double>(entry.table_row_count)) {
+			ScheduleTask("ducklake_rewrite_data_files", entry.schema_name, entry.table_name);
+			pending.deleted_row_count = 0;
+		}
+	}
+	if (state->task_queue.size() == queued_task_count) {
+		return;
+	}
+	StartThread();
+	state->cv.notify_one();
+#endif
+}
+
+void DuckLakeBackgroundMaintenance::StartThread() {
+	if (maintenance_thread) {
+		return;
+	}
+	// start the background thread on the first task
+	auto thread_state = state;
+	maintenance_thread = make_uniq<thread>([thread_state, this]() { Run(thread_state, *this); });
+}
+
+void DuckLakeBackgroundMaintenance::ScheduleBufferCheck(idx_t delay_us) {
+	auto check_time = std::chrono::steady_clock::now() + std::chrono::microseconds(delay_us);
+	if (state->buffer_check_scheduled && state->next_buffer_check <= check_time) {
+		// an earlier check is already scheduled
+		return;
+	}
+	state->buffer_check_scheduled = true;
+	state->next_buffer_check = check_time;
+}
+
+void DuckLakeBackgroundMaintenance::ScheduleInsertBufferCheck(idx_t delay_us) {
+#ifndef DUCKDB_NO_THREADS
+	lock_guard<mutex> guard(state->lock);
+	if (state->shutdown) {
+		return;
+	}
+	ScheduleBufferCheck(delay_us);
+	StartThread();
+	state->cv.notify_one();
+#endif
+}
+
+void DuckLakeBackgroundMaintenance::CheckInsertBuffers() {
+	optional_idx next_check_us;
+	auto expired_buffers = catalog.GetInsertBuffer().GetExpiredBuffers(next_check_us);
+	lock_guard<mutex> guard(state->lock);
+	if (state->shutdown) {
+		return;
+	}
+	for (auto &buffer : expired_buffers) {
+		ScheduleTask("ducklake_flush_insert_buffer", buffer.schema_name, buffer.table_name);
+	}
+	if (next_check_us.IsValid()) {
+		ScheduleBufferCheck(next_check_us.GetIndex());
+	}
+}
+
+void DuckLakeBackgroundMaintenance::Stop() {
+	unique_ptr<thread> stopped_thread;
+	{
+		lock_guard<mutex> guard(state->lock);
+		state->shutdown = true;
+		state->task_queue.clear();
+		state->queued_tasks.clear();
+		state->task_failures.clear();
+		stopped_thread = std::move(maintenance_thread);
+	}
+	state->cv.notify_all();
+	if (!stopped_thread) {
+		return;
+	}
+	if (stopped_thread->get_id() == std::this_thread::get_id()) {
+		// the catalog is destroyed from within a task (i.e. the task held the last reference to the database)
+		// the thread only accesses the shared state after the task returns - so it can exit safely
+		stopped_thread->detach();
+		return;
+	}
+	stopped_thread->join();
+}
+
+void DuckLakeBackgroundMaintenance::Run(shared_ptr<DuckLakeMaintenanceState> state,
+                                        DuckLakeBackgroundMaintenance &maintenance) {
+	while (true) {
+		string query;
+		{
+			unique_lock<mutex> guard(state->lock);
+			auto has_work = [&]() {
+				return state->shutdown || !state->task_queue.empty() ||
+				       (state->buffer_check_scheduled &&
+				        state->next_buffer_check <= std::chrono::steady_clock::now());
+			};
+			while (!has_work()) {
+				if (state->buffer_check_scheduled) {
+					state->cv.wait_until(guard, state->next_buffer_check);
+				} else {
+					state->cv.wait(guard);
+				}
+			}
+			if (state->shutdown) {
+				// the maintenance might already be destroyed - do not access it
+				return;
+			}
+			if (state->task_queue.empty()) {
+				// the insert buffers are due to be checked
+				state->buffer_check_scheduled = false;
+				guard.unlock();
+				maintenance.CheckInsertBuffers();
+				continue;
+			}
+			query = std::move(state->task_queue.front());
+			state->task_queue.erase(state->task_queue.begin());
+			state->queued_tasks.erase(query);
+		}
+		// the maintenance is only destroyed on another thread after Stop has joined this thread
+		// if the task destroys it on this thread, it sets shutdown before returning
+		auto success = maintenance.RunTask(query);
+		state->FinishTask(query, success);
+	}
+}
+
+bool DuckLakeBackgroundMaintenance::RunTask(const string &query) {
+	try {
+		Connection con(catalog.GetDatabase());
+		auto result = con.Query(query);
+		return !result->HasError();
+	} catch (...) {
+		return false;
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,133 @@
+#include "storage/ducklake_buffer_data.hpp"
+
+#include "storage/ducklake_background_maintenance.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_insert.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+DuckLakeBufferData::DuckLakeBufferData(PhysicalPlan &physical_plan, PhysicalOperator &child, DuckLakeTableEntry &table,
+                                       DuckLakeInsertBufferLimits limits, bool flush_buffer)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, child.types, child.estimated_cardinality),
+      table(table), limits(limits), flush_buffer(flush_buffer) {
+	children.push_back(child);
+}
+
+class BufferDataState : public OperatorState {
+public:
+	//! The rows inserted by this statement
+	unique_ptr<ColumnDataCollection> inserted_rows;
+	bool finished_buffering = false;
+	//! The buffered rows we are writing (if the buffer is flushed)
+	optional_ptr<ColumnDataCollection> flushed_rows;
+	ColumnDataScanState emit_scan;
+};
+
+class BufferDataGlobalState : public GlobalOperatorState {
+public:
+	idx_t inserted_row_count = 0;
+};
+
+unique_ptr<OperatorState> DuckLakeBufferData::GetOperatorState(ExecutionContext &context) const {
+	return make_uniq<BufferDataState>();
+}
+
+unique_ptr<GlobalOperatorState> DuckLakeBufferData::GetGlobalOperatorState(ClientContext &context) const {
+	return make_uniq<BufferDataGlobalState>();
+}
+
+OperatorResultType DuckLakeBufferData::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                               GlobalOperatorState &gstate_p, OperatorState &state_p) const {
+	auto &state = state_p.Cast<BufferDataState>();
+	if (!state.inserted_rows) {
+		auto &buffer_manager = BufferManager::GetBufferManager(context.client);
+		state.inserted_rows = make_uniq<ColumnDataCollection>(buffer_manager, types);
+	}
+	state.inserted_rows->Append(input);
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+OperatorFinalizeResultType DuckLakeBufferData::FinalExecute(ExecutionContext &context, DataChunk &chunk,
+                                                            GlobalOperatorState &gstate_p,
+                                                            OperatorState &state_p) const {
+	auto &state = state_p.Cast<BufferDataState>();
+	auto &gstate = gstate_p.Cast<BufferDataGlobalState>();
+	if (!state.finished_buffering) {
+		state.finished_buffering = true;
+		// add the inserted rows to the insert buffer and check if we need to flush it
+		auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+		auto &insert_buffer = catalog.GetInsertBuffer();
+		DuckLakeBufferedRows rows_to_flush;
+		optional_idx batch_id;
+		if (flush_buffer) {
+			rows_to_flush = insert_buffer.Take(table.GetTableId());
+		} else if (state.inserted_rows) {
+			gstate.inserted_row_count = state.inserted_rows->Count();
+			idx_t append_id;
+			rows_to_flush = insert_buffer.Append(table.GetTableId(), table.ParentSchema().name, table.name,
+			                                     std::move(state.inserted_rows), limits, append_id);
+			batch_id = append_id;
+		}
+		if (!rows_to_flush.rows) {
+			// the rows remain buffered - nothing to write
+			if (batch_id.IsValid() && limits.flush_interval_us > 0) {
+				// make sure the rows are written once they exceed the flush interval - even if no insert follows
+				catalog.GetBackgroundMaintenance().ScheduleInsertBufferCheck(limits.flush_interval_us);
+			}
+			if (batch_id.IsValid() && limits.wait_for_commit) {
+				// only acknowledge the insert once its rows have been written
+				insert_buffer.WaitForCommit(batch_id.GetIndex());
+			}
+			return OperatorFinalizeResultType::FINISHED;
+		}
+		if (rows_to_flush.rows->Types() != types) {
+			insert_buffer.Restore(table.GetTableId(), std::move(rows_to_flush));
+			throw InvalidInputException("Failed to flush buffered inserts of table \"%s\" - the table was altered "
+			                            "after the rows were buffered",
+			                            table.name);
+		}
+		// the transaction holds on to the flushed rows - they are put back into the buffer if it does not commit
+		auto &transaction = DuckLakeTransaction::Get(context.client, catalog);
+		state.flushed_rows = transaction.AddFlushedInsertBuffer(table.GetTableId(), std::move(rows_to_flush));
+		state.flushed_rows->InitializeScan(state.emit_scan);
+	}
+	if (!state.flushed_rows) {
+		return OperatorFinalizeResultType::FINISHED;
+	}
+	// emit all buffered rows so they are written out
+	state.flushed_rows->Scan(state.emit_scan, chunk);
+	if (chunk.size() == 0) {
+		return OperatorFinalizeResultType::FINISHED;
+	}
+	return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+}
+
+OperatorFinalResultType DuckLakeBufferData::OperatorFinalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                                             OperatorFinalizeInput &input) const {
+	if (flush_buffer || !insert) {
+		// flushing the buffer - the insert reports the amount of written rows
+		return OperatorFinalResultType::FINISHED;
+	}
+	auto &gstate = input.global_state.Cast<BufferDataGlobalState>();
+	{
+		auto cinsert = const_cast<DuckLakeInsert *>(insert.get());
+		lock_guard<mutex> lock(cinsert->lock);
+		if (!cinsert->sink_state) {
+			cinsert->sink_state = insert->GetGlobalSinkState(context);
+		}
+	}
+	// the insert reports the rows inserted by this statement - regardless of whether or not they were written yet
+	auto &insert_gstate = insert->sink_state->Cast<DuckLakeInsertGlobalState>();
+	insert_gstate.count_written_rows = false;
+	insert_gstate.total_insert_count = gstate.inserted_row_count;
+	return OperatorFinalResultType::FINISHED;
+}
+
+string DuckLakeBufferData::GetName() const {
+	return "DUCKLAKE_BUFFER_DATA";
+}
+
+} // namespace duckdb
@@ -3,6 +3,9 @@
 #include "common/ducklake_types.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/chrono.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/parser/constraints/not_null_constraint.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
@@ -10,20 +13,46 @@
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
 #include "duckdb/parser/parsed_data/drop_info.hpp"
 #include "duckdb/storage/database_size.hpp"
+#include "storage/ducklake_compact_file_list.hpp"
+#include "storage/ducklake_create_index.hpp"
 #include "storage/ducklake_initializer.hpp"
+#include "storage/ducklake_metadata_cache.hpp"
+#include "storage/ducklake_data_file_cache.hpp"
+#include "storage/ducklake_delete_file_cache.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
+#include "storage/ducklake_background_maintenance.hpp"
+#include "storage/ducklake_compaction_tracker.hpp"
+#include "storage/ducklake_file_size_advisor.hpp"
+#include "storage/ducklake_footer_prefetcher.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_multi_file_list.hpp"
 #include "storage/ducklake_schema_entry.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_transaction.hpp"
+#include "storage/ducklake_transaction_changes.hpp"
 #include "storage/ducklake_transaction_manager.hpp"
 #include "storage/ducklake_view_entry.hpp"
+#include "storage/ducklake_zone_map.hpp"
 #include "duckdb/main/database_path_and_type.hpp"
 #include "duckdb/parser/parsed_data/create_index_info.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "duckdb/parser/parsed_data/alter_table_info.hpp"
 
 namespace duckdb {
 
 DuckLakeCatalog::DuckLakeCatalog(AttachedDatabase &db_p, DuckLakeOptions options_p)
     : Catalog(db_p), options(std::move(options_p)), last_uncommitted_catalog_version(TRANSACTION_ID_START) {
+	delete_file_cache = make_uniq<DuckLakeDeleteFileCache>(options.delete_file_cache_size, options.shared_scans);
+	if (!options.data_file_cache_path.empty()) {
+		auto &fs = FileSystem::GetFileSystem(db_p.GetDatabase());
+		data_file_cache =
+		    make_uniq<DuckLakeDataFileCache>(fs, options.data_file_cache_path, options.data_file_cache_size);
+	}
+	insert_buffer = make_uniq<DuckLakeInsertBuffer>();
+	background_maintenance = make_uniq<DuckLakeBackgroundMaintenance>(*this);
+	compaction_tracker = make_uniq<DuckLakeCompactionTracker>();
+	file_size_advisor = make_uniq<DuckLakeFileSizeAdvisor>();
+	read_ahead_budget = make_shared_ptr<DuckLakeReadAheadBudget>();
 	// figure out the metadata server type
 	auto entry = options.metadata_parameters.find("type");
 	if (entry != options.metadata_parameters.end()) {
@@ -37,6 +66,8 @@ DuckLakeCatalog::DuckLakeCatalog(AttachedDatabase &db_p, DuckLakeOptions options
 }
 
 DuckLakeCatalog::~DuckLakeCatalog() {
+	// stop the background maintenance before the rest of the catalog is destroyed
+	background_maintenance.reset();
 }
 
 void DuckLakeCatalog::Initialize(bool load_builtin) {
@@ -161,7 +192,18 @@ optional_ptr<CatalogEntry> DuckLakeCatalog::GetEntryById(DuckLakeTransaction &tr
 		return local_entry;
 	}
 	auto &schema = GetSchemaForSnapshot(transaction, snapshot);
-	return schema.GetEntryById(table_id);
+	return GetCommittedEntryById(transaction, schema, table_id);
+}
+
+optional_ptr<CatalogEntry> DuckLakeCatalog::GetCommittedEntryById(DuckLakeTransaction &transaction,
+                                                                  DuckLakeCatalogSet &schema, TableIndex table_id) {
+	auto entry = schema.GetEntryById(table_id);
+	if (!entry && schema.IsLazyEntry(table_id)) {
+		// the table has not been loaded yet - load it now
+		LoadLazyEntries(transaction, schema, vector<TableIndex> {table_id});
+		entry = schema.GetEntryById(table_id);
+	}
+	return entry;
 }
 
 idx_t DuckLakeCatalog::GetSnapshotForSchema(idx_t schema_id, DuckLakeTransaction &transaction) {
@@ -169,20 +211,107 @@ idx_t DuckLakeCatalog::GetSnapshotForSchema(idx_t schema_id, DuckLakeTransaction
 	return metadata_manager.GetCatalogIdForSchema(schema_id);
 }
 
+static idx_t EstimateSchemaSize(DuckLakeCatalogSet &schema_set) {
+	idx_t size = sizeof(DuckLakeCatalogSet);
+	for (auto &entry : schema_set.GetTableIdMap()) {
+		auto &catalog_entry = entry.second.get();
+		if (catalog_entry.type == CatalogType::TABLE_ENTRY) {
+			auto &table = catalog_entry.Cast<DuckLakeTableEntry>();
+			auto column_count = table.GetColumns().LogicalColumnCount();
+			size += sizeof(DuckLakeTableEntry) + column_count * (sizeof(ColumnDefinition) + sizeof(DuckLakeFieldId));
+		} else {
+			auto &view = catalog_entry.Cast<DuckLakeViewEntry>();
+			size += sizeof(DuckLakeViewEntry) + view.GetQuerySQL().size();
+		}
+	}
+	for (auto &entry : schema_set.GetLazyEntryMap()) {
+		size += sizeof(DuckLakeLazyEntry) + entry.second.name.size();
+	}
+	return size;
+}
+
+static idx_t EstimateStatsSize(DuckLakeStats &lake_stats) {
+	idx_t size = sizeof(DuckLakeStats);
+	for (auto &entry : lake_stats.table_stats) {
+		size += sizeof(DuckLakeTableStats);
+		for (auto &col_entry : entry.second->column_stats) {
+			auto &col_stats = col_entry.second;
+			size += sizeof(DuckLakeColumnStats) + col_stats.min.size() + col_stats.max.size();
+		}
+	}
+	for (auto &entry : lake_stats.lazy_table_stats) {
+		auto column_count = entry.second->column_stats.size();
+		size += sizeof(DuckLakeGlobalStatsInfo) + column_count * sizeof(DuckLakeGlobalColumnStatsInfo);
+	}
+	return size;
+}
+
 DuckLakeCatalogSet &DuckLakeCatalog::GetSchemaForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot) {
 	lock_guard<mutex> guard(schemas_lock);
 	auto entry = schemas.find(snapshot.schema_version);
 	if (entry != schemas.end()) {
 		// this schema version is already cached
-		return *entry->second;
+		entry->second.last_access = ++cache_access_count;
+		transaction.PinSchema(snapshot.schema_version, entry->second.entry);
+		return *entry->second.entry;
 	}
 	// load the schema version from the metadata manager
-	auto schema = LoadSchemaForSnapshot(transaction, snapshot);
-	auto &result = *schema;
-	schemas.insert(make_pair(snapshot.schema_version, std::move(schema)));
+	DuckLakeCacheEntry<DuckLakeCatalogSet> cache_entry;
+	cache_entry.entry = shared_ptr<DuckLakeCatalogSet>(LoadSchemaForSnapshot(transaction, snapshot));
+	cache_entry.snapshot_id = snapshot.snapshot_id;
+	cache_entry.estimated_size = EstimateSchemaSize(*cache_entry.entry);
+	cache_entry.last_access = ++cache_access_count;
+	auto &result = *cache_entry.entry;
+	// pin the schema before evicting so the new entry is never evicted
+	transaction.PinSchema(snapshot.schema_version, cache_entry.entry);
+	cache_size += cache_entry.estimated_size;
+	schemas.insert(make_pair(snapshot.schema_version, std::move(cache_entry)));
+	EvictCacheEntries();
 	return result;
 }
 
+template <class T>
+static void FindEvictionCandidate(unordered_map<idx_t, DuckLakeCacheEntry<T>> &entries, optional_idx &candidate,
+                                  idx_t &candidate_access) {
+	for (auto &entry : entries) {
+		if (entry.second.entry.use_count() > 1) {
+			// this entry is pinned by a running transaction
+			continue;
+		}
+		if (!candidate.IsValid() || entry.second.last_access < candidate_access) {
+			candidate = entry.first;
+			candidate_access = entry.second.last_access;
+		}
+	}
+}
+
+void DuckLakeCatalog::EvictCacheEntries() {
+	while (cache_size > options.catalog_cache_size) {
+		// find the least recently used entry that is not in use
+		optional_idx schema_candidate;
+		idx_t schema_access = 0;
+		FindEvictionCandidate(schemas, schema_candidate, schema_access);
+		optional_idx stats_candidate;
+		idx_t stats_access = 0;
+		FindEvictionCandidate(stats, stats_candidate, stats_access);
+		if (!schema_candidate.IsValid() && !stats_candidate.IsValid()) {
+			// all entries are in use
+			return;
+		}
+		if (schema_candidate.IsValid() && (!stats_candidate.IsValid() || schema_access < stats_access)) {
+			auto entry = schemas.find(schema_candidate.GetIndex());
+			cache_size -= entry->second.estimated_size;
+			// cached plans can still reference the evicted schema - force them to be re-bound
+			evicted_schema_versions[entry->first] = ++last_evicted_catalog_version;
+			schemas.erase(entry);
+		} else {
+			auto entry = stats.find(stats_candidate.GetIndex());
+			cache_size -= entry->second.estimated_size;
+			stats.erase(entry);
+		}
+	}
+}
+
 static unique_ptr<DuckLakeFieldId> TransformColumnType(DuckLakeColumnInfo &col) {
 	DuckLakeColumnData col_data;
 	col_data.id = col.id;
@@ -232,23 +361,151 @@ static unique_ptr<DuckLakeFieldId> TransformColumnType(DuckLakeColumnInfo &col)
 	throw InvalidInputException("Unrecognized nested type \"%s\"", col.type);
 }
 
+//! Get the commit time of a snapshot, to validate the local metadata cache with when it is loaded again
+static bool TryGetSnapshotTime(DuckLakeMetadataManager &metadata_manager, DuckLakeSnapshot snapshot,
+                               timestamp_tz_t &result) {
+	auto snapshot_time = metadata_manager.GetSnapshotTime(snapshot);
+	if (snapshot_time.IsNull()) {
+		// the snapshot was expired in the meantime
+		return false;
+	}
+	result = snapshot_time.GetValue<timestamp_tz_t>();
+	return true;
+}
+
+static bool SnapshotTimeMatches(DuckLakeMetadataManager &metadata_manager, DuckLakeSnapshot snapshot,
+                                timestamp_tz_t expected_time) {
+	timestamp_tz_t snapshot_time;
+	if (!TryGetSnapshotTime(metadata_manager, snapshot, snapshot_time)) {
+		return false;
+	}
+	return snapshot_time == expected_time;
+}
+
 unique_ptr<DuckLakeCatalogSet> DuckLakeCatalog::LoadSchemaForSnapshot(DuckLakeTransaction &transaction,
                                                                       DuckLakeSnapshot snapshot) {
+	auto result = LoadSchemaChanges(transaction, snapshot);
+	if (result) {
+		return result;
+	}
 	auto &metadata_manager = transaction.GetMetadataManager();
-	auto catalog = metadata_manager.GetCatalogForSnapshot(snapshot);
-	ducklake_entries_map_t schema_map;
-	for (auto &schema : catalog.schemas) {
-		CreateSchemaInfo schema_info;
-		schema_info.schema = schema.name;
-		auto schema_entry = make_uniq<DuckLakeSchemaEntry>(*this, schema_info, schema.id, std::move(schema.uuid),
-		                                                   std::move(schema.path));
-		schema_map.insert(make_pair(std::move(schema.name), std::move(schema_entry)));
+	DuckLakeCatalogInfo catalog;
+	if (options.lazy_catalog_loading) {
+		// only load the names of the tables - the tables themselves are loaded on first access
+		catalog = metadata_manager.GetCatalogListingForSnapshot(snapshot);
+	} else {
+		catalog = metadata_manager.GetCatalogForSnapshot(snapshot);
 	}
+	timestamp_tz_t snapshot_time;
+	if (metadata_cache &&
+	    (metadata_cache->snapshot.snapshot_id == DConstants::INVALID_INDEX ||
+	     snapshot.snapshot_id > metadata_cache->snapshot.snapshot_id) &&
+	    TryGetSnapshotTime(metadata_manager, snapshot, snapshot_time)) {
+		// this is the most recent catalog we have loaded - store it in the local metadata cache
+		metadata_cache->catalog = catalog;
+		metadata_cache->snapshot = snapshot;
+		metadata_cache->snapshot_time = snapshot_time;
+	}
+	return CreateSchemaSet(snapshot, catalog, nullptr, set<TableIndex>());
+}
 
-	auto schema_set = make_uniq<DuckLakeCatalogSet>(std::move(schema_map));
-	auto &schema_id_map = schema_set->GetSchemaIdMap();
-	// load the table entries
-	for (auto &table : catalog.tables) {
+unique_ptr<DuckLakeCatalogSet> DuckLakeCatalog::LoadSchemaChanges(DuckLakeTransaction &transaction,
+                                                                  DuckLakeSnapshot snapshot) {
+	// find the most recent schema version we have loaded before this one
+	optional_ptr<DuckLakeCatalogSet> base_set;
+	DuckLakeSnapshot base_snapshot = snapshot;
+	for (auto &entry : schemas) {
+		auto snapshot_id = entry.second.snapshot_id;
+		if (entry.first >= snapshot.schema_version || snapshot_id >= snapshot.snapshot_id) {
+			continue;
+		}
+		if (!base_set || entry.first > base_snapshot.schema_version) {
+			base_set = entry.second.entry.get();
+			base_snapshot.schema_version = entry.first;
+			base_snapshot.snapshot_id = snapshot_id;
+		}
+	}
+	if (!base_set) {
+		return nullptr;
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto changes_made = metadata_manager.GetChangesMadeBetweenSnapshots(base_snapshot, snapshot);
+	if (!changes_made) {
+		// the changes are no longer available
+		return nullptr;
+	}
+	auto changes = SnapshotChangeInformation::ParseChangesMade(changes_made->changes_made);
+	if (!changes.created_schemas.empty() || !changes.dropped_schemas.empty()) {
+		// schemas were created or dropped - reload the full catalog
+		return nullptr;
+	}
+	// reload only the entries that were altered or dropped, and any entries created after the base snapshot
+	set<TableIndex> changed_entries;
+	changed_entries.insert(changes.altered_tables.begin(), changes.altered_tables.end());
+	changed_entries.insert(changes.altered_views.begin(), changes.altered_views.end());
+	changed_entries.insert(changes.dropped_tables.begin(), changes.dropped_tables.end());
+	changed_entries.insert(changes.dropped_views.begin(), changes.dropped_views.end());
+	auto catalog = metadata_manager.GetCatalogChanges(base_snapshot, snapshot, changed_entries);
+	timestamp_tz_t snapshot_time;
+	if (metadata_cache && metadata_cache->snapshot.schema_version == base_snapshot.schema_version &&
+	    snapshot.snapshot_id > metadata_cache->snapshot.snapshot_id &&
+	    TryGetSnapshotTime(metadata_manager, snapshot, snapshot_time)) {
+		// the local metadata cache holds the base version - bring it up-to-date with the same changes
+		metadata_cache->ApplyCatalogChanges(catalog, changed_entries, snapshot, snapshot_time);
+	}
+	return CreateSchemaSet(snapshot, catalog, base_set, changed_entries);
+}
+
+//! Parse the parameter of a "name(parameter)" transform (e.g. bucket(16))
+static bool TryParseTransformParameter(const string &transform, const string &name, idx_t &parameter) {
+	auto prefix = name + "(";
+	if (!StringUtil::StartsWith(transform, prefix) || !StringUtil::EndsWith(transform, ")")) {
+		return false;
+	}
+	auto parameter_str = transform.substr(prefix.size(), transform.size() - prefix.size() - 1);
+	Value parameter_value;
+	if (!Value(parameter_str).DefaultTryCastAs(LogicalType::UBIGINT, parameter_value, nullptr) ||
+	    parameter_value.IsNull() || parameter_value.GetValue<idx_t>() == 0) {
+		throw InvalidInputException("Invalid parameter in partition transform %s", transform);
+	}
+	parameter = parameter_value.GetValue<idx_t>();
+	return true;
+}
+
+static unique_ptr<DuckLakePartition> TransformPartition(DuckLakePartitionInfo &entry) {
+	auto partition = make_uniq<DuckLakePartition>();
+	partition->partition_id = entry.id.GetIndex();
+	for (auto &field : entry.fields) {
+		DuckLakePartitionField partition_field;
+		partition_field.partition_key_index = field.partition_key_index;
+		partition_field.field_id = field.field_id;
+		if (field.transform == "year") {
+			partition_field.transform.type = DuckLakeTransformType::YEAR;
+		} else if (field.transform == "month") {
+			partition_field.transform.type = DuckLakeTransformType::MONTH;
+		} else if (field.transform == "day") {
+			partition_field.transform.type = DuckLakeTransformType::DAY;
+		} else if (field.transform == "hour") {
+			partition_field.transform.type = DuckLakeTransformType::HOUR;
+		} else if (field.transform == "identity") {
+			partition_field.transform.type = DuckLakeTransformType::IDENTITY;
+		} else if (TryParseTransformParameter(field.transform, "bucket", partition_field.transform.parameter)) {
+			partition_field.transform.type = DuckLakeTransformType::BUCKET;
+		} else if (TryParseTransformParameter(field.transform, "truncate", partition_field.transform.parameter)) {
+			partition_field.transform.type = DuckLakeTransformType::TRUNCATE;
+		} else {
+			throw InvalidInputException("Unsupported partition transform %s", field.transform);
+		}
+		partition->fields.push_back(partition_field);
+	}
+	return partition;
+}
+
+void DuckLakeCatalog::AddTableEntries(DuckLakeCatalogSet &schema_set, vector<DuckLakeTableInfo> &tables,
+                                      vector<DuckLakePartitionInfo> &partitions) {
+	auto &schema_id_map = schema_set.GetSchemaIdMap();
+	map<TableIndex, unique_ptr<DuckLakeTableEntry>> new_tables;
+	for (auto &table : tables) {
 		// find the schema for the table
 		auto entry = schema_id_map.find(table.schema_id);
 		if (entry == schema_id_map.end()) {
@@ -297,7 +554,108 @@ unique_ptr<DuckLakeCatalogSet> DuckLakeCatalog::LoadSchemaForSnapshot(DuckLakeTr
 		auto table_entry = make_uniq<DuckLakeTableEntry>(
 		    *this, schema_entry, *create_table_info, table.id, std::move(table.uuid), std::move(table.path),
 		    std::move(field_data), optional_idx(), std::move(table.inlined_data_tables), LocalChangeType::NONE);
-		schema_set->AddEntry(schema_entry, table.id, std::move(table_entry));
+		new_tables.insert(make_pair(table.id, std::move(table_entry)));
+	}
+
+	// load the partition entries
+	for (auto &entry : partitions) {
+		auto new_table = new_tables.find(entry.table_id);
+		if (new_table != new_tables.end()) {
+			new_table->second->SetPartitionData(TransformPartition(entry));
+			continue;
+		}
+		auto table = schema_set.GetEntryById(entry.table_id);
+		if (!table || table->type != CatalogType::TABLE_ENTRY) {
+			throw InvalidInputException("Could not find matching table for partition entry");
+		}
+		auto &ducklake_table = table->Cast<DuckLakeTableEntry>();
+		ducklake_table.SetPartitionData(TransformPartition(entry));
+	}
+	// add the tables only after they are fully initialized - lazily loaded tables are visible to other threads
+	for (auto &entry : new_tables) {
+		auto &schema_entry = entry.second->ParentSchema().Cast<DuckLakeSchemaEntry>();
+		schema_set.AddEntry(schema_entry, entry.first, std::move(entry.second));
+	}
+}
+
+unique_ptr<DuckLakeCatalogSet> DuckLakeCatalog::CreateSchemaSet(DuckLakeSnapshot snapshot,
+                                                                DuckLakeCatalogInfo &catalog,
+                                                                optional_ptr<DuckLakeCatalogSet> base_set,
+                                                                const set<TableIndex> &changed_entries) {
+	ducklake_entries_map_t schema_map;
+	for (auto &schema : catalog.schemas) {
+		CreateSchemaInfo schema_info;
+		schema_info.schema = schema.name;
+		auto schema_entry = make_uniq<DuckLakeSchemaEntry>(*this, schema_info, schema.id, std::move(schema.uuid),
+		                                                   std::move(schema.path));
+		schema_map.insert(make_pair(std::move(schema.name), std::move(schema_entry)));
+	}
+
+	auto schema_set = make_uniq<DuckLakeCatalogSet>(std::move(schema_map));
+	schema_set->SetSnapshot(snapshot);
+	auto &schema_id_map = schema_set->GetSchemaIdMap();
+	if (base_set) {
+		// copy over the unchanged entries from the base schema set
+		set<TableIndex> reloaded_entries = changed_entries;
+		for (auto &table : catalog.tables) {
+			reloaded_entries.insert(table.id);
+		}
+		for (auto &view : catalog.views) {
+			reloaded_entries.insert(view.id);
+		}
+		for (auto &table : catalog.lazy_tables) {
+			reloaded_entries.insert(table.id);
+		}
+		for (auto &entry : base_set->GetTableIdMap()) {
+			if (reloaded_entries.find(entry.first) != reloaded_entries.end()) {
+				continue;
+			}
+			auto &catalog_entry = entry.second.get();
+			auto &base_schema = catalog_entry.ParentSchema().Cast<DuckLakeSchemaEntry>();
+			auto schema_entry = schema_id_map.find(base_schema.GetSchemaId());
+			if (schema_entry == schema_id_map.end()) {
+				throw InternalException("Failed to load DuckLake - could not find schema for existing entry \"%s\"",
+				                        catalog_entry.name);
+			}
+			auto &new_schema = schema_entry->second.get();
+			unique_ptr<CatalogEntry> new_entry;
+			if (catalog_entry.type == CatalogType::TABLE_ENTRY) {
+				auto &table = catalog_entry.Cast<DuckLakeTableEntry>();
+				auto info = table.GetInfo();
+				new_entry = make_uniq<DuckLakeTableEntry>(table, new_schema, info->Cast<CreateTableInfo>());
+			} else {
+				auto &view = catalog_entry.Cast<DuckLakeViewEntry>();
+				CreateViewInfo view_info(new_schema, view.name);
+				view_info.aliases = view.aliases;
+				view_info.comment = view.comment;
+				view_info.tags = view.tags;
+				new_entry = make_uniq<DuckLakeViewEntry>(view, new_schema, view_info);
+			}
+			schema_set->AddEntry(new_schema, entry.first, std::move(new_entry));
+		}
+		for (auto &entry : base_set->GetLazyEntryMap()) {
+			if (reloaded_entries.find(entry.first) != reloaded_entries.end()) {
+				continue;
+			}
+			auto &base_schema = entry.second.schema.get();
+			auto schema_entry = schema_id_map.find(base_schema.GetSchemaId());
+			if (schema_entry == schema_id_map.end()) {
+				throw InternalException("Failed to load DuckLake - could not find schema for existing entry \"%s\"",
+				                        entry.second.name);
+			}
+			schema_set->AddLazyEntry(schema_entry->second.get(), entry.first, entry.second.name);
+		}
+	}
+	AddTableEntries(*schema_set, catalog.tables, catalog.partitions);
+	// register the tables that are loaded on first access
+	for (auto &table : catalog.lazy_tables) {
+		auto entry = schema_id_map.find(table.schema_id);
+		if (entry == schema_id_map.end()) {
+			throw InvalidInputException(
+			    "Failed to load DuckLake - could not find schema that corresponds to the table entry \"%s\"",
+			    table.name);
+		}
+		schema_set->AddLazyEntry(entry->second.get(), table.id, std::move(table.name));
 	}
 
 	// load the view entries
@@ -324,37 +682,25 @@ unique_ptr<DuckLakeCatalogSet> DuckLakeCatalog::LoadSchemaForSnapshot(DuckLakeTr
 		schema_set->AddEntry(schema_entry, view.id, std::move(view_entry));
 	}
 
-	// load the partition entries
-	for (auto &entry : catalog.partitions) {
-		auto table = schema_set->GetEntryById(entry.table_id);
-		if (!table || table->type != CatalogType::TABLE_ENTRY) {
-			throw InvalidInputException("Could not find matching table for partition entry");
-		}
-		auto partition = make_uniq<DuckLakePartition>();
-		partition->partition_id = entry.id.GetIndex();
-		for (auto &field : entry.fields) {
-			DuckLakePartitionField partition_field;
-			partition_field.partition_key_index = field.partition_key_index;
-			partition_field.field_id = field.field_id;
-			if (field.transform == "year") {
-				partition_field.transform.type = DuckLakeTransformType::YEAR;
-			} else if (field.transform == "month") {
-				partition_field.transform.type = DuckLakeTransformType::MONTH;
-			} else if (field.transform == "day") {
-				partition_field.transform.type = DuckLakeTransformType::DAY;
-			} else if (field.transform == "hour") {
-				partition_field.transform.type = DuckLakeTransformType::HOUR;
-			} else if (field.transform == "identity") {
-				partition_field.transform.type = DuckLakeTransformType::IDENTITY;
-			} else {
-				throw InvalidInputException("Unsupported partition transform %s", field.transform);
-			}
-			partition->fields.push_back(partition_field);
+	return schema_set;
+}
+
+void DuckLakeCatalog::LoadLazyEntries(DuckLakeTransaction &transaction, DuckLakeCatalogSet &schema_set,
+                                      const vector<TableIndex> &table_ids) {
+	lock_guard<mutex> guard(schemas_lock);
+	// another thread might have loaded (some of) the tables in the meantime
+	set<TableIndex> lazy_ids;
+	for (auto &table_id : table_ids) {
+		if (schema_set.IsLazyEntry(table_id)) {
+			lazy_ids.insert(table_id);
 		}
-		auto &ducklake_table = table->Cast<DuckLakeTableEntry>();
-		ducklake_table.SetPartitionData(std::move(partition));
 	}
-	return schema_set;
+	if (lazy_ids.empty()) {
+		return;
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto catalog = metadata_manager.GetTablesForSnapshot(schema_set.GetSnapshot(), lazy_ids);
+	AddTableEntries(schema_set, catalog.tables, catalog.partitions);
 }
 
 DuckLakeStats &DuckLakeCatalog::GetStatsForSnapshot(DuckLakeTransaction &transaction, DuckLakeSnapshot snapshot) {
@@ -363,15 +709,392 @@ DuckLakeStats &DuckLakeCatalog::GetStatsForSnapshot(DuckLakeTransaction &transac
 	auto entry = stats.find(snapshot.next_file_id);
 	if (entry != stats.end()) {
 		// this stats are already cached
-		return *entry->second;
+		entry->second.last_access = ++cache_access_count;
+		transaction.PinStats(snapshot.next_file_id, entry->second.entry);
+		return *entry->second.entry;
 	}
 	// load the stats from the metadata manager
-	auto table_stats = LoadStatsForSnapshot(transaction, snapshot, schema);
-	auto &result = *table_stats;
-	stats.insert(make_pair(snapshot.next_file_id, std::move(table_stats)));
+	DuckLakeCacheEntry<DuckLakeStats> cache_entry;
+	cache_entry.entry = shared_ptr<DuckLakeStats>(LoadStatsForSnapshot(transaction, snapshot, schema));
+	cache_entry.snapshot_id = snapshot.snapshot_id;
+	cache_entry.estimated_size = EstimateStatsSize(*cache_entry.entry);
+	cache_entry.last_access = ++cache_access_count;
+	auto &result = *cache_entry.entry;
+	transaction.PinStats(snapshot.next_file_id, cache_entry.entry);
+	cache_size += cache_entry.estimated_size;
+	stats.insert(make_pair(snapshot.next_file_id, std::move(cache_entry)));
+	EvictCacheEntries();
 	return result;
 }
 
+struct DuckLakeCachedFileList {
+	//! The snapshot at which the file list was loaded
+	idx_t snapshot_id;
+	//! The committed file list of the table at that snapshot
+	DuckLakeCompactFileList files;
+	//! Whether or not the file list can be updated incrementally - this is not possible if it contains entries that
+	//! depend on the snapshot they were loaded at (i.e. partially visible files)
+	bool incremental = true;
+};
+
+static bool FileListSupportsIncrementalUpdates(const vector<DuckLakeFileListEntry> &files) {
+	for (auto &file : files) {
+		if (file.max_row_count.IsValid() || file.snapshot_filter.IsValid()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+shared_ptr<DuckLakeCachedFileList> DuckLakeCatalog::TryUpdateFileList(DuckLakeTransaction &transaction,
+                                                                      DuckLakeTableEntry &table,
+                                                                      const DuckLakeCachedFileList &cached_list,
+                                                                      DuckLakeSnapshot snapshot) {
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto table_id = table.GetTableId();
+	DuckLakeSnapshot start_snapshot = snapshot;
+	start_snapshot.snapshot_id = cached_list.snapshot_id;
+
+	auto changes_made = metadata_manager.GetChangesMadeBetweenSnapshots(start_snapshot, snapshot);
+	if (!changes_made) {
+		return nullptr;
+	}
+	auto changes = SnapshotChangeInformation::ParseChangesMade(changes_made->changes_made);
+	if (changes.dropped_tables.find(table_id) != changes.dropped_tables.end() ||
+	    changes.tables_compacted.find(table_id) != changes.tables_compacted.end() ||
+	    changes.tables_flushed_inlined.find(table_id) != changes.tables_flushed_inlined.end()) {
+		// the files of the table were rewritten - the new files can have a begin snapshot before the start snapshot
+		// reload the file list from scratch
+		return nullptr;
+	}
+	auto result = make_shared_ptr<DuckLakeCachedFileList>();
+	result->snapshot_id = snapshot.snapshot_id;
+	if (changes.inserted_tables.find(table_id) == changes.inserted_tables.end() &&
+	    changes.tables_deleted_from.find(table_id) == changes.tables_deleted_from.end()) {
+		// no files were written to or deleted from the table - the file list is unchanged
+		result->files = cached_list.files;
+		return result;
+	}
+	auto file_changes = metadata_manager.GetFileListChanges(table, start_snapshot, snapshot);
+	if (file_changes.start_snapshot_expired) {
+		return nullptr;
+	}
+	for (auto &file : file_changes.new_files) {
+		// files that have a new delete file are listed again - remove the old entry for them
+		file_changes.removed_files.insert(file.file_id);
+	}
+	for (idx_t file_idx = 0; file_idx < cached_list.files.size(); file_idx++) {
+		if (file_changes.removed_files.find(cached_list.files.GetFileId(file_idx)) !=
+		    file_changes.removed_files.end()) {
+			continue;
+		}
+		result->files.Append(cached_list.files, file_idx);
+	}
+	result->incremental = FileListSupportsIncrementalUpdates(file_changes.new_files);
+	for (auto &file : file_changes.new_files) {
+		result->files.Append(file);
+	}
+	return result;
+}
+
+shared_ptr<DuckLakeManifestList> DuckLakeCatalog::GetManifestList(DuckLakeTransaction &transaction,
+                                                                  DuckLakeTableEntry &table) {
+	auto table_id = table.GetTableId();
+	string directory;
+	if (table_id.IsTransactionLocal() ||
+	    !TryGetConfigOption(DuckLakeManifestList::OPTION_NAME, directory, {}, table_id) || directory.empty()) {
+		return nullptr;
+	}
+	{
+		lock_guard<mutex> guard(file_list_lock);
+		auto entry = manifest_lists.find(table_id.index);
+		if (entry != manifest_lists.end() && entry->second->directory == directory) {
+			return entry->second;
+		}
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto manifest_list = metadata_manager.ReadManifestList(table, directory);
+	if (!manifest_list) {
+		return nullptr;
+	}
+	auto result = make_shared_ptr<DuckLakeManifestList>(std::move(*manifest_list));
+	lock_guard<mutex> guard(file_list_lock);
+	manifest_lists[table_id.index] = result;
+	return result;
+}
+
+//! Returns the indexes of the manifests that can contain files matching the filters
+static vector<idx_t> PruneManifests(DuckLakeTableEntry &table, const DuckLakeManifestList &manifest_list,
+                                    const vector<DuckLakeZoneMapFilter> &filters) {
+	vector<bool> keep_manifests(manifest_list.manifests.size(), true);
+	for (auto &filter : filters) {
+		auto field_id = table.GetFieldId(filter.field_index);
+		if (!field_id) {
+			continue;
+		}
+		// the partition summaries are evaluated through a zone map in which every manifest takes the place of a file
+		// the partition values of all files in a summarized manifest are non-NULL
+		vector<vector<Value>> summaries;
+		vector<DataFileIndex> manifest_ids;
+		for (idx_t manifest_idx = 0; manifest_idx < manifest_list.manifests.size(); manifest_idx++) {
+			for (auto &summary : manifest_list.manifests[manifest_idx].partition_summaries) {
+				if (summary.field_id != filter.field_index) {
+					continue;
+				}
+				summaries.push_back({Value::UBIGINT(manifest_idx), summary.min_value, summary.max_value,
+				                     Value::BIGINT(0), Value(), Value()});
+				manifest_ids.emplace_back(manifest_idx);
+			}
+		}
+		if (manifest_ids.empty()) {
+			continue;
+		}
+		DuckLakeColumnZoneMap zone_map(field_id->Type());
+		zone_map.AddFiles(summaries, manifest_list.manifests.size());
+		auto can_match = zone_map.Evaluate(*filter.filter, manifest_ids);
+		for (idx_t i = 0; i < manifest_ids.size(); i++) {
+			if (!can_match[i]) {
+				keep_manifests[manifest_ids[i].index] = false;
+			}
+		}
+	}
+	vector<idx_t> result;
+	for (idx_t manifest_idx = 0; manifest_idx < keep_manifests.size(); manifest_idx++) {
+		if (keep_manifests[manifest_idx]) {
+			result.push_back(manifest_idx);
+		}
+	}
+	return result;
+}
+
+shared_ptr<DuckLakeCachedFileList>
+DuckLakeCatalog::TryLoadFileListFromManifests(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+                                              DuckLakeSnapshot snapshot, const vector<DuckLakeZoneMapFilter> &filters,
+                                              const string &filter) {
+	auto manifest_list = GetManifestList(transaction, table);
+	if (!manifest_list || manifest_list->snapshot_id > snapshot.snapshot_id) {
+		// the manifests can only be used for snapshots at or after the snapshot at which they were written
+		return nullptr;
+	}
+	auto manifest_indexes = PruneManifests(table, *manifest_list, filters);
+	auto &metadata_manager = transaction.GetMetadataManager();
+	DuckLakeCachedFileList manifest_files;
+	manifest_files.snapshot_id = manifest_list->snapshot_id;
+	auto files = metadata_manager.ReadManifests(table, *manifest_list, manifest_indexes, filter);
+	if (!FileListSupportsIncrementalUpdates(files)) {
+		return nullptr;
+	}
+	manifest_files.files = DuckLakeCompactFileList(files);
+	if (manifest_list->snapshot_id == snapshot.snapshot_id) {
+		return make_shared_ptr<DuckLakeCachedFileList>(std::move(manifest_files));
+	}
+	// apply the changes made since the manifests were written - the files added since are not pruned
+	return TryUpdateFileList(transaction, table, manifest_files, snapshot);
+}
+
+bool DuckLakeCatalog::TryGetFilesFromManifests(DuckLakeTransaction &transaction, DuckLakeTableEntry &table,
+                                               DuckLakeSnapshot snapshot, const vector<DuckLakeZoneMapFilter> &filters,
+                                               const string &filter, vector<DuckLakeFileListEntry> &result) {
+	auto file_list = TryLoadFileListFromManifests(transaction, table, snapshot, filters, filter);
+	if (!file_list) {
+		return false;
+	}
+	result = file_list->files.GetEntries();
+	return true;
+}
+
+struct DuckLakeFileListLoad {
+	bool finished = false;
+	//! The loaded file list - nullptr if the load failed
+	shared_ptr<DuckLakeCachedFileList> result;
+};
+
+shared_ptr<DuckLakeCachedFileList> DuckLakeCatalog::LoadFileList(DuckLakeTransaction &transaction,
+                                                                 DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+                                                                 const shared_ptr<DuckLakeCachedFileList> &cached_list,
+                                                                 vector<DuckLakeFileListEntry> &loaded_files) {
+	shared_ptr<DuckLakeCachedFileList> new_list;
+	if (cached_list && cached_list->incremental && cached_list->snapshot_id < snapshot.snapshot_id) {
+		// we have an older file list cached - try to bring it up-to-date by only reading the changes
+		new_list = TryUpdateFileList(transaction, table, *cached_list, snapshot);
+	}
+	if (!new_list) {
+		// if the table has manifests - read the bulk of the file list from them rather than from the metadata catalog
+		vector<DuckLakeZoneMapFilter> no_filters;
+		new_list = TryLoadFileListFromManifests(transaction, table, snapshot, no_filters, string());
+	}
+	if (!new_list) {
+		// load the full file list from the metadata manager
+		auto &metadata_manager = transaction.GetMetadataManager();
+		new_list = make_shared_ptr<DuckLakeCachedFileList>();
+		new_list->snapshot_id = snapshot.snapshot_id;
+		loaded_files = metadata_manager.GetFilesForTable(table, snapshot, string());
+		new_list->incremental = FileListSupportsIncrementalUpdates(loaded_files);
+		new_list->files = DuckLakeCompactFileList(loaded_files);
+	}
+	return new_list;
+}
+
+void DuckLakeCatalog::FinishFileListLoad(TableIndex table_id, idx_t snapshot_id,
+                                         const shared_ptr<DuckLakeFileListLoad> &load,
+                                         shared_ptr<DuckLakeCachedFileList> result) {
+	if (!load) {
+		return;
+	}
+	{
+		lock_guard<mutex> guard(file_list_lock);
+		load->result = std::move(result);
+		load->finished = true;
+		auto &table_loads = file_list_loads[table_id.index];
+		table_loads.erase(snapshot_id);
+		if (table_loads.empty()) {
+			file_list_loads.erase(table_id.index);
+		}
+	}
+	file_list_cv.notify_all();
+}
+
+vector<DuckLakeFileListEntry> DuckLakeCatalog::GetFilesForTable(DuckLakeTransaction &transaction,
+                                                                DuckLakeTableEntry &table, DuckLakeSnapshot snapshot) {
+	auto table_id = table.GetTableId();
+	shared_ptr<DuckLakeCachedFileList> cached_list;
+	shared_ptr<DuckLakeFileListLoad> load;
+	{
+		unique_lock<mutex> guard(file_list_lock);
+		auto entry = file_lists.find(table_id.index);
+		if (entry != file_lists.end()) {
+			cached_list = entry->second;
+		}
+		if (options.shared_scans && (!cached_list || cached_list->snapshot_id != snapshot.snapshot_id)) {
+			auto &table_loads = file_list_loads[table_id.index];
+			auto load_entry = table_loads.find(snapshot.snapshot_id);
+			if (load_entry != table_loads.end()) {
+				// another scan is loading the file list of this table at this snapshot - wait for it instead
+				auto in_flight = load_entry->second;
+				file_list_cv.wait(guard, [&]() { return in_flight->finished; });
+				if (in_flight->result) {
+					cached_list = in_flight->result;
+				}
+				// if the other load failed we load the file list ourselves
+			} else {
+				load = make_shared_ptr<DuckLakeFileListLoad>();
+				table_loads[snapshot.snapshot_id] = load;
+			}
+		}
+	}
+	if (cached_list && cached_list->snapshot_id == snapshot.snapshot_id) {
+		// the file list for this snapshot is already cached
+		return cached_list->files.GetEntries();
+	}
+	shared_ptr<DuckLakeCachedFileList> new_list;
+	vector<DuckLakeFileListEntry> loaded_files;
+	try {
+		new_list = LoadFileList(transaction, table, snapshot, cached_list, loaded_files);
+	} catch (...) {
+		FinishFileListLoad(table_id, snapshot.snapshot_id, load, nullptr);
+		throw;
+	}
+	{
+		// only replace the cached list if we are newer - time travel queries should not evict the latest list
+		lock_guard<mutex> guard(file_list_lock);
+		auto &current = file_lists[table_id.index];
+		if (!current || current->snapshot_id < new_list->snapshot_id) {
+			current = new_list;
+		}
+	}
+	FinishFileListLoad(table_id, snapshot.snapshot_id, load, new_list);
+	if (!loaded_files.empty()) {
+		// we just loaded the full file list - no need to materialize it again
+		return loaded_files;
+	}
+	return new_list->files.GetEntries();
+}
+
+bool DuckLakeCatalog::TryGetAtClauseSnapshot(const Value &at_clause, DuckLakeSnapshot &result) {
+	lock_guard<mutex> guard(at_clause_lock);
+	auto entry = at_clause_snapshots.find(at_clause);
+	if (entry == at_clause_snapshots.end()) {
+		return false;
+	}
+	result = entry->second;
+	return true;
+}
+
+void DuckLakeCatalog::CacheAtClauseSnapshot(Value at_clause, DuckLakeSnapshot snapshot) {
+	//! The maximum amount of distinct AT clauses that are cached
+	static constexpr const idx_t MAX_CACHED_AT_CLAUSES = 4096;
+	lock_guard<mutex> guard(at_clause_lock);
+	if (at_clause_snapshots.size() >= MAX_CACHED_AT_CLAUSES) {
+		// the lookups are cheap to redo - start over rather than tracking which entries are still used
+		at_clause_snapshots.clear();
+	}
+	at_clause_snapshots[std::move(at_clause)] = snapshot;
+}
+
+void DuckLakeCatalog::EvictAtClauseSnapshots(const vector<DuckLakeSnapshotInfo> &snapshots) {
+	unordered_set<idx_t> snapshot_ids;
+	for (auto &snapshot : snapshots) {
+		snapshot_ids.insert(snapshot.id);
+	}
+	lock_guard<mutex> guard(at_clause_lock);
+	for (auto entry = at_clause_snapshots.begin(); entry != at_clause_snapshots.end();) {
+		if (snapshot_ids.find(entry->second.snapshot_id) != snapshot_ids.end()) {
+			entry = at_clause_snapshots.erase(entry);
+		} else {
+			++entry;
+		}
+	}
+}
+
+shared_ptr<DuckLakeColumnZoneMap> DuckLakeCatalog::GetZoneMap(DuckLakeTransaction &transaction,
+                                                             DuckLakeTableEntry &table, const DuckLakeFieldId &field_id,
+                                                             DuckLakeSnapshot snapshot) {
+	auto &type = field_id.Type();
+	if (!DuckLakeColumnZoneMap::SupportsType(type)) {
+		return nullptr;
+	}
+	auto table_id = table.GetTableId();
+	auto column_id = field_id.GetFieldIndex();
+	shared_ptr<DuckLakeColumnZoneMap> zone_map;
+	{
+		lock_guard<mutex> guard(zone_map_lock);
+		auto &entry = zone_maps[table_id.index][column_id.index];
+		if (!entry || entry->GetType() != type) {
+			// no zone map yet - or the type of the column was changed
+			entry = make_shared_ptr<DuckLakeColumnZoneMap>(type);
+		}
+		zone_map = entry;
+	}
+	// the stats of a data file never change - we only need to load the stats of files added since the last load
+	auto loaded_file_id = zone_map->GetLoadedFileId();
+	if (loaded_file_id >= snapshot.next_file_id) {
+		return zone_map;
+	}
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT data_file_id, min_value, max_value, null_count, value_count, contains_nan
+FROM {METADATA_CATALOG}.ducklake_file_column_stats
+WHERE table_id=%d AND column_id=%d AND data_file_id >= %d AND data_file_id < %d
+)",
+	                                                   table_id.index, column_id.index, loaded_file_id,
+	                                                   snapshot.next_file_id));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to load zone map from DuckLake: ");
+	}
+	vector<vector<Value>> file_stats;
+	for (auto &row : *result) {
+		vector<Value> stats;
+		stats.push_back(Value::UBIGINT(row.GetValue<idx_t>(0)));
+		stats.push_back(row.IsNull(1) ? Value() : Value(row.GetValue<string>(1)));
+		stats.push_back(row.IsNull(2) ? Value() : Value(row.GetValue<string>(2)));
+		stats.push_back(row.IsNull(3) ? Value() : Value::BIGINT(row.GetValue<int64_t>(3)));
+		stats.push_back(row.IsNull(4) ? Value() : Value::BIGINT(row.GetValue<int64_t>(4)));
+		stats.push_back(row.IsNull(5) ? Value() : Value::BOOLEAN(row.GetValue<bool>(5)));
+		file_stats.push_back(std::move(stats));
+	}
+	zone_map->AddFiles(file_stats, snapshot.next_file_id);
+	return zone_map;
+}
+
 static unique_ptr<DuckLakeNameMap> ConvertNameMap(DuckLakeColumnMappingInfo column_mapping) {
 	if (column_mapping.map_type != "map_by_name") {
 		throw InvalidInputException("Unsupported column mapping type \"%s\"", column_mapping.map_type);
@@ -425,7 +1148,7 @@ void DuckLakeCatalog::LoadNameMaps(DuckLakeTransaction &transaction) {
 
 optional_ptr<const DuckLakeNameMap> DuckLakeCatalog::TryGetMappingById(DuckLakeTransaction &transaction,
                                                                        MappingIndex mapping_id) {
-	lock_guard<mutex> guard(schemas_lock);
+	lock_guard<mutex> guard(name_maps_lock);
 	auto entry = name_maps.name_maps.find(mapping_id);
 	if (entry != name_maps.name_maps.end()) {
 		return entry->second.get();
@@ -442,64 +1165,261 @@ optional_ptr<const DuckLakeNameMap> DuckLakeCatalog::TryGetMappingById(DuckLakeT
 
 MappingIndex DuckLakeCatalog::TryGetCompatibleNameMap(DuckLakeTransaction &transaction,
                                                       const DuckLakeNameMap &name_map) {
-	lock_guard<mutex> guard(schemas_lock);
+	lock_guard<mutex> guard(name_maps_lock);
 	LoadNameMaps(transaction);
 	return name_maps.TryGetCompatibleNameMap(name_map);
 }
 
-unique_ptr<DuckLakeStats> DuckLakeCatalog::LoadStatsForSnapshot(DuckLakeTransaction &transaction,
-                                                                DuckLakeSnapshot snapshot, DuckLakeCatalogSet &schema) {
-	auto &metadata_manager = transaction.GetMetadataManager();
-	auto global_stats = metadata_manager.GetGlobalTableStats(snapshot);
+static shared_ptr<DuckLakeTableStats> CreateTableStats(DuckLakeGlobalStatsInfo &stats, DuckLakeTableEntry &table) {
+	auto table_stats = make_shared_ptr<DuckLakeTableStats>();
+	table_stats->record_count = stats.record_count;
+	table_stats->next_row_id = stats.next_row_id;
+	table_stats->table_size_bytes = stats.table_size_bytes;
+	for (auto &col_stats : stats.column_stats) {
+		auto field = table.GetFieldId(col_stats.column_id);
+		if (!field) {
+			// column that this field id references was deleted
+			continue;
+		}
+		DuckLakeColumnStats column_stats(field->Type());
+		column_stats.has_null_count = col_stats.has_contains_null;
+		if (column_stats.has_null_count) {
+			column_stats.null_count = col_stats.contains_null ? 1 : 0;
+		}
+		column_stats.has_contains_nan = col_stats.has_contains_nan;
+		if (column_stats.has_contains_nan) {
+			column_stats.contains_nan = col_stats.contains_nan;
+		}
+		column_stats.has_min = col_stats.has_min;
+		if (column_stats.has_min) {
+			column_stats.min = col_stats.min_val;
+		}
+		column_stats.has_max = col_stats.has_max;
+		if (column_stats.has_max) {
+			column_stats.max = col_stats.max_val;
+		}
+		if (col_stats.has_extra_stats && !column_stats.extra_stats &&
+		    DuckLakeColumnHistogramStats::IsHistogram(col_stats.extra_stats)) {
+			column_stats.extra_stats = make_uniq<DuckLakeColumnHistogramStats>();
+		}
+		if (col_stats.has_extra_stats && column_stats.extra_stats) {
+			// The extra_stats should already be allocated in the constructor
+			// if the logical type requires extra stats.
+			column_stats.extra_stats->Deserialize(col_stats.extra_stats);
+		}
+		// the table stats are shared between connections - parse the min/max before they are shared
+		column_stats.InitializeTypedStats();
+		table_stats->column_stats.insert(make_pair(col_stats.column_id, std::move(column_stats)));
+	}
+	return table_stats;
+}
 
-	// construct the stats map
-	auto lake_stats = make_uniq<DuckLakeStats>();
+static void AddTableStats(DuckLakeStats &lake_stats, vector<DuckLakeGlobalStatsInfo> &global_stats,
+                          DuckLakeCatalogSet &schema) {
 	for (auto &stats : global_stats) {
 		// find the referenced table entry
 		auto table_entry = schema.GetEntryById(stats.table_id);
+		if (!table_entry && schema.IsLazyEntry(stats.table_id)) {
+			// the table has not been loaded yet - convert the stats when they are first used
+			lake_stats.lazy_table_stats[stats.table_id] = make_shared_ptr<DuckLakeGlobalStatsInfo>(std::move(stats));
+			continue;
+		}
 		if (!table_entry) {
 			// failed to find the referenced table entry - this means the table does not exist for this snapshot
 			// since the global stats are not versioned this is not an error - just skip
 			continue;
 		}
-		auto table_stats = make_uniq<DuckLakeTableStats>();
-		table_stats->record_count = stats.record_count;
-		table_stats->next_row_id = stats.next_row_id;
-		table_stats->table_size_bytes = stats.table_size_bytes;
 		auto &table = table_entry->Cast<DuckLakeTableEntry>();
-		for (auto &col_stats : stats.column_stats) {
-			auto field = table.GetFieldId(col_stats.column_id);
-			if (!field) {
-				// column that this field id references was deleted
+		lake_stats.table_stats[stats.table_id] = CreateTableStats(stats, table);
+	}
+}
+
+unique_ptr<DuckLakeStats> DuckLakeCatalog::LoadStatsForSnapshot(DuckLakeTransaction &transaction,
+                                                                DuckLakeSnapshot snapshot, DuckLakeCatalogSet &schema) {
+	auto result = LoadStatsChanges(transaction, snapshot, schema);
+	if (result) {
+		return result;
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto global_stats = metadata_manager.GetGlobalTableStats(snapshot);
+	timestamp_tz_t snapshot_time;
+	if (metadata_cache &&
+	    (metadata_cache->stats_snapshot.snapshot_id == DConstants::INVALID_INDEX ||
+	     snapshot.snapshot_id > metadata_cache->stats_snapshot.snapshot_id) &&
+	    TryGetSnapshotTime(metadata_manager, snapshot, snapshot_time)) {
+		metadata_cache->stats = global_stats;
+		metadata_cache->stats_snapshot = snapshot;
+		metadata_cache->stats_snapshot_time = snapshot_time;
+	}
+
+	// construct the stats map
+	auto lake_stats = make_uniq<DuckLakeStats>();
+	AddTableStats(*lake_stats, global_stats, schema);
+	return lake_stats;
+}
+
+unique_ptr<DuckLakeStats> DuckLakeCatalog::LoadStatsChanges(DuckLakeTransaction &transaction,
+                                                            DuckLakeSnapshot snapshot, DuckLakeCatalogSet &schema) {
+	// find the most recent stats we have loaded before this snapshot
+	optional_ptr<DuckLakeStats> base_stats;
+	DuckLakeSnapshot base_snapshot = snapshot;
+	for (auto &entry : stats) {
+		auto snapshot_id = entry.second.snapshot_id;
+		if (snapshot_id >= snapshot.snapshot_id) {
+			continue;
+		}
+		if (!base_stats || snapshot_id > base_snapshot.snapshot_id) {
+			base_stats = entry.second.entry.get();
+			base_snapshot.snapshot_id = snapshot_id;
+		}
+	}
+	if (!base_stats) {
+		return nullptr;
+	}
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto changes_made = metadata_manager.GetChangesMadeBetweenSnapshots(base_snapshot, snapshot);
+	if (!changes_made) {
+		// the changes are no longer available
+		return nullptr;
+	}
+	auto changes = SnapshotChangeInformation::ParseChangesMade(changes_made->changes_made);
+	// gather the tables whose stats might have changed - tables that are created with data are also inserted into
+	set<TableIndex> changed_tables;
+	changed_tables.insert(changes.inserted_tables.begin(), changes.inserted_tables.end());
+	changed_tables.insert(changes.tables_deleted_from.begin(), changes.tables_deleted_from.end());
+	changed_tables.insert(changes.tables_compacted.begin(), changes.tables_compacted.end());
+	changed_tables.insert(changes.tables_inserted_inlined.begin(), changes.tables_inserted_inlined.end());
+	changed_tables.insert(changes.tables_deleted_inlined.begin(), changes.tables_deleted_inlined.end());
+	changed_tables.insert(changes.tables_flushed_inlined.begin(), changes.tables_flushed_inlined.end());
+	changed_tables.insert(changes.altered_tables.begin(), changes.altered_tables.end());
+	changed_tables.insert(changes.dropped_tables.begin(), changes.dropped_tables.end());
+	// carry over the stats of all unchanged tables
+	auto lake_stats = make_uniq<DuckLakeStats>();
+	for (auto &entry : base_stats->table_stats) {
+		if (changed_tables.find(entry.first) != changed_tables.end()) {
+			continue;
+		}
+		lake_stats->table_stats.insert(entry);
+	}
+	for (auto &entry : base_stats->lazy_table_stats) {
+		if (changed_tables.find(entry.first) != changed_tables.end()) {
+			continue;
+		}
+		lake_stats->lazy_table_stats.insert(entry);
+	}
+	// reload the stats of the changed tables
+	auto global_stats = metadata_manager.GetGlobalTableStats(snapshot, changed_tables);
+	timestamp_tz_t snapshot_time;
+	if (metadata_cache && metadata_cache->stats_snapshot.snapshot_id == base_snapshot.snapshot_id &&
+	    snapshot.snapshot_id > metadata_cache->stats_snapshot.snapshot_id &&
+	    TryGetSnapshotTime(metadata_manager, snapshot, snapshot_time)) {
+		metadata_cache->ApplyStatsChanges(global_stats, changed_tables, snapshot, snapshot_time);
+	}
+	AddTableStats(*lake_stats, global_stats, schema);
+	return lake_stats;
+}
+
+void DuckLakeCatalog::LoadMetadataCache(DuckLakeTransaction &transaction) {
+	if (options.catalog_cache_path.empty()) {
+		return;
+	}
+	auto &fs = FileSystem::GetFileSystem(GetDatabase());
+	auto cache = DuckLakeMetadataCache::TryRead(fs, options.catalog_cache_path);
+	auto &metadata_manager = transaction.GetMetadataManager();
+	if (!cache || cache->metadata_path != options.metadata_path || cache->data_path != options.data_path ||
+	    cache->snapshot.snapshot_id == DConstants::INVALID_INDEX ||
+	    !SnapshotTimeMatches(metadata_manager, cache->snapshot, cache->snapshot_time)) {
+		// the cache does not exist, belongs to a different DuckLake or its snapshot was expired (or belongs to a
+		// DuckLake that was recreated at the same path) - start from scratch
+		metadata_cache = make_uniq<DuckLakeMetadataCache>();
+		metadata_cache->metadata_path = options.metadata_path;
+		metadata_cache->data_path = options.data_path;
+		return;
+	}
+	// install the cached schema version - changes made since the cached snapshot are loaded on top of it
+	auto catalog_info = cache->catalog;
+	DuckLakeCacheEntry<DuckLakeCatalogSet> schema_entry;
+	schema_entry.entry =
+	    shared_ptr<DuckLakeCatalogSet>(CreateSchemaSet(cache->snapshot, catalog_info, nullptr, set<TableIndex>()));
+	schema_entry.snapshot_id = cache->snapshot.snapshot_id;
+	schema_entry.estimated_size = EstimateSchemaSize(*schema_entry.entry);
+
+	lock_guard<mutex> guard(schemas_lock);
+	// the stats can only be installed if they were loaded for the same schema version
+	auto &stats_snapshot = cache->stats_snapshot;
+	if (stats_snapshot.snapshot_id != DConstants::INVALID_INDEX &&
+	    stats_snapshot.schema_version == cache->snapshot.schema_version &&
+	    SnapshotTimeMatches(metadata_manager, stats_snapshot, cache->stats_snapshot_time)) {
+		DuckLakeCacheEntry<DuckLakeStats> stats_entry;
+		stats_entry.entry = make_shared_ptr<DuckLakeStats>();
+		auto global_stats = cache->stats;
+		AddTableStats(*stats_entry.entry, global_stats, *schema_entry.entry);
+		stats_entry.snapshot_id = stats_snapshot.snapshot_id;
+		stats_entry.estimated_size = EstimateStatsSize(*stats_entry.entry);
+		stats_entry.last_access = ++cache_access_count;
+		cache_size += stats_entry.estimated_size;
+		stats.insert(make_pair(stats_snapshot.next_file_id, std::move(stats_entry)));
+	} else {
+		cache->stats.clear();
+		cache->stats_snapshot = DuckLakeSnapshot();
+	}
+	schema_entry.last_access = ++cache_access_count;
+	cache_size += schema_entry.estimated_size;
+	schemas.insert(make_pair(cache->snapshot.schema_version, std::move(schema_entry)));
+	{
+		lock_guard<mutex> file_list_guard(file_list_lock);
+		for (auto &file_list : cache->file_lists) {
+			auto cached_list = make_shared_ptr<DuckLakeCachedFileList>();
+			cached_list->snapshot_id = file_list.snapshot_id;
+			cached_list->files = DuckLakeCompactFileList(file_list.files);
+			file_lists[file_list.table_id.index] = std::move(cached_list);
+		}
+		cache->file_lists.clear();
+	}
+	metadata_cache = std::move(cache);
+	EvictCacheEntries();
+}
+
+void DuckLakeCatalog::WriteMetadataCache() {
+	lock_guard<mutex> guard(schemas_lock);
+	if (!metadata_cache || metadata_cache->snapshot.snapshot_id == DConstants::INVALID_INDEX) {
+		return;
+	}
+	{
+		// only file lists that can be updated incrementally are worth caching
+		lock_guard<mutex> file_list_guard(file_list_lock);
+		metadata_cache->file_lists.clear();
+		for (auto &entry : file_lists) {
+			auto &cached_list = *entry.second;
+			if (!cached_list.incremental) {
 				continue;
 			}
-			DuckLakeColumnStats column_stats(field->Type());
-			column_stats.has_null_count = col_stats.has_contains_null;
-			if (column_stats.has_null_count) {
-				column_stats.null_count = col_stats.contains_null ? 1 : 0;
-			}
-			column_stats.has_contains_nan = col_stats.has_contains_nan;
-			if (column_stats.has_contains_nan) {
-				column_stats.contains_nan = col_stats.contains_nan;
-			}
-			column_stats.has_min = col_stats.has_min;
-			if (column_stats.has_min) {
-				column_stats.min = col_stats.min_val;
-			}
-			column_stats.has_max = col_stats.has_max;
-			if (column_stats.has_max) {
-				column_stats.max = col_stats.max_val;
+			DuckLakeMetadataCacheFileList file_list;
+			file_list.table_id = TableIndex(entry.first);
+			file_list.snapshot_id = cached_list.snapshot_id;
+			file_list.files = cached_list.files.GetEntries();
+			bool encrypted = false;
+			for (auto &file : file_list.files) {
+				if (!file.file.encryption_key.empty() || !file.delete_file.encryption_key.empty()) {
+					encrypted = true;
+					break;
+				}
 			}
-			if (col_stats.has_extra_stats && column_stats.extra_stats) {
-				// The extra_stats should already be allocated in the constructor
-				// if the logical type requires extra stats.
-				column_stats.extra_stats->Deserialize(col_stats.extra_stats);
+			if (encrypted) {
+				// the encryption keys of the files must not be written to the local disk - the file list of the table
+				// is loaded from the metadata catalog instead
+				continue;
 			}
-			table_stats->column_stats.insert(make_pair(col_stats.column_id, std::move(column_stats)));
+			metadata_cache->file_lists.push_back(std::move(file_list));
 		}
-		lake_stats->table_stats.insert(make_pair(stats.table_id, std::move(table_stats)));
 	}
-	return lake_stats;
+	try {
+		auto &fs = FileSystem::GetFileSystem(GetDatabase());
+		metadata_cache->Write(fs, options.catalog_cache_path);
+	} catch (std::exception &ex) {
+		// the metadata cache is only an optimization - failing to write it is not an error
+	}
+	metadata_cache->file_lists.clear();
 }
 
 optional_ptr<DuckLakeTableStats> DuckLakeCatalog::GetTableStats(DuckLakeTransaction &transaction, TableIndex table_id) {
@@ -509,11 +1429,34 @@ optional_ptr<DuckLakeTableStats> DuckLakeCatalog::GetTableStats(DuckLakeTransact
 optional_ptr<DuckLakeTableStats> DuckLakeCatalog::GetTableStats(DuckLakeTransaction &transaction,
                                                                 DuckLakeSnapshot snapshot, TableIndex table_id) {
 	auto &lake_stats = GetStatsForSnapshot(transaction, snapshot);
+	{
+		lock_guard<mutex> guard(schemas_lock);
+		auto entry = lake_stats.table_stats.find(table_id);
+		if (entry != lake_stats.table_stats.end()) {
+			return entry->second.get();
+		}
+		if (lake_stats.lazy_table_stats.find(table_id) == lake_stats.lazy_table_stats.end()) {
+			return nullptr;
+		}
+	}
+	// the stats belong to a table that was not loaded yet - load the table so we can convert the stats
+	auto &schema = GetSchemaForSnapshot(transaction, snapshot);
+	auto table_entry = GetCommittedEntryById(transaction, schema, table_id);
+	lock_guard<mutex> guard(schemas_lock);
 	auto entry = lake_stats.table_stats.find(table_id);
-	if (entry == lake_stats.table_stats.end()) {
+	if (entry != lake_stats.table_stats.end()) {
+		return entry->second.get();
+	}
+	auto lazy_entry = lake_stats.lazy_table_stats.find(table_id);
+	if (!table_entry || table_entry->type != CatalogType::TABLE_ENTRY ||
+	    lazy_entry == lake_stats.lazy_table_stats.end()) {
 		return nullptr;
 	}
-	return entry->second.get();
+	auto table_stats = CreateTableStats(*lazy_entry->second, table_entry->Cast<DuckLakeTableEntry>());
+	auto result = table_stats.get();
+	lake_stats.table_stats[table_id] = std::move(table_stats);
+	lake_stats.lazy_table_stats.erase(lazy_entry);
+	return result;
 }
 
 optional_ptr<SchemaCatalogEntry> DuckLakeCatalog::LookupSchema(CatalogTransaction transaction,
@@ -579,7 +1522,8 @@ void DuckLakeCatalog::SetEncryption(DuckLakeEncryption new_encryption) {
 unique_ptr<LogicalOperator> DuckLakeCatalog::BindCreateIndex(Binder &binder, CreateStatement &stmt,
                                                              TableCatalogEntry &table,
                                                              unique_ptr<LogicalOperator> plan) {
-	throw NotImplementedException("DuckLake does not support indexes");
+	auto &info = stmt.info->Cast<CreateIndexInfo>();
+	return DuckLakeCreateIndex::Bind(binder, info, table.Cast<DuckLakeTableEntry>());
 }
 
 DatabaseSize DuckLakeCatalog::GetDatabaseSize(ClientContext &context) {
@@ -611,9 +1555,112 @@ optional_ptr<BoundAtClause> DuckLakeCatalog::CatalogSnapshot() const {
 }
 
 void DuckLakeCatalog::OnDetach(ClientContext &context) {
+	if (insert_buffer->HasBufferedRows()) {
+		// write any buffered inserts before detaching - they are lost otherwise
+		Connection con(GetDatabase());
+		auto catalog_name = KeywordHelper::WriteQuoted(GetName(), '\'');
+		auto result = con.Query("CALL ducklake_flush_insert_buffer(" + catalog_name + ")");
+		if (result->HasError()) {
+			result->ThrowError("Failed to write the buffered inserts before detaching: ");
+		}
+	}
+	// release any inserts that are still waiting for their rows to be written
+	insert_buffer->Shutdown();
+	// stop the background maintenance
+	background_maintenance->Stop();
+	WriteMetadataCache();
+	// close any idle metadata connections before detaching the metadata database
+	ClearConnectionPool();
 	// detach the metadata database
 	auto &db_manager = DatabaseManager::Get(context);
 	db_manager.DetachDatabase(context, MetadataDatabaseName(), OnEntryNotFound::RETURN_NULL);
+	if (!MetadataReplicaDatabaseName().empty()) {
+		db_manager.DetachDatabase(context, MetadataReplicaDatabaseName(), OnEntryNotFound::RETURN_NULL);
+	}
+}
+
+unique_ptr<DuckLakeMetadataConnection> DuckLakeCatalog::BorrowConnection() {
+	lock_guard<mutex> guard(connection_pool_lock);
+	borrowed_connections++;
+	if (connection_pool.empty()) {
+		return nullptr;
+	}
+	auto result = std::move(connection_pool.back());
+	connection_pool.pop_back();
+	return result;
+}
+
+void DuckLakeCatalog::ReturnConnection(unique_ptr<DuckLakeMetadataConnection> connection) {
+	// connections are destroyed outside of the lock
+	vector<unique_ptr<DuckLakeMetadataConnection>> closed_connections;
+	lock_guard<mutex> guard(connection_pool_lock);
+	if (borrowed_connections == 0) {
+		throw InternalException("DuckLakeCatalog::ReturnConnection called without a borrowed connection");
+	}
+	borrowed_connections--;
+	if (borrowed_connections == 0) {
+		// no other transactions are using the metadata catalog - close all idle connections
+		// a connection keeps the database instance alive, so idle connections are only kept while there are other
+		// active connections that will eventually return them
+		closed_connections = std::move(connection_pool);
+		connection_pool.clear();
+		return;
+	}
+	if (!connection || !connection->connection || connection->connection->HasActiveTransaction()) {
+		return;
+	}
+	if (connection_pool.size() >= options.metadata_connection_pool_size) {
+		return;
+	}
+	connection_pool.push_back(std::move(connection));
+}
+
+void DuckLakeCatalog::ClearConnectionPool() {
+	vector<unique_ptr<DuckLakeMetadataConnection>> closed_connections;
+	lock_guard<mutex> guard(connection_pool_lock);
+	closed_connections = std::move(connection_pool);
+	connection_pool.clear();
+}
+
+static idx_t GetSteadyTimeMs() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return NumericCast<idx_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+unique_ptr<DuckLakeSnapshot> DuckLakeCatalog::TryGetLatestSnapshot() {
+	if (options.snapshot_staleness_ms == 0 && !exclusive_metadata) {
+		return nullptr;
+	}
+	lock_guard<mutex> guard(latest_snapshot_lock);
+	if (!latest_snapshot) {
+		return nullptr;
+	}
+	if (!exclusive_metadata && GetSteadyTimeMs() - latest_snapshot_time > options.snapshot_staleness_ms) {
+		return nullptr;
+	}
+	return make_uniq<DuckLakeSnapshot>(*latest_snapshot);
+}
+
+void DuckLakeCatalog::SetLatestSnapshot(DuckLakeSnapshot snapshot) {
+	if (options.snapshot_staleness_ms == 0 && !exclusive_metadata) {
+		return;
+	}
+	lock_guard<mutex> guard(latest_snapshot_lock);
+	if (latest_snapshot && latest_snapshot->snapshot_id > snapshot.snapshot_id) {
+		// we have already observed a more recent snapshot
+		return;
+	}
+	latest_snapshot = make_uniq<DuckLakeSnapshot>(snapshot);
+	latest_snapshot_time = GetSteadyTimeMs();
+}
+
+idx_t DuckLakeCatalog::GetCommittedCatalogVersion(idx_t schema_version) {
+	lock_guard<mutex> guard(schemas_lock);
+	auto entry = evicted_schema_versions.find(schema_version);
+	if (entry == evicted_schema_versions.end()) {
+		return schema_version;
+	}
+	return entry->second;
 }
 
 optional_idx DuckLakeCatalog::GetCatalogVersion(ClientContext &context) {
@@ -681,10 +1728,47 @@ bool DuckLakeCatalog::TryGetConfigOption(const string &option, string &result, D
 	return TryGetConfigOption(option, result, schema_id, table_id);
 }
 
+bool DuckLakeCatalog::HasConfigOption(const string &option) const {
+	lock_guard<mutex> guard(config_lock);
+	if (options.config_options.find(option) != options.config_options.end()) {
+		return true;
+	}
+	for (auto &entry : options.schema_options) {
+		if (entry.second.find(option) != entry.second.end()) {
+			return true;
+		}
+	}
+	for (auto &entry : options.table_options) {
+		if (entry.second.find(option) != entry.second.end()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 idx_t DuckLakeCatalog::DataInliningRowLimit(SchemaIndex schema_index, TableIndex table_index) const {
 	return GetConfigOption<idx_t>("data_inlining_row_limit", schema_index, table_index, 0);
 }
 
+idx_t DuckLakeCatalog::DeleteInliningRowLimit(SchemaIndex schema_index, TableIndex table_index) const {
+	return GetConfigOption<idx_t>("delete_inlining_row_limit", schema_index, table_index, 0);
+}
+
+DuckLakeInsertBufferLimits DuckLakeCatalog::InsertBufferLimits(SchemaIndex schema_index, TableIndex table_index) const {
+	DuckLakeInsertBufferLimits result;
+	result.row_limit = GetConfigOption<idx_t>("insert_buffer_row_limit", schema_index, table_index, 0);
+	result.size_limit = GetConfigOption<idx_t>("insert_buffer_size", schema_index, table_index, 0);
+	auto flush_interval = GetConfigOption<string>("insert_buffer_flush_interval", schema_index, table_index, "");
+	interval_t interval;
+	if (!flush_interval.empty() && Interval::FromString(flush_interval, interval)) {
+		auto interval_us = Interval::GetMicro(interval);
+		result.flush_interval_us = interval_us > 0 ? NumericCast<idx_t>(interval_us) : 0;
+	}
+	auto ack_mode = GetConfigOption<string>("insert_buffer_ack_mode", schema_index, table_index, "buffered");
+	result.wait_for_commit = ack_mode == "committed";
+	return result;
+}
+
 unique_ptr<LogicalOperator> DuckLakeCatalog::BindAlterAddIndex(Binder &binder, TableCatalogEntry &table_entry,
                                                                unique_ptr<LogicalOperator> plan,
                                                                unique_ptr<CreateIndexInfo> create_info,
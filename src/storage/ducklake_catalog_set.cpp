@@ -16,7 +16,9 @@ DuckLakeCatalogSet::DuckLakeCatalogSet(ducklake_entries_map_t catalog_entries_p)
 }
 
 void DuckLakeCatalogSet::CreateEntry(unique_ptr<CatalogEntry> catalog_entry) {
+	lock_guard<mutex> guard(entry_lock);
 	auto name = catalog_entry->name;
+	lazy_entries.erase(name);
 	auto entry = catalog_entries.find(name);
 	if (entry != catalog_entries.end()) {
 		catalog_entry->SetChild(std::move(entry->second));
@@ -25,6 +27,7 @@ void DuckLakeCatalogSet::CreateEntry(unique_ptr<CatalogEntry> catalog_entry) {
 }
 
 unique_ptr<CatalogEntry> DuckLakeCatalogSet::DropEntry(const string &name) {
+	lock_guard<mutex> guard(entry_lock);
 	auto entry = catalog_entries.find(name);
 	auto catalog_entry = std::move(entry->second);
 	catalog_entries.erase(entry);
@@ -32,6 +35,7 @@ unique_ptr<CatalogEntry> DuckLakeCatalogSet::DropEntry(const string &name) {
 }
 
 optional_ptr<CatalogEntry> DuckLakeCatalogSet::GetEntry(const string &name) {
+	lock_guard<mutex> guard(entry_lock);
 	auto entry = catalog_entries.find(name);
 	if (entry == catalog_entries.end()) {
 		return nullptr;
@@ -49,6 +53,7 @@ optional_ptr<CatalogEntry> DuckLakeCatalogSet::GetEntryById(SchemaIndex index) {
 }
 
 optional_ptr<CatalogEntry> DuckLakeCatalogSet::GetEntryById(TableIndex index) {
+	lock_guard<mutex> guard(entry_lock);
 	auto entry = table_entry_map.find(index);
 	if (entry == table_entry_map.end()) {
 		return nullptr;
@@ -58,9 +63,45 @@ optional_ptr<CatalogEntry> DuckLakeCatalogSet::GetEntryById(TableIndex index) {
 }
 
 void DuckLakeCatalogSet::AddEntry(DuckLakeSchemaEntry &schema, TableIndex id, unique_ptr<CatalogEntry> entry) {
+	lock_guard<mutex> guard(entry_lock);
 	auto catalog_type = entry->type;
 	table_entry_map.insert(make_pair(id, reference<CatalogEntry>(*entry)));
+	lazy_entry_map.erase(id);
 	schema.AddEntry(catalog_type, std::move(entry));
 }
 
+void DuckLakeCatalogSet::AddLazyEntry(DuckLakeSchemaEntry &schema, TableIndex id, string name) {
+	lock_guard<mutex> guard(entry_lock);
+	schema.AddLazyEntry(*this, name, id);
+	lazy_entry_map.insert(make_pair(id, DuckLakeLazyEntry(schema, std::move(name))));
+}
+
+void DuckLakeCatalogSet::AddLazyEntry(const string &name, TableIndex id) {
+	lock_guard<mutex> guard(entry_lock);
+	lazy_entries[name] = id;
+}
+
+TableIndex DuckLakeCatalogSet::GetLazyEntry(const string &name) {
+	lock_guard<mutex> guard(entry_lock);
+	auto entry = lazy_entries.find(name);
+	if (entry == lazy_entries.end()) {
+		return TableIndex();
+	}
+	return entry->second;
+}
+
+vector<TableIndex> DuckLakeCatalogSet::GetLazyEntries() {
+	lock_guard<mutex> guard(entry_lock);
+	vector<TableIndex> result;
+	for (auto &entry : lazy_entries) {
+		result.push_back(entry.second);
+	}
+	return result;
+}
+
+bool DuckLakeCatalogSet::IsLazyEntry(TableIndex id) {
+	lock_guard<mutex> guard(entry_lock);
+	return lazy_entry_map.find(id) != lazy_entry_map.end();
+}
+
 } // namespace duckdb
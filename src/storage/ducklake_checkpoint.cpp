@@ -1,31 +1,186 @@
 #include "ducklake_extension.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/connection.hpp"
 #include "storage/ducklake_transaction_manager.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
 #include "storage/ducklake_schema_entry.hpp"
 #include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction_changes.hpp"
 #include "duckdb/main/database.hpp"
 
 namespace duckdb {
 
+//! The snapshot up to which all changes made to a table have been processed by a CHECKPOINT
+static constexpr const char *CHECKPOINT_SNAPSHOT_OPTION = "checkpoint_snapshot";
+
+struct DuckLakeCheckpointTable {
+	string schema_name;
+	string table_name;
+};
+
+static void RunCheckpointQuery(Connection &conn, const string &query) {
+	auto res = conn.Query(query);
+	if (res->HasError()) {
+		res->GetErrorObject().Throw("Failed to perform CHECKPOINT; in DuckLake:  ");
+	}
+}
+
+//! Gather the tables that have to be checkpointed - i.e. the tables that were changed since their last checkpoint
+static vector<DuckLakeCheckpointTable> GetCheckpointTables(Connection &conn, DuckLakeCatalog &catalog, bool force,
+                                                           idx_t &checkpoint_snapshot) {
+	auto &context = *conn.context;
+	conn.BeginTransaction();
+	auto &transaction = DuckLakeTransaction::Get(context, catalog);
+	checkpoint_snapshot = transaction.GetSnapshot().snapshot_id;
+
+	struct TableEntry {
+		TableIndex table_id;
+		DuckLakeCheckpointTable table;
+		optional_idx last_checkpoint;
+	};
+	vector<TableEntry> tables;
+	optional_idx min_checkpoint;
+	for (auto &schema : catalog.GetSchemas(context)) {
+		schema.get().Scan(context, CatalogType::TABLE_ENTRY, [&](CatalogEntry &entry) {
+			auto &table = entry.Cast<DuckLakeTableEntry>();
+			TableEntry table_entry;
+			table_entry.table_id = table.GetTableId();
+			table_entry.table.schema_name = table.ParentSchema().name;
+			table_entry.table.table_name = table.name;
+			string last_checkpoint;
+			if (!force && catalog.TryGetConfigOption(CHECKPOINT_SNAPSHOT_OPTION, last_checkpoint, table)) {
+				auto last_checkpoint_value = Value(last_checkpoint).DefaultCastAs(LogicalType::UBIGINT);
+				table_entry.last_checkpoint = last_checkpoint_value.GetValue<idx_t>();
+				if (!min_checkpoint.IsValid() || table_entry.last_checkpoint.GetIndex() < min_checkpoint.GetIndex()) {
+					min_checkpoint = table_entry.last_checkpoint;
+				}
+			}
+			tables.push_back(std::move(table_entry));
+		});
+	}
+
+	// find the last snapshot in which the data of every table was changed
+	// compactions and flushes of inlined data are not counted - these are the changes made by a checkpoint itself
+	unordered_map<idx_t, idx_t> last_changes;
+	unordered_set<idx_t> existing_snapshots;
+	if (min_checkpoint.IsValid()) {
+		auto &metadata_manager = transaction.GetMetadataManager();
+		auto snapshots =
+		    metadata_manager.GetAllSnapshots(StringUtil::Format("snapshot_id >= %d", min_checkpoint.GetIndex()));
+		for (auto &snapshot : snapshots) {
+			existing_snapshots.insert(snapshot.id);
+			auto changes = SnapshotChangeInformation::ParseChangesMade(snapshot.change_info.changes_made);
+			for (auto changed_tables : {&changes.inserted_tables, &changes.tables_deleted_from,
+			                            &changes.tables_inserted_inlined, &changes.tables_deleted_inlined,
+			                            &changes.altered_tables}) {
+				for (auto &table_id : *changed_tables) {
+					auto &last_change = last_changes[table_id.index];
+					last_change = MaxValue<idx_t>(last_change, snapshot.id);
+				}
+			}
+		}
+	}
+	conn.Commit();
+
+	vector<DuckLakeCheckpointTable> result;
+	for (auto &entry : tables) {
+		if (entry.last_checkpoint.IsValid() &&
+		    existing_snapshots.find(entry.last_checkpoint.GetIndex()) != existing_snapshots.end()) {
+			// the table was checkpointed before - and the snapshots since have not been expired
+			auto last_change = last_changes.find(entry.table_id.index);
+			if (last_change == last_changes.end() || last_change->second <= entry.last_checkpoint.GetIndex()) {
+				// the table was not changed since - skip it
+				continue;
+			}
+		}
+		result.push_back(std::move(entry.table));
+	}
+	return result;
+}
+
 void DuckLakeTransactionManager::Checkpoint(ClientContext &context, bool force) {
 	auto conn = make_uniq<Connection>(ducklake_catalog.GetDatabase());
-	// 1. We first flush inlined data, since these can generate many files, which would be important for compaction
-	// 2. We expire snapshots since these can create more compaction opportunities.
-	// 3. We call the compaction functions, merge_adjacent and rewrite, unclear what is the best order here.
-	// 4. We call the functions that delete files last, since these mostly result from compaction or expired snapshots.
-	const vector<string> checkpoint_queries {
-	    "CALL ducklake_flush_inlined_data({CATALOG})",   "CALL ducklake_expire_snapshots({CATALOG})",
-	    "CALL ducklake_merge_adjacent_files({CATALOG})", "CALL ducklake_rewrite_data_files({CATALOG})",
-	    "CALL ducklake_cleanup_old_files({CATALOG})",    "CALL ducklake_delete_orphaned_files({CATALOG})"};
-
-	for (const auto &query : checkpoint_queries) {
-		auto checkpoint_query =
-		    StringUtil::Replace(query, "{CATALOG}", KeywordHelper::WriteQuoted(ducklake_catalog.GetName(), '\''));
-		auto res = conn->Query(checkpoint_query);
-		if (res->HasError()) {
-			res->GetErrorObject().Throw("Failed to perform CHECKPOINT; in DuckLake:  ");
+	auto catalog_name = KeywordHelper::WriteQuoted(ducklake_catalog.GetName(), '\'');
+	// 1. We first expire snapshots since these can create more compaction opportunities.
+	// 2. We then run the table maintenance pipeline for every table that was changed since its last checkpoint:
+	//    a. We flush inlined data, since these can generate many files, which would be important for compaction
+	//    b. We call the compaction functions, merge_adjacent and rewrite, unclear what is the best order here.
+	//    Every table runs the pipeline on its own - so tables can be checkpointed in parallel.
+	// 3. We call the functions that delete files last, since these mostly result from compaction or expired snapshots.
+	RunCheckpointQuery(*conn, StringUtil::Format("CALL ducklake_expire_snapshots(%s)", catalog_name));
+
+	idx_t checkpoint_snapshot;
+	auto tables = GetCheckpointTables(*conn, ducklake_catalog, force, checkpoint_snapshot);
+	auto max_concurrency = ducklake_catalog.GetConfigOption<idx_t>("checkpoint_max_concurrency", {}, {}, 1);
+
+	mutex lock;
+	idx_t next_table = 0;
+	vector<ErrorData> errors;
+	auto run_checkpoints = [&]() {
+		try {
+			Connection con(ducklake_catalog.GetDatabase());
+			while (true) {
+				idx_t table_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_table >= tables.size() || context.interrupted) {
+						return;
+					}
+					table_idx = next_table++;
+				}
+				auto &table = tables[table_idx];
+				auto schema_name = KeywordHelper::WriteQuoted(table.schema_name, '\'');
+				auto table_name = KeywordHelper::WriteQuoted(table.table_name, '\'');
+				const vector<string> table_queries {
+				    StringUtil::Format("CALL ducklake_flush_inlined_data(%s, schema_name => %s, table_name => %s)",
+				                       catalog_name, schema_name, table_name),
+				    StringUtil::Format("CALL ducklake_merge_adjacent_files(%s, %s, schema => %s)", catalog_name,
+				                       table_name, schema_name),
+				    StringUtil::Format("CALL ducklake_rewrite_data_files(%s, %s, schema => %s)", catalog_name,
+				                       table_name, schema_name),
+				    // all changes made up to the start of the checkpoint have been processed
+				    StringUtil::Format("CALL ducklake_set_option(%s, '%s', %d, schema => %s, table_name => %s)",
+				                       catalog_name, CHECKPOINT_SNAPSHOT_OPTION, checkpoint_snapshot, schema_name,
+				                       table_name)};
+				for (auto &query : table_queries) {
+					auto result = con.Query(query);
+					if (result->HasError()) {
+						lock_guard<mutex> guard(lock);
+						errors.push_back(result->GetErrorObject());
+						break;
+					}
+				}
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			errors.emplace_back(ex);
 		}
+	};
+#ifndef DUCKDB_NO_THREADS
+	auto thread_count = MinValue<idx_t>(max_concurrency, tables.size());
+	vector<thread> threads;
+	for (idx_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(run_checkpoints);
+	}
+	run_checkpoints();
+	for (auto &checkpoint_thread : threads) {
+		checkpoint_thread.join();
+	}
+#else
+	run_checkpoints();
+#endif
+	if (!errors.empty()) {
+		errors[0].Throw("Failed to perform CHECKPOINT; in DuckLake:  ");
+	}
+
+	const vector<string> cleanup_queries {"CALL ducklake_cleanup_old_files(%s)",
+	                                      "CALL ducklake_delete_orphaned_files(%s)"};
+	for (const auto &query : cleanup_queries) {
+		RunCheckpointQuery(*conn, StringUtil::Format(query, catalog_name));
 	}
 }
 
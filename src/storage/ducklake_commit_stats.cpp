@@ -0,0 +1,69 @@
+#include "storage/ducklake_commit_stats.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+DuckLakeCommitPhase::DuckLakeCommitPhase(DuckLakeCommitTimings &timings, const char *phase)
+    : timings(timings), phase(phase), start(std::chrono::steady_clock::now()) {
+}
+
+DuckLakeCommitPhase::~DuckLakeCommitPhase() {
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	timings.phase_time_us[phase] += NumericCast<idx_t>(elapsed.count());
+}
+
+void DuckLakeCommitStats::Record(const DuckLakeCommitTimings &timings) {
+	lock_guard<mutex> guard(lock);
+	stats.commits++;
+	if (timings.failed) {
+		stats.failed_commits++;
+	}
+	stats.retries += timings.retries;
+	stats.max_retries = MaxValue<idx_t>(stats.max_retries, timings.retries);
+	stats.total_time_us += timings.total_time_us;
+	stats.max_time_us = MaxValue<idx_t>(stats.max_time_us, timings.total_time_us);
+	for (auto &entry : timings.phase_time_us) {
+		auto &phase = stats.phases[entry.first];
+		phase.commits++;
+		phase.total_time_us += entry.second;
+		phase.max_time_us = MaxValue<idx_t>(phase.max_time_us, entry.second);
+	}
+	for (auto &cause : timings.conflict_causes) {
+		stats.conflict_causes[cause]++;
+	}
+}
+
+DuckLakeCommitStatsData DuckLakeCommitStats::GetStats() const {
+	lock_guard<mutex> guard(lock);
+	return stats;
+}
+
+void DuckLakeCommitStats::Reset() {
+	lock_guard<mutex> guard(lock);
+	stats = DuckLakeCommitStatsData();
+}
+
+string DuckLakeCommitStats::GetConflictCause(const string &error_message) {
+	static constexpr const char *CONFLICT_PREFIX = "Transaction conflict - attempting to ";
+	if (StringUtil::StartsWith(error_message, CONFLICT_PREFIX)) {
+		// conflicts detected by the conflict check - keep the action that conflicted (e.g. "insert into table")
+		auto action = error_message.substr(strlen(CONFLICT_PREFIX));
+		auto end = MinValue<idx_t>(action.find(" with "), action.find(" \""));
+		return "conflict: " + action.substr(0, end);
+	}
+	auto message = StringUtil::Lower(error_message);
+	if (StringUtil::Contains(message, "primary key") || StringUtil::Contains(message, "unique")) {
+		// another process inserted the same snapshot or catalog ids into the metadata catalog
+		return "unique constraint";
+	}
+	if (StringUtil::Contains(message, "conflict")) {
+		return "conflict";
+	}
+	if (StringUtil::Contains(message, "concurrent")) {
+		return "concurrent access";
+	}
+	return "other";
+}
+
+} // namespace duckdb
@@ -0,0 +1,141 @@
+#include "storage/ducklake_compact_file_list.hpp"
+
+namespace duckdb {
+
+DuckLakeCompactFileList::DuckLakeCompactFileList() {
+}
+
+DuckLakeCompactFileList::DuckLakeCompactFileList(const vector<DuckLakeFileListEntry> &files) {
+	entries.reserve(files.size());
+	for (auto &file : files) {
+		Append(file);
+	}
+}
+
+DuckLakeCompactFileList::ArenaString DuckLakeCompactFileList::AddString(const char *data, idx_t length) {
+	ArenaString result;
+	result.offset = arena.size();
+	result.length = length;
+	arena.append(data, length);
+	return result;
+}
+
+string DuckLakeCompactFileList::GetString(const ArenaString &str) const {
+	return string(arena.data() + str.offset, str.length);
+}
+
+uint32_t DuckLakeCompactFileList::InternDirectory(const string &directory) {
+	auto entry = directory_map.find(directory);
+	if (entry != directory_map.end()) {
+		return entry->second;
+	}
+	auto directory_idx = NumericCast<uint32_t>(directories.size());
+	directories.push_back(directory);
+	directory_map.insert(make_pair(directory, directory_idx));
+	return directory_idx;
+}
+
+DuckLakeCompactFileList::CompactFileData DuckLakeCompactFileList::CompactFile(const DuckLakeFileData &file) {
+	CompactFileData result;
+	if (file.path.empty()) {
+		return result;
+	}
+	// split the path into its directory (including the trailing separator) and the file name
+	auto separator_pos = file.path.find_last_of("/\\");
+	idx_t name_start = separator_pos == string::npos ? 0 : separator_pos + 1;
+	result.directory = InternDirectory(file.path.substr(0, name_start));
+	result.file_name = AddString(file.path.c_str() + name_start, file.path.size() - name_start);
+	result.encryption_key = AddString(file.encryption_key.c_str(), file.encryption_key.size());
+	result.file_size_bytes = file.file_size_bytes;
+	result.footer_size = file.footer_size.IsValid() ? file.footer_size.GetIndex() : DConstants::INVALID_INDEX;
+	return result;
+}
+
+DuckLakeCompactFileList::CompactFileData DuckLakeCompactFileList::CopyFile(const DuckLakeCompactFileList &other,
+                                                                           const CompactFileData &file) {
+	CompactFileData result = file;
+	if (file.directory == INVALID_DIRECTORY) {
+		return result;
+	}
+	result.directory = InternDirectory(other.directories[file.directory]);
+	result.file_name = AddString(other.arena.data() + file.file_name.offset, file.file_name.length);
+	result.encryption_key = AddString(other.arena.data() + file.encryption_key.offset, file.encryption_key.length);
+	return result;
+}
+
+DuckLakeFileData DuckLakeCompactFileList::GetFile(const CompactFileData &file) const {
+	DuckLakeFileData result;
+	if (file.directory == INVALID_DIRECTORY) {
+		return result;
+	}
+	auto &directory = directories[file.directory];
+	result.path.reserve(directory.size() + file.file_name.length);
+	result.path += directory;
+	result.path.append(arena.data() + file.file_name.offset, file.file_name.length);
+	result.encryption_key = GetString(file.encryption_key);
+	result.file_size_bytes = file.file_size_bytes;
+	if (file.footer_size != DConstants::INVALID_INDEX) {
+		result.footer_size = file.footer_size;
+	}
+	return result;
+}
+
+static idx_t GetOptionalIndex(const optional_idx &index) {
+	return index.IsValid() ? index.GetIndex() : DConstants::INVALID_INDEX;
+}
+
+static optional_idx ToOptionalIndex(idx_t index) {
+	return index == DConstants::INVALID_INDEX ? optional_idx() : optional_idx(index);
+}
+
+void DuckLakeCompactFileList::Append(const DuckLakeFileListEntry &file) {
+	CompactFileListEntry entry;
+	entry.file = CompactFile(file.file);
+	entry.delete_file = CompactFile(file.delete_file);
+	entry.row_id_start = GetOptionalIndex(file.row_id_start);
+	entry.snapshot_id = GetOptionalIndex(file.snapshot_id);
+	entry.max_row_count = GetOptionalIndex(file.max_row_count);
+	entry.snapshot_filter = GetOptionalIndex(file.snapshot_filter);
+	entry.mapping_id = file.mapping_id.index;
+	entry.file_id = file.file_id.index;
+	entry.row_count = GetOptionalIndex(file.row_count);
+	entry.delete_count = file.delete_count;
+	entry.data_type = file.data_type;
+	entries.push_back(entry);
+}
+
+void DuckLakeCompactFileList::Append(const DuckLakeCompactFileList &other, idx_t index) {
+	auto &other_entry = other.entries[index];
+	CompactFileListEntry entry = other_entry;
+	entry.file = CopyFile(other, other_entry.file);
+	entry.delete_file = CopyFile(other, other_entry.delete_file);
+	entries.push_back(entry);
+}
+
+DuckLakeFileListEntry DuckLakeCompactFileList::Get(idx_t index) const {
+	auto &entry = entries[index];
+	DuckLakeFileListEntry result;
+	result.file = GetFile(entry.file);
+	result.delete_file = GetFile(entry.delete_file);
+	result.row_id_start = ToOptionalIndex(entry.row_id_start);
+	result.snapshot_id = ToOptionalIndex(entry.snapshot_id);
+	result.max_row_count = ToOptionalIndex(entry.max_row_count);
+	result.snapshot_filter = ToOptionalIndex(entry.snapshot_filter);
+	result.mapping_id = MappingIndex(entry.mapping_id);
+	result.data_type = entry.data_type;
+	result.file_id = DataFileIndex(entry.file_id);
+	result.row_count = ToOptionalIndex(entry.row_count);
+	result.delete_count = entry.delete_count;
+	return result;
+}
+
+vector<DuckLakeFileListEntry> DuckLakeCompactFileList::GetEntries() const {
+	vector<DuckLakeFileListEntry> result;
+	result.reserve(entries.size());
+	for (idx_t i = 0; i < entries.size(); i++) {
+		result.push_back(Get(i));
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,206 @@
+#include "storage/ducklake_compaction_tracker.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_transaction.hpp"
+#include "storage/ducklake_transaction_changes.hpp"
+#include "common/ducklake_data_file.hpp"
+#include "duckdb/common/algorithm.hpp"
+
+namespace duckdb {
+
+string DuckLakeCompactionTracker::GetPartitionKey(const optional_idx &partition_id,
+                                                  const vector<string> &partition_values) {
+	string result = partition_id.IsValid() ? to_string(partition_id.GetIndex()) : "-";
+	for (auto &value : partition_values) {
+		// prefix every value with its length - so the key is unambiguous regardless of the contents of the values
+		result += "|" + to_string(value.size()) + ":" + value;
+	}
+	return result;
+}
+
+string DuckLakeCompactionTracker::GetPartitionKey(const DuckLakeDataFile &file) {
+	auto partition_entries = file.partition_values;
+	std::sort(partition_entries.begin(), partition_entries.end(),
+	          [](const DuckLakeFilePartition &a, const DuckLakeFilePartition &b) {
+		          return a.partition_column_idx < b.partition_column_idx;
+	          });
+	vector<string> partition_values;
+	for (auto &entry : partition_entries) {
+		partition_values.push_back(entry.partition_value);
+	}
+	return GetPartitionKey(file.partition_id, partition_values);
+}
+
+bool DuckLakeCompactionTracker::AdvanceTableState(DuckLakeTransaction &transaction, TableIndex table_id,
+                                                  idx_t snapshot_id) {
+	idx_t state_snapshot_id;
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = tables.find(table_id.index);
+		if (entry == tables.end() || entry->second.snapshot_id > snapshot_id) {
+			return false;
+		}
+		state_snapshot_id = entry->second.snapshot_id;
+	}
+	if (state_snapshot_id == snapshot_id) {
+		return true;
+	}
+	// check the changes made by the snapshots the state does not reflect yet
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto snapshots = metadata_manager.GetAllSnapshots(
+	    StringUtil::Format("snapshot_id > %d AND snapshot_id <= %d", state_snapshot_id, snapshot_id));
+	// if some of the snapshots have been expired we cannot tell what happened to the table
+	bool changed = snapshots.size() != snapshot_id - state_snapshot_id;
+	for (auto &snapshot : snapshots) {
+		auto changes = SnapshotChangeInformation::ParseChangesMade(snapshot.change_info.changes_made);
+		for (auto changed_tables : {&changes.inserted_tables, &changes.tables_deleted_from, &changes.tables_compacted,
+		                            &changes.tables_flushed_inlined, &changes.dropped_tables}) {
+			if (changed_tables->find(table_id) != changed_tables->end()) {
+				changed = true;
+			}
+		}
+	}
+	lock_guard<mutex> guard(lock);
+	auto entry = tables.find(table_id.index);
+	if (entry == tables.end() || entry->second.snapshot_id != state_snapshot_id) {
+		// the state was changed concurrently
+		return false;
+	}
+	if (changed) {
+		tables.erase(entry);
+		return false;
+	}
+	entry->second.snapshot_id = snapshot_id;
+	return true;
+}
+
+bool DuckLakeCompactionTracker::CanSkipCompaction(DuckLakeTransaction &transaction, TableIndex table_id,
+                                                  CompactionType type, idx_t target_file_size,
+                                                  double delete_threshold) {
+	auto snapshot_id = transaction.GetSnapshot().snapshot_id;
+	if (!AdvanceTableState(transaction, table_id, snapshot_id)) {
+		return false;
+	}
+	lock_guard<mutex> guard(lock);
+	auto entry = tables.find(table_id.index);
+	if (entry == tables.end() || entry->second.snapshot_id != snapshot_id) {
+		return false;
+	}
+	auto &state = entry->second;
+	switch (type) {
+	case CompactionType::MERGE_ADJACENT_TABLES:
+		if (state.target_file_size != target_file_size) {
+			return false;
+		}
+		for (auto &partition : state.partitions) {
+			if (partition.second.small_file_count > 1) {
+				// this partition has multiple small files that might be merged
+				return false;
+			}
+		}
+		return true;
+	case CompactionType::REWRITE_DELETES:
+		return delete_threshold > state.max_delete_ratio || delete_threshold >= state.clean_rewrite_threshold;
+	default:
+		return false;
+	}
+}
+
+void DuckLakeCompactionTracker::SetTableState(TableIndex table_id, idx_t snapshot_id, idx_t target_file_size,
+                                              const vector<DuckLakeCompactionFileEntry> &files) {
+	TableState state;
+	state.snapshot_id = snapshot_id;
+	state.target_file_size = target_file_size;
+	// no live file has any deletes - a rewrite has no work for any threshold
+	state.max_delete_ratio = -1;
+	for (auto &entry : files) {
+		auto &file = entry.file;
+		if (file.begin_snapshot > snapshot_id) {
+			// the file list contains files committed after the snapshot - it does not reflect the snapshot
+			return;
+		}
+		if (file.end_snapshot.IsValid()) {
+			continue;
+		}
+		for (auto &delete_file : entry.delete_files) {
+			if (delete_file.begin_snapshot > snapshot_id) {
+				return;
+			}
+			if (delete_file.end_snapshot.IsValid()) {
+				continue;
+			}
+			double delete_ratio = file.row_count == 0 ? 1.0
+			                                          : static_cast<double>(delete_file.row_count) /
+			                                                static_cast<double>(file.row_count);
+			state.max_delete_ratio = MaxValue<double>(state.max_delete_ratio, delete_ratio);
+		}
+		if (file.data.file_size_bytes >= target_file_size) {
+			continue;
+		}
+		auto &partition = state.partitions[GetPartitionKey(file.partition_id, file.partition_values)];
+		partition.small_file_count++;
+		partition.small_file_bytes += file.data.file_size_bytes;
+	}
+	lock_guard<mutex> guard(lock);
+	auto entry = tables.find(table_id.index);
+	if (entry != tables.end() && entry->second.snapshot_id > snapshot_id) {
+		// we already have a more recent state
+		return;
+	}
+	tables[table_id.index] = std::move(state);
+}
+
+void DuckLakeCompactionTracker::SetCleanRewrite(TableIndex table_id, idx_t snapshot_id, double delete_threshold) {
+	lock_guard<mutex> guard(lock);
+	auto entry = tables.find(table_id.index);
+	if (entry == tables.end() || entry->second.snapshot_id != snapshot_id) {
+		return;
+	}
+	auto &state = entry->second;
+	state.clean_rewrite_threshold = MinValue<double>(state.clean_rewrite_threshold, delete_threshold);
+}
+
+void DuckLakeCompactionTracker::CommitChanges(idx_t commit_snapshot_id,
+                                              const vector<DuckLakeCompactionTrackerChanges> &changes) {
+	unordered_map<idx_t, reference<const DuckLakeCompactionTrackerChanges>> table_changes;
+	for (auto &entry : changes) {
+		table_changes.insert(make_pair(entry.table_id.index, std::cref(entry)));
+	}
+	lock_guard<mutex> guard(lock);
+	for (auto it = tables.begin(); it != tables.end();) {
+		auto &state = it->second;
+		if (state.snapshot_id + 1 != commit_snapshot_id) {
+			// the state does not reflect the snapshot this commit was made on top of - the gap is resolved by
+			// AdvanceTableState
+			it++;
+			continue;
+		}
+		auto entry = table_changes.find(it->first);
+		if (entry == table_changes.end()) {
+			// the commit did not change the files of this table
+			state.snapshot_id = commit_snapshot_id;
+			it++;
+			continue;
+		}
+		auto &commit_changes = entry->second.get();
+		if (commit_changes.invalidate) {
+			it = tables.erase(it);
+			continue;
+		}
+		if (commit_changes.deleted_rows) {
+			state.max_delete_ratio = UNKNOWN_DELETE_RATIO;
+			state.clean_rewrite_threshold = UNKNOWN_DELETE_RATIO;
+		}
+		for (auto &file : commit_changes.new_files) {
+			if (file.file_size_bytes >= state.target_file_size) {
+				continue;
+			}
+			auto &partition = state.partitions[file.partition_key];
+			partition.small_file_count++;
+			partition.small_file_bytes += file.file_size_bytes;
+		}
+		state.snapshot_id = commit_snapshot_id;
+		it++;
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,163 @@
+#include "storage/ducklake_create_index.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_field_data.hpp"
+#include "storage/ducklake_insert.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
+
+#include "duckdb/parser/expression/columnref_expression.hpp"
+#include "duckdb/parser/parsed_data/create_index_info.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+
+namespace duckdb {
+
+//! The option holding the indexed columns of a table
+static constexpr const char *BLOOM_FILTER_COLUMNS_OPTION = "bloom_filter_columns";
+
+DuckLakeCreateIndex::DuckLakeCreateIndex(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+                                         DuckLakeTableEntry &table, vector<string> columns_p)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, 0), table(table),
+      columns(std::move(columns_p)) {
+}
+
+SourceResultType DuckLakeCreateIndex::GetData(ExecutionContext &context, DataChunk &chunk,
+                                              OperatorSourceInput &input) const {
+	auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+	auto &transaction = DuckLakeTransaction::Get(context.client, catalog);
+
+	// add the columns to the Bloom filter columns of the table - so new files are indexed when they are written
+	string bloom_filter_columns;
+	catalog.TryGetConfigOption(BLOOM_FILTER_COLUMNS_OPTION, bloom_filter_columns, table);
+	vector<string> indexed_columns;
+	for (auto &entry : StringUtil::Split(bloom_filter_columns, ',')) {
+		StringUtil::Trim(entry);
+		if (!entry.empty()) {
+			indexed_columns.push_back(entry);
+		}
+	}
+	bool added_columns = false;
+	for (auto &column : columns) {
+		bool is_indexed = false;
+		for (auto &indexed_column : indexed_columns) {
+			if (StringUtil::CIEquals(indexed_column, column)) {
+				is_indexed = true;
+				break;
+			}
+		}
+		if (!is_indexed) {
+			indexed_columns.push_back(column);
+			added_columns = true;
+		}
+	}
+	if (added_columns) {
+		DuckLakeConfigOption option;
+		option.option.key = BLOOM_FILTER_COLUMNS_OPTION;
+		option.option.value = StringUtil::Join(indexed_columns, ", ");
+		option.table_id = table.GetTableId();
+		transaction.SetConfigOption(option);
+	}
+
+	// compute the Bloom filters of the existing files that do not have one yet
+	auto &metadata_manager = transaction.GetMetadataManager();
+	auto files = catalog.GetFilesForTable(transaction, table, transaction.GetSnapshot());
+	for (auto &column : columns) {
+		auto field_id = table.TryGetFieldId(vector<string> {column});
+		if (!field_id) {
+			throw InternalException("Indexed column \"%s\" not found", column);
+		}
+		auto field_index = field_id->GetFieldIndex();
+		unordered_set<idx_t> unindexed_files;
+		for (auto &file_id : metadata_manager.GetFilesWithoutExtraStats(table.GetTableId(), field_index)) {
+			unindexed_files.insert(file_id.index);
+		}
+		vector<DuckLakeFileExtraStats> file_stats;
+		for (auto &file : files) {
+			if (unindexed_files.find(file.file_id.index) == unindexed_files.end()) {
+				continue;
+			}
+			if (file.mapping_id.IsValid() || !file.file.encryption_key.empty()) {
+				// FIXME: support added files with a name mapping and encrypted files - these files are always read
+				continue;
+			}
+			// the column is read by its field id - it might have been renamed since the file was written
+			auto source = StringUtil::Format(
+			    "read_parquet(%s, schema=MAP {%d: {name: %s, type: %s, default_value: NULL}})",
+			    SQLString(file.file.path), field_index.index, SQLString(field_id->Name()),
+			    SQLString(field_id->Type().ToString()));
+			DuckLakeFileExtraStats stats;
+			stats.data_file_id = file.file_id;
+			vector<reference<const DuckLakeFieldId>> fields {*field_id};
+			stats.extra_stats = DuckLakeInsert::ComputeFileBloomFilters(transaction, fields, source)[0]->Serialize();
+			file_stats.push_back(std::move(stats));
+		}
+		metadata_manager.SetFileExtraStats(table.GetTableId(), field_index, file_stats);
+	}
+	return SourceResultType::FINISHED;
+}
+
+string DuckLakeCreateIndex::GetName() const {
+	return "DUCKLAKE_CREATE_INDEX";
+}
+
+class DuckLakeLogicalCreateIndex : public LogicalExtensionOperator {
+public:
+	DuckLakeLogicalCreateIndex(idx_t table_index, DuckLakeTableEntry &table, vector<string> columns_p)
+	    : table_index(table_index), table(table), columns(std::move(columns_p)) {
+	}
+
+	idx_t table_index;
+	DuckLakeTableEntry &table;
+	vector<string> columns;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		return planner.Make<DuckLakeCreateIndex>(types, table, std::move(columns));
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		vector<ColumnBinding> result;
+		result.emplace_back(table_index, 0);
+		return result;
+	}
+
+	void ResolveTypes() override {
+		types = {LogicalType::BIGINT};
+	}
+};
+
+unique_ptr<LogicalOperator> DuckLakeCreateIndex::Bind(Binder &binder, CreateIndexInfo &info,
+                                                      DuckLakeTableEntry &table) {
+	if (info.constraint_type != IndexConstraintType::NONE) {
+		throw NotImplementedException("DuckLake indexes cannot enforce UNIQUE or PRIMARY KEY constraints");
+	}
+	if (!info.index_type.empty() && !StringUtil::CIEquals(info.index_type, "ART") &&
+	    !StringUtil::CIEquals(info.index_type, "BLOOM")) {
+		throw NotImplementedException("Index type \"%s\" is not supported in DuckLake - only BLOOM indexes are",
+		                              info.index_type);
+	}
+	if (table.GetTableId().IsTransactionLocal()) {
+		throw NotImplementedException("Indexes cannot be created on tables that were created in the same transaction");
+	}
+	vector<string> columns;
+	for (auto &expr : info.parsed_expressions) {
+		if (expr->GetExpressionClass() != ExpressionClass::COLUMN_REF) {
+			throw BinderException("DuckLake indexes can only be created on columns, not on expressions");
+		}
+		auto &column_name = expr->Cast<ColumnRefExpression>().GetColumnName();
+		auto field_id = table.TryGetFieldId(vector<string> {column_name});
+		if (!field_id || field_id->HasChildren()) {
+			throw BinderException("DuckLake indexes can only be created on top-level columns of primitive types - "
+			                      "\"%s\" is not",
+			                      column_name);
+		}
+		columns.push_back(field_id->Name());
+	}
+	return make_uniq<DuckLakeLogicalCreateIndex>(binder.GenerateTableIndex(), table, std::move(columns));
+}
+
+} // namespace duckdb
@@ -0,0 +1,158 @@
+#include "storage/ducklake_data_file_cache.hpp"
+
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+//! Suffix of files that are still being downloaded
+static constexpr const char *CACHE_DOWNLOAD_SUFFIX = ".download";
+static constexpr idx_t CACHE_DOWNLOAD_BUFFER_SIZE = 1ULL << 20;
+
+DuckLakeDataFileCache::DuckLakeDataFileCache(FileSystem &fs, string directory_p, idx_t max_size)
+    : fs(fs), directory(std::move(directory_p)), max_size(max_size) {
+	if (!fs.DirectoryExists(directory)) {
+		fs.CreateDirectory(directory);
+	}
+	LoadCachedFiles();
+}
+
+void DuckLakeDataFileCache::LoadCachedFiles() {
+	vector<string> file_names;
+	fs.ListFiles(directory, [&](const string &name, bool is_directory) {
+		if (!is_directory) {
+			file_names.push_back(name);
+		}
+	});
+	// we do not know the order in which the files were accessed by the previous session - sort them by name so the
+	// eviction order is at least deterministic
+	std::sort(file_names.begin(), file_names.end());
+	for (auto &name : file_names) {
+		auto local_path = fs.JoinPath(directory, name);
+		if (StringUtil::EndsWith(name, CACHE_DOWNLOAD_SUFFIX)) {
+			// left-over of an interrupted download
+			fs.TryRemoveFile(local_path);
+			continue;
+		}
+		auto handle = fs.OpenFile(local_path, FileFlags::FILE_FLAGS_READ);
+		CacheEntry entry;
+		entry.local_path = local_path;
+		entry.file_size = NumericCast<idx_t>(handle->GetFileSize());
+		entry.last_access = ++access_count;
+		cache_size += entry.file_size;
+		entries.emplace(name, std::move(entry));
+	}
+	EvictEntries();
+}
+
+string DuckLakeDataFileCache::GetCacheFileName(const string &path, idx_t file_size) const {
+	// the hash of the full path and the size recorded in the metadata make the name unique - a file that was
+	// overwritten with different contents (e.g. a file added with ducklake_add_files) is not mistaken for the cached
+	// copy. The original file name is kept to make the cache inspectable
+	auto file_name = StringUtil::GetFileName(path);
+	return StringUtil::Format("%016llx_%llu_%s", static_cast<uint64_t>(Hash(path.c_str())), file_size, file_name);
+}
+
+bool DuckLakeDataFileCache::DownloadFile(const string &path, const string &local_path, idx_t file_size) {
+	auto source = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	if (NumericCast<idx_t>(source->GetFileSize()) != file_size) {
+		// the remote file does not match the metadata - do not cache it
+		return false;
+	}
+	auto target = fs.OpenFile(local_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	auto buffer = make_unsafe_uniq_array<data_t>(CACHE_DOWNLOAD_BUFFER_SIZE);
+	idx_t offset = 0;
+	while (offset < file_size) {
+		auto read_size = MinValue<idx_t>(CACHE_DOWNLOAD_BUFFER_SIZE, file_size - offset);
+		source->Read(buffer.get(), read_size, offset);
+		target->Write(buffer.get(), read_size, offset);
+		offset += read_size;
+	}
+	target->Sync();
+	target->Close();
+	return true;
+}
+
+string DuckLakeDataFileCache::GetLocalPath(const string &path, idx_t file_size) {
+	if (!FileSystem::IsRemoteFile(path)) {
+		// local files are read directly
+		return path;
+	}
+	if (file_size > max_size) {
+		// the file does not fit in the cache at all - read it directly without downloading it
+		return path;
+	}
+	auto name = GetCacheFileName(path, file_size);
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = entries.find(name);
+		if (entry != entries.end()) {
+			entry->second.last_access = ++access_count;
+			return entry->second.local_path;
+		}
+	}
+	// download the file outside of the lock - we download to a temporary file first so an interrupted download is
+	// never mistaken for a cached file
+	auto local_path = fs.JoinPath(directory, name);
+	RandomEngine engine;
+	auto download_path =
+	    StringUtil::Format("%s.%llu%s", local_path, engine.NextRandomInteger64(), CACHE_DOWNLOAD_SUFFIX);
+	try {
+		if (!DownloadFile(path, download_path, file_size)) {
+			fs.TryRemoveFile(download_path);
+			return path;
+		}
+	} catch (std::exception &ex) {
+		// the cache only speeds up reads - if the file cannot be downloaded or written locally (e.g. the disk is
+		// full) it is read from the remote path instead
+		fs.TryRemoveFile(download_path);
+		return path;
+	}
+
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(name);
+	if (entry != entries.end()) {
+		// another thread downloaded the same file concurrently
+		fs.TryRemoveFile(download_path);
+		entry->second.last_access = ++access_count;
+		return entry->second.local_path;
+	}
+	try {
+		fs.MoveFile(download_path, local_path);
+	} catch (std::exception &ex) {
+		fs.TryRemoveFile(download_path);
+		return path;
+	}
+	CacheEntry cache_entry;
+	cache_entry.local_path = local_path;
+	cache_entry.file_size = file_size;
+	cache_entry.last_access = ++access_count;
+	cache_size += file_size;
+	entries.emplace(name, std::move(cache_entry));
+	EvictEntries();
+	return local_path;
+}
+
+void DuckLakeDataFileCache::EvictEntries() {
+	while (cache_size > max_size) {
+		// evict the least recently used entry
+		auto candidate = entries.end();
+		for (auto entry = entries.begin(); entry != entries.end(); entry++) {
+			if (candidate == entries.end() || entry->second.last_access < candidate->second.last_access) {
+				candidate = entry;
+			}
+		}
+		if (candidate == entries.end()) {
+			return;
+		}
+		// readers that still have the file open keep reading it (on POSIX) - new readers download it again
+		fs.TryRemoveFile(candidate->second.local_path);
+		cache_size -= candidate->second.file_size;
+		entries.erase(candidate);
+	}
+}
+
+} // namespace duckdb
@@ -16,9 +16,12 @@
 #include "duckdb/common/types/uuid.hpp"
 #include "storage/ducklake_delete.hpp"
 #include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_schema_entry.hpp"
 #include "common/ducklake_data_file.hpp"
 #include "storage/ducklake_multi_file_list.hpp"
 #include "duckdb/parallel/thread_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/common/thread.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "storage/ducklake_multi_file_reader.hpp"
 #include "duckdb/common/types/column/column_data_collection.hpp"
@@ -191,9 +194,18 @@ SinkCombineResultType DuckLakeDelete::Combine(ExecutionContext &context, Operato
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
+//! A delete file that is written to storage - the files are written in parallel after all deletes are prepared
+struct DuckLakeDeleteFileWrite {
+	string filename;
+	DuckLakeDeleteFile delete_file;
+	set<idx_t> sorted_deletes;
+	string delete_file_path;
+};
+
 void DuckLakeDelete::FlushDelete(DuckLakeTransaction &transaction, ClientContext &context,
                                  DuckLakeDeleteGlobalState &global_state, const string &filename,
-                                 ColumnDataCollection &deleted_rows) const {
+                                 ColumnDataCollection &deleted_rows,
+                                 vector<DuckLakeDeleteFileWrite> &pending_writes) const {
 	// find the matching data file for the deletion
 	auto data_file_info = delete_map->GetExtendedFileInfo(filename);
 
@@ -227,7 +239,7 @@ void DuckLakeDelete::FlushDelete(DuckLakeTransaction &transaction, ClientContext
 	auto existing_delete_data = delete_map->GetDeleteData(filename);
 	if (existing_delete_data) {
 		// deletes already exist for this file - add to set of deletes to write
-		auto &existing_deletes = existing_delete_data->deleted_rows;
+		auto existing_deletes = existing_delete_data->deleted_rows.ToVector();
 		sorted_deletes.insert(existing_deletes.begin(), existing_deletes.end());
 
 		// clear the deletes
@@ -248,10 +260,38 @@ void DuckLakeDelete::FlushDelete(DuckLakeTransaction &transaction, ClientContext
 		}
 		return;
 	}
+	if (delete_file.data_file_id.IsValid() && encryption_key.empty()) {
+		// small sets of deletes of persistent files are inlined in the metadata catalog instead of written to a file
+		auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+		auto schema_id = table.ParentSchema().Cast<DuckLakeSchemaEntry>().GetSchemaId();
+		if (sorted_deletes.size() <= catalog.DeleteInliningRowLimit(schema_id, table.GetTableId())) {
+			delete_file.file_name = DuckLakeDeleteFile::GetLocalInlinedDeletePath(transaction.GenerateUUID());
+			delete_file.delete_count = sorted_deletes.size();
+			delete_file.file_size_bytes = 0;
+			delete_file.footer_size = 0;
+			delete_file.inlined_deletes.assign(sorted_deletes.begin(), sorted_deletes.end());
+			global_state.written_files.emplace(filename, std::move(delete_file));
+			return;
+		}
+	}
 
 	auto &fs = FileSystem::GetFileSystem(context);
 	auto delete_file_uuid = "ducklake-" + transaction.GenerateUUID() + "-delete.parquet";
-	string delete_file_path = DuckLakeUtil::JoinPath(fs, table.DataPath(), delete_file_uuid);
+
+	DuckLakeDeleteFileWrite pending_write;
+	pending_write.filename = filename;
+	pending_write.delete_file = std::move(delete_file);
+	pending_write.sorted_deletes = std::move(sorted_deletes);
+	pending_write.delete_file_path = DuckLakeUtil::JoinPath(fs, table.DataPath(), delete_file_uuid);
+	pending_writes.push_back(std::move(pending_write));
+}
+
+void DuckLakeDelete::WriteDeleteFile(ClientContext &context, CopyFunctionCatalogEntry &copy_fun,
+                                     DuckLakeDeleteFileWrite &pending_write) const {
+	auto &filename = pending_write.filename;
+	auto &delete_file = pending_write.delete_file;
+	auto &sorted_deletes = pending_write.sorted_deletes;
+	auto &delete_file_path = pending_write.delete_file_path;
 
 	auto info = make_uniq<CopyInfo>();
 	info->file_path = delete_file_path;
@@ -275,9 +315,7 @@ void DuckLakeDelete::FlushDelete(DuckLakeTransaction &transaction, ClientContext
 		info->options["encryption_config"] = std::move(encryption_input);
 	}
 
-	// get the actual copy function and bind it
-	auto &copy_fun = DuckLakeFunctions::GetCopyFunction(context, "parquet");
-
+	// bind the copy function
 	CopyFunctionBindInput bind_input(*info);
 
 	vector<string> names_to_write {"file_path", "pos"};
@@ -360,7 +398,6 @@ void DuckLakeDelete::FlushDelete(DuckLakeTransaction &transaction, ClientContext
 	delete_file.file_size_bytes = stats_chunk.GetValue(2, r).GetValue<idx_t>();
 	delete_file.footer_size = stats_chunk.GetValue(3, r).GetValue<idx_t>();
 	delete_file.encryption_key = encryption_key;
-	global_state.written_files.emplace(filename, std::move(delete_file));
 }
 
 SinkFinalizeType DuckLakeDelete::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
@@ -371,13 +408,60 @@ SinkFinalizeType DuckLakeDelete::Finalize(Pipeline &pipeline, Event &event, Clie
 	}
 
 	auto &transaction = DuckLakeTransaction::Get(context, table.catalog);
-	// write out the delete rows
+	// process the deletes of every file - deletes that are not inlined or dropped are collected as pending writes
+	vector<DuckLakeDeleteFileWrite> pending_writes;
 	for (auto &entry : global_state.deleted_rows) {
 		auto filename_entry = global_state.filenames.find(entry.first);
 		if (filename_entry == global_state.filenames.end()) {
 			throw InternalException("Filename not found for file index");
 		}
-		FlushDelete(transaction, context, global_state, filename_entry->second, *entry.second);
+		FlushDelete(transaction, context, global_state, filename_entry->second, *entry.second, pending_writes);
+	}
+	if (!pending_writes.empty()) {
+		// write the delete files in parallel - every delete file is a small write (e.g. to an object store), so the
+		// time spent here is dominated by the latency of the writes
+		auto &copy_fun = DuckLakeFunctions::GetCopyFunction(context, "parquet");
+		mutex lock;
+		idx_t next_write = 0;
+		vector<ErrorData> errors;
+		auto write_files = [&]() {
+			while (true) {
+				idx_t write_idx;
+				{
+					lock_guard<mutex> guard(lock);
+					if (next_write >= pending_writes.size() || !errors.empty()) {
+						return;
+					}
+					write_idx = next_write++;
+				}
+				try {
+					WriteDeleteFile(context, copy_fun, pending_writes[write_idx]);
+				} catch (std::exception &ex) {
+					lock_guard<mutex> guard(lock);
+					errors.emplace_back(ex);
+				}
+			}
+		};
+#ifndef DUCKDB_NO_THREADS
+		auto thread_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+		thread_count = MaxValue<idx_t>(MinValue<idx_t>(thread_count, pending_writes.size()), 1);
+		vector<thread> threads;
+		for (idx_t i = 1; i < thread_count; i++) {
+			threads.emplace_back(write_files);
+		}
+		write_files();
+		for (auto &write_thread : threads) {
+			write_thread.join();
+		}
+#else
+		write_files();
+#endif
+		if (!errors.empty()) {
+			errors[0].Throw();
+		}
+		for (auto &pending_write : pending_writes) {
+			global_state.written_files.emplace(std::move(pending_write.filename), std::move(pending_write.delete_file));
+		}
 	}
 	vector<DuckLakeDeleteFile> delete_files;
 	for (auto &entry : global_state.written_files) {
@@ -0,0 +1,238 @@
+#include "storage/ducklake_delete_bitmap.hpp"
+
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/bit_utils.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Container
+//===--------------------------------------------------------------------===//
+bool DuckLakeDeleteBitmap::Container::Add(uint16_t row) {
+	if (IsBitmap()) {
+		auto &word = bitmap[row / 64];
+		auto bit = 1ULL << (row % 64);
+		if (word & bit) {
+			return false;
+		}
+		word |= bit;
+		count++;
+		return true;
+	}
+	if (array.empty() || array.back() < row) {
+		// fast path - rows are usually added in order
+		array.push_back(row);
+	} else {
+		auto entry = std::lower_bound(array.begin(), array.end(), row);
+		if (*entry == row) {
+			return false;
+		}
+		array.insert(entry, row);
+	}
+	count++;
+	if (count > ARRAY_LIMIT) {
+		// the container has become dense - convert it to a bitmap
+		bitmap.resize(BITMAP_WORDS, 0);
+		for (auto entry : array) {
+			bitmap[entry / 64] |= 1ULL << (entry % 64);
+		}
+		array.clear();
+		array.shrink_to_fit();
+	}
+	return true;
+}
+
+bool DuckLakeDeleteBitmap::Container::Contains(uint16_t row) const {
+	if (IsBitmap()) {
+		return bitmap[row / 64] & (1ULL << (row % 64));
+	}
+	return std::binary_search(array.begin(), array.end(), row);
+}
+
+static void OrBits(uint64_t *mask, idx_t position, uint64_t bits, idx_t bit_count) {
+	auto word = position / 64;
+	auto shift = position % 64;
+	mask[word] |= bits << shift;
+	if (shift != 0 && shift + bit_count > 64) {
+		mask[word + 1] |= bits >> (64 - shift);
+	}
+}
+
+static void SetBits(uint64_t *mask, idx_t position, idx_t count) {
+	for (idx_t i = 0; i < count; i += 64) {
+		auto bit_count = MinValue<idx_t>(64, count - i);
+		auto bits = bit_count < 64 ? (1ULL << bit_count) - 1 : ~0ULL;
+		OrBits(mask, position + i, bits, bit_count);
+	}
+}
+
+void DuckLakeDeleteBitmap::Container::GetMask(idx_t offset, idx_t count, uint64_t *mask, idx_t mask_offset) const {
+	if (!IsBitmap()) {
+		auto entry = std::lower_bound(array.begin(), array.end(), offset);
+		for (; entry != array.end() && *entry < offset + count; entry++) {
+			auto position = mask_offset + (*entry - offset);
+			mask[position / 64] |= 1ULL << (position % 64);
+		}
+		return;
+	}
+	// copy the bitmap 64 bits at a time
+	for (idx_t i = 0; i < count; i += 64) {
+		auto source = offset + i;
+		auto word = source / 64;
+		auto shift = source % 64;
+		uint64_t bits = bitmap[word] >> shift;
+		if (shift != 0 && word + 1 < BITMAP_WORDS) {
+			bits |= bitmap[word + 1] << (64 - shift);
+		}
+		auto bit_count = MinValue<idx_t>(64, count - i);
+		if (bit_count < 64) {
+			bits &= (1ULL << bit_count) - 1;
+		}
+		OrBits(mask, mask_offset + i, bits, bit_count);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// DuckLakeDeleteBitmap
+//===--------------------------------------------------------------------===//
+void DuckLakeDeleteBitmap::Add(idx_t row) {
+	auto key = row >> CONTAINER_BITS;
+	auto low = UnsafeNumericCast<uint16_t>(row & (CONTAINER_SIZE - 1));
+	if (containers.empty() || containers.back().key < key) {
+		containers.emplace_back(key);
+	} else if (containers.back().key != key) {
+		auto entry = std::lower_bound(containers.begin(), containers.end(), key,
+		                              [](const Container &container, idx_t key) { return container.key < key; });
+		if (entry->key != key) {
+			entry = containers.insert(entry, Container(key));
+		}
+		if (entry->Add(low)) {
+			total_count++;
+		}
+		return;
+	}
+	if (containers.back().Add(low)) {
+		total_count++;
+	}
+}
+
+optional_ptr<const DuckLakeDeleteBitmap::Container> DuckLakeDeleteBitmap::FindContainer(idx_t key) const {
+	auto entry = std::lower_bound(containers.begin(), containers.end(), key,
+	                              [](const Container &container, idx_t key) { return container.key < key; });
+	if (entry == containers.end() || entry->key != key) {
+		return nullptr;
+	}
+	return &*entry;
+}
+
+bool DuckLakeDeleteBitmap::Contains(idx_t row) const {
+	auto container = FindContainer(row >> CONTAINER_BITS);
+	if (!container) {
+		return false;
+	}
+	return container->Contains(UnsafeNumericCast<uint16_t>(row & (CONTAINER_SIZE - 1)));
+}
+
+void DuckLakeDeleteBitmap::Clear() {
+	containers.clear();
+	total_count = 0;
+}
+
+vector<idx_t> DuckLakeDeleteBitmap::ToVector() const {
+	vector<idx_t> result;
+	result.reserve(total_count);
+	for (auto &container : containers) {
+		auto base = container.key << CONTAINER_BITS;
+		if (!container.IsBitmap()) {
+			for (auto entry : container.array) {
+				result.push_back(base + entry);
+			}
+			continue;
+		}
+		for (idx_t word_idx = 0; word_idx < BITMAP_WORDS; word_idx++) {
+			auto word = container.bitmap[word_idx];
+			while (word) {
+				auto bit = CountZeros<uint64_t>::Trailing(word);
+				result.push_back(base + word_idx * 64 + bit);
+				word &= word - 1;
+			}
+		}
+	}
+	return result;
+}
+
+idx_t DuckLakeDeleteBitmap::EstimatedSize() const {
+	idx_t result = sizeof(DuckLakeDeleteBitmap) + containers.capacity() * sizeof(Container);
+	for (auto &container : containers) {
+		result += container.array.capacity() * sizeof(uint16_t) + container.bitmap.capacity() * sizeof(uint64_t);
+	}
+	return result;
+}
+
+idx_t DuckLakeDeleteBitmap::Filter(idx_t start, idx_t count, SelectionVector &result_sel) const {
+	D_ASSERT(count <= STANDARD_VECTOR_SIZE);
+	if (total_count == 0 || count == 0) {
+		return count;
+	}
+	// construct the mask of deleted rows in this range
+	static constexpr const idx_t MASK_WORDS = STANDARD_VECTOR_SIZE / 64 + 1;
+	uint64_t mask[MASK_WORDS];
+	memset(mask, 0, sizeof(mask));
+	bool has_deletes = false;
+	bool all_deleted = true;
+	idx_t end = start + count;
+	for (idx_t position = start; position < end;) {
+		auto key = position >> CONTAINER_BITS;
+		auto segment_end = MinValue<idx_t>(end, (key + 1) << CONTAINER_BITS);
+		auto container = FindContainer(key);
+		if (!container) {
+			all_deleted = false;
+		} else if (container->count == CONTAINER_SIZE) {
+			// the entire container is deleted
+			has_deletes = true;
+			SetBits(mask, position - start, segment_end - position);
+		} else {
+			has_deletes = true;
+			all_deleted = false;
+			container->GetMask(position & (CONTAINER_SIZE - 1), segment_end - position, mask, position - start);
+		}
+		position = segment_end;
+	}
+	if (!has_deletes) {
+		// nothing in this range is deleted
+		return count;
+	}
+	if (all_deleted) {
+		// everything in this range is deleted
+		return 0;
+	}
+	// construct the selection vector from the mask one word at a time
+	result_sel.Initialize(STANDARD_VECTOR_SIZE);
+	idx_t result_count = 0;
+	for (idx_t base = 0; base < count; base += 64) {
+		auto bit_count = MinValue<idx_t>(64, count - base);
+		uint64_t keep = ~mask[base / 64];
+		if (bit_count < 64) {
+			keep &= (1ULL << bit_count) - 1;
+		}
+		if (keep == 0) {
+			continue;
+		}
+		if (keep == ~0ULL) {
+			// no deletes in this word
+			for (idx_t i = 0; i < 64; i++) {
+				result_sel.set_index(result_count++, base + i);
+			}
+			continue;
+		}
+		while (keep) {
+			auto bit = CountZeros<uint64_t>::Trailing(keep);
+			result_sel.set_index(result_count++, base + bit);
+			keep &= keep - 1;
+		}
+	}
+	return result_count;
+}
+
+} // namespace duckdb
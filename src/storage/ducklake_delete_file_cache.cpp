@@ -0,0 +1,112 @@
+#include "storage/ducklake_delete_file_cache.hpp"
+
+#include "storage/ducklake_delete_filter.hpp"
+
+namespace duckdb {
+
+DuckLakeDeleteFileCache::DuckLakeDeleteFileCache(idx_t max_size, bool shared_loads)
+    : max_size(max_size), shared_loads(shared_loads) {
+}
+
+shared_ptr<DuckLakeDeleteData> DuckLakeDeleteFileCache::Get(const string &path) {
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(path);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	entry->second.last_access = ++access_count;
+	return entry->second.delete_data;
+}
+
+void DuckLakeDeleteFileCache::Insert(const string &path, shared_ptr<DuckLakeDeleteData> delete_data) {
+	auto estimated_size = path.size() + sizeof(DuckLakeDeleteData) + delete_data->deleted_rows.EstimatedSize();
+	if (estimated_size > max_size) {
+		// the deletes do not fit in the cache at all
+		return;
+	}
+	lock_guard<mutex> guard(lock);
+	if (entries.find(path) != entries.end()) {
+		// another thread loaded the same delete file concurrently
+		return;
+	}
+	CacheEntry cache_entry;
+	cache_entry.delete_data = std::move(delete_data);
+	cache_entry.estimated_size = estimated_size;
+	cache_entry.last_access = ++access_count;
+	cache_size += estimated_size;
+	entries.emplace(path, std::move(cache_entry));
+	EvictEntries();
+}
+
+shared_ptr<DuckLakeDeleteData>
+DuckLakeDeleteFileCache::GetOrLoad(const string &path, const std::function<shared_ptr<DuckLakeDeleteData>()> &load) {
+	shared_ptr<PendingLoad> pending;
+	{
+		unique_lock<mutex> guard(lock);
+		auto entry = entries.find(path);
+		if (entry != entries.end()) {
+			entry->second.last_access = ++access_count;
+			return entry->second.delete_data;
+		}
+		if (shared_loads) {
+			auto pending_entry = pending_loads.find(path);
+			if (pending_entry != pending_loads.end()) {
+				// another query is loading the same delete file - wait for it
+				// this also shares the deletes of delete files that are too large to be cached
+				auto in_flight = pending_entry->second;
+				load_finished.wait(guard, [&]() { return in_flight->finished; });
+				if (in_flight->delete_data) {
+					return in_flight->delete_data;
+				}
+				// the other load failed - load the delete file ourselves
+			} else {
+				pending = make_shared_ptr<PendingLoad>();
+				pending_loads.emplace(path, pending);
+			}
+		}
+	}
+	shared_ptr<DuckLakeDeleteData> delete_data;
+	try {
+		delete_data = load();
+	} catch (...) {
+		FinishLoad(path, pending, nullptr);
+		throw;
+	}
+	// insert before finishing the load - so new readers find the deletes either in the cache or in the pending load
+	Insert(path, delete_data);
+	FinishLoad(path, pending, delete_data);
+	return delete_data;
+}
+
+void DuckLakeDeleteFileCache::FinishLoad(const string &path, const shared_ptr<PendingLoad> &pending,
+                                         shared_ptr<DuckLakeDeleteData> delete_data) {
+	if (!pending) {
+		return;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		pending->delete_data = std::move(delete_data);
+		pending->finished = true;
+		pending_loads.erase(path);
+	}
+	load_finished.notify_all();
+}
+
+void DuckLakeDeleteFileCache::EvictEntries() {
+	while (cache_size > max_size) {
+		// evict the least recently used entry
+		auto candidate = entries.end();
+		for (auto entry = entries.begin(); entry != entries.end(); entry++) {
+			if (candidate == entries.end() || entry->second.last_access < candidate->second.last_access) {
+				candidate = entry;
+			}
+		}
+		if (candidate == entries.end()) {
+			return;
+		}
+		cache_size -= candidate->second.estimated_size;
+		entries.erase(candidate);
+	}
+}
+
+} // namespace duckdb
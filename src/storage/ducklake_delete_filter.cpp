@@ -1,4 +1,9 @@
 #include "storage/ducklake_delete_filter.hpp"
+#include "storage/ducklake_delete_file_cache.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_data_file_cache.hpp"
+#include "storage/ducklake_transaction.hpp"
+#include "storage/ducklake_metadata_manager.hpp"
 #include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
 #include "duckdb/parallel/thread_context.hpp"
@@ -10,29 +15,7 @@ DuckLakeDeleteFilter::DuckLakeDeleteFilter() : delete_data(make_shared_ptr<DuckL
 }
 
 idx_t DuckLakeDeleteData::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) const {
-	auto entry = std::lower_bound(deleted_rows.begin(), deleted_rows.end(), start_row_index);
-	if (entry == deleted_rows.end()) {
-		// no filter found for this entry
-		return count;
-	}
-	idx_t end_pos = start_row_index + count;
-	auto delete_idx = NumericCast<idx_t>(entry - deleted_rows.begin());
-	if (deleted_rows[delete_idx] > end_pos) {
-		// nothing in this range is deleted - skip
-		return count;
-	}
-	// we have deletes in this range
-	result_sel.Initialize(STANDARD_VECTOR_SIZE);
-	idx_t result_count = 0;
-	for (idx_t i = 0; i < count; i++) {
-		if (delete_idx < deleted_rows.size() && start_row_index + i == deleted_rows[delete_idx]) {
-			// this row is deleted - skip
-			delete_idx++;
-			continue;
-		}
-		result_sel.set_index(result_count++, i);
-	}
-	return result_count;
+	return deleted_rows.Filter(NumericCast<idx_t>(start_row_index), count, result_sel);
 }
 
 idx_t DuckLakeDeleteFilter::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) {
@@ -48,7 +31,7 @@ idx_t DuckLakeDeleteFilter::Filter(row_t start_row_index, idx_t count, Selection
 	return delete_data->Filter(start_row_index, count, result_sel);
 }
 
-vector<idx_t> DuckLakeDeleteFilter::ScanDeleteFile(ClientContext &context, const DuckLakeFileData &delete_file) {
+DuckLakeDeleteBitmap DuckLakeDeleteFilter::ScanDeleteFile(ClientContext &context, const DuckLakeFileData &delete_file) {
 	auto &instance = DatabaseInstance::GetDatabase(context);
 	ExtensionLoader loader(instance, "ducklake");
 	auto &parquet_scan_entry = loader.GetTableFunction("parquet_scan");
@@ -102,7 +85,7 @@ vector<idx_t> DuckLakeDeleteFilter::ScanDeleteFile(ClientContext &context, const
 	auto global_state = parquet_scan.init_global(context, input);
 	auto local_state = parquet_scan.init_local(execution_context, input, global_state.get());
 
-	vector<idx_t> deleted_rows;
+	DuckLakeDeleteBitmap deleted_rows;
 	int64_t last_delete = -1;
 	while (true) {
 		TableFunctionInput function_input(bind_data.get(), local_state.get(), global_state.get());
@@ -129,34 +112,82 @@ vector<idx_t> DuckLakeDeleteFilter::ScanDeleteFile(ClientContext &context, const
 				    row_id, last_delete);
 			}
 
-			deleted_rows.push_back(row_id);
+			deleted_rows.Add(NumericCast<idx_t>(row_id));
 			last_delete = row_id;
 		}
 	}
 	return deleted_rows;
 }
 
-void DuckLakeDeleteFilter::Initialize(ClientContext &context, const DuckLakeFileData &delete_file) {
-	delete_data->deleted_rows = ScanDeleteFile(context, delete_file);
+shared_ptr<DuckLakeDeleteData> DuckLakeDeleteFilter::LoadDeleteFile(ClientContext &context,
+                                                                    DuckLakeTransaction &transaction,
+                                                                    const DuckLakeFileData &delete_file) {
+	auto result = make_shared_ptr<DuckLakeDeleteData>();
+	bool is_inlined = DuckLakeDeleteFile::IsInlinedDeletePath(delete_file.path);
+	auto delete_file_id = is_inlined ? DuckLakeDeleteFile::GetInlinedDeleteFileId(delete_file.path) : DataFileIndex();
+	if (is_inlined && !delete_file_id.IsValid()) {
+		// transaction-local inlined deletes - read them from the transaction
+		auto local_deletes = transaction.GetLocalInlinedDeletes(delete_file.path);
+		if (!local_deletes) {
+			throw InternalException("Failed to find transaction-local inlined deletes %s", delete_file.path);
+		}
+		for (auto &row_id : local_deletes->inlined_deletes) {
+			result->deleted_rows.Add(row_id);
+		}
+		return result;
+	}
+	auto &cache = transaction.GetCatalog().GetDeleteFileCache();
+	return cache.GetOrLoad(delete_file.path, [&]() {
+		if (is_inlined) {
+			for (auto &row_id : transaction.GetMetadataManager().ReadInlinedDeleteFile(delete_file_id)) {
+				result->deleted_rows.Add(row_id);
+			}
+		} else {
+			// read the delete file from the local disk cache (if any)
+			auto scan_file = delete_file;
+			auto data_file_cache = transaction.GetCatalog().GetDataFileCache();
+			if (data_file_cache) {
+				scan_file.path = data_file_cache->GetLocalPath(delete_file.path, delete_file.file_size_bytes);
+			}
+			if (scan_file.path == delete_file.path) {
+				result->deleted_rows = ScanDeleteFile(context, scan_file);
+			} else {
+				try {
+					result->deleted_rows = ScanDeleteFile(context, scan_file);
+				} catch (std::exception &ex) {
+					// the cached copy might have been evicted concurrently - read the delete file directly instead
+					result->deleted_rows = ScanDeleteFile(context, delete_file);
+				}
+			}
+		}
+		return result;
+	});
+}
+
+void DuckLakeDeleteFilter::Initialize(ClientContext &context, DuckLakeTransaction &transaction,
+                                      const DuckLakeFileData &delete_file) {
+	// delete files are immutable - the loaded deletes can be shared with other readers of the same delete file
+	delete_data = LoadDeleteFile(context, transaction, delete_file);
 }
 
 void DuckLakeDeleteFilter::Initialize(const DuckLakeInlinedDataDeletes &inlined_deletes) {
 	for (auto &idx : inlined_deletes.rows) {
-		delete_data->deleted_rows.push_back(idx);
+		delete_data->deleted_rows.Add(idx);
 	}
 }
 
-void DuckLakeDeleteFilter::Initialize(ClientContext &context, const DuckLakeDeleteScanEntry &delete_scan) {
+void DuckLakeDeleteFilter::Initialize(ClientContext &context, DuckLakeTransaction &transaction,
+                                      const DuckLakeDeleteScanEntry &delete_scan) {
 	// scanning deletes - we need to scan the opposite (i.e. only the rows that were deleted)
 	auto rows_to_scan = make_unsafe_uniq_array<bool>(delete_scan.row_count);
 
 	// scan the current set of deletes
 	if (!delete_scan.delete_file.path.empty()) {
 		// we have a delete file - read the delete file from disk
-		auto current_deletes = ScanDeleteFile(context, delete_scan.delete_file);
+		auto current_deletes = LoadDeleteFile(context, transaction, delete_scan.delete_file);
 		// iterate over the current delets - these are the rows we need to scan
 		memset(rows_to_scan.get(), 0, sizeof(bool) * delete_scan.row_count);
-		for (auto delete_idx : current_deletes) {
+		for (auto delete_idx : current_deletes->deleted_rows.ToVector()) {
 			if (delete_idx >= delete_scan.row_count) {
 				throw InvalidInputException(
 				    "Invalid delete data - delete index read from file %s is out of range for data file %s",
@@ -172,9 +203,9 @@ void DuckLakeDeleteFilter::Initialize(ClientContext &context, const DuckLakeDele
 
 	if (!delete_scan.previous_delete_file.path.empty()) {
 		// if we have a previous delete file - scan that set of deletes
-		auto previous_deletes = ScanDeleteFile(context, delete_scan.previous_delete_file);
+		auto previous_deletes = LoadDeleteFile(context, transaction, delete_scan.previous_delete_file);
 		// these deletes are not new - we should not scan them
-		for (auto delete_idx : previous_deletes) {
+		for (auto delete_idx : previous_deletes->deleted_rows.ToVector()) {
 			if (delete_idx >= delete_scan.row_count) {
 				throw InvalidInputException(
 				    "Invalid delete data - delete index read from file %s is out of range for data file %s",
@@ -188,7 +219,7 @@ void DuckLakeDeleteFilter::Initialize(ClientContext &context, const DuckLakeDele
 	auto &deleted = delete_data->deleted_rows;
 	for (idx_t i = 0; i < delete_scan.row_count; i++) {
 		if (!rows_to_scan[i]) {
-			deleted.push_back(i);
+			deleted.Add(i);
 		}
 	}
 }
@@ -0,0 +1,101 @@
+#include "storage/ducklake_file_size_advisor.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_compaction_tracker.hpp"
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+//! The weight of a new scan in the average read fraction of a table
+static constexpr const double READ_FRACTION_WEIGHT = 0.125;
+//! The minimum time the writes to a table have to be observed for before its write rate is used
+static constexpr const std::chrono::hours MIN_WRITE_OBSERVATION_TIME {1};
+
+void DuckLakeFileSizeAdvisor::RecordScan(TableIndex table_id, idx_t catalog_files, idx_t read_files) {
+	if (catalog_files == 0) {
+		return;
+	}
+	auto read_fraction = static_cast<double>(read_files) / static_cast<double>(catalog_files);
+	lock_guard<mutex> guard(lock);
+	auto &state = tables[table_id.index];
+	if (state.scan_count == 0) {
+		state.read_fraction = read_fraction;
+	} else {
+		state.read_fraction += (read_fraction - state.read_fraction) * READ_FRACTION_WEIGHT;
+	}
+	state.scan_count++;
+}
+
+void DuckLakeFileSizeAdvisor::RecordWrites(const vector<DuckLakeCompactionTrackerChanges> &changes) {
+	auto now = std::chrono::steady_clock::now();
+	lock_guard<mutex> guard(lock);
+	for (auto &table_changes : changes) {
+		if (table_changes.invalidate || table_changes.new_files.empty()) {
+			// compactions rewrite existing data - they do not add to the write rate of a table
+			continue;
+		}
+		auto &state = tables[table_changes.table_id.index];
+		if (state.bytes_written == 0) {
+			state.first_write = now;
+		}
+		for (auto &file : table_changes.new_files) {
+			state.bytes_written += file.file_size_bytes;
+		}
+	}
+}
+
+static idx_t ClampFileSize(idx_t file_size) {
+	file_size = MaxValue<idx_t>(file_size, DuckLakeFileSizeAdvisor::MIN_TARGET_FILE_SIZE);
+	file_size = MinValue<idx_t>(file_size, DuckLakeFileSizeAdvisor::MAX_TARGET_FILE_SIZE);
+	return NextPowerOfTwo(file_size);
+}
+
+DuckLakeFileSizing DuckLakeFileSizeAdvisor::GetAdaptiveFileSizing(TableIndex table_id, idx_t column_count) {
+	DuckLakeFileSizing result;
+	result.target_file_size = DuckLakeCatalog::DEFAULT_TARGET_FILE_SIZE;
+	if (column_count >= WIDE_TABLE_COLUMN_COUNT) {
+		result.target_file_size *= 2;
+	}
+	lock_guard<mutex> guard(lock);
+	auto entry = tables.find(table_id.index);
+	if (entry == tables.end()) {
+		return result;
+	}
+	auto &state = entry->second;
+	if (state.scan_count >= MIN_OBSERVED_SCANS && state.read_fraction <= SELECTIVE_READ_FRACTION) {
+		result.target_file_size /= 4;
+		result.row_group_size = SELECTIVE_ROW_GROUP_SIZE;
+	}
+	if (state.bytes_written > 0) {
+		auto observed_time = std::chrono::steady_clock::now() - state.first_write;
+		if (observed_time >= MIN_WRITE_OBSERVATION_TIME) {
+			auto observed_seconds = std::chrono::duration<double>(observed_time).count();
+			auto bytes_per_day = static_cast<double>(state.bytes_written) * 86400.0 / observed_seconds;
+			if (bytes_per_day < static_cast<double>(result.target_file_size)) {
+				result.target_file_size = static_cast<idx_t>(bytes_per_day);
+			}
+		}
+	}
+	result.target_file_size = ClampFileSize(result.target_file_size);
+	return result;
+}
+
+DuckLakeFileSizing DuckLakeFileSizeAdvisor::GetFileSizing(const DuckLakeCatalog &catalog, SchemaIndex schema_id,
+                                                          TableIndex table_id, idx_t column_count) {
+	DuckLakeFileSizing result;
+	result.target_file_size = DuckLakeCatalog::DEFAULT_TARGET_FILE_SIZE;
+	auto adaptive = catalog.GetConfigOption<string>("adaptive_file_size", schema_id, table_id, "false");
+	if (adaptive == "true" && !table_id.IsTransactionLocal()) {
+		result = GetAdaptiveFileSizing(table_id, column_count);
+	}
+	string target_file_size;
+	if (catalog.TryGetConfigOption("target_file_size", target_file_size, schema_id, table_id)) {
+		result.target_file_size = Value(target_file_size).DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+	}
+	string row_group_size;
+	if (catalog.TryGetConfigOption("parquet_row_group_size", row_group_size, schema_id, table_id)) {
+		result.row_group_size = Value(row_group_size).DefaultCastAs(LogicalType::UBIGINT).GetValue<idx_t>();
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,186 @@
+#include "storage/ducklake_footer_prefetcher.hpp"
+
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/open_file_info.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/caching_file_system.hpp"
+
+namespace duckdb {
+
+//! The Parquet footer is followed by its length (4 bytes) and the magic bytes (4 bytes)
+static constexpr idx_t PARQUET_FOOTER_TRAILER_SIZE = 8;
+
+bool DuckLakeReadAheadBudget::TryReserve(idx_t bytes, idx_t limit) {
+	lock_guard<mutex> guard(lock);
+	if (reserved + bytes > limit) {
+		return false;
+	}
+	reserved += bytes;
+	return true;
+}
+
+void DuckLakeReadAheadBudget::Release(idx_t bytes) {
+	lock_guard<mutex> guard(lock);
+	D_ASSERT(reserved >= bytes);
+	reserved -= bytes;
+}
+
+struct DuckLakePrefetchTaskInfo {
+	idx_t file_idx;
+	DuckLakeFileData file;
+	bool read_file;
+};
+
+struct DuckLakePrefetchState {
+	DuckLakePrefetchState(ClientContext &context, idx_t max_tasks)
+	    : context(context.shared_from_this()), scheduler(TaskScheduler::GetScheduler(context)),
+	      token(scheduler.CreateProducer()), max_tasks(max_tasks) {
+	}
+
+	//! The file system of the client is used for the prefetch - the state does not keep the client alive, since the
+	//! tasks might sit in the queue of the scheduler until the database is shut down
+	weak_ptr<ClientContext> context;
+	TaskScheduler &scheduler;
+	unique_ptr<ProducerToken> token;
+	idx_t max_tasks;
+	mutex lock;
+	//! The files whose footers (or contents) still have to be fetched
+	deque<DuckLakePrefetchTaskInfo> pending_files;
+	//! The files that have been fetched
+	unordered_set<idx_t> finished_files;
+	idx_t active_tasks = 0;
+	//! Set once the scan is finished - or a prefetch failed, after which no more files are fetched
+	bool finished = false;
+	//! An unexpected error that occurred while prefetching - raised in the scan
+	ErrorData error;
+};
+
+static void PrefetchFile(ClientContext &context, const DuckLakePrefetchTaskInfo &task) {
+	auto &file = task.file;
+	idx_t read_size;
+	if (task.read_file) {
+		// read the complete file - this includes the footer
+		read_size = file.file_size_bytes;
+	} else {
+		if (!file.footer_size.IsValid()) {
+			return;
+		}
+		read_size = file.footer_size.GetIndex() + PARQUET_FOOTER_TRAILER_SIZE;
+		if (read_size > file.file_size_bytes) {
+			return;
+		}
+	}
+	// open the file with the same information the scan passes to the reader, so the cached data is re-used
+	OpenFileInfo info(file.path);
+	auto extended_info = make_shared_ptr<ExtendedOpenFileInfo>();
+	extended_info->options["file_size"] = Value::UBIGINT(file.file_size_bytes);
+	extended_info->options["validate_external_file_cache"] = Value::BOOLEAN(false);
+	extended_info->options["etag"] = Value("");
+	extended_info->options["last_modified"] = Value::TIMESTAMP(timestamp_t(0));
+	info.extended_info = std::move(extended_info);
+
+	auto caching_fs = CachingFileSystem::Get(context);
+	auto handle = caching_fs.OpenFile(info, FileFlags::FILE_FLAGS_READ);
+	data_ptr_t buffer;
+	handle->Read(buffer, read_size, file.file_size_bytes - read_size);
+}
+
+class DuckLakePrefetchTask : public Task {
+public:
+	explicit DuckLakePrefetchTask(shared_ptr<DuckLakePrefetchState> state_p) : state(std::move(state_p)) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		while (true) {
+			DuckLakePrefetchTaskInfo task;
+			{
+				lock_guard<mutex> guard(state->lock);
+				if (state->finished || state->pending_files.empty()) {
+					state->active_tasks--;
+					return TaskExecutionResult::TASK_FINISHED;
+				}
+				task = std::move(state->pending_files.front());
+				state->pending_files.pop_front();
+			}
+			auto context = state->context.lock();
+			if (!context) {
+				lock_guard<mutex> guard(state->lock);
+				state->active_tasks--;
+				return TaskExecutionResult::TASK_FINISHED;
+			}
+			try {
+				PrefetchFile(*context, task);
+			} catch (std::exception &ex) {
+				ErrorData error(ex);
+				lock_guard<mutex> guard(state->lock);
+				// a file that cannot be fetched (e.g. because the remote is unreachable) fails in the scan in the same
+				// way - the error is raised there. Any other error is raised in the scan directly
+				auto type = error.Type();
+				if (type != ExceptionType::IO && type != ExceptionType::HTTP && type != ExceptionType::INTERRUPT &&
+				    !state->error.HasError()) {
+					state->error = std::move(error);
+				}
+				// the remaining files would most likely fail in the same way - stop fetching
+				state->finished = true;
+				state->pending_files.clear();
+				continue;
+			}
+			lock_guard<mutex> guard(state->lock);
+			state->finished_files.insert(task.file_idx);
+		}
+	}
+
+private:
+	shared_ptr<DuckLakePrefetchState> state;
+};
+
+DuckLakeFooterPrefetcher::DuckLakeFooterPrefetcher(ClientContext &context, idx_t max_tasks)
+    : state(make_shared_ptr<DuckLakePrefetchState>(context, max_tasks)) {
+}
+
+DuckLakeFooterPrefetcher::~DuckLakeFooterPrefetcher() {
+	// the tasks that are still running finish their current file - queued tasks find nothing left to do
+	lock_guard<mutex> guard(state->lock);
+	state->finished = true;
+	state->pending_files.clear();
+}
+
+void DuckLakeFooterPrefetcher::Prefetch(idx_t file_idx, const DuckLakeFileData &file, bool read_file) {
+#ifndef DUCKDB_NO_THREADS
+	bool schedule_task = false;
+	{
+		lock_guard<mutex> guard(state->lock);
+		if (state->error.HasError()) {
+			state->error.Throw("Failed to prefetch the footer of a DuckLake data file: ");
+		}
+		if (state->finished || state->scheduler.NumberOfThreads() <= 1) {
+			// without background threads the tasks would never run - the files are not prefetched then
+			return;
+		}
+		DuckLakePrefetchTaskInfo task;
+		task.file_idx = file_idx;
+		task.file = file;
+		task.read_file = read_file;
+		state->pending_files.push_back(std::move(task));
+		// tasks are only scheduled once there is something to fetch
+		if (state->active_tasks < state->max_tasks && state->active_tasks < state->pending_files.size()) {
+			state->active_tasks++;
+			schedule_task = true;
+		}
+	}
+	if (schedule_task) {
+		state->scheduler.ScheduleTask(*state->token, make_shared_ptr<DuckLakePrefetchTask>(state));
+	}
+#endif
+}
+
+bool DuckLakeFooterPrefetcher::IsPrefetched(idx_t file_idx) {
+	lock_guard<mutex> guard(state->lock);
+	return state->finished_files.erase(file_idx) > 0;
+}
+
+} // namespace duckdb
@@ -6,6 +6,7 @@
 #include "duckdb/main/connection.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
+#include "common/ducklake_util.hpp"
 #include "storage/ducklake_initializer.hpp"
 #include "storage/ducklake_catalog.hpp"
 #include "storage/ducklake_transaction.hpp"
@@ -49,8 +50,28 @@ string DuckLakeInitializer::GetAttachOptions() {
 	return " (" + result + ")";
 }
 
+void DuckLakeInitializer::AttachReadReplica(DuckLakeTransaction &transaction) {
+	auto replica_path = options.metadata_read_replica;
+	if (StringUtil::StartsWith(replica_path, "postgres:")) {
+		replica_path = replica_path.substr(strlen("postgres:"));
+	}
+	// the replica is only ever read from - snapshot-pinned reads are routed to it by the metadata manager
+	auto result = transaction.Query("ATTACH " + DuckLakeUtil::SQLLiteralToString(replica_path) + " AS " +
+	                                DuckLakeUtil::SQLIdentifierToString(options.metadata_replica_database) +
+	                                " (TYPE postgres, READ_ONLY)");
+	if (result->HasError()) {
+		auto &error_obj = result->GetErrorObject();
+		error_obj.Throw("Failed to attach the read replica of the DuckLake MetaData \"" +
+		                catalog.MetadataDatabaseName() + "\"");
+	}
+}
+
 void DuckLakeInitializer::Initialize() {
 	auto &transaction = DuckLakeTransaction::Get(context, catalog);
+	auto &metadata_type = catalog.MetadataType();
+	if (!options.metadata_read_replica.empty() && metadata_type != "postgres" && metadata_type != "postgres_scanner") {
+		throw InvalidInputException("METADATA_READ_REPLICA is only supported for Postgres metadata catalogs");
+	}
 	// attach the metadata database
 	auto result =
 	    transaction.Query("ATTACH {METADATA_PATH} AS {METADATA_CATALOG_NAME_IDENTIFIER}" + GetAttachOptions());
@@ -59,8 +80,18 @@ void DuckLakeInitializer::Initialize() {
 		error_obj.Throw("Failed to attach DuckLake MetaData \"" + catalog.MetadataDatabaseName() + "\" at path + \"" +
 		                catalog.MetadataPath() + "\"");
 	}
+	if (!options.metadata_read_replica.empty()) {
+		AttachReadReplica(transaction);
+	}
 	// explicitly load all secrets - work-around to secret initialization bug
 	transaction.Query("FROM duckdb_secrets()");
+	{
+		// a DuckDB database file can only be written to by the process that has it attached - so every snapshot is
+		// committed through this catalog, and the latest snapshot it has observed can be re-used without checking
+		auto &metadata_catalog = Catalog::GetCatalog(*transaction.GetConnection().context, options.metadata_database);
+		catalog.SetExclusiveMetadata(metadata_catalog.IsDuckCatalog() &&
+		                             (metadata_type.empty() || metadata_type == "duckdb"));
+	}
 
 	bool has_explicit_schema = !options.metadata_schema.empty();
 	if (options.metadata_schema.empty()) {
@@ -93,6 +124,7 @@ void DuckLakeInitializer::Initialize() {
 		InitializeNewDuckLake(transaction, has_explicit_schema);
 	} else {
 		LoadExistingDuckLake(transaction);
+		catalog.LoadMetadataCache(transaction);
 	}
 	if (options.at_clause) {
 		// if the user specified a snapshot try to load it to trigger an error if it does not exist
@@ -135,6 +167,8 @@ void DuckLakeInitializer::InitializeNewDuckLake(DuckLakeTransaction &transaction
 	}
 	auto &metadata_manager = transaction.GetMetadataManager();
 	metadata_manager.InitializeDuckLake(has_explicit_schema, catalog.Encryption());
+	metadata_manager.CreateMetadataIndexes();
+	catalog.SetSnapshotChangeIndex(true);
 	if (catalog.Encryption() == DuckLakeEncryption::AUTOMATIC) {
 		// default to unencrypted
 		catalog.SetEncryption(DuckLakeEncryption::UNENCRYPTED);
@@ -148,7 +182,8 @@ void DuckLakeInitializer::LoadExistingDuckLake(DuckLakeTransaction &transaction)
 	for (auto &tag : metadata.tags) {
 		if (tag.key == "version") {
 			string version = tag.value;
-			if (version != "0.3" && !options.migrate_if_required) {
+			bool is_current_version = version == "0.3" || version == DUCKLAKE_EXTENDED_VERSION;
+			if (!is_current_version && !options.migrate_if_required) {
 				// Throw when Loading the Ducklake if a Migration is required and migrate_if_required option is false
 				throw InvalidInputException("DuckLake Extension requires a DuckLake Catalog version of 0.3 or "
 				                            "higher, current version is %s "
@@ -167,8 +202,9 @@ void DuckLakeInitializer::LoadExistingDuckLake(DuckLakeTransaction &transaction)
 				metadata_manager.MigrateV02(true);
 				version = "0.3";
 			}
-			if (version != "0.3") {
-				throw NotImplementedException("Only DuckLake versions 0.1, 0.2, 0.3-dev1 and 0.3 are supported");
+			if (version != "0.3" && version != DUCKLAKE_EXTENDED_VERSION) {
+				throw NotImplementedException("Only DuckLake versions 0.1, 0.2, 0.3-dev1, 0.3 and %s are supported",
+				                              DUCKLAKE_EXTENDED_VERSION);
 			}
 		}
 		if (tag.key == "data_path") {
@@ -206,6 +242,12 @@ void DuckLakeInitializer::LoadExistingDuckLake(DuckLakeTransaction &transaction)
 	for (auto &entry : metadata.table_settings) {
 		options.table_options[entry.table_id][entry.tag.key] = entry.tag.value;
 	}
+	if (options.access_mode != AccessMode::READ_ONLY && !options.at_clause) {
+		// create any indexes that were added after the DuckLake was created - either by a migration or by a newer
+		// release of the same DuckLake version
+		metadata_manager.CreateMetadataIndexes();
+	}
+	catalog.SetSnapshotChangeIndex(metadata_manager.HasSnapshotChangeIndex());
 }
 
 } // namespace duckdb
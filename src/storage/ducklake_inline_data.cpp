@@ -1,5 +1,6 @@
 #include "storage/ducklake_inline_data.hpp"
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/type_visitor.hpp"
 #include "storage/ducklake_insert.hpp"
 #include "storage/ducklake_table_entry.hpp"
@@ -39,18 +40,24 @@ public:
 	}
 
 	InlinePhase AddRows(InlineDataState &state, idx_t new_rows) {
+		// reserve the rows - every thread decides by itself whether or not we are still inlining
+		auto new_total = total_inlined_rows.fetch_add(new_rows) + new_rows;
+		if (new_total <= op.inline_row_limit) {
+			// we are still inlining rows
+			return InlinePhase::INLINING_ROWS;
+		}
+		// we have exceeded the total amount of rows - bail
+		// this happens at most once per thread, since the thread passes through all subsequent rows
 		lock_guard<mutex> guard(lock);
-		total_inlined_rows += new_rows;
-		if (total_inlined_rows > op.inline_row_limit) {
-			// we have exceeded the total amount of rows - bail
-			if (global_inlined_data) {
-				// if we have any global inlined data - add it to the local inlined data so we can emit it
-				AddToCollection(std::move(global_inlined_data), state.inlined_data);
-			}
-			return InlinePhase::PASS_THROUGH_ROWS;
+		if (global_inlined_data) {
+			// if we have any global inlined data - add it to the local inlined data so we can emit it
+			AddToCollection(std::move(global_inlined_data), state.inlined_data);
 		}
-		// we are still inlining rows
-		return InlinePhase::INLINING_ROWS;
+		return InlinePhase::PASS_THROUGH_ROWS;
+	}
+
+	bool ExceededLimit() const {
+		return total_inlined_rows.load() > op.inline_row_limit;
 	}
 
 	static void AddToCollection(unique_ptr<ColumnDataCollection> source, unique_ptr<ColumnDataCollection> &target) {
@@ -58,17 +65,14 @@ public:
 			target = std::move(source);
 			return;
 		}
-		ColumnDataAppendState append_state;
-		target->InitializeAppend(append_state);
-		for (auto &chunk : source->Chunks()) {
-			target->Append(append_state, chunk);
-		}
+		// move over the segments of the source collection instead of copying the rows
+		target->Combine(*source);
 	}
 
 	const DuckLakeInlineData &op;
+	//! Lock protecting the global inlined data
 	mutex lock;
-	idx_t total_inlined_rows = 0;
-	InlinePhase global_phase = InlinePhase::INLINING_ROWS;
+	atomic<idx_t> total_inlined_rows;
 	unique_ptr<ColumnDataCollection> global_inlined_data;
 };
 
@@ -142,8 +146,9 @@ OperatorFinalizeResultType DuckLakeInlineData::FinalExecute(ExecutionContext &co
 		return OperatorFinalizeResultType::FINISHED;
 	}
 	// push the inlined data into the global inlined data
+	// the limit has to be checked while holding the lock - a thread that exceeds the limit takes the global data
 	lock_guard<mutex> guard(gstate.lock);
-	if (gstate.total_inlined_rows > inline_row_limit) {
+	if (gstate.ExceededLimit()) {
 		// we have changed our mind on inlining - we need to emit the rows again
 		state.inlined_data->InitializeScan(state.emit_scan);
 		state.phase = InlinePhase::EMITTING_PREVIOUSLY_INLINED_ROWS;
@@ -5,6 +5,11 @@
 #include "duckdb/storage/table/column_segment.hpp"
 #include "duckdb/planner/table_filter_state.hpp"
 #include "storage/ducklake_delete_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/filter/null_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
 
 namespace duckdb {
 
@@ -20,6 +25,64 @@ DuckLakeInlinedDataReader::DuckLakeInlinedDataReader(DuckLakeFunctionInfo &read_
 	columns = std::move(columns_p);
 }
 
+//! Convert a table filter into a SQL predicate that can be pushed into the query on the inlined data table
+//! Returns an empty string if the filter cannot be converted - the filters are always re-applied after reading
+static string InlinedFilterToSQL(const string &column_name, const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		return column_name + " " + ExpressionTypeToOperator(constant_filter.comparison_type) + " " +
+		       constant_filter.constant.ToSQLString();
+	}
+	case TableFilterType::IS_NULL:
+		return column_name + " IS NULL";
+	case TableFilterType::IS_NOT_NULL:
+		return column_name + " IS NOT NULL";
+	case TableFilterType::IN_FILTER: {
+		auto &in_filter = filter.Cast<InFilter>();
+		vector<string> values;
+		for (auto &value : in_filter.values) {
+			values.push_back(value.ToSQLString());
+		}
+		return column_name + " IN (" + StringUtil::Join(values, ", ") + ")";
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		// we can push any subset of the children of an AND
+		auto &and_filter = filter.Cast<ConjunctionAndFilter>();
+		vector<string> children;
+		for (auto &child_filter : and_filter.child_filters) {
+			auto child = InlinedFilterToSQL(column_name, *child_filter);
+			if (!child.empty()) {
+				children.push_back("(" + child + ")");
+			}
+		}
+		return StringUtil::Join(children, " AND ");
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		// we can only push an OR if we can push all of its children
+		auto &or_filter = filter.Cast<ConjunctionOrFilter>();
+		vector<string> children;
+		for (auto &child_filter : or_filter.child_filters) {
+			auto child = InlinedFilterToSQL(column_name, *child_filter);
+			if (child.empty()) {
+				return string();
+			}
+			children.push_back("(" + child + ")");
+		}
+		return StringUtil::Join(children, " OR ");
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional_filter = filter.Cast<OptionalFilter>();
+		if (!optional_filter.child_filter) {
+			return string();
+		}
+		return InlinedFilterToSQL(column_name, *optional_filter.child_filter);
+	}
+	default:
+		return string();
+	}
+}
+
 bool DuckLakeInlinedDataReader::TryInitializeScan(ClientContext &context, GlobalTableFunctionState &gstate,
                                                   LocalTableFunctionState &lstate) {
 	{
@@ -86,21 +149,34 @@ bool DuckLakeInlinedDataReader::TryInitializeScan(ClientContext &context, Global
 			columns_to_read.push_back("row_id");
 			virtual_columns.emplace_back(InlinedVirtualColumn::COLUMN_EMPTY);
 		}
+		// push the filters into the read so we only fetch the qualifying rows from the metadata catalog
+		vector<string> pushed_filters;
+		if (filters) {
+			for (auto &entry : filters->filters) {
+				auto column_name = KeywordHelper::WriteOptionallyQuoted(columns_to_read[entry.first]);
+				auto filter_sql = InlinedFilterToSQL(column_name, *entry.second);
+				if (!filter_sql.empty()) {
+					pushed_filters.push_back("(" + filter_sql + ")");
+				}
+			}
+		}
+		auto filter = StringUtil::Join(pushed_filters, " AND ");
 		switch (read_info.scan_type) {
 		case DuckLakeScanType::SCAN_TABLE:
-			data = metadata_manager.ReadInlinedData(read_info.snapshot, table_name, columns_to_read);
+			data = metadata_manager.ReadInlinedData(read_info.snapshot, table_name, columns_to_read, filter);
 			break;
 		case DuckLakeScanType::SCAN_INSERTIONS:
 			data = metadata_manager.ReadInlinedDataInsertions(*read_info.start_snapshot, read_info.snapshot, table_name,
-			                                                  columns_to_read);
+			                                                  columns_to_read, filter);
 			break;
 		case DuckLakeScanType::SCAN_DELETIONS:
 			data = metadata_manager.ReadInlinedDataDeletions(*read_info.start_snapshot, read_info.snapshot, table_name,
-			                                                 columns_to_read);
+			                                                 columns_to_read, filter);
 			break;
 		default:
 			throw InternalException("Unknown DuckLake scan type");
 		}
+		read_info.metrics.inlined_data_bytes += data->data->SizeInBytes();
 		if (!virtual_columns.empty()) {
 			auto scan_types = data->data->Types();
 			scan_chunk.Initialize(context, scan_types);
@@ -108,18 +184,22 @@ bool DuckLakeInlinedDataReader::TryInitializeScan(ClientContext &context, Global
 		if (deletion_filter) {
 			// map the deleted row-ids to the deleted ordinals to obtain the correct deleted rows
 			auto &filter = reinterpret_cast<DuckLakeDeleteFilter &>(*deletion_filter);
-			vector<idx_t> deleted_ordinals;
+			DuckLakeDeleteBitmap deleted_ordinals;
 			auto &deleted_row_ids = filter.delete_data->deleted_rows;
-			idx_t current_idx = 0;
+			// only scan the row-id column - the other columns are not needed for the mapping
+			auto &collection = *data->data;
+			vector<column_t> row_id_column {collection.ColumnCount() - 1};
+			ColumnDataScanState row_id_state;
+			collection.InitializeScan(row_id_state, row_id_column);
+			DataChunk row_id_chunk;
+			row_id_chunk.Initialize(context, {collection.Types().back()});
 			idx_t ordinal_position = 0;
-			for (auto &chunk : data->data->Chunks()) {
-				auto &row_id_vector = chunk.data.back();
-				auto row_id_data = FlatVector::GetData<int64_t>(row_id_vector);
-				for (idx_t r = 0; r < chunk.size(); r++) {
+			while (collection.Scan(row_id_state, row_id_chunk)) {
+				auto row_id_data = FlatVector::GetData<int64_t>(row_id_chunk.data[0]);
+				for (idx_t r = 0; r < row_id_chunk.size(); r++) {
 					auto row_id = NumericCast<idx_t>(row_id_data[r]);
-					if (current_idx < deleted_row_ids.size() && deleted_row_ids[current_idx] == row_id) {
-						deleted_ordinals.push_back(ordinal_position);
-						current_idx++;
+					if (deleted_row_ids.Contains(row_id)) {
+						deleted_ordinals.Add(ordinal_position);
 					}
 					ordinal_position++;
 				}
@@ -149,7 +229,8 @@ bool DuckLakeInlinedDataReader::TryInitializeScan(ClientContext &context, Global
 		}
 		scan_chunk.Initialize(context, scan_types);
 
-		data->data->InitializeScan(state, scan_column_ids);
+		// the scan references the vectors of the transaction-local collection directly instead of copying them
+		data->data->InitializeScan(state, scan_column_ids, ColumnDataScanProperties::ALLOW_ZERO_COPY);
 	}
 	return true;
 }
@@ -168,13 +249,10 @@ void DuckLakeInlinedDataReader::Scan(ClientContext &context, GlobalTableFunction
 				chunk.data[c].Reference(scan_chunk.data[column_id]);
 				break;
 			}
-			case InlinedVirtualColumn::COLUMN_ROW_ID: {
-				auto row_id_data = FlatVector::GetData<int64_t>(chunk.data[c]);
-				for (idx_t r = 0; r < scan_chunk.size(); r++) {
-					row_id_data[r] = NumericCast<int64_t>(file_row_number + r);
-				}
-				continue;
-			}
+			case InlinedVirtualColumn::COLUMN_ROW_ID:
+				// the file row numbers are consecutive - emit them as a sequence instead of materializing them
+				chunk.data[c].Sequence(file_row_number, 1, scan_chunk.size());
+				break;
 			case InlinedVirtualColumn::COLUMN_EMPTY:
 				break;
 			}
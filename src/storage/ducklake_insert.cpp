@@ -1,4 +1,5 @@
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_file_size_advisor.hpp"
 #include "storage/ducklake_schema_entry.hpp"
 #include "storage/ducklake_field_data.hpp"
 #include "storage/ducklake_insert.hpp"
@@ -7,15 +8,18 @@
 #include "common/ducklake_util.hpp"
 #include "storage/ducklake_scan.hpp"
 #include "storage/ducklake_inline_data.hpp"
+#include "storage/ducklake_buffer_data.hpp"
 #include "common/ducklake_types.hpp"
 
 #include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
+#include "duckdb/execution/operator/order/physical_order.hpp"
 #include "duckdb/execution/operator/projection/physical_projection.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/planner/operator/logical_insert.hpp"
 #include "duckdb/planner/operator/logical_create_table.hpp"
 #include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
 #include "duckdb/main/extension_helper.hpp"
@@ -61,6 +65,10 @@ unique_ptr<GlobalSinkState> DuckLakeInsert::GetGlobalSinkState(ClientContext &co
 	return make_uniq<DuckLakeInsertGlobalState>(*table_ptr);
 }
 
+unique_ptr<LocalSinkState> DuckLakeInsert::GetLocalSinkState(ExecutionContext &context) const {
+	return make_uniq<DuckLakeInsertLocalState>();
+}
+
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
@@ -125,6 +133,12 @@ DuckLakeColumnStats DuckLakeInsert::ParseColumnStats(const LogicalType &type, co
 
 void DuckLakeInsert::AddWrittenFiles(DuckLakeInsertGlobalState &global_state, DataChunk &chunk,
                                      const string &encryption_key, optional_idx partition_id, bool set_snapshot_id) {
+	AddWrittenFiles(global_state, global_state.written_files, chunk, encryption_key, partition_id, set_snapshot_id);
+}
+
+void DuckLakeInsert::AddWrittenFiles(const DuckLakeInsertGlobalState &global_state, vector<DuckLakeDataFile> &result,
+                                     DataChunk &chunk, const string &encryption_key, optional_idx partition_id,
+                                     bool set_snapshot_id) {
 	for (idx_t r = 0; r < chunk.size(); r++) {
 		DuckLakeDataFile data_file;
 		data_file.file_name = chunk.GetValue(0, r).GetValue<string>();
@@ -192,16 +206,213 @@ void DuckLakeInsert::AddWrittenFiles(DuckLakeInsertGlobalState &global_state, Da
 			throw InvalidInputException("Did not find written snapshot id - but operation requires it to be set");
 		}
 
-		global_state.written_files.push_back(std::move(data_file));
+		result.push_back(std::move(data_file));
+	}
+}
+
+void DuckLakeInsert::ComputeBloomFilters(ClientContext &context, DuckLakeTableEntry &table,
+                                         vector<DuckLakeDataFile> &written_files) {
+	if (written_files.empty()) {
+		return;
+	}
+	auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+	string bloom_filter_columns;
+	if (!catalog.TryGetConfigOption("bloom_filter_columns", bloom_filter_columns, table)) {
+		return;
+	}
+	vector<reference<const DuckLakeFieldId>> fields;
+	for (auto &column_name : StringUtil::Split(bloom_filter_columns, ',')) {
+		StringUtil::Trim(column_name);
+		auto field_id = table.TryGetFieldId(vector<string> {column_name});
+		if (!field_id || field_id->HasChildren()) {
+			// Bloom filters are only computed for primitive top-level columns
+			continue;
+		}
+		fields.push_back(*field_id);
+	}
+	if (fields.empty()) {
+		return;
+	}
+	// the written files only return min/max stats - read back the hashes of the distinct values of each column
+	auto &transaction = DuckLakeTransaction::Get(context, catalog);
+	for (auto &data_file : written_files) {
+		if (!data_file.encryption_key.empty()) {
+			// FIXME: support encrypted files
+			continue;
+		}
+		vector<reference<const DuckLakeFieldId>> file_fields;
+		for (auto &field_ref : fields) {
+			auto entry = data_file.column_stats.find(field_ref.get().GetFieldIndex());
+			if (entry == data_file.column_stats.end() || entry->second.extra_stats) {
+				continue;
+			}
+			file_fields.push_back(field_ref);
+		}
+		if (file_fields.empty()) {
+			continue;
+		}
+		auto source = StringUtil::Format("read_parquet(%s)", SQLString(data_file.file_name));
+		auto bloom_filters = ComputeFileBloomFilters(transaction, file_fields, source);
+		for (idx_t i = 0; i < file_fields.size(); i++) {
+			auto &stats = data_file.column_stats.find(file_fields[i].get().GetFieldIndex())->second;
+			stats.extra_stats = std::move(bloom_filters[i]);
+		}
+	}
+}
+
+vector<unique_ptr<DuckLakeColumnBloomFilterStats>>
+DuckLakeInsert::ComputeFileBloomFilters(DuckLakeTransaction &transaction,
+                                        const vector<reference<const DuckLakeFieldId>> &fields, const string &source) {
+	// the values stored in the file can have a different type than the column (e.g. after the column was widened) -
+	// cast them to the type of the column so they hash the same as the constants the Bloom filters are probed with
+	string select_list;
+	for (auto &field_ref : fields) {
+		auto &field_id = field_ref.get();
+		auto column_name = SQLIdentifier(field_id.Name());
+		if (!select_list.empty()) {
+			select_list += ", ";
+		}
+		select_list += StringUtil::Format("LIST(DISTINCT hash(CAST(%s AS %s))) FILTER (WHERE %s IS NOT NULL)",
+		                                  column_name, field_id.Type().ToString(), column_name);
+	}
+	auto result = transaction.Query(StringUtil::Format("SELECT %s FROM %s", select_list, source));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to compute Bloom filter for DuckLake: ");
+	}
+	vector<unique_ptr<DuckLakeColumnBloomFilterStats>> bloom_filters;
+	for (auto &row : *result) {
+		for (idx_t i = 0; i < fields.size(); i++) {
+			vector<hash_t> hashes;
+			auto hash_list = row.GetValue<Value>(i);
+			if (!hash_list.IsNull()) {
+				for (auto &hash : ListValue::GetChildren(hash_list)) {
+					hashes.push_back(hash.GetValue<uint64_t>());
+				}
+			}
+			auto bloom_filter = make_uniq<DuckLakeColumnBloomFilterStats>(fields[i].get().Type(), hashes.size());
+			for (auto &hash : hashes) {
+				bloom_filter->Insert(hash);
+			}
+			bloom_filters.push_back(std::move(bloom_filter));
+		}
+	}
+	if (bloom_filters.size() != fields.size()) {
+		throw InternalException("Failed to compute Bloom filter for DuckLake: unexpected result");
+	}
+	return bloom_filters;
+}
+
+void DuckLakeInsert::ComputeHistograms(ClientContext &context, DuckLakeTableEntry &table,
+                                       vector<DuckLakeDataFile> &written_files) {
+	if (written_files.empty()) {
+		return;
+	}
+	auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+	string histogram_columns;
+	if (!catalog.TryGetConfigOption("histogram_columns", histogram_columns, table)) {
+		return;
+	}
+	vector<reference<const DuckLakeFieldId>> fields;
+	for (auto &column_name : StringUtil::Split(histogram_columns, ',')) {
+		StringUtil::Trim(column_name);
+		auto field_id = table.TryGetFieldId(vector<string> {column_name});
+		if (!field_id || field_id->HasChildren() || !DuckLakeColumnHistogramStats::SupportsType(field_id->Type())) {
+			// histograms are only computed for top-level numeric and temporal columns
+			continue;
+		}
+		fields.push_back(*field_id);
+	}
+	if (fields.empty()) {
+		return;
+	}
+	string quantiles;
+	for (idx_t i = 0; i <= DuckLakeColumnHistogramStats::BUCKET_COUNT; i++) {
+		quantiles += quantiles.empty() ? "[" : ", ";
+		quantiles += to_string(static_cast<double>(i) / DuckLakeColumnHistogramStats::BUCKET_COUNT);
+	}
+	quantiles += "]";
+	// the written files only return min/max stats - read back the quantiles of each column
+	auto &transaction = DuckLakeTransaction::Get(context, catalog);
+	for (auto &data_file : written_files) {
+		if (!data_file.encryption_key.empty()) {
+			// FIXME: support encrypted files
+			continue;
+		}
+		vector<reference<const DuckLakeFieldId>> file_fields;
+		string select_list;
+		for (auto &field_ref : fields) {
+			auto &field_id = field_ref.get();
+			auto entry = data_file.column_stats.find(field_id.GetFieldIndex());
+			if (entry == data_file.column_stats.end() || entry->second.extra_stats) {
+				// columns that already have extra stats (e.g. a Bloom filter) are skipped
+				continue;
+			}
+			auto column_name = SQLIdentifier(field_id.Name());
+			select_list += select_list.empty() ? "" : ", ";
+			select_list += StringUtil::Format("COUNT(%s), quantile_disc(%s, %s)", column_name, column_name, quantiles);
+			file_fields.push_back(field_id);
+		}
+		if (file_fields.empty()) {
+			continue;
+		}
+		auto result = transaction.Query(
+		    StringUtil::Format("SELECT %s FROM read_parquet(%s)", select_list, SQLString(data_file.file_name)));
+		if (result->HasError()) {
+			result->GetErrorObject().Throw("Failed to compute histogram for DuckLake: ");
+		}
+		for (auto &row : *result) {
+			for (idx_t field_idx = 0; field_idx < file_fields.size(); field_idx++) {
+				auto &field_id = file_fields[field_idx].get();
+				auto value_count = row.GetValue<idx_t>(field_idx * 2);
+				if (value_count == 0) {
+					continue;
+				}
+				auto quantile_list = row.GetValue<Value>(field_idx * 2 + 1);
+				vector<double> bounds;
+				for (auto &quantile : ListValue::GetChildren(quantile_list)) {
+					double bound;
+					if (!DuckLakeColumnHistogramStats::TryConvert(field_id.Type(), quantile, bound)) {
+						// e.g. infinite values - we cannot build a histogram
+						bounds.clear();
+						break;
+					}
+					bounds.push_back(bound);
+				}
+				if (bounds.empty()) {
+					continue;
+				}
+				auto histogram = make_uniq<DuckLakeColumnHistogramStats>();
+				histogram->Initialize(bounds, value_count);
+				data_file.column_stats.find(field_id.GetFieldIndex())->second.extra_stats = std::move(histogram);
+			}
+		}
 	}
 }
 
 SinkResultType DuckLakeInsert::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
 	auto &global_state = input.global_state.Cast<DuckLakeInsertGlobalState>();
-	AddWrittenFiles(global_state, chunk, encryption_key, partition_id);
+	auto &local_state = input.local_state.Cast<DuckLakeInsertLocalState>();
+	// parse the written files (and their stats) into the thread-local list
+	AddWrittenFiles(global_state, local_state.written_files, chunk, encryption_key, partition_id);
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
+//===--------------------------------------------------------------------===//
+// Combine
+//===--------------------------------------------------------------------===//
+SinkCombineResultType DuckLakeInsert::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
+	auto &global_state = input.global_state.Cast<DuckLakeInsertGlobalState>();
+	auto &local_state = input.local_state.Cast<DuckLakeInsertLocalState>();
+	if (local_state.written_files.empty()) {
+		return SinkCombineResultType::FINISHED;
+	}
+	lock_guard<mutex> guard(global_state.lock);
+	for (auto &data_file : local_state.written_files) {
+		global_state.written_files.push_back(std::move(data_file));
+	}
+	return SinkCombineResultType::FINISHED;
+}
+
 //===--------------------------------------------------------------------===//
 // GetData
 //===--------------------------------------------------------------------===//
@@ -220,9 +431,13 @@ SinkFinalizeType DuckLakeInsert::Finalize(Pipeline &pipeline, Event &event, Clie
                                           OperatorSinkFinalizeInput &input) const {
 	auto &global_state = input.global_state.Cast<DuckLakeInsertGlobalState>();
 
-	for (auto &data_file : global_state.written_files) {
-		global_state.total_insert_count += data_file.row_count;
+	if (global_state.count_written_rows) {
+		for (auto &data_file : global_state.written_files) {
+			global_state.total_insert_count += data_file.row_count;
+		}
 	}
+	ComputeBloomFilters(context, global_state.table, global_state.written_files);
+	ComputeHistograms(context, global_state.table, global_state.written_files);
 	auto &transaction = DuckLakeTransaction::Get(context, global_state.table.catalog);
 	transaction.AppendFiles(global_state.table.GetTableId(), std::move(global_state.written_files));
 
@@ -374,8 +589,14 @@ static unique_ptr<Expression> GetColumnReference(DuckLakeCopyInput &copy_input,
 }
 
 static unique_ptr<Expression> GetFunction(ClientContext &context, DuckLakeCopyInput &copy_input,
-                                          const string &function_name, FieldIndex field_id) {
+                                          const string &function_name, FieldIndex field_id,
+                                          optional_idx parameter = optional_idx()) {
 	vector<unique_ptr<Expression>> children;
+	if (parameter.IsValid()) {
+		// bucket and truncate transforms take their parameter as the first argument
+		auto parameter_value = Value::BIGINT(NumericCast<int64_t>(parameter.GetIndex()));
+		children.push_back(make_uniq<BoundConstantExpression>(std::move(parameter_value)));
+	}
 	children.push_back(GetColumnReference(copy_input, field_id));
 
 	ErrorData error;
@@ -400,6 +621,10 @@ static unique_ptr<Expression> GetPartitionExpression(ClientContext &context, Duc
 		return GetFunction(context, copy_input, "day", field.field_id);
 	case DuckLakeTransformType::HOUR:
 		return GetFunction(context, copy_input, "hour", field.field_id);
+	case DuckLakeTransformType::BUCKET:
+		return GetFunction(context, copy_input, "ducklake_bucket", field.field_id, field.transform.parameter);
+	case DuckLakeTransformType::TRUNCATE:
+		return GetFunction(context, copy_input, "ducklake_truncate", field.field_id, field.transform.parameter);
 	default:
 		throw NotImplementedException("Unsupported partition transform type in GetPartitionExpression");
 	}
@@ -424,6 +649,12 @@ static string GetPartitionExpressionName(DuckLakeCopyInput &copy_input, const Du
 	case DuckLakeTransformType::HOUR:
 		prefix = "hour";
 		break;
+	case DuckLakeTransformType::BUCKET:
+		prefix = "bucket";
+		break;
+	case DuckLakeTransformType::TRUNCATE:
+		prefix = "truncate";
+		break;
 	default:
 		throw NotImplementedException("Unsupported partition transform type in GetPartitionExpressionName");
 	}
@@ -492,6 +723,45 @@ static void GeneratePartitionExpressions(ClientContext &context, DuckLakeCopyInp
 	}
 }
 
+vector<BoundOrderByNode> DuckLakeInsert::GetSortOrders(ClientContext &context, DuckLakeCopyInput &copy_input) {
+	vector<BoundOrderByNode> result;
+	auto &catalog = copy_input.catalog;
+	auto sort_partitioned_writes =
+	    catalog.GetConfigOption<string>("sort_partitioned_writes", copy_input.schema_id, copy_input.table_id, "false");
+	if (copy_input.partition_data && sort_partitioned_writes == "true") {
+		// cluster the rows by partition - this way partitions are written one after the other, instead of having to
+		// keep a writer open for every partition at the same time
+		for (auto &field : copy_input.partition_data->fields) {
+			result.emplace_back(OrderType::ASCENDING, OrderByNullType::NULLS_LAST,
+			                    GetPartitionExpression(context, copy_input, field));
+		}
+	}
+	string sorted_by;
+	if (!catalog.TryGetConfigOption("sorted_by", sorted_by, copy_input.schema_id, copy_input.table_id)) {
+		return result;
+	}
+	// comma-separated list of columns, optionally followed by ASC or DESC
+	for (auto &entry : StringUtil::Split(sorted_by, ',')) {
+		StringUtil::Trim(entry);
+		auto parts = StringUtil::Split(entry, ' ');
+		if (parts.empty() || parts.size() > 2 || !copy_input.columns.ColumnExists(parts[0])) {
+			continue;
+		}
+		auto order_type = OrderType::ASCENDING;
+		if (parts.size() == 2) {
+			if (StringUtil::CIEquals(parts[1], "desc")) {
+				order_type = OrderType::DESCENDING;
+			} else if (!StringUtil::CIEquals(parts[1], "asc")) {
+				continue;
+			}
+		}
+		auto &col = copy_input.columns.GetColumn(parts[0]);
+		auto expr = CreateColumnReference(copy_input, col.Type(), col.Physical().index);
+		result.emplace_back(order_type, OrderByNullType::NULLS_LAST, std::move(expr));
+	}
+	return result;
+}
+
 DuckLakeCopyOptions DuckLakeInsert::GetCopyOptions(ClientContext &context, DuckLakeCopyInput &copy_input) {
 	auto info = make_uniq<CopyInfo>();
 	auto &catalog = copy_input.catalog;
@@ -529,9 +799,11 @@ DuckLakeCopyOptions DuckLakeInsert::GetCopyOptions(ClientContext &context, DuckL
 	if (catalog.TryGetConfigOption("parquet_compression_level", parquet_compression_level, schema_id, table_id)) {
 		info->options["compression_level"].emplace_back(parquet_compression_level);
 	}
-	string row_group_size;
-	if (catalog.TryGetConfigOption("parquet_row_group_size", row_group_size, schema_id, table_id)) {
-		info->options["row_group_size"].emplace_back(row_group_size);
+	// the target file size and row group size are either configured - or chosen from the workload of the table
+	auto file_sizing = catalog.GetFileSizeAdvisor().GetFileSizing(catalog, schema_id, table_id,
+	                                                              copy_input.columns.PhysicalColumnCount());
+	if (file_sizing.row_group_size.IsValid()) {
+		info->options["row_group_size"].emplace_back(to_string(file_sizing.row_group_size.GetIndex()));
 	}
 	string row_group_size_bytes;
 	if (catalog.TryGetConfigOption("parquet_row_group_size_bytes", row_group_size_bytes, schema_id, table_id)) {
@@ -542,8 +814,7 @@ DuckLakeCopyOptions DuckLakeInsert::GetCopyOptions(ClientContext &context, DuckL
 	if (catalog.TryGetConfigOption("per_thread_output", per_thread_output_str, schema_id, table_id)) {
 		per_thread_output = per_thread_output_str == "true";
 	}
-	idx_t target_file_size = catalog.GetConfigOption<idx_t>("target_file_size", schema_id, table_id,
-	                                                        DuckLakeCatalog::DEFAULT_TARGET_FILE_SIZE);
+	idx_t target_file_size = file_sizing.target_file_size;
 
 	// Always use native parquet geometry for writing
 	info->options["geoparquet_version"].emplace_back("NONE");
@@ -616,6 +887,7 @@ DuckLakeCopyOptions DuckLakeInsert::GetCopyOptions(ClientContext &context, DuckL
 		// we are partitioning - generate partition expressions (if any)
 		GeneratePartitionExpressions(context, copy_input, result);
 	}
+	result.sort_orders = GetSortOrders(context, copy_input);
 	return result;
 }
 
@@ -679,6 +951,18 @@ PhysicalOperator &DuckLakeInsert::PlanCopyForInsert(ClientContext &context, Phys
 	bool is_encrypted = !copy_input.encryption_key.empty();
 	auto copy_options = GetCopyOptions(context, copy_input);
 
+	if (!copy_options.sort_orders.empty() && plan) {
+		// sort the rows prior to writing them
+		vector<idx_t> projections;
+		for (idx_t i = 0; i < plan->types.size(); i++) {
+			projections.push_back(i);
+		}
+		auto &order = planner.Make<PhysicalOrder>(plan->types, std::move(copy_options.sort_orders),
+		                                          std::move(projections), plan->estimated_cardinality);
+		order.children.push_back(*plan);
+		plan = order;
+	}
+
 	if (!copy_options.projection_list.empty() && plan) {
 		// generate a projection
 		GenerateProjection(context, planner, copy_options.projection_list, plan);
@@ -773,9 +1057,19 @@ PhysicalOperator &DuckLakeCatalog::PlanInsert(ClientContext &context, PhysicalPl
 	auto &ducklake_table = op.table.Cast<DuckLakeTableEntry>();
 	auto &ducklake_schema = ducklake_table.ParentSchema().Cast<DuckLakeSchemaEntry>();
 	optional_ptr<DuckLakeInlineData> inline_data;
+	optional_ptr<DuckLakeBufferData> buffer_data;
 
+	auto buffer_limits = InsertBufferLimits(ducklake_schema.GetSchemaId(), ducklake_table.GetTableId());
 	idx_t data_inlining_row_limit = DataInliningRowLimit(ducklake_schema.GetSchemaId(), ducklake_table.GetTableId());
-	if (data_inlining_row_limit > 0) {
+	if (buffer_limits.row_limit > 0 && context.transaction.IsAutoCommit() && !ducklake_table.IsTransactionLocal()) {
+		// buffered inserts - add the rows to the insert buffer, and only write them once the buffer is full
+		if (buffer_limits.wait_for_commit && buffer_limits.flush_interval_us == 0) {
+			throw InvalidInputException("insert_buffer_ack_mode 'committed' requires an insert_buffer_flush_interval - "
+			                            "otherwise inserts could wait for their rows to be written indefinitely");
+		}
+		plan = planner.Make<DuckLakeBufferData>(*plan, ducklake_table, buffer_limits, false);
+		buffer_data = plan->Cast<DuckLakeBufferData>();
+	} else if (data_inlining_row_limit > 0) {
 		plan = planner.Make<DuckLakeInlineData>(*plan, data_inlining_row_limit);
 		inline_data = plan->Cast<DuckLakeInlineData>();
 	}
@@ -785,6 +1079,9 @@ PhysicalOperator &DuckLakeCatalog::PlanInsert(ClientContext &context, PhysicalPl
 	if (inline_data) {
 		inline_data->insert = insert.Cast<DuckLakeInsert>();
 	}
+	if (buffer_data) {
+		buffer_data->insert = insert.Cast<DuckLakeInsert>();
+	}
 	insert.children.push_back(physical_copy);
 	return insert;
 }
@@ -0,0 +1,145 @@
+#include "storage/ducklake_insert_buffer.hpp"
+
+namespace duckdb {
+
+void DuckLakeInsertBuffer::AddRows(TableBuffer &buffer, DuckLakeBufferedRows rows) {
+	buffer.batch_ids.insert(buffer.batch_ids.end(), rows.batch_ids.begin(), rows.batch_ids.end());
+	if (!buffer.rows) {
+		buffer.rows = std::move(rows.rows);
+		buffer.first_append = std::chrono::steady_clock::now();
+		return;
+	}
+	if (buffer.rows->Types() != rows.rows->Types()) {
+		throw InvalidInputException("The table was altered while it had buffered inserts - flush the buffered "
+		                            "inserts with ducklake_flush_insert_buffer before altering the table");
+	}
+	buffer.rows->Combine(*rows.rows);
+}
+
+DuckLakeBufferedRows DuckLakeInsertBuffer::Append(TableIndex table_id, const string &schema_name,
+                                                  const string &table_name, unique_ptr<ColumnDataCollection> rows,
+                                                  const DuckLakeInsertBufferLimits &limits, idx_t &batch_id) {
+	lock_guard<mutex> guard(lock);
+	auto &buffer = buffers[table_id];
+	DuckLakeBufferedRows new_rows;
+	new_rows.rows = std::move(rows);
+	batch_id = ++last_batch_id;
+	new_rows.batch_ids.push_back(batch_id);
+	AddRows(buffer, std::move(new_rows));
+	uncommitted_batches.insert(batch_id);
+	buffer.schema_name = schema_name;
+	buffer.table_name = table_name;
+	buffer.flush_interval_us = limits.flush_interval_us;
+
+	bool flush = buffer.rows->Count() >= limits.row_limit;
+	if (limits.size_limit > 0 && buffer.rows->SizeInBytes() >= limits.size_limit) {
+		flush = true;
+	}
+	if (limits.flush_interval_us > 0) {
+		auto buffered_time = std::chrono::steady_clock::now() - buffer.first_append;
+		auto buffered_us = std::chrono::duration_cast<std::chrono::microseconds>(buffered_time).count();
+		if (NumericCast<idx_t>(buffered_us) >= limits.flush_interval_us) {
+			flush = true;
+		}
+	}
+	DuckLakeBufferedRows result;
+	if (!flush) {
+		return result;
+	}
+	result.rows = std::move(buffer.rows);
+	result.batch_ids = std::move(buffer.batch_ids);
+	buffers.erase(table_id);
+	return result;
+}
+
+DuckLakeBufferedRows DuckLakeInsertBuffer::Take(TableIndex table_id) {
+	lock_guard<mutex> guard(lock);
+	DuckLakeBufferedRows result;
+	auto entry = buffers.find(table_id);
+	if (entry == buffers.end()) {
+		return result;
+	}
+	result.rows = std::move(entry->second.rows);
+	result.batch_ids = std::move(entry->second.batch_ids);
+	buffers.erase(entry);
+	return result;
+}
+
+void DuckLakeInsertBuffer::Restore(TableIndex table_id, DuckLakeBufferedRows rows) {
+	if (!rows.rows || rows.rows->Count() == 0) {
+		return;
+	}
+	lock_guard<mutex> guard(lock);
+	AddRows(buffers[table_id], std::move(rows));
+}
+
+void DuckLakeInsertBuffer::MarkCommitted(const vector<idx_t> &batch_ids) {
+	if (batch_ids.empty()) {
+		return;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		for (auto &batch_id : batch_ids) {
+			uncommitted_batches.erase(batch_id);
+		}
+	}
+	commit_cv.notify_all();
+}
+
+void DuckLakeInsertBuffer::WaitForCommit(idx_t batch_id) {
+	unique_lock<mutex> guard(lock);
+	commit_cv.wait(guard,
+	               [&]() { return shutdown || uncommitted_batches.find(batch_id) == uncommitted_batches.end(); });
+	if (uncommitted_batches.find(batch_id) != uncommitted_batches.end()) {
+		throw IOException("The buffered inserts were not written before the DuckLake was detached");
+	}
+}
+
+void DuckLakeInsertBuffer::Shutdown() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	commit_cv.notify_all();
+}
+
+bool DuckLakeInsertBuffer::HasBufferedRows(TableIndex table_id) {
+	lock_guard<mutex> guard(lock);
+	return buffers.find(table_id) != buffers.end();
+}
+
+bool DuckLakeInsertBuffer::HasBufferedRows() {
+	lock_guard<mutex> guard(lock);
+	return !buffers.empty();
+}
+
+vector<DuckLakeExpiredInsertBuffer> DuckLakeInsertBuffer::GetExpiredBuffers(optional_idx &next_check_us) {
+	vector<DuckLakeExpiredInsertBuffer> result;
+	auto now = std::chrono::steady_clock::now();
+	lock_guard<mutex> guard(lock);
+	for (auto &entry : buffers) {
+		auto &buffer = entry.second;
+		if (buffer.flush_interval_us == 0) {
+			continue;
+		}
+		auto buffered_time = now - buffer.first_append;
+		auto buffered_us = NumericCast<idx_t>(
+		    MaxValue<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(buffered_time).count(), 0));
+		// expired buffers are checked again after another interval - in case flushing them fails
+		idx_t check_us = buffer.flush_interval_us;
+		if (buffered_us >= buffer.flush_interval_us) {
+			DuckLakeExpiredInsertBuffer expired;
+			expired.schema_name = buffer.schema_name;
+			expired.table_name = buffer.table_name;
+			result.push_back(std::move(expired));
+		} else {
+			check_us = buffer.flush_interval_us - buffered_us;
+		}
+		if (!next_check_us.IsValid() || check_us < next_check_us.GetIndex()) {
+			next_check_us = check_us;
+		}
+	}
+	return result;
+}
+
+} // namespace duckdb
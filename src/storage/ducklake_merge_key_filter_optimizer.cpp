@@ -0,0 +1,253 @@
+#include "storage/ducklake_merge_key_filter_optimizer.hpp"
+
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_merge_into.hpp"
+#include "storage/ducklake_scan.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_zone_map.hpp"
+
+namespace duckdb {
+
+//! The range of one join key of the source - published as a pair of dynamic filters on the target scan
+struct DuckLakeMergeKeyRange {
+	Value min;
+	Value max;
+	shared_ptr<DynamicFilterData> min_filter;
+	shared_ptr<DynamicFilterData> max_filter;
+};
+
+struct DuckLakeMergeKeyFilterInfo {
+	mutex lock;
+	vector<DuckLakeMergeKeyRange> keys;
+
+	void Update(idx_t key_idx, const Value &chunk_min, const Value &chunk_max) {
+		lock_guard<mutex> guard(lock);
+		auto &key = keys[key_idx];
+		if (key.min.IsNull() || chunk_min < key.min) {
+			key.min = chunk_min;
+			SetFilter(*key.min_filter, ExpressionType::COMPARE_GREATERTHANOREQUALTO, key.min);
+		}
+		if (key.max.IsNull() || chunk_max > key.max) {
+			key.max = chunk_max;
+			SetFilter(*key.max_filter, ExpressionType::COMPARE_LESSTHANOREQUALTO, key.max);
+		}
+	}
+
+private:
+	static void SetFilter(DynamicFilterData &filter_data, ExpressionType comparison_type, const Value &value) {
+		lock_guard<mutex> guard(filter_data.lock);
+		filter_data.filter = make_uniq<ConstantFilter>(comparison_type, value);
+		filter_data.initialized = true;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Physical Operator
+//===--------------------------------------------------------------------===//
+//! Passes through the source rows of a MERGE INTO while collecting the range of their join keys
+//! This is placed on the build side of the join - which is fully consumed before the target scan on the probe side
+//! starts, so the target scan only observes the final range
+class DuckLakeMergeKeyFilter : public PhysicalOperator {
+public:
+	DuckLakeMergeKeyFilter(PhysicalPlan &physical_plan, const vector<LogicalType> &types,
+	                       vector<unique_ptr<Expression>> keys_p, shared_ptr<DuckLakeMergeKeyFilterInfo> info_p,
+	                       idx_t estimated_cardinality)
+	    : PhysicalOperator(physical_plan, PhysicalOperatorType::EXTENSION, types, estimated_cardinality),
+	      keys(std::move(keys_p)), info(std::move(info_p)) {
+	}
+
+	vector<unique_ptr<Expression>> keys;
+	shared_ptr<DuckLakeMergeKeyFilterInfo> info;
+
+public:
+	unique_ptr<OperatorState> GetOperatorState(ExecutionContext &context) const override;
+	OperatorResultType Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                           GlobalOperatorState &gstate, OperatorState &state) const override;
+
+	bool ParallelOperator() const override {
+		return true;
+	}
+	string GetName() const override {
+		return "DUCKLAKE_MERGE_KEY_FILTER";
+	}
+};
+
+class DuckLakeMergeKeyFilterState : public OperatorState {
+public:
+	DuckLakeMergeKeyFilterState(ClientContext &context, const vector<unique_ptr<Expression>> &keys)
+	    : executor(context, keys) {
+		vector<LogicalType> key_types;
+		for (auto &key : keys) {
+			key_types.push_back(key->return_type);
+		}
+		key_chunk.Initialize(context, key_types);
+	}
+
+	ExpressionExecutor executor;
+	DataChunk key_chunk;
+};
+
+unique_ptr<OperatorState> DuckLakeMergeKeyFilter::GetOperatorState(ExecutionContext &context) const {
+	return make_uniq<DuckLakeMergeKeyFilterState>(context.client, keys);
+}
+
+OperatorResultType DuckLakeMergeKeyFilter::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                                   GlobalOperatorState &gstate, OperatorState &state_p) const {
+	auto &state = state_p.Cast<DuckLakeMergeKeyFilterState>();
+	state.key_chunk.Reset();
+	state.executor.Execute(input, state.key_chunk);
+	for (idx_t key_idx = 0; key_idx < keys.size(); key_idx++) {
+		auto &key_vector = state.key_chunk.data[key_idx];
+		Value chunk_min;
+		Value chunk_max;
+		for (idx_t row_idx = 0; row_idx < input.size(); row_idx++) {
+			auto value = key_vector.GetValue(row_idx);
+			if (value.IsNull()) {
+				// NULL keys never match
+				continue;
+			}
+			if (chunk_min.IsNull() || value < chunk_min) {
+				chunk_min = value;
+			}
+			if (chunk_max.IsNull() || value > chunk_max) {
+				chunk_max = std::move(value);
+			}
+		}
+		if (!chunk_min.IsNull()) {
+			info->Update(key_idx, chunk_min, chunk_max);
+		}
+	}
+	chunk.Reference(input);
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+//===--------------------------------------------------------------------===//
+// Logical Operator
+//===--------------------------------------------------------------------===//
+class DuckLakeLogicalMergeKeyFilter : public LogicalExtensionOperator {
+public:
+	explicit DuckLakeLogicalMergeKeyFilter(shared_ptr<DuckLakeMergeKeyFilterInfo> info_p) : info(std::move(info_p)) {
+	}
+
+	shared_ptr<DuckLakeMergeKeyFilterInfo> info;
+
+public:
+	PhysicalOperator &CreatePlan(ClientContext &context, PhysicalPlanGenerator &planner) override {
+		auto &child = planner.CreatePlan(*children[0]);
+		auto &result =
+		    planner.Make<DuckLakeMergeKeyFilter>(types, std::move(expressions), info, child.estimated_cardinality);
+		result.children.push_back(child);
+		return result;
+	}
+
+	string GetExtensionName() const override {
+		return "ducklake";
+	}
+	vector<ColumnBinding> GetColumnBindings() override {
+		return children[0]->GetColumnBindings();
+	}
+
+	void ResolveTypes() override {
+		types = children[0]->types;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Optimizer
+//===--------------------------------------------------------------------===//
+DuckLakeMergeKeyFilterOptimizer::DuckLakeMergeKeyFilterOptimizer() {
+	optimize_function = DuckLakeMergeKeyFilterOptimizer::Optimize;
+}
+
+static bool IsMergeTargetScan(LogicalGet &get, LogicalMergeInto &merge) {
+	if (get.function.name != "ducklake_scan" || !get.function.function_info) {
+		return false;
+	}
+	auto &read_info = get.function.function_info->Cast<DuckLakeFunctionInfo>();
+	if (read_info.scan_type != DuckLakeScanType::SCAN_TABLE) {
+		return false;
+	}
+	auto &target = merge.table;
+	if (&read_info.table.ParentCatalog() != &target.ParentCatalog()) {
+		return false;
+	}
+	return read_info.table_id == target.Cast<DuckLakeTableEntry>().GetTableId();
+}
+
+static void AddMergeKeyFilters(LogicalMergeInto &merge) {
+	if (merge.actions.find(MergeActionCondition::WHEN_NOT_MATCHED_BY_SOURCE) != merge.actions.end()) {
+		// rows of the target without a match are needed
+		return;
+	}
+	if (merge.children.size() != 1) {
+		return;
+	}
+	reference<LogicalOperator> op = *merge.children[0];
+	while (op.get().type == LogicalOperatorType::LOGICAL_PROJECTION ||
+	       op.get().type == LogicalOperatorType::LOGICAL_FILTER) {
+		op = *op.get().children[0];
+	}
+	if (op.get().type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		return;
+	}
+	auto &join = op.get().Cast<LogicalComparisonJoin>();
+	// the target must be scanned on the probe (left) side, and its rows without a match must not be emitted
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::RIGHT) {
+		return;
+	}
+	auto info = make_shared_ptr<DuckLakeMergeKeyFilterInfo>();
+	vector<unique_ptr<Expression>> keys;
+	for (auto &condition : join.conditions) {
+		if (condition.comparison != ExpressionType::COMPARE_EQUAL ||
+		    condition.left->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			continue;
+		}
+		// the scan is only reached through projections and filters - so it is part of the probe pipeline
+		idx_t column_index;
+		auto &colref = condition.left->Cast<BoundColumnRefExpression>();
+		auto get = DuckLakeFunctions::FindScanColumn(*join.children[0], colref.binding, column_index);
+		if (!get || !IsMergeTargetScan(*get, merge)) {
+			continue;
+		}
+		auto &read_info = get->function.function_info->Cast<DuckLakeFunctionInfo>();
+		auto field_id = DuckLakeFunctions::GetScanColumn(*get, read_info.table, column_index);
+		if (!field_id || !DuckLakeColumnZoneMap::SupportsType(field_id->Type()) ||
+		    condition.right->return_type != field_id->Type()) {
+			continue;
+		}
+		DuckLakeMergeKeyRange key;
+		key.min_filter = make_shared_ptr<DynamicFilterData>();
+		key.max_filter = make_shared_ptr<DynamicFilterData>();
+		get->table_filters.PushFilter(ColumnIndex(column_index), make_uniq<DynamicFilter>(key.min_filter));
+		get->table_filters.PushFilter(ColumnIndex(column_index), make_uniq<DynamicFilter>(key.max_filter));
+		info->keys.push_back(std::move(key));
+		keys.push_back(condition.right->Copy());
+	}
+	if (keys.empty()) {
+		return;
+	}
+	auto key_filter = make_uniq<DuckLakeLogicalMergeKeyFilter>(std::move(info));
+	key_filter->expressions = std::move(keys);
+	key_filter->children.push_back(std::move(join.children[1]));
+	key_filter->ResolveOperatorTypes();
+	join.children[1] = std::move(key_filter);
+}
+
+void DuckLakeMergeKeyFilterOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	for (auto &child : plan->children) {
+		Optimize(input, child);
+	}
+	if (plan->type == LogicalOperatorType::LOGICAL_MERGE_INTO) {
+		AddMergeKeyFilters(plan->Cast<LogicalMergeInto>());
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,491 @@
+#include "storage/ducklake_metadata_cache.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/serializer/binary_deserializer.hpp"
+#include "duckdb/common/serializer/binary_serializer.hpp"
+#include "duckdb/common/serializer/memory_stream.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Apply Changes
+//===--------------------------------------------------------------------===//
+template <class T>
+static void RemoveEntries(vector<T> &entries, const set<TableIndex> &removed_ids,
+                          const std::function<TableIndex(const T &)> &get_id) {
+	vector<T> result;
+	for (auto &entry : entries) {
+		if (removed_ids.find(get_id(entry)) != removed_ids.end()) {
+			continue;
+		}
+		result.push_back(std::move(entry));
+	}
+	entries = std::move(result);
+}
+
+void DuckLakeMetadataCache::ApplyCatalogChanges(const DuckLakeCatalogInfo &changes,
+                                                const set<TableIndex> &changed_entries, DuckLakeSnapshot new_snapshot,
+                                                timestamp_tz_t new_snapshot_time) {
+	// the schemas are always fully loaded
+	catalog.schemas = changes.schemas;
+	// remove all entries that were changed or reloaded
+	set<TableIndex> reloaded_entries = changed_entries;
+	for (auto &table : changes.tables) {
+		reloaded_entries.insert(table.id);
+	}
+	for (auto &view : changes.views) {
+		reloaded_entries.insert(view.id);
+	}
+	RemoveEntries<DuckLakeTableInfo>(catalog.tables, reloaded_entries,
+	                                 [](const DuckLakeTableInfo &table) { return table.id; });
+	RemoveEntries<DuckLakeTableInfo>(catalog.lazy_tables, reloaded_entries,
+	                                 [](const DuckLakeTableInfo &table) { return table.id; });
+	RemoveEntries<DuckLakeViewInfo>(catalog.views, reloaded_entries,
+	                                [](const DuckLakeViewInfo &view) { return view.id; });
+	RemoveEntries<DuckLakePartitionInfo>(catalog.partitions, reloaded_entries,
+	                                     [](const DuckLakePartitionInfo &partition) { return partition.table_id; });
+	// add the reloaded entries
+	catalog.tables.insert(catalog.tables.end(), changes.tables.begin(), changes.tables.end());
+	catalog.views.insert(catalog.views.end(), changes.views.begin(), changes.views.end());
+	catalog.partitions.insert(catalog.partitions.end(), changes.partitions.begin(), changes.partitions.end());
+	snapshot = new_snapshot;
+	snapshot_time = new_snapshot_time;
+}
+
+void DuckLakeMetadataCache::ApplyStatsChanges(const vector<DuckLakeGlobalStatsInfo> &changes,
+                                              const set<TableIndex> &changed_tables, DuckLakeSnapshot new_snapshot,
+                                              timestamp_tz_t new_snapshot_time) {
+	RemoveEntries<DuckLakeGlobalStatsInfo>(stats, changed_tables,
+	                                       [](const DuckLakeGlobalStatsInfo &stats) { return stats.table_id; });
+	stats.insert(stats.end(), changes.begin(), changes.end());
+	stats_snapshot = new_snapshot;
+	stats_snapshot_time = new_snapshot_time;
+}
+
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+static idx_t OptionalToIndex(optional_idx value) {
+	return value.IsValid() ? value.GetIndex() : DConstants::INVALID_INDEX;
+}
+
+static optional_idx IndexToOptional(idx_t value) {
+	return value == DConstants::INVALID_INDEX ? optional_idx() : optional_idx(value);
+}
+
+static void WriteSnapshot(Serializer &serializer, field_id_t field_id, const char *tag,
+                          const DuckLakeSnapshot &snapshot, timestamp_tz_t snapshot_time) {
+	serializer.WriteObject(field_id, tag, [&](Serializer &object) {
+		object.WriteProperty(100, "snapshot_id", snapshot.snapshot_id);
+		object.WriteProperty(101, "schema_version", snapshot.schema_version);
+		object.WriteProperty(102, "next_catalog_id", snapshot.next_catalog_id);
+		object.WriteProperty(103, "next_file_id", snapshot.next_file_id);
+		object.WriteProperty<int64_t>(104, "snapshot_time", snapshot_time.value);
+	});
+}
+
+static DuckLakeSnapshot ReadSnapshot(Deserializer &deserializer, field_id_t field_id, const char *tag,
+                                     timestamp_tz_t &snapshot_time) {
+	DuckLakeSnapshot snapshot;
+	deserializer.ReadObject(field_id, tag, [&](Deserializer &object) {
+		snapshot.snapshot_id = object.ReadProperty<idx_t>(100, "snapshot_id");
+		snapshot.schema_version = object.ReadProperty<idx_t>(101, "schema_version");
+		snapshot.next_catalog_id = object.ReadProperty<idx_t>(102, "next_catalog_id");
+		snapshot.next_file_id = object.ReadProperty<idx_t>(103, "next_file_id");
+		snapshot_time = timestamp_tz_t(object.ReadProperty<int64_t>(104, "snapshot_time"));
+	});
+	return snapshot;
+}
+
+static void WriteTags(Serializer &serializer, field_id_t field_id, const char *tag, const vector<DuckLakeTag> &tags) {
+	serializer.WriteList(field_id, tag, tags.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			object.WriteProperty(100, "key", tags[i].key);
+			object.WriteProperty(101, "value", tags[i].value);
+		});
+	});
+}
+
+static vector<DuckLakeTag> ReadTags(Deserializer &deserializer, field_id_t field_id, const char *tag) {
+	vector<DuckLakeTag> tags;
+	deserializer.ReadList(field_id, tag, [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeTag entry;
+			entry.key = object.ReadProperty<string>(100, "key");
+			entry.value = object.ReadProperty<string>(101, "value");
+			tags.push_back(std::move(entry));
+		});
+	});
+	return tags;
+}
+
+static void WriteColumns(Serializer &serializer, field_id_t field_id, const char *tag,
+                         const vector<DuckLakeColumnInfo> &columns) {
+	serializer.WriteList(field_id, tag, columns.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &column = columns[i];
+			object.WriteProperty(100, "id", column.id.index);
+			object.WriteProperty(101, "name", column.name);
+			object.WriteProperty(102, "type", column.type);
+			object.WriteProperty(103, "initial_default", column.initial_default);
+			object.WriteProperty(104, "default_value", column.default_value);
+			object.WriteProperty(105, "nulls_allowed", column.nulls_allowed);
+			WriteColumns(object, 106, "children", column.children);
+			WriteTags(object, 107, "tags", column.tags);
+		});
+	});
+}
+
+static vector<DuckLakeColumnInfo> ReadColumns(Deserializer &deserializer, field_id_t field_id, const char *tag) {
+	vector<DuckLakeColumnInfo> columns;
+	deserializer.ReadList(field_id, tag, [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeColumnInfo column;
+			column.id = FieldIndex(object.ReadProperty<idx_t>(100, "id"));
+			column.name = object.ReadProperty<string>(101, "name");
+			column.type = object.ReadProperty<string>(102, "type");
+			column.initial_default = object.ReadProperty<Value>(103, "initial_default");
+			column.default_value = object.ReadProperty<Value>(104, "default_value");
+			column.nulls_allowed = object.ReadProperty<bool>(105, "nulls_allowed");
+			column.children = ReadColumns(object, 106, "children");
+			column.tags = ReadTags(object, 107, "tags");
+			columns.push_back(std::move(column));
+		});
+	});
+	return columns;
+}
+
+static void WriteTables(Serializer &serializer, field_id_t field_id, const char *tag,
+                        const vector<DuckLakeTableInfo> &tables) {
+	serializer.WriteList(field_id, tag, tables.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &table = tables[i];
+			object.WriteProperty(100, "id", table.id.index);
+			object.WriteProperty(101, "schema_id", table.schema_id.index);
+			object.WriteProperty(102, "uuid", table.uuid);
+			object.WriteProperty(103, "name", table.name);
+			object.WriteProperty(104, "path", table.path);
+			WriteColumns(object, 105, "columns", table.columns);
+			WriteTags(object, 106, "tags", table.tags);
+			object.WriteList(107, "inlined_data_tables", table.inlined_data_tables.size(),
+			                 [&](Serializer::List &inlined_list, idx_t inlined_idx) {
+				                 inlined_list.WriteObject([&](Serializer &inlined_object) {
+					                 auto &inlined_table = table.inlined_data_tables[inlined_idx];
+					                 inlined_object.WriteProperty(100, "table_name", inlined_table.table_name);
+					                 inlined_object.WriteProperty(101, "schema_version", inlined_table.schema_version);
+				                 });
+			                 });
+		});
+	});
+}
+
+static void WriteCatalog(Serializer &serializer, const DuckLakeCatalogInfo &catalog) {
+	serializer.WriteList(200, "schemas", catalog.schemas.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &schema = catalog.schemas[i];
+			object.WriteProperty(100, "id", schema.id.index);
+			object.WriteProperty(101, "uuid", schema.uuid);
+			object.WriteProperty(102, "name", schema.name);
+			object.WriteProperty(103, "path", schema.path);
+			WriteTags(object, 104, "tags", schema.tags);
+		});
+	});
+	WriteTables(serializer, 201, "tables", catalog.tables);
+	serializer.WriteList(202, "views", catalog.views.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &view = catalog.views[i];
+			object.WriteProperty(100, "id", view.id.index);
+			object.WriteProperty(101, "schema_id", view.schema_id.index);
+			object.WriteProperty(102, "uuid", view.uuid);
+			object.WriteProperty(103, "name", view.name);
+			object.WriteProperty(104, "dialect", view.dialect);
+			object.WriteProperty(105, "column_aliases", view.column_aliases);
+			object.WriteProperty(106, "sql", view.sql);
+			WriteTags(object, 107, "tags", view.tags);
+		});
+	});
+	serializer.WriteList(203, "partitions", catalog.partitions.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &partition = catalog.partitions[i];
+			object.WriteProperty(100, "id", OptionalToIndex(partition.id));
+			object.WriteProperty(101, "table_id", partition.table_id.index);
+			auto &fields = partition.fields;
+			object.WriteList(102, "fields", fields.size(), [&](Serializer::List &field_list, idx_t field_idx) {
+				field_list.WriteObject([&](Serializer &field_object) {
+					auto &field = fields[field_idx];
+					field_object.WriteProperty(100, "partition_key_index", field.partition_key_index);
+					field_object.WriteProperty(101, "field_id", field.field_id.index);
+					field_object.WriteProperty(102, "transform", field.transform);
+				});
+			});
+		});
+	});
+	WriteTables(serializer, 204, "lazy_tables", catalog.lazy_tables);
+}
+
+static vector<DuckLakeTableInfo> ReadTables(Deserializer &deserializer, field_id_t field_id, const char *tag) {
+	vector<DuckLakeTableInfo> tables;
+	deserializer.ReadList(field_id, tag, [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeTableInfo table;
+			table.id = TableIndex(object.ReadProperty<idx_t>(100, "id"));
+			table.schema_id = SchemaIndex(object.ReadProperty<idx_t>(101, "schema_id"));
+			table.uuid = object.ReadProperty<string>(102, "uuid");
+			table.name = object.ReadProperty<string>(103, "name");
+			table.path = object.ReadProperty<string>(104, "path");
+			table.columns = ReadColumns(object, 105, "columns");
+			table.tags = ReadTags(object, 106, "tags");
+			object.ReadList(107, "inlined_data_tables", [&](Deserializer::List &inlined_list, idx_t inlined_idx) {
+				inlined_list.ReadObject([&](Deserializer &inlined_object) {
+					DuckLakeInlinedTableInfo inlined_table;
+					inlined_table.table_name = inlined_object.ReadProperty<string>(100, "table_name");
+					inlined_table.schema_version = inlined_object.ReadProperty<idx_t>(101, "schema_version");
+					table.inlined_data_tables.push_back(std::move(inlined_table));
+				});
+			});
+			tables.push_back(std::move(table));
+		});
+	});
+	return tables;
+}
+
+static DuckLakeCatalogInfo ReadCatalog(Deserializer &deserializer) {
+	DuckLakeCatalogInfo catalog;
+	deserializer.ReadList(200, "schemas", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeSchemaInfo schema;
+			schema.id = SchemaIndex(object.ReadProperty<idx_t>(100, "id"));
+			schema.uuid = object.ReadProperty<string>(101, "uuid");
+			schema.name = object.ReadProperty<string>(102, "name");
+			schema.path = object.ReadProperty<string>(103, "path");
+			schema.tags = ReadTags(object, 104, "tags");
+			catalog.schemas.push_back(std::move(schema));
+		});
+	});
+	catalog.tables = ReadTables(deserializer, 201, "tables");
+	deserializer.ReadList(202, "views", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeViewInfo view;
+			view.id = TableIndex(object.ReadProperty<idx_t>(100, "id"));
+			view.schema_id = SchemaIndex(object.ReadProperty<idx_t>(101, "schema_id"));
+			view.uuid = object.ReadProperty<string>(102, "uuid");
+			view.name = object.ReadProperty<string>(103, "name");
+			view.dialect = object.ReadProperty<string>(104, "dialect");
+			view.column_aliases = object.ReadProperty<vector<string>>(105, "column_aliases");
+			view.sql = object.ReadProperty<string>(106, "sql");
+			view.tags = ReadTags(object, 107, "tags");
+			catalog.views.push_back(std::move(view));
+		});
+	});
+	deserializer.ReadList(203, "partitions", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakePartitionInfo partition;
+			partition.id = IndexToOptional(object.ReadProperty<idx_t>(100, "id"));
+			partition.table_id = TableIndex(object.ReadProperty<idx_t>(101, "table_id"));
+			object.ReadList(102, "fields", [&](Deserializer::List &field_list, idx_t field_idx) {
+				field_list.ReadObject([&](Deserializer &field_object) {
+					DuckLakePartitionFieldInfo field;
+					field.partition_key_index = field_object.ReadProperty<idx_t>(100, "partition_key_index");
+					field.field_id = FieldIndex(field_object.ReadProperty<idx_t>(101, "field_id"));
+					field.transform = field_object.ReadProperty<string>(102, "transform");
+					partition.fields.push_back(std::move(field));
+				});
+			});
+			catalog.partitions.push_back(std::move(partition));
+		});
+	});
+	catalog.lazy_tables = ReadTables(deserializer, 204, "lazy_tables");
+	return catalog;
+}
+
+static void WriteStats(Serializer &serializer, const vector<DuckLakeGlobalStatsInfo> &stats) {
+	serializer.WriteList(301, "stats", stats.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &table_stats = stats[i];
+			object.WriteProperty(100, "table_id", table_stats.table_id.index);
+			object.WriteProperty(101, "record_count", table_stats.record_count);
+			object.WriteProperty(102, "next_row_id", table_stats.next_row_id);
+			object.WriteProperty(103, "table_size_bytes", table_stats.table_size_bytes);
+			auto &column_stats = table_stats.column_stats;
+			object.WriteList(104, "column_stats", column_stats.size(), [&](Serializer::List &col_list, idx_t col_idx) {
+				col_list.WriteObject([&](Serializer &col_object) {
+					auto &col_stats = column_stats[col_idx];
+					col_object.WriteProperty(100, "column_id", col_stats.column_id.index);
+					col_object.WriteProperty(101, "has_contains_null", col_stats.has_contains_null);
+					col_object.WriteProperty(102, "contains_null", col_stats.contains_null);
+					col_object.WriteProperty(103, "has_contains_nan", col_stats.has_contains_nan);
+					col_object.WriteProperty(104, "contains_nan", col_stats.contains_nan);
+					col_object.WriteProperty(105, "has_min", col_stats.has_min);
+					col_object.WriteProperty(106, "min_val", col_stats.min_val);
+					col_object.WriteProperty(107, "has_max", col_stats.has_max);
+					col_object.WriteProperty(108, "max_val", col_stats.max_val);
+					col_object.WriteProperty(109, "has_extra_stats", col_stats.has_extra_stats);
+					col_object.WriteProperty(110, "extra_stats", col_stats.extra_stats);
+				});
+			});
+		});
+	});
+}
+
+static vector<DuckLakeGlobalStatsInfo> ReadStats(Deserializer &deserializer) {
+	vector<DuckLakeGlobalStatsInfo> stats;
+	deserializer.ReadList(301, "stats", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeGlobalStatsInfo table_stats;
+			table_stats.table_id = TableIndex(object.ReadProperty<idx_t>(100, "table_id"));
+			table_stats.initialized = true;
+			table_stats.record_count = object.ReadProperty<idx_t>(101, "record_count");
+			table_stats.next_row_id = object.ReadProperty<idx_t>(102, "next_row_id");
+			table_stats.table_size_bytes = object.ReadProperty<idx_t>(103, "table_size_bytes");
+			object.ReadList(104, "column_stats", [&](Deserializer::List &col_list, idx_t col_idx) {
+				col_list.ReadObject([&](Deserializer &col_object) {
+					DuckLakeGlobalColumnStatsInfo col_stats;
+					col_stats.column_id = FieldIndex(col_object.ReadProperty<idx_t>(100, "column_id"));
+					col_stats.has_contains_null = col_object.ReadProperty<bool>(101, "has_contains_null");
+					col_stats.contains_null = col_object.ReadProperty<bool>(102, "contains_null");
+					col_stats.has_contains_nan = col_object.ReadProperty<bool>(103, "has_contains_nan");
+					col_stats.contains_nan = col_object.ReadProperty<bool>(104, "contains_nan");
+					col_stats.has_min = col_object.ReadProperty<bool>(105, "has_min");
+					col_stats.min_val = col_object.ReadProperty<string>(106, "min_val");
+					col_stats.has_max = col_object.ReadProperty<bool>(107, "has_max");
+					col_stats.max_val = col_object.ReadProperty<string>(108, "max_val");
+					col_stats.has_extra_stats = col_object.ReadProperty<bool>(109, "has_extra_stats");
+					col_stats.extra_stats = col_object.ReadProperty<string>(110, "extra_stats");
+					table_stats.column_stats.push_back(std::move(col_stats));
+				});
+			});
+			stats.push_back(std::move(table_stats));
+		});
+	});
+	return stats;
+}
+
+static void WriteFileData(Serializer &serializer, field_id_t field_id, const char *tag, const DuckLakeFileData &file) {
+	serializer.WriteObject(field_id, tag, [&](Serializer &object) {
+		object.WriteProperty(100, "path", file.path);
+		object.WriteProperty(102, "file_size_bytes", file.file_size_bytes);
+		object.WriteProperty(103, "footer_size", OptionalToIndex(file.footer_size));
+	});
+}
+
+static DuckLakeFileData ReadFileData(Deserializer &deserializer, field_id_t field_id, const char *tag) {
+	DuckLakeFileData file;
+	deserializer.ReadObject(field_id, tag, [&](Deserializer &object) {
+		file.path = object.ReadProperty<string>(100, "path");
+		file.file_size_bytes = object.ReadProperty<idx_t>(102, "file_size_bytes");
+		file.footer_size = IndexToOptional(object.ReadProperty<idx_t>(103, "footer_size"));
+	});
+	return file;
+}
+
+static void WriteFileLists(Serializer &serializer, const vector<DuckLakeMetadataCacheFileList> &file_lists) {
+	serializer.WriteList(400, "file_lists", file_lists.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &file_list = file_lists[i];
+			object.WriteProperty(100, "table_id", file_list.table_id.index);
+			object.WriteProperty(101, "snapshot_id", file_list.snapshot_id);
+			auto &files = file_list.files;
+			object.WriteList(102, "files", files.size(), [&](Serializer::List &file_list, idx_t file_idx) {
+				file_list.WriteObject([&](Serializer &file_object) {
+					auto &file = files[file_idx];
+					WriteFileData(file_object, 100, "file", file.file);
+					WriteFileData(file_object, 101, "delete_file", file.delete_file);
+					file_object.WriteProperty(102, "row_id_start", OptionalToIndex(file.row_id_start));
+					file_object.WriteProperty(103, "snapshot_id", OptionalToIndex(file.snapshot_id));
+					file_object.WriteProperty(104, "mapping_id", file.mapping_id.index);
+					file_object.WriteProperty(105, "file_id", file.file_id.index);
+					file_object.WriteProperty(106, "row_count", OptionalToIndex(file.row_count));
+					file_object.WriteProperty(107, "delete_count", file.delete_count);
+				});
+			});
+		});
+	});
+}
+
+static vector<DuckLakeMetadataCacheFileList> ReadFileLists(Deserializer &deserializer) {
+	vector<DuckLakeMetadataCacheFileList> file_lists;
+	deserializer.ReadList(400, "file_lists", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeMetadataCacheFileList file_list;
+			file_list.table_id = TableIndex(object.ReadProperty<idx_t>(100, "table_id"));
+			file_list.snapshot_id = object.ReadProperty<idx_t>(101, "snapshot_id");
+			object.ReadList(102, "files", [&](Deserializer::List &files, idx_t file_idx) {
+				files.ReadObject([&](Deserializer &file_object) {
+					DuckLakeFileListEntry file;
+					file.file = ReadFileData(file_object, 100, "file");
+					file.delete_file = ReadFileData(file_object, 101, "delete_file");
+					file.row_id_start = IndexToOptional(file_object.ReadProperty<idx_t>(102, "row_id_start"));
+					file.snapshot_id = IndexToOptional(file_object.ReadProperty<idx_t>(103, "snapshot_id"));
+					file.mapping_id = MappingIndex(file_object.ReadProperty<idx_t>(104, "mapping_id"));
+					file.file_id = DataFileIndex(file_object.ReadProperty<idx_t>(105, "file_id"));
+					file.row_count = IndexToOptional(file_object.ReadProperty<idx_t>(106, "row_count"));
+					file.delete_count = file_object.ReadProperty<idx_t>(107, "delete_count");
+					file_list.files.push_back(std::move(file));
+				});
+			});
+			file_lists.push_back(std::move(file_list));
+		});
+	});
+	return file_lists;
+}
+
+void DuckLakeMetadataCache::Write(FileSystem &fs, const string &path) const {
+	MemoryStream stream;
+	BinarySerializer serializer(stream);
+	idx_t version = CACHE_VERSION;
+	serializer.Begin();
+	serializer.WriteProperty(100, "version", version);
+	serializer.WriteProperty(101, "metadata_path", metadata_path);
+	serializer.WriteProperty(102, "data_path", data_path);
+	WriteSnapshot(serializer, 103, "snapshot", snapshot, snapshot_time);
+	WriteCatalog(serializer, catalog);
+	WriteSnapshot(serializer, 300, "stats_snapshot", stats_snapshot, stats_snapshot_time);
+	WriteStats(serializer, stats);
+	WriteFileLists(serializer, file_lists);
+	serializer.End();
+
+	// write to a temporary file first and move it in place - so a concurrent reader never sees a partial cache
+	auto temp_path = path + ".tmp";
+	{
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(stream.GetData(), stream.GetPosition());
+		handle->Sync();
+	}
+	fs.MoveFile(temp_path, path);
+}
+
+unique_ptr<DuckLakeMetadataCache> DuckLakeMetadataCache::TryRead(FileSystem &fs, const string &path) {
+	if (!fs.FileExists(path)) {
+		return nullptr;
+	}
+	try {
+		auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+		auto file_size = NumericCast<idx_t>(handle->GetFileSize());
+		auto buffer = make_unsafe_uniq_array<data_t>(file_size);
+		handle->Read(buffer.get(), file_size);
+
+		MemoryStream stream(buffer.get(), file_size);
+		BinaryDeserializer deserializer(stream);
+		deserializer.Begin();
+		auto version = deserializer.ReadProperty<idx_t>(100, "version");
+		if (version != CACHE_VERSION) {
+			// cache was written by a different version
+			return nullptr;
+		}
+		auto result = make_uniq<DuckLakeMetadataCache>();
+		result->metadata_path = deserializer.ReadProperty<string>(101, "metadata_path");
+		result->data_path = deserializer.ReadProperty<string>(102, "data_path");
+		result->snapshot = ReadSnapshot(deserializer, 103, "snapshot", result->snapshot_time);
+		result->catalog = ReadCatalog(deserializer);
+		result->stats_snapshot = ReadSnapshot(deserializer, 300, "stats_snapshot", result->stats_snapshot_time);
+		result->stats = ReadStats(deserializer);
+		result->file_lists = ReadFileLists(deserializer);
+		deserializer.End();
+		return result;
+	} catch (std::exception &ex) {
+		// the cache is corrupt or unreadable - ignore it
+		return nullptr;
+	}
+}
+
+} // namespace duckdb
@@ -4,11 +4,14 @@
 #include "duckdb/planner/tableref/bound_at_clause.hpp"
 #include "duckdb/common/types/blob.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_metadata_stats.hpp"
 #include "common/ducklake_types.hpp"
 #include "storage/ducklake_schema_entry.hpp"
 #include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_zone_map.hpp"
 #include "duckdb.hpp"
 #include "metadata_manager/postgres_metadata_manager.hpp"
+#include "duckdb/main/appender.hpp"
 #include "duckdb/main/attached_database.hpp"
 
 namespace duckdb {
@@ -38,6 +41,7 @@ FileSystem &DuckLakeMetadataManager::GetFileSystem() {
 }
 
 void DuckLakeMetadataManager::InitializeDuckLake(bool has_explicit_schema, DuckLakeEncryption encryption) {
+	DuckLakeMetadataOperation metadata_operation("InitializeDuckLake");
 	string initialize_query;
 	if (has_explicit_schema) {
 		// if the schema is user provided create it
@@ -71,9 +75,11 @@ CREATE TABLE {METADATA_CATALOG}.ducklake_inlined_data_tables(table_id BIGINT, ta
 CREATE TABLE {METADATA_CATALOG}.ducklake_column_mapping(mapping_id BIGINT, table_id BIGINT, type VARCHAR);
 CREATE TABLE {METADATA_CATALOG}.ducklake_name_mapping(mapping_id BIGINT, column_id BIGINT, source_name VARCHAR, target_field_id BIGINT, parent_column BIGINT, is_partition BOOLEAN);
 CREATE TABLE {METADATA_CATALOG}.ducklake_schema_versions(begin_snapshot BIGINT, schema_version BIGINT);
+CREATE TABLE {METADATA_CATALOG}.ducklake_snapshot_change_index(snapshot_id BIGINT, change_type VARCHAR, object_id BIGINT, change_value VARCHAR);
 INSERT INTO {METADATA_CATALOG}.ducklake_schema_versions VALUES (0,0);
 INSERT INTO {METADATA_CATALOG}.ducklake_snapshot VALUES (0, NOW(), 0, 1, 0);
 INSERT INTO {METADATA_CATALOG}.ducklake_snapshot_changes VALUES (0, 'created_schema:"main"',  NULL, NULL, NULL);
+INSERT INTO {METADATA_CATALOG}.ducklake_snapshot_change_index VALUES (0, 'created_schema', NULL, '"main"');
 INSERT INTO {METADATA_CATALOG}.ducklake_metadata (key, value) VALUES ('version', '0.3'), ('created_by', 'DuckDB %s'), ('data_path', %s), ('encrypted', '%s');
 INSERT INTO {METADATA_CATALOG}.ducklake_schema VALUES (0, UUID(), 0, NULL, 'main', 'main/', true);
 	)",
@@ -88,7 +94,31 @@ INSERT INTO {METADATA_CATALOG}.ducklake_schema VALUES (0, UUID(), 0, NULL, 'main
 	}
 }
 
+void DuckLakeMetadataManager::CreateMetadataIndexes() {
+}
+
+bool DuckLakeMetadataManager::HasSnapshotChangeIndex() {
+	DuckLakeMetadataOperation metadata_operation("HasSnapshotChangeIndex");
+	// the index was added to existing DuckLakes by the migration to v0.3 - DuckLakes created as v0.3 before it was
+	// introduced do not have it
+	auto result = transaction.Query(
+	    "SELECT COUNT(*) FROM duckdb_tables() WHERE database_name={METADATA_CATALOG_NAME_LITERAL} AND "
+	    "schema_name={METADATA_SCHEMA_NAME_LITERAL} AND table_name='ducklake_snapshot_change_index'");
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to load DuckLake table data: ");
+	}
+	for (auto &row : *result) {
+		return row.GetValue<idx_t>(0) > 0;
+	}
+	return false;
+}
+
+string DuckLakeMetadataManager::GetWriteBatchQuery(const vector<string> &statements) {
+	return StringUtil::Join(statements, "\n");
+}
+
 void DuckLakeMetadataManager::MigrateV01() {
+	DuckLakeMetadataOperation metadata_operation("MigrateV01");
 	string migrate_query = R"(
 ALTER TABLE {METADATA_CATALOG}.ducklake_schema ADD COLUMN path VARCHAR DEFAULT '';
 ALTER TABLE {METADATA_CATALOG}.ducklake_schema ADD COLUMN path_is_relative BOOLEAN DEFAULT TRUE;
@@ -109,6 +139,7 @@ UPDATE {METADATA_CATALOG}.ducklake_metadata SET value = '0.2' WHERE key = 'versi
 }
 
 void DuckLakeMetadataManager::MigrateV02(bool allow_failures) {
+	DuckLakeMetadataOperation metadata_operation("MigrateV02");
 	string migrate_query = R"(
 ALTER TABLE {METADATA_CATALOG}.ducklake_name_mapping ADD COLUMN {IF_NOT_EXISTS} is_partition BOOLEAN DEFAULT false;
 ALTER TABLE {METADATA_CATALOG}.ducklake_snapshot_changes ADD COLUMN {IF_NOT_EXISTS} author VARCHAR DEFAULT NULL;
@@ -116,6 +147,7 @@ ALTER TABLE {METADATA_CATALOG}.ducklake_snapshot_changes ADD COLUMN {IF_NOT_EXIS
 ALTER TABLE {METADATA_CATALOG}.ducklake_snapshot_changes ADD COLUMN {IF_NOT_EXISTS} commit_extra_info VARCHAR DEFAULT NULL;
 UPDATE {METADATA_CATALOG}.ducklake_metadata SET value = '0.3' WHERE key = 'version';
 CREATE TABLE {IF_NOT_EXISTS} {METADATA_CATALOG}.ducklake_schema_versions(begin_snapshot BIGINT, schema_version BIGINT);
+CREATE TABLE {IF_NOT_EXISTS} {METADATA_CATALOG}.ducklake_snapshot_change_index(snapshot_id BIGINT, change_type VARCHAR, object_id BIGINT, change_value VARCHAR);
 INSERT INTO {METADATA_CATALOG}.ducklake_schema_versions SELECT * FROM (SELECT MIN(snapshot_id), schema_version FROM {METADATA_CATALOG}.ducklake_snapshot GROUP BY schema_version ORDER BY schema_version) t {WHERE_EMPTY};
 ALTER TABLE {IF_EXISTS} {METADATA_CATALOG}.ducklake_file_column_statistics RENAME TO ducklake_file_column_stats;
 ALTER TABLE {METADATA_CATALOG}.ducklake_file_column_stats ADD COLUMN {IF_NOT_EXISTS} extra_stats VARCHAR DEFAULT NULL;
@@ -140,6 +172,7 @@ ALTER TABLE {METADATA_CATALOG}.ducklake_table_column_stats ADD COLUMN {IF_NOT_EX
 }
 
 DuckLakeMetadata DuckLakeMetadataManager::LoadDuckLake() {
+	DuckLakeMetadataOperation metadata_operation("LoadDuckLake");
 	auto result = transaction.Query(R"(
 SELECT key, value, scope, scope_id FROM {METADATA_CATALOG}.ducklake_metadata
 )");
@@ -227,6 +260,7 @@ static vector<DuckLakeInlinedTableInfo> LoadInlinedDataTables(const Value &list)
 }
 
 idx_t DuckLakeMetadataManager::GetCatalogIdForSchema(idx_t schema_id) {
+	DuckLakeMetadataOperation metadata_operation("GetCatalogIdForSchema");
 	string query = R"(
 SELECT begin_snapshot
 FROM {METADATA_CATALOG}.ducklake_inlined_data_tables
@@ -240,12 +274,98 @@ WHERE schema_version = {SCHEMA_ID})";
 	throw InternalException("Schema Version %llu does not exist", schema_id);
 }
 
+static string TableIdList(const set<TableIndex> &table_ids) {
+	string id_list;
+	for (auto &table_id : table_ids) {
+		if (!id_list.empty()) {
+			id_list += ", ";
+		}
+		id_list += to_string(table_id.index);
+	}
+	return id_list;
+}
+
 DuckLakeCatalogInfo DuckLakeMetadataManager::GetCatalogForSnapshot(DuckLakeSnapshot snapshot) {
+	return LoadCatalogInfo(snapshot, string(), string(), string());
+}
+
+DuckLakeCatalogInfo DuckLakeMetadataManager::GetCatalogChanges(DuckLakeSnapshot start_snapshot,
+                                                               DuckLakeSnapshot snapshot,
+                                                               const set<TableIndex> &changed_entries) {
+	// load all entries that were either explicitly changed, or that were (re-)created after the start snapshot
+	auto id_list = TableIdList(changed_entries);
+	auto get_filter = [&](const string &id_column, const string &begin_column) {
+		string filter = StringUtil::Format("AND (%s > %d", begin_column, start_snapshot.snapshot_id);
+		if (!id_list.empty()) {
+			filter += StringUtil::Format(" OR %s IN (%s)", id_column, id_list);
+		}
+		return filter + ")";
+	};
+	return LoadCatalogInfo(snapshot, get_filter("tbl.table_id", "tbl.begin_snapshot"),
+	                       get_filter("view.view_id", "view.begin_snapshot"),
+	                       get_filter("part.table_id", "part.begin_snapshot"));
+}
+
+DuckLakeCatalogInfo DuckLakeMetadataManager::GetCatalogListingForSnapshot(DuckLakeSnapshot snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetCatalogListingForSnapshot");
+	DuckLakeCatalogInfo catalog;
+	LoadSchemaInfo(snapshot, catalog);
+	map<SchemaIndex, idx_t> schema_map;
+	for (idx_t schema_idx = 0; schema_idx < catalog.schemas.size(); schema_idx++) {
+		schema_map[catalog.schemas[schema_idx].id] = schema_idx;
+	}
+	// load only the names and ids of the tables - columns, tags and partitions are loaded when the table is used
+	auto result = transaction.PreparedQuery(snapshot, R"(
+SELECT schema_id, table_id, table_uuid::VARCHAR, table_name, path, path_is_relative
+FROM {METADATA_CATALOG}.ducklake_table tbl
+WHERE {SNAPSHOT_ID} >= tbl.begin_snapshot AND ({SNAPSHOT_ID} < tbl.end_snapshot OR tbl.end_snapshot IS NULL)
+)");
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get table information from DuckLake: ");
+	}
+	for (auto &row : *result) {
+		DuckLakeTableInfo table_info;
+		table_info.schema_id = SchemaIndex(row.GetValue<uint64_t>(0));
+		table_info.id = TableIndex(row.GetValue<uint64_t>(1));
+		table_info.uuid = row.GetValue<string>(2);
+		table_info.name = row.GetValue<string>(3);
+		auto schema_entry = schema_map.find(table_info.schema_id);
+		if (schema_entry == schema_map.end()) {
+			throw InvalidInputException(
+			    "Failed to load DuckLake - table with id %d references schema id %d that does not exist",
+			    table_info.id.index, table_info.schema_id.index);
+		}
+		auto &schema = catalog.schemas[schema_entry->second];
+		if (row.IsNull(4)) {
+			table_info.path = schema.path;
+		} else {
+			DuckLakePath path;
+			path.path = row.GetValue<string>(4);
+			path.path_is_relative = row.GetValue<bool>(5);
+			table_info.path = FromRelativePath(path, schema.path);
+		}
+		catalog.lazy_tables.push_back(std::move(table_info));
+	}
+	LoadViewInfo(snapshot, catalog, string());
+	return catalog;
+}
+
+DuckLakeCatalogInfo DuckLakeMetadataManager::GetTablesForSnapshot(DuckLakeSnapshot snapshot,
+                                                                  const set<TableIndex> &table_ids) {
+	if (table_ids.empty()) {
+		throw InternalException("GetTablesForSnapshot called without any tables");
+	}
+	auto id_list = TableIdList(table_ids);
+	return LoadCatalogInfo(snapshot, StringUtil::Format("AND tbl.table_id IN (%s)", id_list), "AND FALSE",
+	                       StringUtil::Format("AND part.table_id IN (%s)", id_list));
+}
+
+void DuckLakeMetadataManager::LoadSchemaInfo(DuckLakeSnapshot snapshot, DuckLakeCatalogInfo &catalog) {
+	DuckLakeMetadataOperation metadata_operation("LoadSchemaInfo");
 	auto &ducklake_catalog = transaction.GetCatalog();
 	auto &base_data_path = ducklake_catalog.DataPath();
-	DuckLakeCatalogInfo catalog;
 	// load the schema information
-	auto result = transaction.Query(snapshot, R"(
+	auto result = transaction.PreparedQuery(snapshot, R"(
 SELECT schema_id, schema_uuid::VARCHAR, schema_name, path, path_is_relative
 FROM {METADATA_CATALOG}.ducklake_schema
 WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
@@ -253,7 +373,6 @@ WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_s
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get schema information from DuckLake: ");
 	}
-	map<SchemaIndex, idx_t> schema_map;
 	for (auto &row : *result) {
 		DuckLakeSchemaInfo schema;
 		schema.id = SchemaIndex(row.GetValue<uint64_t>(0));
@@ -270,12 +389,75 @@ WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_s
 
 			schema.path = FromRelativePath(path);
 		}
-		schema_map[schema.id] = catalog.schemas.size();
 		catalog.schemas.push_back(std::move(schema));
 	}
+}
+
+void DuckLakeMetadataManager::LoadViewInfo(DuckLakeSnapshot snapshot, DuckLakeCatalogInfo &catalog,
+                                           const string &view_filter) {
+	DuckLakeMetadataOperation metadata_operation("LoadViewInfo");
+	// load view information
+	auto query = StringUtil::Replace(R"(
+SELECT view_id, view_uuid, schema_id, view_name, dialect, sql, column_aliases,
+	(
+		SELECT LIST({'key': key, 'value': value})
+		FROM {METADATA_CATALOG}.ducklake_tag tag
+		WHERE object_id=view_id AND
+		      {SNAPSHOT_ID} >= tag.begin_snapshot AND ({SNAPSHOT_ID} < tag.end_snapshot OR tag.end_snapshot IS NULL)
+	) AS tag
+FROM {METADATA_CATALOG}.ducklake_view view
+WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < view.end_snapshot OR view.end_snapshot IS NULL)
+  {ENTRY_FILTER}
+)",
+	                                 "{ENTRY_FILTER}", view_filter);
+	unique_ptr<QueryResult> result;
+	if (view_filter.empty()) {
+		result = transaction.PreparedQuery(snapshot, std::move(query));
+	} else {
+		result = transaction.Query(snapshot, std::move(query));
+	}
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get view information from DuckLake: ");
+	}
+	auto &views = catalog.views;
+	for (auto &row : *result) {
+		DuckLakeViewInfo view_info;
+		view_info.id = TableIndex(row.GetValue<uint64_t>(0));
+		view_info.uuid = row.GetValue<string>(1);
+		view_info.schema_id = SchemaIndex(row.GetValue<uint64_t>(2));
+		view_info.name = row.GetValue<string>(3);
+		view_info.dialect = row.GetValue<string>(4);
+		view_info.sql = row.GetValue<string>(5);
+		view_info.column_aliases = DuckLakeUtil::ParseQuotedList(row.GetValue<string>(6));
+		if (!row.IsNull(7)) {
+			auto tags = row.GetValue<Value>(7);
+			view_info.tags = LoadTags(tags);
+		}
+		views.push_back(std::move(view_info));
+	}
+}
+
+DuckLakeCatalogInfo DuckLakeMetadataManager::LoadCatalogInfo(DuckLakeSnapshot snapshot, const string &table_filter,
+                                                             const string &view_filter,
+                                                             const string &partition_filter) {
+	DuckLakeMetadataOperation metadata_operation("LoadCatalogInfo");
+	DuckLakeCatalogInfo catalog;
+	auto run_query = [&](const string &query, const string &filter) {
+		auto final_query = StringUtil::Replace(query, "{ENTRY_FILTER}", filter);
+		if (filter.empty()) {
+			// loading the full catalog - use a cached prepared statement
+			return transaction.PreparedQuery(snapshot, std::move(final_query));
+		}
+		return transaction.Query(snapshot, std::move(final_query));
+	};
+	LoadSchemaInfo(snapshot, catalog);
+	map<SchemaIndex, idx_t> schema_map;
+	for (idx_t schema_idx = 0; schema_idx < catalog.schemas.size(); schema_idx++) {
+		schema_map[catalog.schemas[schema_idx].id] = schema_idx;
+	}
 
 	// load the table information
-	result = transaction.Query(snapshot, R"(
+	auto result = run_query(R"(
 SELECT schema_id, tbl.table_id, table_uuid::VARCHAR, table_name,
 	(
 		SELECT LIST({'key': key, 'value': value})
@@ -300,8 +482,10 @@ FROM {METADATA_CATALOG}.ducklake_table tbl
 LEFT JOIN {METADATA_CATALOG}.ducklake_column col USING (table_id)
 WHERE {SNAPSHOT_ID} >= tbl.begin_snapshot AND ({SNAPSHOT_ID} < tbl.end_snapshot OR tbl.end_snapshot IS NULL)
   AND (({SNAPSHOT_ID} >= col.begin_snapshot AND ({SNAPSHOT_ID} < col.end_snapshot OR col.end_snapshot IS NULL)) OR column_id IS NULL)
+  {ENTRY_FILTER}
 ORDER BY table_id, parent_column NULLS FIRST, column_order
-)");
+)",
+	                   table_filter);
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get table information from DuckLake: ");
 	}
@@ -379,46 +563,18 @@ ORDER BY table_id, parent_column NULLS FIRST, column_order
 			}
 		}
 	}
-	// load view information
-	result = transaction.Query(snapshot, R"(
-SELECT view_id, view_uuid, schema_id, view_name, dialect, sql, column_aliases,
-	(
-		SELECT LIST({'key': key, 'value': value})
-		FROM {METADATA_CATALOG}.ducklake_tag tag
-		WHERE object_id=view_id AND
-		      {SNAPSHOT_ID} >= tag.begin_snapshot AND ({SNAPSHOT_ID} < tag.end_snapshot OR tag.end_snapshot IS NULL)
-	) AS tag
-FROM {METADATA_CATALOG}.ducklake_view view
-WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < view.end_snapshot OR view.end_snapshot IS NULL)
-)");
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to get partition information from DuckLake: ");
-	}
-	auto &views = catalog.views;
-	for (auto &row : *result) {
-		DuckLakeViewInfo view_info;
-		view_info.id = TableIndex(row.GetValue<uint64_t>(0));
-		view_info.uuid = row.GetValue<string>(1);
-		view_info.schema_id = SchemaIndex(row.GetValue<uint64_t>(2));
-		view_info.name = row.GetValue<string>(3);
-		view_info.dialect = row.GetValue<string>(4);
-		view_info.sql = row.GetValue<string>(5);
-		view_info.column_aliases = DuckLakeUtil::ParseQuotedList(row.GetValue<string>(6));
-		if (!row.IsNull(7)) {
-			auto tags = row.GetValue<Value>(7);
-			view_info.tags = LoadTags(tags);
-		}
-		views.push_back(std::move(view_info));
-	}
+	LoadViewInfo(snapshot, catalog, view_filter);
 
 	// load partition information
-	result = transaction.Query(snapshot, R"(
+	result = run_query(R"(
 SELECT partition_id, part.table_id, partition_key_index, column_id, transform
 FROM {METADATA_CATALOG}.ducklake_partition_info part
 JOIN {METADATA_CATALOG}.ducklake_partition_column part_col USING (partition_id)
 WHERE {SNAPSHOT_ID} >= part.begin_snapshot AND ({SNAPSHOT_ID} < part.end_snapshot OR part.end_snapshot IS NULL)
+  {ENTRY_FILTER}
 ORDER BY part.table_id, partition_id, partition_key_index
-)");
+)",
+	                   partition_filter);
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get partition information from DuckLake: ");
 	}
@@ -445,14 +601,38 @@ ORDER BY part.table_id, partition_id, partition_key_index
 }
 
 vector<DuckLakeGlobalStatsInfo> DuckLakeMetadataManager::GetGlobalTableStats(DuckLakeSnapshot snapshot) {
+	return LoadGlobalTableStats(snapshot, string());
+}
+
+vector<DuckLakeGlobalStatsInfo> DuckLakeMetadataManager::GetGlobalTableStats(DuckLakeSnapshot snapshot,
+                                                                             const set<TableIndex> &table_ids) {
+	if (table_ids.empty()) {
+		return vector<DuckLakeGlobalStatsInfo>();
+	}
+	auto id_list = TableIdList(table_ids);
+	return LoadGlobalTableStats(snapshot, StringUtil::Format("AND table_id IN (%s)", id_list));
+}
+
+vector<DuckLakeGlobalStatsInfo> DuckLakeMetadataManager::LoadGlobalTableStats(DuckLakeSnapshot snapshot,
+                                                                              const string &table_filter) {
+	DuckLakeMetadataOperation metadata_operation("LoadGlobalTableStats");
 	// query the most recent stats
-	auto result = transaction.Query(snapshot, R"(
+	string query = R"(
 SELECT table_id, column_id, record_count, next_row_id, file_size_bytes, contains_null, contains_nan, min_value, max_value, extra_stats
 FROM {METADATA_CATALOG}.ducklake_table_stats
 LEFT JOIN {METADATA_CATALOG}.ducklake_table_column_stats USING (table_id)
 WHERE record_count IS NOT NULL AND file_size_bytes IS NOT NULL
+{TABLE_FILTER}
 ORDER BY table_id;
-)");
+)";
+	query = StringUtil::Replace(query, "{TABLE_FILTER}", table_filter);
+	unique_ptr<QueryResult> result;
+	if (table_filter.empty()) {
+		// loading the stats of all tables - use a cached prepared statement
+		result = transaction.PreparedQuery(snapshot, std::move(query));
+	} else {
+		result = transaction.Query(snapshot, std::move(query));
+	}
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get global stats information from DuckLake: ");
 	}
@@ -626,33 +806,85 @@ static void ParsePartialFileInfo(DuckLakeSnapshot snapshot, const string &partia
 	}
 }
 
-vector<DuckLakeFileListEntry>
-DuckLakeMetadataManager::GetFilesForTable(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot, const string &filter) {
-	auto table_id = table.GetTableId();
-	string select_list = GetFileSelectList("data") +
-	                     ", data.row_id_start, data.begin_snapshot, data.partial_file_info, data.mapping_id, " +
-	                     GetFileSelectList("del");
-	auto query = StringUtil::Format(R"(
+//! The amount of files that is read from the metadata catalog by a single file list query
+static constexpr idx_t FILE_LIST_PAGE_SIZE = 100000;
+
+//! The query for the file list of a table - $1 is the table id, and only files with an id above $2 are listed
+static string GetFileListQuery(const string &select_list, const string &data_file_table,
+                               const string &delete_file_table) {
+	return StringUtil::Format(R"(
 SELECT %s
-FROM {METADATA_CATALOG}.ducklake_data_file data
+FROM %s data
 LEFT JOIN (
     SELECT *
-    FROM {METADATA_CATALOG}.ducklake_delete_file
-    WHERE table_id=%d  AND {SNAPSHOT_ID} >= begin_snapshot
+    FROM %s
+    WHERE table_id=$1  AND {SNAPSHOT_ID} >= begin_snapshot
           AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
     ) del USING (data_file_id)
-WHERE data.table_id=%d AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_ID} < data.end_snapshot OR data.end_snapshot IS NULL)
+WHERE data.table_id=$1 AND data.data_file_id > $2
+      AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_ID} < data.end_snapshot OR data.end_snapshot IS NULL)
+      AND (del.delete_count IS NULL OR del.delete_count < data.record_count)
 		)",
-	                                select_list, table_id.index, table_id.index);
-	if (!filter.empty()) {
-		query += "\nAND " + filter;
+	                          select_list, data_file_table, delete_file_table);
+}
+
+vector<DuckLakeFileListEntry>
+DuckLakeMetadataManager::GetFilesForTable(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot, const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("GetFilesForTable");
+	// the file list of a large table can have millions of rows - it is read in pages so that only a single page of the
+	// metadata result is materialized next to the converted file list at any time
+	vector<DuckLakeFileListEntry> files;
+	optional_idx last_file_id;
+	while (true) {
+		auto page = GetFilesForTablePage(table, snapshot, filter, last_file_id, FILE_LIST_PAGE_SIZE);
+		auto page_count = page.size();
+		for (auto &file : page) {
+			files.push_back(std::move(file));
+		}
+		if (page_count < FILE_LIST_PAGE_SIZE) {
+			break;
+		}
+		last_file_id = files.back().file_id.index;
+	}
+	return files;
+}
+
+vector<DuckLakeFileListEntry> DuckLakeMetadataManager::GetFilesForTablePage(DuckLakeTableEntry &table,
+                                                                            DuckLakeSnapshot snapshot,
+                                                                            const string &filter,
+                                                                            optional_idx last_file_id,
+                                                                            idx_t page_size) {
+	DuckLakeMetadataOperation metadata_operation("GetFilesForTable");
+	auto table_id = table.GetTableId();
+	string select_list = GetFileSelectList("data") +
+	                     ", data.row_id_start, data.begin_snapshot, data.partial_file_info, data.mapping_id, " +
+	                     GetFileSelectList("del") + ", data.data_file_id, data.record_count, del.delete_count";
+	auto query = GetFileListQuery(select_list, GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1),
+	                              GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1));
+	auto order_clause = StringUtil::Format("\nORDER BY data.data_file_id\nLIMIT %llu", page_size);
+	int64_t after_file_id = last_file_id.IsValid() ? NumericCast<int64_t>(last_file_id.GetIndex()) : -1;
+	unique_ptr<QueryResult> result;
+	if (filter.empty()) {
+		// the unfiltered file list is requested for every scan - run it through a cached prepared statement
+		vector<Value> parameters {Value::BIGINT(NumericCast<int64_t>(table_id.index)), Value::BIGINT(after_file_id)};
+		result = transaction.PreparedQuery(snapshot, query + order_clause, std::move(parameters));
+	} else {
+		auto page_query = StringUtil::Replace(query, "$1", to_string(table_id.index));
+		page_query = StringUtil::Replace(page_query, "$2", to_string(after_file_id));
+		page_query += "\nAND " + filter + order_clause;
+		result = transaction.Query(snapshot, page_query);
 	}
-	auto result = transaction.Query(snapshot, query);
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get data file list from DuckLake: ");
 	}
 	vector<DuckLakeFileListEntry> files;
-	for (auto &row : *result) {
+	ReadFileListPage(table, snapshot, *result, files);
+	return files;
+}
+
+void DuckLakeMetadataManager::ReadFileListPage(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+                                               QueryResult &result, vector<DuckLakeFileListEntry> &files) {
+	for (auto &row : result) {
 		DuckLakeFileListEntry file_entry;
 		idx_t col_idx = 0;
 		file_entry.file = ReadDataFile(table, row, col_idx, IsEncrypted());
@@ -671,26 +903,362 @@ WHERE data.table_id=%d AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_I
 		}
 		col_idx++;
 		file_entry.delete_file = ReadDataFile(table, row, col_idx, IsEncrypted());
+		file_entry.file_id = DataFileIndex(row.GetValue<idx_t>(col_idx++));
+		if (!row.IsNull(col_idx)) {
+			file_entry.row_count = row.GetValue<idx_t>(col_idx);
+		}
+		col_idx++;
+		if (!row.IsNull(col_idx)) {
+			file_entry.delete_count = row.GetValue<idx_t>(col_idx);
+		}
 		files.push_back(std::move(file_entry));
 	}
+}
+
+//! The columns of a manifest - the first columns are in the order in which they are converted by ReadFileListPage
+static constexpr const char *MANIFEST_COLUMNS =
+    "data.path, data.path_is_relative, data.file_size_bytes, data.footer_size, data.row_id_start, "
+    "data.begin_snapshot, data.partial_file_info, data.mapping_id, del.path AS delete_path, "
+    "del.path_is_relative AS delete_path_is_relative, del.file_size_bytes AS delete_file_size_bytes, "
+    "del.footer_size AS delete_footer_size, data.data_file_id, data.record_count, del.delete_count, data.partition_id";
+
+DuckLakeManifestList DuckLakeMetadataManager::WriteManifests(DuckLakeTableEntry &table, DuckLakeSnapshot snapshot,
+                                                             const string &directory, idx_t manifest_size) {
+	DuckLakeMetadataOperation metadata_operation("WriteManifests");
+	if (IsEncrypted()) {
+		// the manifests would contain the encryption keys of the files
+		throw NotImplementedException("Manifests are not supported for encrypted DuckLakes");
+	}
+	auto table_id = table.GetTableId();
+	// the files are grouped by their identity partition values - which are summarized per manifest
+	string partition_columns;
+	string partition_order;
+	vector<string> partition_column_names;
+	vector<string> field_ids;
+	vector<string> min_values;
+	vector<string> max_values;
+	auto partition_data = table.GetPartitionData();
+	if (partition_data) {
+		for (auto &field : partition_data->fields) {
+			if (field.transform.type != DuckLakeTransformType::IDENTITY) {
+				continue;
+			}
+			auto field_data = table.GetFieldData().GetByFieldIndex(field.field_id);
+			if (!field_data || !DuckLakeColumnZoneMap::SupportsType(field_data->Type())) {
+				continue;
+			}
+			auto column_name = "partition_value_" + to_string(partition_column_names.size());
+			// the partition values of files that were written with a different partition key are not used
+			partition_columns += StringUtil::Format(
+			    ", CASE WHEN data.partition_id=%d THEN (SELECT TRY_CAST(partition_value AS %s) FROM "
+			    "{METADATA_CATALOG}.ducklake_file_partition_value pv WHERE pv.data_file_id=data.data_file_id AND "
+			    "pv.table_id=%d AND pv.partition_key_index=%d) END AS %s",
+			    partition_data->partition_id, field_data->Type().ToString(), table_id.index,
+			    field.partition_key_index, column_name);
+			partition_order += column_name + ", ";
+			field_ids.push_back(to_string(field.field_id.index));
+			// a column is only summarized if all files in the manifest have a partition value for it
+			min_values.push_back(StringUtil::Format("CASE WHEN COUNT(%s)=COUNT(*) THEN MIN(%s)::VARCHAR END",
+			                                        column_name, column_name));
+			max_values.push_back(StringUtil::Format("CASE WHEN COUNT(%s)=COUNT(*) THEN MAX(%s)::VARCHAR END",
+			                                        column_name, column_name));
+			partition_column_names.push_back(std::move(column_name));
+		}
+	}
+	auto file_list_query = GetFileListQuery(string(MANIFEST_COLUMNS) + partition_columns,
+	                                        GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1),
+	                                        GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1));
+	file_list_query = StringUtil::Replace(file_list_query, "$1", to_string(table_id.index));
+	file_list_query = StringUtil::Replace(file_list_query, "$2", "-1");
+	// the order is total - so that the manifests and the manifest list are computed over the same groups
+	auto grouped_query = StringUtil::Format(
+	    "SELECT *, (ROW_NUMBER() OVER (ORDER BY %sdata_file_id) - 1) // %llu AS manifest_group FROM (%s) entries",
+	    partition_order, manifest_size, file_list_query);
+	auto manifest_directory = table.DataPath() + directory;
+	string manifest_select = "*";
+	if (!partition_column_names.empty()) {
+		manifest_select += " EXCLUDE (" + StringUtil::Join(partition_column_names, ", ") + ")";
+	}
+	auto result = transaction.Query(
+	    snapshot, StringUtil::Format("COPY (SELECT %s FROM (%s) grouped) TO %s (FORMAT parquet, PARTITION_BY "
+	                                 "(manifest_group))",
+	                                 manifest_select, grouped_query, SQLString(manifest_directory)));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to write manifests for DuckLake table: ");
+	}
+	// the snapshot is stored in the key-value metadata of the manifest list - so that it is known for an empty list
+	auto list_path = manifest_directory + DuckLakeManifestList::LIST_FILE_NAME;
+	result = transaction.Query(
+	    snapshot,
+	    StringUtil::Format("COPY (SELECT manifest_group, COUNT(*) AS file_count, SUM(record_count) AS record_count, "
+	                       "[%s]::BIGINT[] AS partition_field_ids, [%s]::VARCHAR[] AS partition_min_values, "
+	                       "[%s]::VARCHAR[] AS partition_max_values FROM (%s) grouped GROUP BY manifest_group "
+	                       "ORDER BY manifest_group) TO %s (FORMAT parquet, KV_METADATA {snapshot_id: '%d'})",
+	                       StringUtil::Join(field_ids, ", "), StringUtil::Join(min_values, ", "),
+	                       StringUtil::Join(max_values, ", "), grouped_query, SQLString(list_path),
+	                       snapshot.snapshot_id));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to write manifest list for DuckLake table: ");
+	}
+	auto manifest_list = ReadManifestList(table, directory);
+	if (!manifest_list) {
+		throw IOException("Failed to write manifest list %s for DuckLake table", list_path);
+	}
+	return std::move(*manifest_list);
+}
+
+unique_ptr<DuckLakeManifestList> DuckLakeMetadataManager::ReadManifestList(DuckLakeTableEntry &table,
+                                                                           const string &directory) {
+	DuckLakeMetadataOperation metadata_operation("ReadManifestList");
+	auto manifest_directory = table.DataPath() + directory;
+	auto list_path = manifest_directory + DuckLakeManifestList::LIST_FILE_NAME;
+	if (!GetFileSystem().FileExists(list_path)) {
+		return nullptr;
+	}
+	auto result = transaction.Query(StringUtil::Format(
+	    "SELECT decode(value) FROM parquet_kv_metadata(%s) WHERE decode(key) = 'snapshot_id'", SQLString(list_path)));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to read manifest list of DuckLake table: ");
+	}
+	auto manifest_list = make_uniq<DuckLakeManifestList>();
+	manifest_list->directory = directory;
+	bool has_snapshot = false;
+	for (auto &row : *result) {
+		manifest_list->snapshot_id = StringUtil::ToUnsigned(row.GetValue<string>(0));
+		has_snapshot = true;
+	}
+	if (!has_snapshot) {
+		throw InvalidInputException("Manifest list %s does not have a snapshot id", list_path);
+	}
+	result = transaction.Query(StringUtil::Format(R"(
+SELECT manifest_group, file_count, record_count, partition_field_ids, partition_min_values, partition_max_values
+FROM read_parquet(%s)
+ORDER BY manifest_group
+)",
+	                                              SQLString(list_path)));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to read manifest list of DuckLake table: ");
+	}
+	auto &separator = transaction.GetCatalog().Separator();
+	for (auto &row : *result) {
+		DuckLakeManifestInfo manifest;
+		// the manifests are written as a hive partitioned COPY - the file names within a partition are not fixed
+		manifest.path = StringUtil::Format("%smanifest_group=%d%s*.parquet", manifest_directory,
+		                                   row.GetValue<idx_t>(0), separator);
+		manifest.file_count = row.GetValue<idx_t>(1);
+		manifest.record_count = row.GetValue<idx_t>(2);
+		auto field_ids = row.iterator.chunk->GetValue(3, row.row);
+		auto min_values = row.iterator.chunk->GetValue(4, row.row);
+		auto max_values = row.iterator.chunk->GetValue(5, row.row);
+		auto &field_id_list = ListValue::GetChildren(field_ids);
+		auto &min_value_list = ListValue::GetChildren(min_values);
+		auto &max_value_list = ListValue::GetChildren(max_values);
+		for (idx_t i = 0; i < field_id_list.size(); i++) {
+			if (min_value_list[i].IsNull() || max_value_list[i].IsNull()) {
+				continue;
+			}
+			DuckLakeManifestPartitionSummary summary;
+			summary.field_id = FieldIndex(field_id_list[i].GetValue<idx_t>());
+			auto field_data = table.GetFieldData().GetByFieldIndex(summary.field_id);
+			if (!field_data) {
+				continue;
+			}
+			summary.min_value = min_value_list[i];
+			summary.max_value = max_value_list[i];
+			if (!summary.min_value.DefaultTryCastAs(field_data->Type()) ||
+			    !summary.max_value.DefaultTryCastAs(field_data->Type())) {
+				continue;
+			}
+			manifest.partition_summaries.push_back(std::move(summary));
+		}
+		manifest_list->manifests.push_back(std::move(manifest));
+	}
+	return manifest_list;
+}
+
+vector<DuckLakeFileListEntry> DuckLakeMetadataManager::ReadManifests(DuckLakeTableEntry &table,
+                                                                     const DuckLakeManifestList &list,
+                                                                     const vector<idx_t> &manifest_indexes,
+                                                                     const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("ReadManifests");
+	vector<DuckLakeFileListEntry> files;
+	if (manifest_indexes.empty()) {
+		return files;
+	}
+	vector<string> paths;
+	for (auto &manifest_idx : manifest_indexes) {
+		paths.push_back(SQLString(list.manifests[manifest_idx].path));
+	}
+	// the manifests have the same column names as the data file list - so filters on the file list apply to them
+	auto query = StringUtil::Format("SELECT * FROM read_parquet([%s], hive_partitioning=false) data",
+	                                StringUtil::Join(paths, ", "));
+	if (!filter.empty()) {
+		query += "\nWHERE " + filter;
+	}
+	query += "\nORDER BY data_file_id";
+	DuckLakeSnapshot snapshot(list.snapshot_id, 0, 0, 0);
+	auto result = transaction.Query(snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to read manifests of DuckLake table: ");
+	}
+	ReadFileListPage(table, snapshot, *result, files);
 	return files;
 }
 
+vector<DuckLakeFileStatsEntry> DuckLakeMetadataManager::GetFileStatsForTable(DuckLakeTableEntry &table,
+                                                                              DuckLakeSnapshot snapshot,
+                                                                              const vector<FieldIndex> &columns) {
+	DuckLakeMetadataOperation metadata_operation("GetFileStatsForTable");
+	auto table_id = table.GetTableId();
+	string stats_select_list = "NULL, NULL, NULL, NULL, NULL";
+	string stats_join;
+	if (!columns.empty()) {
+		string column_list;
+		for (auto &column_id : columns) {
+			if (!column_list.empty()) {
+				column_list += ", ";
+			}
+			column_list += to_string(column_id.index);
+		}
+		stats_select_list = "stats.column_id, stats.min_value, stats.max_value, stats.null_count, stats.contains_nan";
+		stats_join = StringUtil::Format(R"(
+LEFT JOIN (
+    SELECT data_file_id, column_id, min_value, max_value, null_count, contains_nan
+    FROM {METADATA_CATALOG}.ducklake_file_column_stats
+    WHERE table_id=%d AND column_id IN (%s)
+    ) stats USING (data_file_id))",
+		                                table_id.index, column_list);
+	}
+	auto query = StringUtil::Format(R"(
+SELECT data.data_file_id, data.record_count, data.partial_file_info, del.delete_count, %s
+FROM %s data
+LEFT JOIN (
+    SELECT data_file_id, delete_count
+    FROM %s
+    WHERE table_id=%d AND {SNAPSHOT_ID} >= begin_snapshot
+          AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
+    ) del USING (data_file_id)%s
+WHERE data.table_id=%d AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_ID} < data.end_snapshot OR data.end_snapshot IS NULL)
+ORDER BY data.data_file_id
+)",
+	                                stats_select_list, GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1),
+	                                GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1), table_id.index,
+	                                stats_join, table_id.index);
+	auto result = transaction.Query(snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get data file stats from DuckLake: ");
+	}
+	vector<DuckLakeFileStatsEntry> files;
+	for (auto &row : *result) {
+		DataFileIndex file_id(row.GetValue<idx_t>(0));
+		if (files.empty() || files.back().file_id != file_id) {
+			// first row of a new file
+			DuckLakeFileStatsEntry file_entry;
+			file_entry.file_id = file_id;
+			file_entry.row_count = row.GetValue<idx_t>(1);
+			if (!row.IsNull(2)) {
+				DuckLakeFileListEntry partial_file;
+				ParsePartialFileInfo(snapshot, row.GetValue<string>(2), partial_file);
+				file_entry.is_partial_file =
+				    partial_file.max_row_count.IsValid() || partial_file.snapshot_filter.IsValid();
+			}
+			if (!row.IsNull(3)) {
+				file_entry.delete_count = row.GetValue<idx_t>(3);
+			}
+			files.push_back(std::move(file_entry));
+		}
+		if (row.IsNull(4)) {
+			// no stats for this file
+			continue;
+		}
+		DuckLakeFileColumnStatsEntry column_stats;
+		column_stats.column_id = FieldIndex(row.GetValue<idx_t>(4));
+		if (!row.IsNull(5)) {
+			column_stats.min_value = Value(row.GetValue<string>(5));
+		}
+		if (!row.IsNull(6)) {
+			column_stats.max_value = Value(row.GetValue<string>(6));
+		}
+		if (!row.IsNull(7)) {
+			column_stats.null_count = row.GetValue<idx_t>(7);
+		}
+		if (!row.IsNull(8)) {
+			column_stats.contains_nan = row.GetValue<bool>(8);
+		}
+		files.back().column_stats.push_back(std::move(column_stats));
+	}
+	return files;
+}
+
+DuckLakeFileListChanges DuckLakeMetadataManager::GetFileListChanges(DuckLakeTableEntry &table,
+                                                                    DuckLakeSnapshot start_snapshot,
+                                                                    DuckLakeSnapshot snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetFileListChanges");
+	DuckLakeFileListChanges changes;
+	auto table_id = table.GetTableId();
+	// files that were removed from the file list, whose delete file was replaced, or that received a delete file that
+	// deletes all of their rows
+	// if the start snapshot has been expired the rows of removed files might have been purged - we signal this by
+	// emitting a NULL row
+	// only rows that ended after the start snapshot are relevant
+	auto data_file_table = GetFileTable("ducklake_data_file", start_snapshot.snapshot_id + 1);
+	auto delete_file_table = GetFileTable("ducklake_delete_file", start_snapshot.snapshot_id + 1);
+	auto query = StringUtil::Format(R"(
+SELECT data_file_id
+FROM %s
+WHERE table_id=%d AND end_snapshot > %d AND end_snapshot <= {SNAPSHOT_ID}
+UNION
+SELECT data_file_id
+FROM %s
+WHERE table_id=%d AND end_snapshot > %d AND end_snapshot <= {SNAPSHOT_ID}
+UNION
+SELECT del.data_file_id
+FROM %s del
+JOIN %s data USING (data_file_id)
+WHERE del.table_id=%d AND del.begin_snapshot > %d AND del.begin_snapshot <= {SNAPSHOT_ID}
+      AND del.delete_count >= data.record_count
+UNION ALL
+SELECT NULL
+WHERE NOT EXISTS (SELECT 1 FROM {METADATA_CATALOG}.ducklake_snapshot WHERE snapshot_id=%d)
+)",
+	                                data_file_table, table_id.index, start_snapshot.snapshot_id, delete_file_table,
+	                                table_id.index, start_snapshot.snapshot_id, delete_file_table, data_file_table,
+	                                table_id.index, start_snapshot.snapshot_id, start_snapshot.snapshot_id);
+	auto result = transaction.Query(snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get data file list changes from DuckLake: ");
+	}
+	for (auto &row : *result) {
+		if (row.IsNull(0)) {
+			changes.start_snapshot_expired = true;
+			return changes;
+		}
+		changes.removed_files.insert(DataFileIndex(row.GetValue<idx_t>(0)));
+	}
+	// files that were added, or that received a new delete file
+	auto filter = StringUtil::Format("(data.begin_snapshot > %d OR del.begin_snapshot > %d)",
+	                                 start_snapshot.snapshot_id, start_snapshot.snapshot_id);
+	changes.new_files = GetFilesForTable(table, snapshot, filter);
+	return changes;
+}
+
 vector<DuckLakeFileListEntry> DuckLakeMetadataManager::GetTableInsertions(DuckLakeTableEntry &table,
                                                                           DuckLakeSnapshot start_snapshot,
                                                                           DuckLakeSnapshot end_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetTableInsertions");
 	auto table_id = table.GetTableId();
 	string select_list = GetFileSelectList("data") +
 	                     ", data.row_id_start, data.begin_snapshot, data.partial_file_info, data.mapping_id, " +
 	                     GetFileSelectList("del");
 	auto query = StringUtil::Format(R"(
 SELECT %s
-FROM {METADATA_CATALOG}.ducklake_data_file data, (
+FROM %s data, (
 	SELECT NULL path, NULL path_is_relative, NULL file_size_bytes, NULL footer_size, NULL encryption_key
 ) del
 WHERE data.table_id=%d AND data.begin_snapshot >= %d AND data.begin_snapshot <= {SNAPSHOT_ID};
 		)",
-	                                select_list, table_id.index, start_snapshot.snapshot_id);
+	                                select_list, GetFileTable("ducklake_data_file", start_snapshot.snapshot_id + 1),
+	                                table_id.index, start_snapshot.snapshot_id);
 
 	auto result = transaction.Query(end_snapshot, query);
 	if (result->HasError()) {
@@ -724,6 +1292,7 @@ WHERE data.table_id=%d AND data.begin_snapshot >= %d AND data.begin_snapshot <=
 vector<DuckLakeDeleteScanEntry> DuckLakeMetadataManager::GetTableDeletions(DuckLakeTableEntry &table,
                                                                            DuckLakeSnapshot start_snapshot,
                                                                            DuckLakeSnapshot end_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetTableDeletions");
 	auto table_id = table.GetTableId();
 	string select_list = GetFileSelectList("data") + ", data.row_id_start, data.record_count, data.mapping_id, " +
 	                     GetFileSelectList("current_delete") + ", " + GetFileSelectList("previous_delete");
@@ -738,18 +1307,18 @@ vector<DuckLakeDeleteScanEntry> DuckLakeMetadataManager::GetTableDeletions(DuckL
 	    StringUtil::Format(R"(
 SELECT %s, current_delete.begin_snapshot FROM (
 	SELECT data_file_id, begin_snapshot, path, path_is_relative, file_size_bytes, footer_size, encryption_key
-	FROM {METADATA_CATALOG}.ducklake_delete_file
+	FROM {DELETE_FILE_TABLE}
 	WHERE table_id = %d AND begin_snapshot >= %d AND begin_snapshot <= {SNAPSHOT_ID}
 ) AS current_delete
 LEFT JOIN (
 	SELECT data_file_id, MAX_BY(COLUMNS(['path', 'path_is_relative', 'file_size_bytes', 'footer_size', 'encryption_key']), begin_snapshot) AS '\0'
-	FROM {METADATA_CATALOG}.ducklake_delete_file
+	FROM {DELETE_FILE_TABLE}
 	WHERE table_id = %d AND begin_snapshot < current_delete.begin_snapshot
 	GROUP BY data_file_id
 ) AS previous_delete
 USING (data_file_id)
 JOIN (
-	FROM {METADATA_CATALOG}.ducklake_data_file data
+	FROM {DATA_FILE_TABLE} data
 	WHERE table_id = %d
 ) AS data
 USING (data_file_id)
@@ -757,12 +1326,12 @@ USING (data_file_id)
 UNION ALL
 
 SELECT %s, data.end_snapshot FROM (
-	FROM {METADATA_CATALOG}.ducklake_data_file
+	FROM {DATA_FILE_TABLE}
 	WHERE table_id = %d AND end_snapshot >= %d AND end_snapshot <= {SNAPSHOT_ID}
 ) AS data
 LEFT JOIN (
 	SELECT data_file_id, MAX_BY(COLUMNS(['path', 'path_is_relative', 'file_size_bytes', 'footer_size', 'encryption_key']), begin_snapshot) AS '\0'
-	FROM {METADATA_CATALOG}.ducklake_delete_file
+	FROM {DELETE_FILE_TABLE}
 	WHERE table_id = %d AND begin_snapshot < data.end_snapshot
 	GROUP BY data_file_id
 ) AS previous_delete
@@ -772,6 +1341,12 @@ USING (data_file_id), (
 		)",
 	                       select_list, table_id.index, start_snapshot.snapshot_id, table_id.index, table_id.index,
 	                       select_list, table_id.index, start_snapshot.snapshot_id, table_id.index);
+	// the previous delete files might have been replaced at the start snapshot - so the rows that ended at the start
+	// snapshot are relevant as well
+	query = StringUtil::Replace(query, "{DATA_FILE_TABLE}",
+	                            GetFileTable("ducklake_data_file", start_snapshot.snapshot_id));
+	query = StringUtil::Replace(query, "{DELETE_FILE_TABLE}",
+	                            GetFileTable("ducklake_delete_file", start_snapshot.snapshot_id));
 	auto result = transaction.Query(end_snapshot, query);
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get table insertion file list from DuckLake: ");
@@ -801,20 +1376,23 @@ USING (data_file_id), (
 vector<DuckLakeFileListExtendedEntry> DuckLakeMetadataManager::GetExtendedFilesForTable(DuckLakeTableEntry &table,
                                                                                         DuckLakeSnapshot snapshot,
                                                                                         const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("GetExtendedFilesForTable");
 	auto table_id = table.GetTableId();
 	string select_list = GetFileSelectList("data") + ", data.row_id_start, " + GetFileSelectList("del");
 	auto query = StringUtil::Format(R"(
 SELECT data.data_file_id, del.delete_file_id, data.record_count, %s
-FROM {METADATA_CATALOG}.ducklake_data_file data
+FROM %s data
 LEFT JOIN (
 	SELECT *
-    FROM {METADATA_CATALOG}.ducklake_delete_file
+    FROM %s
     WHERE table_id=%d  AND {SNAPSHOT_ID} >= begin_snapshot
           AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
     ) del USING (data_file_id)
 WHERE data.table_id=%d AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_ID} < data.end_snapshot OR data.end_snapshot IS NULL)
 		)",
-	                                select_list, table_id.index, table_id.index);
+	                                select_list, GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1),
+	                                GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1), table_id.index,
+	                                table_id.index);
 	if (!filter.empty()) {
 		query += "\nAND " + filter;
 	}
@@ -843,10 +1421,110 @@ WHERE data.table_id=%d AND {SNAPSHOT_ID} >= data.begin_snapshot AND ({SNAPSHOT_I
 	return files;
 }
 
+unordered_map<string, string> DuckLakeMetadataManager::GetFileEncryptionKeys(DuckLakeTableEntry &table,
+                                                                            DuckLakeSnapshot snapshot,
+                                                                            const vector<DataFileIndex> &file_ids) {
+	DuckLakeMetadataOperation metadata_operation("GetFileEncryptionKeys");
+	unordered_map<string, string> result;
+	if (!IsEncrypted() || file_ids.empty()) {
+		return result;
+	}
+	string file_id_list;
+	for (auto &file_id : file_ids) {
+		if (!file_id_list.empty()) {
+			file_id_list += ", ";
+		}
+		file_id_list += to_string(file_id.index);
+	}
+	auto table_id = table.GetTableId();
+	auto select_list = GetFileSelectList("f");
+	auto query = StringUtil::Format(R"(
+SELECT %s
+FROM %s f
+WHERE f.table_id=%d AND f.data_file_id IN (%s)
+UNION ALL
+SELECT %s
+FROM %s f
+WHERE f.table_id=%d AND f.data_file_id IN (%s)
+)",
+	                                select_list, GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1),
+	                                table_id.index, file_id_list, select_list,
+	                                GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1), table_id.index,
+	                                file_id_list);
+	auto query_result = transaction.Query(snapshot, query);
+	if (query_result->HasError()) {
+		query_result->GetErrorObject().Throw("Failed to get the encryption keys of data files from DuckLake: ");
+	}
+	for (auto &row : *query_result) {
+		idx_t col_idx = 0;
+		auto file = ReadDataFile(table, row, col_idx, true);
+		result[file.path] = std::move(file.encryption_key);
+	}
+	return result;
+}
+
+vector<DuckLakeFileColumnStatsInfo> DuckLakeMetadataManager::GetFileColumnStats(DuckLakeTableEntry &table,
+                                                                               const vector<DataFileIndex> &file_ids) {
+	DuckLakeMetadataOperation metadata_operation("GetFileColumnStats");
+	vector<DuckLakeFileColumnStatsInfo> result;
+	if (file_ids.empty()) {
+		return result;
+	}
+	string file_id_list;
+	for (auto &file_id : file_ids) {
+		if (!file_id_list.empty()) {
+			file_id_list += ", ";
+		}
+		file_id_list += to_string(file_id.index);
+	}
+	auto query = StringUtil::Format(R"(
+SELECT data_file_id, column_id, column_size_bytes, null_count, min_value, max_value, contains_nan, extra_stats
+FROM {METADATA_CATALOG}.ducklake_file_column_stats
+WHERE table_id=%d AND data_file_id IN (%s)
+ORDER BY data_file_id, column_id
+)",
+	                                table.GetTableId().index, file_id_list);
+	auto query_result = transaction.Query(query);
+	if (query_result->HasError()) {
+		query_result->GetErrorObject().Throw("Failed to get the column stats of data files from DuckLake: ");
+	}
+	for (auto &row : *query_result) {
+		DuckLakeFileColumnStatsInfo column_stats;
+		column_stats.data_file_id = DataFileIndex(row.GetValue<idx_t>(0));
+		column_stats.column_id = FieldIndex(row.GetValue<idx_t>(1));
+		if (!row.IsNull(2)) {
+			column_stats.column_size_bytes = row.GetValue<idx_t>(2);
+		}
+		if (!row.IsNull(3)) {
+			column_stats.has_null_count = true;
+			column_stats.null_count = row.GetValue<idx_t>(3);
+		}
+		if (!row.IsNull(4)) {
+			column_stats.has_min = true;
+			column_stats.min_val = row.GetValue<string>(4);
+		}
+		if (!row.IsNull(5)) {
+			column_stats.has_max = true;
+			column_stats.max_val = row.GetValue<string>(5);
+		}
+		if (!row.IsNull(6)) {
+			column_stats.has_contains_nan = true;
+			column_stats.contains_nan = row.GetValue<bool>(6);
+		}
+		if (!row.IsNull(7)) {
+			column_stats.has_extra_stats = true;
+			column_stats.extra_stats = row.GetValue<string>(7);
+		}
+		result.push_back(std::move(column_stats));
+	}
+	return result;
+}
+
 vector<DuckLakeCompactionFileEntry> DuckLakeMetadataManager::GetFilesForCompaction(DuckLakeTableEntry &table,
                                                                                    CompactionType type,
                                                                                    double deletion_threshold,
                                                                                    DuckLakeSnapshot snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetFilesForCompaction");
 	auto table_id = table.GetTableId();
 	string data_select_list = "data.data_file_id, data.record_count, data.row_id_start, data.begin_snapshot, "
 	                          "data.end_snapshot, data.mapping_id, sr.schema_version , data.partial_file_info, "
@@ -962,6 +1640,7 @@ ORDER BY data.begin_snapshot, data.row_id_start, data.data_file_id, del.begin_sn
 template <class T>
 void DuckLakeMetadataManager::FlushDrop(DuckLakeSnapshot commit_snapshot, const string &metadata_table_name,
                                         const string &id_name, const set<T> &dropped_entries) {
+	DuckLakeMetadataOperation metadata_operation("FlushDrop");
 	if (dropped_entries.empty()) {
 		return;
 	}
@@ -975,10 +1654,7 @@ void DuckLakeMetadataManager::FlushDrop(DuckLakeSnapshot commit_snapshot, const
 	auto dropped_id_query = StringUtil::Format(
 	    R"(UPDATE {METADATA_CATALOG}.%s SET end_snapshot = {SNAPSHOT_ID} WHERE end_snapshot IS NULL AND %s IN (%s);)",
 	    metadata_table_name, id_name, dropped_id_list);
-	auto result = transaction.Query(commit_snapshot, dropped_id_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write drop information to DuckLake:");
-	}
+	transaction.ExecuteWrite(commit_snapshot, dropped_id_query, "Failed to write drop information to DuckLake:");
 }
 
 void DuckLakeMetadataManager::DropSchemas(DuckLakeSnapshot commit_snapshot, const set<SchemaIndex> &ids) {
@@ -1003,6 +1679,7 @@ void DuckLakeMetadataManager::DropViews(DuckLakeSnapshot commit_snapshot, const
 
 void DuckLakeMetadataManager::WriteNewSchemas(DuckLakeSnapshot commit_snapshot,
                                               const vector<DuckLakeSchemaInfo> &new_schemas) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewSchemas");
 	if (new_schemas.empty()) {
 		throw InternalException("No schemas to create - should be handled elsewhere");
 	}
@@ -1018,10 +1695,7 @@ void DuckLakeMetadataManager::WriteNewSchemas(DuckLakeSnapshot commit_snapshot,
 		                                        path.path_is_relative ? "true" : "false");
 	}
 	schema_insert_sql = "INSERT INTO {METADATA_CATALOG}.ducklake_schema VALUES " + schema_insert_sql;
-	auto result = transaction.Query(commit_snapshot, schema_insert_sql);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new schemas to DuckLake: ");
-	}
+	transaction.ExecuteWrite(commit_snapshot, schema_insert_sql, "Failed to write new schemas to DuckLake: ");
 }
 
 static void ColumnToSQLRecursive(const DuckLakeColumnInfo &column, TableIndex table_id, optional_idx parent,
@@ -1083,6 +1757,7 @@ string DuckLakeMetadataManager::GetInlinedTableQuery(const DuckLakeTableInfo &ta
 
 void DuckLakeMetadataManager::WriteNewTables(DuckLakeSnapshot commit_snapshot,
                                              const vector<DuckLakeTableInfo> &new_tables) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewTables");
 	string column_insert_sql;
 	string table_insert_sql;
 	for (auto &table : new_tables) {
@@ -1101,18 +1776,13 @@ void DuckLakeMetadataManager::WriteNewTables(DuckLakeSnapshot commit_snapshot,
 	if (!table_insert_sql.empty()) {
 		// insert table entries
 		table_insert_sql = "INSERT INTO {METADATA_CATALOG}.ducklake_table VALUES " + table_insert_sql;
-		auto result = transaction.Query(commit_snapshot, table_insert_sql);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write new table to DuckLake: ");
-		}
+		transaction.ExecuteWrite(commit_snapshot, table_insert_sql, "Failed to write new table to DuckLake: ");
 	}
 	if (!column_insert_sql.empty()) {
 		// insert column entries
 		column_insert_sql = "INSERT INTO {METADATA_CATALOG}.ducklake_column VALUES " + column_insert_sql;
-		auto result = transaction.Query(commit_snapshot, column_insert_sql);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write column information to DuckLake: ");
-		}
+		transaction.ExecuteWrite(commit_snapshot, column_insert_sql,
+		                         "Failed to write column information to DuckLake: ");
 	}
 	// write new data-inlining tables (if data-inlining is enabled)
 	WriteNewInlinedTables(commit_snapshot, new_tables);
@@ -1139,18 +1809,14 @@ string DuckLakeMetadataManager::GetInlinedTableQueries(DuckLakeSnapshot commit_s
 
 void DuckLakeMetadataManager::ExecuteInlinedTableQueries(DuckLakeSnapshot commit_snapshot, string &inlined_tables,
                                                          const string &inlined_table_queries) {
+	DuckLakeMetadataOperation metadata_operation("ExecuteInlinedTableQueries");
 	if (inlined_tables.empty()) {
 		return;
 	}
 	inlined_tables = "INSERT INTO {METADATA_CATALOG}.ducklake_inlined_data_tables VALUES " + inlined_tables;
-	auto result = transaction.Query(commit_snapshot, inlined_tables);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new inlined tables table to DuckLake: ");
-	}
-	result = transaction.Query(commit_snapshot, inlined_table_queries);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new inlined tables to DuckLake: ");
-	}
+	transaction.ExecuteWrite(commit_snapshot, inlined_tables, "Failed to write new inlined tables table to DuckLake: ");
+	transaction.ExecuteWrite(commit_snapshot, inlined_table_queries,
+	                         "Failed to write new inlined tables to DuckLake: ");
 }
 
 void DuckLakeMetadataManager::WriteNewInlinedTables(DuckLakeSnapshot commit_snapshot,
@@ -1170,6 +1836,7 @@ void DuckLakeMetadataManager::WriteNewInlinedTables(DuckLakeSnapshot commit_snap
 
 void DuckLakeMetadataManager::WriteDroppedColumns(DuckLakeSnapshot commit_snapshot,
                                                   const vector<DuckLakeDroppedColumn> &dropped_columns) {
+	DuckLakeMetadataOperation metadata_operation("WriteDroppedColumns");
 	if (dropped_columns.empty()) {
 		return;
 	}
@@ -1181,7 +1848,7 @@ void DuckLakeMetadataManager::WriteDroppedColumns(DuckLakeSnapshot commit_snapsh
 		dropped_cols += StringUtil::Format("(%d, %d)", dropped_col.table_id.index, dropped_col.field_id.index);
 	}
 	// overwrite the snapshot for the old columns
-	auto result = transaction.Query(commit_snapshot, StringUtil::Format(R"(
+	auto query = StringUtil::Format(R"(
 WITH dropped_cols(tid, cid) AS (
 VALUES %s
 )
@@ -1190,14 +1857,13 @@ SET end_snapshot = {SNAPSHOT_ID}
 FROM dropped_cols
 WHERE table_id=tid AND column_id=cid
 )",
-	                                                                    dropped_cols));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to drop columns in DuckLake: ");
-	}
+	                                dropped_cols);
+	transaction.ExecuteWrite(commit_snapshot, query, "Failed to drop columns in DuckLake: ");
 }
 
 void DuckLakeMetadataManager::WriteNewColumns(DuckLakeSnapshot commit_snapshot,
                                               const vector<DuckLakeNewColumn> &new_columns) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewColumns");
 	if (new_columns.empty()) {
 		return;
 	}
@@ -1208,14 +1874,12 @@ void DuckLakeMetadataManager::WriteNewColumns(DuckLakeSnapshot commit_snapshot,
 
 	// insert column entries
 	column_insert_sql = "INSERT INTO {METADATA_CATALOG}.ducklake_column VALUES " + column_insert_sql;
-	auto result = transaction.Query(commit_snapshot, column_insert_sql);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write column information to DuckLake: ");
-	}
+	transaction.ExecuteWrite(commit_snapshot, column_insert_sql, "Failed to write column information to DuckLake: ");
 }
 
 void DuckLakeMetadataManager::WriteNewViews(DuckLakeSnapshot commit_snapshot,
                                             const vector<DuckLakeViewInfo> &new_views) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewViews");
 	string view_insert_sql;
 	for (auto &view : new_views) {
 		if (!view_insert_sql.empty()) {
@@ -1230,15 +1894,13 @@ void DuckLakeMetadataManager::WriteNewViews(DuckLakeSnapshot commit_snapshot,
 	if (!view_insert_sql.empty()) {
 		// insert table entries
 		view_insert_sql = "INSERT INTO {METADATA_CATALOG}.ducklake_view VALUES " + view_insert_sql;
-		auto result = transaction.Query(commit_snapshot, view_insert_sql);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write new view to DuckLake: ");
-		}
+		transaction.ExecuteWrite(commit_snapshot, view_insert_sql, "Failed to write new view to DuckLake: ");
 	}
 }
 
 void DuckLakeMetadataManager::WriteNewInlinedData(DuckLakeSnapshot &commit_snapshot,
                                                   const vector<DuckLakeInlinedDataInfo> &new_data) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewInlinedData");
 	if (new_data.empty()) {
 		return;
 	}
@@ -1288,37 +1950,47 @@ WHERE table_id = %d AND schema_version=(
 			ExecuteInlinedTableQueries(commit_snapshot, inlined_tables, inlined_table_queries);
 		}
 
-		// append the data
-		// FIXME: we can do a much faster append than this
-		string values;
+		// append the data - one INSERT per chunk so large batches do not turn into a single huge statement that the
+		// metadata database has to parse in one go
+		auto append_prefix =
+		    StringUtil::Format("INSERT INTO {METADATA_CATALOG}.%s VALUES ", SQLIdentifier(inlined_table_name));
 		idx_t row_id = entry.row_id_start;
 		for (auto &chunk : entry.data->data->Chunks()) {
+			if (chunk.size() == 0) {
+				continue;
+			}
+			// render the chunk column by column - this avoids re-fetching the vector of every column for every row
+			vector<vector<string>> column_values(chunk.ColumnCount());
+			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+				auto &values = column_values[c];
+				values.reserve(chunk.size());
+				for (idx_t r = 0; r < chunk.size(); r++) {
+					values.push_back(DuckLakeUtil::ValueToSQL(context, chunk.data[c].GetValue(r)));
+				}
+			}
+			string append_query = append_prefix;
 			for (idx_t r = 0; r < chunk.size(); r++) {
-				if (!values.empty()) {
-					values += ", ";
+				if (r > 0) {
+					append_query += ", ";
 				}
-				values += "(";
-				values += to_string(row_id);
-				values += ", {SNAPSHOT_ID}, NULL";
-				for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-					values += ", ";
-					values += DuckLakeUtil::ValueToSQL(context, chunk.GetValue(c, r));
+				append_query += "(";
+				append_query += to_string(row_id);
+				append_query += ", {SNAPSHOT_ID}, NULL";
+				for (auto &values : column_values) {
+					append_query += ", ";
+					append_query += values[r];
 				}
-				values += ")";
+				append_query += ")";
 				row_id++;
 			}
-		}
-		string append_query = StringUtil::Format("INSERT INTO {METADATA_CATALOG}.%s VALUES %s",
-		                                         SQLIdentifier(inlined_table_name), values);
-		result = transaction.Query(commit_snapshot, append_query);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write inlined data to DuckLake: ");
+			transaction.ExecuteWrite(commit_snapshot, append_query, "Failed to write inlined data to DuckLake: ");
 		}
 	}
 }
 
 void DuckLakeMetadataManager::WriteNewInlinedDeletes(DuckLakeSnapshot commit_snapshot,
                                                      const vector<DuckLakeDeletedInlinedDataInfo> &new_deletes) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewInlinedDeletes");
 	if (new_deletes.empty()) {
 		return;
 	}
@@ -1332,7 +2004,7 @@ void DuckLakeMetadataManager::WriteNewInlinedDeletes(DuckLakeSnapshot commit_sna
 			row_id_list += StringUtil::Format("(%d)", deleted_id);
 		}
 		// overwrite the snapshot for the old tags
-		auto result = transaction.Query(commit_snapshot, StringUtil::Format(R"(
+		auto query = StringUtil::Format(R"(
 WITH deleted_row_list(deleted_row_id) AS (
 VALUES %s
 )
@@ -1341,10 +2013,8 @@ SET end_snapshot = {SNAPSHOT_ID}
 FROM deleted_row_list
 WHERE row_id=deleted_row_id
 )",
-		                                                                    row_id_list, entry.table_name));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write inlined delete information in DuckLake: ");
-		}
+		                                row_id_list, entry.table_name);
+		transaction.ExecuteWrite(commit_snapshot, query, "Failed to write inlined delete information in DuckLake: ");
 	}
 }
 
@@ -1353,6 +2023,12 @@ shared_ptr<DuckLakeInlinedData> DuckLakeMetadataManager::TransformInlinedData(Qu
 		result.GetErrorObject().Throw("Failed to read inlined data from DuckLake: ");
 	}
 
+	auto inlined_data = make_shared_ptr<DuckLakeInlinedData>();
+	if (result.type == QueryResultType::MATERIALIZED_RESULT) {
+		// the result is already materialized in a ColumnDataCollection - take it over instead of copying the chunks
+		inlined_data->data = result.Cast<MaterializedQueryResult>().TakeCollection();
+		return inlined_data;
+	}
 	auto context = transaction.context.lock();
 	auto data = make_uniq<ColumnDataCollection>(*context, result.types);
 	while (true) {
@@ -1362,7 +2038,6 @@ shared_ptr<DuckLakeInlinedData> DuckLakeMetadataManager::TransformInlinedData(Qu
 		}
 		data->Append(*chunk);
 	}
-	auto inlined_data = make_shared_ptr<DuckLakeInlinedData>();
 	inlined_data->data = std::move(data);
 	return inlined_data;
 }
@@ -1378,47 +2053,84 @@ static string GetProjection(const vector<string> &columns_to_read) {
 	return result;
 }
 
+vector<Value> DuckLakeMetadataManager::ReadInlinedDataAggregates(DuckLakeSnapshot snapshot,
+                                                                 const string &inlined_table_name,
+                                                                 const vector<string> &aggregates) {
+	DuckLakeMetadataOperation metadata_operation("ReadInlinedDataAggregates");
+	auto result = transaction.Query(snapshot, StringUtil::Format(R"(
+SELECT %s
+FROM {METADATA_CATALOG}.%s inlined_data
+WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL);)",
+	                                                             StringUtil::Join(aggregates, ", "),
+	                                                             inlined_table_name));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to compute aggregates over inlined data in DuckLake: ");
+	}
+	vector<Value> values;
+	for (auto &row : *result) {
+		for (idx_t i = 0; i < aggregates.size(); i++) {
+			values.push_back(row.GetValue<Value>(i));
+		}
+	}
+	return values;
+}
+
+static string GetInlinedDataFilter(const string &filter) {
+	if (filter.empty()) {
+		return string();
+	}
+	return " AND (" + filter + ")";
+}
+
 shared_ptr<DuckLakeInlinedData> DuckLakeMetadataManager::ReadInlinedData(DuckLakeSnapshot snapshot,
                                                                          const string &inlined_table_name,
-                                                                         const vector<string> &columns_to_read) {
+                                                                         const vector<string> &columns_to_read,
+                                                                         const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("ReadInlinedData");
 	auto projection = GetProjection(columns_to_read);
 	auto result = transaction.Query(snapshot, StringUtil::Format(R"(
 SELECT %s
 FROM {METADATA_CATALOG}.%s inlined_data
-WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL);)",
-	                                                             projection, inlined_table_name));
+WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)%s;)",
+	                                                             projection, inlined_table_name,
+	                                                             GetInlinedDataFilter(filter)));
 	return TransformInlinedData(*result);
 }
 
 shared_ptr<DuckLakeInlinedData>
 DuckLakeMetadataManager::ReadInlinedDataInsertions(DuckLakeSnapshot start_snapshot, DuckLakeSnapshot end_snapshot,
                                                    const string &inlined_table_name,
-                                                   const vector<string> &columns_to_read) {
+                                                   const vector<string> &columns_to_read, const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("ReadInlinedDataInsertions");
 	auto projection = GetProjection(columns_to_read);
 	auto result =
 	    transaction.Query(end_snapshot, StringUtil::Format(R"(
 SELECT %s
 FROM {METADATA_CATALOG}.%s inlined_data
-WHERE inlined_data.begin_snapshot >= %d AND inlined_data.begin_snapshot <= {SNAPSHOT_ID};)",
-	                                                       projection, inlined_table_name, start_snapshot.snapshot_id));
+WHERE inlined_data.begin_snapshot >= %d AND inlined_data.begin_snapshot <= {SNAPSHOT_ID}%s;)",
+	                                                       projection, inlined_table_name, start_snapshot.snapshot_id,
+	                                                       GetInlinedDataFilter(filter)));
 	return TransformInlinedData(*result);
 }
 
 shared_ptr<DuckLakeInlinedData>
 DuckLakeMetadataManager::ReadInlinedDataDeletions(DuckLakeSnapshot start_snapshot, DuckLakeSnapshot end_snapshot,
                                                   const string &inlined_table_name,
-                                                  const vector<string> &columns_to_read) {
+                                                  const vector<string> &columns_to_read, const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("ReadInlinedDataDeletions");
 	auto projection = GetProjection(columns_to_read);
 	auto result =
 	    transaction.Query(end_snapshot, StringUtil::Format(R"(
 SELECT %s
 FROM {METADATA_CATALOG}.%s inlined_data
-WHERE inlined_data.end_snapshot >= %d AND inlined_data.end_snapshot <= {SNAPSHOT_ID};)",
-	                                                       projection, inlined_table_name, start_snapshot.snapshot_id));
+WHERE inlined_data.end_snapshot >= %d AND inlined_data.end_snapshot <= {SNAPSHOT_ID}%s;)",
+	                                                       projection, inlined_table_name, start_snapshot.snapshot_id,
+	                                                       GetInlinedDataFilter(filter)));
 	return TransformInlinedData(*result);
 }
 
 string DuckLakeMetadataManager::GetPathForSchema(SchemaIndex schema_id) {
+	DuckLakeMetadataOperation metadata_operation("GetPathForSchema");
 	auto result = transaction.Query(StringUtil::Format(R"(
 SELECT path, path_is_relative
 FROM {METADATA_CATALOG}.ducklake_schema
@@ -1435,6 +2147,7 @@ WHERE schema_id = %d;)",
 }
 
 string DuckLakeMetadataManager::GetPathForTable(TableIndex table_id) {
+	DuckLakeMetadataOperation metadata_operation("GetPathForTable");
 	auto result = transaction.Query(StringUtil::Format(R"(
 SELECT s.path, s.path_is_relative, t.path, t.path_is_relative
 FROM {METADATA_CATALOG}.ducklake_schema s
@@ -1557,91 +2270,174 @@ string DuckLakeMetadataManager::FromRelativePath(TableIndex table_id, const Duck
 	return FromRelativePath(path, GetPath(table_id));
 }
 
+//! The default amount of rows from which inserts into a metadata table go through the bulk path
+static constexpr const idx_t DEFAULT_BULK_INSERT_THRESHOLD = 1000;
+
+static string MetadataValueToSQL(const Value &value) {
+	if (value.IsNull()) {
+		return "NULL";
+	}
+	if (value.type().id() == LogicalTypeId::VARCHAR) {
+		return DuckLakeUtil::SQLLiteralToString(StringValue::Get(value));
+	}
+	return value.ToString();
+}
+
+//! Convert a SQL literal (as generated for the stats, e.g. 'abc', 42 or NULL) into a value of the given type
+static Value SQLLiteralToValue(const string &literal, const LogicalType &type) {
+	if (literal == "NULL") {
+		return Value(type);
+	}
+	if (literal.size() >= 2 && literal.front() == '\'' && literal.back() == '\'') {
+		auto str = StringUtil::Replace(literal.substr(1, literal.size() - 2), "''", "'");
+		return Value(std::move(str)).DefaultCastAs(type);
+	}
+	return Value(literal).DefaultCastAs(type);
+}
+
+static Value OptionalBigInt(optional_idx value) {
+	if (!value.IsValid()) {
+		return Value(LogicalType::BIGINT);
+	}
+	return Value::BIGINT(NumericCast<int64_t>(value.GetIndex()));
+}
+
+static Value BigInt(idx_t value) {
+	return Value::BIGINT(NumericCast<int64_t>(value));
+}
+
+void DuckLakeMetadataManager::AppendRows(const string &catalog_name, const string &schema_name,
+                                         const string &table_name, const DuckLakeMetadataInsert &insert) {
+	Appender appender(transaction.GetConnection(), catalog_name, schema_name, table_name);
+	for (auto &row : insert.rows) {
+		appender.BeginRow();
+		for (auto &value : row) {
+			appender.Append(value);
+		}
+		appender.EndRow();
+	}
+	appender.Close();
+}
+
+bool DuckLakeMetadataManager::TryBulkInsert(const DuckLakeMetadataInsert &insert) {
+	auto &catalog = transaction.GetCatalog();
+	auto &metadata_type = catalog.MetadataType();
+	if (!metadata_type.empty() && metadata_type != "duckdb") {
+		// only DuckDB tables can be appended to directly
+		return false;
+	}
+	// the buffered writes have to be executed before the appended rows
+	transaction.FlushWriteBatch();
+	AppendRows(catalog.MetadataDatabaseName(), catalog.MetadataSchemaName(), insert.table_name, insert);
+	return true;
+}
+
+void DuckLakeMetadataManager::InsertRows(DuckLakeSnapshot commit_snapshot, const DuckLakeMetadataInsert &insert,
+                                         const string &error_prefix) {
+	if (insert.rows.empty()) {
+		return;
+	}
+	auto threshold = transaction.GetCatalog().GetConfigOption<idx_t>("metadata_bulk_insert_threshold", {}, {},
+	                                                                  DEFAULT_BULK_INSERT_THRESHOLD);
+	if (threshold > 0 && insert.rows.size() >= threshold) {
+		try {
+			if (TryBulkInsert(insert)) {
+				return;
+			}
+		} catch (std::exception &ex) {
+			ErrorData error(ex);
+			error.Throw(error_prefix);
+		}
+	}
+	string values;
+	for (auto &row : insert.rows) {
+		if (!values.empty()) {
+			values += ", ";
+		}
+		values += "(";
+		for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+			if (col_idx > 0) {
+				values += ", ";
+			}
+			values += MetadataValueToSQL(row[col_idx]);
+		}
+		values += ")";
+	}
+	auto query = StringUtil::Format("INSERT INTO {METADATA_CATALOG}.%s VALUES %s", insert.table_name, values);
+	transaction.ExecuteWrite(commit_snapshot, std::move(query), error_prefix);
+}
+
 void DuckLakeMetadataManager::WriteNewDataFiles(DuckLakeSnapshot commit_snapshot,
                                                 const vector<DuckLakeFileInfo> &new_files) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewDataFiles");
 	if (new_files.empty()) {
 		return;
 	}
-	string data_file_insert_query;
-	string column_stats_insert_query;
-	string partition_insert_query;
+	DuckLakeMetadataInsert data_file_insert(
+	    "ducklake_data_file",
+	    {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	     LogicalType::VARCHAR, LogicalType::BOOLEAN, LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT,
+	     LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	     LogicalType::BIGINT});
+	DuckLakeMetadataInsert column_stats_insert(
+	    "ducklake_file_column_stats",
+	    {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+	     LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BOOLEAN, LogicalType::VARCHAR});
+	DuckLakeMetadataInsert partition_insert(
+	    "ducklake_file_partition_value",
+	    {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::VARCHAR});
 
 	for (auto &file : new_files) {
-		if (!data_file_insert_query.empty()) {
-			data_file_insert_query += ",";
-		}
-		auto row_id = file.row_id_start.IsValid() ? to_string(file.row_id_start.GetIndex()) : "NULL";
-		auto partition_id = file.partition_id.IsValid() ? to_string(file.partition_id.GetIndex()) : "NULL";
 		auto begin_snapshot =
-		    file.begin_snapshot.IsValid() ? to_string(file.begin_snapshot.GetIndex()) : "{SNAPSHOT_ID}";
+		    file.begin_snapshot.IsValid() ? file.begin_snapshot.GetIndex() : commit_snapshot.snapshot_id;
 		auto data_file_index = file.id.index;
 		auto table_id = file.table_id.index;
-		auto encryption_key =
-		    file.encryption_key.empty() ? "NULL" : "'" + Blob::ToBase64(string_t(file.encryption_key)) + "'";
-		string partial_file_info = "NULL";
+		auto encryption_key = file.encryption_key.empty()
+		                          ? Value(LogicalType::VARCHAR)
+		                          : Value(Blob::ToBase64(string_t(file.encryption_key)));
+		Value partial_file_info(LogicalType::VARCHAR);
 		if (!file.partial_file_info.empty()) {
 			if (file.max_partial_file_snapshot.IsValid()) {
 				throw InternalException("Either partial_file_info or max_partial_file_snapshot can be set - not both");
 			}
-			partial_file_info = "'" + PartialFileInfoToString(file.partial_file_info) + "'";
+			partial_file_info = Value(PartialFileInfoToString(file.partial_file_info));
 		} else if (file.max_partial_file_snapshot.IsValid()) {
-			partial_file_info = "'partial_max:" + to_string(file.max_partial_file_snapshot.GetIndex()) + "'";
+			partial_file_info = Value("partial_max:" + to_string(file.max_partial_file_snapshot.GetIndex()));
 		}
-		string footer_size = file.footer_size.IsValid() ? to_string(file.footer_size.GetIndex()) : "NULL";
-		string mapping = file.mapping_id.IsValid() ? to_string(file.mapping_id.index) : "NULL";
+		auto mapping = file.mapping_id.IsValid() ? BigInt(file.mapping_id.index) : Value(LogicalType::BIGINT);
 		auto path = GetRelativePath(file.table_id, file.file_name);
-		data_file_insert_query += StringUtil::Format(
-		    "(%d, %d, %s, NULL, NULL, %s, %s, 'parquet', %d, %d, %s, %s, %s, %s, %s, %s)", data_file_index, table_id,
-		    begin_snapshot, SQLString(path.path), path.path_is_relative ? "true" : "false", file.row_count,
-		    file.file_size_bytes, footer_size, row_id, partition_id, encryption_key, partial_file_info, mapping);
+		data_file_insert.rows.push_back({BigInt(data_file_index), BigInt(table_id), BigInt(begin_snapshot),
+		                                 Value(LogicalType::BIGINT), Value(LogicalType::BIGINT), Value(path.path),
+		                                 Value::BOOLEAN(path.path_is_relative), Value("parquet"),
+		                                 BigInt(file.row_count), BigInt(file.file_size_bytes),
+		                                 OptionalBigInt(file.footer_size), OptionalBigInt(file.row_id_start),
+		                                 OptionalBigInt(file.partition_id), std::move(encryption_key),
+		                                 std::move(partial_file_info), std::move(mapping)});
 		for (auto &column_stats : file.column_stats) {
-			if (!column_stats_insert_query.empty()) {
-				column_stats_insert_query += ",";
-			}
-			auto column_id = column_stats.column_id.index;
-			column_stats_insert_query += StringUtil::Format(
-			    "(%d, %d, %d, %s, %s, %s, %s, %s, %s, %s)", data_file_index, table_id, column_id,
-			    column_stats.column_size_bytes, column_stats.value_count, column_stats.null_count, column_stats.min_val,
-			    column_stats.max_val, column_stats.contains_nan, column_stats.extra_stats);
-		}
-		if (file.partition_id.IsValid() == file.partition_values.empty()) {
-			throw InternalException("File should either not be partitioned, or have partition values");
+			auto &types = column_stats_insert.types;
+			column_stats_insert.rows.push_back(
+			    {BigInt(data_file_index), BigInt(table_id), BigInt(column_stats.column_id.index),
+			     SQLLiteralToValue(column_stats.column_size_bytes, types[3]),
+			     SQLLiteralToValue(column_stats.value_count, types[4]),
+			     SQLLiteralToValue(column_stats.null_count, types[5]), SQLLiteralToValue(column_stats.min_val, types[6]),
+			     SQLLiteralToValue(column_stats.max_val, types[7]),
+			     SQLLiteralToValue(column_stats.contains_nan, types[8]),
+			     SQLLiteralToValue(column_stats.extra_stats, types[9])});
 		}
-		for (auto &part_val : file.partition_values) {
-			if (!partition_insert_query.empty()) {
-				partition_insert_query += ",";
-			}
-			partition_insert_query +=
-			    StringUtil::Format("(%d, %d, %d, %s)", data_file_index, table_id, part_val.partition_column_idx,
-			                       SQLString(part_val.partition_value));
-		}
-	}
-	if (data_file_insert_query.empty()) {
-		throw InternalException("No files found!?");
-	}
-	// insert the data files
-	data_file_insert_query =
-	    StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_data_file VALUES %s", data_file_insert_query);
-	auto result = transaction.Query(commit_snapshot, data_file_insert_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write data file information to DuckLake: ");
-	}
-	// insert the column stats
-	column_stats_insert_query = StringUtil::Format(
-	    "INSERT INTO {METADATA_CATALOG}.ducklake_file_column_stats VALUES %s", column_stats_insert_query);
-	result = transaction.Query(commit_snapshot, column_stats_insert_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write column stats information to DuckLake: ");
-	}
-	if (!partition_insert_query.empty()) {
-		// insert the partition values
-		partition_insert_query = StringUtil::Format(
-		    "INSERT INTO {METADATA_CATALOG}.ducklake_file_partition_value VALUES %s", partition_insert_query);
-		result = transaction.Query(commit_snapshot, partition_insert_query);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to write partition value information to DuckLake: ");
+		if (file.partition_id.IsValid() == file.partition_values.empty()) {
+			throw InternalException("File should either not be partitioned, or have partition values");
+		}
+		for (auto &part_val : file.partition_values) {
+			partition_insert.rows.push_back({BigInt(data_file_index), BigInt(table_id),
+			                                 BigInt(part_val.partition_column_idx), Value(part_val.partition_value)});
 		}
 	}
+	// insert the data files
+	InsertRows(commit_snapshot, data_file_insert, "Failed to write data file information to DuckLake: ");
+	// insert the column stats
+	InsertRows(commit_snapshot, column_stats_insert, "Failed to write column stats information to DuckLake: ");
+	// insert the partition values
+	InsertRows(commit_snapshot, partition_insert, "Failed to write partition value information to DuckLake: ");
 }
 
 void DuckLakeMetadataManager::DropDataFiles(DuckLakeSnapshot commit_snapshot, const set<DataFileIndex> &dropped_files) {
@@ -1655,10 +2451,12 @@ void DuckLakeMetadataManager::DropDeleteFiles(DuckLakeSnapshot commit_snapshot,
 
 void DuckLakeMetadataManager::WriteNewDeleteFiles(DuckLakeSnapshot commit_snapshot,
                                                   const vector<DuckLakeDeleteFileInfo> &new_files) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewDeleteFiles");
 	if (new_files.empty()) {
 		return;
 	}
 	string delete_file_insert_query;
+	string inlined_deletes_insert_query;
 	for (auto &file : new_files) {
 		if (!delete_file_insert_query.empty()) {
 			delete_file_insert_query += ",";
@@ -1666,6 +2464,20 @@ void DuckLakeMetadataManager::WriteNewDeleteFiles(DuckLakeSnapshot commit_snapsh
 		auto delete_file_index = file.id.index;
 		auto table_id = file.table_id.index;
 		auto data_file_index = file.data_file_id.index;
+		if (!file.inlined_deletes.empty()) {
+			// the deletes are inlined - refer to them through the delete file id and write the rows directly
+			auto path = DuckLakeDeleteFile::GetInlinedDeletePath(file.id);
+			delete_file_insert_query +=
+			    StringUtil::Format("(%d, %d, {SNAPSHOT_ID}, NULL, %d, %s, false, 'inlined', %d, 0, 0, NULL)",
+			                       delete_file_index, table_id, data_file_index, SQLString(path), file.delete_count);
+			for (auto &row_id : file.inlined_deletes) {
+				if (!inlined_deletes_insert_query.empty()) {
+					inlined_deletes_insert_query += ",";
+				}
+				inlined_deletes_insert_query += StringUtil::Format("(%d, %d)", delete_file_index, row_id);
+			}
+			continue;
+		}
 		auto encryption_key =
 		    file.encryption_key.empty() ? "NULL" : "'" + Blob::ToBase64(string_t(file.encryption_key)) + "'";
 		auto path = GetRelativePath(file.table_id, file.path);
@@ -1678,13 +2490,46 @@ void DuckLakeMetadataManager::WriteNewDeleteFiles(DuckLakeSnapshot commit_snapsh
 	// insert the data files
 	delete_file_insert_query =
 	    StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_delete_file VALUES %s", delete_file_insert_query);
-	auto result = transaction.Query(commit_snapshot, delete_file_insert_query);
+	transaction.ExecuteWrite(commit_snapshot, delete_file_insert_query,
+	                         "Failed to write delete file information to DuckLake: ");
+	if (inlined_deletes_insert_query.empty()) {
+		return;
+	}
+	// clients that do not know inlined delete files would read them as Parquet files - move the DuckLake to a version
+	// that they refuse to attach
+	transaction.ExecuteWrite(GetExtendedVersionQuery(), "Failed to update the DuckLake version: ");
+	// the inlined deletes table is created on first use
+	transaction.ExecuteWrite(commit_snapshot,
+	                         "CREATE TABLE IF NOT EXISTS {METADATA_CATALOG}.ducklake_inlined_deletes(delete_file_id "
+	                         "BIGINT, row_id BIGINT);",
+	                         "Failed to create inlined deletes table in DuckLake: ");
+	inlined_deletes_insert_query = StringUtil::Format(
+	    "INSERT INTO {METADATA_CATALOG}.ducklake_inlined_deletes VALUES %s", inlined_deletes_insert_query);
+	transaction.ExecuteWrite(commit_snapshot, inlined_deletes_insert_query,
+	                         "Failed to write inlined deletes to DuckLake: ");
+}
+
+vector<idx_t> DuckLakeMetadataManager::ReadInlinedDeleteFile(DataFileIndex delete_file_id) {
+	DuckLakeMetadataOperation metadata_operation("ReadInlinedDeleteFile");
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT row_id
+FROM {METADATA_CATALOG}.ducklake_inlined_deletes
+WHERE delete_file_id = %d
+ORDER BY row_id
+)",
+	                                                   delete_file_id.index));
 	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write delete file information to DuckLake: ");
+		result->GetErrorObject().Throw("Failed to read inlined deletes from DuckLake: ");
+	}
+	vector<idx_t> deleted_rows;
+	for (auto &row : *result) {
+		deleted_rows.push_back(row.GetValue<idx_t>(0));
 	}
+	return deleted_rows;
 }
 
 vector<DuckLakeColumnMappingInfo> DuckLakeMetadataManager::GetColumnMappings(optional_idx start_from) {
+	DuckLakeMetadataOperation metadata_operation("GetColumnMappings");
 	string filter;
 	if (start_from.IsValid()) {
 		filter = "WHERE mapping_id >= " + to_string(start_from.GetIndex());
@@ -1723,48 +2568,33 @@ ORDER BY mapping_id, parent_column NULLS FIRST
 
 void DuckLakeMetadataManager::WriteNewColumnMappings(DuckLakeSnapshot commit_snapshot,
                                                      const vector<DuckLakeColumnMappingInfo> &new_column_mappings) {
-	string column_mapping_insert_query;
-	string name_map_insert_query;
+	DuckLakeMetadataOperation metadata_operation("WriteNewColumnMappings");
+	DuckLakeMetadataInsert column_mapping_insert("ducklake_column_mapping",
+	                                             {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::VARCHAR});
+	DuckLakeMetadataInsert name_map_insert("ducklake_name_mapping",
+	                                       {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::VARCHAR,
+	                                        LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BOOLEAN});
 	for (auto &column_mapping : new_column_mappings) {
-		if (!column_mapping_insert_query.empty()) {
-			column_mapping_insert_query += ", ";
-		}
-		column_mapping_insert_query +=
-		    StringUtil::Format("(%d, %d, %s)", column_mapping.mapping_id.index, column_mapping.table_id.index,
-		                       SQLString(column_mapping.map_type));
+		column_mapping_insert.rows.push_back({BigInt(column_mapping.mapping_id.index),
+		                                      BigInt(column_mapping.table_id.index), Value(column_mapping.map_type)});
 		for (auto &name_map_column : column_mapping.map_columns) {
-			if (!name_map_insert_query.empty()) {
-				name_map_insert_query += ", ";
-			}
-			string parent_column =
-			    name_map_column.parent_column.IsValid() ? to_string(name_map_column.parent_column.GetIndex()) : "NULL";
-			string is_partition = name_map_column.hive_partition ? "true" : "false";
-			name_map_insert_query +=
-			    StringUtil::Format("(%d, %d, %s, %d, %s, %s)", column_mapping.mapping_id.index,
-			                       name_map_column.column_id, SQLString(name_map_column.source_name),
-			                       name_map_column.target_field_id.index, parent_column, is_partition);
-		}
-	}
-	column_mapping_insert_query =
-	    "INSERT INTO {METADATA_CATALOG}.ducklake_column_mapping VALUES " + column_mapping_insert_query;
-	auto result = transaction.Query(commit_snapshot, column_mapping_insert_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new column mapping information to DuckLake: ");
-	}
-	name_map_insert_query = "INSERT INTO {METADATA_CATALOG}.ducklake_name_mapping VALUES " + name_map_insert_query;
-	result = transaction.Query(commit_snapshot, name_map_insert_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new column mapping information to DuckLake: ");
+			name_map_insert.rows.push_back({BigInt(column_mapping.mapping_id.index), BigInt(name_map_column.column_id),
+			                                Value(name_map_column.source_name),
+			                                BigInt(name_map_column.target_field_id.index),
+			                                OptionalBigInt(name_map_column.parent_column),
+			                                Value::BOOLEAN(name_map_column.hive_partition)});
+		}
 	}
+	InsertRows(commit_snapshot, column_mapping_insert, "Failed to write new column mapping information to DuckLake: ");
+	InsertRows(commit_snapshot, name_map_insert, "Failed to write new column mapping information to DuckLake: ");
 }
 
 void DuckLakeMetadataManager::InsertSnapshot(const DuckLakeSnapshot commit_snapshot) {
-	auto result = transaction.Query(
+	DuckLakeMetadataOperation metadata_operation("InsertSnapshot");
+	transaction.ExecuteWrite(
 	    commit_snapshot,
-	    R"(INSERT INTO {METADATA_CATALOG}.ducklake_snapshot VALUES ({SNAPSHOT_ID}, NOW(), {SCHEMA_VERSION}, {NEXT_CATALOG_ID}, {NEXT_FILE_ID});)");
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new snapshot to DuckLake: ");
-	}
+	    R"(INSERT INTO {METADATA_CATALOG}.ducklake_snapshot VALUES ({SNAPSHOT_ID}, NOW(), {SCHEMA_VERSION}, {NEXT_CATALOG_ID}, {NEXT_FILE_ID});)",
+	    "Failed to write new snapshot to DuckLake: ");
 }
 
 static string SQLStringOrNull(const string &str) {
@@ -1777,18 +2607,35 @@ static string SQLStringOrNull(const string &str) {
 void DuckLakeMetadataManager::WriteSnapshotChanges(DuckLakeSnapshot commit_snapshot,
                                                    const SnapshotChangeInfo &change_info,
                                                    const DuckLakeSnapshotCommit &commit_info) {
+	DuckLakeMetadataOperation metadata_operation("WriteSnapshotChanges");
 	// insert the snapshot changes
 	auto query = StringUtil::Format(
 	    R"(INSERT INTO {METADATA_CATALOG}.ducklake_snapshot_changes VALUES ({SNAPSHOT_ID}, %s, %s, %s, %s);)",
 	    SQLStringOrNull(change_info.changes_made), commit_info.author.ToSQLString(),
 	    commit_info.commit_message.ToSQLString(), commit_info.commit_extra_info.ToSQLString());
-	auto result = transaction.Query(commit_snapshot, query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to write new snapshot to DuckLake:");
+	transaction.ExecuteWrite(commit_snapshot, query, "Failed to write new snapshot to DuckLake:");
+	if (!transaction.GetCatalog().HasSnapshotChangeIndex()) {
+		return;
+	}
+	// write every change to the snapshot change index - so conflict checks only have to read the relevant changes
+	DuckLakeMetadataInsert change_insert(
+	    "ducklake_snapshot_change_index",
+	    {LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::VARCHAR});
+	auto snapshot_id = BigInt(commit_snapshot.snapshot_id);
+	for (auto &change : SnapshotChangeInformation::SplitChangesMade(change_info.changes_made)) {
+		auto object_id = change.object_id.IsValid() ? BigInt(change.object_id.GetIndex()) : Value(LogicalType::BIGINT);
+		change_insert.rows.push_back({snapshot_id, Value(change.change_type), object_id, Value(change.change_value)});
 	}
+	if (change_insert.rows.empty()) {
+		// snapshots without changes are recorded as well - the index has to cover every snapshot
+		change_insert.rows.push_back(
+		    {snapshot_id, Value(LogicalType::VARCHAR), Value(LogicalType::BIGINT), Value(LogicalType::VARCHAR)});
+	}
+	InsertRows(commit_snapshot, change_insert, "Failed to write snapshot change index to DuckLake: ");
 }
 
 SnapshotChangeInfo DuckLakeMetadataManager::GetChangesMadeAfterSnapshot(DuckLakeSnapshot start_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetChangesMadeAfterSnapshot");
 	// get all changes made to the system after the snapshot was started
 	auto result = transaction.Query(start_snapshot, R"(
 	SELECT COALESCE(STRING_AGG(changes_made), '')
@@ -1807,18 +2654,102 @@ SnapshotChangeInfo DuckLakeMetadataManager::GetChangesMadeAfterSnapshot(DuckLake
 	return change_info;
 }
 
+unique_ptr<SnapshotChangeInfo>
+DuckLakeMetadataManager::GetIndexedChangesMadeAfterSnapshot(DuckLakeSnapshot start_snapshot,
+                                                            const set<idx_t> &object_ids) {
+	DuckLakeMetadataOperation metadata_operation("GetIndexedChangesMadeAfterSnapshot");
+	string object_filter = "object_id IS NULL";
+	if (!object_ids.empty()) {
+		string object_id_list;
+		for (auto &object_id : object_ids) {
+			if (!object_id_list.empty()) {
+				object_id_list += ", ";
+			}
+			object_id_list += to_string(object_id);
+		}
+		object_filter += StringUtil::Format(" OR object_id IN (%s)", object_id_list);
+	}
+	// the last row holds the amount of snapshots made after the snapshot that are not covered by the index
+	// (e.g. because they were committed by a client that does not write the index)
+	auto query = StringUtil::Format(R"(
+SELECT change_type, change_value, NULL::BIGINT
+FROM {METADATA_CATALOG}.ducklake_snapshot_change_index
+WHERE snapshot_id > {SNAPSHOT_ID} AND change_type IS NOT NULL AND (%s)
+UNION ALL
+SELECT NULL::VARCHAR, NULL::VARCHAR,
+       (SELECT COUNT(*) FROM {METADATA_CATALOG}.ducklake_snapshot WHERE snapshot_id > {SNAPSHOT_ID}) -
+       (SELECT COUNT(DISTINCT snapshot_id) FROM {METADATA_CATALOG}.ducklake_snapshot_change_index
+        WHERE snapshot_id > {SNAPSHOT_ID})
+)",
+	                                object_filter);
+	auto result = transaction.Query(start_snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw(
+		    "Failed to commit DuckLake transaction - failed to get snapshot changes for conflict resolution:");
+	}
+	auto change_info = make_uniq<SnapshotChangeInfo>();
+	for (auto &row : *result) {
+		if (!row.IsNull(2)) {
+			if (row.GetValue<int64_t>(2) != 0) {
+				// not all snapshots are covered by the index
+				return nullptr;
+			}
+			continue;
+		}
+		if (!change_info->changes_made.empty()) {
+			change_info->changes_made += ",";
+		}
+		change_info->changes_made += row.GetValue<string>(0) + ":" + row.GetValue<string>(1);
+	}
+	return change_info;
+}
+
+unique_ptr<SnapshotChangeInfo>
+DuckLakeMetadataManager::GetChangesMadeBetweenSnapshots(DuckLakeSnapshot start_snapshot, DuckLakeSnapshot end_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetChangesMadeBetweenSnapshots");
+	// get all changes made in the range (start_snapshot, end_snapshot]
+	// we also count the snapshots in the range - if any of them have been expired their changes are lost
+	auto query = StringUtil::Format(R"(
+SELECT COUNT(*), COALESCE(STRING_AGG(changes_made) FILTER (WHERE snapshot_id > %d), '')
+FROM {METADATA_CATALOG}.ducklake_snapshot
+LEFT JOIN {METADATA_CATALOG}.ducklake_snapshot_changes USING (snapshot_id)
+WHERE snapshot_id >= %d AND snapshot_id <= {SNAPSHOT_ID}
+)",
+	                                start_snapshot.snapshot_id, start_snapshot.snapshot_id);
+	auto result = transaction.Query(end_snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get snapshot changes from DuckLake: ");
+	}
+	unique_ptr<SnapshotChangeInfo> change_info;
+	for (auto &row : *result) {
+		auto snapshot_count = row.GetValue<idx_t>(0);
+		if (snapshot_count != end_snapshot.snapshot_id - start_snapshot.snapshot_id + 1) {
+			// snapshots in the range have been expired
+			return nullptr;
+		}
+		change_info = make_uniq<SnapshotChangeInfo>();
+		change_info->changes_made = row.GetValue<string>(1);
+	}
+	return change_info;
+}
+
 SnapshotDeletedFromFiles
 DuckLakeMetadataManager::GetFilesDeletedOrDroppedAfterSnapshot(DuckLakeSnapshot start_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetFilesDeletedOrDroppedAfterSnapshot");
 	// get all changes made to the system after the snapshot was started
-	auto result = transaction.Query(start_snapshot, R"(
+	auto delete_file_table = GetFileTable("ducklake_delete_file", start_snapshot.snapshot_id + 1);
+	auto data_file_table = GetFileTable("ducklake_data_file", start_snapshot.snapshot_id + 1);
+	auto query = StringUtil::Format(R"(
 	SELECT data_file_id
-	FROM {METADATA_CATALOG}.ducklake_delete_file
+	FROM %s
 	WHERE begin_snapshot > {SNAPSHOT_ID}
 	UNION ALL
 	SELECT data_file_id
-	FROM {METADATA_CATALOG}.ducklake_data_file
+	FROM %s
 	WHERE end_snapshot IS NOT NULL AND end_snapshot > {SNAPSHOT_ID}
-	)");
+	)",
+	                                delete_file_table, data_file_table);
+	auto result = transaction.Query(start_snapshot, query);
 	if (result->HasError()) {
 		result->GetErrorObject().Throw(
 		    "Failed to commit DuckLake transaction - failed to get files with deletions for conflict resolution:");
@@ -1831,6 +2762,36 @@ DuckLakeMetadataManager::GetFilesDeletedOrDroppedAfterSnapshot(DuckLakeSnapshot
 	return change_info;
 }
 
+set<DataFileIndex> DuckLakeMetadataManager::GetRemovedDataFiles(const set<DataFileIndex> &file_ids) {
+	DuckLakeMetadataOperation metadata_operation("GetRemovedDataFiles");
+	set<DataFileIndex> removed_files;
+	if (file_ids.empty()) {
+		return removed_files;
+	}
+	string file_id_list;
+	for (auto &file_id : file_ids) {
+		if (!file_id_list.empty()) {
+			file_id_list += ", ";
+		}
+		file_id_list += to_string(file_id.index);
+	}
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT data_file_id
+FROM {METADATA_CATALOG}.ducklake_data_file
+WHERE data_file_id IN (%s)
+)",
+	                                                   file_id_list));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw(
+		    "Failed to commit DuckLake transaction - failed to get removed files for conflict resolution:");
+	}
+	removed_files = file_ids;
+	for (auto &row : *result) {
+		removed_files.erase(DataFileIndex(row.GetValue<idx_t>(0)));
+	}
+	return removed_files;
+}
+
 static unique_ptr<DuckLakeSnapshot> TryGetSnapshotInternal(QueryResult &result) {
 	unique_ptr<DuckLakeSnapshot> snapshot;
 	for (auto &row : result) {
@@ -1851,7 +2812,8 @@ string DuckLakeMetadataManager::GetLatestSnapshotQuery() const {
 }
 
 unique_ptr<DuckLakeSnapshot> DuckLakeMetadataManager::GetSnapshot() {
-	auto result = transaction.Query(GetLatestSnapshotQuery());
+	DuckLakeMetadataOperation metadata_operation("GetSnapshot");
+	auto result = transaction.PreparedQuery(GetLatestSnapshotQuery());
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to query most recent snapshot for DuckLake: ");
 	}
@@ -1862,7 +2824,28 @@ unique_ptr<DuckLakeSnapshot> DuckLakeMetadataManager::GetSnapshot() {
 	return snapshot;
 }
 
+Value DuckLakeMetadataManager::GetSnapshotTime(DuckLakeSnapshot snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetSnapshotTime");
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT snapshot_time
+FROM {METADATA_CATALOG}.ducklake_snapshot
+WHERE snapshot_id = %llu AND schema_version = %llu AND next_catalog_id = %llu AND next_file_id = %llu;)",
+	                                                   snapshot.snapshot_id, snapshot.schema_version,
+	                                                   snapshot.next_catalog_id, snapshot.next_file_id));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to query snapshot for DuckLake: ");
+	}
+	for (auto &row : *result) {
+		if (row.IsNull(0)) {
+			break;
+		}
+		return Value::TIMESTAMPTZ(row.GetValue<timestamp_tz_t>(0));
+	}
+	return Value(LogicalType::TIMESTAMP_TZ);
+}
+
 unique_ptr<DuckLakeSnapshot> DuckLakeMetadataManager::GetSnapshot(BoundAtClause &at_clause, SnapshotBound bound) {
+	DuckLakeMetadataOperation metadata_operation("GetSnapshotAtClause");
 	auto &unit = at_clause.Unit();
 	auto &val = at_clause.GetValue();
 	unique_ptr<QueryResult> result;
@@ -1935,6 +2918,7 @@ GetNewPartitions(const vector<DuckLakePartitionInfo> &old_partitions,
 
 void DuckLakeMetadataManager::WriteNewPartitionKeys(DuckLakeSnapshot commit_snapshot,
                                                     const vector<DuckLakePartitionInfo> &new_partitions) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewPartitionKeys");
 	if (new_partitions.empty()) {
 		return;
 	}
@@ -1979,29 +2963,24 @@ UPDATE {METADATA_CATALOG}.ducklake_partition_info
 SET end_snapshot = {SNAPSHOT_ID}
 WHERE table_id IN (%s) AND end_snapshot IS NULL)",
 	                                                 old_partition_table_ids);
-	auto result = transaction.Query(commit_snapshot, update_partition_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to update old partition information in DuckLake: ");
-	}
+	transaction.ExecuteWrite(commit_snapshot, update_partition_query,
+	                         "Failed to update old partition information in DuckLake: ");
 	if (!new_partition_values.empty()) {
 		new_partition_values = "INSERT INTO {METADATA_CATALOG}.ducklake_partition_info VALUES " + new_partition_values;
-		auto result = transaction.Query(commit_snapshot, new_partition_values);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to insert new partition information in DuckLake: ");
-		}
+		transaction.ExecuteWrite(commit_snapshot, new_partition_values,
+		                         "Failed to insert new partition information in DuckLake: ");
 	}
 	if (!insert_partition_cols.empty()) {
 		insert_partition_cols =
 		    "INSERT INTO {METADATA_CATALOG}.ducklake_partition_column VALUES " + insert_partition_cols;
 
-		auto result = transaction.Query(commit_snapshot, insert_partition_cols);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to insert new partition information in DuckLake:");
-		}
+		transaction.ExecuteWrite(commit_snapshot, insert_partition_cols,
+		                         "Failed to insert new partition information in DuckLake:");
 	}
 }
 
 void DuckLakeMetadataManager::WriteNewTags(DuckLakeSnapshot commit_snapshot, const vector<DuckLakeTagInfo> &new_tags) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewTags");
 	if (new_tags.empty()) {
 		return;
 	}
@@ -2015,7 +2994,7 @@ void DuckLakeMetadataManager::WriteNewTags(DuckLakeSnapshot commit_snapshot, con
 		tags_list += StringUtil::Format("(%d, %s)", tag.id, SQLString(tag.key));
 	}
 	// overwrite the snapshot for the old tags
-	auto result = transaction.Query(commit_snapshot, StringUtil::Format(R"(
+	auto query = StringUtil::Format(R"(
 WITH overwritten_tags(tid, key) AS (
 VALUES %s
 )
@@ -2024,10 +3003,8 @@ SET end_snapshot = {SNAPSHOT_ID}
 FROM overwritten_tags
 WHERE object_id=tid
 )",
-	                                                                    tags_list));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to update tag information in DuckLake: ");
-	}
+	                                tags_list);
+	transaction.ExecuteWrite(commit_snapshot, query, "Failed to update tag information in DuckLake: ");
 	// now insert the new tags
 	string new_tag_query;
 	for (auto &tag : new_tags) {
@@ -2040,14 +3017,12 @@ WHERE object_id=tid
 
 	new_tag_query = "INSERT INTO {METADATA_CATALOG}.ducklake_tag VALUES " + new_tag_query;
 
-	result = transaction.Query(commit_snapshot, new_tag_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to insert new tag information in DuckLake:");
-	}
+	transaction.ExecuteWrite(commit_snapshot, new_tag_query, "Failed to insert new tag information in DuckLake:");
 }
 
 void DuckLakeMetadataManager::WriteNewColumnTags(DuckLakeSnapshot commit_snapshot,
                                                  const vector<DuckLakeColumnTagInfo> &new_tags) {
+	DuckLakeMetadataOperation metadata_operation("WriteNewColumnTags");
 	if (new_tags.empty()) {
 		return;
 	}
@@ -2061,7 +3036,7 @@ void DuckLakeMetadataManager::WriteNewColumnTags(DuckLakeSnapshot commit_snapsho
 		tags_list += StringUtil::Format("(%d, %d, %s)", tag.table_id.index, tag.field_index.index, SQLString(tag.key));
 	}
 	// overwrite the snapshot for the old tags
-	auto result = transaction.Query(commit_snapshot, StringUtil::Format(R"(
+	auto query = StringUtil::Format(R"(
 WITH overwritten_tags(tid, cid, key) AS (
 VALUES %s
 )
@@ -2070,10 +3045,8 @@ SET end_snapshot = {SNAPSHOT_ID}
 FROM overwritten_tags
 WHERE table_id=tid AND column_id=cid
 )",
-	                                                                    tags_list));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to update column tag information in DuckLake: ");
-	}
+	                                tags_list);
+	transaction.ExecuteWrite(commit_snapshot, query, "Failed to update column tag information in DuckLake: ");
 	// now insert the new tags
 	string new_tag_query;
 	for (auto &tag : new_tags) {
@@ -2086,13 +3059,12 @@ WHERE table_id=tid AND column_id=cid
 
 	new_tag_query = "INSERT INTO {METADATA_CATALOG}.ducklake_column_tag VALUES " + new_tag_query;
 
-	result = transaction.Query(commit_snapshot, new_tag_query);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to insert new column tag information in DuckLake:");
-	}
+	transaction.ExecuteWrite(commit_snapshot, new_tag_query,
+	                         "Failed to insert new column tag information in DuckLake:");
 }
 
 void DuckLakeMetadataManager::UpdateGlobalTableStats(const DuckLakeGlobalStatsInfo &stats) {
+	DuckLakeMetadataOperation metadata_operation("UpdateGlobalTableStats");
 	string column_stats_values;
 	for (auto &col_stats : stats.column_stats) {
 		if (!column_stats_values.empty()) {
@@ -2121,29 +3093,23 @@ void DuckLakeMetadataManager::UpdateGlobalTableStats(const DuckLakeGlobalStatsIn
 
 	if (!stats.initialized) {
 		// stats have not been initialized yet - insert them
-		auto result = transaction.Query(
+		transaction.ExecuteWrite(
 		    StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_table_stats VALUES (%d, %d, %d, %d);",
-		                       stats.table_id.index, stats.record_count, stats.next_row_id, stats.table_size_bytes));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to insert stats information in DuckLake: ");
-		}
+		                       stats.table_id.index, stats.record_count, stats.next_row_id, stats.table_size_bytes),
+		    "Failed to insert stats information in DuckLake: ");
 
-		result = transaction.Query(StringUtil::Format(
-		    "INSERT INTO {METADATA_CATALOG}.ducklake_table_column_stats VALUES %s;", column_stats_values));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to insert stats information in DuckLake: ");
-		}
+		auto column_stats_query = StringUtil::Format(
+		    "INSERT INTO {METADATA_CATALOG}.ducklake_table_column_stats VALUES %s;", column_stats_values);
+		transaction.ExecuteWrite(column_stats_query, "Failed to insert stats information in DuckLake: ");
 		return;
 	}
 	// stats have been initialized - update them
-	auto result = transaction.Query(
+	transaction.ExecuteWrite(
 	    StringUtil::Format("UPDATE {METADATA_CATALOG}.ducklake_table_stats SET record_count=%d, file_size_bytes=%d, "
 	                       "next_row_id=%d WHERE table_id=%d;",
-	                       stats.record_count, stats.table_size_bytes, stats.next_row_id, stats.table_id.index));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to update stats information in DuckLake: ");
-	}
-	result = transaction.Query(StringUtil::Format(R"(
+	                       stats.record_count, stats.table_size_bytes, stats.next_row_id, stats.table_id.index),
+	    "Failed to update stats information in DuckLake: ");
+	auto query = StringUtil::Format(R"(
 WITH new_values(tid, cid, new_contains_null, new_contains_nan, new_min, new_max, new_extra_stats) AS (
 VALUES %s
 )
@@ -2152,10 +3118,8 @@ SET contains_null=new_contains_null, contains_nan=new_contains_nan, min_value=ne
 FROM new_values
 WHERE table_id=tid AND column_id=cid
 )",
-	                                              column_stats_values));
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to update stats information in DuckLake: ");
-	}
+	                                column_stats_values);
+	transaction.ExecuteWrite(query, "Failed to update stats information in DuckLake: ");
 }
 
 template <class T>
@@ -2164,7 +3128,8 @@ static timestamp_tz_t GetTimestampTZFromRow(ClientContext &context, const T &row
 	return val.CastAs(context, LogicalType::TIMESTAMP_TZ).template GetValue<timestamp_tz_t>();
 }
 
-vector<DuckLakeSnapshotInfo> DuckLakeMetadataManager::GetAllSnapshots(const string &filter) {
+vector<DuckLakeSnapshotInfo> DuckLakeMetadataManager::GetAllSnapshots(const string &filter, optional_idx limit) {
+	DuckLakeMetadataOperation metadata_operation("GetAllSnapshots");
 
 	auto res = transaction.Query(StringUtil::Format(R"(
 SELECT snapshot_id, snapshot_time, schema_version, changes_made, author, commit_message, commit_extra_info
@@ -2172,8 +3137,10 @@ FROM {METADATA_CATALOG}.ducklake_snapshot
 LEFT JOIN {METADATA_CATALOG}.ducklake_snapshot_changes USING (snapshot_id)
 %s %s
 ORDER BY snapshot_id
+%s
 )",
-	                                                filter.empty() ? "" : "WHERE", filter));
+	                                                filter.empty() ? "" : "WHERE", filter,
+	                                                limit.IsValid() ? "LIMIT " + to_string(limit.GetIndex()) : ""));
 	if (res->HasError()) {
 		res->GetErrorObject().Throw("Failed to get snapshot information from DuckLake: ");
 	}
@@ -2195,6 +3162,7 @@ ORDER BY snapshot_id
 }
 
 vector<DuckLakeFileForCleanup> DuckLakeMetadataManager::GetOldFilesForCleanup(const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("GetOldFilesForCleanup");
 	auto query = R"(
 SELECT data_file_id, path, path_is_relative, schedule_start
 FROM {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion
@@ -2218,10 +3186,35 @@ FROM {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion
 	return result;
 }
 vector<DuckLakeFileForCleanup> DuckLakeMetadataManager::GetOrphanFilesForCleanup(const string &filter,
-                                                                                 const string &separator) {
+                                                                                 const string &separator,
+                                                                                 const vector<string> &directories) {
+	DuckLakeMetadataOperation metadata_operation("GetOrphanFilesForCleanup");
+	// by default the entire data path is examined
+	string globs = "{DATA_PATH} || '**'";
+	string directory_filter;
+	if (!directories.empty()) {
+		// only list the given directories - and only compare against the known files within these directories
+		globs.clear();
+		for (auto &directory : directories) {
+			if (!globs.empty()) {
+				globs += ", ";
+				directory_filter += " OR ";
+			}
+			globs += SQLString(directory + "**");
+			directory_filter += StringUtil::Format("starts_with(full_path, %s)", SQLString(directory));
+		}
+		globs = "[" + globs + "]";
+		directory_filter = "WHERE " + directory_filter;
+	}
+	// the files of archived rows are still needed for time travel - another connection might have archived files since
+	// we attached, so the archive snapshot is reloaded
+	LoadArchiveSnapshot();
+	// the manifests of a table are not listed individually - all files in the directory of its current manifest list
+	// are known
 	auto query = R"(SELECT filename
-FROM read_blob({DATA_PATH} || '**')
+FROM read_blob({GLOBS})
 WHERE filename NOT IN (
+SELECT full_path FROM (
 SELECT REPLACE(
            CASE
                WHEN NOT file_relative THEN file_path
@@ -2239,10 +3232,10 @@ SELECT REPLACE(
 FROM
   (SELECT s.path AS schema_path, t.path AS table_path, file_path, s.path_is_relative AS schema_relative, t.path_is_relative AS table_relative, file_relative FROM (
     SELECT f.path AS file_path, f.path_is_relative AS file_relative, table_id
-    FROM {METADATA_CATALOG}.ducklake_data_file f
+    FROM {DATA_FILE_TABLE} f
     UNION ALL
     SELECT f.path AS file_path, f.path_is_relative AS file_relative, table_id
-    FROM {METADATA_CATALOG}.ducklake_delete_file f
+    FROM {DELETE_FILE_TABLE} f
   ) AS f
    JOIN {METADATA_CATALOG}.ducklake_table t ON f.table_id = t.table_id
    JOIN {METADATA_CATALOG}.ducklake_schema s ON t.schema_id = s.schema_id) AS r
@@ -2256,9 +3249,32 @@ SELECT REPLACE(
            '{SEPARATOR}'
 ) AS full_path
 FROM {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion f
+) {DIRECTORY_FILTER}
+)
+AND NOT EXISTS (
+SELECT 1 FROM (
+SELECT REPLACE(
+           CASE
+               WHEN NOT t.path_is_relative THEN t.path || m.value
+               WHEN NOT s.path_is_relative THEN s.path || t.path || m.value
+               ELSE {DATA_PATH} || s.path || t.path || m.value
+           END,
+           '/',
+           '{SEPARATOR}'
+       ) AS manifest_directory
+FROM {METADATA_CATALOG}.ducklake_metadata m
+JOIN {METADATA_CATALOG}.ducklake_table t ON m.scope_id = t.table_id
+JOIN {METADATA_CATALOG}.ducklake_schema s ON t.schema_id = s.schema_id
+WHERE m.scope = 'table' AND m.key = 'manifest_list'
+) manifests
+WHERE starts_with(filename, manifest_directory)
 )
 )" + filter;
 	query = StringUtil::Replace(query, "{SEPARATOR}", separator);
+	query = StringUtil::Replace(query, "{GLOBS}", globs);
+	query = StringUtil::Replace(query, "{DIRECTORY_FILTER}", directory_filter);
+	query = StringUtil::Replace(query, "{DATA_FILE_TABLE}", GetFileTable("ducklake_data_file", 0));
+	query = StringUtil::Replace(query, "{DELETE_FILE_TABLE}", GetFileTable("ducklake_delete_file", 0));
 	auto res = transaction.Query(query);
 	if (res->HasError()) {
 		res->GetErrorObject().Throw("Failed to get files scheduled for deletion from DuckLake: ");
@@ -2273,19 +3289,64 @@ FROM {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion f
 	return result;
 }
 
+vector<DuckLakeTableDirectory> DuckLakeMetadataManager::GetTableDirectories(optional_idx changed_since_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("GetTableDirectories");
+	string query;
+	if (changed_since_snapshot.IsValid()) {
+		LoadArchiveSnapshot();
+		auto changed_since = changed_since_snapshot.GetIndex();
+		query = StringUtil::Format(R"(
+SELECT DISTINCT table_id FROM (
+	SELECT table_id FROM {METADATA_CATALOG}.ducklake_table WHERE begin_snapshot >= %d OR end_snapshot >= %d
+	UNION ALL
+	SELECT table_id FROM %s WHERE begin_snapshot >= %d OR end_snapshot >= %d
+	UNION ALL
+	SELECT table_id FROM %s WHERE begin_snapshot >= %d OR end_snapshot >= %d
+)
+ORDER BY table_id
+)",
+		                           changed_since, changed_since, GetFileTable("ducklake_data_file", changed_since),
+		                           changed_since, changed_since, GetFileTable("ducklake_delete_file", changed_since),
+		                           changed_since, changed_since);
+	} else {
+		query = R"(
+SELECT DISTINCT table_id
+FROM {METADATA_CATALOG}.ducklake_table
+ORDER BY table_id
+)";
+	}
+	auto res = transaction.Query(query);
+	if (res->HasError()) {
+		res->GetErrorObject().Throw("Failed to get table directories from DuckLake: ");
+	}
+	vector<TableIndex> table_ids;
+	for (auto &row : *res) {
+		table_ids.emplace_back(row.GetValue<idx_t>(0));
+	}
+	vector<DuckLakeTableDirectory> result;
+	for (auto &table_id : table_ids) {
+		DuckLakeTableDirectory directory;
+		directory.table_id = table_id;
+		directory.path = GetPath(table_id);
+		result.push_back(std::move(directory));
+	}
+	return result;
+}
+
 vector<DuckLakeFileForCleanup> DuckLakeMetadataManager::GetFilesForCleanup(const string &filter, CleanupType type,
                                                                            const string &separator) {
 	switch (type) {
 	case CleanupType::OLD_FILES:
 		return GetOldFilesForCleanup(filter);
 	case CleanupType::ORPHANED_FILES:
-		return GetOrphanFilesForCleanup(filter, separator);
+		return GetOrphanFilesForCleanup(filter, separator, vector<string>());
 	default:
 		throw InternalException("CleanupType in DuckLakeMetadataManager::GetFilesForCleanup is not valid");
 	}
 }
 
 void DuckLakeMetadataManager::RemoveFilesScheduledForCleanup(const vector<DuckLakeFileForCleanup> &cleaned_up_files) {
+	DuckLakeMetadataOperation metadata_operation("RemoveFilesScheduledForCleanup");
 	string deleted_file_ids;
 	for (auto &file : cleaned_up_files) {
 		if (!deleted_file_ids.empty()) {
@@ -2304,12 +3365,14 @@ WHERE data_file_id IN (%s);
 }
 
 idx_t DuckLakeMetadataManager::GetNextColumnId(TableIndex table_id) {
-	auto result = transaction.Query(StringUtil::Format(R"(
+	DuckLakeMetadataOperation metadata_operation("GetNextColumnId");
+	vector<Value> parameters {Value::BIGINT(NumericCast<int64_t>(table_id.index))};
+	auto result = transaction.PreparedQuery(R"(
 	SELECT MAX(column_id)
 	FROM {METADATA_CATALOG}.ducklake_column
-	WHERE table_id=%d
+	WHERE table_id=$1
 )",
-	                                                   table_id.index));
+	                                        std::move(parameters));
 	if (result->HasError()) {
 		result->GetErrorObject().Throw("Failed to get next column id in DuckLake: ");
 	}
@@ -2323,6 +3386,7 @@ idx_t DuckLakeMetadataManager::GetNextColumnId(TableIndex table_id) {
 }
 
 void DuckLakeMetadataManager::WriteMergeAdjacent(const vector<DuckLakeCompactedFileInfo> &compactions) {
+	DuckLakeMetadataOperation metadata_operation("WriteMergeAdjacent");
 	if (compactions.empty()) {
 		return;
 	}
@@ -2346,27 +3410,24 @@ void DuckLakeMetadataManager::WriteMergeAdjacent(const vector<DuckLakeCompactedF
 	}
 	// for each file that has been compacted - delete it from the list of data files entirely
 	// including all other info (stats, delete files, partition values, etc)
+	DeleteInlinedDeleteFiles(StringUtil::Format("data_file_id IN (%s)", deleted_file_ids));
 	vector<string> tables_to_delete_from {"ducklake_data_file", "ducklake_file_column_stats", "ducklake_delete_file",
 	                                      "ducklake_file_partition_value"};
 	for (auto &delete_from_tbl : tables_to_delete_from) {
-		auto result = transaction.Query(StringUtil::Format(R"(
+		auto query = StringUtil::Format(R"(
 DELETE FROM {METADATA_CATALOG}.%s
 WHERE data_file_id IN (%s);
 )",
-		                                                   delete_from_tbl, deleted_file_ids));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to delete old data file information in DuckLake: ");
-		}
+		                                delete_from_tbl, deleted_file_ids);
+		transaction.ExecuteWrite(query, "Failed to delete old data file information in DuckLake: ");
 	}
 	// add the files we cleared to the deletion schedule
 	scheduled_deletions =
 	    "INSERT INTO {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion VALUES " + scheduled_deletions;
-	auto result = transaction.Query(scheduled_deletions);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to insert files scheduled for deletions in DuckLake: ");
-	}
+	transaction.ExecuteWrite(scheduled_deletions, "Failed to insert files scheduled for deletions in DuckLake: ");
 }
 void DuckLakeMetadataManager::WriteDeleteRewrites(const vector<DuckLakeCompactedFileInfo> &compactions) {
+	DuckLakeMetadataOperation metadata_operation("WriteDeleteRewrites");
 	if (compactions.empty()) {
 		return;
 	}
@@ -2393,69 +3454,95 @@ void DuckLakeMetadataManager::WriteDeleteRewrites(const vector<DuckLakeCompacted
 		if (files_to_remove.find(i) != files_to_remove.end()) {
 			// We only delete deletion files if they are part of the last snapshot, as they won't be required for
 			// time travel
-			if (!scheduled_deletions.empty()) {
-				scheduled_deletions += ", ";
+			// inlined deletes have no file to clean up - they are removed together with the delete file entry
+			if (!DuckLakeDeleteFile::IsInlinedDeletePath(compaction.delete_file_path)) {
+				if (!scheduled_deletions.empty()) {
+					scheduled_deletions += ", ";
+				}
+				scheduled_deletions +=
+				    StringUtil::Format("(%d, %s, %s, NOW())", compaction.delete_file_id.index, SQLString(path.path),
+				                       path.path_is_relative ? "true" : "false");
 			}
-			scheduled_deletions += StringUtil::Format("(%d, %s, %s, NOW())", compaction.delete_file_id.index,
-			                                          SQLString(path.path), path.path_is_relative ? "true" : "false");
 			if (!deleted_file_ids.empty()) {
 				deleted_file_ids += ", ";
 			}
 			deleted_file_ids += to_string(compaction.delete_file_id.index);
 		} else if (!compaction.delete_file_end_snapshot.IsValid()) {
 			// if the deletion file was not removed, we still update its end_snapshot if null
-			auto result = transaction.Query(StringUtil::Format(R"(
+			auto query = StringUtil::Format(R"(
 			UPDATE {METADATA_CATALOG}.ducklake_delete_file SET end_snapshot = %llu
 			WHERE delete_file_id = %llu;
 			)",
-			                                                   table_idx_last_snapshot[compaction.table_index.index],
-			                                                   compaction.delete_file_id.index));
-			if (result->HasError()) {
-				result->GetErrorObject().Throw("Failed to update ducklake delete file end_snapshot.");
-			}
+			                                table_idx_last_snapshot[compaction.table_index.index],
+			                                compaction.delete_file_id.index);
+			transaction.ExecuteWrite(query, "Failed to update ducklake delete file end_snapshot.");
 		}
 		// We must update the data file table
-		auto result = transaction.Query(StringUtil::Format(R"(
+		auto query = StringUtil::Format(R"(
 		UPDATE {METADATA_CATALOG}.ducklake_data_file SET end_snapshot = %llu
 		WHERE data_file_id = %llu;
 		)",
-		                                                   table_idx_last_snapshot[compaction.table_index.index],
-		                                                   compaction.source_id.index));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to update snapshot end file information in DuckLake: ");
-		}
+		                                table_idx_last_snapshot[compaction.table_index.index],
+		                                compaction.source_id.index);
+		transaction.ExecuteWrite(query, "Failed to update snapshot end file information in DuckLake: ");
 
 		// update the snapshot of our newly added file
-		result = transaction.Query(StringUtil::Format(R"(
+		query = StringUtil::Format(R"(
 			UPDATE {METADATA_CATALOG}.ducklake_data_file SET begin_snapshot = %llu
 			WHERE data_file_id = %llu;
 			)",
-		                                              table_idx_last_snapshot[compaction.table_index.index],
-		                                              compaction.new_id.index));
-
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to update snapshot end file information in DuckLake: ");
-		}
+		                           table_idx_last_snapshot[compaction.table_index.index], compaction.new_id.index);
+		transaction.ExecuteWrite(query, "Failed to update snapshot end file information in DuckLake: ");
 	}
 	if (!deleted_file_ids.empty()) {
 		// for each file that has been rewritten - we also delete it from the ducklake_delete_file table
-		auto result = transaction.Query(StringUtil::Format(R"(
+		DeleteInlinedDeleteFiles(StringUtil::Format("delete_file_id IN (%s)", deleted_file_ids));
+		auto query = StringUtil::Format(R"(
 	DELETE FROM {METADATA_CATALOG}.ducklake_delete_file
 	WHERE delete_file_id IN (%s);
 	)",
-		                                                   deleted_file_ids));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to delete old data file information in DuckLake: ");
-		}
-
+		                                deleted_file_ids);
+		transaction.ExecuteWrite(query, "Failed to delete old data file information in DuckLake: ");
+	}
+	if (!scheduled_deletions.empty()) {
 		// add the files we cleared to the deletion schedule
 		scheduled_deletions =
 		    "INSERT INTO {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion VALUES " + scheduled_deletions;
-		result = transaction.Query(scheduled_deletions);
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to insert files scheduled for deletions in DuckLake: ");
-		}
+		transaction.ExecuteWrite(scheduled_deletions, "Failed to insert files scheduled for deletions in DuckLake: ");
+	}
+}
+
+void DuckLakeMetadataManager::DeleteInlinedDeleteFiles(const string &delete_file_filter) {
+	DuckLakeMetadataOperation metadata_operation("DeleteInlinedDeleteFiles");
+	// the inlined deletes table only exists once deletes have been inlined - check if there is anything to remove
+	// the delete files might have been archived
+	auto delete_file_table = GetFileTable("ducklake_delete_file", 0);
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT COUNT(*)
+FROM %s
+WHERE format = 'inlined' AND (%s)
+)",
+	                                                   delete_file_table, delete_file_filter));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get inlined delete files from DuckLake: ");
+	}
+	idx_t inlined_count = 0;
+	for (auto &row : *result) {
+		inlined_count = row.GetValue<idx_t>(0);
+	}
+	if (inlined_count == 0) {
+		return;
 	}
+	auto query = StringUtil::Format(R"(
+DELETE FROM {METADATA_CATALOG}.ducklake_inlined_deletes
+WHERE delete_file_id IN (
+	SELECT delete_file_id
+	FROM %s
+	WHERE format = 'inlined' AND (%s)
+);
+)",
+	                                delete_file_table, delete_file_filter);
+	transaction.ExecuteWrite(query, "Failed to delete inlined deletes from DuckLake: ");
 }
 
 void DuckLakeMetadataManager::WriteCompactions(const vector<DuckLakeCompactedFileInfo> &compactions,
@@ -2473,6 +3560,7 @@ void DuckLakeMetadataManager::WriteCompactions(const vector<DuckLakeCompactedFil
 }
 
 void DuckLakeMetadataManager::DeleteSnapshots(const vector<DuckLakeSnapshotInfo> &snapshots) {
+	DuckLakeMetadataOperation metadata_operation("DeleteSnapshots");
 	unique_ptr<QueryResult> result;
 	// first delete the actual snapshots
 	string snapshot_ids;
@@ -2483,6 +3571,9 @@ void DuckLakeMetadataManager::DeleteSnapshots(const vector<DuckLakeSnapshotInfo>
 		snapshot_ids += to_string(snapshot.id);
 	}
 	vector<string> tables_to_delete_from {"ducklake_snapshot", "ducklake_snapshot_changes"};
+	if (transaction.GetCatalog().HasSnapshotChangeIndex()) {
+		tables_to_delete_from.push_back("ducklake_snapshot_change_index");
+	}
 	for (auto &delete_tbl : tables_to_delete_from) {
 		result = transaction.Query(StringUtil::Format(R"(
 DELETE FROM {METADATA_CATALOG}.%s
@@ -2520,15 +3611,18 @@ WHERE end_snapshot IS NOT NULL AND NOT EXISTS(
 		table_id_filter = StringUtil::Format("table_id IN (%s) OR", deleted_table_ids);
 	}
 
+	// the files that are no longer required might have been archived - reload the archive snapshot in case another
+	// connection archived files since we attached
+	auto has_archive = LoadArchiveSnapshot() > 0;
 	result = transaction.Query(StringUtil::Format(R"(
 SELECT data_file_id, table_id, path, path_is_relative
-FROM {METADATA_CATALOG}.ducklake_data_file
+FROM %s
 WHERE %s (end_snapshot IS NOT NULL AND NOT EXISTS(
     SELECT snapshot_id
     FROM {METADATA_CATALOG}.ducklake_snapshot
     WHERE snapshot_id >= begin_snapshot AND snapshot_id < end_snapshot
 ));)",
-	                                              table_id_filter));
+	                                              GetFileTable("ducklake_data_file", 0), table_id_filter));
 	vector<DuckLakeFileForCleanup> cleanup_files;
 	for (auto &row : *result) {
 		DuckLakeFileForCleanup info;
@@ -2560,6 +3654,9 @@ WHERE %s (end_snapshot IS NOT NULL AND NOT EXISTS(
 
 		// delete the data files
 		tables_to_delete_from = {"ducklake_data_file", "ducklake_file_column_stats"};
+		if (has_archive) {
+			tables_to_delete_from.push_back("ducklake_data_file_archive");
+		}
 		for (auto &delete_tbl : tables_to_delete_from) {
 			result = transaction.Query(StringUtil::Format(R"(
 DELETE FROM {METADATA_CATALOG}.%s
@@ -2589,13 +3686,14 @@ VALUES %s;
 
 	result = transaction.Query(StringUtil::Format(R"(
 SELECT delete_file_id, table_id, path, path_is_relative
-FROM {METADATA_CATALOG}.ducklake_delete_file
+FROM %s
 WHERE %s %s (end_snapshot IS NOT NULL AND NOT EXISTS(
     SELECT snapshot_id
     FROM {METADATA_CATALOG}.ducklake_snapshot
     WHERE snapshot_id >= begin_snapshot AND snapshot_id < end_snapshot
 ));)",
-	                                              table_id_filter, file_id_filter));
+	                                              GetFileTable("ducklake_delete_file", 0), table_id_filter,
+	                                              file_id_filter));
 	vector<DuckLakeFileForCleanup> cleanup_deletes;
 	for (auto &row : *result) {
 		DuckLakeFileForCleanup info;
@@ -2618,6 +3716,10 @@ WHERE %s %s (end_snapshot IS NOT NULL AND NOT EXISTS(
 			}
 			deleted_delete_ids += to_string(file.id.index);
 
+			if (DuckLakeDeleteFile::IsInlinedDeletePath(file.path)) {
+				// inlined deletes have no file to clean up
+				continue;
+			}
 			if (!files_scheduled_for_cleanup.empty()) {
 				files_scheduled_for_cleanup += ", ";
 			}
@@ -2626,22 +3728,31 @@ WHERE %s %s (end_snapshot IS NOT NULL AND NOT EXISTS(
 			    "(%d, %s, %s, NOW())", file.id.index, SQLString(path.path), path.path_is_relative ? "true" : "false");
 		}
 		// delete the delete files
-		result = transaction.Query(StringUtil::Format(R"(
-DELETE FROM {METADATA_CATALOG}.ducklake_delete_file
+		DeleteInlinedDeleteFiles(StringUtil::Format("delete_file_id IN (%s)", deleted_delete_ids));
+		vector<string> delete_file_tables {"ducklake_delete_file"};
+		if (has_archive) {
+			delete_file_tables.push_back("ducklake_delete_file_archive");
+		}
+		for (auto &delete_tbl : delete_file_tables) {
+			result = transaction.Query(StringUtil::Format(R"(
+DELETE FROM {METADATA_CATALOG}.%s
 WHERE delete_file_id IN (%s);
 )",
-		                                              deleted_delete_ids));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to delete old delete file information in DuckLake: ");
+			                                              delete_tbl, deleted_delete_ids));
+			if (result->HasError()) {
+				result->GetErrorObject().Throw("Failed to delete old delete file information in DuckLake: ");
+			}
 		}
-		// insert the to-be-cleaned-up files
-		result = transaction.Query(StringUtil::Format(R"(
+		if (!files_scheduled_for_cleanup.empty()) {
+			// insert the to-be-cleaned-up files
+			result = transaction.Query(StringUtil::Format(R"(
 INSERT INTO {METADATA_CATALOG}.ducklake_files_scheduled_for_deletion
 VALUES %s;
 )",
-		                                              files_scheduled_for_cleanup));
-		if (result->HasError()) {
-			result->GetErrorObject().Throw("Failed to schedule files for clean-up in DuckLake: ");
+			                                              files_scheduled_for_cleanup));
+			if (result->HasError()) {
+				result->GetErrorObject().Throw("Failed to schedule files for clean-up in DuckLake: ");
+			}
 		}
 	}
 
@@ -2679,6 +3790,7 @@ WHERE end_snapshot IS NOT NULL AND NOT EXISTS(
 }
 
 void DuckLakeMetadataManager::DeleteInlinedData(const DuckLakeInlinedTableInfo &inlined_table) {
+	DuckLakeMetadataOperation metadata_operation("DeleteInlinedData");
 	auto result = transaction.Query(StringUtil::Format(R"(
 		DELETE FROM {METADATA_CATALOG}.%s
 )",
@@ -2690,30 +3802,41 @@ void DuckLakeMetadataManager::DeleteInlinedData(const DuckLakeInlinedTableInfo &
 }
 
 void DuckLakeMetadataManager::InsertNewSchema(const DuckLakeSnapshot &snapshot) {
+	DuckLakeMetadataOperation metadata_operation("InsertNewSchema");
 	const auto insert_schema_change =
 	    StringUtil::Format(R"(INSERT INTO {METADATA_CATALOG}.ducklake_schema_versions VALUES (%llu,%llu);)",
 	                       snapshot.snapshot_id, snapshot.schema_version);
-	const auto result = transaction.Query(insert_schema_change);
-	if (result->HasError()) {
-		result->GetErrorObject().Throw("Failed to insert new schema version to DuckLake:");
-	}
+	transaction.ExecuteWrite(insert_schema_change, "Failed to insert new schema version to DuckLake:");
 }
 
-vector<DuckLakeTableSizeInfo> DuckLakeMetadataManager::GetTableSizes(DuckLakeSnapshot snapshot) {
+vector<DuckLakeTableSizeInfo> DuckLakeMetadataManager::GetTableSizes(DuckLakeSnapshot snapshot,
+                                                                   const string &filter) {
+	DuckLakeMetadataOperation metadata_operation("GetTableSizes");
 	vector<DuckLakeTableSizeInfo> table_sizes;
-	auto result = transaction.Query(snapshot, R"(
+	auto query = R"(
 SELECT schema_id, table_id, table_name, table_uuid, data_file_info.file_count, data_file_info.total_file_size, delete_file_info.file_count, delete_file_info.total_file_size
 FROM {METADATA_CATALOG}.ducklake_table tbl, LATERAL (
 	SELECT COUNT(*) file_count, SUM(file_size_bytes) total_file_size
-	FROM {METADATA_CATALOG}.ducklake_data_file df
+	FROM {DATA_FILE_TABLE} df
 	WHERE df.table_id = tbl.table_id AND {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
 ) data_file_info, LATERAL (
 	SELECT COUNT(*) file_count, SUM(file_size_bytes) total_file_size
-	FROM {METADATA_CATALOG}.ducklake_delete_file df
+	FROM {DELETE_FILE_TABLE} df
 	WHERE df.table_id = tbl.table_id AND {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
 ) delete_file_info
 WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
-)");
+)";
+	query = StringUtil::Replace(query, "{DATA_FILE_TABLE}",
+	                            GetFileTable("ducklake_data_file", snapshot.snapshot_id + 1));
+	query = StringUtil::Replace(query, "{DELETE_FILE_TABLE}",
+	                            GetFileTable("ducklake_delete_file", snapshot.snapshot_id + 1));
+	if (!filter.empty()) {
+		query += "AND " + filter;
+	}
+	auto result = transaction.Query(snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get table sizes from DuckLake: ");
+	}
 	for (auto &row : *result) {
 		DuckLakeTableSizeInfo table_size;
 		table_size.schema_id = SchemaIndex(row.GetValue<idx_t>(0));
@@ -2737,7 +3860,134 @@ WHERE {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_s
 	return table_sizes;
 }
 
+string DuckLakeMetadataManager::GetFileTable(const string &table_name, idx_t min_end_snapshot) {
+	auto archive_snapshot = GetArchiveSnapshot();
+	if (archive_snapshot == 0 || min_end_snapshot > archive_snapshot) {
+		// all archived rows ended before the rows the query is interested in
+		return "{METADATA_CATALOG}." + table_name;
+	}
+	return StringUtil::Format("(SELECT * FROM {METADATA_CATALOG}.%s UNION ALL BY NAME SELECT * FROM "
+	                          "{METADATA_CATALOG}.%s_archive WHERE end_snapshot >= %d)",
+	                          table_name, table_name, min_end_snapshot);
+}
+
+idx_t DuckLakeMetadataManager::LoadArchiveSnapshot() {
+	DuckLakeMetadataOperation metadata_operation("LoadArchiveSnapshot");
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT value
+FROM {METADATA_CATALOG}.ducklake_metadata
+WHERE key = %s AND scope IS NULL
+)",
+	                                                   SQLString(DuckLakeArchiveInfo::OPTION_NAME)));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to load archive snapshot from DuckLake: ");
+	}
+	idx_t loaded_snapshot = 0;
+	for (auto &row : *result) {
+		loaded_snapshot = StringUtil::ToUnsigned(row.GetValue<string>(0));
+	}
+	archive_snapshot = loaded_snapshot;
+	return loaded_snapshot;
+}
+
+idx_t DuckLakeMetadataManager::GetArchiveSnapshot() {
+	if (!archive_snapshot.IsValid()) {
+		// the archive snapshot cached in the catalog might be out-of-date - other connections can archive files at
+		// any time
+		LoadArchiveSnapshot();
+	}
+	return archive_snapshot.GetIndex();
+}
+
+string DuckLakeMetadataManager::GetExtendedVersionQuery() {
+	return StringUtil::Format(
+	    "UPDATE {METADATA_CATALOG}.ducklake_metadata SET value = '%s' WHERE key = 'version' AND value = '0.3';",
+	    DUCKLAKE_EXTENDED_VERSION);
+}
+
+DuckLakeArchiveInfo DuckLakeMetadataManager::ArchiveFiles(idx_t archive_snapshot) {
+	DuckLakeMetadataOperation metadata_operation("ArchiveFiles");
+	DuckLakeArchiveInfo archive_info;
+	// the archive snapshot never moves back - the rows that were archived before stay archived
+	archive_info.archive_snapshot = MaxValue<idx_t>(LoadArchiveSnapshot(), archive_snapshot);
+	if (archive_info.archive_snapshot == 0) {
+		return archive_info;
+	}
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT (SELECT COUNT(*) FROM {METADATA_CATALOG}.ducklake_data_file WHERE end_snapshot <= %d),
+       (SELECT COUNT(*) FROM {METADATA_CATALOG}.ducklake_delete_file WHERE end_snapshot <= %d)
+)",
+	                                                   archive_info.archive_snapshot, archive_info.archive_snapshot));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get files to archive from DuckLake: ");
+	}
+	for (auto &row : *result) {
+		archive_info.data_file_count = row.GetValue<idx_t>(0);
+		archive_info.delete_file_count = row.GetValue<idx_t>(1);
+	}
+	// the archive tables are created on first use - with the same columns as the file tables. Clients that do not know
+	// the archive tables would miss the archived files when time travelling - move the DuckLake to a version that they
+	// refuse to attach
+	string archive_query = GetExtendedVersionQuery();
+	for (auto &table_name : {"ducklake_data_file", "ducklake_delete_file"}) {
+		archive_query += StringUtil::Format(R"(
+CREATE TABLE IF NOT EXISTS {METADATA_CATALOG}.%s_archive AS SELECT * FROM {METADATA_CATALOG}.%s LIMIT 0;
+INSERT INTO {METADATA_CATALOG}.%s_archive SELECT * FROM {METADATA_CATALOG}.%s WHERE end_snapshot <= %d;
+DELETE FROM {METADATA_CATALOG}.%s WHERE end_snapshot <= %d;
+)",
+		                                    table_name, table_name, table_name, table_name,
+		                                    archive_info.archive_snapshot, table_name, archive_info.archive_snapshot);
+	}
+	result = transaction.Query(archive_query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to archive files in DuckLake: ");
+	}
+	// the queries of this transaction read the archive from now on
+	archive_snapshot = archive_info.archive_snapshot;
+	return archive_info;
+}
+
+vector<DataFileIndex> DuckLakeMetadataManager::GetFilesWithoutExtraStats(TableIndex table_id, FieldIndex column_id) {
+	DuckLakeMetadataOperation metadata_operation("GetFilesWithoutExtraStats");
+	auto result = transaction.Query(StringUtil::Format(R"(
+SELECT data_file_id
+FROM {METADATA_CATALOG}.ducklake_file_column_stats
+WHERE table_id=%d AND column_id=%d AND extra_stats IS NULL
+ORDER BY data_file_id
+)",
+	                                                   table_id.index, column_id.index));
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to get file column stats from DuckLake: ");
+	}
+	vector<DataFileIndex> file_ids;
+	for (auto &row : *result) {
+		file_ids.emplace_back(row.GetValue<idx_t>(0));
+	}
+	return file_ids;
+}
+
+void DuckLakeMetadataManager::SetFileExtraStats(TableIndex table_id, FieldIndex column_id,
+                                                const vector<DuckLakeFileExtraStats> &file_stats) {
+	if (file_stats.empty()) {
+		return;
+	}
+	DuckLakeMetadataOperation metadata_operation("SetFileExtraStats");
+	string query;
+	for (auto &entry : file_stats) {
+		query += StringUtil::Format(R"(
+UPDATE {METADATA_CATALOG}.ducklake_file_column_stats
+SET extra_stats=%s
+WHERE data_file_id=%d AND table_id=%d AND column_id=%d AND extra_stats IS NULL;)",
+		                            entry.extra_stats, entry.data_file_id.index, table_id.index, column_id.index);
+	}
+	auto result = transaction.Query(query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to write file column stats to DuckLake: ");
+	}
+}
+
 void DuckLakeMetadataManager::SetConfigOption(const DuckLakeConfigOption &option) {
+	DuckLakeMetadataOperation metadata_operation("SetConfigOption");
 	// check if the option already exists
 	auto &option_key = option.option.key;
 	auto &option_value = option.option.value;
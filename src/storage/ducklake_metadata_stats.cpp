@@ -0,0 +1,59 @@
+#include "storage/ducklake_metadata_stats.hpp"
+
+namespace duckdb {
+
+//! The operation of the metadata manager that is currently running on this thread
+static thread_local const char *current_metadata_operation = nullptr;
+
+idx_t DuckLakeMetadataOperationStats::GetBucket(idx_t time_us) {
+	idx_t bucket = 0;
+	for (idx_t bound = 100; bucket + 1 < BUCKET_COUNT && time_us >= bound; bound *= 10) {
+		bucket++;
+	}
+	return bucket;
+}
+
+const char *DuckLakeMetadataOperationStats::GetBucketName(idx_t bucket) {
+	static const char *BUCKET_NAMES[] = {"<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"};
+	return BUCKET_NAMES[bucket];
+}
+
+void DuckLakeMetadataStats::Record(const string &operation, idx_t time_us, idx_t rows, idx_t bytes, bool error) {
+	lock_guard<mutex> guard(lock);
+	auto &stats = operations[operation];
+	stats.queries++;
+	if (error) {
+		stats.errors++;
+	}
+	stats.rows += rows;
+	stats.bytes += bytes;
+	stats.total_time_us += time_us;
+	stats.max_time_us = MaxValue<idx_t>(stats.max_time_us, time_us);
+	stats.latency_buckets[DuckLakeMetadataOperationStats::GetBucket(time_us)]++;
+}
+
+map<string, DuckLakeMetadataOperationStats> DuckLakeMetadataStats::GetStats() const {
+	lock_guard<mutex> guard(lock);
+	return operations;
+}
+
+void DuckLakeMetadataStats::Reset() {
+	lock_guard<mutex> guard(lock);
+	operations.clear();
+}
+
+const char *DuckLakeMetadataStats::CurrentOperation() {
+	// queries that were not issued through the metadata manager (e.g. by table functions) are grouped together
+	return current_metadata_operation ? current_metadata_operation : "Query";
+}
+
+DuckLakeMetadataOperation::DuckLakeMetadataOperation(const char *name)
+    : previous_operation(current_metadata_operation) {
+	current_metadata_operation = name;
+}
+
+DuckLakeMetadataOperation::~DuckLakeMetadataOperation() {
+	current_metadata_operation = previous_operation;
+}
+
+} // namespace duckdb
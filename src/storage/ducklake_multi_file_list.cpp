@@ -1,9 +1,16 @@
 #include "common/ducklake_util.hpp"
+#include "functions/ducklake_partition_functions.hpp"
 #include "storage/ducklake_scan.hpp"
 #include "storage/ducklake_multi_file_list.hpp"
 #include "storage/ducklake_multi_file_reader.hpp"
+#include "storage/ducklake_file_size_advisor.hpp"
 
 #include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/serializer/deserializer.hpp"
+#include "duckdb/common/serializer/serializer.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/extension_helper.hpp"
@@ -15,10 +22,18 @@
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
 #include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
 #include "duckdb/planner/filter/null_filter.hpp"
 #include "duckdb/planner/filter/optional_filter.hpp"
 #include "duckdb/planner/filter/in_filter.hpp"
 #include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_footer_prefetcher.hpp"
+#include "storage/ducklake_row_id_index.hpp"
+#include "storage/ducklake_stats.hpp"
+#include "storage/ducklake_zone_map.hpp"
+
+#include <chrono>
 
 namespace duckdb {
 
@@ -47,6 +62,18 @@ DuckLakeMultiFileList::DuckLakeMultiFileList(DuckLakeFunctionInfo &read_info,
 	inlined_data_tables.push_back(inlined_table);
 }
 
+//! The default amount of files ahead of the current file whose footers are prefetched
+static constexpr idx_t DEFAULT_FOOTER_PREFETCH_COUNT = 8;
+//! The default memory budget for the files read ahead by all scans of a catalog
+static constexpr idx_t DEFAULT_READ_AHEAD_MEMORY_LIMIT = 1ULL << 28ULL;
+
+DuckLakeMultiFileList::~DuckLakeMultiFileList() {
+	// the files that were read ahead but not reached are no longer held for this scan
+	for (auto &entry : read_ahead_reservations) {
+		read_ahead_budget->Release(entry.second);
+	}
+}
+
 unique_ptr<MultiFileList> DuckLakeMultiFileList::ComplexFilterPushdown(ClientContext &context,
                                                                        const MultiFileOptions &options,
                                                                        MultiFilePushdownInfo &info,
@@ -94,8 +121,13 @@ string GenerateConstantFilter(const ConstantFilter &constant_filter, const Logic
 	case ExpressionType::COMPARE_NOTEQUAL:
 		// x <> constant
 		// this can only be false if "constant = min AND constant = max" (i.e. min = max = constant)
-		// skip this for now
-		return string();
+		if (type.id() == LogicalTypeId::VARCHAR) {
+			// string stats are not necessarily exact - skip
+			return string();
+		}
+		referenced_stats.insert("min_value");
+		referenced_stats.insert("max_value");
+		return StringUtil::Format("NOT (%s = %s AND %s = %s)", min_value, constant_str, max_value, constant_str);
 	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
 		// x >= constant
 		// this can only be true if "max >= C"
@@ -153,7 +185,19 @@ string GenerateConstantFilterDouble(const ConstantFilter &constant_filter, const
 		referenced_stats.insert("contains_nan");
 		return filter + " OR contains_nan";
 	}
-	case ExpressionType::COMPARE_NOTEQUAL:
+	case ExpressionType::COMPARE_NOTEQUAL: {
+		if (constant_is_nan) {
+			// skip these filters if the constant is nan
+			return string();
+		}
+		string filter = GenerateConstantFilter(constant_filter, type, referenced_stats);
+		if (filter.empty()) {
+			return string();
+		}
+		// NaN values are not equal to the constant either - files that contain NaN can never be pruned
+		referenced_stats.insert("contains_nan");
+		return filter + " OR contains_nan";
+	}
 	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
 	case ExpressionType::COMPARE_LESSTHAN:
 		if (constant_is_nan) {
@@ -202,22 +246,23 @@ string GenerateFilterPushdown(const TableFilter &filter, unordered_set<string> &
 			if (child_str.empty()) {
 				return string();
 			}
-			result += child_str;
+			result += "(" + child_str + ")";
 		}
 		return result;
 	}
 	case TableFilterType::CONJUNCTION_AND: {
+		// for AND we can skip any child filters that we cannot handle
 		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
 		string result;
 		for (auto &child_filter : conjunction_and_filter.child_filters) {
-			if (!result.empty()) {
-				result += " AND ";
-			}
 			string child_str = GenerateFilterPushdown(*child_filter, referenced_stats);
 			if (child_str.empty()) {
-				return string();
+				continue;
 			}
-			result += child_str;
+			if (!result.empty()) {
+				result += " AND ";
+			}
+			result += "(" + child_str + ")";
 		}
 		return result;
 	}
@@ -237,7 +282,7 @@ string GenerateFilterPushdown(const TableFilter &filter, unordered_set<string> &
 			if (next_filter.empty()) {
 				return string();
 			}
-			result += next_filter;
+			result += "(" + next_filter + ")";
 		}
 		return result;
 	}
@@ -247,6 +292,486 @@ string GenerateFilterPushdown(const TableFilter &filter, unordered_set<string> &
 	}
 }
 
+bool GetTimePartitionValues(const Value &constant, idx_t component_count, vector<int64_t> &result) {
+	if (constant.IsNull()) {
+		return false;
+	}
+	int32_t year, month, day;
+	int32_t hour = 0, minute, second, micros;
+	switch (constant.type().id()) {
+	case LogicalTypeId::DATE: {
+		auto date = constant.GetValue<date_t>();
+		if (!Date::IsFinite(date)) {
+			return false;
+		}
+		Date::Convert(date, year, month, day);
+		break;
+	}
+	case LogicalTypeId::TIMESTAMP: {
+		auto timestamp = constant.GetValue<timestamp_t>();
+		if (!Timestamp::IsFinite(timestamp)) {
+			return false;
+		}
+		date_t date;
+		dtime_t time;
+		Timestamp::Convert(timestamp, date, time);
+		Date::Convert(date, year, month, day);
+		Time::Convert(time, hour, minute, second, micros);
+		break;
+	}
+	default:
+		// time zone dependent (or unsupported) type
+		return false;
+	}
+	int64_t components[] {year, month, day, hour};
+	result.assign(components, components + component_count);
+	return true;
+}
+
+string GenerateTupleComparison(const vector<string> &partition_values, const vector<int64_t> &constants,
+                               ExpressionType comparison_type) {
+	// generate a lexicographic comparison of (year, month, ...) against the components of the constant
+	string result;
+	for (idx_t i = partition_values.size(); i > 0; i--) {
+		auto &partition_value = partition_values[i - 1];
+		auto constant = to_string(constants[i - 1]);
+		string comparison;
+		switch (comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+			comparison = "=";
+			break;
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			comparison = result.empty() ? ">=" : ">";
+			break;
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			comparison = result.empty() ? "<=" : "<";
+			break;
+		default:
+			throw InternalException("Unsupported comparison type in GenerateTupleComparison");
+		}
+		if (result.empty()) {
+			result = StringUtil::Format("%s %s %s", partition_value, comparison, constant);
+		} else if (comparison_type == ExpressionType::COMPARE_EQUAL) {
+			result = StringUtil::Format("%s = %s AND %s", partition_value, constant, result);
+		} else {
+			result = StringUtil::Format("%s %s %s OR (%s = %s AND (%s))", partition_value, comparison, constant,
+			                            partition_value, constant, result);
+		}
+	}
+	return "(" + result + ")";
+}
+
+string GenerateTimePartitionFilter(const TableFilter &filter, const vector<string> &partition_values) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		vector<int64_t> constants;
+		if (!GetTimePartitionValues(constant_filter.constant, partition_values.size(), constants)) {
+			return string();
+		}
+		switch (constant_filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+			// x = constant - the partition of the constant has to match
+			return GenerateTupleComparison(partition_values, constants, ExpressionType::COMPARE_EQUAL);
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		case ExpressionType::COMPARE_GREATERTHAN:
+			// x > constant - the partition has to be the same or after the partition of the constant
+			return GenerateTupleComparison(partition_values, constants,
+			                               ExpressionType::COMPARE_GREATERTHANOREQUALTO);
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		case ExpressionType::COMPARE_LESSTHAN:
+			// x < constant - the partition has to be the same or before the partition of the constant
+			return GenerateTupleComparison(partition_values, constants, ExpressionType::COMPARE_LESSTHANOREQUALTO);
+		default:
+			return string();
+		}
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		// for AND we can skip any child filters that we cannot handle
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		string result;
+		for (auto &child_filter : conjunction_and_filter.child_filters) {
+			string child_str = GenerateTimePartitionFilter(*child_filter, partition_values);
+			if (child_str.empty()) {
+				continue;
+			}
+			if (!result.empty()) {
+				result += " AND ";
+			}
+			result += child_str;
+		}
+		return result;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction_or_filter = filter.Cast<ConjunctionOrFilter>();
+		string result;
+		for (auto &child_filter : conjunction_or_filter.child_filters) {
+			string child_str = GenerateTimePartitionFilter(*child_filter, partition_values);
+			if (child_str.empty()) {
+				return string();
+			}
+			if (!result.empty()) {
+				result += " OR ";
+			}
+			result += child_str;
+		}
+		return result;
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional_filter = filter.Cast<OptionalFilter>();
+		return GenerateTimePartitionFilter(*optional_filter.child_filter, partition_values);
+	}
+	case TableFilterType::IN_FILTER: {
+		auto &in_filter = filter.Cast<InFilter>();
+		string result;
+		for (auto &value : in_filter.values) {
+			auto temporary_constant_filter = ConstantFilter(ExpressionType::COMPARE_EQUAL, value);
+			auto next_filter = GenerateTimePartitionFilter(temporary_constant_filter, partition_values);
+			if (next_filter.empty()) {
+				return string();
+			}
+			if (!result.empty()) {
+				result += " OR ";
+			}
+			result += next_filter;
+		}
+		return result;
+	}
+	default:
+		return string();
+	}
+}
+
+static bool GetEqualityValues(const TableFilter &filter, vector<Value> &values);
+
+//! Generate the set of partition values of a bucket or truncate partition key that rows matching the filter can have
+//! Returns an empty string if the filter does not restrict the column to a set of values
+static string GenerateValueTransformFilter(const DuckLakePartitionField &field, const LogicalType &column_type,
+                                           const TableFilter &filter) {
+	if (field.transform.type == DuckLakeTransformType::TRUNCATE && column_type.id() == LogicalTypeId::BLOB) {
+		// truncated blobs are not compared against their (escaped) partition values
+		return string();
+	}
+	vector<Value> values;
+	if (!GetEqualityValues(filter, values) || values.empty()) {
+		return string();
+	}
+	set<string> partition_values;
+	for (auto &value : values) {
+		if (value.IsNull() || value.type() != column_type) {
+			return string();
+		}
+		if (field.transform.type == DuckLakeTransformType::BUCKET) {
+			auto bucket = DuckLakePartitionFunctions::Bucket(field.transform.parameter, value);
+			partition_values.insert(to_string(bucket));
+		} else {
+			partition_values.insert(DuckLakePartitionFunctions::Truncate(field.transform.parameter, value).ToString());
+		}
+	}
+	string result;
+	for (auto &partition_value : partition_values) {
+		if (!result.empty()) {
+			result += ", ";
+		}
+		result += DuckLakeUtil::SQLLiteralToString(partition_value);
+	}
+	return result;
+}
+
+//! Generate a filter that prunes files based on their partition values
+//! The partition values of a file are only meaningful for the partition key the file was written with - files that
+//! were written with a different (or no) partition key are never pruned
+string GeneratePartitionFilter(DuckLakeTableEntry &table, TableIndex table_id, FieldIndex field_id,
+                               const TableFilter &filter) {
+	auto partition_data = table.GetPartitionData();
+	if (!partition_data) {
+		return string();
+	}
+	optional_idx identity_key;
+	// the (year, month, day, hour) partition keys of this column
+	optional_idx time_keys[4];
+	// the bucket and truncate partition keys of this column
+	vector<reference<const DuckLakePartitionField>> value_keys;
+	for (auto &field : partition_data->fields) {
+		if (field.field_id != field_id) {
+			continue;
+		}
+		switch (field.transform.type) {
+		case DuckLakeTransformType::IDENTITY:
+			identity_key = field.partition_key_index;
+			break;
+		case DuckLakeTransformType::YEAR:
+			time_keys[0] = field.partition_key_index;
+			break;
+		case DuckLakeTransformType::MONTH:
+			time_keys[1] = field.partition_key_index;
+			break;
+		case DuckLakeTransformType::DAY:
+			time_keys[2] = field.partition_key_index;
+			break;
+		case DuckLakeTransformType::HOUR:
+			time_keys[3] = field.partition_key_index;
+			break;
+		case DuckLakeTransformType::BUCKET:
+		case DuckLakeTransformType::TRUNCATE:
+			value_keys.push_back(field);
+			break;
+		default:
+			break;
+		}
+	}
+	vector<string> excluded_files;
+	if (identity_key.IsValid()) {
+		// for identity partitions we know that min = max = partition value for all files in the partition
+		unordered_set<string> referenced_stats;
+		auto identity_filter = GenerateFilterPushdown(filter, referenced_stats);
+		for (auto &stats_name : referenced_stats) {
+			if (stats_name != "min_value" && stats_name != "max_value") {
+				identity_filter = string();
+			}
+		}
+		if (!identity_filter.empty()) {
+			excluded_files.push_back(StringUtil::Format(R"(
+SELECT data_file_id
+FROM (
+    SELECT data_file_id, partition_value AS min_value, partition_value AS max_value
+    FROM {METADATA_CATALOG}.ducklake_file_partition_value
+    WHERE table_id=%d AND partition_key_index=%d
+) partition_value
+WHERE NOT (%s))",
+			                                            table_id.index, identity_key.GetIndex(), identity_filter));
+		}
+	}
+	// for bucket and truncate partitions the rows matching an equality (or IN) filter are in the partitions of the
+	// transformed constants - all other partitions can be skipped
+	auto column_field = table.GetFieldData().GetByFieldIndex(field_id);
+	for (idx_t key_idx = 0; column_field && key_idx < value_keys.size(); key_idx++) {
+		auto &field = value_keys[key_idx].get();
+		auto partition_values = GenerateValueTransformFilter(field, column_field->Type(), filter);
+		if (partition_values.empty()) {
+			continue;
+		}
+		excluded_files.push_back(StringUtil::Format(R"(
+SELECT data_file_id
+FROM {METADATA_CATALOG}.ducklake_file_partition_value
+WHERE table_id=%d AND partition_key_index=%d AND partition_value NOT IN (%s))",
+		                                            table_id.index, field.partition_key_index, partition_values));
+	}
+	// time partitions can only be used if all coarser partitions are present (e.g. month requires year)
+	vector<idx_t> time_chain;
+	for (auto &time_key : time_keys) {
+		if (!time_key.IsValid()) {
+			break;
+		}
+		time_chain.push_back(time_key.GetIndex());
+	}
+	if (!time_chain.empty()) {
+		vector<string> partition_values;
+		for (idx_t i = 0; i < time_chain.size(); i++) {
+			partition_values.push_back(StringUtil::Format("TRY_CAST(pv%d.partition_value AS BIGINT)", i));
+		}
+		auto time_filter = GenerateTimePartitionFilter(filter, partition_values);
+		if (!time_filter.empty()) {
+			string from_clause = "{METADATA_CATALOG}.ducklake_file_partition_value pv0";
+			for (idx_t i = 1; i < time_chain.size(); i++) {
+				from_clause += StringUtil::Format("\nJOIN {METADATA_CATALOG}.ducklake_file_partition_value pv%d ON "
+				                                  "pv%d.data_file_id=pv0.data_file_id AND pv%d.table_id=%d AND "
+				                                  "pv%d.partition_key_index=%d",
+				                                  i, i, i, table_id.index, i, time_chain[i]);
+			}
+			excluded_files.push_back(StringUtil::Format(R"(
+SELECT pv0.data_file_id
+FROM %s
+WHERE pv0.table_id=%d AND pv0.partition_key_index=%d AND NOT (%s))",
+			                                            from_clause, table_id.index, time_chain[0], time_filter));
+		}
+	}
+	if (excluded_files.empty()) {
+		return string();
+	}
+	string result;
+	for (auto &excluded : excluded_files) {
+		if (!result.empty()) {
+			result += " AND ";
+		}
+		result += "data_file_id NOT IN (" + excluded + ")";
+	}
+	return StringUtil::Format("(data.partition_id IS DISTINCT FROM %d OR (%s))", partition_data->partition_id,
+	                          result);
+}
+
+//! Collect the set of values a column must be equal to for the filter to pass - returns false if there is no such set
+static bool GetEqualityValues(const TableFilter &filter, vector<Value> &values) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		if (constant_filter.comparison_type != ExpressionType::COMPARE_EQUAL) {
+			return false;
+		}
+		values.push_back(constant_filter.constant);
+		return true;
+	}
+	case TableFilterType::IN_FILTER: {
+		auto &in_filter = filter.Cast<InFilter>();
+		values.insert(values.end(), in_filter.values.begin(), in_filter.values.end());
+		return true;
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional_filter = filter.Cast<OptionalFilter>();
+		return GetEqualityValues(*optional_filter.child_filter, values);
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		// an OR restricts the set of values only if all of its children do
+		auto &conjunction_or_filter = filter.Cast<ConjunctionOrFilter>();
+		for (auto &child_filter : conjunction_or_filter.child_filters) {
+			if (!GetEqualityValues(*child_filter, values)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		// any child of an AND that is an equality filter restricts the set of values
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child_filter : conjunction_and_filter.child_filters) {
+			// a child that does not restrict the values might have collected some of them already - discard those
+			vector<Value> child_values;
+			if (GetEqualityValues(*child_filter, child_values)) {
+				values.insert(values.end(), child_values.begin(), child_values.end());
+				return true;
+			}
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+//! Prune files on the Bloom filters stored for a column - this probes the Bloom filters locally and returns a filter
+//! that excludes the files that cannot contain any of the values
+static string GenerateBloomFilterPruning(DuckLakeFunctionInfo &read_info, const DuckLakeFieldId &field_id,
+                                         const TableFilter &filter) {
+	if (read_info.table_id.IsTransactionLocal()) {
+		return string();
+	}
+	// only probe the Bloom filters of columns that have them enabled
+	auto &catalog = read_info.table.ParentCatalog().Cast<DuckLakeCatalog>();
+	string bloom_filter_columns;
+	if (!catalog.TryGetConfigOption("bloom_filter_columns", bloom_filter_columns, read_info.table)) {
+		return string();
+	}
+	bool has_bloom_filter = false;
+	for (auto &entry : StringUtil::Split(bloom_filter_columns, ',')) {
+		StringUtil::Trim(entry);
+		if (StringUtil::CIEquals(entry, field_id.Name())) {
+			has_bloom_filter = true;
+			break;
+		}
+	}
+	if (!has_bloom_filter) {
+		return string();
+	}
+	vector<Value> values;
+	if (!GetEqualityValues(filter, values) || values.empty()) {
+		return string();
+	}
+	vector<hash_t> hashes;
+	string type_name = values[0].type().ToString();
+	for (auto &value : values) {
+		if (value.IsNull() || value.type().IsNested() || value.type().ToString() != type_name) {
+			return string();
+		}
+		hashes.push_back(value.Hash());
+	}
+	auto transaction_ref = read_info.GetTransaction();
+	auto &transaction = *transaction_ref;
+	auto bloom_filter_files = StringUtil::Format(R"(
+SELECT data_file_id
+FROM {METADATA_CATALOG}.ducklake_file_column_stats
+WHERE table_id=%d AND column_id=%d AND extra_stats LIKE '{"bloom_filter"%%')",
+	                                             read_info.table_id.index, field_id.GetFieldIndex().index);
+	auto data_file_table =
+	    transaction.GetMetadataManager().GetFileTable("ducklake_data_file", read_info.snapshot.snapshot_id + 1);
+	auto query = StringUtil::Format(R"(
+SELECT data_file_id, extra_stats
+FROM {METADATA_CATALOG}.ducklake_file_column_stats
+WHERE table_id=%d AND column_id=%d AND extra_stats LIKE '{"bloom_filter"%%' AND data_file_id IN (
+	SELECT data_file_id
+	FROM %s
+	WHERE table_id=%d AND {SNAPSHOT_ID} >= begin_snapshot AND ({SNAPSHOT_ID} < end_snapshot OR end_snapshot IS NULL)
+))",
+	                                read_info.table_id.index, field_id.GetFieldIndex().index, data_file_table,
+	                                read_info.table_id.index);
+	auto result = transaction.Query(read_info.snapshot, query);
+	if (result->HasError()) {
+		result->GetErrorObject().Throw("Failed to read Bloom filters from DuckLake: ");
+	}
+	bool pruned_any = false;
+	vector<string> remaining_files;
+	for (auto &row : *result) {
+		auto data_file_id = row.GetValue<int64_t>(0);
+		DuckLakeColumnBloomFilterStats bloom_filter;
+		bloom_filter.Deserialize(row.GetValue<string>(1));
+		bool may_contain = bloom_filter.type != type_name;
+		for (idx_t i = 0; i < hashes.size() && !may_contain; i++) {
+			may_contain = bloom_filter.MayContain(hashes[i]);
+		}
+		if (may_contain) {
+			remaining_files.push_back(to_string(data_file_id));
+		} else {
+			pruned_any = true;
+		}
+	}
+	if (!pruned_any) {
+		return string();
+	}
+	// files without a Bloom filter are always kept
+	if (remaining_files.empty()) {
+		return StringUtil::Format("data_file_id NOT IN (%s)", bloom_filter_files);
+	}
+	return StringUtil::Format("(data_file_id IN (%s) OR data_file_id NOT IN (%s))",
+	                          StringUtil::Join(remaining_files, ", "), bloom_filter_files);
+}
+
+static optional_ptr<const DynamicFilter> GetTopNFilter(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::DYNAMIC_FILTER: {
+		auto &dynamic_filter = filter.Cast<DynamicFilter>();
+		if (!dynamic_filter.filter_data) {
+			return nullptr;
+		}
+		lock_guard<mutex> guard(dynamic_filter.filter_data->lock);
+		if (!dynamic_filter.filter_data->filter) {
+			return nullptr;
+		}
+		switch (dynamic_filter.filter_data->filter->comparison_type) {
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			return &dynamic_filter;
+		default:
+			return nullptr;
+		}
+	}
+	case TableFilterType::OPTIONAL_FILTER:
+		return GetTopNFilter(*filter.Cast<OptionalFilter>().child_filter);
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child_filter : conjunction_and_filter.child_filters) {
+			auto result = GetTopNFilter(*child_filter);
+			if (result) {
+				return result;
+			}
+		}
+		return nullptr;
+	}
+	default:
+		return nullptr;
+	}
+}
+
 unique_ptr<MultiFileList>
 DuckLakeMultiFileList::DynamicFilterPushdown(ClientContext &context, const MultiFileOptions &options,
                                              const vector<string> &names, const vector<LogicalType> &types,
@@ -256,8 +781,18 @@ DuckLakeMultiFileList::DynamicFilterPushdown(ClientContext &context, const Multi
 		return nullptr;
 	}
 	string filter;
+	vector<DuckLakeZoneMapFilter> new_zone_map_filters;
+	shared_ptr<DynamicFilterData> new_top_n_filter;
+	FieldIndex new_top_n_field;
+	unique_ptr<TableFilter> new_row_id_filter;
 	for (auto &entry : filters.filters) {
 		auto column_id = entry.first;
+		if (column_ids[column_id] == COLUMN_IDENTIFIER_ROW_ID) {
+			// filters on the row id are evaluated against the row id ranges of the files once the file list is read
+			// dynamic filters (e.g. of a join on the row id) are resolved at that point
+			new_row_id_filter = entry.second->Copy();
+			continue;
+		}
 		if (IsVirtualColumn(column_ids[column_id])) {
 			// skip pushing filters on virtual columns
 			continue;
@@ -265,6 +800,37 @@ DuckLakeMultiFileList::DynamicFilterPushdown(ClientContext &context, const Multi
 		// FIXME: handle structs
 		auto column_index = PhysicalIndex(column_ids[column_id]);
 		auto &root_id = read_info.table.GetFieldId(column_index);
+		// prune files based on their partition values
+		auto partition_filter =
+		    GeneratePartitionFilter(read_info.table, read_info.table_id, root_id.GetFieldIndex(), *entry.second);
+		if (!partition_filter.empty()) {
+			if (!filter.empty()) {
+				filter += " AND ";
+			}
+			filter += partition_filter;
+		}
+		// prune files on their Bloom filters
+		auto bloom_filter = GenerateBloomFilterPruning(read_info, root_id, *entry.second);
+		if (!bloom_filter.empty()) {
+			if (!filter.empty()) {
+				filter += " AND ";
+			}
+			filter += bloom_filter;
+		}
+		if (!read_info.table_id.IsTransactionLocal() && DuckLakeColumnZoneMap::SupportsType(root_id.Type())) {
+			auto top_n_filter = GetTopNFilter(*entry.second);
+			if (top_n_filter && !new_top_n_filter) {
+				// a top-n on this column - visit the files in the order of their stats
+				new_top_n_filter = top_n_filter->filter_data;
+				new_top_n_field = root_id.GetFieldIndex();
+			}
+			// the stats of this column are evaluated locally against the zone map of the column
+			DuckLakeZoneMapFilter zone_map_filter;
+			zone_map_filter.field_index = root_id.GetFieldIndex();
+			zone_map_filter.filter = entry.second->Copy();
+			new_zone_map_filters.push_back(std::move(zone_map_filter));
+			continue;
+		}
 		unordered_set<string> referenced_stats;
 		auto new_filter = GenerateFilterPushdown(*entry.second, referenced_stats);
 		if (new_filter.empty()) {
@@ -292,9 +858,16 @@ DuckLakeMultiFileList::DynamicFilterPushdown(ClientContext &context, const Multi
 		    "data_file_id IN (SELECT data_file_id FROM {METADATA_CATALOG}.ducklake_file_column_stats WHERE %s)",
 		    final_filter);
 	}
-	if (!filter.empty()) {
-		return make_uniq<DuckLakeMultiFileList>(read_info, transaction_local_files, transaction_local_data,
-		                                        std::move(filter));
+	if (!filter.empty() || !new_zone_map_filters.empty() || new_row_id_filter) {
+		auto result = make_uniq<DuckLakeMultiFileList>(read_info, transaction_local_files, transaction_local_data,
+		                                               std::move(filter));
+		result->zone_map_filters = std::move(new_zone_map_filters);
+		result->row_id_filter = std::move(new_row_id_filter);
+		result->scan_order_field = scan_order_field;
+		result->scan_order_descending = scan_order_descending;
+		result->top_n_filter = std::move(new_top_n_filter);
+		result->top_n_field = new_top_n_field;
+		return std::move(result);
 	}
 	return nullptr;
 }
@@ -302,7 +875,7 @@ DuckLakeMultiFileList::DynamicFilterPushdown(ClientContext &context, const Multi
 vector<OpenFileInfo> DuckLakeMultiFileList::GetAllFiles() {
 	vector<OpenFileInfo> file_list;
 	for (idx_t i = 0; i < GetTotalFileCount(); i++) {
-		file_list.push_back(GetFile(i));
+		file_list.push_back(GetFileInfo(i));
 	}
 	return file_list;
 }
@@ -320,7 +893,45 @@ unique_ptr<NodeStatistics> DuckLakeMultiFileList::GetCardinality(ClientContext &
 	if (!stats) {
 		return nullptr;
 	}
-	return make_uniq<NodeStatistics>(stats->record_count);
+	if (read_info.scan_type != DuckLakeScanType::SCAN_TABLE || (filter.empty() && zone_map_filters.empty())) {
+		return make_uniq<NodeStatistics>(stats->record_count);
+	}
+	// files have been pruned using the pushed down filters - estimate the cardinality from the files that are left
+	idx_t row_count = 0;
+	for (auto &file_entry : GetFiles()) {
+		if (file_entry.data_type != DuckLakeDataType::DATA_FILE || !file_entry.row_count.IsValid()) {
+			// we don't know how many rows are in inlined data - fall back to the row count of the table
+			return make_uniq<NodeStatistics>(stats->record_count);
+		}
+		auto file_rows = file_entry.row_count.GetIndex();
+		if (file_entry.max_row_count.IsValid()) {
+			file_rows = MinValue<idx_t>(file_rows, file_entry.max_row_count.GetIndex());
+		}
+		row_count += file_rows - MinValue<idx_t>(file_rows, file_entry.delete_count);
+	}
+	// the files that are left can still contain many rows that do not match - estimate the fraction of matching rows
+	// from the histograms of the filtered columns
+	double selectivity = 1;
+	bool has_selectivity = false;
+	for (auto &zone_map_filter : zone_map_filters) {
+		auto column_stats = stats->column_stats.find(zone_map_filter.field_index);
+		auto field_id = read_info.table.GetFieldId(zone_map_filter.field_index);
+		if (column_stats == stats->column_stats.end() || !field_id || !column_stats->second.extra_stats ||
+		    !DuckLakeColumnHistogramStats::SupportsType(field_id->Type())) {
+			continue;
+		}
+		auto &histogram = column_stats->second.extra_stats->Cast<DuckLakeColumnHistogramStats>();
+		double column_selectivity;
+		if (histogram.TryEstimateSelectivity(field_id->Type(), *zone_map_filter.filter, column_selectivity)) {
+			selectivity *= column_selectivity;
+			has_selectivity = true;
+		}
+	}
+	if (has_selectivity) {
+		auto estimate = static_cast<double>(stats->record_count) * selectivity;
+		row_count = MinValue<idx_t>(row_count, MaxValue<idx_t>(static_cast<idx_t>(estimate), 1));
+	}
+	return make_uniq<NodeStatistics>(row_count);
 }
 
 DuckLakeTableEntry &DuckLakeMultiFileList::GetTable() {
@@ -328,11 +939,95 @@ DuckLakeTableEntry &DuckLakeMultiFileList::GetTable() {
 }
 
 OpenFileInfo DuckLakeMultiFileList::GetFile(idx_t i) {
+	auto result = GetFileInfo(i);
+	if (!result.path.empty()) {
+		PrefetchFiles(i);
+	}
+	return result;
+}
+
+void DuckLakeMultiFileList::PrefetchFiles(idx_t i) {
+	lock_guard<mutex> guard(prefetch_lock);
+	auto &catalog = read_info.table.ParentCatalog().Cast<DuckLakeCatalog>();
+	if (!prefetch_count.IsValid()) {
+		string prefetch_count_str;
+		idx_t count = DEFAULT_FOOTER_PREFETCH_COUNT;
+		if (!read_info.table_id.IsTransactionLocal() &&
+		    catalog.TryGetConfigOption("footer_prefetch_count", prefetch_count_str, read_info.table)) {
+			count = Value(prefetch_count_str).GetValue<idx_t>();
+		}
+		prefetch_count = count;
+		string read_ahead_str;
+		if (!read_info.table_id.IsTransactionLocal() &&
+		    catalog.TryGetConfigOption("read_ahead_file_size", read_ahead_str, read_info.table)) {
+			read_ahead_file_size = Value(read_ahead_str).GetValue<idx_t>();
+		}
+		read_ahead_budget = catalog.GetReadAheadBudget();
+	}
+	// the scan has reached this file - the memory reserved for reading it ahead is released
+	auto reservation = read_ahead_reservations.find(i);
+	if (reservation != read_ahead_reservations.end()) {
+		read_ahead_budget->Release(reservation->second);
+		read_ahead_reservations.erase(reservation);
+	}
+	if (footer_prefetcher && footer_prefetcher->IsPrefetched(i)) {
+		read_info.metrics.prefetched_files++;
+	}
+	auto count = prefetch_count.GetIndex();
+	if (count == 0) {
+		return;
+	}
+	auto &files = GetFiles();
+	// only the regular data files have footers that can be prefetched
+	idx_t data_file_end = files.size() - inlined_data_tables.size();
+	if (transaction_local_data) {
+		data_file_end--;
+	}
+	auto end = MinValue<idx_t>(i + 1 + count, data_file_end);
+	idx_t read_ahead_limit = 0;
+	if (read_ahead_file_size > 0) {
+		read_ahead_limit = catalog.GetConfigOption<idx_t>("read_ahead_memory_limit", {}, {},
+		                                                  DEFAULT_READ_AHEAD_MEMORY_LIMIT);
+	}
+	for (idx_t file_idx = MaxValue<idx_t>(prefetch_end, i + 1); file_idx < end; file_idx++) {
+		auto &file = files[file_idx].file;
+		if (!file.footer_size.IsValid() || !FileSystem::IsRemoteFile(file.path)) {
+			// local files are cheap to open - there is nothing to gain from prefetching them
+			continue;
+		}
+		if (top_n_zone_map && !TopNFileCanMatch(files[file_idx])) {
+			// the scan stops before reaching this file
+			break;
+		}
+		if (!footer_prefetcher) {
+			auto context = read_info.GetTransaction()->context.lock();
+			if (!context) {
+				return;
+			}
+			footer_prefetcher = make_uniq<DuckLakeFooterPrefetcher>(*context, count);
+		}
+		// small files are read ahead completely - as long as the read-ahead of all scans fits in the memory budget
+		bool read_file = file.file_size_bytes <= read_ahead_file_size &&
+		                 read_ahead_budget->TryReserve(file.file_size_bytes, read_ahead_limit);
+		if (read_file) {
+			read_ahead_reservations[file_idx] = file.file_size_bytes;
+		}
+		footer_prefetcher->Prefetch(file_idx, file, read_file);
+	}
+	prefetch_end = MaxValue<idx_t>(prefetch_end, end);
+}
+
+OpenFileInfo DuckLakeMultiFileList::GetFileInfo(idx_t i) {
 	auto &files = GetFiles();
 	if (i >= files.size()) {
 		return OpenFileInfo();
 	}
 	auto &file_entry = files[i];
+	if (top_n_zone_map && !TopNFileCanMatch(file_entry)) {
+		// the files are ordered by the top-n column - none of the remaining files can contain rows that pass the
+		// threshold of the top-n, so we can stop scanning
+		return OpenFileInfo();
+	}
 	auto &file = file_entry.file;
 	OpenFileInfo result(file.path);
 	auto extended_info = make_shared_ptr<ExtendedOpenFileInfo>();
@@ -398,6 +1093,20 @@ unique_ptr<MultiFileList> DuckLakeMultiFileList::Copy() {
 	result->files = GetFiles();
 	result->read_file_list = read_file_list;
 	result->delete_scans = delete_scans;
+	for (auto &zone_map_filter : zone_map_filters) {
+		DuckLakeZoneMapFilter filter_copy;
+		filter_copy.field_index = zone_map_filter.field_index;
+		filter_copy.filter = zone_map_filter.filter->Copy();
+		result->zone_map_filters.push_back(std::move(filter_copy));
+	}
+	if (row_id_filter) {
+		result->row_id_filter = row_id_filter->Copy();
+	}
+	result->scan_order_field = scan_order_field;
+	result->scan_order_descending = scan_order_descending;
+	result->top_n_filter = top_n_filter;
+	result->top_n_field = top_n_field;
+	result->top_n_zone_map = top_n_zone_map;
 	return std::move(result);
 }
 
@@ -505,8 +1214,34 @@ void DuckLakeMultiFileList::GetFilesForTable() {
 	auto &transaction = *transaction_ref;
 	if (!read_info.table_id.IsTransactionLocal()) {
 		// not a transaction local table - read the file list from the metadata store
-		auto &metadata_manager = transaction.GetMetadataManager();
-		files = metadata_manager.GetFilesForTable(read_info.table, read_info.snapshot, filter);
+		if (filter.empty()) {
+			// no filter - use the file list cached in the catalog
+			auto &catalog = transaction.GetCatalog();
+			files = catalog.GetFilesForTable(transaction, read_info.table, read_info.snapshot);
+		} else {
+			// if the table has manifests - only read the manifests whose partition summaries can match the filters
+			auto &catalog = transaction.GetCatalog();
+			if (!catalog.TryGetFilesFromManifests(transaction, read_info.table, read_info.snapshot, zone_map_filters,
+			                                      filter, files)) {
+				auto &metadata_manager = transaction.GetMetadataManager();
+				files = metadata_manager.GetFilesForTable(read_info.table, read_info.snapshot, filter);
+			}
+		}
+		read_info.metrics.catalog_files = files.size();
+		if (!zone_map_filters.empty()) {
+			PruneFilesWithZoneMaps(transaction);
+		}
+		if (row_id_filter) {
+			PruneFilesWithRowIds();
+		}
+		// register the fraction of the files of the table the scan reads - which determines the adaptive file size
+		auto &file_size_advisor = transaction.GetCatalog().GetFileSizeAdvisor();
+		file_size_advisor.RecordScan(read_info.table_id, read_info.metrics.catalog_files, files.size());
+		if (top_n_filter) {
+			OrderFilesForTopN(transaction);
+		} else if (scan_order_field.IsValid()) {
+			OrderFilesByStats(transaction, scan_order_field, scan_order_descending);
+		}
 	}
 	if (transaction.HasDroppedFiles()) {
 		for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
@@ -529,6 +1264,7 @@ void DuckLakeMultiFileList::GetFilesForTable() {
 		file_entry.row_id_start = transaction_row_start;
 		file_entry.delete_file = GetDeleteData(file);
 		file_entry.mapping_id = file.mapping_id;
+		file_entry.row_count = file.row_count;
 		transaction_row_start += file.row_count;
 		files.emplace_back(std::move(file_entry));
 	}
@@ -548,6 +1284,126 @@ void DuckLakeMultiFileList::GetFilesForTable() {
 		file_entry.data_type = DuckLakeDataType::TRANSACTION_LOCAL_INLINED_DATA;
 		files.push_back(std::move(file_entry));
 	}
+	bool has_other_sources = !transaction_local_files.empty() || !inlined_data_tables.empty() || transaction_local_data;
+	if (top_n_zone_map && has_other_sources) {
+		// we have sources after the data files that we cannot skip - we cannot stop the scan early
+		top_n_zone_map.reset();
+	}
+}
+
+void DuckLakeMultiFileList::PruneFilesWithZoneMaps(DuckLakeTransaction &transaction) {
+	auto &catalog = transaction.GetCatalog();
+	vector<DataFileIndex> file_ids;
+	for (auto &file : files) {
+		file_ids.push_back(file.file_id);
+	}
+	vector<bool> keep_files(files.size(), true);
+	for (auto &zone_map_filter : zone_map_filters) {
+		auto field_id = read_info.table.GetFieldId(zone_map_filter.field_index);
+		if (!field_id) {
+			continue;
+		}
+		auto zone_map = catalog.GetZoneMap(transaction, read_info.table, *field_id, read_info.snapshot);
+		if (!zone_map) {
+			continue;
+		}
+		auto column_result = zone_map->Evaluate(*zone_map_filter.filter, file_ids);
+		for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+			keep_files[file_idx] = keep_files[file_idx] && column_result[file_idx];
+		}
+	}
+	vector<DuckLakeFileListEntry> result;
+	for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+		if (keep_files[file_idx]) {
+			result.push_back(std::move(files[file_idx]));
+		}
+	}
+	read_info.metrics.zone_map_pruned_files = files.size() - result.size();
+	files = std::move(result);
+}
+
+void DuckLakeMultiFileList::PruneFilesWithRowIds() {
+	auto ranges = DuckLakeRowIdIndex::GetRowIdRanges(*row_id_filter);
+	if (DuckLakeRowIdIndex::IsFullRange(ranges)) {
+		return;
+	}
+	DuckLakeRowIdIndex row_id_index(files);
+	auto keep_files = row_id_index.Evaluate(ranges);
+	vector<DuckLakeFileListEntry> result;
+	for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+		if (keep_files[file_idx]) {
+			result.push_back(std::move(files[file_idx]));
+		}
+	}
+	read_info.metrics.row_id_pruned_files = files.size() - result.size();
+	files = std::move(result);
+}
+
+shared_ptr<DuckLakeColumnZoneMap> DuckLakeMultiFileList::OrderFilesByStats(DuckLakeTransaction &transaction,
+                                                                          FieldIndex field_index, bool descending) {
+	auto field_id = read_info.table.GetFieldId(field_index);
+	if (!field_id || !DuckLakeColumnZoneMap::SupportsType(field_id->Type())) {
+		return nullptr;
+	}
+	auto &catalog = transaction.GetCatalog();
+	auto zone_map = catalog.GetZoneMap(transaction, read_info.table, *field_id, read_info.snapshot);
+	if (!zone_map) {
+		return nullptr;
+	}
+	// only the data files are ordered - inlined and transaction-local data always comes after them
+	vector<DataFileIndex> file_ids;
+	for (auto &file : files) {
+		if (!file.file_id.IsValid()) {
+			break;
+		}
+		file_ids.push_back(file.file_id);
+	}
+	auto file_order = zone_map->OrderFiles(file_ids, descending);
+	vector<DuckLakeFileListEntry> result;
+	result.reserve(files.size());
+	for (auto &file_idx : file_order) {
+		result.push_back(std::move(files[file_idx]));
+	}
+	for (idx_t file_idx = file_ids.size(); file_idx < files.size(); file_idx++) {
+		result.push_back(std::move(files[file_idx]));
+	}
+	files = std::move(result);
+	return zone_map;
+}
+
+void DuckLakeMultiFileList::OrderFilesForTopN(DuckLakeTransaction &transaction) {
+	bool descending;
+	{
+		lock_guard<mutex> guard(top_n_filter->lock);
+		auto comparison_type = top_n_filter->filter->comparison_type;
+		// ORDER BY x DESC pushes a filter of x > threshold - the files with the highest max should be read first
+		descending = comparison_type == ExpressionType::COMPARE_GREATERTHAN ||
+		             comparison_type == ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+	}
+	top_n_zone_map = OrderFilesByStats(transaction, top_n_field, descending);
+}
+
+void DuckLakeMultiFileList::SetScanOrder(FieldIndex field_index, bool descending) {
+	lock_guard<mutex> l(file_lock);
+	scan_order_field = field_index;
+	scan_order_descending = descending;
+	if (read_file_list && read_info.scan_type == DuckLakeScanType::SCAN_TABLE &&
+	    !read_info.table_id.IsTransactionLocal()) {
+		// the file list has already been read - reorder it
+		auto transaction_ref = read_info.GetTransaction();
+		OrderFilesByStats(*transaction_ref, scan_order_field, scan_order_descending);
+	}
+}
+
+bool DuckLakeMultiFileList::TopNFileCanMatch(const DuckLakeFileListEntry &file_entry) {
+	lock_guard<mutex> guard(top_n_filter->lock);
+	if (!top_n_filter->initialized) {
+		// the top-n has not produced a threshold yet
+		return true;
+	}
+	auto &constant_filter = *top_n_filter->filter;
+	return top_n_zone_map->FileCanMatch(file_entry.file_id, constant_filter.comparison_type,
+	                                    constant_filter.constant);
 }
 
 void DuckLakeMultiFileList::GetTableInsertions() {
@@ -604,10 +1460,195 @@ const DuckLakeDeleteScanEntry &DuckLakeMultiFileList::GetDeleteScanEntry(idx_t f
 	return delete_scans[file_idx];
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+static idx_t OptionalToIndex(optional_idx value) {
+	return value.IsValid() ? value.GetIndex() : DConstants::INVALID_INDEX;
+}
+
+static optional_idx IndexToOptional(idx_t value) {
+	return value == DConstants::INVALID_INDEX ? optional_idx() : optional_idx(value);
+}
+
+//! The encryption keys of the files are not serialized - the deserializing side looks them up in the metadata catalog
+static void WriteFileData(Serializer &serializer, field_id_t field_id, const char *tag, const DuckLakeFileData &file) {
+	serializer.WriteObject(field_id, tag, [&](Serializer &object) {
+		object.WriteProperty(100, "path", file.path);
+		object.WriteProperty(102, "file_size_bytes", file.file_size_bytes);
+		object.WriteProperty(103, "footer_size", OptionalToIndex(file.footer_size));
+	});
+}
+
+static DuckLakeFileData ReadFileData(Deserializer &deserializer, field_id_t field_id, const char *tag) {
+	DuckLakeFileData file;
+	deserializer.ReadObject(field_id, tag, [&](Deserializer &object) {
+		file.path = object.ReadProperty<string>(100, "path");
+		file.file_size_bytes = object.ReadProperty<idx_t>(102, "file_size_bytes");
+		file.footer_size = IndexToOptional(object.ReadProperty<idx_t>(103, "footer_size"));
+	});
+	return file;
+}
+
+static void ResolveEncryptionKey(const unordered_map<string, string> &encryption_keys, DuckLakeFileData &file) {
+	if (file.path.empty()) {
+		return;
+	}
+	auto entry = encryption_keys.find(file.path);
+	if (entry == encryption_keys.end()) {
+		throw InvalidInputException("Failed to deserialize DuckLake scan: no encryption key found for file %s",
+		                            file.path);
+	}
+	file.encryption_key = entry->second;
+}
+
+static void ResolveEncryptionKeys(DuckLakeFunctionInfo &read_info, vector<DuckLakeFileListEntry> &files) {
+	auto transaction = read_info.GetTransaction();
+	if (transaction->GetCatalog().Encryption() != DuckLakeEncryption::ENCRYPTED) {
+		return;
+	}
+	auto &metadata_manager = transaction->GetMetadataManager();
+	vector<DataFileIndex> file_ids;
+	for (auto &file : files) {
+		if (file.data_type == DuckLakeDataType::DATA_FILE) {
+			file_ids.push_back(file.file_id);
+		}
+	}
+	auto encryption_keys = metadata_manager.GetFileEncryptionKeys(read_info.table, read_info.snapshot, file_ids);
+	for (auto &file : files) {
+		if (file.data_type != DuckLakeDataType::DATA_FILE) {
+			continue;
+		}
+		ResolveEncryptionKey(encryption_keys, file.file);
+		ResolveEncryptionKey(encryption_keys, file.delete_file);
+	}
+}
+
+void DuckLakeMultiFileList::VerifyCommittedScan() {
+	if (HasTransactionLocalData() || read_info.table_id.IsTransactionLocal()) {
+		throw NotImplementedException("Scans of uncommitted data of a DuckLake table cannot be serialized");
+	}
+	auto transaction = read_info.GetTransaction();
+	if (transaction->HasDroppedFiles() || transaction->HasLocalDeletes(read_info.table_id)) {
+		throw NotImplementedException("Scans of uncommitted data of a DuckLake table cannot be serialized");
+	}
+}
+
+void DuckLakeMultiFileList::Serialize(Serializer &serializer) {
+	VerifyCommittedScan();
+	auto &files = GetFiles();
+	serializer.WriteList(100, "files", files.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			auto &file = files[i];
+			WriteFileData(object, 100, "file", file.file);
+			WriteFileData(object, 101, "delete_file", file.delete_file);
+			object.WriteProperty(102, "row_id_start", OptionalToIndex(file.row_id_start));
+			object.WriteProperty(103, "snapshot_id", OptionalToIndex(file.snapshot_id));
+			object.WriteProperty(104, "max_row_count", OptionalToIndex(file.max_row_count));
+			object.WriteProperty(105, "snapshot_filter", OptionalToIndex(file.snapshot_filter));
+			object.WriteProperty(106, "mapping_id", file.mapping_id.index);
+			object.WriteProperty(107, "data_type", static_cast<uint8_t>(file.data_type));
+			object.WriteProperty(108, "file_id", file.file_id.index);
+			object.WriteProperty(109, "row_count", OptionalToIndex(file.row_count));
+			object.WriteProperty(110, "delete_count", file.delete_count);
+		});
+	});
+	serializer.WriteList(101, "inlined_data_tables", inlined_data_tables.size(), [&](Serializer::List &list, idx_t i) {
+		list.WriteObject([&](Serializer &object) {
+			object.WriteProperty(100, "table_name", inlined_data_tables[i].table_name);
+			object.WriteProperty(101, "schema_version", inlined_data_tables[i].schema_version);
+		});
+	});
+}
+
+unique_ptr<DuckLakeMultiFileList> DuckLakeMultiFileList::Deserialize(Deserializer &deserializer,
+                                                                     DuckLakeFunctionInfo &read_info) {
+	vector<DuckLakeFileListEntry> files;
+	deserializer.ReadList(100, "files", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeFileListEntry file;
+			file.file = ReadFileData(object, 100, "file");
+			file.delete_file = ReadFileData(object, 101, "delete_file");
+			file.row_id_start = IndexToOptional(object.ReadProperty<idx_t>(102, "row_id_start"));
+			file.snapshot_id = IndexToOptional(object.ReadProperty<idx_t>(103, "snapshot_id"));
+			file.max_row_count = IndexToOptional(object.ReadProperty<idx_t>(104, "max_row_count"));
+			file.snapshot_filter = IndexToOptional(object.ReadProperty<idx_t>(105, "snapshot_filter"));
+			file.mapping_id = MappingIndex(object.ReadProperty<idx_t>(106, "mapping_id"));
+			file.data_type = static_cast<DuckLakeDataType>(object.ReadProperty<uint8_t>(107, "data_type"));
+			file.file_id = DataFileIndex(object.ReadProperty<idx_t>(108, "file_id"));
+			file.row_count = IndexToOptional(object.ReadProperty<idx_t>(109, "row_count"));
+			file.delete_count = object.ReadProperty<idx_t>(110, "delete_count");
+			files.push_back(std::move(file));
+		});
+	});
+	ResolveEncryptionKeys(read_info, files);
+	auto result = make_uniq<DuckLakeMultiFileList>(read_info, std::move(files));
+	deserializer.ReadList(101, "inlined_data_tables", [&](Deserializer::List &list, idx_t i) {
+		list.ReadObject([&](Deserializer &object) {
+			DuckLakeInlinedTableInfo inlined_table;
+			inlined_table.table_name = object.ReadProperty<string>(100, "table_name");
+			inlined_table.schema_version = object.ReadProperty<idx_t>(101, "schema_version");
+			result->inlined_data_tables.push_back(std::move(inlined_table));
+		});
+	});
+	return result;
+}
+
+vector<unique_ptr<DuckLakeMultiFileList>> DuckLakeMultiFileList::Split(idx_t count) {
+	VerifyCommittedScan();
+	auto &files = GetFiles();
+	count = MaxValue<idx_t>(count, 1);
+	// the inlined data tables are the last entries of the file list
+	idx_t data_file_count = files.size() - inlined_data_tables.size();
+	// assign the data files - largest first - to the part that reads the fewest bytes so far
+	vector<idx_t> data_files;
+	for (idx_t file_idx = 0; file_idx < data_file_count; file_idx++) {
+		data_files.push_back(file_idx);
+	}
+	std::stable_sort(data_files.begin(), data_files.end(), [&](idx_t a, idx_t b) {
+		return files[a].file.file_size_bytes > files[b].file.file_size_bytes;
+	});
+	vector<idx_t> part_sizes(count, 0);
+	vector<idx_t> file_parts(data_file_count, 0);
+	for (auto file_idx : data_files) {
+		idx_t part_idx = 0;
+		for (idx_t i = 1; i < count; i++) {
+			if (part_sizes[i] < part_sizes[part_idx]) {
+				part_idx = i;
+			}
+		}
+		part_sizes[part_idx] += MaxValue<idx_t>(files[file_idx].file.file_size_bytes, 1);
+		file_parts[file_idx] = part_idx;
+	}
+	vector<vector<DuckLakeFileListEntry>> part_files(count);
+	for (idx_t file_idx = 0; file_idx < data_file_count; file_idx++) {
+		// every part visits its files in the order of the original file list
+		part_files[file_parts[file_idx]].push_back(files[file_idx]);
+	}
+	// the size of the inlined data is not known up front - deal the inlined data tables out round-robin
+	vector<vector<DuckLakeInlinedTableInfo>> part_inlined_tables(count);
+	for (idx_t inlined_idx = 0; inlined_idx < inlined_data_tables.size(); inlined_idx++) {
+		auto part_idx = inlined_idx % count;
+		part_files[part_idx].push_back(files[data_file_count + inlined_idx]);
+		part_inlined_tables[part_idx].push_back(inlined_data_tables[inlined_idx]);
+	}
+	vector<unique_ptr<DuckLakeMultiFileList>> result;
+	for (idx_t part_idx = 0; part_idx < count; part_idx++) {
+		if (part_files[part_idx].empty() && !result.empty()) {
+			continue;
+		}
+		auto part = make_uniq<DuckLakeMultiFileList>(read_info, std::move(part_files[part_idx]));
+		part->inlined_data_tables = std::move(part_inlined_tables[part_idx]);
+		result.push_back(std::move(part));
+	}
+	return result;
+}
+
 const vector<DuckLakeFileListEntry> &DuckLakeMultiFileList::GetFiles() {
 	lock_guard<mutex> l(file_lock);
 	if (!read_file_list) {
 		// we have not read the file list yet - read it
+		auto start = std::chrono::steady_clock::now();
 		switch (read_info.scan_type) {
 		case DuckLakeScanType::SCAN_TABLE:
 			GetFilesForTable();
@@ -621,6 +1662,8 @@ const vector<DuckLakeFileListEntry> &DuckLakeMultiFileList::GetFiles() {
 		default:
 			throw InternalException("Unknown DuckLake scan type");
 		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		read_info.metrics.planning_time_us += NumericCast<idx_t>(elapsed.count());
 		read_file_list = true;
 	}
 	return files;
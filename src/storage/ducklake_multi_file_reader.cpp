@@ -2,6 +2,7 @@
 #include "storage/ducklake_multi_file_reader.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_data_file_cache.hpp"
 
 #include "duckdb/common/local_file_system.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
@@ -24,6 +25,8 @@
 #include "duckdb/function/function_binder.hpp"
 #include "storage/ducklake_inlined_data_reader.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "storage/ducklake_row_id_index.hpp"
 
 namespace duckdb {
 
@@ -108,6 +111,79 @@ void DuckLakeMultiFileReader::BindOptions(MultiFileOptions &options, MultiFileLi
                                           MultiFileReaderBindData &bind_data) {
 }
 
+//! Convert a filter on the row id into a filter on the file row number of a file whose row ids are computed as
+//! row_id_start + file_row_number - so the reader can skip the rows (and row groups) that cannot match
+static void PushRowIdFilter(BaseFileReader &reader, const DuckLakeFileListEntry &file_entry,
+                            const vector<ColumnIndex> &global_column_ids, const TableFilterSet &table_filters) {
+	if (!file_entry.row_id_start.IsValid()) {
+		return;
+	}
+	optional_ptr<const TableFilter> row_id_filter;
+	for (auto &entry : table_filters.filters) {
+		if (global_column_ids[entry.first].GetPrimaryIndex() == COLUMN_IDENTIFIER_ROW_ID) {
+			row_id_filter = entry.second.get();
+			break;
+		}
+	}
+	if (!row_id_filter) {
+		return;
+	}
+	for (auto &col : reader.columns) {
+		if (!col.identifier.IsNull() && col.identifier.GetValue<int32_t>() == MultiFileReader::ROW_ID_FIELD_ID) {
+			// the row ids are stored in the file - the filter is pushed into the row id column directly
+			return;
+		}
+	}
+	// the row id column is read as the file row number
+	optional_idx row_number_local_id;
+	for (idx_t i = 0; i < reader.column_indexes.size(); i++) {
+		if (reader.column_indexes[i].GetPrimaryIndex() == MultiFileReader::COLUMN_IDENTIFIER_FILE_ROW_NUMBER) {
+			row_number_local_id = i;
+			break;
+		}
+	}
+	if (!row_number_local_id.IsValid()) {
+		return;
+	}
+	auto ranges = DuckLakeRowIdIndex::GetRowIdRanges(*row_id_filter);
+	if (DuckLakeRowIdIndex::IsFullRange(ranges)) {
+		return;
+	}
+	auto row_ranges =
+	    DuckLakeRowIdIndex::GetFileRowRanges(ranges, file_entry.row_id_start.GetIndex(), file_entry.row_count);
+	unique_ptr<TableFilter> row_number_filter;
+	if (row_ranges.empty()) {
+		// none of the rows of this file can match
+		row_number_filter = make_uniq<ConstantFilter>(ExpressionType::COMPARE_LESSTHAN, Value::BIGINT(0));
+	} else {
+		auto or_filter = make_uniq<ConjunctionOrFilter>();
+		for (auto &range : row_ranges) {
+			auto start = Value::BIGINT(NumericCast<int64_t>(range.start));
+			if (range.end == range.start + 1) {
+				or_filter->child_filters.push_back(make_uniq<ConstantFilter>(ExpressionType::COMPARE_EQUAL, start));
+				continue;
+			}
+			auto and_filter = make_uniq<ConjunctionAndFilter>();
+			and_filter->child_filters.push_back(
+			    make_uniq<ConstantFilter>(ExpressionType::COMPARE_GREATERTHANOREQUALTO, start));
+			if (range.end <= NumericLimits<int64_t>::Maximum()) {
+				auto end = Value::BIGINT(NumericCast<int64_t>(range.end));
+				and_filter->child_filters.push_back(make_uniq<ConstantFilter>(ExpressionType::COMPARE_LESSTHAN, end));
+			}
+			or_filter->child_filters.push_back(std::move(and_filter));
+		}
+		if (or_filter->child_filters.size() == 1) {
+			row_number_filter = std::move(or_filter->child_filters[0]);
+		} else {
+			row_number_filter = std::move(or_filter);
+		}
+	}
+	if (!reader.filters) {
+		reader.filters = make_uniq<TableFilterSet>();
+	}
+	reader.filters->PushFilter(ColumnIndex(row_number_local_id.GetIndex()), std::move(row_number_filter));
+}
+
 ReaderInitializeType DuckLakeMultiFileReader::InitializeReader(MultiFileReaderData &reader_data,
                                                                const MultiFileBindData &bind_data,
                                                                const vector<MultiFileColumnDefinition> &global_columns,
@@ -119,9 +195,14 @@ ReaderInitializeType DuckLakeMultiFileReader::InitializeReader(MultiFileReaderDa
 	auto file_idx = reader.file_list_idx.GetIndex();
 
 	auto &file_entry = file_list.GetFileEntry(file_idx);
+	if (file_entry.data_type == DuckLakeDataType::DATA_FILE) {
+		read_info.metrics.data_files_read++;
+		read_info.metrics.data_file_bytes += file_entry.file.file_size_bytes;
+	}
 	if (!file_list.IsDeleteScan()) {
 		// regular scan - read the deletes from the delete file (if any) and apply the max row count
 		if (file_entry.data_type != DuckLakeDataType::DATA_FILE) {
+			read_info.metrics.inlined_data_read++;
 			auto transaction = read_info.GetTransaction();
 			auto inlined_deletes = transaction->GetInlinedDeletes(read_info.table.GetTableId(), file_entry.file.path);
 			if (inlined_deletes) {
@@ -132,7 +213,9 @@ ReaderInitializeType DuckLakeMultiFileReader::InitializeReader(MultiFileReaderDa
 		} else if (!file_entry.delete_file.path.empty() || file_entry.max_row_count.IsValid()) {
 			auto delete_filter = make_uniq<DuckLakeDeleteFilter>();
 			if (!file_entry.delete_file.path.empty()) {
-				delete_filter->Initialize(context, file_entry.delete_file);
+				read_info.metrics.delete_files_applied++;
+				auto transaction = read_info.GetTransaction();
+				delete_filter->Initialize(context, *transaction, file_entry.delete_file);
 			}
 			if (file_entry.max_row_count.IsValid()) {
 				delete_filter->SetMaxRowCount(file_entry.max_row_count.GetIndex());
@@ -147,7 +230,8 @@ ReaderInitializeType DuckLakeMultiFileReader::InitializeReader(MultiFileReaderDa
 		if (file_entry.data_type == DuckLakeDataType::DATA_FILE) {
 			auto &delete_entry = file_list.GetDeleteScanEntry(file_idx);
 			auto delete_filter = make_uniq<DuckLakeDeleteFilter>();
-			delete_filter->Initialize(context, delete_entry);
+			auto transaction = read_info.GetTransaction();
+			delete_filter->Initialize(context, *transaction, delete_entry);
 			reader.deletion_filter = std::move(delete_filter);
 		}
 	}
@@ -193,6 +277,9 @@ ReaderInitializeType DuckLakeMultiFileReader::InitializeReader(MultiFileReaderDa
 		    make_uniq<ConstantFilter>(ExpressionType::COMPARE_LESSTHANOREQUALTO, std::move(snapshot_filter_constant));
 		reader.filters->PushFilter(snapshot_col_idx, std::move(snapshot_filter));
 	}
+	if (table_filters && !file_list.IsDeleteScan() && file_entry.data_type == DuckLakeDataType::DATA_FILE) {
+		PushRowIdFilter(*reader_data.reader, file_entry, global_column_ids, *table_filters);
+	}
 	return result;
 }
 
@@ -250,7 +337,19 @@ shared_ptr<BaseFileReader> DuckLakeMultiFileReader::CreateReader(ClientContext &
 	if (reader) {
 		return reader;
 	}
-	return MultiFileReader::CreateReader(context, gstate, file, file_idx, bind_data);
+	auto cached_file = GetCachedFile(file);
+	if (!cached_file) {
+		return MultiFileReader::CreateReader(context, gstate, file, file_idx, bind_data);
+	}
+	try {
+		reader = MultiFileReader::CreateReader(context, gstate, *cached_file, file_idx, bind_data);
+	} catch (std::exception &ex) {
+		// the cached copy might have been evicted concurrently - read the file directly instead
+		return MultiFileReader::CreateReader(context, gstate, file, file_idx, bind_data);
+	}
+	// the reader has opened the local copy - refer to the original file from here on (e.g. for the filename column)
+	reader->file = file;
+	return reader;
 }
 
 shared_ptr<BaseFileReader> DuckLakeMultiFileReader::CreateReader(ClientContext &context, const OpenFileInfo &file,
@@ -261,7 +360,40 @@ shared_ptr<BaseFileReader> DuckLakeMultiFileReader::CreateReader(ClientContext &
 	if (reader) {
 		return reader;
 	}
-	return MultiFileReader::CreateReader(context, file, options, file_options, interface);
+	auto cached_file = GetCachedFile(file);
+	if (!cached_file) {
+		return MultiFileReader::CreateReader(context, file, options, file_options, interface);
+	}
+	try {
+		reader = MultiFileReader::CreateReader(context, *cached_file, options, file_options, interface);
+	} catch (std::exception &ex) {
+		// the cached copy might have been evicted concurrently - read the file directly instead
+		return MultiFileReader::CreateReader(context, file, options, file_options, interface);
+	}
+	reader->file = file;
+	return reader;
+}
+
+unique_ptr<OpenFileInfo> DuckLakeMultiFileReader::GetCachedFile(const OpenFileInfo &file) {
+	auto &catalog = read_info.table.ParentCatalog().Cast<DuckLakeCatalog>();
+	auto data_file_cache = catalog.GetDataFileCache();
+	if (!data_file_cache) {
+		return nullptr;
+	}
+	if (!file.extended_info) {
+		return nullptr;
+	}
+	auto entry = file.extended_info->options.find("file_size");
+	if (entry == file.extended_info->options.end()) {
+		return nullptr;
+	}
+	auto local_path = data_file_cache->GetLocalPath(file.path, entry->second.GetValue<idx_t>());
+	if (local_path == file.path) {
+		return nullptr;
+	}
+	auto result = make_uniq<OpenFileInfo>(file);
+	result->path = std::move(local_path);
+	return result;
 }
 
 vector<MultiFileColumnDefinition> MapColumns(MultiFileReaderData &reader_data,
@@ -322,6 +454,41 @@ vector<MultiFileColumnDefinition> CreateNewMapping(MultiFileReaderData &reader_d
 	return MapColumns(reader_data, global_map, name_map.column_maps);
 }
 
+static bool HasHivePartitionColumns(const vector<unique_ptr<DuckLakeNameMapEntry>> &column_maps) {
+	for (auto &column_map : column_maps) {
+		if (column_map->hive_partition || HasHivePartitionColumns(column_map->child_entries)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+shared_ptr<vector<MultiFileColumnDefinition>>
+DuckLakeMultiFileReader::GetMappedColumns(MultiFileReaderData &reader_data,
+                                          const vector<MultiFileColumnDefinition> &global_columns,
+                                          MappingIndex mapping_id) {
+	{
+		lock_guard<mutex> guard(mapping_lock);
+		auto entry = mapped_column_cache.find(mapping_id.index);
+		if (entry != mapped_column_cache.end() && entry->second.global_columns.get() == &global_columns) {
+			return entry->second.columns;
+		}
+	}
+	auto transaction = read_info.transaction.lock();
+	auto &mapping = transaction->GetMappingById(mapping_id);
+	auto result = make_shared_ptr<vector<MultiFileColumnDefinition>>(
+	    CreateNewMapping(reader_data, global_columns, mapping));
+	if (HasHivePartitionColumns(mapping.column_maps)) {
+		// the values of hive partition columns are taken from the path of the file - the mapping cannot be shared
+		return result;
+	}
+	lock_guard<mutex> guard(mapping_lock);
+	auto &cached_mapping = mapped_column_cache[mapping_id.index];
+	cached_mapping.global_columns = &global_columns;
+	cached_mapping.columns = result;
+	return result;
+}
+
 ReaderInitializeType DuckLakeMultiFileReader::CreateMapping(
     ClientContext &context, MultiFileReaderData &reader_data, const vector<MultiFileColumnDefinition> &global_columns,
     const vector<ColumnIndex> &global_column_ids, optional_ptr<TableFilterSet> filters, MultiFileList &multi_file_list,
@@ -331,11 +498,9 @@ ReaderInitializeType DuckLakeMultiFileReader::CreateMapping(
 		auto entry = file_options.find("mapping_id");
 		if (entry != file_options.end()) {
 			auto mapping_id = MappingIndex(entry->second.GetValue<idx_t>());
-			auto transaction = read_info.transaction.lock();
-			auto &mapping = transaction->GetMappingById(mapping_id);
 			// use the mapping to generate a new set of global columns for this file
-			auto mapped_columns = CreateNewMapping(reader_data, global_columns, mapping);
-			return MultiFileReader::CreateMapping(context, reader_data, mapped_columns, global_column_ids, filters,
+			auto mapped_columns = GetMappedColumns(reader_data, global_columns, mapping_id);
+			return MultiFileReader::CreateMapping(context, reader_data, *mapped_columns, global_column_ids, filters,
 			                                      multi_file_list, bind_data, virtual_columns,
 			                                      MultiFileColumnMappingMode::BY_NAME);
 		}
@@ -0,0 +1,684 @@
+#include "storage/ducklake_parquet_merge.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+//! The magic bytes at the start and the end of a Parquet file - files with an encrypted footer end in "PARE" instead
+static constexpr const char *PARQUET_MAGIC = "PAR1";
+static constexpr idx_t PARQUET_MAGIC_SIZE = 4;
+//! The Parquet footer is followed by its length (4 bytes) and the magic bytes (4 bytes)
+static constexpr idx_t PARQUET_FOOTER_TRAILER_SIZE = 8;
+static constexpr idx_t PARQUET_MERGE_BUFFER_SIZE = 1ULL << 20;
+//! The footer is only nested a few levels deep - anything deeper is a malformed footer
+static constexpr idx_t THRIFT_MAX_DEPTH = 64;
+//! Columns that DuckLake writes to files next to the table columns (e.g. the row ids of compacted files)
+static constexpr const char *DUCKLAKE_INTERNAL_COLUMN_PREFIX = "_ducklake_internal_";
+
+//===--------------------------------------------------------------------===//
+// Thrift Compact Protocol
+//===--------------------------------------------------------------------===//
+enum class ThriftCompactType : uint8_t {
+	STOP = 0,
+	BOOLEAN_TRUE = 1,
+	BOOLEAN_FALSE = 2,
+	BYTE = 3,
+	I16 = 4,
+	I32 = 5,
+	I64 = 6,
+	DOUBLE = 7,
+	BINARY = 8,
+	LIST = 9,
+	SET = 10,
+	MAP = 11,
+	STRUCT = 12
+};
+
+//! A value of the Thrift compact protocol - booleans have the type BOOLEAN_TRUE and store their value in "integer"
+struct ThriftCompactValue {
+	ThriftCompactType type = ThriftCompactType::STOP;
+	//! The value of booleans and integers
+	int64_t integer = 0;
+	//! The bytes of doubles and binaries
+	string binary;
+	//! The element type of lists and sets - or the key type of maps
+	ThriftCompactType element_type = ThriftCompactType::STOP;
+	//! The value type of maps
+	ThriftCompactType value_type = ThriftCompactType::STOP;
+	//! The elements of lists and sets, the keys and values of maps (alternating) or the fields of structs
+	vector<ThriftCompactValue> children;
+	//! The field ids of the fields of structs
+	vector<int16_t> field_ids;
+
+	optional_ptr<ThriftCompactValue> GetField(int16_t field_id) {
+		for (idx_t i = 0; i < field_ids.size(); i++) {
+			if (field_ids[i] == field_id) {
+				return children[i];
+			}
+		}
+		return nullptr;
+	}
+};
+
+class ThriftCompactReader {
+public:
+	ThriftCompactReader(const_data_ptr_t data, idx_t size) : data(data), size(size) {
+	}
+
+	ThriftCompactValue ReadStruct(idx_t depth = 0) {
+		ThriftCompactValue result;
+		result.type = ThriftCompactType::STRUCT;
+		int16_t last_field_id = 0;
+		while (true) {
+			auto header = ReadByte();
+			auto type = static_cast<ThriftCompactType>(header & 0x0F);
+			if (type == ThriftCompactType::STOP) {
+				break;
+			}
+			// the field id is either stored as the delta to the previous field id or - if that does not fit - in full
+			auto delta = header >> 4;
+			int16_t field_id;
+			if (delta == 0) {
+				field_id = static_cast<int16_t>(ReadZigZag());
+			} else {
+				field_id = static_cast<int16_t>(last_field_id + delta);
+			}
+			last_field_id = field_id;
+			result.field_ids.push_back(field_id);
+			result.children.push_back(ReadValue(type, false, depth + 1));
+		}
+		return result;
+	}
+
+private:
+	ThriftCompactValue ReadValue(ThriftCompactType type, bool in_container, idx_t depth) {
+		if (depth > THRIFT_MAX_DEPTH) {
+			throw InvalidInputException("Parquet footer is nested too deeply");
+		}
+		ThriftCompactValue result;
+		result.type = type;
+		switch (type) {
+		case ThriftCompactType::BOOLEAN_TRUE:
+		case ThriftCompactType::BOOLEAN_FALSE:
+			// booleans in structs are stored in the type of the field - in containers they take up a byte
+			result.type = ThriftCompactType::BOOLEAN_TRUE;
+			if (in_container) {
+				result.integer = ReadByte() == static_cast<uint8_t>(ThriftCompactType::BOOLEAN_TRUE);
+			} else {
+				result.integer = type == ThriftCompactType::BOOLEAN_TRUE;
+			}
+			break;
+		case ThriftCompactType::BYTE:
+			result.integer = static_cast<int8_t>(ReadByte());
+			break;
+		case ThriftCompactType::I16:
+		case ThriftCompactType::I32:
+		case ThriftCompactType::I64:
+			result.integer = ReadZigZag();
+			break;
+		case ThriftCompactType::DOUBLE:
+			result.binary = ReadBytes(sizeof(double));
+			break;
+		case ThriftCompactType::BINARY:
+			result.binary = ReadBytes(ReadVarint());
+			break;
+		case ThriftCompactType::LIST:
+		case ThriftCompactType::SET: {
+			auto header = ReadByte();
+			result.element_type = static_cast<ThriftCompactType>(header & 0x0F);
+			idx_t count = header >> 4;
+			if (count == 15) {
+				count = ReadVarint();
+			}
+			for (idx_t i = 0; i < count; i++) {
+				result.children.push_back(ReadValue(result.element_type, true, depth + 1));
+			}
+			break;
+		}
+		case ThriftCompactType::MAP: {
+			auto count = ReadVarint();
+			if (count > 0) {
+				auto types = ReadByte();
+				result.element_type = static_cast<ThriftCompactType>(types >> 4);
+				result.value_type = static_cast<ThriftCompactType>(types & 0x0F);
+			}
+			for (idx_t i = 0; i < count; i++) {
+				result.children.push_back(ReadValue(result.element_type, true, depth + 1));
+				result.children.push_back(ReadValue(result.value_type, true, depth + 1));
+			}
+			break;
+		}
+		case ThriftCompactType::STRUCT:
+			return ReadStruct(depth);
+		default:
+			throw InvalidInputException("Parquet footer contains an unknown Thrift type %d", static_cast<int>(type));
+		}
+		return result;
+	}
+
+	uint8_t ReadByte() {
+		if (position >= size) {
+			throw InvalidInputException("Parquet footer is truncated");
+		}
+		return data[position++];
+	}
+
+	uint64_t ReadVarint() {
+		uint64_t result = 0;
+		for (idx_t shift = 0; shift < 64; shift += 7) {
+			auto byte = ReadByte();
+			result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return result;
+			}
+		}
+		throw InvalidInputException("Parquet footer contains an invalid varint");
+	}
+
+	int64_t ReadZigZag() {
+		auto value = ReadVarint();
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	string ReadBytes(idx_t count) {
+		if (count > size - position) {
+			throw InvalidInputException("Parquet footer is truncated");
+		}
+		string result(const_char_ptr_cast(data + position), count);
+		position += count;
+		return result;
+	}
+
+private:
+	const_data_ptr_t data;
+	idx_t size;
+	idx_t position = 0;
+};
+
+class ThriftCompactWriter {
+public:
+	void WriteStruct(const ThriftCompactValue &value) {
+		int16_t last_field_id = 0;
+		for (idx_t i = 0; i < value.children.size(); i++) {
+			auto &field = value.children[i];
+			auto field_id = value.field_ids[i];
+			auto type = field.type;
+			if (type == ThriftCompactType::BOOLEAN_TRUE) {
+				type = field.integer ? ThriftCompactType::BOOLEAN_TRUE : ThriftCompactType::BOOLEAN_FALSE;
+			}
+			auto delta = static_cast<int32_t>(field_id) - static_cast<int32_t>(last_field_id);
+			if (delta > 0 && delta <= 15) {
+				WriteByte(static_cast<uint8_t>(delta << 4) | static_cast<uint8_t>(type));
+			} else {
+				WriteByte(static_cast<uint8_t>(type));
+				WriteZigZag(field_id);
+			}
+			last_field_id = field_id;
+			if (field.type != ThriftCompactType::BOOLEAN_TRUE) {
+				WriteValue(field, false);
+			}
+		}
+		WriteByte(static_cast<uint8_t>(ThriftCompactType::STOP));
+	}
+
+	const string &GetData() const {
+		return output;
+	}
+
+private:
+	void WriteValue(const ThriftCompactValue &value, bool in_container) {
+		switch (value.type) {
+		case ThriftCompactType::BOOLEAN_TRUE:
+			D_ASSERT(in_container);
+			WriteByte(static_cast<uint8_t>(value.integer ? ThriftCompactType::BOOLEAN_TRUE
+			                                             : ThriftCompactType::BOOLEAN_FALSE));
+			break;
+		case ThriftCompactType::BYTE:
+			WriteByte(static_cast<uint8_t>(value.integer));
+			break;
+		case ThriftCompactType::I16:
+		case ThriftCompactType::I32:
+		case ThriftCompactType::I64:
+			WriteZigZag(value.integer);
+			break;
+		case ThriftCompactType::DOUBLE:
+			output += value.binary;
+			break;
+		case ThriftCompactType::BINARY:
+			WriteVarint(value.binary.size());
+			output += value.binary;
+			break;
+		case ThriftCompactType::LIST:
+		case ThriftCompactType::SET: {
+			auto count = value.children.size();
+			if (count < 15) {
+				WriteByte(static_cast<uint8_t>(count << 4) | static_cast<uint8_t>(value.element_type));
+			} else {
+				WriteByte(0xF0 | static_cast<uint8_t>(value.element_type));
+				WriteVarint(count);
+			}
+			for (auto &child : value.children) {
+				WriteValue(child, true);
+			}
+			break;
+		}
+		case ThriftCompactType::MAP: {
+			auto count = value.children.size() / 2;
+			WriteVarint(count);
+			if (count > 0) {
+				WriteByte(static_cast<uint8_t>(static_cast<uint8_t>(value.element_type) << 4) |
+				          static_cast<uint8_t>(value.value_type));
+			}
+			for (auto &child : value.children) {
+				WriteValue(child, true);
+			}
+			break;
+		}
+		case ThriftCompactType::STRUCT:
+			WriteStruct(value);
+			break;
+		default:
+			throw InternalException("Unsupported Thrift type in ThriftCompactWriter");
+		}
+	}
+
+	void WriteByte(uint8_t byte) {
+		output.push_back(static_cast<char>(byte));
+	}
+
+	void WriteVarint(uint64_t value) {
+		while (value >= 0x80) {
+			WriteByte(static_cast<uint8_t>(value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		WriteByte(static_cast<uint8_t>(value));
+	}
+
+	void WriteZigZag(int64_t value) {
+		WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+private:
+	string output;
+};
+
+//===--------------------------------------------------------------------===//
+// Parquet Footer
+//===--------------------------------------------------------------------===//
+// field ids of the Parquet footer (see parquet.thrift)
+static constexpr int16_t FILE_METADATA_VERSION = 1;
+static constexpr int16_t FILE_METADATA_SCHEMA = 2;
+static constexpr int16_t FILE_METADATA_NUM_ROWS = 3;
+static constexpr int16_t FILE_METADATA_ROW_GROUPS = 4;
+static constexpr int16_t FILE_METADATA_KEY_VALUE_METADATA = 5;
+static constexpr int16_t FILE_METADATA_COLUMN_ORDERS = 7;
+static constexpr int16_t FILE_METADATA_ENCRYPTION_ALGORITHM = 8;
+static constexpr int16_t SCHEMA_ELEMENT_NAME = 4;
+static constexpr int16_t ROW_GROUP_COLUMNS = 1;
+static constexpr int16_t ROW_GROUP_FILE_OFFSET = 5;
+static constexpr int16_t ROW_GROUP_ORDINAL = 7;
+static constexpr int16_t COLUMN_CHUNK_FILE_PATH = 1;
+static constexpr int16_t COLUMN_CHUNK_FILE_OFFSET = 2;
+static constexpr int16_t COLUMN_CHUNK_META_DATA = 3;
+static constexpr int16_t COLUMN_CHUNK_OFFSET_INDEX_OFFSET = 4;
+static constexpr int16_t COLUMN_CHUNK_OFFSET_INDEX_LENGTH = 5;
+static constexpr int16_t COLUMN_CHUNK_COLUMN_INDEX_OFFSET = 6;
+static constexpr int16_t COLUMN_CHUNK_CRYPTO_METADATA = 8;
+static constexpr int16_t COLUMN_CHUNK_ENCRYPTED_COLUMN_METADATA = 9;
+static constexpr int16_t COLUMN_METADATA_DATA_PAGE_OFFSET = 9;
+static constexpr int16_t COLUMN_METADATA_INDEX_PAGE_OFFSET = 10;
+static constexpr int16_t COLUMN_METADATA_DICTIONARY_PAGE_OFFSET = 11;
+static constexpr int16_t COLUMN_METADATA_BLOOM_FILTER_OFFSET = 14;
+static constexpr int16_t OFFSET_INDEX_PAGE_LOCATIONS = 1;
+static constexpr int16_t PAGE_LOCATION_OFFSET = 1;
+
+struct DuckLakeParquetMergeSource {
+	string path;
+	//! The size of the row groups - i.e. the bytes between the leading magic bytes and the footer
+	idx_t data_size = 0;
+	ThriftCompactValue metadata;
+	//! The encoded fields of the footer that have to be identical between merged files (e.g. the schema)
+	string layout;
+	//! The decoded offset indexes of the column chunks that have one - in the order of the row groups and columns
+	vector<ThriftCompactValue> offset_indexes;
+};
+
+static bool IsStruct(optional_ptr<ThriftCompactValue> value) {
+	return value && value->type == ThriftCompactType::STRUCT;
+}
+
+static bool IsList(optional_ptr<ThriftCompactValue> value) {
+	return value && value->type == ThriftCompactType::LIST;
+}
+
+static bool IsInteger(optional_ptr<ThriftCompactValue> value) {
+	return value && (value->type == ThriftCompactType::I16 || value->type == ThriftCompactType::I32 ||
+	                 value->type == ThriftCompactType::I64);
+}
+
+//! Whether or not the row groups of a file can be copied into another file - i.e. all offsets in the footer are known
+static bool CanMergeFile(ThriftCompactValue &metadata) {
+	if (metadata.GetField(FILE_METADATA_ENCRYPTION_ALGORITHM)) {
+		return false;
+	}
+	if (!IsInteger(metadata.GetField(FILE_METADATA_NUM_ROWS))) {
+		return false;
+	}
+	auto schema = metadata.GetField(FILE_METADATA_SCHEMA);
+	if (!IsList(schema)) {
+		return false;
+	}
+	for (auto &schema_element : schema->children) {
+		if (schema_element.type != ThriftCompactType::STRUCT) {
+			return false;
+		}
+		auto name = schema_element.GetField(SCHEMA_ELEMENT_NAME);
+		if (name && StringUtil::StartsWith(name->binary, DUCKLAKE_INTERNAL_COLUMN_PREFIX)) {
+			// the file was written with DuckLake-internal columns - these are interpreted through the metadata of
+			// the file, which is not carried over to the merged file
+			return false;
+		}
+	}
+	auto row_groups = metadata.GetField(FILE_METADATA_ROW_GROUPS);
+	if (!IsList(row_groups)) {
+		return false;
+	}
+	for (auto &row_group : row_groups->children) {
+		if (row_group.type != ThriftCompactType::STRUCT) {
+			return false;
+		}
+		auto columns = row_group.GetField(ROW_GROUP_COLUMNS);
+		if (!IsList(columns)) {
+			return false;
+		}
+		for (auto &column_chunk : columns->children) {
+			if (column_chunk.type != ThriftCompactType::STRUCT) {
+				return false;
+			}
+			if (column_chunk.GetField(COLUMN_CHUNK_FILE_PATH) || column_chunk.GetField(COLUMN_CHUNK_CRYPTO_METADATA) ||
+			    column_chunk.GetField(COLUMN_CHUNK_ENCRYPTED_COLUMN_METADATA)) {
+				// column chunks stored in other files or encrypted column chunks
+				return false;
+			}
+			if (!IsStruct(column_chunk.GetField(COLUMN_CHUNK_META_DATA))) {
+				return false;
+			}
+			auto offset_index_offset = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_OFFSET);
+			if (offset_index_offset && (!IsInteger(offset_index_offset) ||
+			                            !IsInteger(column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_LENGTH)))) {
+				// we cannot find the offset index - so we cannot move the page locations it holds
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//! Encode the fields of the footer that describe the layout of the rows - these have to match to merge files
+static string GetFileLayout(ThriftCompactValue &metadata) {
+	ThriftCompactValue layout;
+	layout.type = ThriftCompactType::STRUCT;
+	for (auto field_id : {FILE_METADATA_VERSION, FILE_METADATA_SCHEMA, FILE_METADATA_KEY_VALUE_METADATA,
+	                      FILE_METADATA_COLUMN_ORDERS}) {
+		auto field = metadata.GetField(field_id);
+		if (field) {
+			layout.field_ids.push_back(field_id);
+			layout.children.push_back(*field);
+		}
+	}
+	ThriftCompactWriter writer;
+	writer.WriteStruct(layout);
+	return writer.GetData();
+}
+
+static void ShiftOffset(ThriftCompactValue &value, int16_t field_id, int64_t shift) {
+	auto field = value.GetField(field_id);
+	if (IsInteger(field)) {
+		field->integer += shift;
+	}
+}
+
+//! Read and decode the offset indexes of the column chunks of a file - they are read in a single read, as writers
+//! place them next to each other after the row groups. Returns false if they cannot be decoded.
+static bool ReadOffsetIndexes(FileHandle &handle, ThriftCompactValue &metadata, idx_t file_size,
+                              vector<ThriftCompactValue> &result) {
+	idx_t range_start = NumericLimits<idx_t>::Maximum();
+	idx_t range_end = 0;
+	for (auto &row_group : metadata.GetField(FILE_METADATA_ROW_GROUPS)->children) {
+		for (auto &column_chunk : row_group.GetField(ROW_GROUP_COLUMNS)->children) {
+			auto offset = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_OFFSET);
+			if (!offset) {
+				continue;
+			}
+			auto length = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_LENGTH)->integer;
+			if (offset->integer < 0 || length <= 0) {
+				return false;
+			}
+			range_start = MinValue<idx_t>(range_start, NumericCast<idx_t>(offset->integer));
+			range_end = MaxValue<idx_t>(range_end, NumericCast<idx_t>(offset->integer + length));
+		}
+	}
+	if (range_end == 0) {
+		// no offset indexes
+		return true;
+	}
+	if (range_end > file_size) {
+		return false;
+	}
+	auto range_size = range_end - range_start;
+	auto data = make_unsafe_uniq_array<data_t>(range_size);
+	handle.Read(data.get(), range_size, range_start);
+	for (auto &row_group : metadata.GetField(FILE_METADATA_ROW_GROUPS)->children) {
+		for (auto &column_chunk : row_group.GetField(ROW_GROUP_COLUMNS)->children) {
+			auto offset = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_OFFSET);
+			if (!offset) {
+				continue;
+			}
+			auto length = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_LENGTH)->integer;
+			try {
+				ThriftCompactReader reader(data.get() + (NumericCast<idx_t>(offset->integer) - range_start),
+				                           NumericCast<idx_t>(length));
+				result.push_back(reader.ReadStruct());
+			} catch (InvalidInputException &ex) {
+				return false;
+			}
+			auto page_locations = result.back().GetField(OFFSET_INDEX_PAGE_LOCATIONS);
+			if (!IsList(page_locations)) {
+				return false;
+			}
+			for (auto &page_location : page_locations->children) {
+				if (page_location.type != ThriftCompactType::STRUCT ||
+				    !IsInteger(page_location.GetField(PAGE_LOCATION_OFFSET))) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+//! Move the offsets of a row group that is copied to a different position in the merged file
+//! The offset indexes are handled separately - as they hold the positions of the pages themselves
+static void ShiftRowGroup(ThriftCompactValue &row_group, int64_t shift) {
+	ShiftOffset(row_group, ROW_GROUP_FILE_OFFSET, shift);
+	for (auto &column_chunk : row_group.GetField(ROW_GROUP_COLUMNS)->children) {
+		ShiftOffset(column_chunk, COLUMN_CHUNK_FILE_OFFSET, shift);
+		ShiftOffset(column_chunk, COLUMN_CHUNK_COLUMN_INDEX_OFFSET, shift);
+		auto &column_metadata = *column_chunk.GetField(COLUMN_CHUNK_META_DATA);
+		ShiftOffset(column_metadata, COLUMN_METADATA_DATA_PAGE_OFFSET, shift);
+		ShiftOffset(column_metadata, COLUMN_METADATA_INDEX_PAGE_OFFSET, shift);
+		ShiftOffset(column_metadata, COLUMN_METADATA_DICTIONARY_PAGE_OFFSET, shift);
+		ShiftOffset(column_metadata, COLUMN_METADATA_BLOOM_FILTER_OFFSET, shift);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Parquet Merge
+//===--------------------------------------------------------------------===//
+DuckLakeParquetMerge::DuckLakeParquetMerge(FileSystem &fs) : fs(fs) {
+}
+
+DuckLakeParquetMerge::~DuckLakeParquetMerge() {
+}
+
+bool DuckLakeParquetMerge::AddFile(const string &path, idx_t file_size) {
+	if (file_size < PARQUET_MAGIC_SIZE + PARQUET_FOOTER_TRAILER_SIZE) {
+		return false;
+	}
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	if (NumericCast<idx_t>(handle->GetFileSize()) != file_size) {
+		// the file does not match the metadata
+		return false;
+	}
+	char magic[PARQUET_MAGIC_SIZE];
+	handle->Read(magic, PARQUET_MAGIC_SIZE, 0);
+	uint8_t trailer[PARQUET_FOOTER_TRAILER_SIZE];
+	handle->Read(trailer, PARQUET_FOOTER_TRAILER_SIZE, file_size - PARQUET_FOOTER_TRAILER_SIZE);
+	if (memcmp(magic, PARQUET_MAGIC, PARQUET_MAGIC_SIZE) != 0 ||
+	    memcmp(trailer + 4, PARQUET_MAGIC, PARQUET_MAGIC_SIZE) != 0) {
+		// not a Parquet file - or a file with an encrypted footer
+		return false;
+	}
+	idx_t footer_size = static_cast<idx_t>(trailer[0]) | static_cast<idx_t>(trailer[1]) << 8 |
+	                    static_cast<idx_t>(trailer[2]) << 16 | static_cast<idx_t>(trailer[3]) << 24;
+	if (footer_size + PARQUET_MAGIC_SIZE + PARQUET_FOOTER_TRAILER_SIZE > file_size) {
+		return false;
+	}
+	auto footer = make_unsafe_uniq_array<data_t>(footer_size);
+	handle->Read(footer.get(), footer_size, file_size - PARQUET_FOOTER_TRAILER_SIZE - footer_size);
+
+	auto source = make_uniq<DuckLakeParquetMergeSource>();
+	try {
+		ThriftCompactReader reader(footer.get(), footer_size);
+		source->metadata = reader.ReadStruct();
+	} catch (InvalidInputException &ex) {
+		// a footer we cannot decode - the file is rewritten instead
+		return false;
+	}
+	if (!CanMergeFile(source->metadata)) {
+		return false;
+	}
+	if (!ReadOffsetIndexes(*handle, source->metadata, file_size, source->offset_indexes)) {
+		return false;
+	}
+	handle->Close();
+	source->layout = GetFileLayout(source->metadata);
+	if (!sources.empty() && sources[0]->layout != source->layout) {
+		// a file with a different schema
+		return false;
+	}
+	auto file_row_group_count = source->metadata.GetField(FILE_METADATA_ROW_GROUPS)->children.size();
+	if (row_group_count + file_row_group_count > NumericLimits<int16_t>::Maximum()) {
+		// the ordinal of row groups is a 16-bit integer
+		return false;
+	}
+	row_group_count += file_row_group_count;
+	source->path = path;
+	source->data_size = file_size - PARQUET_MAGIC_SIZE - PARQUET_FOOTER_TRAILER_SIZE - footer_size;
+	sources.push_back(std::move(source));
+	return true;
+}
+
+DuckLakeParquetMergeResult DuckLakeParquetMerge::Write(const string &path) {
+	if (sources.empty()) {
+		throw InternalException("DuckLakeParquetMerge - no files to merge");
+	}
+	// the footer of the merged file is the footer of the first file - with the row groups of all files
+	auto metadata = sources[0]->metadata;
+	auto &row_groups = *metadata.GetField(FILE_METADATA_ROW_GROUPS);
+	row_groups.children.clear();
+	idx_t data_end = PARQUET_MAGIC_SIZE;
+	for (auto &source : sources) {
+		data_end += source->data_size;
+	}
+	// the offset indexes hold the positions of the pages - the copied offset indexes are left unused, and offset
+	// indexes with the moved positions are written after the row groups of all files instead
+	ThriftCompactWriter offset_index_writer;
+	int64_t row_count = 0;
+	idx_t offset = PARQUET_MAGIC_SIZE;
+	for (auto &source : sources) {
+		// the row groups of the file move from right after its magic bytes to the current offset
+		auto shift = NumericCast<int64_t>(offset - PARQUET_MAGIC_SIZE);
+		idx_t offset_index_idx = 0;
+		for (auto &row_group : source->metadata.GetField(FILE_METADATA_ROW_GROUPS)->children) {
+			auto new_row_group = row_group;
+			ShiftRowGroup(new_row_group, shift);
+			for (auto &column_chunk : new_row_group.GetField(ROW_GROUP_COLUMNS)->children) {
+				auto offset_index_offset = column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_OFFSET);
+				if (!offset_index_offset) {
+					continue;
+				}
+				auto offset_index = source->offset_indexes[offset_index_idx++];
+				for (auto &page_location : offset_index.GetField(OFFSET_INDEX_PAGE_LOCATIONS)->children) {
+					ShiftOffset(page_location, PAGE_LOCATION_OFFSET, shift);
+				}
+				auto offset_index_start = offset_index_writer.GetData().size();
+				offset_index_writer.WriteStruct(offset_index);
+				offset_index_offset->integer = NumericCast<int64_t>(data_end + offset_index_start);
+				column_chunk.GetField(COLUMN_CHUNK_OFFSET_INDEX_LENGTH)->integer =
+				    NumericCast<int64_t>(offset_index_writer.GetData().size() - offset_index_start);
+			}
+			auto ordinal = new_row_group.GetField(ROW_GROUP_ORDINAL);
+			if (ordinal) {
+				ordinal->integer = NumericCast<int64_t>(row_groups.children.size());
+			}
+			row_groups.children.push_back(std::move(new_row_group));
+		}
+		row_count += source->metadata.GetField(FILE_METADATA_NUM_ROWS)->integer;
+		offset += source->data_size;
+	}
+	auto &offset_indexes = offset_index_writer.GetData();
+	offset += offset_indexes.size();
+	metadata.GetField(FILE_METADATA_NUM_ROWS)->integer = row_count;
+	ThriftCompactWriter writer;
+	writer.WriteStruct(metadata);
+	auto &footer = writer.GetData();
+
+	auto target = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	try {
+		char magic[PARQUET_MAGIC_SIZE];
+		memcpy(magic, PARQUET_MAGIC, PARQUET_MAGIC_SIZE);
+		target->Write(magic, PARQUET_MAGIC_SIZE);
+		auto buffer = make_unsafe_uniq_array<data_t>(PARQUET_MERGE_BUFFER_SIZE);
+		for (auto &source : sources) {
+			auto handle = fs.OpenFile(source->path, FileFlags::FILE_FLAGS_READ);
+			idx_t copied = 0;
+			while (copied < source->data_size) {
+				auto copy_size = MinValue<idx_t>(PARQUET_MERGE_BUFFER_SIZE, source->data_size - copied);
+				handle->Read(buffer.get(), copy_size, PARQUET_MAGIC_SIZE + copied);
+				target->Write(buffer.get(), copy_size);
+				copied += copy_size;
+			}
+		}
+		// the offset indexes are written together with the footer
+		auto footer_data_size = offset_indexes.size() + footer.size() + PARQUET_FOOTER_TRAILER_SIZE;
+		auto footer_data = make_unsafe_uniq_array<data_t>(footer_data_size);
+		memcpy(footer_data.get(), offset_indexes.data(), offset_indexes.size());
+		memcpy(footer_data.get() + offset_indexes.size(), footer.data(), footer.size());
+		auto trailer = footer_data.get() + offset_indexes.size() + footer.size();
+		auto footer_size = NumericCast<uint32_t>(footer.size());
+		for (idx_t i = 0; i < 4; i++) {
+			trailer[i] = static_cast<data_t>((footer_size >> (8 * i)) & 0xFF);
+		}
+		memcpy(trailer + 4, PARQUET_MAGIC, PARQUET_MAGIC_SIZE);
+		target->Write(footer_data.get(), footer_data_size);
+		target->Sync();
+		target->Close();
+	} catch (...) {
+		target.reset();
+		fs.TryRemoveFile(path);
+		throw;
+	}
+	DuckLakeParquetMergeResult result;
+	result.row_count = NumericCast<idx_t>(row_count);
+	result.file_size_bytes = offset + footer.size() + PARQUET_FOOTER_TRAILER_SIZE;
+	result.footer_size = footer.size();
+	return result;
+}
+
+} // namespace duckdb
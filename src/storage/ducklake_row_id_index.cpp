@@ -0,0 +1,214 @@
+#include "storage/ducklake_row_id_index.hpp"
+
+#include "duckdb/common/limits.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
+#include "duckdb/planner/table_filter.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static constexpr idx_t MAX_ROW_ID = NumericLimits<idx_t>::Maximum();
+
+DuckLakeRowIdIndex::DuckLakeRowIdIndex(const vector<DuckLakeFileListEntry> &files) : file_count(files.size()) {
+	for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+		auto &file = files[file_idx];
+		if (file.data_type != DuckLakeDataType::DATA_FILE || !file.row_id_start.IsValid() ||
+		    !file.row_count.IsValid()) {
+			unindexed_files.push_back(file_idx);
+			continue;
+		}
+		IndexEntry entry;
+		entry.start = file.row_id_start.GetIndex();
+		entry.end = entry.start + file.row_count.GetIndex();
+		entry.file_idx = file_idx;
+		entries.push_back(entry);
+	}
+	// files are listed in the order in which they were written - which is usually already the order of their row ids
+	std::sort(entries.begin(), entries.end(),
+	          [](const IndexEntry &a, const IndexEntry &b) { return a.start < b.start; });
+	max_end.reserve(entries.size());
+	for (auto &entry : entries) {
+		max_end.push_back(max_end.empty() ? entry.end : MaxValue<idx_t>(max_end.back(), entry.end));
+	}
+}
+
+//! Sort a set of ranges and merge the ranges that overlap or touch
+static vector<DuckLakeRowIdRange> NormalizeRanges(vector<DuckLakeRowIdRange> ranges) {
+	std::sort(ranges.begin(), ranges.end(),
+	          [](const DuckLakeRowIdRange &a, const DuckLakeRowIdRange &b) { return a.start < b.start; });
+	vector<DuckLakeRowIdRange> result;
+	for (auto &range : ranges) {
+		if (range.start >= range.end) {
+			continue;
+		}
+		if (!result.empty() && range.start <= result.back().end) {
+			result.back().end = MaxValue<idx_t>(result.back().end, range.end);
+			continue;
+		}
+		result.push_back(range);
+	}
+	return result;
+}
+
+static vector<DuckLakeRowIdRange> IntersectRanges(const vector<DuckLakeRowIdRange> &left,
+                                                  const vector<DuckLakeRowIdRange> &right) {
+	vector<DuckLakeRowIdRange> result;
+	idx_t left_idx = 0;
+	idx_t right_idx = 0;
+	while (left_idx < left.size() && right_idx < right.size()) {
+		auto start = MaxValue<idx_t>(left[left_idx].start, right[right_idx].start);
+		auto end = MinValue<idx_t>(left[left_idx].end, right[right_idx].end);
+		if (start < end) {
+			result.emplace_back(start, end);
+		}
+		// advance the range that ends first
+		if (left[left_idx].end < right[right_idx].end) {
+			left_idx++;
+		} else {
+			right_idx++;
+		}
+	}
+	return result;
+}
+
+static vector<DuckLakeRowIdRange> FullRange() {
+	vector<DuckLakeRowIdRange> result;
+	result.emplace_back(0, MAX_ROW_ID);
+	return result;
+}
+
+static vector<DuckLakeRowIdRange> GetComparisonRanges(ExpressionType comparison_type, const Value &constant) {
+	vector<DuckLakeRowIdRange> result;
+	Value row_id_value;
+	if (constant.IsNull() || !constant.type().IsIntegral() ||
+	    !constant.DefaultTryCastAs(LogicalType::BIGINT, row_id_value, nullptr)) {
+		return FullRange();
+	}
+	auto row_id = row_id_value.GetValue<int64_t>();
+	// row ids are never negative
+	auto clamped_row_id = row_id < 0 ? 0 : NumericCast<idx_t>(row_id);
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		if (row_id >= 0) {
+			result.emplace_back(clamped_row_id, clamped_row_id + 1);
+		}
+		return result;
+	case ExpressionType::COMPARE_LESSTHAN:
+		result.emplace_back(0, clamped_row_id);
+		return NormalizeRanges(std::move(result));
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		if (row_id >= 0) {
+			result.emplace_back(0, clamped_row_id + 1);
+		}
+		return result;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		result.emplace_back(row_id < 0 ? 0 : clamped_row_id + 1, MAX_ROW_ID);
+		return result;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		result.emplace_back(clamped_row_id, MAX_ROW_ID);
+		return result;
+	default:
+		return FullRange();
+	}
+}
+
+vector<DuckLakeRowIdRange> DuckLakeRowIdIndex::GetRowIdRanges(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		return GetComparisonRanges(constant_filter.comparison_type, constant_filter.constant);
+	}
+	case TableFilterType::IS_NULL:
+		// the row id is never NULL
+		return vector<DuckLakeRowIdRange>();
+	case TableFilterType::CONJUNCTION_AND: {
+		auto result = FullRange();
+		for (auto &child_filter : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			result = IntersectRanges(result, GetRowIdRanges(*child_filter));
+		}
+		return result;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		vector<DuckLakeRowIdRange> result;
+		for (auto &child_filter : filter.Cast<ConjunctionOrFilter>().child_filters) {
+			auto child_ranges = GetRowIdRanges(*child_filter);
+			result.insert(result.end(), child_ranges.begin(), child_ranges.end());
+		}
+		return NormalizeRanges(std::move(result));
+	}
+	case TableFilterType::IN_FILTER: {
+		vector<DuckLakeRowIdRange> result;
+		for (auto &value : filter.Cast<InFilter>().values) {
+			auto value_ranges = GetComparisonRanges(ExpressionType::COMPARE_EQUAL, value);
+			result.insert(result.end(), value_ranges.begin(), value_ranges.end());
+		}
+		return NormalizeRanges(std::move(result));
+	}
+	case TableFilterType::OPTIONAL_FILTER:
+		return GetRowIdRanges(*filter.Cast<OptionalFilter>().child_filter);
+	case TableFilterType::DYNAMIC_FILTER: {
+		auto &dynamic_filter = filter.Cast<DynamicFilter>();
+		if (!dynamic_filter.filter_data) {
+			return FullRange();
+		}
+		unique_ptr<TableFilter> current_filter;
+		{
+			lock_guard<mutex> guard(dynamic_filter.filter_data->lock);
+			if (!dynamic_filter.filter_data->initialized || !dynamic_filter.filter_data->filter) {
+				return FullRange();
+			}
+			current_filter = dynamic_filter.filter_data->filter->Copy();
+		}
+		return GetRowIdRanges(*current_filter);
+	}
+	default:
+		// unsupported filter - any row id can match
+		return FullRange();
+	}
+}
+
+bool DuckLakeRowIdIndex::IsFullRange(const vector<DuckLakeRowIdRange> &ranges) {
+	return ranges.size() == 1 && ranges[0].start == 0 && ranges[0].end == MAX_ROW_ID;
+}
+
+vector<DuckLakeRowIdRange> DuckLakeRowIdIndex::GetFileRowRanges(const vector<DuckLakeRowIdRange> &ranges,
+                                                                idx_t row_id_start, optional_idx row_count) {
+	vector<DuckLakeRowIdRange> file_range;
+	file_range.emplace_back(row_id_start, row_count.IsValid() ? row_id_start + row_count.GetIndex() : MAX_ROW_ID);
+	auto result = IntersectRanges(ranges, file_range);
+	for (auto &range : result) {
+		range.start -= row_id_start;
+		range.end = range.end == MAX_ROW_ID ? MAX_ROW_ID : range.end - row_id_start;
+	}
+	return result;
+}
+
+vector<bool> DuckLakeRowIdIndex::Evaluate(const vector<DuckLakeRowIdRange> &ranges) const {
+	vector<bool> result(file_count, false);
+	for (auto &file_idx : unindexed_files) {
+		result[file_idx] = true;
+	}
+	for (auto &range : ranges) {
+		// find the first file that starts at or after the end of the range - only the files before it can overlap
+		auto upper = std::lower_bound(entries.begin(), entries.end(), range.end,
+		                              [](const IndexEntry &entry, idx_t end) { return entry.start < end; });
+		for (auto entry_idx = NumericCast<idx_t>(upper - entries.begin()); entry_idx > 0; entry_idx--) {
+			auto &entry = entries[entry_idx - 1];
+			if (max_end[entry_idx - 1] <= range.start) {
+				// none of the remaining files end after the start of the range
+				break;
+			}
+			if (entry.end > range.start) {
+				result[entry.file_idx] = true;
+			}
+		}
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -5,11 +5,18 @@
 #include "storage/ducklake_stats.hpp"
 
 #include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
+#include "duckdb/common/serializer/deserializer.hpp"
+#include "duckdb/common/serializer/serializer.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/extension_helper.hpp"
 #include "duckdb/main/query_profiler.hpp"
 #include "duckdb/main/secret/secret_manager.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/tableref/bound_at_clause.hpp"
 
 namespace duckdb {
 
@@ -24,6 +31,32 @@ static InsertionOrderPreservingMap<string> DuckLakeFunctionToString(TableFunctio
 	return result;
 }
 
+//! The dynamic to_string of the parquet scan - which reports the amount of files read
+static table_function_dynamic_to_string_t parquet_dynamic_to_string;
+
+static InsertionOrderPreservingMap<string> DuckLakeFunctionDynamicToString(TableFunctionDynamicToStringInput &input) {
+	InsertionOrderPreservingMap<string> result;
+	if (parquet_dynamic_to_string) {
+		result = parquet_dynamic_to_string(input);
+	}
+	if (!input.table_function.function_info) {
+		return result;
+	}
+	auto &metrics = input.table_function.function_info->Cast<DuckLakeFunctionInfo>().metrics;
+	result["Catalog Files"] = to_string(metrics.catalog_files.load());
+	result["Zone Map Pruned Files"] = to_string(metrics.zone_map_pruned_files.load());
+	result["Row Id Pruned Files"] = to_string(metrics.row_id_pruned_files.load());
+	result["Data Files Read"] = to_string(metrics.data_files_read.load());
+	result["Data File Bytes"] = StringUtil::BytesToHumanReadableString(metrics.data_file_bytes.load());
+	result["Delete Files Applied"] = to_string(metrics.delete_files_applied.load());
+	result["Prefetched Files"] = to_string(metrics.prefetched_files.load());
+	result["Inlined Data Read"] = to_string(metrics.inlined_data_read.load());
+	result["Inlined Data Bytes"] = StringUtil::BytesToHumanReadableString(metrics.inlined_data_bytes.load());
+	result["Metadata Planning Time"] =
+	    StringUtil::Format("%.3fms", static_cast<double>(metrics.planning_time_us.load()) / 1000.0);
+	return result;
+}
+
 unique_ptr<BaseStatistics> DuckLakeStatistics(ClientContext &context, const FunctionData *bind_data,
                                               column_t column_index) {
 	if (IsVirtualColumn(column_index)) {
@@ -46,9 +79,61 @@ BindInfo DuckLakeBindInfo(const optional_ptr<FunctionData> bind_data) {
 	return BindInfo(file_list.GetTable());
 }
 
-void DuckLakeScanSerialize(Serializer &serializer, const optional_ptr<FunctionData> bind_data,
+void DuckLakeScanSerialize(Serializer &serializer, const optional_ptr<FunctionData> bind_data_p,
                            const TableFunction &function) {
-	throw NotImplementedException("DuckLakeScan not implemented");
+	if (!function.function_info) {
+		throw NotImplementedException("DuckLakeScan cannot be serialized without the table it scans");
+	}
+	auto &function_info = function.function_info->Cast<DuckLakeFunctionInfo>();
+	if (function_info.scan_type != DuckLakeScanType::SCAN_TABLE) {
+		throw NotImplementedException("Only scans of DuckLake tables can be serialized - not scans of their changes");
+	}
+	auto &bind_data = bind_data_p->Cast<MultiFileBindData>();
+	auto &file_list = bind_data.file_list->Cast<DuckLakeMultiFileList>();
+	auto &table = function_info.table;
+	serializer.WriteProperty(100, "catalog", table.ParentCatalog().GetName());
+	serializer.WriteProperty(101, "schema", table.ParentSchema().name);
+	serializer.WriteProperty(102, "table", function_info.table_name);
+	serializer.WriteProperty(103, "table_id", function_info.table_id.index);
+	// the scan is pinned to the snapshot it was planned at
+	serializer.WriteProperty(104, "snapshot_id", function_info.snapshot.snapshot_id);
+	serializer.WriteObject(105, "file_list", [&](Serializer &object) { file_list.Serialize(object); });
+}
+
+unique_ptr<FunctionData> DuckLakeScanDeserialize(Deserializer &deserializer, TableFunction &function) {
+	auto &context = deserializer.Get<ClientContext &>();
+	auto catalog_name = deserializer.ReadProperty<string>(100, "catalog");
+	auto schema_name = deserializer.ReadProperty<string>(101, "schema");
+	auto table_name = deserializer.ReadProperty<string>(102, "table");
+	auto table_id = TableIndex(deserializer.ReadProperty<idx_t>(103, "table_id"));
+	auto snapshot_id = deserializer.ReadProperty<idx_t>(104, "snapshot_id");
+
+	// look up the table at the pinned snapshot - and bind the scan the same way the planner does
+	auto &catalog = Catalog::GetCatalog(context, catalog_name);
+	BoundAtClause at_clause("version", Value::UBIGINT(snapshot_id));
+	EntryLookupInfo table_lookup(CatalogType::TABLE_ENTRY, table_name, &at_clause, QueryErrorContext());
+	auto entry = catalog.GetEntry(context, schema_name, table_lookup, OnEntryNotFound::THROW_EXCEPTION);
+	auto &table = entry->Cast<DuckLakeTableEntry>();
+	if (table.GetTableId() != table_id) {
+		throw InvalidInputException("Failed to deserialize DuckLake scan: table \"%s\" at snapshot %d is not the "
+		                            "table the scan was planned on",
+		                            table_name, snapshot_id);
+	}
+	unique_ptr<FunctionData> bind_data;
+	function = table.GetScanFunction(context, bind_data, table_lookup);
+
+	// use the serialized file list - instead of reading the file list from the metadata catalog again
+	auto &function_info = function.function_info->Cast<DuckLakeFunctionInfo>();
+	auto &multi_file_data = bind_data->Cast<MultiFileBindData>();
+	deserializer.ReadObject(105, "file_list", [&](Deserializer &object) {
+		multi_file_data.file_list = DuckLakeMultiFileList::Deserialize(object, function_info);
+	});
+	return bind_data;
+}
+
+static unique_ptr<FunctionData> DuckLakeScanStubBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	throw BinderException("ducklake_scan cannot be called directly - query the table of the DuckLake catalog instead");
 }
 
 virtual_column_map_t DuckLakeVirtualColumns(ClientContext &context, optional_ptr<FunctionData> bind_data_p) {
@@ -84,17 +169,92 @@ TableFunction DuckLakeFunctions::GetDuckLakeScanFunction(DatabaseInstance &insta
 	function.get_virtual_columns = DuckLakeVirtualColumns;
 	function.get_row_id_columns = DuckLakeGetRowIdColumn;
 
-	// Unset all of these: they are either broken, very inefficient.
-	// TODO: implement/fix these
+	// scans are serialized as the table, the pinned snapshot and the pruned file list
 	function.serialize = DuckLakeScanSerialize;
-	function.deserialize = nullptr;
+	function.deserialize = DuckLakeScanDeserialize;
 
 	function.to_string = DuckLakeFunctionToString;
+	parquet_dynamic_to_string = function.dynamic_to_string;
+	function.dynamic_to_string = DuckLakeFunctionDynamicToString;
 
 	function.name = "ducklake_scan";
 	return function;
 }
 
+TableFunction DuckLakeFunctions::GetDuckLakeScanDeserializeFunction() {
+	// serialized plans look up the ducklake_scan function by name when they are deserialized
+	// the deserializer replaces this function with the actual scan of the table
+	TableFunction function("ducklake_scan", {LogicalType::VARCHAR}, nullptr, DuckLakeScanStubBind);
+	function.serialize = DuckLakeScanSerialize;
+	function.deserialize = DuckLakeScanDeserialize;
+	return function;
+}
+
+vector<unique_ptr<FunctionData>> DuckLakeFunctions::SplitScan(const FunctionData &bind_data_p, idx_t count) {
+	auto &bind_data = bind_data_p.Cast<MultiFileBindData>();
+	auto &file_list = bind_data.file_list->Cast<DuckLakeMultiFileList>();
+	vector<unique_ptr<FunctionData>> result;
+	for (auto &part : file_list.Split(count)) {
+		auto part_data = bind_data.Copy();
+		part_data->Cast<MultiFileBindData>().file_list = std::move(part);
+		result.push_back(std::move(part_data));
+	}
+	return result;
+}
+
+optional_ptr<const DuckLakeFieldId> DuckLakeFunctions::GetScanColumn(LogicalGet &get, DuckLakeTableEntry &table,
+                                                                    idx_t column_index) {
+	auto &column_ids = get.GetColumnIds();
+	if (column_index >= column_ids.size()) {
+		return nullptr;
+	}
+	auto &column = column_ids[column_index];
+	if (column.HasChildren() || IsVirtualColumn(column.GetPrimaryIndex())) {
+		return nullptr;
+	}
+	return &table.GetFieldId(PhysicalIndex(column.GetPrimaryIndex()));
+}
+
+optional_ptr<LogicalGet> DuckLakeFunctions::FindScanColumn(LogicalOperator &op, const ColumnBinding &binding,
+                                                           idx_t &column_index) {
+	switch (op.type) {
+	case LogicalOperatorType::LOGICAL_PROJECTION: {
+		auto &projection = op.Cast<LogicalProjection>();
+		if (binding.table_index != projection.table_index || binding.column_index >= projection.expressions.size()) {
+			return nullptr;
+		}
+		auto &expr = *projection.expressions[binding.column_index];
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return nullptr;
+		}
+		return FindScanColumn(*op.children[0], expr.Cast<BoundColumnRefExpression>().binding, column_index);
+	}
+	case LogicalOperatorType::LOGICAL_FILTER: {
+		auto &filter = op.Cast<LogicalFilter>();
+		if (!filter.projection_map.empty()) {
+			return nullptr;
+		}
+		return FindScanColumn(*op.children[0], binding, column_index);
+	}
+	case LogicalOperatorType::LOGICAL_GET: {
+		auto &get = op.Cast<LogicalGet>();
+		if (binding.table_index != get.table_index) {
+			return nullptr;
+		}
+		column_index = binding.column_index;
+		if (!get.projection_ids.empty()) {
+			if (column_index >= get.projection_ids.size()) {
+				return nullptr;
+			}
+			column_index = get.projection_ids[column_index];
+		}
+		return &get;
+	}
+	default:
+		return nullptr;
+	}
+}
+
 DuckLakeFunctionInfo::DuckLakeFunctionInfo(DuckLakeTableEntry &table, DuckLakeTransaction &transaction_p,
                                            DuckLakeSnapshot snapshot)
     : table(table), transaction(transaction_p.shared_from_this()), snapshot(snapshot) {
@@ -0,0 +1,54 @@
+#include "storage/ducklake_scan_order_optimizer.hpp"
+
+#include "duckdb/common/multi_file/multi_file_function.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_order.hpp"
+#include "storage/ducklake_multi_file_list.hpp"
+#include "storage/ducklake_scan.hpp"
+#include "storage/ducklake_table_entry.hpp"
+#include "storage/ducklake_zone_map.hpp"
+
+namespace duckdb {
+
+DuckLakeScanOrderOptimizer::DuckLakeScanOrderOptimizer() {
+	optimize_function = DuckLakeScanOrderOptimizer::Optimize;
+}
+
+static void SetScanOrder(LogicalOrder &order) {
+	if (order.orders.empty() || order.children.size() != 1) {
+		return;
+	}
+	auto &order_node = order.orders[0];
+	if (order_node.expression->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return;
+	}
+	auto &colref = order_node.expression->Cast<BoundColumnRefExpression>();
+	idx_t column_index;
+	auto get = DuckLakeFunctions::FindScanColumn(*order.children[0], colref.binding, column_index);
+	if (!get || get->function.name != "ducklake_scan" || !get->function.function_info || !get->bind_data) {
+		return;
+	}
+	auto &read_info = get->function.function_info->Cast<DuckLakeFunctionInfo>();
+	if (read_info.scan_type != DuckLakeScanType::SCAN_TABLE) {
+		return;
+	}
+	auto field_id = DuckLakeFunctions::GetScanColumn(*get, read_info.table, column_index);
+	if (!field_id || !DuckLakeColumnZoneMap::SupportsType(field_id->Type())) {
+		return;
+	}
+	auto &bind_data = get->bind_data->Cast<MultiFileBindData>();
+	auto &file_list = bind_data.file_list->Cast<DuckLakeMultiFileList>();
+	file_list.SetScanOrder(field_id->GetFieldIndex(), order_node.type == OrderType::DESCENDING);
+}
+
+void DuckLakeScanOrderOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	for (auto &child : plan->children) {
+		Optimize(input, child);
+	}
+	if (plan->type == LogicalOperatorType::LOGICAL_ORDER_BY) {
+		SetScanOrder(plan->Cast<LogicalOrder>());
+	}
+}
+
+} // namespace duckdb
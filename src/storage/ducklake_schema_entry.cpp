@@ -248,7 +248,8 @@ void DuckLakeSchemaEntry::Scan(ClientContext &context, CatalogType type,
 			callback(*entry.second);
 		}
 	}
-	// scan committed entries
+	// scan committed entries - all tables need to be loaded first
+	LoadLazyEntries(duck_transaction);
 	auto &catalog_set = GetCatalogSet(type);
 	for (auto &entry : catalog_set.GetEntries()) {
 		if (duck_transaction.IsDeleted(*entry.second) || duck_transaction.IsRenamed(*entry.second)) {
@@ -320,7 +321,16 @@ optional_ptr<CatalogEntry> DuckLakeSchemaEntry::LookupEntry(CatalogTransaction t
 	auto &catalog_set = GetCatalogSet(catalog_type);
 	auto entry = catalog_set.GetEntry(entry_name);
 	if (!entry) {
-		return nullptr;
+		auto lazy_id = catalog_set.GetLazyEntry(entry_name);
+		if (!lazy_id.IsValid()) {
+			return nullptr;
+		}
+		// the table has not been loaded yet - load it now
+		LoadLazyEntries(duck_transaction, vector<TableIndex> {lazy_id});
+		entry = catalog_set.GetEntry(entry_name);
+		if (!entry) {
+			return nullptr;
+		}
 	}
 	if (duck_transaction.IsDeleted(*entry) || duck_transaction.IsRenamed(*entry)) {
 		return nullptr;
@@ -333,7 +343,28 @@ void DuckLakeSchemaEntry::AddEntry(CatalogType type, unique_ptr<CatalogEntry> en
 	catalog_set.CreateEntry(std::move(entry));
 }
 
+void DuckLakeSchemaEntry::AddLazyEntry(DuckLakeCatalogSet &schema_set, const string &name, TableIndex id) {
+	lazy_schema_set = schema_set;
+	tables.AddLazyEntry(name, id);
+}
+
+void DuckLakeSchemaEntry::LoadLazyEntries(DuckLakeTransaction &transaction, const vector<TableIndex> &table_ids) {
+	if (!lazy_schema_set || table_ids.empty()) {
+		return;
+	}
+	auto &ducklake_catalog = ParentCatalog().Cast<DuckLakeCatalog>();
+	ducklake_catalog.LoadLazyEntries(transaction, *lazy_schema_set, table_ids);
+}
+
+void DuckLakeSchemaEntry::LoadLazyEntries(DuckLakeTransaction &transaction) {
+	if (!lazy_schema_set) {
+		return;
+	}
+	LoadLazyEntries(transaction, tables.GetLazyEntries());
+}
+
 void DuckLakeSchemaEntry::TryDropSchema(DuckLakeTransaction &transaction, bool cascade) {
+	LoadLazyEntries(transaction);
 	if (!cascade) {
 		// get a list of all dependents
 		vector<reference<CatalogEntry>> dependents;
@@ -2,11 +2,20 @@
 #include "duckdb/common/types/string.hpp"
 #include "duckdb/common/types/value.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/common/algorithm.hpp"
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/limits.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
+#include "storage/ducklake_zone_map.hpp"
 
 #include "yyjson.hpp"
 
+#include <cmath>
+
 namespace duckdb {
 
 using namespace duckdb_yyjson; // NOLINT
@@ -23,6 +32,9 @@ DuckLakeColumnStats::DuckLakeColumnStats(const DuckLakeColumnStats &other) {
 	has_max = other.has_max;
 	any_valid = other.any_valid;
 	has_contains_nan = other.has_contains_nan;
+	typed_min = other.typed_min;
+	typed_max = other.typed_max;
+	typed_stats_initialized = other.typed_stats_initialized;
 
 	if (other.extra_stats) {
 		extra_stats = other.extra_stats->Copy();
@@ -44,6 +56,9 @@ DuckLakeColumnStats &DuckLakeColumnStats::operator=(const DuckLakeColumnStats &o
 	has_max = other.has_max;
 	any_valid = other.any_valid;
 	has_contains_nan = other.has_contains_nan;
+	typed_min = other.typed_min;
+	typed_max = other.typed_max;
+	typed_stats_initialized = other.typed_stats_initialized;
 
 	if (other.extra_stats) {
 		extra_stats = other.extra_stats->Copy();
@@ -53,10 +68,125 @@ DuckLakeColumnStats &DuckLakeColumnStats::operator=(const DuckLakeColumnStats &o
 	return *this;
 }
 
+//! Whether or not the stats of the type are compared in their typed representation rather than as text
+static bool UseTypedStats(const LogicalType &type) {
+	if (type.IsNumeric()) {
+		return true;
+	}
+	switch (type.id()) {
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::TIMESTAMP_SEC:
+	case LogicalTypeId::TIMESTAMP_MS:
+	case LogicalTypeId::TIMESTAMP_NS:
+		// the text of e.g. dates before year 0 or after year 9999 does not sort in the order of the values
+		return true;
+	default:
+		return false;
+	}
+}
+
+template <class T>
+static bool TryParseNativeStats(const string &text, Value &result) {
+	T value;
+	if (!TryCast::Operation<string_t, T>(string_t(text), value, false)) {
+		return false;
+	}
+	result = Value::CreateValue<T>(value);
+	return true;
+}
+
+//! Parse the stats directly into their native representation - this does not go through a (heap-allocated) VARCHAR
+//! value, which keeps merging the stats of many files cheap
+static bool TryParseNativeStats(const LogicalType &type, const string &text, Value &result) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+		return TryParseNativeStats<int8_t>(text, result);
+	case LogicalTypeId::SMALLINT:
+		return TryParseNativeStats<int16_t>(text, result);
+	case LogicalTypeId::INTEGER:
+		return TryParseNativeStats<int32_t>(text, result);
+	case LogicalTypeId::BIGINT:
+		return TryParseNativeStats<int64_t>(text, result);
+	case LogicalTypeId::UTINYINT:
+		return TryParseNativeStats<uint8_t>(text, result);
+	case LogicalTypeId::USMALLINT:
+		return TryParseNativeStats<uint16_t>(text, result);
+	case LogicalTypeId::UINTEGER:
+		return TryParseNativeStats<uint32_t>(text, result);
+	case LogicalTypeId::UBIGINT:
+		return TryParseNativeStats<uint64_t>(text, result);
+	case LogicalTypeId::HUGEINT:
+		return TryParseNativeStats<hugeint_t>(text, result);
+	case LogicalTypeId::UHUGEINT:
+		return TryParseNativeStats<uhugeint_t>(text, result);
+	case LogicalTypeId::FLOAT:
+		return TryParseNativeStats<float>(text, result);
+	case LogicalTypeId::DOUBLE:
+		return TryParseNativeStats<double>(text, result);
+	case LogicalTypeId::DATE:
+		return TryParseNativeStats<date_t>(text, result);
+	case LogicalTypeId::TIME:
+		return TryParseNativeStats<dtime_t>(text, result);
+	case LogicalTypeId::TIMESTAMP:
+		return TryParseNativeStats<timestamp_t>(text, result);
+	default:
+		return false;
+	}
+}
+
+//! Parse the stats into the type of the column - or a NULL value if the type is compared as text
+static Value ParseTypedStats(const LogicalType &type, const string &text) {
+	Value result;
+	if (!UseTypedStats(type)) {
+		return result;
+	}
+	if (TryParseNativeStats(type, text, result)) {
+		return result;
+	}
+	// other types (e.g. decimals) are parsed through a value
+	if (!Value(text).DefaultTryCastAs(type, result, nullptr)) {
+		return Value();
+	}
+	return result;
+}
+
+void DuckLakeColumnStats::InitializeTypedStats() {
+	typed_min = has_min ? ParseTypedStats(type, min) : Value();
+	typed_max = has_max ? ParseTypedStats(type, max) : Value();
+	typed_stats_initialized = true;
+}
+
+Value DuckLakeColumnStats::GetTypedMin() const {
+	if (typed_stats_initialized) {
+		return typed_min;
+	}
+	return ParseTypedStats(type, min);
+}
+
+Value DuckLakeColumnStats::GetTypedMax() const {
+	if (typed_stats_initialized) {
+		return typed_max;
+	}
+	return ParseTypedStats(type, max);
+}
+
+//! Returns whether the stats value "left" is smaller than the stats value "right"
+static bool StatsLessThan(const Value &left_typed, const Value &right_typed, const string &left, const string &right) {
+	if (!left_typed.IsNull() && !right_typed.IsNull()) {
+		return left_typed < right_typed;
+	}
+	// for other types we can compare the strings directly
+	return left < right;
+}
+
 void DuckLakeColumnStats::MergeStats(const DuckLakeColumnStats &new_stats) {
 	if (type != new_stats.type) {
 		// handle type promotion - adopt the new type
 		type = new_stats.type;
+		typed_stats_initialized = false;
 	}
 	if (!new_stats.has_null_count) {
 		has_null_count = false;
@@ -85,43 +215,37 @@ void DuckLakeColumnStats::MergeStats(const DuckLakeColumnStats &new_stats) {
 		max = new_stats.max;
 		has_max = new_stats.has_max;
 		any_valid = true;
+		typed_stats_initialized = false;
 		return;
 	}
+	if (!typed_stats_initialized) {
+		InitializeTypedStats();
+	}
+	// stats of the same type that were already parsed are used as-is - otherwise only the merged-in side is parsed
+	bool new_stats_typed = new_stats.typed_stats_initialized && new_stats.type == type;
 	if (!new_stats.has_min) {
 		has_min = false;
 	} else if (has_min) {
 		// both stats have a min - select the smallest
-		if (type.IsNumeric()) {
-			// for numerics we need to parse the stats
-			auto current_min = Value(min).DefaultCastAs(type);
-			auto new_min = Value(new_stats.min).DefaultCastAs(type);
-			if (new_min < current_min) {
-				min = new_stats.min;
-			}
-		} else if (new_stats.min < min) {
-			// for other types we can compare the strings directly
+		auto new_min = new_stats_typed ? new_stats.typed_min : ParseTypedStats(type, new_stats.min);
+		if (StatsLessThan(new_min, typed_min, new_stats.min, min)) {
 			min = new_stats.min;
+			typed_min = std::move(new_min);
 		}
 	}
 
 	if (!new_stats.has_max) {
 		has_max = false;
 	} else if (has_max) {
-		// both stats have a min - select the smallest
-		if (type.IsNumeric()) {
-			// for numerics we need to parse the stats
-			auto current_max = Value(max).DefaultCastAs(type);
-			auto new_max = Value(new_stats.max).DefaultCastAs(type);
-			if (new_max > current_max) {
-				max = new_stats.max;
-			}
-		} else if (new_stats.max > max) {
-			// for other types we can compare the strings directly
+		// both stats have a max - select the largest
+		auto new_max = new_stats_typed ? new_stats.typed_max : ParseTypedStats(type, new_stats.max);
+		if (StatsLessThan(typed_max, new_max, max, new_stats.max)) {
 			max = new_stats.max;
+			typed_max = std::move(new_max);
 		}
 	}
 
-	if (new_stats.extra_stats) {
+	if (new_stats.extra_stats && new_stats.extra_stats->IsTableStats()) {
 		if (extra_stats) {
 			extra_stats->Merge(*new_stats.extra_stats);
 		} else {
@@ -130,10 +254,88 @@ void DuckLakeColumnStats::MergeStats(const DuckLakeColumnStats &new_stats) {
 	}
 }
 
+void DuckLakeColumnStatsMap::clear() {
+	entries.clear();
+	positions.clear();
+}
+
+idx_t DuckLakeColumnStatsMap::GetPosition(FieldIndex field_index) const {
+	if (field_index.index < MAX_DIRECT_INDEX) {
+		if (field_index.index >= positions.size()) {
+			return DConstants::INVALID_INDEX;
+		}
+		return positions[field_index.index];
+	}
+	auto entry = std::lower_bound(entries.begin(), entries.end(), field_index,
+	                              [](const value_type &entry, FieldIndex index) { return entry.first < index; });
+	if (entry == entries.end() || entry->first != field_index) {
+		return DConstants::INVALID_INDEX;
+	}
+	return NumericCast<idx_t>(entry - entries.begin());
+}
+
+void DuckLakeColumnStatsMap::UpdatePositions(idx_t start) {
+	for (idx_t pos = start; pos < entries.size(); pos++) {
+		auto index = entries[pos].first.index;
+		if (index >= MAX_DIRECT_INDEX) {
+			// the remaining entries are looked up through a binary search
+			break;
+		}
+		if (index >= positions.size()) {
+			positions.resize(index + 1, DConstants::INVALID_INDEX);
+		}
+		positions[index] = pos;
+	}
+}
+
+DuckLakeColumnStatsMap::iterator DuckLakeColumnStatsMap::find(FieldIndex field_index) {
+	auto pos = GetPosition(field_index);
+	if (pos == DConstants::INVALID_INDEX) {
+		return entries.end();
+	}
+	return entries.begin() + NumericCast<int64_t>(pos);
+}
+
+DuckLakeColumnStatsMap::const_iterator DuckLakeColumnStatsMap::find(FieldIndex field_index) const {
+	auto pos = GetPosition(field_index);
+	if (pos == DConstants::INVALID_INDEX) {
+		return entries.end();
+	}
+	return entries.begin() + NumericCast<int64_t>(pos);
+}
+
+pair<DuckLakeColumnStatsMap::iterator, bool> DuckLakeColumnStatsMap::insert(value_type entry) {
+	auto pos = GetPosition(entry.first);
+	if (pos != DConstants::INVALID_INDEX) {
+		return make_pair(entries.begin() + NumericCast<int64_t>(pos), false);
+	}
+	if (entries.empty() || entries.back().first < entry.first) {
+		// fields are almost always added in order - append
+		entries.push_back(std::move(entry));
+		pos = entries.size() - 1;
+	} else {
+		auto insert_pos =
+		    std::lower_bound(entries.begin(), entries.end(), entry.first,
+		                     [](const value_type &existing, FieldIndex index) { return existing.first < index; });
+		pos = NumericCast<idx_t>(insert_pos - entries.begin());
+		entries.insert(insert_pos, std::move(entry));
+	}
+	UpdatePositions(pos);
+	return make_pair(entries.begin() + NumericCast<int64_t>(pos), true);
+}
+
+pair<DuckLakeColumnStatsMap::iterator, bool> DuckLakeColumnStatsMap::emplace(FieldIndex field_index,
+                                                                             DuckLakeColumnStats stats) {
+	return insert(make_pair(field_index, std::move(stats)));
+}
+
 void DuckLakeTableStats::MergeStats(FieldIndex col_id, const DuckLakeColumnStats &file_stats) {
 	auto entry = column_stats.find(col_id);
 	if (entry == column_stats.end()) {
-		column_stats.insert(make_pair(col_id, file_stats));
+		auto &new_stats = column_stats.insert(make_pair(col_id, file_stats)).first->second;
+		if (new_stats.extra_stats && !new_stats.extra_stats->IsTableStats()) {
+			new_stats.extra_stats.reset();
+		}
 		return;
 	}
 	// merge the stats
@@ -145,13 +347,14 @@ unique_ptr<BaseStatistics> DuckLakeColumnStats::CreateNumericStats() const {
 	if (!has_min || !has_max) {
 		return nullptr;
 	}
+	auto min_val = GetTypedMin();
+	auto max_val = GetTypedMax();
+	if (min_val.IsNull() || max_val.IsNull()) {
+		return nullptr;
+	}
 	auto stats = NumericStats::CreateEmpty(type);
-	// set min
-	Value min_val(min);
-	NumericStats::SetMin(stats, min_val.DefaultCastAs(type));
-	// set max
-	Value max_val(max);
-	NumericStats::SetMax(stats, max_val.DefaultCastAs(type));
+	NumericStats::SetMin(stats, min_val);
+	NumericStats::SetMax(stats, max_val);
 	// set null count
 	if (!has_null_count || null_count > 0) {
 		stats.SetHasNull();
@@ -329,4 +532,377 @@ void DuckLakeColumnGeoStats::Deserialize(const string &stats) {
 	yyjson_doc_free(doc);
 }
 
+DuckLakeColumnBloomFilterStats::DuckLakeColumnBloomFilterStats() : DuckLakeColumnExtraStats() {
+}
+
+DuckLakeColumnBloomFilterStats::DuckLakeColumnBloomFilterStats(const LogicalType &type_p, idx_t distinct_count)
+    : DuckLakeColumnExtraStats(), type(type_p.ToString()) {
+	idx_t bit_count = MIN_BIT_COUNT;
+	while (bit_count < distinct_count * BITS_PER_VALUE && bit_count < MAX_BIT_COUNT) {
+		bit_count *= 2;
+	}
+	bits.resize(bit_count / 64, 0);
+}
+
+unique_ptr<DuckLakeColumnExtraStats> DuckLakeColumnBloomFilterStats::Copy() const {
+	return make_uniq<DuckLakeColumnBloomFilterStats>(*this);
+}
+
+void DuckLakeColumnBloomFilterStats::Merge(const DuckLakeColumnExtraStats &new_stats) {
+	auto &bloom_stats = new_stats.Cast<DuckLakeColumnBloomFilterStats>();
+	if (bloom_stats.bits.size() != bits.size() || bloom_stats.type != type) {
+		// we cannot merge Bloom filters of different sizes - set all bits so we never prune
+		for (auto &entry : bits) {
+			entry = NumericLimits<uint64_t>::Maximum();
+		}
+		return;
+	}
+	for (idx_t i = 0; i < bits.size(); i++) {
+		bits[i] |= bloom_stats.bits[i];
+	}
+}
+
+void DuckLakeColumnBloomFilterStats::Insert(hash_t hash) {
+	idx_t bit_count = bits.size() * 64;
+	// derive the bit positions from the two halves of the hash (double hashing)
+	uint64_t h1 = hash;
+	uint64_t h2 = (hash >> 32) | 1;
+	for (idx_t i = 0; i < HASH_COUNT; i++) {
+		auto bit = (h1 + i * h2) & (bit_count - 1);
+		bits[bit / 64] |= 1ULL << (bit % 64);
+	}
+}
+
+bool DuckLakeColumnBloomFilterStats::MayContain(hash_t hash) const {
+	idx_t bit_count = bits.size() * 64;
+	if (bit_count == 0) {
+		return true;
+	}
+	uint64_t h1 = hash;
+	uint64_t h2 = (hash >> 32) | 1;
+	for (idx_t i = 0; i < HASH_COUNT; i++) {
+		auto bit = (h1 + i * h2) & (bit_count - 1);
+		if (!(bits[bit / 64] & (1ULL << (bit % 64)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+string DuckLakeColumnBloomFilterStats::Serialize() const {
+	static constexpr const char *HEX_DIGITS = "0123456789abcdef";
+	string hex;
+	hex.reserve(bits.size() * 16);
+	for (auto entry : bits) {
+		for (idx_t i = 0; i < 16; i++) {
+			hex += HEX_DIGITS[(entry >> (60 - i * 4)) & 0xF];
+		}
+	}
+	return StringUtil::Format(R"('{"bloom_filter": "%s", "type": "%s"}')", hex, type);
+}
+
+void DuckLakeColumnBloomFilterStats::Deserialize(const string &stats) {
+	auto doc = yyjson_read(stats.c_str(), stats.size(), 0);
+	if (!doc) {
+		throw InvalidInputException("Failed to parse Bloom filter stats JSON");
+	}
+	auto root = yyjson_doc_get_root(doc);
+	auto bloom_filter_json = yyjson_obj_get(root, "bloom_filter");
+	auto type_json = yyjson_obj_get(root, "type");
+	if (!yyjson_is_str(bloom_filter_json) || !yyjson_is_str(type_json)) {
+		yyjson_doc_free(doc);
+		throw InvalidInputException("Invalid Bloom filter stats JSON");
+	}
+	string hex(yyjson_get_str(bloom_filter_json), yyjson_get_len(bloom_filter_json));
+	type = yyjson_get_str(type_json);
+	yyjson_doc_free(doc);
+
+	if (hex.size() % 16 != 0) {
+		throw InvalidInputException("Invalid Bloom filter stats JSON");
+	}
+	bits.clear();
+	bits.resize(hex.size() / 16, 0);
+	for (idx_t i = 0; i < hex.size(); i++) {
+		auto c = hex[i];
+		uint64_t digit;
+		if (c >= '0' && c <= '9') {
+			digit = static_cast<uint64_t>(c - '0');
+		} else if (c >= 'a' && c <= 'f') {
+			digit = static_cast<uint64_t>(c - 'a' + 10);
+		} else {
+			throw InvalidInputException("Invalid Bloom filter stats JSON");
+		}
+		bits[i / 16] |= digit << (60 - (i % 16) * 4);
+	}
+}
+
+DuckLakeColumnHistogramStats::DuckLakeColumnHistogramStats() : DuckLakeColumnExtraStats() {
+}
+
+unique_ptr<DuckLakeColumnExtraStats> DuckLakeColumnHistogramStats::Copy() const {
+	return make_uniq<DuckLakeColumnHistogramStats>(*this);
+}
+
+bool DuckLakeColumnHistogramStats::SupportsType(const LogicalType &type) {
+	// histograms use the same value representation as the zone maps
+	return DuckLakeColumnZoneMap::SupportsType(type);
+}
+
+bool DuckLakeColumnHistogramStats::IsHistogram(const string &stats) {
+	return StringUtil::StartsWith(stats, "{\"histogram\"");
+}
+
+bool DuckLakeColumnHistogramStats::TryConvert(const LogicalType &type, const Value &value, double &result) {
+	if (value.IsNull()) {
+		return false;
+	}
+	Value converted = value;
+	if (!converted.DefaultTryCastAs(type)) {
+		return false;
+	}
+	switch (type.InternalType()) {
+	case PhysicalType::INT8:
+		result = converted.GetValueUnsafe<int8_t>();
+		break;
+	case PhysicalType::INT16:
+		result = converted.GetValueUnsafe<int16_t>();
+		break;
+	case PhysicalType::INT32:
+		result = converted.GetValueUnsafe<int32_t>();
+		break;
+	case PhysicalType::INT64:
+		result = static_cast<double>(converted.GetValueUnsafe<int64_t>());
+		break;
+	case PhysicalType::UINT8:
+		result = converted.GetValueUnsafe<uint8_t>();
+		break;
+	case PhysicalType::UINT16:
+		result = converted.GetValueUnsafe<uint16_t>();
+		break;
+	case PhysicalType::UINT32:
+		result = converted.GetValueUnsafe<uint32_t>();
+		break;
+	case PhysicalType::FLOAT:
+		result = converted.GetValueUnsafe<float>();
+		break;
+	case PhysicalType::DOUBLE:
+		result = converted.GetValueUnsafe<double>();
+		break;
+	default:
+		return false;
+	}
+	return std::isfinite(result);
+}
+
+void DuckLakeColumnHistogramStats::Initialize(const vector<double> &quantiles, idx_t value_count) {
+	bounds.clear();
+	counts.clear();
+	if (quantiles.size() < 2 || value_count == 0) {
+		return;
+	}
+	bounds = quantiles;
+	auto bucket_count = bounds.size() - 1;
+	for (idx_t i = 0; i < bucket_count; i++) {
+		counts.push_back(value_count * (i + 1) / bucket_count - value_count * i / bucket_count);
+	}
+}
+
+idx_t DuckLakeColumnHistogramStats::TotalCount() const {
+	idx_t result = 0;
+	for (auto &count : counts) {
+		result += count;
+	}
+	return result;
+}
+
+double DuckLakeColumnHistogramStats::CumulativeCount(double value, bool inclusive) const {
+	double result = 0;
+	for (idx_t i = 0; i < counts.size(); i++) {
+		auto lower = bounds[i];
+		auto upper = bounds[i + 1];
+		auto count = static_cast<double>(counts[i]);
+		if (value > upper || (inclusive && value == upper)) {
+			// the entire bucket is below the value
+			result += count;
+		} else if (value < lower || value == lower) {
+			// the bucket is above the value - as are all subsequent buckets
+			break;
+		} else {
+			// the value is within the bucket - assume the values are evenly distributed within the bucket
+			result += count * (value - lower) / (upper - lower);
+		}
+	}
+	return result;
+}
+
+void DuckLakeColumnHistogramStats::Merge(const DuckLakeColumnExtraStats &new_stats) {
+	auto &histogram = new_stats.Cast<DuckLakeColumnHistogramStats>();
+	if (histogram.counts.empty()) {
+		return;
+	}
+	if (counts.empty()) {
+		bounds = histogram.bounds;
+		counts = histogram.counts;
+		return;
+	}
+	// compute the combined cumulative counts at the boundaries of both histograms
+	vector<double> all_bounds = bounds;
+	all_bounds.insert(all_bounds.end(), histogram.bounds.begin(), histogram.bounds.end());
+	std::sort(all_bounds.begin(), all_bounds.end());
+	all_bounds.erase(std::unique(all_bounds.begin(), all_bounds.end()), all_bounds.end());
+	vector<double> cumulative_counts;
+	for (auto &bound : all_bounds) {
+		cumulative_counts.push_back(CumulativeCount(bound, true) + histogram.CumulativeCount(bound, true));
+	}
+	// place the boundaries of the merged histogram at evenly spaced ranks
+	auto total_count = TotalCount() + histogram.TotalCount();
+	vector<double> quantiles;
+	quantiles.push_back(all_bounds[0]);
+	idx_t bound_idx = 0;
+	for (idx_t i = 1; i < BUCKET_COUNT; i++) {
+		auto target = static_cast<double>(total_count) * static_cast<double>(i) / static_cast<double>(BUCKET_COUNT);
+		while (bound_idx + 1 < all_bounds.size() && cumulative_counts[bound_idx] < target) {
+			bound_idx++;
+		}
+		if (bound_idx == 0 || cumulative_counts[bound_idx] <= cumulative_counts[bound_idx - 1]) {
+			quantiles.push_back(all_bounds[bound_idx]);
+			continue;
+		}
+		auto previous_count = cumulative_counts[bound_idx - 1];
+		auto fraction = (target - previous_count) / (cumulative_counts[bound_idx] - previous_count);
+		auto lower = all_bounds[bound_idx - 1];
+		quantiles.push_back(lower + MaxValue<double>(fraction, 0) * (all_bounds[bound_idx] - lower));
+	}
+	quantiles.push_back(all_bounds.back());
+	Initialize(quantiles, total_count);
+}
+
+//! Collect the range of values a filter selects - returns false if the filter is not a range on the column
+static bool TryGetFilterRange(const LogicalType &type, const TableFilter &filter, double &lower, bool &lower_inclusive,
+                              double &upper, bool &upper_inclusive) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		double constant;
+		if (!DuckLakeColumnHistogramStats::TryConvert(type, constant_filter.constant, constant)) {
+			return false;
+		}
+		auto comparison_type = constant_filter.comparison_type;
+		bool set_lower = comparison_type == ExpressionType::COMPARE_EQUAL ||
+		                 comparison_type == ExpressionType::COMPARE_GREATERTHAN ||
+		                 comparison_type == ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+		bool set_upper = comparison_type == ExpressionType::COMPARE_EQUAL ||
+		                 comparison_type == ExpressionType::COMPARE_LESSTHAN ||
+		                 comparison_type == ExpressionType::COMPARE_LESSTHANOREQUALTO;
+		if (!set_lower && !set_upper) {
+			return false;
+		}
+		if (set_lower) {
+			bool inclusive = comparison_type != ExpressionType::COMPARE_GREATERTHAN;
+			if (constant > lower) {
+				lower = constant;
+				lower_inclusive = inclusive;
+			} else if (constant == lower) {
+				lower_inclusive = lower_inclusive && inclusive;
+			}
+		}
+		if (set_upper) {
+			bool inclusive = comparison_type != ExpressionType::COMPARE_LESSTHAN;
+			if (constant < upper) {
+				upper = constant;
+				upper_inclusive = inclusive;
+			} else if (constant == upper) {
+				upper_inclusive = upper_inclusive && inclusive;
+			}
+		}
+		return true;
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		bool any_range = false;
+		for (auto &child_filter : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			if (TryGetFilterRange(type, *child_filter, lower, lower_inclusive, upper, upper_inclusive)) {
+				any_range = true;
+			}
+		}
+		return any_range;
+	}
+	case TableFilterType::OPTIONAL_FILTER:
+		return TryGetFilterRange(type, *filter.Cast<OptionalFilter>().child_filter, lower, lower_inclusive, upper,
+		                         upper_inclusive);
+	default:
+		return false;
+	}
+}
+
+bool DuckLakeColumnHistogramStats::TryEstimateSelectivity(const LogicalType &type, const TableFilter &filter,
+                                                          double &result) const {
+	auto total_count = static_cast<double>(TotalCount());
+	if (total_count == 0) {
+		return false;
+	}
+	double lower = -NumericLimits<double>::Maximum();
+	double upper = NumericLimits<double>::Maximum();
+	bool lower_inclusive = true;
+	bool upper_inclusive = true;
+	if (!TryGetFilterRange(type, filter, lower, lower_inclusive, upper, upper_inclusive)) {
+		return false;
+	}
+	auto selected = CumulativeCount(upper, upper_inclusive) - CumulativeCount(lower, !lower_inclusive);
+	result = MinValue<double>(MaxValue<double>(selected / total_count, 0), 1);
+	return true;
+}
+
+static double GetJSONNumber(yyjson_val *val) {
+	if (yyjson_is_real(val)) {
+		return yyjson_get_real(val);
+	}
+	if (yyjson_is_uint(val)) {
+		return static_cast<double>(yyjson_get_uint(val));
+	}
+	return static_cast<double>(yyjson_get_sint(val));
+}
+
+string DuckLakeColumnHistogramStats::Serialize() const {
+	string bounds_str;
+	for (auto &bound : bounds) {
+		bounds_str += bounds_str.empty() ? "" : ", ";
+		bounds_str += StringUtil::Format("%.17g", bound);
+	}
+	string counts_str;
+	for (auto &count : counts) {
+		counts_str += counts_str.empty() ? "" : ", ";
+		counts_str += to_string(count);
+	}
+	return StringUtil::Format(R"('{"histogram": {"bounds": [%s], "counts": [%s]}}')", bounds_str, counts_str);
+}
+
+void DuckLakeColumnHistogramStats::Deserialize(const string &stats) {
+	auto doc = yyjson_read(stats.c_str(), stats.size(), 0);
+	if (!doc) {
+		throw InvalidInputException("Failed to parse histogram stats JSON");
+	}
+	auto root = yyjson_doc_get_root(doc);
+	auto histogram_json = yyjson_obj_get(root, "histogram");
+	auto bounds_json = yyjson_obj_get(histogram_json, "bounds");
+	auto counts_json = yyjson_obj_get(histogram_json, "counts");
+	if (!yyjson_is_arr(bounds_json) || !yyjson_is_arr(counts_json) ||
+	    yyjson_arr_size(bounds_json) != yyjson_arr_size(counts_json) + 1) {
+		yyjson_doc_free(doc);
+		throw InvalidInputException("Invalid histogram stats JSON");
+	}
+	bounds.clear();
+	counts.clear();
+	yyjson_arr_iter iter;
+	yyjson_arr_iter_init(bounds_json, &iter);
+	yyjson_val *entry;
+	while ((entry = yyjson_arr_iter_next(&iter))) {
+		bounds.push_back(GetJSONNumber(entry));
+	}
+	yyjson_arr_iter_init(counts_json, &iter);
+	while ((entry = yyjson_arr_iter_next(&iter))) {
+		counts.push_back(yyjson_get_uint(entry));
+	}
+	yyjson_doc_free(doc);
+}
+
 } // namespace duckdb
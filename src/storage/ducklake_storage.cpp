@@ -19,6 +19,8 @@ static void HandleDuckLakeOption(DuckLakeOptions &options, const string &option,
 		options.metadata_database = value.ToString();
 	} else if (lcase == "metadata_path") {
 		options.metadata_path = value.ToString();
+	} else if (lcase == "metadata_read_replica") {
+		options.metadata_read_replica = value.ToString();
 	} else if (lcase == "metadata_parameters") {
 		auto &children = MapValue::GetChildren(value);
 		for (auto &child : children) {
@@ -34,6 +36,10 @@ static void HandleDuckLakeOption(DuckLakeOptions &options, const string &option,
 		}
 	} else if (lcase == "data_inlining_row_limit") {
 		options.config_options["data_inlining_row_limit"] = value.DefaultCastAs(LogicalType::UBIGINT).ToString();
+	} else if (lcase == "delete_inlining_row_limit") {
+		options.config_options["delete_inlining_row_limit"] = value.DefaultCastAs(LogicalType::UBIGINT).ToString();
+	} else if (lcase == "insert_buffer_row_limit") {
+		options.config_options["insert_buffer_row_limit"] = value.DefaultCastAs(LogicalType::UBIGINT).ToString();
 	} else if (lcase == "snapshot_version") {
 		if (options.at_clause) {
 			throw InvalidInputException("Cannot specify both VERSION and TIMESTAMP");
@@ -53,6 +59,24 @@ static void HandleDuckLakeOption(DuckLakeOptions &options, const string &option,
 		options.migrate_if_required = BooleanValue::Get(value.DefaultCastAs(LogicalType::BOOLEAN));
 	} else if (lcase == "busy_timeout") {
 		options.busy_timeout = UBigIntValue::Get(value.DefaultCastAs(LogicalType::UBIGINT));
+	} else if (lcase == "catalog_cache_size") {
+		options.catalog_cache_size = DBConfig::ParseMemoryLimit(value.ToString());
+	} else if (lcase == "delete_file_cache_size") {
+		options.delete_file_cache_size = DBConfig::ParseMemoryLimit(value.ToString());
+	} else if (lcase == "shared_scans") {
+		options.shared_scans = BooleanValue::Get(value.DefaultCastAs(LogicalType::BOOLEAN));
+	} else if (lcase == "data_file_cache_path") {
+		options.data_file_cache_path = value.ToString();
+	} else if (lcase == "data_file_cache_size") {
+		options.data_file_cache_size = DBConfig::ParseMemoryLimit(value.ToString());
+	} else if (lcase == "catalog_cache_path") {
+		options.catalog_cache_path = value.ToString();
+	} else if (lcase == "lazy_catalog_loading") {
+		options.lazy_catalog_loading = BooleanValue::Get(value.DefaultCastAs(LogicalType::BOOLEAN));
+	} else if (lcase == "snapshot_staleness_ms") {
+		options.snapshot_staleness_ms = UBigIntValue::Get(value.DefaultCastAs(LogicalType::UBIGINT));
+	} else if (lcase == "metadata_connection_pool_size") {
+		options.metadata_connection_pool_size = UBigIntValue::Get(value.DefaultCastAs(LogicalType::UBIGINT));
 	} else {
 		throw NotImplementedException("Unsupported option %s for DuckLake", option);
 	}
@@ -103,6 +127,9 @@ static unique_ptr<Catalog> DuckLakeAttach(optional_ptr<StorageExtensionInfo> sto
 	if (options.metadata_database.empty()) {
 		options.metadata_database = "__ducklake_metadata_" + name;
 	}
+	if (!options.metadata_read_replica.empty()) {
+		options.metadata_replica_database = options.metadata_database + "_replica";
+	}
 	if (options.at_clause) {
 		if (attach_options.access_mode == AccessMode::READ_WRITE) {
 			throw InvalidInputException("SNAPSHOT_VERSION / SNAPSHOT_TIME can only be used in read-only mode");
@@ -1,6 +1,8 @@
 #include "common/ducklake_types.hpp"
+#include "functions/ducklake_partition_functions.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
 #include "storage/ducklake_scan.hpp"
 #include "storage/ducklake_transaction.hpp"
 
@@ -12,8 +14,13 @@
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 #include "duckdb/parser/expression/cast_expression.hpp"
 #include "duckdb/parser/expression/columnref_expression.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
 #include "duckdb/storage/statistics/struct_stats.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+#include "duckdb/common/operator/add.hpp"
+#include "duckdb/common/operator/subtract.hpp"
 #include "duckdb/storage/statistics/list_stats.hpp"
 #include "duckdb/parser/parsed_data/comment_on_column_info.hpp"
 #include "duckdb/parser/constraints/not_null_constraint.hpp"
@@ -119,6 +126,17 @@ DuckLakeTableEntry::DuckLakeTableEntry(DuckLakeTableEntry &parent, CreateTableIn
 	partition_data = std::move(partition_data_p);
 }
 
+// Copy a committed table entry into a different schema entry
+DuckLakeTableEntry::DuckLakeTableEntry(DuckLakeTableEntry &parent, SchemaCatalogEntry &schema, CreateTableInfo &info)
+    : DuckLakeTableEntry(parent.ParentCatalog(), schema, info, parent.GetTableId(), parent.GetTableUUID(),
+                         parent.DataPath(), parent.field_data, parent.next_column_id, parent.inlined_data_tables,
+                         parent.local_change) {
+	D_ASSERT(!parent.IsTransactionLocal());
+	if (parent.partition_data) {
+		partition_data = make_uniq<DuckLakePartition>(*parent.partition_data);
+	}
+}
+
 const DuckLakeFieldId &DuckLakeTableEntry::GetFieldId(PhysicalIndex column_index) const {
 	return field_data->GetByRootIndex(column_index);
 }
@@ -196,13 +214,42 @@ case_insensitive_set_t DuckLakeTableEntry::GetNotNullFields() const {
 	return result;
 }
 
+//! Estimate the distinct count of a column for the optimizer - an integral column cannot have more distinct values
+//! than there are values between its min and max
+static void EstimateDistinctCount(BaseStatistics &stats, idx_t record_count) {
+	if (!stats.GetType().IsIntegral() || !NumericStats::HasMinMax(stats)) {
+		return;
+	}
+	// the range of a UHUGEINT (or full-range HUGEINT) column does not fit in a HUGEINT - leave the estimate unset
+	Value min_value;
+	Value max_value;
+	if (!NumericStats::Min(stats).DefaultTryCastAs(LogicalType::HUGEINT, min_value, nullptr) ||
+	    !NumericStats::Max(stats).DefaultTryCastAs(LogicalType::HUGEINT, max_value, nullptr)) {
+		return;
+	}
+	hugeint_t range;
+	if (!TrySubtractOperator::Operation(max_value.GetValue<hugeint_t>(), min_value.GetValue<hugeint_t>(), range) ||
+	    !TryAddOperator::Operation(range, hugeint_t(1), range)) {
+		return;
+	}
+	idx_t distinct_count = record_count;
+	if (range < Hugeint::Convert(record_count)) {
+		distinct_count = Hugeint::Cast<idx_t>(range);
+	}
+	stats.SetDistinctCount(distinct_count);
+}
+
 unique_ptr<BaseStatistics> DuckLakeTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
 	auto table_stats = GetTableStats(context);
 	if (!table_stats) {
 		return nullptr;
 	}
 	auto &field_id = field_data->GetByRootIndex(PhysicalIndex(column_id));
-	return GetColumnStats(field_id, *table_stats);
+	auto stats = GetColumnStats(field_id, *table_stats);
+	if (stats) {
+		EstimateDistinctCount(*stats, table_stats->record_count);
+	}
+	return stats;
 }
 
 TableFunction DuckLakeTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
@@ -331,9 +378,27 @@ string GetPartitionColumnName(ColumnRefExpression &colref) {
 	return colref.GetColumnName();
 }
 
+//! Get the parameter of a bucket(N, column) or truncate(W, column) partition key
+static idx_t GetTransformParameter(const string &name, ParsedExpression &expr) {
+	if (expr.type != ExpressionType::VALUE_CONSTANT) {
+		throw NotImplementedException("Expected a constant as the first argument of %s, but got %s", name,
+		                              expr.ToString());
+	}
+	auto &constant = expr.Cast<ConstantExpression>();
+	Value parameter;
+	string error;
+	if (!constant.value.DefaultTryCastAs(LogicalType::BIGINT, parameter, &error) || parameter.IsNull() ||
+	    parameter.GetValue<int64_t>() <= 0 || parameter.GetValue<int64_t>() > NumericLimits<int32_t>::Maximum()) {
+		throw InvalidInputException("The first argument of %s must be a positive integer, but got %s", name,
+		                            constant.value.ToString());
+	}
+	return parameter.GetValue<idx_t>();
+}
+
 DuckLakePartitionField GetPartitionField(DuckLakeTableEntry &table, ParsedExpression &expr) {
 	string column_name;
 	DuckLakeTransformType transform_type;
+	idx_t transform_parameter = 0;
 	switch (expr.type) {
 	case ExpressionType::COLUMN_REF: {
 		auto &colref = expr.Cast<ColumnRefExpression>();
@@ -344,6 +409,7 @@ DuckLakePartitionField GetPartitionField(DuckLakeTableEntry &table, ParsedExpres
 	case ExpressionType::FUNCTION: {
 		auto &function = expr.Cast<FunctionExpression>();
 		auto name = StringUtil::Lower(function.function_name);
+		idx_t expected_arguments = 1;
 		if (name == "year") {
 			transform_type = DuckLakeTransformType::YEAR;
 		} else if (name == "month") {
@@ -352,28 +418,52 @@ DuckLakePartitionField GetPartitionField(DuckLakeTableEntry &table, ParsedExpres
 			transform_type = DuckLakeTransformType::DAY;
 		} else if (name == "hour") {
 			transform_type = DuckLakeTransformType::HOUR;
+		} else if (name == "bucket") {
+			transform_type = DuckLakeTransformType::BUCKET;
+			expected_arguments = 2;
+		} else if (name == "truncate") {
+			transform_type = DuckLakeTransformType::TRUNCATE;
+			expected_arguments = 2;
 		} else {
 			throw NotImplementedException(
-			    "Unsupported partition function %s - only year, month, day, hour are supported", name);
+			    "Unsupported partition function %s - only year, month, day, hour, bucket, truncate are supported",
+			    name);
 		}
-		if (function.children.size() != 1 || function.children[0]->type != ExpressionType::COLUMN_REF) {
+		if (function.children.size() != expected_arguments ||
+		    function.children.back()->type != ExpressionType::COLUMN_REF) {
+			if (expected_arguments == 2) {
+				throw NotImplementedException("Expected %s(N, column), but got %s", name, expr.ToString());
+			}
 			throw NotImplementedException("Expected %s(column), but got %s", name, expr.ToString());
 		}
-		auto &colref = function.children[0]->Cast<ColumnRefExpression>();
+		if (expected_arguments == 2) {
+			transform_parameter = GetTransformParameter(name, *function.children[0]);
+		}
+		auto &colref = function.children.back()->Cast<ColumnRefExpression>();
 		column_name = GetPartitionColumnName(colref);
 		break;
 	}
 	default:
-		throw NotImplementedException(
-		    "Unsupported partition key %s - only identity columns and year/month/day/hour are supported",
-		    expr.ToString());
+		throw NotImplementedException("Unsupported partition key %s - only identity columns and "
+		                              "year/month/day/hour/bucket/truncate are supported",
+		                              expr.ToString());
 	}
 	DuckLakePartitionField field;
 	auto &col = table.GetColumn(column_name);
+	if (transform_type == DuckLakeTransformType::BUCKET && !DuckLakePartitionFunctions::SupportsBucket(col.Type())) {
+		throw NotImplementedException("Unsupported type %s for bucket partitioning of column \"%s\"",
+		                              col.Type().ToString(), column_name);
+	}
+	if (transform_type == DuckLakeTransformType::TRUNCATE &&
+	    !DuckLakePartitionFunctions::SupportsTruncate(col.Type())) {
+		throw NotImplementedException("Unsupported type %s for truncate partitioning of column \"%s\"",
+		                              col.Type().ToString(), column_name);
+	}
 	PhysicalIndex column_index(col.StorageOid());
 	auto &field_id = table.GetFieldData().GetByRootIndex(column_index);
 	field.field_id = field_id.GetFieldIndex();
 	field.transform.type = transform_type;
+	field.transform.parameter = transform_parameter;
 	return field;
 }
 
@@ -1037,6 +1127,11 @@ unique_ptr<CatalogEntry> DuckLakeTableEntry::Alter(DuckLakeTransaction &transact
 	if (transaction.HasTransactionInlinedData(GetTableId())) {
 		throw NotImplementedException("ALTER on a table with transaction-local inlined data is not supported");
 	}
+	auto &catalog = ParentCatalog().Cast<DuckLakeCatalog>();
+	if (catalog.GetInsertBuffer().HasBufferedRows(GetTableId())) {
+		throw NotImplementedException("ALTER on a table with buffered inserts is not supported - write the buffered "
+		                              "inserts first using ducklake_flush_insert_buffer");
+	}
 	switch (info.alter_table_type) {
 	case AlterTableType::RENAME_TABLE:
 		return AlterTable(transaction, info.Cast<RenameTableInfo>());
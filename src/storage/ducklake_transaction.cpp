@@ -7,8 +7,15 @@
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "duckdb/planner/tableref/bound_at_clause.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_insert_buffer.hpp"
+#include "storage/ducklake_background_maintenance.hpp"
+#include "storage/ducklake_compaction_tracker.hpp"
+#include "storage/ducklake_file_size_advisor.hpp"
 #include "storage/ducklake_schema_entry.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_transaction_changes.hpp"
@@ -41,49 +48,304 @@ DuckLakeTransaction::DuckLakeTransaction(DuckLakeCatalog &ducklake_catalog, Tran
     : Transaction(manager, context), ducklake_catalog(ducklake_catalog), db(*context.db),
       local_catalog_id(DuckLakeConstants::TRANSACTION_LOCAL_ID_START), catalog_version(0) {
 	metadata_manager = DuckLakeMetadataManager::Create(*this);
+	Value latency;
+	if (context.TryGetCurrentSetting("ducklake_metadata_latency_ms", latency)) {
+		metadata_latency_ms = latency.GetValue<idx_t>();
+	}
 }
 
 DuckLakeTransaction::~DuckLakeTransaction() {
+	try {
+		ReleaseConnection();
+	} catch (...) {
+	}
 }
 
 void DuckLakeTransaction::Start() {
 }
 
+vector<DuckLakeCommittedTableChanges> DuckLakeTransaction::GetCommittedTableChanges() {
+	vector<DuckLakeCommittedTableChanges> result;
+	// the changes are only tracked for tables with maintenance thresholds - if no threshold is set anywhere we can
+	// skip looking up the tables, their options and stats on every commit
+	static const char *const MAINTENANCE_OPTIONS[] = {"auto_flush_inlined_row_limit", "auto_flush_inlined_size",
+	                                                  "auto_compaction_file_count", "auto_compaction_delete_ratio"};
+	bool has_thresholds = false;
+	for (auto &option : MAINTENANCE_OPTIONS) {
+		if (ducklake_catalog.HasConfigOption(option)) {
+			has_thresholds = true;
+			break;
+		}
+	}
+	if (!has_thresholds) {
+		return result;
+	}
+	for (auto &entry : table_data_changes) {
+		auto table_id = entry.first;
+		auto &table_changes = entry.second;
+		if (table_id.IsTransactionLocal()) {
+			// tables created in this transaction are only tracked from their next commit on
+			continue;
+		}
+		if (!table_changes.new_inlined_data && table_changes.new_data_files.empty() &&
+		    table_changes.new_delete_files.empty()) {
+			continue;
+		}
+		auto table_entry = ducklake_catalog.GetEntryById(*this, GetSnapshot(), table_id);
+		if (!table_entry) {
+			continue;
+		}
+		auto &table = table_entry->Cast<DuckLakeTableEntry>();
+		auto &schema = table.ParentSchema().Cast<DuckLakeSchemaEntry>();
+		auto schema_id = schema.GetSchemaId();
+		DuckLakeCommittedTableChanges changes;
+		changes.inlined_row_limit =
+		    ducklake_catalog.GetConfigOption<idx_t>("auto_flush_inlined_row_limit", schema_id, table_id, 0);
+		changes.inlined_size_limit =
+		    ducklake_catalog.GetConfigOption<idx_t>("auto_flush_inlined_size", schema_id, table_id, 0);
+		changes.small_file_limit =
+		    ducklake_catalog.GetConfigOption<idx_t>("auto_compaction_file_count", schema_id, table_id, 0);
+		changes.delete_ratio_limit =
+		    ducklake_catalog.GetConfigOption<double>("auto_compaction_delete_ratio", schema_id, table_id, 0);
+		if (!changes.HasMaintenanceThresholds()) {
+			continue;
+		}
+		changes.table_id = table_id;
+		changes.schema_name = schema.name;
+		changes.table_name = table.name;
+		if (table_changes.new_inlined_data) {
+			auto &inlined_data = *table_changes.new_inlined_data->data;
+			changes.inlined_row_count = inlined_data.Count();
+			changes.inlined_size_in_bytes = inlined_data.SizeInBytes();
+		}
+		auto column_count = table.GetColumns().PhysicalColumnCount();
+		auto file_sizing =
+		    ducklake_catalog.GetFileSizeAdvisor().GetFileSizing(ducklake_catalog, schema_id, table_id, column_count);
+		auto target_file_size = file_sizing.target_file_size;
+		for (auto &file : table_changes.new_data_files) {
+			if (file.file_size_bytes < target_file_size) {
+				changes.small_file_count++;
+			}
+		}
+		for (auto &delete_entry : table_changes.new_delete_files) {
+			// delete files that overwrite an existing delete file also count the previously deleted rows
+			changes.deleted_row_count += delete_entry.second.delete_count;
+		}
+		if (changes.delete_ratio_limit > 0) {
+			auto table_stats = ducklake_catalog.GetTableStats(*this, table_id);
+			changes.table_row_count = table_stats ? table_stats->record_count : 0;
+		}
+		result.push_back(std::move(changes));
+	}
+	return result;
+}
+
+vector<DuckLakeCompactionTrackerChanges> DuckLakeTransaction::GetCompactionTrackerChanges() {
+	map<TableIndex, DuckLakeCompactionTrackerChanges> changes;
+	for (auto &entry : table_data_changes) {
+		auto table_id = entry.first;
+		auto &table_changes = entry.second;
+		if (table_id.IsTransactionLocal()) {
+			// tables created in this transaction are not tracked yet
+			continue;
+		}
+		auto &result = changes[table_id];
+		result.table_id = table_id;
+		if (!table_changes.compactions.empty()) {
+			result.invalidate = true;
+		}
+		if (!table_changes.new_delete_files.empty()) {
+			result.deleted_rows = true;
+		}
+		for (auto &file : table_changes.new_data_files) {
+			if (file.delete_file) {
+				result.deleted_rows = true;
+			}
+			DuckLakeCompactionTrackerFile new_file;
+			new_file.partition_key = DuckLakeCompactionTracker::GetPartitionKey(file);
+			new_file.file_size_bytes = file.file_size_bytes;
+			result.new_files.push_back(std::move(new_file));
+		}
+	}
+	for (auto &table_id : tables_deleted_from) {
+		// files that were dropped because all of their rows were deleted
+		auto &result = changes[table_id];
+		result.table_id = table_id;
+		result.deleted_rows = true;
+	}
+	vector<DuckLakeCompactionTrackerChanges> result;
+	for (auto &entry : changes) {
+		result.push_back(std::move(entry.second));
+	}
+	return result;
+}
+
+vector<string> DuckLakeTransaction::GetCopyOnWriteRewrites() {
+	vector<string> result;
+	for (auto &table_id : copy_on_write_tables) {
+		auto entry = table_data_changes.find(table_id);
+		if (entry == table_data_changes.end()) {
+			continue;
+		}
+		// only the files the transaction wrote deletes for are rewritten
+		set<idx_t> data_file_ids;
+		for (auto &delete_file : entry->second.new_delete_files) {
+			if (delete_file.second.data_file_id.IsValid()) {
+				data_file_ids.insert(delete_file.second.data_file_id.index);
+			}
+		}
+		if (data_file_ids.empty()) {
+			// the update did not write any delete files (e.g. all updated files were fully rewritten)
+			continue;
+		}
+		auto table_entry = ducklake_catalog.GetEntryById(*this, GetSnapshot(), table_id);
+		if (!table_entry) {
+			continue;
+		}
+		auto &table = table_entry->Cast<DuckLakeTableEntry>();
+		string data_file_id_list;
+		for (auto &data_file_id : data_file_ids) {
+			if (!data_file_id_list.empty()) {
+				data_file_id_list += ", ";
+			}
+			data_file_id_list += to_string(data_file_id);
+		}
+		// a delete threshold of 0 rewrites the given files regardless of how many of their rows were deleted
+		result.push_back(StringUtil::Format(
+		    "CALL ducklake_rewrite_data_files(%s, %s, schema => %s, delete_threshold => 0, data_file_ids => [%s])",
+		    KeywordHelper::WriteQuoted(ducklake_catalog.GetName(), '\''), KeywordHelper::WriteQuoted(table.name, '\''),
+		    KeywordHelper::WriteQuoted(table.ParentSchema().name, '\''), data_file_id_list));
+	}
+	return result;
+}
+
+void DuckLakeTransaction::AddCopyOnWriteUpdate(TableIndex table_id) {
+	lock_guard<mutex> guard(table_data_changes_lock);
+	copy_on_write_tables.insert(table_id);
+}
+
+void DuckLakeTransaction::RewriteCopyOnWriteTables() {
+	auto rewrites = std::move(copy_on_write_rewrites);
+	// the update itself has been committed - the rewrites run in the background, each in its own transaction. If a
+	// rewrite keeps failing (e.g. because it conflicts with concurrent writers) the delete files remain and are
+	// rewritten by the next update or compaction
+	auto &background_maintenance = ducklake_catalog.GetBackgroundMaintenance();
+	for (auto &rewrite : rewrites) {
+		background_maintenance.ScheduleQuery(rewrite);
+	}
+}
+
 void DuckLakeTransaction::Commit() {
 	if (ChangesMade()) {
+		auto committed_changes = GetCommittedTableChanges();
+		copy_on_write_rewrites = GetCopyOnWriteRewrites();
 		FlushChanges();
+		if (!committed_changes.empty()) {
+			ducklake_catalog.GetBackgroundMaintenance().AddCommittedChanges(committed_changes);
+		}
 	} else if (connection) {
 		connection->Commit();
 	}
-	connection.reset();
+	// the flushed insert buffers have been written - release them and acknowledge the inserts waiting for them
+	auto &insert_buffer = ducklake_catalog.GetInsertBuffer();
+	for (auto &entry : flushed_insert_buffers) {
+		insert_buffer.MarkCommitted(entry.second.batch_ids);
+	}
+	flushed_insert_buffers.clear();
+	for (auto &option : commit_config_options) {
+		ducklake_catalog.SetConfigOption(option);
+	}
+	commit_config_options.clear();
+	ReleaseConnection();
 }
 
 void DuckLakeTransaction::Rollback() {
 	if (connection) {
 		// rollback any changes made to the metadata catalog
 		connection->Rollback();
-		connection.reset();
+		ReleaseConnection();
 	}
 	CleanupFiles();
 }
 
+bool DuckLakeTransaction::CanGroupCommit() {
+	if (table_data_changes.empty() || SchemaChangesMade() || !dropped_files.empty() ||
+	    !new_name_maps.name_maps.empty()) {
+		return false;
+	}
+	if (commit_info.is_commit_info_set || !tables_deleted_from.empty() || !flushed_insert_buffers.empty() ||
+	    !copy_on_write_tables.empty()) {
+		return false;
+	}
+	for (auto &entry : table_data_changes) {
+		auto &table_changes = entry.second;
+		if (entry.first.IsTransactionLocal() || table_changes.new_inlined_data ||
+		    !table_changes.new_delete_files.empty() || !table_changes.new_inlined_data_deletes.empty() ||
+		    !table_changes.compactions.empty()) {
+			return false;
+		}
+		for (auto &file : table_changes.new_data_files) {
+			if (file.begin_snapshot.IsValid() || file.delete_file) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void DuckLakeTransaction::AddGroupCommit(DuckLakeTransaction &other) {
+	set<TableIndex> tables_inserted_into;
+	for (auto &entry : other.table_data_changes) {
+		tables_inserted_into.insert(entry.first);
+		AppendFiles(entry.first, std::move(entry.second.new_data_files));
+	}
+	other.table_data_changes.clear();
+	grouped_transactions.emplace_back(other.GetSnapshot(), std::move(tables_inserted_into));
+}
+
 Connection &DuckLakeTransaction::GetConnection() {
 	lock_guard<mutex> lock(connection_lock);
 	if (!connection) {
-		connection = make_uniq<Connection>(db);
-		// set the search path to the metadata catalog
-		auto &client_data = ClientData::Get(*connection->context);
-		CatalogSearchEntry metadata_entry(ducklake_catalog.MetadataDatabaseName(),
-		                                  ducklake_catalog.MetadataSchemaName());
-		if (metadata_entry.schema.empty()) {
-			metadata_entry.schema = "main";
-		}
-		client_data.catalog_search_path->Set(metadata_entry, CatalogSetPathType::SET_DIRECTLY);
+		// try to re-use an idle connection (and the statements prepared on it) from the connection pool
+		auto pooled_connection = ducklake_catalog.BorrowConnection();
+		if (pooled_connection) {
+			connection = std::move(pooled_connection->connection);
+			lock_guard<mutex> guard(prepared_statement_lock);
+			prepared_statements = std::move(pooled_connection->prepared_statements);
+		} else {
+			connection = make_uniq<Connection>(db);
+			// set the search path to the metadata catalog
+			auto &client_data = ClientData::Get(*connection->context);
+			CatalogSearchEntry metadata_entry(ducklake_catalog.MetadataDatabaseName(),
+			                                  ducklake_catalog.MetadataSchemaName());
+			if (metadata_entry.schema.empty()) {
+				metadata_entry.schema = "main";
+			}
+			client_data.catalog_search_path->Set(metadata_entry, CatalogSetPathType::SET_DIRECTLY);
+		}
 		connection->BeginTransaction();
 	}
 	return *connection;
 }
 
+void DuckLakeTransaction::ReleaseConnection() {
+	lock_guard<mutex> lock(connection_lock);
+	if (!connection) {
+		return;
+	}
+	unique_ptr<DuckLakeMetadataConnection> pooled_connection;
+	if (!connection->HasActiveTransaction()) {
+		// the metadata transaction has finished - the connection can be re-used by other transactions
+		pooled_connection = make_uniq<DuckLakeMetadataConnection>();
+		pooled_connection->connection = std::move(connection);
+		lock_guard<mutex> guard(prepared_statement_lock);
+		pooled_connection->prepared_statements = std::move(prepared_statements);
+	}
+	ClearPreparedStatements();
+	connection.reset();
+	ducklake_catalog.ReturnConnection(std::move(pooled_connection));
+}
+
 bool DuckLakeTransaction::SchemaChangesMade() {
 	return !new_tables.empty() || !dropped_tables.empty() || new_schemas || !dropped_schemas.empty() ||
 	       !dropped_views.empty();
@@ -227,10 +489,12 @@ TransactionChangeInformation DuckLakeTransaction::GetTransactionChanges() {
 }
 
 struct DuckLakeCommitState {
-	explicit DuckLakeCommitState(DuckLakeSnapshot &snapshot) : commit_snapshot(snapshot) {
+	DuckLakeCommitState(DuckLakeSnapshot &snapshot, DuckLakeCommitTimings &timings)
+	    : commit_snapshot(snapshot), timings(timings) {
 	}
 
 	DuckLakeSnapshot &commit_snapshot;
+	DuckLakeCommitTimings &timings;
 	map<SchemaIndex, SchemaIndex> committed_schemas;
 	map<TableIndex, TableIndex> committed_tables;
 
@@ -390,11 +654,27 @@ void DuckLakeTransaction::CleanupFiles() {
 			}
 		}
 		for (auto &file : table_changes.new_delete_files) {
-			fs.TryRemoveFile(file.second.file_name);
+			if (!file.second.IsInlined()) {
+				fs.TryRemoveFile(file.second.file_name);
+			}
 		}
 		table_changes.new_data_files.clear();
 		table_changes.new_delete_files.clear();
 	}
+	// put back any buffered inserts we have taken from the insert buffer
+	auto &insert_buffer = ducklake_catalog.GetInsertBuffer();
+	for (auto &entry : flushed_insert_buffers) {
+		insert_buffer.Restore(entry.first, std::move(entry.second));
+	}
+	flushed_insert_buffers.clear();
+}
+
+optional_ptr<ColumnDataCollection> DuckLakeTransaction::AddFlushedInsertBuffer(TableIndex table_id,
+                                                                              DuckLakeBufferedRows rows) {
+	lock_guard<mutex> guard(table_data_changes_lock);
+	auto &result = *rows.rows;
+	flushed_insert_buffers.emplace_back(table_id, std::move(rows));
+	return result;
 }
 
 template <class T, class MAP>
@@ -478,29 +758,45 @@ void DuckLakeTransaction::CheckForConflicts(const TransactionChangeInformation &
 	for (auto &table_id : changes.tables_deleted_from) {
 		ConflictCheck(table_id, other_changes.dropped_tables, "delete from table", "dropped it");
 		ConflictCheck(table_id, other_changes.altered_tables, "delete from table", "altered it");
-		ConflictCheck(table_id, other_changes.tables_compacted, "delete from table", "compacted it");
 	}
+	// deletes and compactions conflict only if they touch the same data files
+	// the files deleted from by other transactions are loaded only if another transaction touched the same table
+	unique_ptr<SnapshotDeletedFromFiles> deleted_files;
 	if (!changes.tables_deleted_from.empty()) {
-		bool check_for_matches = false;
+		bool check_for_deletes = false;
+		bool check_for_compactions = false;
 		for (auto &table_id : changes.tables_deleted_from) {
 			if (other_changes.tables_deleted_from.find(table_id) != other_changes.tables_deleted_from.end()) {
-				check_for_matches = true;
-				break;
+				check_for_deletes = true;
+			}
+			if (other_changes.tables_compacted.find(table_id) != other_changes.tables_compacted.end()) {
+				check_for_compactions = true;
 			}
 		}
-		if (check_for_matches) {
-			// If we have deletes on the tables, check for files being deleted
-			const auto deleted_files = metadata_manager->GetFilesDeletedOrDroppedAfterSnapshot(transaction_snapshot);
+		if (check_for_deletes || check_for_compactions) {
+			// gather the files we are deleting from
+			set<DataFileIndex> files_deleted_from;
 			for (auto &entry : table_data_changes) {
 				auto &table_changes = entry.second;
 				for (auto &file_entry : table_changes.new_delete_files) {
-					auto &file = file_entry.second;
-					ConflictCheck(file.data_file_id, deleted_files.deleted_from_files, "delete from file",
-					              "deleted from it");
+					files_deleted_from.insert(file_entry.second.data_file_id);
 				}
 			}
 			for (auto &file : dropped_files) {
-				ConflictCheck(file.second, deleted_files.deleted_from_files, "delete from file", "deleted from it");
+				files_deleted_from.insert(file.second);
+			}
+			// check for files being deleted from or dropped by other transactions
+			deleted_files = make_uniq<SnapshotDeletedFromFiles>(
+			    metadata_manager->GetFilesDeletedOrDroppedAfterSnapshot(transaction_snapshot));
+			for (auto &file_id : files_deleted_from) {
+				ConflictCheck(file_id, deleted_files->deleted_from_files, "delete from file", "deleted from it");
+			}
+			if (check_for_compactions) {
+				// merging files removes the source files from the metadata entirely
+				auto removed_files = metadata_manager->GetRemovedDataFiles(files_deleted_from);
+				for (auto &file_id : files_deleted_from) {
+					ConflictCheck(file_id, removed_files, "delete from file", "compacted it");
+				}
 			}
 		}
 	}
@@ -517,8 +813,25 @@ void DuckLakeTransaction::CheckForConflicts(const TransactionChangeInformation &
 	}
 	for (auto &table_id : changes.tables_compacted) {
 		ConflictCheck(table_id, other_changes.dropped_tables, "compact table", "dropped it");
-		ConflictCheck(table_id, other_changes.tables_deleted_from, "compact table", "deleted from it");
 		ConflictCheck(table_id, other_changes.tables_compacted, "compact table", "compacted it");
+		if (other_changes.tables_deleted_from.find(table_id) == other_changes.tables_deleted_from.end()) {
+			continue;
+		}
+		// another transaction deleted from this table - check if it deleted from any of the compacted files
+		if (!deleted_files) {
+			deleted_files = make_uniq<SnapshotDeletedFromFiles>(
+			    metadata_manager->GetFilesDeletedOrDroppedAfterSnapshot(transaction_snapshot));
+		}
+		auto entry = table_data_changes.find(table_id);
+		if (entry == table_data_changes.end()) {
+			continue;
+		}
+		for (auto &compaction : entry->second.compactions) {
+			for (auto &source_file : compaction.source_files) {
+				ConflictCheck(source_file.file.id, deleted_files->deleted_from_files, "compact file",
+				              "deleted from it");
+			}
+		}
 	}
 	for (auto &table_id : changes.altered_tables) {
 		ConflictCheck(table_id, other_changes.dropped_tables, "alter table", "dropped it");
@@ -529,13 +842,43 @@ void DuckLakeTransaction::CheckForConflicts(const TransactionChangeInformation &
 	}
 }
 
+//! The ids of the schemas, tables and views whose changes by other transactions can conflict with the given changes
+static set<idx_t> GetConflictObjectIds(const TransactionChangeInformation &changes) {
+	set<idx_t> result;
+	for (auto &entry : changes.dropped_schemas) {
+		result.insert(entry.first.index);
+	}
+	for (auto &entry : changes.created_tables) {
+		for (auto &table : entry.second) {
+			result.insert(table.get().ParentSchema().Cast<DuckLakeSchemaEntry>().GetSchemaId().index);
+		}
+	}
+	for (auto table_ids : {&changes.altered_tables, &changes.altered_views, &changes.dropped_tables,
+	                       &changes.dropped_views, &changes.tables_inserted_into, &changes.tables_deleted_from,
+	                       &changes.tables_inserted_inlined, &changes.tables_deleted_inlined,
+	                       &changes.tables_flushed_inlined, &changes.tables_compacted}) {
+		for (auto &table_id : *table_ids) {
+			result.insert(table_id.index);
+		}
+	}
+	return result;
+}
+
 void DuckLakeTransaction::CheckForConflicts(DuckLakeSnapshot transaction_snapshot,
                                             const TransactionChangeInformation &changes) {
-
-	// get all changes made to the system after the current snapshot was started
-	auto changes_made = metadata_manager->GetChangesMadeAfterSnapshot(transaction_snapshot);
+	// get the changes made to the system after the current snapshot was started
+	// if the metadata catalog has the snapshot change index we only read the changes that are relevant to our changes
+	unique_ptr<SnapshotChangeInfo> changes_made;
+	if (ducklake_catalog.HasSnapshotChangeIndex()) {
+		changes_made = metadata_manager->GetIndexedChangesMadeAfterSnapshot(transaction_snapshot,
+		                                                                    GetConflictObjectIds(changes));
+	}
+	if (!changes_made) {
+		auto all_changes = metadata_manager->GetChangesMadeAfterSnapshot(transaction_snapshot);
+		changes_made = make_uniq<SnapshotChangeInfo>(std::move(all_changes));
+	}
 	// parse changes made by other transactions
-	auto other_changes = SnapshotChangeInformation::ParseChangesMade(changes_made.changes_made);
+	auto other_changes = SnapshotChangeInformation::ParseChangesMade(changes_made->changes_made);
 
 	// now check for conflicts
 	CheckForConflicts(changes, other_changes, transaction_snapshot);
@@ -598,6 +941,12 @@ DuckLakePartitionInfo DuckLakeTransaction::GetNewPartitionKey(DuckLakeCommitStat
 		case DuckLakeTransformType::HOUR:
 			partition_field.transform = "hour";
 			break;
+		case DuckLakeTransformType::BUCKET:
+			partition_field.transform = "bucket(" + to_string(field.transform.parameter) + ")";
+			break;
+		case DuckLakeTransformType::TRUNCATE:
+			partition_field.transform = "truncate(" + to_string(field.transform.parameter) + ")";
+			break;
 		default:
 			throw NotImplementedException("Unimplemented transform type for partition");
 		}
@@ -941,22 +1290,8 @@ void DuckLakeTransaction::UpdateGlobalTableStats(TableIndex table_id, const Duck
 	metadata_manager->UpdateGlobalTableStats(stats);
 }
 
-DuckLakeFileInfo DuckLakeTransaction::GetNewDataFile(DuckLakeDataFile &file, DuckLakeSnapshot &commit_snapshot,
-                                                     TableIndex table_id, optional_idx row_id_start) {
-	DuckLakeFileInfo data_file;
-	data_file.id = DataFileIndex(commit_snapshot.next_file_id++);
-	data_file.table_id = table_id;
-	data_file.file_name = file.file_name;
-	data_file.row_count = file.row_count;
-	data_file.file_size_bytes = file.file_size_bytes;
-	data_file.footer_size = file.footer_size;
-	data_file.partition_id = file.partition_id;
-	data_file.encryption_key = file.encryption_key;
-	data_file.row_id_start = row_id_start;
-	data_file.mapping_id = file.mapping_id;
-	data_file.begin_snapshot = file.begin_snapshot;
-	data_file.max_partial_file_snapshot = file.max_partial_file_snapshot;
-	// gather the column statistics for this file
+static vector<DuckLakeColumnStatsInfo> ConvertColumnStats(DuckLakeDataFile &file) {
+	vector<DuckLakeColumnStatsInfo> result;
 	for (auto &column_stats_entry : file.column_stats) {
 		DuckLakeColumnStatsInfo column_stats;
 		column_stats.column_id = column_stats_entry.first;
@@ -986,7 +1321,32 @@ DuckLakeFileInfo DuckLakeTransaction::GetNewDataFile(DuckLakeDataFile &file, Duc
 			column_stats.extra_stats = "NULL";
 		}
 
-		data_file.column_stats.push_back(std::move(column_stats));
+		result.push_back(std::move(column_stats));
+	}
+	return result;
+}
+
+DuckLakeFileInfo DuckLakeTransaction::GetNewDataFile(DuckLakeDataFile &file, DuckLakeSnapshot &commit_snapshot,
+                                                     TableIndex table_id, optional_idx row_id_start,
+                                                     optional_ptr<const vector<DuckLakeColumnStatsInfo>> column_stats) {
+	DuckLakeFileInfo data_file;
+	data_file.id = DataFileIndex(commit_snapshot.next_file_id++);
+	data_file.table_id = table_id;
+	data_file.file_name = file.file_name;
+	data_file.row_count = file.row_count;
+	data_file.file_size_bytes = file.file_size_bytes;
+	data_file.footer_size = file.footer_size;
+	data_file.partition_id = file.partition_id;
+	data_file.encryption_key = file.encryption_key;
+	data_file.row_id_start = row_id_start;
+	data_file.mapping_id = file.mapping_id;
+	data_file.begin_snapshot = file.begin_snapshot;
+	data_file.max_partial_file_snapshot = file.max_partial_file_snapshot;
+	// gather the column statistics for this file
+	if (column_stats) {
+		data_file.column_stats = *column_stats;
+	} else {
+		data_file.column_stats = ConvertColumnStats(file);
 	}
 	for (auto &partition_entry : file.partition_values) {
 		DuckLakeFilePartitionInfo partition_info;
@@ -1002,6 +1362,40 @@ struct NewDataInfo {
 	vector<DuckLakeInlinedDataInfo> new_inlined_data;
 };
 
+//! The new data files of a table, prepared for committing
+struct DuckLakePreparedDataFiles {
+	//! The converted column stats of each of the new data files
+	vector<vector<DuckLakeColumnStatsInfo>> column_stats;
+	//! The merged stats of all new data files (next_row_id is unused)
+	DuckLakeTableStats stats;
+};
+
+struct DuckLakePreparedCommit {
+	map<TableIndex, DuckLakePreparedDataFiles> new_data_files;
+};
+
+void DuckLakeTransaction::PrepareCommit() {
+	// converting and merging the column stats of the new data files does not depend on the snapshot we commit on top
+	// of - do this only once, instead of for every commit attempt
+	prepared_commit = make_uniq<DuckLakePreparedCommit>();
+	for (auto &entry : table_data_changes) {
+		auto &table_changes = entry.second;
+		if (table_changes.new_data_files.empty()) {
+			continue;
+		}
+		auto &prepared_files = prepared_commit->new_data_files[entry.first];
+		auto &stats = prepared_files.stats;
+		for (auto &file : table_changes.new_data_files) {
+			prepared_files.column_stats.push_back(ConvertColumnStats(file));
+			stats.record_count += file.row_count;
+			stats.table_size_bytes += file.file_size_bytes;
+			for (auto &column_stats : file.column_stats) {
+				stats.MergeStats(column_stats.first, column_stats.second);
+			}
+		}
+	}
+}
+
 NewDataInfo DuckLakeTransaction::GetNewDataFiles(DuckLakeCommitState &commit_state) {
 	NewDataInfo result;
 
@@ -1024,23 +1418,32 @@ NewDataInfo DuckLakeTransaction::GetNewDataFiles(DuckLakeCommitState &commit_sta
 		}
 		auto &new_stats = new_globals.stats;
 		vector<DuckLakeDeleteFile> delete_files;
-		for (auto &file : table_changes.new_data_files) {
-			auto data_file = GetNewDataFile(file, commit_state.commit_snapshot, table_id, new_stats.next_row_id);
-			if (file.delete_file) {
-				// this transaction-local file already has deletes - write them out
-				DuckLakeDeleteFile delete_file = *file.delete_file;
-				delete_file.data_file_id = data_file.id;
-				delete_files.push_back(std::move(delete_file));
+		if (!table_changes.new_data_files.empty()) {
+			if (!prepared_commit) {
+				PrepareCommit();
 			}
-
-			// merge the stats into the new global states
-			new_stats.record_count += file.row_count;
-			new_stats.table_size_bytes += file.file_size_bytes;
-			new_stats.next_row_id += file.row_count;
-			for (auto &entry : file.column_stats) {
-				new_stats.MergeStats(entry.first, entry.second);
+			auto &prepared_files = prepared_commit->new_data_files[entry.first];
+			D_ASSERT(prepared_files.column_stats.size() == table_changes.new_data_files.size());
+			for (idx_t file_idx = 0; file_idx < table_changes.new_data_files.size(); file_idx++) {
+				auto &file = table_changes.new_data_files[file_idx];
+				auto data_file = GetNewDataFile(file, commit_state.commit_snapshot, table_id, new_stats.next_row_id,
+				                                prepared_files.column_stats[file_idx]);
+				if (file.delete_file) {
+					// this transaction-local file already has deletes - write them out
+					DuckLakeDeleteFile delete_file = *file.delete_file;
+					delete_file.data_file_id = data_file.id;
+					delete_files.push_back(std::move(delete_file));
+				}
+				new_stats.next_row_id += file.row_count;
+				result.new_files.push_back(std::move(data_file));
+			}
+			// merge the (already merged) stats of the new files into the new global stats
+			auto &file_stats = prepared_files.stats;
+			new_stats.record_count += file_stats.record_count;
+			new_stats.table_size_bytes += file_stats.table_size_bytes;
+			for (auto &column_stats : file_stats.column_stats) {
+				new_stats.MergeStats(column_stats.first, column_stats.second);
 			}
-			result.new_files.push_back(std::move(data_file));
 		}
 		// write any deletes that were made on top of these transaction-local files
 		AddDeletes(table_id, std::move(delete_files));
@@ -1099,6 +1502,7 @@ DuckLakeTransaction::GetNewDeleteFiles(const DuckLakeCommitState &commit_state,
 			delete_file.file_size_bytes = file.file_size_bytes;
 			delete_file.footer_size = file.footer_size;
 			delete_file.encryption_key = file.encryption_key;
+			delete_file.inlined_deletes = file.inlined_deletes;
 			result.push_back(std::move(delete_file));
 		}
 	}
@@ -1205,18 +1609,23 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 	}
 
 	// drop entries
+	auto &timings = commit_state.timings;
 	if (!dropped_tables.empty()) {
+		DuckLakeCommitPhase phase(timings, "drop_tables");
 		metadata_manager->DropTables(commit_snapshot, dropped_tables, false);
 	}
 
 	if (!renamed_tables.empty()) {
+		DuckLakeCommitPhase phase(timings, "drop_tables");
 		metadata_manager->DropTables(commit_snapshot, renamed_tables, true);
 	}
 
 	if (!dropped_views.empty()) {
+		DuckLakeCommitPhase phase(timings, "drop_views");
 		metadata_manager->DropViews(commit_snapshot, dropped_views);
 	}
 	if (!dropped_schemas.empty()) {
+		DuckLakeCommitPhase phase(timings, "drop_schemas");
 		set<SchemaIndex> dropped_schema_ids;
 		for (auto &entry : dropped_schemas) {
 			dropped_schema_ids.insert(entry.first);
@@ -1225,12 +1634,14 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 	}
 	// write new schemas
 	if (new_schemas) {
+		DuckLakeCommitPhase phase(timings, "write_schemas");
 		auto schema_list = GetNewSchemas(commit_state);
 		metadata_manager->WriteNewSchemas(commit_snapshot, schema_list);
 	}
 
 	// write new tables
 	if (!new_tables.empty()) {
+		DuckLakeCommitPhase phase(timings, "write_tables");
 		auto result = GetNewTables(commit_state, transaction_changes);
 		metadata_manager->WriteNewTables(commit_snapshot, result.new_tables);
 		metadata_manager->WriteNewPartitionKeys(commit_snapshot, result.new_partition_keys);
@@ -1244,12 +1655,14 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 
 	// write new name maps
 	if (!new_name_maps.name_maps.empty()) {
+		DuckLakeCommitPhase phase(timings, "write_name_maps");
 		auto result = GetNewNameMaps(commit_state);
 		metadata_manager->WriteNewColumnMappings(commit_snapshot, result.new_column_mappings);
 	}
 
 	// write new data / data files
 	if (!table_data_changes.empty()) {
+		DuckLakeCommitPhase phase(timings, "write_data_files");
 		auto result = GetNewDataFiles(commit_state);
 		metadata_manager->WriteNewDataFiles(commit_snapshot, result.new_files);
 		metadata_manager->WriteNewInlinedData(commit_snapshot, result.new_inlined_data);
@@ -1257,6 +1670,7 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 
 	// drop data files
 	if (!dropped_files.empty()) {
+		DuckLakeCommitPhase phase(timings, "drop_data_files");
 		set<DataFileIndex> dropped_indexes;
 		for (auto &entry : dropped_files) {
 			dropped_indexes.insert(entry.second);
@@ -1265,6 +1679,7 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 	}
 
 	if (!table_data_changes.empty()) {
+		DuckLakeCommitPhase phase(timings, "write_deletes");
 		// write new delete files
 		set<DataFileIndex> overwritten_delete_files;
 		auto file_list = GetNewDeleteFiles(commit_state, overwritten_delete_files);
@@ -1274,7 +1689,9 @@ void DuckLakeTransaction::CommitChanges(DuckLakeCommitState &commit_state,
 		// write new inlined deletes
 		auto inlined_deletes = GetNewInlinedDeletes(commit_state);
 		metadata_manager->WriteNewInlinedDeletes(commit_snapshot, inlined_deletes);
-
+	}
+	if (!table_data_changes.empty()) {
+		DuckLakeCommitPhase phase(timings, "write_compactions");
 		// write compactions
 		auto compaction_merge_adjacent_changes =
 		    GetCompactionChanges(commit_snapshot, CompactionType::MERGE_ADJACENT_TABLES);
@@ -1390,8 +1807,25 @@ void DuckLakeTransaction::FlushChanges() {
 		retry_backoff = setting_val.GetValue<double>();
 	}
 
+	DuckLakeCommitTimings timings;
+	auto commit_start = std::chrono::steady_clock::now();
 	auto transaction_snapshot = GetSnapshot();
-	auto transaction_changes = GetTransactionChanges();
+	bool check_for_conflicts = false;
+	TransactionChangeInformation transaction_changes;
+	{
+		DuckLakeCommitPhase phase(timings, "prepare");
+		transaction_changes = GetTransactionChanges();
+		PrepareCommit();
+		auto last_committed_snapshot = ducklake_catalog.GetLastCommittedSnapshotId();
+		if (!last_committed_snapshot.IsNull() &&
+		    last_committed_snapshot.GetValue<idx_t>() > transaction_snapshot.snapshot_id) {
+			// another transaction in this process has committed since our snapshot was taken
+			// committing on top of our snapshot is bound to fail - start from the latest snapshot instead
+			lock_guard<mutex> guard(snapshot_lock);
+			snapshot = LoadLatestSnapshot();
+			check_for_conflicts = true;
+		}
+	}
 	DuckLakeSnapshot commit_snapshot;
 	for (idx_t i = 0; i < max_retry_count + 1; i++) {
 		commit_snapshot = GetSnapshot();
@@ -1403,30 +1837,51 @@ void DuckLakeTransaction::FlushChanges() {
 		bool can_retry;
 		try {
 			can_retry = false;
-			if (i > 0) {
-				// we failed our first commit due to another transaction committing
-				// retry - but first check for conflicts
+			if (check_for_conflicts) {
+				// another transaction has committed since our snapshot was taken - check for conflicts
+				DuckLakeCommitPhase phase(timings, "conflict_check");
 				CheckForConflicts(transaction_snapshot, transaction_changes);
 			}
+			for (auto &entry : grouped_transactions) {
+				if (entry.first.snapshot_id + 1 == commit_snapshot.snapshot_id) {
+					continue;
+				}
+				// the inserts of the transactions whose files we took over are checked against their own snapshots
+				DuckLakeCommitPhase phase(timings, "conflict_check");
+				TransactionChangeInformation grouped_changes;
+				grouped_changes.tables_inserted_into = entry.second;
+				CheckForConflicts(entry.first, grouped_changes);
+			}
 			can_retry = true;
-			DuckLakeCommitState commit_state(commit_snapshot);
+			// buffer the metadata writes of this commit so they are sent to the metadata catalog together
+			BeginWriteBatch();
+			DuckLakeCommitState commit_state(commit_snapshot, timings);
 			CommitChanges(commit_state, transaction_changes);
 
-			// write the new snapshot
-			metadata_manager->InsertSnapshot(commit_snapshot);
+			{
+				// write the new snapshot
+				DuckLakeCommitPhase phase(timings, "write_snapshot");
+				metadata_manager->InsertSnapshot(commit_snapshot);
 
-			WriteSnapshotChanges(commit_state, transaction_changes);
-			if (SchemaChangesMade()) {
-				// Insert our new schema in our table that tracks schema changes
-				metadata_manager->InsertNewSchema(commit_snapshot);
+				WriteSnapshotChanges(commit_state, transaction_changes);
+				if (SchemaChangesMade()) {
+					// Insert our new schema in our table that tracks schema changes
+					metadata_manager->InsertNewSchema(commit_snapshot);
+				}
+			}
+			{
+				// send the buffered writes and commit the metadata transaction
+				DuckLakeCommitPhase phase(timings, "metadata_commit");
+				EndWriteBatch();
+				connection->Commit();
 			}
-			connection->Commit();
 			catalog_version = commit_snapshot.schema_version;
 
 			// finished writing
 			break;
 		} catch (std::exception &ex) {
 			ErrorData error(ex);
+			DiscardWriteBatch();
 			// rollback if there is an active transaction
 			auto has_active_transaction = connection->context->transaction.HasActiveTransaction();
 			if (has_active_transaction) {
@@ -1434,8 +1889,11 @@ void DuckLakeTransaction::FlushChanges() {
 			}
 			bool retry_on_error = RetryOnError(error.Message());
 			bool finished_retrying = i + 1 >= max_retry_count;
+			timings.conflict_causes.push_back(DuckLakeCommitStats::GetConflictCause(error.Message()));
 			if (!can_retry || !retry_on_error || finished_retrying) {
 				// we abort after the max retry count
+				timings.failed = true;
+				RecordCommitTimings(timings, commit_start);
 				CleanupFiles();
 				// Add additional information on the number of retries and suggest to increase it
 				std::ostringstream error_message;
@@ -1449,22 +1907,42 @@ void DuckLakeTransaction::FlushChanges() {
 				error.Throw(error_message.str());
 			}
 
+			timings.retries++;
 #ifndef DUCKDB_NO_THREADS
-			RandomEngine random;
-			// random multiplier between 0.5 - 1.0
-			double random_multiplier = (random.NextRandom() + 1.0) / 2.0;
-			uint64_t sleep_amount =
-			    (uint64_t)((double)retry_wait_ms * random_multiplier * pow(retry_backoff, static_cast<double>(i)));
-			std::this_thread::sleep_for(std::chrono::milliseconds(sleep_amount));
+			{
+				DuckLakeCommitPhase phase(timings, "backoff");
+				RandomEngine random;
+				// random multiplier between 0.5 - 1.0
+				double random_multiplier = (random.NextRandom() + 1.0) / 2.0;
+				uint64_t sleep_amount =
+				    (uint64_t)((double)retry_wait_ms * random_multiplier * pow(retry_backoff, static_cast<double>(i)));
+				std::this_thread::sleep_for(std::chrono::milliseconds(sleep_amount));
+			}
 #endif
 
 			// retry the transaction (with a new snapshot id)
+			// we always load the latest snapshot here, as the snapshot observed by the catalog might be out-of-date
+			DuckLakeCommitPhase phase(timings, "reload_snapshot");
 			connection->BeginTransaction();
-			snapshot.reset();
+			lock_guard<mutex> guard(snapshot_lock);
+			snapshot = LoadLatestSnapshot();
+			check_for_conflicts = true;
 		}
 	}
 	// If we got here, this snapshot was successful
 	ducklake_catalog.SetCommittedSnapshotId(commit_snapshot.snapshot_id);
+	ducklake_catalog.SetLatestSnapshot(commit_snapshot);
+	auto tracker_changes = GetCompactionTrackerChanges();
+	ducklake_catalog.GetCompactionTracker().CommitChanges(commit_snapshot.snapshot_id, tracker_changes);
+	ducklake_catalog.GetFileSizeAdvisor().RecordWrites(tracker_changes);
+	RecordCommitTimings(timings, commit_start);
+}
+
+void DuckLakeTransaction::RecordCommitTimings(DuckLakeCommitTimings &timings,
+                                              std::chrono::steady_clock::time_point start) {
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	timings.total_time_us = NumericCast<idx_t>(elapsed.count());
+	ducklake_catalog.GetCommitStats().Record(timings);
 }
 
 void DuckLakeTransaction::SetConfigOption(const DuckLakeConfigOption &option) {
@@ -1474,6 +1952,11 @@ void DuckLakeTransaction::SetConfigOption(const DuckLakeConfigOption &option) {
 	ducklake_catalog.SetConfigOption(option);
 }
 
+void DuckLakeTransaction::SetConfigOptionOnCommit(const DuckLakeConfigOption &option) {
+	metadata_manager->SetConfigOption(option);
+	commit_config_options.push_back(option);
+}
+
 void DuckLakeTransaction::SetCommitMessage(const DuckLakeSnapshotCommit &option) {
 	commit_info = option;
 }
@@ -1481,6 +1964,8 @@ void DuckLakeTransaction::SetCommitMessage(const DuckLakeSnapshotCommit &option)
 void DuckLakeTransaction::DeleteSnapshots(const vector<DuckLakeSnapshotInfo> &snapshots) {
 	auto &metadata_manager = GetMetadataManager();
 	metadata_manager.DeleteSnapshots(snapshots);
+	// AT clauses that resolved to the expired snapshots have to be resolved again
+	ducklake_catalog.EvictAtClauseSnapshots(snapshots);
 }
 
 void DuckLakeTransaction::DeleteInlinedData(const DuckLakeInlinedTableInfo &inlined_table) {
@@ -1488,10 +1973,27 @@ void DuckLakeTransaction::DeleteInlinedData(const DuckLakeInlinedTableInfo &inli
 	metadata_manager.DeleteInlinedData(inlined_table);
 }
 
-unique_ptr<QueryResult> DuckLakeTransaction::Query(string query) {
-	auto &connection = GetConnection();
-	auto catalog_identifier = DuckLakeUtil::SQLIdentifierToString(ducklake_catalog.MetadataDatabaseName());
-	auto catalog_literal = DuckLakeUtil::SQLLiteralToString(ducklake_catalog.MetadataDatabaseName());
+//! The database the metadata queries of this thread are routed to instead of the metadata catalog
+static thread_local const string *current_metadata_read_database = nullptr;
+
+DuckLakeMetadataReadScope::DuckLakeMetadataReadScope(const string &database_name)
+    : previous_database(current_metadata_read_database) {
+	current_metadata_read_database = &database_name;
+}
+
+DuckLakeMetadataReadScope::~DuckLakeMetadataReadScope() {
+	current_metadata_read_database = previous_database.get();
+}
+
+optional_ptr<const string> DuckLakeMetadataReadScope::CurrentDatabase() {
+	return current_metadata_read_database;
+}
+
+string DuckLakeTransaction::ReplaceCatalogPlaceholders(string query) {
+	auto read_database = DuckLakeMetadataReadScope::CurrentDatabase();
+	auto &catalog_name = read_database ? *read_database : ducklake_catalog.MetadataDatabaseName();
+	auto catalog_identifier = DuckLakeUtil::SQLIdentifierToString(catalog_name);
+	auto catalog_literal = DuckLakeUtil::SQLLiteralToString(catalog_name);
 	auto schema_identifier = DuckLakeUtil::SQLIdentifierToString(ducklake_catalog.MetadataSchemaName());
 	auto schema_identifier_escaped = StringUtil::Replace(schema_identifier, "'", "''");
 	auto schema_literal = DuckLakeUtil::SQLLiteralToString(ducklake_catalog.MetadataSchemaName());
@@ -1505,10 +2007,91 @@ unique_ptr<QueryResult> DuckLakeTransaction::Query(string query) {
 	query = StringUtil::Replace(query, "{METADATA_SCHEMA_ESCAPED}", schema_identifier_escaped);
 	query = StringUtil::Replace(query, "{METADATA_PATH}", metadata_path);
 	query = StringUtil::Replace(query, "{DATA_PATH}", data_path);
-	return connection.Query(query);
+	return query;
 }
 
-unique_ptr<QueryResult> DuckLakeTransaction::Query(DuckLakeSnapshot snapshot, string query) {
+void DuckLakeTransaction::RecordMetadataQuery(const char *operation, std::chrono::steady_clock::time_point start,
+                                              QueryResult &result) {
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	idx_t rows = 0;
+	idx_t bytes = 0;
+	for (optional_ptr<QueryResult> current = &result; current; current = current->next.get()) {
+		if (current->HasError() || current->type != QueryResultType::MATERIALIZED_RESULT) {
+			continue;
+		}
+		auto &collection = current->Cast<MaterializedQueryResult>().Collection();
+		rows += collection.Count();
+		bytes += collection.SizeInBytes();
+	}
+	auto &stats = ducklake_catalog.GetMetadataStats();
+	stats.Record(operation, NumericCast<idx_t>(elapsed.count()), rows, bytes, result.HasError());
+}
+
+void DuckLakeTransaction::AddMetadataLatency() {
+	if (metadata_latency_ms == 0) {
+		return;
+	}
+#ifndef DUCKDB_NO_THREADS
+	std::this_thread::sleep_for(std::chrono::milliseconds(metadata_latency_ms));
+#endif
+}
+
+unique_ptr<QueryResult> DuckLakeTransaction::Query(string query) {
+	// any buffered writes need to be visible to this query
+	FlushWriteBatch();
+	auto &connection = GetConnection();
+	auto start = std::chrono::steady_clock::now();
+	AddMetadataLatency();
+	auto result = connection.Query(ReplaceCatalogPlaceholders(std::move(query)));
+	RecordMetadataQuery(DuckLakeMetadataStats::CurrentOperation(), start, *result);
+	return result;
+}
+
+unique_ptr<QueryResult> DuckLakeTransaction::PreparedQuery(string query, vector<Value> parameters) {
+	FlushWriteBatch();
+	auto &connection = GetConnection();
+	query = ReplaceCatalogPlaceholders(std::move(query));
+
+	optional_ptr<PreparedStatement> statement;
+	{
+		lock_guard<mutex> guard(prepared_statement_lock);
+		auto entry = prepared_statements.find(query);
+		if (entry != prepared_statements.end()) {
+			statement = entry->second.get();
+		} else {
+			// first time we see this query on this connection - prepare it and cache the statement
+			AddMetadataLatency();
+			auto prepared = connection.Prepare(query);
+			if (prepared->HasError()) {
+				return make_uniq<MaterializedQueryResult>(prepared->GetErrorObject());
+			}
+			statement = prepared.get();
+			prepared_statements.insert(make_pair(std::move(query), std::move(prepared)));
+		}
+	}
+	auto start = std::chrono::steady_clock::now();
+	AddMetadataLatency();
+	auto result = statement->Execute(parameters, false);
+	RecordMetadataQuery(DuckLakeMetadataStats::CurrentOperation(), start, *result);
+	return result;
+}
+
+unique_ptr<QueryResult> DuckLakeTransaction::PreparedQuery(DuckLakeSnapshot snapshot, string query,
+                                                           vector<Value> parameters) {
+	if (query.find("{SNAPSHOT_ID}") != string::npos) {
+		// the snapshot id is bound as the last parameter
+		parameters.push_back(Value::BIGINT(NumericCast<int64_t>(snapshot.snapshot_id)));
+		query = StringUtil::Replace(query, "{SNAPSHOT_ID}", "$" + to_string(parameters.size()));
+	}
+	return PreparedQuery(std::move(query), std::move(parameters));
+}
+
+void DuckLakeTransaction::ClearPreparedStatements() {
+	lock_guard<mutex> guard(prepared_statement_lock);
+	prepared_statements.clear();
+}
+
+string DuckLakeTransaction::ReplaceSnapshotPlaceholders(DuckLakeSnapshot snapshot, string query) {
 	query = StringUtil::Replace(query, "{SNAPSHOT_ID}", to_string(snapshot.snapshot_id));
 	query = StringUtil::Replace(query, "{SCHEMA_VERSION}", to_string(snapshot.schema_version));
 	query = StringUtil::Replace(query, "{NEXT_CATALOG_ID}", to_string(snapshot.next_catalog_id));
@@ -1516,8 +2099,66 @@ unique_ptr<QueryResult> DuckLakeTransaction::Query(DuckLakeSnapshot snapshot, st
 	query = StringUtil::Replace(query, "{AUTHOR}", commit_info.author.ToSQLString());
 	query = StringUtil::Replace(query, "{COMMIT_MESSAGE}", commit_info.commit_message.ToSQLString());
 	query = StringUtil::Replace(query, "{COMMIT_EXTRA_INFO}", commit_info.commit_extra_info.ToSQLString());
+	return query;
+}
 
-	return Query(std::move(query));
+unique_ptr<QueryResult> DuckLakeTransaction::Query(DuckLakeSnapshot snapshot, string query) {
+	return Query(ReplaceSnapshotPlaceholders(snapshot, std::move(query)));
+}
+
+void DuckLakeTransaction::ExecuteWrite(DuckLakeSnapshot snapshot, string query, const string &error_prefix) {
+	ExecuteWrite(ReplaceSnapshotPlaceholders(snapshot, std::move(query)), error_prefix);
+}
+
+void DuckLakeTransaction::ExecuteWrite(string query, const string &error_prefix) {
+	if (!batch_writes) {
+		// not batching - run the write directly
+		auto result = Query(std::move(query));
+		if (result->HasError()) {
+			result->GetErrorObject().Throw(error_prefix);
+		}
+		return;
+	}
+	// append the write to the batch - it is sent with the next read or when the batch is finished
+	StringUtil::Trim(query);
+	if (!StringUtil::EndsWith(query, ";")) {
+		query += ";";
+	}
+	write_batch.push_back(std::move(query));
+}
+
+void DuckLakeTransaction::BeginWriteBatch() {
+	batch_writes = true;
+}
+
+void DuckLakeTransaction::FlushWriteBatch() {
+	if (write_batch.empty()) {
+		return;
+	}
+	auto batch = GetMetadataManager().GetWriteBatchQuery(write_batch);
+	write_batch.clear();
+	auto &connection = GetConnection();
+	auto start = std::chrono::steady_clock::now();
+	AddMetadataLatency();
+	auto result = connection.Query(ReplaceCatalogPlaceholders(std::move(batch)));
+	// the writes in the batch were issued by different operations - they are tracked as a whole
+	RecordMetadataQuery("WriteBatch", start, *result);
+	// every statement in the batch produces its own result - check all of them
+	for (optional_ptr<QueryResult> current = result.get(); current; current = current->next.get()) {
+		if (current->HasError()) {
+			current->GetErrorObject().Throw("Failed to write changes to DuckLake: ");
+		}
+	}
+}
+
+void DuckLakeTransaction::EndWriteBatch() {
+	FlushWriteBatch();
+	batch_writes = false;
+}
+
+void DuckLakeTransaction::DiscardWriteBatch() {
+	write_batch.clear();
+	batch_writes = false;
 }
 
 string DuckLakeTransaction::GetDefaultSchemaName() {
@@ -1527,6 +2168,16 @@ string DuckLakeTransaction::GetDefaultSchemaName() {
 	return metadb->GetCatalog().GetDefaultSchema();
 }
 
+void DuckLakeTransaction::PinSchema(idx_t schema_version, shared_ptr<DuckLakeCatalogSet> schema) {
+	lock_guard<mutex> guard(pinned_cache_lock);
+	pinned_schemas.insert(make_pair(schema_version, std::move(schema)));
+}
+
+void DuckLakeTransaction::PinStats(idx_t next_file_id, shared_ptr<DuckLakeStats> stats) {
+	lock_guard<mutex> guard(pinned_cache_lock);
+	pinned_stats.insert(make_pair(next_file_id, std::move(stats)));
+}
+
 DuckLakeSnapshot DuckLakeTransaction::GetSnapshot() {
 	auto catalog_snapshot = ducklake_catalog.CatalogSnapshot();
 	if (catalog_snapshot) {
@@ -1535,12 +2186,22 @@ DuckLakeSnapshot DuckLakeTransaction::GetSnapshot() {
 	}
 	lock_guard<mutex> guard(snapshot_lock);
 	if (!snapshot) {
-		// no snapshot loaded yet for this transaction - load it
-		snapshot = metadata_manager->GetSnapshot();
+		// no snapshot loaded yet for this transaction - check if the catalog has recently observed the latest snapshot
+		snapshot = ducklake_catalog.TryGetLatestSnapshot();
+	}
+	if (!snapshot) {
+		// it has not - load it
+		snapshot = LoadLatestSnapshot();
 	}
 	return *snapshot;
 }
 
+unique_ptr<DuckLakeSnapshot> DuckLakeTransaction::LoadLatestSnapshot() {
+	auto result = metadata_manager->GetSnapshot();
+	ducklake_catalog.SetLatestSnapshot(*result);
+	return result;
+}
+
 DuckLakeSnapshot DuckLakeTransaction::GetSnapshot(optional_ptr<BoundAtClause> at_clause, SnapshotBound bound) {
 	if (!at_clause) {
 		// no AT-clause - get the latest snapshot
@@ -1548,8 +2209,13 @@ DuckLakeSnapshot DuckLakeTransaction::GetSnapshot(optional_ptr<BoundAtClause> at
 	}
 	// construct a struct value from the AT clause in the form of {"unit": value} (e.g. {"version": 2}
 	// this is used as a caching key for the snapshot
+	// timestamps resolve to a different snapshot depending on the bound - so the bound is part of the key
+	auto is_version = StringUtil::CIEquals(at_clause->Unit(), "version");
 	child_list_t<Value> values;
 	values.push_back(make_pair(at_clause->Unit(), at_clause->GetValue()));
+	if (!is_version) {
+		values.push_back(make_pair("bound", Value(bound == SnapshotBound::LOWER_BOUND ? "lower" : "upper")));
+	}
 	auto snapshot_value = Value::STRUCT(std::move(values));
 
 	lock_guard<mutex> guard(snapshot_lock);
@@ -1558,8 +2224,33 @@ DuckLakeSnapshot DuckLakeTransaction::GetSnapshot(optional_ptr<BoundAtClause> at
 		// we already found this snapshot - return it
 		return entry->second;
 	}
+	DuckLakeSnapshot result_snapshot;
+	if (ducklake_catalog.TryGetAtClauseSnapshot(snapshot_value, result_snapshot)) {
+		// another transaction already found this snapshot
+		snapshot_cache.insert(make_pair(std::move(snapshot_value), result_snapshot));
+		return result_snapshot;
+	}
 	// find the snapshot and cache it
-	auto result_snapshot = *metadata_manager->GetSnapshot(*at_clause, bound);
+	result_snapshot = *metadata_manager->GetSnapshot(*at_clause, bound);
+	// committed snapshots never change - so the snapshot of a version is fixed
+	// a timestamp resolves to the first snapshot at or after it (lower bound) - which is fixed once found - or to the
+	// last snapshot at or before it (upper bound) - which is fixed once a later snapshot has been committed
+	bool is_final = is_version || bound == SnapshotBound::LOWER_BOUND;
+	if (!is_final) {
+		unique_ptr<DuckLakeSnapshot> latest_snapshot;
+		if (snapshot) {
+			latest_snapshot = make_uniq<DuckLakeSnapshot>(*snapshot);
+		} else {
+			latest_snapshot = ducklake_catalog.TryGetLatestSnapshot();
+		}
+		if (!latest_snapshot) {
+			latest_snapshot = metadata_manager->GetSnapshot();
+		}
+		is_final = result_snapshot.snapshot_id < latest_snapshot->snapshot_id;
+	}
+	if (is_final) {
+		ducklake_catalog.CacheAtClauseSnapshot(snapshot_value, result_snapshot);
+	}
 	snapshot_cache.insert(make_pair(std::move(snapshot_value), result_snapshot));
 	return result_snapshot;
 }
@@ -1568,38 +2259,63 @@ idx_t DuckLakeTransaction::GetLocalCatalogId() {
 	return local_catalog_id++;
 }
 
-bool DuckLakeTransaction::HasTransactionLocalChanges(TableIndex table_id) const {
+LocalTableDataChanges &DuckLakeTransaction::GetOrCreateTableChanges(TableIndex table_id) {
+	lock_guard<mutex> guard(table_data_changes_lock);
+	return table_data_changes[table_id];
+}
+
+optional_ptr<LocalTableDataChanges> DuckLakeTransaction::TryGetTableChanges(TableIndex table_id) {
+	lock_guard<mutex> guard(table_data_changes_lock);
 	auto entry = table_data_changes.find(table_id);
 	if (entry == table_data_changes.end()) {
-		return false;
+		return nullptr;
 	}
-	auto &table_changes = entry->second;
-	return !table_changes.new_data_files.empty() || table_changes.new_inlined_data;
+	return entry->second;
 }
 
-bool DuckLakeTransaction::HasTransactionInlinedData(TableIndex table_id) const {
+optional_ptr<const LocalTableDataChanges> DuckLakeTransaction::TryGetTableChanges(TableIndex table_id) const {
+	lock_guard<mutex> guard(table_data_changes_lock);
 	auto entry = table_data_changes.find(table_id);
 	if (entry == table_data_changes.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+bool DuckLakeTransaction::HasTransactionLocalChanges(TableIndex table_id) const {
+	auto table_changes = TryGetTableChanges(table_id);
+	if (!table_changes) {
 		return false;
 	}
-	auto &table_changes = entry->second;
-	return table_changes.new_inlined_data != nullptr;
+	lock_guard<mutex> guard(table_changes->lock);
+	return !table_changes->new_data_files.empty() || table_changes->new_inlined_data;
+}
+
+bool DuckLakeTransaction::HasTransactionInlinedData(TableIndex table_id) const {
+	auto table_changes = TryGetTableChanges(table_id);
+	if (!table_changes) {
+		return false;
+	}
+	lock_guard<mutex> guard(table_changes->lock);
+	return table_changes->new_inlined_data != nullptr;
 }
 
 vector<DuckLakeDataFile> DuckLakeTransaction::GetTransactionLocalFiles(TableIndex table_id) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto table_changes = TryGetTableChanges(table_id);
+	if (!table_changes) {
 		return vector<DuckLakeDataFile>();
 	}
-	return entry->second.new_data_files;
+	lock_guard<mutex> guard(table_changes->lock);
+	return table_changes->new_data_files;
 }
 
 shared_ptr<DuckLakeInlinedData> DuckLakeTransaction::GetTransactionLocalInlinedData(TableIndex table_id) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		return nullptr;
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	lock_guard<mutex> guard(table_changes.lock);
 	if (!table_changes.new_inlined_data) {
 		return nullptr;
 	}
@@ -1614,12 +2330,13 @@ shared_ptr<DuckLakeInlinedData> DuckLakeTransaction::GetTransactionLocalInlinedD
 }
 
 void DuckLakeTransaction::DropTransactionLocalFile(TableIndex table_id, const string &path) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		throw InternalException(
 		    "DropTransactionLocalFile called for a table for which no transaction-local files exist");
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	unique_lock<mutex> table_guard(table_changes.lock);
 	auto &table_files = table_changes.new_data_files;
 	auto context_ref = context.lock();
 	auto &fs = FileSystem::GetFileSystem(*context_ref);
@@ -1631,7 +2348,9 @@ void DuckLakeTransaction::DropTransactionLocalFile(TableIndex table_id, const st
 			fs.RemoveFile(path);
 			if (table_changes.IsEmpty()) {
 				// no more files remaining
-				table_data_changes.erase(entry);
+				table_guard.unlock();
+				lock_guard<mutex> guard(table_data_changes_lock);
+				table_data_changes.erase(table_id);
 			}
 			return;
 		}
@@ -1643,15 +2362,16 @@ void DuckLakeTransaction::AppendFiles(TableIndex table_id, vector<DuckLakeDataFi
 	if (files.empty()) {
 		return;
 	}
-	auto &table_changes = table_data_changes[table_id];
+	auto &table_changes = GetOrCreateTableChanges(table_id);
+	lock_guard<mutex> guard(table_changes.lock);
 	for (auto &file : files) {
 		table_changes.new_data_files.push_back(std::move(file));
 	}
 }
 
 void DuckLakeTransaction::AppendInlinedData(TableIndex table_id, unique_ptr<DuckLakeInlinedData> new_data) {
-	lock_guard<mutex> guard(table_data_changes_lock);
-	auto &table_changes = table_data_changes[table_id];
+	auto &table_changes = GetOrCreateTableChanges(table_id);
+	lock_guard<mutex> guard(table_changes.lock);
 	if (table_changes.new_inlined_data) {
 		// already exists - append
 		auto &existing_data = *table_changes.new_inlined_data;
@@ -1677,7 +2397,8 @@ void DuckLakeTransaction::AddNewInlinedDeletes(TableIndex table_id, const string
 	if (new_deletes.empty()) {
 		return;
 	}
-	auto &table_changes = table_data_changes[table_id];
+	auto &table_changes = GetOrCreateTableChanges(table_id);
+	lock_guard<mutex> guard(table_changes.lock);
 	auto &table_deletes = table_changes.new_inlined_data_deletes;
 	auto entry = table_deletes.find(table_name);
 	if (entry != table_deletes.end()) {
@@ -1694,11 +2415,12 @@ void DuckLakeTransaction::AddNewInlinedDeletes(TableIndex table_id, const string
 }
 
 void DuckLakeTransaction::DeleteFromLocalInlinedData(TableIndex table_id, set<idx_t> new_deletes) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		throw InternalException("DeleteFromLocalInlinedData called but no transaction-local data exists for table");
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	lock_guard<mutex> guard(table_changes.lock);
 	auto &existing = *table_changes.new_inlined_data->data;
 	// construct a new collection from the existing data minus the deletes
 	auto context_ref = context.lock();
@@ -1734,11 +2456,12 @@ void DuckLakeTransaction::DeleteFromLocalInlinedData(TableIndex table_id, set<id
 
 optional_ptr<DuckLakeInlinedDataDeletes> DuckLakeTransaction::GetInlinedDeletes(TableIndex table_id,
                                                                                 const string &table_name) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		return nullptr;
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	lock_guard<mutex> guard(table_changes.lock);
 	auto delete_entry = table_changes.new_inlined_data_deletes.find(table_name);
 	if (delete_entry == table_changes.new_inlined_data_deletes.end()) {
 		return nullptr;
@@ -1750,7 +2473,8 @@ void DuckLakeTransaction::AddDeletes(TableIndex table_id, vector<DuckLakeDeleteF
 	if (files.empty()) {
 		return;
 	}
-	auto &table_changes = table_data_changes[table_id];
+	auto &table_changes = GetOrCreateTableChanges(table_id);
+	lock_guard<mutex> guard(table_changes.lock);
 	auto &table_delete_map = table_changes.new_delete_files;
 	for (auto &file : files) {
 		auto &data_file_path = file.data_file_path;
@@ -1759,10 +2483,12 @@ void DuckLakeTransaction::AddDeletes(TableIndex table_id, vector<DuckLakeDeleteF
 		}
 		auto existing_entry = table_delete_map.find(data_file_path);
 		if (existing_entry != table_delete_map.end()) {
-			auto context_ref = context.lock();
-			auto &fs = FileSystem::GetFileSystem(*context_ref);
-			// we have a transaction-local delete for this file already - delete it
-			fs.RemoveFile(existing_entry->second.file_name);
+			if (!existing_entry->second.IsInlined()) {
+				auto context_ref = context.lock();
+				auto &fs = FileSystem::GetFileSystem(*context_ref);
+				// we have a transaction-local delete file for this file already - delete it
+				fs.RemoveFile(existing_entry->second.file_name);
+			}
 			// write the new file
 			existing_entry->second = std::move(file);
 		} else {
@@ -1772,25 +2498,27 @@ void DuckLakeTransaction::AddDeletes(TableIndex table_id, vector<DuckLakeDeleteF
 }
 
 void DuckLakeTransaction::AddCompaction(TableIndex table_id, DuckLakeCompactionEntry entry) {
-	lock_guard<mutex> guard(table_data_changes_lock);
-	auto &table_changes = table_data_changes[table_id];
+	auto &table_changes = GetOrCreateTableChanges(table_id);
+	lock_guard<mutex> guard(table_changes.lock);
 	table_changes.compactions.push_back(std::move(entry));
 }
 
 bool DuckLakeTransaction::HasLocalDeletes(TableIndex table_id) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto table_changes = TryGetTableChanges(table_id);
+	if (!table_changes) {
 		return false;
 	}
-	return !entry->second.new_delete_files.empty();
+	lock_guard<mutex> guard(table_changes->lock);
+	return !table_changes->new_delete_files.empty();
 }
 
 void DuckLakeTransaction::GetLocalDeleteForFile(TableIndex table_id, const string &path, DuckLakeFileData &result) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		return;
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	lock_guard<mutex> guard(table_changes.lock);
 	auto file_entry = table_changes.new_delete_files.find(path);
 	if (file_entry == table_changes.new_delete_files.end()) {
 		return;
@@ -1802,14 +2530,26 @@ void DuckLakeTransaction::GetLocalDeleteForFile(TableIndex table_id, const strin
 	result.encryption_key = delete_file.encryption_key;
 }
 
+optional_ptr<const DuckLakeDeleteFile> DuckLakeTransaction::GetLocalInlinedDeletes(const string &file_name) {
+	for (auto &entry : table_data_changes) {
+		for (auto &file_entry : entry.second.new_delete_files) {
+			if (file_entry.second.file_name == file_name) {
+				return file_entry.second;
+			}
+		}
+	}
+	return nullptr;
+}
+
 void DuckLakeTransaction::TransactionLocalDelete(TableIndex table_id, const string &data_file_path,
                                                  DuckLakeDeleteFile delete_file) {
-	auto entry = table_data_changes.find(table_id);
-	if (entry == table_data_changes.end()) {
+	auto entry = TryGetTableChanges(table_id);
+	if (!entry) {
 		throw InternalException(
 		    "Transaction local delete called for table which does not have transaction local insertions");
 	}
-	auto &table_changes = entry->second;
+	auto &table_changes = *entry;
+	lock_guard<mutex> guard(table_changes.lock);
 	for (auto &file : table_changes.new_data_files) {
 		if (file.file_name == data_file_path) {
 			if (file.delete_file) {
@@ -1863,6 +2603,7 @@ void DuckLakeTransaction::DropTable(DuckLakeTableEntry &table) {
 		auto table_id = table.GetTableId();
 		schema_entry->second->DropEntry(table.name);
 		// if we have written any files for this table - clean them up
+		lock_guard<mutex> guard(table_data_changes_lock);
 		auto table_entry = table_data_changes.find(table_id);
 		if (table_entry != table_data_changes.end()) {
 			auto &table_changes = table_entry->second;
@@ -1877,6 +2618,11 @@ void DuckLakeTransaction::DropTable(DuckLakeTableEntry &table) {
 	} else {
 		auto table_id = table.GetTableId();
 		dropped_tables.insert(table_id);
+		// discard any buffered inserts of the table once we commit
+		auto buffered_rows = ducklake_catalog.GetInsertBuffer().Take(table_id);
+		if (buffered_rows.rows) {
+			AddFlushedInsertBuffer(table_id, std::move(buffered_rows));
+		}
 	}
 }
 
@@ -2223,7 +2969,7 @@ idx_t DuckLakeTransaction::GetCatalogVersion() {
 	if (catalog_version > 0) {
 		return catalog_version;
 	}
-	return GetSnapshot().schema_version;
+	return ducklake_catalog.GetCommittedCatalogVersion(GetSnapshot().schema_version);
 }
 
 } // namespace duckdb
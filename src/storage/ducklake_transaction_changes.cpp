@@ -22,6 +22,7 @@ enum class ChangeType {
 
 struct ChangeInfo {
 	ChangeType change_type;
+	string change_type_name;
 	string change_value;
 };
 
@@ -84,7 +85,9 @@ string ParseChangeValue(const string &changes_made, idx_t &pos) {
 
 ChangeInfo ParseChangeEntry(const string &changes_made, idx_t &pos) {
 	ChangeInfo info;
+	auto start_pos = pos;
 	info.change_type = ParseChangeType(changes_made, pos);
+	info.change_type_name = changes_made.substr(start_pos, pos - start_pos);
 	if (pos >= changes_made.size() || changes_made[pos] != ':') {
 		throw InvalidInputException("Expected a colon after the change type");
 	}
@@ -171,4 +174,25 @@ SnapshotChangeInformation SnapshotChangeInformation::ParseChangesMade(const stri
 	return result;
 }
 
+vector<SnapshotChangeEntry> SnapshotChangeInformation::SplitChangesMade(const string &changes_made) {
+	vector<SnapshotChangeEntry> result;
+	for (auto &entry : ParseChangesList(changes_made)) {
+		SnapshotChangeEntry change;
+		change.change_type = std::move(entry.change_type_name);
+		change.change_value = std::move(entry.change_value);
+		switch (entry.change_type) {
+		case ChangeType::CREATED_TABLE:
+		case ChangeType::CREATED_VIEW:
+		case ChangeType::CREATED_SCHEMA:
+			// created entries are referred to by their name
+			break;
+		default:
+			change.object_id = StringUtil::ToUnsigned(change.change_value);
+			break;
+		}
+		result.push_back(std::move(change));
+	}
+	return result;
+}
+
 } // namespace duckdb
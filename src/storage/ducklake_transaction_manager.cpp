@@ -1,5 +1,6 @@
 #include "storage/ducklake_transaction_manager.hpp"
 
+#include "duckdb/common/thread.hpp"
 #include "duckdb/main/settings.hpp"
 
 namespace duckdb {
@@ -23,13 +24,83 @@ Transaction &DuckLakeTransactionManager::StartTransaction(ClientContext &context
 	return result;
 }
 
+void DuckLakeTransactionManager::CommitInternal(ClientContext &context, DuckLakeTransaction &transaction) {
+	Value serialize_commits;
+	if (transaction.ChangesMade() && context.TryGetCurrentSetting("ducklake_serialize_commits", serialize_commits) &&
+	    BooleanValue::Get(serialize_commits)) {
+		// commit one transaction at a time - every commit then starts from the snapshot committed before it
+		lock_guard<mutex> guard(commit_lock);
+		transaction.Commit();
+	} else {
+		transaction.Commit();
+	}
+}
+
+void DuckLakeTransactionManager::GroupCommit(ClientContext &context, DuckLakeTransaction &transaction,
+                                             idx_t window_ms) {
+	unique_lock<mutex> guard(group_commit_lock);
+	if (open_commit_group) {
+		// another transaction is collecting the transactions that commit together with it - hand it our data files
+		auto group = open_commit_group;
+		group->transactions.push_back(transaction);
+		group_commit_cv.wait(guard, [&]() { return group->finished; });
+		guard.unlock();
+		if (group->error.HasError()) {
+			group->error.Throw();
+		}
+		// our data files have been committed - finish the (now empty) transaction
+		transaction.Commit();
+		return;
+	}
+	// we are the leader of a new group - wait for the transactions that commit within the window to join it
+	auto group = make_shared_ptr<DuckLakeCommitGroup>();
+	open_commit_group = group;
+	guard.unlock();
+#ifndef DUCKDB_NO_THREADS
+	std::this_thread::sleep_for(std::chrono::milliseconds(window_ms));
+#endif
+	guard.lock();
+	open_commit_group.reset();
+	guard.unlock();
+
+	ErrorData error;
+	try {
+		for (auto &other : group->transactions) {
+			transaction.AddGroupCommit(other.get());
+		}
+		CommitInternal(context, transaction);
+	} catch (std::exception &ex) {
+		error = ErrorData(ex);
+	}
+	guard.lock();
+	group->error = error;
+	group->finished = true;
+	guard.unlock();
+	group_commit_cv.notify_all();
+	if (error.HasError()) {
+		error.Throw();
+	}
+}
+
 ErrorData DuckLakeTransactionManager::CommitTransaction(ClientContext &context, Transaction &transaction) {
 	auto &ducklake_transaction = transaction.Cast<DuckLakeTransaction>();
 	try {
-		ducklake_transaction.Commit();
+		Value group_commit_window;
+		if (context.TryGetCurrentSetting("ducklake_group_commit_window_ms", group_commit_window) &&
+		    group_commit_window.GetValue<idx_t>() > 0 && ducklake_transaction.CanGroupCommit()) {
+			// append-only transactions committing within the window are combined into a single snapshot
+			GroupCommit(context, ducklake_transaction, group_commit_window.GetValue<idx_t>());
+		} else {
+			CommitInternal(context, ducklake_transaction);
+		}
 	} catch (std::exception &ex) {
 		return ErrorData(ex);
 	}
+	try {
+		// copy-on-write rewrites run in their own transactions after the commit - they never fail the commit
+		ducklake_transaction.RewriteCopyOnWriteTables();
+	} catch (...) {
+	}
 	lock_guard<mutex> l(transaction_lock);
 	transactions.erase(transaction);
 	return ErrorData();
@@ -7,10 +7,13 @@
 #include "storage/ducklake_delete.hpp"
 #include "storage/ducklake_table_entry.hpp"
 #include "storage/ducklake_catalog.hpp"
+#include "storage/ducklake_schema_entry.hpp"
+#include "storage/ducklake_transaction.hpp"
 #include "duckdb/planner/operator/logical_update.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/parser/expression/cast_expression.hpp"
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_projection.hpp"
@@ -201,6 +204,16 @@ SinkFinalizeType DuckLakeUpdate::Finalize(Pipeline &pipeline, Event &event, Clie
 	if (result != SinkFinalizeType::READY) {
 		throw InternalException("DuckLakeUpdate::Finalize does not support async child operators");
 	}
+	auto table_id = table.GetTableId();
+	if (!table_id.IsTransactionLocal()) {
+		auto &catalog = table.ParentCatalog().Cast<DuckLakeCatalog>();
+		auto schema_id = table.ParentSchema().Cast<DuckLakeSchemaEntry>().GetSchemaId();
+		auto update_mode = catalog.GetConfigOption<string>("update_mode", schema_id, table_id, "merge_on_read");
+		if (update_mode == "copy_on_write") {
+			// the files the update wrote deletes for are rewritten in full once the transaction commits
+			DuckLakeTransaction::Get(context, catalog).AddCopyOnWriteUpdate(table_id);
+		}
+	}
 	return SinkFinalizeType::READY;
 }
 
@@ -230,8 +243,12 @@ InsertionOrderPreservingMap<string> DuckLakeUpdate::ParamsToString() const {
 }
 
 static unique_ptr<Expression> GetFunction(ClientContext &context, unique_ptr<BoundReferenceExpression> column_reference,
-                                          const string &function_name) {
+                                          const string &function_name, optional_idx parameter = optional_idx()) {
 	vector<unique_ptr<Expression>> children;
+	if (parameter.IsValid()) {
+		auto parameter_value = Value::BIGINT(NumericCast<int64_t>(parameter.GetIndex()));
+		children.push_back(make_uniq<BoundConstantExpression>(std::move(parameter_value)));
+	}
 	children.emplace_back(std::move(column_reference));
 	ErrorData error;
 	FunctionBinder binder(context);
@@ -256,6 +273,10 @@ static unique_ptr<Expression> GetPartitionExpressionForUpdate(ClientContext &con
 		return GetFunction(context, std::move(column_reference), "day");
 	case DuckLakeTransformType::HOUR:
 		return GetFunction(context, std::move(column_reference), "hour");
+	case DuckLakeTransformType::BUCKET:
+		return GetFunction(context, std::move(column_reference), "ducklake_bucket", field.transform.parameter);
+	case DuckLakeTransformType::TRUNCATE:
+		return GetFunction(context, std::move(column_reference), "ducklake_truncate", field.transform.parameter);
 	default:
 		throw NotImplementedException("Unsupported partition transform type in GetPartitionExpressionForUpdate");
 	}
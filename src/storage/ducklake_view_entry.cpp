@@ -16,6 +16,19 @@ DuckLakeViewEntry::DuckLakeViewEntry(Catalog &catalog, SchemaCatalogEntry &schem
 DuckLakeViewEntry::DuckLakeViewEntry(DuckLakeViewEntry &parent, CreateViewInfo &info, LocalChange local_change)
     : DuckLakeViewEntry(parent.catalog, parent.schema, info, parent.GetViewId(), parent.GetViewUUID(), parent.query_sql,
                         local_change) {
+	ShareParsedQuery(parent);
+}
+
+DuckLakeViewEntry::DuckLakeViewEntry(DuckLakeViewEntry &parent, SchemaCatalogEntry &schema, CreateViewInfo &info)
+    : DuckLakeViewEntry(parent.catalog, schema, info, parent.GetViewId(), parent.GetViewUUID(), parent.query_sql,
+                        parent.local_change) {
+	ShareParsedQuery(parent);
+}
+
+void DuckLakeViewEntry::ShareParsedQuery(const DuckLakeViewEntry &other) {
+	D_ASSERT(query_sql == other.query_sql);
+	lock_guard<mutex> l(other.parse_lock);
+	parsed_query = other.parsed_query;
 }
 
 unique_ptr<CatalogEntry> DuckLakeViewEntry::AlterEntry(ClientContext &context, AlterInfo &info) {
@@ -51,7 +64,7 @@ unique_ptr<CreateInfo> DuckLakeViewEntry::GetInfo() const {
 	auto info = ViewCatalogEntry::GetInfo();
 	auto &view_info = info->Cast<CreateViewInfo>();
 	if (!view_info.query) {
-		view_info.query = ParseSelectStatement();
+		view_info.query = unique_ptr_cast<SQLStatement, SelectStatement>(GetParsedQuery()->Copy());
 	}
 	return info;
 }
@@ -64,8 +77,10 @@ unique_ptr<CatalogEntry> DuckLakeViewEntry::Copy(ClientContext &context) const {
 	D_ASSERT(!internal);
 	auto create_info = GetInfo();
 
-	return make_uniq<DuckLakeViewEntry>(catalog, schema, create_info->Cast<CreateViewInfo>(), view_id, view_uuid,
-	                                    query_sql, local_change);
+	auto result = make_uniq<DuckLakeViewEntry>(catalog, schema, create_info->Cast<CreateViewInfo>(), view_id,
+	                                           view_uuid, query_sql, local_change);
+	result->ShareParsedQuery(*this);
+	return std::move(result);
 }
 
 unique_ptr<SelectStatement> DuckLakeViewEntry::ParseSelectStatement() const {
@@ -78,13 +93,17 @@ unique_ptr<SelectStatement> DuckLakeViewEntry::ParseSelectStatement() const {
 	return unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
 }
 
-const SelectStatement &DuckLakeViewEntry::GetQuery() {
+shared_ptr<SelectStatement> DuckLakeViewEntry::GetParsedQuery() const {
 	lock_guard<mutex> l(parse_lock);
-	if (!query) {
+	if (!parsed_query) {
 		// parse the query
-		query = ParseSelectStatement();
+		parsed_query = ParseSelectStatement();
 	}
-	return *query;
+	return parsed_query;
+}
+
+const SelectStatement &DuckLakeViewEntry::GetQuery() {
+	return *GetParsedQuery();
 }
 
 string DuckLakeViewEntry::GetQuerySQL() {
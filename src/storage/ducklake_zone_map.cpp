@@ -0,0 +1,407 @@
+#include "storage/ducklake_zone_map.hpp"
+
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
+
+namespace duckdb {
+
+DuckLakeColumnZoneMap::DuckLakeColumnZoneMap(LogicalType type_p) : type(std::move(type_p)) {
+	is_floating_point = type.id() == LogicalTypeId::FLOAT || type.id() == LogicalTypeId::DOUBLE;
+}
+
+bool DuckLakeColumnZoneMap::SupportsType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::UTINYINT:
+	case LogicalTypeId::USMALLINT:
+	case LogicalTypeId::UINTEGER:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_SEC:
+	case LogicalTypeId::TIMESTAMP_MS:
+	case LogicalTypeId::TIMESTAMP_NS:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+		return true;
+	case LogicalTypeId::DECIMAL:
+		return DecimalType::GetWidth(type) <= Decimal::MAX_WIDTH_INT64;
+	default:
+		return false;
+	}
+}
+
+idx_t DuckLakeColumnZoneMap::GetLoadedFileId() {
+	lock_guard<mutex> guard(lock);
+	return loaded_file_id;
+}
+
+bool DuckLakeColumnZoneMap::TryConvert(const Value &value, int64_t &result) const {
+	if (value.IsNull()) {
+		return false;
+	}
+	Value converted = value;
+	if (!converted.DefaultTryCastAs(type)) {
+		return false;
+	}
+	switch (type.InternalType()) {
+	case PhysicalType::INT8:
+		result = converted.GetValueUnsafe<int8_t>();
+		return true;
+	case PhysicalType::INT16:
+		result = converted.GetValueUnsafe<int16_t>();
+		return true;
+	case PhysicalType::INT32:
+		result = converted.GetValueUnsafe<int32_t>();
+		return true;
+	case PhysicalType::INT64:
+		result = converted.GetValueUnsafe<int64_t>();
+		return true;
+	case PhysicalType::UINT8:
+		result = converted.GetValueUnsafe<uint8_t>();
+		return true;
+	case PhysicalType::UINT16:
+		result = converted.GetValueUnsafe<uint16_t>();
+		return true;
+	case PhysicalType::UINT32:
+		result = converted.GetValueUnsafe<uint32_t>();
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool TryConvertDouble(const Value &value, double &result) {
+	if (value.IsNull()) {
+		return false;
+	}
+	Value converted = value;
+	if (!converted.DefaultTryCastAs(LogicalType::DOUBLE)) {
+		return false;
+	}
+	result = converted.GetValue<double>();
+	return !Value::IsNan(result);
+}
+
+void DuckLakeColumnZoneMap::AddFiles(const vector<vector<Value>> &file_stats, idx_t loaded_file_id_p) {
+	lock_guard<mutex> guard(lock);
+	for (auto &stats : file_stats) {
+		auto file_id = stats[0].GetValue<idx_t>();
+		if (file_offsets.find(file_id) != file_offsets.end()) {
+			// we have already added this file
+			continue;
+		}
+		file_offsets.emplace(file_id, has_min_max.size());
+		bool has_stats;
+		if (is_floating_point) {
+			double min_val = 0, max_val = 0;
+			has_stats = TryConvertDouble(stats[1], min_val) && TryConvertDouble(stats[2], max_val);
+			double_min.push_back(min_val);
+			double_max.push_back(max_val);
+		} else {
+			int64_t min_val = 0, max_val = 0;
+			has_stats = TryConvert(stats[1], min_val) && TryConvert(stats[2], max_val);
+			int_min.push_back(min_val);
+			int_max.push_back(max_val);
+		}
+		has_min_max.push_back(has_stats ? 1 : 0);
+		null_count.push_back(stats[3].IsNull() ? -1 : stats[3].GetValue<int64_t>());
+		value_count.push_back(stats[4].IsNull() ? -1 : stats[4].GetValue<int64_t>());
+		// if we don't know whether or not the file contains NaN values we assume it does
+		contains_nan.push_back(stats[5].IsNull() || stats[5].GetValue<bool>() ? 1 : 0);
+	}
+	loaded_file_id = MaxValue<idx_t>(loaded_file_id, loaded_file_id_p);
+}
+
+template <class T>
+void DuckLakeColumnZoneMap::EvaluateComparison(ExpressionType comparison_type, T constant, const vector<T> &min_values,
+                                               const vector<T> &max_values, vector<uint8_t> &result) const {
+	auto count = result.size();
+	auto min_data = min_values.data();
+	auto max_data = max_values.data();
+	auto has_stats = has_min_max.data();
+	auto result_data = result.data();
+	// files without min/max stats can never be pruned
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | ((min_data[i] <= constant) & (max_data[i] >= constant));
+		}
+		break;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | !((min_data[i] == constant) & (max_data[i] == constant));
+		}
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | (max_data[i] >= constant);
+		}
+		break;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | (max_data[i] > constant);
+		}
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | (min_data[i] <= constant);
+		}
+		break;
+	case ExpressionType::COMPARE_LESSTHAN:
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = !has_stats[i] | (min_data[i] < constant);
+		}
+		break;
+	default:
+		// unsupported comparison
+		std::fill(result.begin(), result.end(), 1);
+		break;
+	}
+}
+
+void DuckLakeColumnZoneMap::EvaluateComparison(ExpressionType comparison_type, const Value &constant,
+                                               vector<uint8_t> &result) const {
+	if (!is_floating_point) {
+		int64_t constant_val;
+		if (!TryConvert(constant, constant_val)) {
+			std::fill(result.begin(), result.end(), 1);
+			return;
+		}
+		EvaluateComparison<int64_t>(comparison_type, constant_val, int_min, int_max, result);
+		return;
+	}
+	if (constant.IsNull()) {
+		std::fill(result.begin(), result.end(), 1);
+		return;
+	}
+	auto constant_val = constant.DefaultCastAs(LogicalType::DOUBLE).GetValue<double>();
+	if (Value::IsNan(constant_val)) {
+		if (comparison_type == ExpressionType::COMPARE_EQUAL) {
+			// x = NaN - check for contains_nan
+			result = contains_nan;
+		} else {
+			std::fill(result.begin(), result.end(), 1);
+		}
+		return;
+	}
+	EvaluateComparison<double>(comparison_type, constant_val, double_min, double_max, result);
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_NOTEQUAL:
+		// NaN is bigger than (and not equal to) any other value - files that contain NaN can never be pruned
+		for (idx_t i = 0; i < result.size(); i++) {
+			result[i] |= contains_nan[i];
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void DuckLakeColumnZoneMap::EvaluateFilter(const TableFilter &filter, vector<uint8_t> &result) const {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		EvaluateComparison(constant_filter.comparison_type, constant_filter.constant, result);
+		break;
+	}
+	case TableFilterType::IS_NULL:
+		// IS NULL can only be true if the file has any NULL values
+		for (idx_t i = 0; i < result.size(); i++) {
+			result[i] = null_count[i] != 0;
+		}
+		break;
+	case TableFilterType::IS_NOT_NULL:
+		// IS NOT NULL can only be true if the file has any valid values
+		for (idx_t i = 0; i < result.size(); i++) {
+			result[i] = value_count[i] != 0;
+		}
+		break;
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		std::fill(result.begin(), result.end(), 1);
+		vector<uint8_t> child_result(result.size());
+		for (auto &child_filter : conjunction_and_filter.child_filters) {
+			EvaluateFilter(*child_filter, child_result);
+			for (idx_t i = 0; i < result.size(); i++) {
+				result[i] &= child_result[i];
+			}
+		}
+		break;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction_or_filter = filter.Cast<ConjunctionOrFilter>();
+		std::fill(result.begin(), result.end(), 0);
+		vector<uint8_t> child_result(result.size());
+		for (auto &child_filter : conjunction_or_filter.child_filters) {
+			EvaluateFilter(*child_filter, child_result);
+			for (idx_t i = 0; i < result.size(); i++) {
+				result[i] |= child_result[i];
+			}
+		}
+		break;
+	}
+	case TableFilterType::IN_FILTER: {
+		auto &in_filter = filter.Cast<InFilter>();
+		std::fill(result.begin(), result.end(), 0);
+		vector<uint8_t> child_result(result.size());
+		for (auto &value : in_filter.values) {
+			EvaluateComparison(ExpressionType::COMPARE_EQUAL, value, child_result);
+			for (idx_t i = 0; i < result.size(); i++) {
+				result[i] |= child_result[i];
+			}
+		}
+		break;
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional_filter = filter.Cast<OptionalFilter>();
+		EvaluateFilter(*optional_filter.child_filter, result);
+		break;
+	}
+	default:
+		// unsupported filter - we cannot prune any files
+		std::fill(result.begin(), result.end(), 1);
+		break;
+	}
+}
+
+//! Replace dynamic filters with a copy of their current value - so that they are not read while the zone map is locked
+static unique_ptr<TableFilter> ResolveDynamicFilters(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::DYNAMIC_FILTER: {
+		auto &dynamic_filter = filter.Cast<DynamicFilter>();
+		if (dynamic_filter.filter_data) {
+			lock_guard<mutex> guard(dynamic_filter.filter_data->lock);
+			if (dynamic_filter.filter_data->initialized && dynamic_filter.filter_data->filter) {
+				return dynamic_filter.filter_data->filter->Copy();
+			}
+		}
+		return filter.Copy();
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		auto result = make_uniq<ConjunctionAndFilter>();
+		for (auto &child_filter : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			result->child_filters.push_back(ResolveDynamicFilters(*child_filter));
+		}
+		return std::move(result);
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		auto result = make_uniq<ConjunctionOrFilter>();
+		for (auto &child_filter : filter.Cast<ConjunctionOrFilter>().child_filters) {
+			result->child_filters.push_back(ResolveDynamicFilters(*child_filter));
+		}
+		return std::move(result);
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional_filter = filter.Cast<OptionalFilter>();
+		return make_uniq<OptionalFilter>(ResolveDynamicFilters(*optional_filter.child_filter));
+	}
+	default:
+		return filter.Copy();
+	}
+}
+
+vector<bool> DuckLakeColumnZoneMap::Evaluate(const TableFilter &filter_p, const vector<DataFileIndex> &file_ids) {
+	auto filter = ResolveDynamicFilters(filter_p);
+	lock_guard<mutex> guard(lock);
+	vector<uint8_t> result(has_min_max.size());
+	EvaluateFilter(*filter, result);
+
+	vector<bool> keep_files;
+	keep_files.reserve(file_ids.size());
+	for (auto &file_id : file_ids) {
+		auto entry = file_offsets.find(file_id.index);
+		if (entry == file_offsets.end()) {
+			// no stats for this file - we need to keep it
+			keep_files.push_back(true);
+			continue;
+		}
+		keep_files.push_back(result[entry->second] != 0);
+	}
+	return keep_files;
+}
+
+vector<idx_t> DuckLakeColumnZoneMap::OrderFiles(const vector<DataFileIndex> &file_ids, bool descending) {
+	lock_guard<mutex> guard(lock);
+	// files without stats (or with NaN values for a descending order) are read first
+	vector<idx_t> unordered_files;
+	vector<pair<idx_t, idx_t>> ordered_files;
+	for (idx_t i = 0; i < file_ids.size(); i++) {
+		auto entry = file_offsets.find(file_ids[i].index);
+		if (entry == file_offsets.end() || !has_min_max[entry->second] ||
+		    (descending && is_floating_point && contains_nan[entry->second])) {
+			unordered_files.push_back(i);
+			continue;
+		}
+		ordered_files.emplace_back(entry->second, i);
+	}
+	std::sort(ordered_files.begin(), ordered_files.end(),
+	          [&](const pair<idx_t, idx_t> &a, const pair<idx_t, idx_t> &b) {
+		          if (is_floating_point) {
+			          return descending ? double_max[a.first] > double_max[b.first]
+			                            : double_min[a.first] < double_min[b.first];
+		          }
+		          return descending ? int_max[a.first] > int_max[b.first] : int_min[a.first] < int_min[b.first];
+	          });
+	auto result = std::move(unordered_files);
+	for (auto &entry : ordered_files) {
+		result.push_back(entry.second);
+	}
+	return result;
+}
+
+template <class T>
+static bool ComparisonCanMatch(ExpressionType comparison_type, T constant, T min_value, T max_value) {
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		return min_value <= constant && max_value >= constant;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		return !(min_value == constant && max_value == constant);
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return max_value >= constant;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return max_value > constant;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return min_value <= constant;
+	case ExpressionType::COMPARE_LESSTHAN:
+		return min_value < constant;
+	default:
+		return true;
+	}
+}
+
+bool DuckLakeColumnZoneMap::FileCanMatch(DataFileIndex file_id, ExpressionType comparison_type,
+                                         const Value &constant) {
+	lock_guard<mutex> guard(lock);
+	auto entry = file_offsets.find(file_id.index);
+	if (entry == file_offsets.end() || !has_min_max[entry->second]) {
+		return true;
+	}
+	auto offset = entry->second;
+	if (is_floating_point) {
+		double constant_val;
+		if (!TryConvertDouble(constant, constant_val) || contains_nan[offset]) {
+			return true;
+		}
+		return ComparisonCanMatch<double>(comparison_type, constant_val, double_min[offset], double_max[offset]);
+	}
+	int64_t constant_val;
+	if (!TryConvert(constant, constant_val)) {
+		return true;
+	}
+	return ComparisonCanMatch<int64_t>(comparison_type, constant_val, int_min[offset], int_max[offset]);
+}
+
+} // namespace duckdb